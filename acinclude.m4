@@ -6,6 +6,10 @@ dnl Function to detect if libvmdk dependencies are available
 AC_DEFUN([AX_LIBVMDK_CHECK_LOCAL],
   [dnl Check for internationalization functions in libvmdk/libvmdk_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
+
+  dnl Headers and functions used to copy to a file descriptor in libvmdk/libvmdk_handle.c
+  AC_CHECK_HEADERS([errno.h fcntl.h unistd.h])
+  AC_CHECK_FUNCS([copy_file_range fstat open pwrite])
 ])
 
 dnl Function to check if DLL support is needed
@@ -0,0 +1,656 @@
+/*
+ * Change tracking file functions
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_change_tracking_file.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcnotify.h"
+
+#include "vmdk_change_tracking_file_header.h"
+
+const uint8_t vmdk_change_tracking_file_signature[ 4 ] = {
+	0xa2, 0x72, 0x19, 0xf6 };
+
+/* Creates a change tracking file
+ * Make sure the value change_tracking_file is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_change_tracking_file_initialize(
+     libvmdk_change_tracking_file_t **change_tracking_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_change_tracking_file_initialize";
+
+	if( change_tracking_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change tracking file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *change_tracking_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid change tracking file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*change_tracking_file = memory_allocate_structure(
+	                         libvmdk_change_tracking_file_t );
+
+	if( *change_tracking_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create change tracking file.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *change_tracking_file,
+	     0,
+	     sizeof( libvmdk_change_tracking_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear change tracking file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *change_tracking_file != NULL )
+	{
+		memory_free(
+		 *change_tracking_file );
+
+		*change_tracking_file = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a change tracking file
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_change_tracking_file_free(
+     libvmdk_change_tracking_file_t **change_tracking_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_change_tracking_file_free";
+
+	if( change_tracking_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change tracking file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *change_tracking_file != NULL )
+	{
+		memory_free(
+		 *change_tracking_file );
+
+		*change_tracking_file = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads the file header data of the change tracking file
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_change_tracking_file_read_file_header_data(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function            = "libvmdk_change_tracking_file_read_file_header_data";
+	uint64_t number_of_entries       = 0;
+	uint64_t number_of_sectors       = 0;
+	uint32_t entry_number_of_sectors = 0;
+	uint32_t header_size             = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	uint32_t value_32bit             = 0;
+#endif
+
+	if( change_tracking_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change tracking file.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( vmdk_change_tracking_file_header_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: file header:\n",
+		 function );
+		libcnotify_print_data(
+		 data,
+		 sizeof( vmdk_change_tracking_file_header_t ),
+		 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
+	}
+#endif
+	if( memory_compare(
+	     ( (vmdk_change_tracking_file_header_t *) data )->signature,
+	     vmdk_change_tracking_file_signature,
+	     4 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported file signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vmdk_change_tracking_file_header_t *) data )->format_version,
+	 change_tracking_file->format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vmdk_change_tracking_file_header_t *) data )->header_size,
+	 header_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vmdk_change_tracking_file_header_t *) data )->number_of_sectors,
+	 number_of_sectors );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vmdk_change_tracking_file_header_t *) data )->number_of_entries,
+	 number_of_entries );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vmdk_change_tracking_file_header_t *) data )->entry_number_of_sectors,
+	 entry_number_of_sectors );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vmdk_change_tracking_file_header_t *) data )->change_sequence_number,
+	 change_tracking_file->change_sequence_number );
+
+	if( memory_copy(
+	     change_tracking_file->change_tracking_identifier,
+	     ( (vmdk_change_tracking_file_header_t *) data )->change_tracking_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy change tracking identifier.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: signature\t\t\t\t: 0x%02" PRIx8 " 0x%02" PRIx8 " 0x%02" PRIx8 " 0x%02" PRIx8 "\n",
+		 function,
+		 data[ 0 ],
+		 data[ 1 ],
+		 data[ 2 ],
+		 data[ 3 ] );
+
+		libcnotify_printf(
+		 "%s: format version\t\t\t\t: %" PRIu32 "\n",
+		 function,
+		 change_tracking_file->format_version );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (vmdk_change_tracking_file_header_t *) data )->unknown1,
+		 value_32bit );
+		libcnotify_printf(
+		 "%s: unknown1\t\t\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 value_32bit );
+
+		libcnotify_printf(
+		 "%s: header size\t\t\t\t: %" PRIu32 "\n",
+		 function,
+		 header_size );
+
+		libcnotify_printf(
+		 "%s: number of sectors\t\t\t: %" PRIu64 "\n",
+		 function,
+		 number_of_sectors );
+
+		libcnotify_printf(
+		 "%s: number of entries\t\t\t: %" PRIu64 "\n",
+		 function,
+		 number_of_entries );
+
+		libcnotify_printf(
+		 "%s: entry number of sectors\t\t\t: %" PRIu32 "\n",
+		 function,
+		 entry_number_of_sectors );
+
+		libcnotify_printf(
+		 "%s: change sequence number\t\t\t: %" PRIu32 "\n",
+		 function,
+		 change_tracking_file->change_sequence_number );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (vmdk_change_tracking_file_header_t *) data )->unknown2,
+		 value_32bit );
+		libcnotify_printf(
+		 "%s: unknown2\t\t\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 value_32bit );
+
+		libcnotify_printf(
+		 "%s: change tracking identifier:\n",
+		 function );
+		libcnotify_print_data(
+		 change_tracking_file->change_tracking_identifier,
+		 16,
+		 0 );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	if( change_tracking_file->format_version != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version: %" PRIu32 ".",
+		 function,
+		 change_tracking_file->format_version );
+
+		return( -1 );
+	}
+	if( header_size < sizeof( vmdk_change_tracking_file_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid header size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sectors > ( (uint64_t) INT64_MAX / 512 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of sectors value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_number_of_sectors == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry number of sectors value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	change_tracking_file->entries_offset = (off64_t) header_size;
+	change_tracking_file->media_size     = number_of_sectors * 512;
+	change_tracking_file->entry_size     = (size64_t) entry_number_of_sectors * 512;
+
+	/* The entries must cover the entire (storage) media
+	 */
+	if( ( number_of_entries > ( (uint64_t) INT64_MAX / change_tracking_file->entry_size ) )
+	 || ( number_of_entries > ( ( (uint64_t) INT64_MAX - header_size ) / 4 ) )
+	 || ( ( number_of_entries * change_tracking_file->entry_size ) < change_tracking_file->media_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	change_tracking_file->number_of_entries = number_of_entries;
+
+	return( 1 );
+}
+
+/* Reads the file header of the change tracking file
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_change_tracking_file_read_file_header(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t file_header_data[ sizeof( vmdk_change_tracking_file_header_t ) ];
+
+	static char *function = "libvmdk_change_tracking_file_read_file_header";
+	size64_t file_size    = 0;
+	ssize_t read_count    = 0;
+
+	if( change_tracking_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change tracking file.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading file header at offset: 0 (0x00000000)\n",
+		 function );
+	}
+#endif
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              file_header_data,
+	              sizeof( vmdk_change_tracking_file_header_t ),
+	              0,
+	              error );
+
+	if( read_count != (ssize_t) sizeof( vmdk_change_tracking_file_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header data at offset: 0 (0x00000000).",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_change_tracking_file_read_file_header_data(
+	     change_tracking_file,
+	     file_header_data,
+	     sizeof( vmdk_change_tracking_file_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_size < ( (size64_t) change_tracking_file->entries_offset + ( change_tracking_file->number_of_entries * 4 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file size value too small to contain change sequence number entries.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the first changed range at or after a specific offset
+ * A range is considered changed if its change sequence number is greater than the one specified
+ * Returns 1 if successful, 0 if no such range or -1 on error
+ */
+int libvmdk_change_tracking_file_get_changed_range(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     libbfio_handle_t *file_io_handle,
+     uint32_t change_sequence_number,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	uint8_t entries_data[ 4096 ];
+
+	static char *function         = "libvmdk_change_tracking_file_get_changed_range";
+	off64_t file_offset           = 0;
+	off64_t range_end_offset      = 0;
+	off64_t range_start_offset    = 0;
+	size_t entries_data_offset    = 0;
+	size_t entries_data_size      = 0;
+	size_t read_size              = 0;
+	ssize_t read_count            = 0;
+	uint64_t entry_index          = 0;
+	uint32_t entry_sequence_value = 0;
+	uint8_t in_range              = 0;
+
+	if( change_tracking_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change tracking file.",
+		 function );
+
+		return( -1 );
+	}
+	if( change_tracking_file->entry_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid change tracking file - entry size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= change_tracking_file->media_size )
+	{
+		return( 0 );
+	}
+	entry_index = (uint64_t) offset / change_tracking_file->entry_size;
+
+	while( entry_index < change_tracking_file->number_of_entries )
+	{
+		if( entries_data_offset >= entries_data_size )
+		{
+			read_size = sizeof( entries_data );
+
+			if( ( (uint64_t) read_size / 4 ) > ( change_tracking_file->number_of_entries - entry_index ) )
+			{
+				read_size = (size_t) ( change_tracking_file->number_of_entries - entry_index ) * 4;
+			}
+			file_offset = change_tracking_file->entries_offset + (off64_t) ( entry_index * 4 );
+
+			read_count = libbfio_handle_read_buffer_at_offset(
+			              file_io_handle,
+			              entries_data,
+			              read_size,
+			              file_offset,
+			              error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read change sequence number entries data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 file_offset,
+				 file_offset );
+
+				return( -1 );
+			}
+			entries_data_offset = 0;
+			entries_data_size   = read_size;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 &( entries_data[ entries_data_offset ] ),
+		 entry_sequence_value );
+
+		if( entry_sequence_value > change_sequence_number )
+		{
+			if( in_range == 0 )
+			{
+				range_start_offset = (off64_t) ( entry_index * change_tracking_file->entry_size );
+				in_range           = 1;
+			}
+		}
+		else if( in_range != 0 )
+		{
+			break;
+		}
+		entries_data_offset += 4;
+
+		entry_index++;
+	}
+	if( in_range == 0 )
+	{
+		return( 0 );
+	}
+	range_end_offset = (off64_t) ( entry_index * change_tracking_file->entry_size );
+
+	if( (size64_t) range_end_offset > change_tracking_file->media_size )
+	{
+		range_end_offset = (off64_t) change_tracking_file->media_size;
+	}
+	if( range_start_offset < offset )
+	{
+		range_start_offset = offset;
+	}
+	if( range_start_offset >= range_end_offset )
+	{
+		return( 0 );
+	}
+	*range_offset = range_start_offset;
+	*range_size   = (size64_t) ( range_end_offset - range_start_offset );
+
+	return( 1 );
+}
+
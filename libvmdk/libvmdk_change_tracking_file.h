@@ -0,0 +1,104 @@
+/*
+ * Change tracking file functions
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _LIBVMDK_CHANGE_TRACKING_FILE_H )
+#define _LIBVMDK_CHANGE_TRACKING_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+extern const uint8_t vmdk_change_tracking_file_signature[ 4 ];
+
+typedef struct libvmdk_change_tracking_file libvmdk_change_tracking_file_t;
+
+struct libvmdk_change_tracking_file
+{
+	/* The format version
+	 */
+	uint32_t format_version;
+
+	/* The entries offset
+	 */
+	off64_t entries_offset;
+
+	/* The (storage) media size
+	 */
+	size64_t media_size;
+
+	/* The number of change sequence number entries
+	 */
+	uint64_t number_of_entries;
+
+	/* The (storage media) size covered by a change sequence number entry
+	 */
+	size64_t entry_size;
+
+	/* The change sequence number
+	 */
+	uint32_t change_sequence_number;
+
+	/* The change tracking identifier
+	 */
+	uint8_t change_tracking_identifier[ 16 ];
+};
+
+int libvmdk_change_tracking_file_initialize(
+     libvmdk_change_tracking_file_t **change_tracking_file,
+     libcerror_error_t **error );
+
+int libvmdk_change_tracking_file_free(
+     libvmdk_change_tracking_file_t **change_tracking_file,
+     libcerror_error_t **error );
+
+int libvmdk_change_tracking_file_read_file_header_data(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvmdk_change_tracking_file_read_file_header(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libvmdk_change_tracking_file_get_changed_range(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     libbfio_handle_t *file_io_handle,
+     uint32_t change_sequence_number,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_CHANGE_TRACKING_FILE_H ) */
+
@@ -0,0 +1,260 @@
+/*
+ * Corrupted range functions
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_corrupted_range.h"
+#include "libvmdk_libcdata.h"
+#include "libvmdk_libcerror.h"
+
+/* Creates a corrupted range
+ * Make sure the value corrupted_range is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_corrupted_range_initialize(
+     libvmdk_corrupted_range_t **corrupted_range,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_corrupted_range_initialize";
+
+	if( corrupted_range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid corrupted range.",
+		 function );
+
+		return( -1 );
+	}
+	if( *corrupted_range != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid corrupted range value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*corrupted_range = memory_allocate_structure(
+	                    libvmdk_corrupted_range_t );
+
+	if( *corrupted_range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create corrupted range.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *corrupted_range,
+	     0,
+	     sizeof( libvmdk_corrupted_range_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear corrupted range.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *corrupted_range != NULL )
+	{
+		memory_free(
+		 *corrupted_range );
+
+		*corrupted_range = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a corrupted range
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_corrupted_range_free(
+     libvmdk_corrupted_range_t **corrupted_range,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_corrupted_range_free";
+
+	if( corrupted_range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid corrupted range.",
+		 function );
+
+		return( -1 );
+	}
+	if( *corrupted_range != NULL )
+	{
+		memory_free(
+		 *corrupted_range );
+
+		*corrupted_range = NULL;
+	}
+	return( 1 );
+}
+
+/* Appends a corrupted range to an array
+ * The range is merged with the last corrupted range in the array if it directly
+ * follows it and has the same extent index and corruption flags
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_corrupted_range_append_to_array(
+     libcdata_array_t *corrupted_ranges_array,
+     off64_t offset,
+     size64_t size,
+     int extent_index,
+     uint32_t corruption_flags,
+     libcerror_error_t **error )
+{
+	libvmdk_corrupted_range_t *corrupted_range = NULL;
+	static char *function                      = "libvmdk_corrupted_range_append_to_array";
+	int entry_index                            = 0;
+	int number_of_entries                      = 0;
+
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     corrupted_ranges_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of corrupted ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries > 0 )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     corrupted_ranges_array,
+		     number_of_entries - 1,
+		     (intptr_t **) &corrupted_range,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve corrupted range: %d.",
+			 function,
+			 number_of_entries - 1 );
+
+			return( -1 );
+		}
+		if( ( corrupted_range != NULL )
+		 && ( corrupted_range->extent_index == extent_index )
+		 && ( corrupted_range->corruption_flags == corruption_flags )
+		 && ( ( corrupted_range->offset + (off64_t) corrupted_range->size ) == offset ) )
+		{
+			corrupted_range->size += size;
+
+			return( 1 );
+		}
+		corrupted_range = NULL;
+	}
+	if( libvmdk_corrupted_range_initialize(
+	     &corrupted_range,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create corrupted range.",
+		 function );
+
+		goto on_error;
+	}
+	corrupted_range->offset           = offset;
+	corrupted_range->size             = size;
+	corrupted_range->extent_index     = extent_index;
+	corrupted_range->corruption_flags = corruption_flags;
+
+	if( libcdata_array_append_entry(
+	     corrupted_ranges_array,
+	     &entry_index,
+	     (intptr_t *) corrupted_range,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append corrupted range to array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( corrupted_range != NULL )
+	{
+		libvmdk_corrupted_range_free(
+		 &corrupted_range,
+		 NULL );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,77 @@
+/*
+ * Corrupted range functions
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_CORRUPTED_RANGE_H )
+#define _LIBVMDK_CORRUPTED_RANGE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_libcdata.h"
+#include "libvmdk_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_corrupted_range libvmdk_corrupted_range_t;
+
+struct libvmdk_corrupted_range
+{
+	/* The (media) offset
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The extent index
+	 */
+	int extent_index;
+
+	/* The corruption flags
+	 */
+	uint32_t corruption_flags;
+};
+
+int libvmdk_corrupted_range_initialize(
+     libvmdk_corrupted_range_t **corrupted_range,
+     libcerror_error_t **error );
+
+int libvmdk_corrupted_range_free(
+     libvmdk_corrupted_range_t **corrupted_range,
+     libcerror_error_t **error );
+
+int libvmdk_corrupted_range_append_to_array(
+     libcdata_array_t *corrupted_ranges_array,
+     off64_t offset,
+     size64_t size,
+     int extent_index,
+     uint32_t corruption_flags,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_CORRUPTED_RANGE_H ) */
+
@@ -147,6 +147,11 @@ int libvmdk_descriptor_file_free(
 			memory_free(
 			 ( *descriptor_file )->parent_filename );
 		}
+		if( ( *descriptor_file )->change_tracking_filename != NULL )
+		{
+			memory_free(
+			 ( *descriptor_file )->change_tracking_filename );
+		}
 		memory_free(
 		 *descriptor_file );
 
@@ -1718,6 +1723,7 @@ int libvmdk_descriptor_file_read_change_tracking_file(
 {
 	char *line_string_segment        = NULL;
 	char *value_identifier           = NULL;
+	char *value                      = NULL;
 	static char *function            = "libvmdk_descriptor_file_read_change_tracking_file";
 	size_t line_string_segment_index = 0;
 	size_t line_string_segment_size  = 0;
@@ -1725,10 +1731,6 @@ int libvmdk_descriptor_file_read_change_tracking_file(
 	size_t value_length              = 0;
 	int safe_line_index              = 0;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	char *value                      = NULL;
-#endif
-
 	if( descriptor_file == NULL )
 	{
 		libcerror_error_set(
@@ -2035,9 +2037,7 @@ int libvmdk_descriptor_file_read_change_tracking_file(
 		}
 		/* Determine the value
 		 */
-#if defined( HAVE_DEBUG_OUTPUT )
 		value        = &( line_string_segment[ line_string_segment_index ] );
-#endif
 		value_length = line_string_segment_size - 1;
 
 		/* Ingore quotes at the beginning of the value data
@@ -2046,9 +2046,7 @@ int libvmdk_descriptor_file_read_change_tracking_file(
 		 || ( line_string_segment[ line_string_segment_index ] == '\'' ) )
 		{
 			line_string_segment_index++;
-#if defined( HAVE_DEBUG_OUTPUT )
 			value++;
-#endif
 			value_length--;
 		}
 		/* Ingore quotes at the end of the value data
@@ -2062,9 +2060,8 @@ int libvmdk_descriptor_file_read_change_tracking_file(
 		 */
 		line_string_segment[ value_length ] = 0;
 
-#if defined( HAVE_DEBUG_OUTPUT )
 		value_length -= line_string_segment_index;
-#endif
+
 		if( value_identifier_length == 15 )
 		{
 			if( narrow_string_compare_no_case(
@@ -2072,7 +2069,66 @@ int libvmdk_descriptor_file_read_change_tracking_file(
 			     "changeTrackPath",
 			     15 ) == 0 )
 			{
-/* TODO */
+				if( descriptor_file->change_tracking_filename != NULL )
+				{
+					memory_free(
+					 descriptor_file->change_tracking_filename );
+
+					descriptor_file->change_tracking_filename      = NULL;
+					descriptor_file->change_tracking_filename_size = 0;
+				}
+				if( value_length > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 1 ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+					 "%s: invalid change tracking filename length exceeds maximum allocation size.",
+					 function );
+
+					goto on_error;
+				}
+				descriptor_file->change_tracking_filename = (uint8_t *) memory_allocate(
+				                                                         sizeof( uint8_t ) * ( value_length + 1 ) );
+
+				if( descriptor_file->change_tracking_filename == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create change tracking filename.",
+					 function );
+
+					goto on_error;
+				}
+				if( memory_copy(
+				     descriptor_file->change_tracking_filename,
+				     value,
+				     value_length ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy change tracking filename.",
+					 function );
+
+					goto on_error;
+				}
+				descriptor_file->change_tracking_filename[ value_length ] = 0;
+
+				descriptor_file->change_tracking_filename_size = value_length + 1;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+				 	 "%s: change tracking filename\t\t: %s\n",
+					 function,
+					 descriptor_file->change_tracking_filename );
+				}
+#endif
 			}
 		}
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -2098,6 +2154,18 @@ int libvmdk_descriptor_file_read_change_tracking_file(
 	*line_index = safe_line_index;
 
 	return( 1 );
+
+on_error:
+	if( descriptor_file->change_tracking_filename != NULL )
+	{
+		memory_free(
+		 descriptor_file->change_tracking_filename );
+
+		descriptor_file->change_tracking_filename = NULL;
+	}
+	descriptor_file->change_tracking_filename_size = 0;
+
+	return( -1 );
 }
 
 /* Reads the disk database from the descriptor file
@@ -2761,6 +2829,190 @@ int libvmdk_descriptor_file_get_utf16_parent_filename(
 	return( 1 );
 }
 
+/* Retrieves the size of the UTF-8 encoded change tracking filename
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_descriptor_file_get_utf8_change_tracking_filename_size(
+     libvmdk_descriptor_file_t *descriptor_file,
+     size_t *utf8_string_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_descriptor_file_get_utf8_change_tracking_filename_size";
+
+	if( descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( descriptor_file->change_tracking_filename == NULL )
+	 || ( descriptor_file->change_tracking_filename_size == 0 ) )
+	{
+		return( 0 );
+	}
+	if( libuna_utf8_string_size_from_utf8_stream(
+	     descriptor_file->change_tracking_filename,
+	     descriptor_file->change_tracking_filename_size,
+	     utf8_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 string size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the UTF-8 encoded change tracking filename
+ * The size should include the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_descriptor_file_get_utf8_change_tracking_filename(
+     libvmdk_descriptor_file_t *descriptor_file,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_descriptor_file_get_utf8_change_tracking_filename";
+
+	if( descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( descriptor_file->change_tracking_filename == NULL )
+	 || ( descriptor_file->change_tracking_filename_size == 0 ) )
+	{
+		return( 0 );
+	}
+	if( libuna_utf8_string_copy_from_utf8_stream(
+	     utf8_string,
+	     utf8_string_size,
+	     descriptor_file->change_tracking_filename,
+	     descriptor_file->change_tracking_filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy change tracking filename to UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of the UTF-16 encoded change tracking filename
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_descriptor_file_get_utf16_change_tracking_filename_size(
+     libvmdk_descriptor_file_t *descriptor_file,
+     size_t *utf16_string_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_descriptor_file_get_utf16_change_tracking_filename_size";
+
+	if( descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( descriptor_file->change_tracking_filename == NULL )
+	 || ( descriptor_file->change_tracking_filename_size == 0 ) )
+	{
+		return( 0 );
+	}
+	if( libuna_utf16_string_size_from_utf8_stream(
+	     descriptor_file->change_tracking_filename,
+	     descriptor_file->change_tracking_filename_size,
+	     utf16_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 string size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the UTF-16 encoded change tracking filename
+ * The size should include the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_descriptor_file_get_utf16_change_tracking_filename(
+     libvmdk_descriptor_file_t *descriptor_file,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_descriptor_file_get_utf16_change_tracking_filename";
+
+	if( descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( descriptor_file->change_tracking_filename == NULL )
+	 || ( descriptor_file->change_tracking_filename_size == 0 ) )
+	{
+		return( 0 );
+	}
+	if( libuna_utf16_string_copy_from_utf8_stream(
+	     utf16_string,
+	     utf16_string_size,
+	     descriptor_file->change_tracking_filename,
+	     descriptor_file->change_tracking_filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy change tracking filename to UTF-16 string.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Retrieves the disk type
  * Returns 1 if successful or -1 on error
  */
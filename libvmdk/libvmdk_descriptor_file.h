@@ -70,6 +70,14 @@ struct libvmdk_descriptor_file
 	 */
 	size_t parent_filename_size;
 
+	/* The change tracking filename
+	 */
+	uint8_t *change_tracking_filename;
+
+	/* The change tracking filename size
+	 */
+	size_t change_tracking_filename_size;
+
 	/* The disk type
 	 */
 	int disk_type;
@@ -162,6 +170,28 @@ int libvmdk_descriptor_file_get_utf16_parent_filename(
      size_t utf16_string_size,
      libcerror_error_t **error );
 
+int libvmdk_descriptor_file_get_utf8_change_tracking_filename_size(
+     libvmdk_descriptor_file_t *descriptor_file,
+     size_t *utf8_string_size,
+     libcerror_error_t **error );
+
+int libvmdk_descriptor_file_get_utf8_change_tracking_filename(
+     libvmdk_descriptor_file_t *descriptor_file,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error );
+
+int libvmdk_descriptor_file_get_utf16_change_tracking_filename_size(
+     libvmdk_descriptor_file_t *descriptor_file,
+     size_t *utf16_string_size,
+     libcerror_error_t **error );
+
+int libvmdk_descriptor_file_get_utf16_change_tracking_filename(
+     libvmdk_descriptor_file_t *descriptor_file,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
+     libcerror_error_t **error );
+
 int libvmdk_descriptor_file_get_disk_type(
      libvmdk_descriptor_file_t *descriptor_file,
      int *disk_type,
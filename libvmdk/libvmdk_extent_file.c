@@ -24,12 +24,15 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libvmdk_compression.h"
+#include "libvmdk_corrupted_range.h"
 #include "libvmdk_debug.h"
 #include "libvmdk_definitions.h"
 #include "libvmdk_extent_file.h"
 #include "libvmdk_grain_data.h"
 #include "libvmdk_grain_group.h"
 #include "libvmdk_libbfio.h"
+#include "libvmdk_libcdata.h"
 #include "libvmdk_libcerror.h"
 #include "libvmdk_libcnotify.h"
 #include "libvmdk_libfcache.h"
@@ -140,20 +143,6 @@ int libvmdk_extent_file_initialize(
 		goto on_error;
 	}
 /* TODO set mapped offset in grain_groups_list ? */
-	if( libfcache_cache_initialize(
-	     &( ( *extent_file )->grain_groups_cache ),
-	     LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAIN_GROUPS,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create grain groups cache.",
-		 function );
-
-		goto on_error;
-	}
 	( *extent_file )->io_handle = io_handle;
 
 	return( 1 );
@@ -211,19 +200,6 @@ int libvmdk_extent_file_free(
 
 			result = -1;
 		}
-		if( libfcache_cache_free(
-		     &( ( *extent_file )->grain_groups_cache ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free grain groups cache.",
-			 function );
-
-			result = -1;
-		}
 		memory_free(
 		 *extent_file );
 
@@ -1374,7 +1350,102 @@ int libvmdk_extent_file_read_descriptor_data_file_io_handle(
 	return( 1 );
 }
 
+/* Reads the extent file header and grain directories
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_file_read_file_io_pool(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t extent_file_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_extent_file_read_file_io_pool";
+
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_extent_file_read_file_header(
+	     extent_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read extent file header from file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	/* Stream optimized extent files store the grain directory offset in the footer
+	 */
+	if( ( extent_file->file_type == LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
+	 && ( extent_file->primary_grain_directory_offset == (off64_t) -1 )
+	 && ( extent_file->compression_method == LIBVMDK_COMPRESSION_METHOD_DEFLATE ) )
+	{
+		if( extent_file_size < 1024 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extent file size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( libvmdk_extent_file_read_file_header(
+		     extent_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     extent_file_size - 1024,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read secondary extent file header from file IO pool entry: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+	}
+	if( libvmdk_extent_file_read_grain_directories(
+	     extent_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read grain directories from file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Reads the grain directories
+ * The backup grain directory is read, verified or skipped depending on the backup grain directory mode of the IO handle
  * Returns 1 if successful or -1 on error
  */
 int libvmdk_extent_file_read_grain_directories(
@@ -1447,7 +1518,8 @@ int libvmdk_extent_file_read_grain_directories(
 
 			return( -1 );
 		}
-		if( extent_file->primary_grain_directory_offset > 0 )
+		if( ( extent_file->primary_grain_directory_offset > 0 )
+		 && ( extent_file->io_handle->backup_grain_directory_mode != LIBVMDK_BACKUP_GRAIN_DIRECTORY_MODE_SKIP ) )
 		{
 #if defined( HAVE_DEBUG_OUTPUT )
 			if( libcnotify_verbose != 0 )
@@ -1527,7 +1599,8 @@ int libvmdk_extent_file_read_grain_directories(
 
 			return( -1 );
 		}
-		if( extent_file->secondary_grain_directory_offset > 0 )
+		if( ( extent_file->secondary_grain_directory_offset > 0 )
+		 && ( extent_file->io_handle->backup_grain_directory_mode != LIBVMDK_BACKUP_GRAIN_DIRECTORY_MODE_SKIP ) )
 		{
 #if defined( HAVE_DEBUG_OUTPUT )
 			if( libcnotify_verbose != 0 )
@@ -1835,7 +1908,148 @@ on_error:
 	return( -1 );
 }
 
+/* Compares the primary and secondary (backup) grain table
+ * Returns 1 if the grain tables are identical, 0 if not or -1 on error
+ */
+int libvmdk_extent_file_compare_grain_tables(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t primary_grain_table_offset,
+     off64_t secondary_grain_table_offset,
+     libcerror_error_t **error )
+{
+	uint8_t *primary_grain_table_data   = NULL;
+	uint8_t *secondary_grain_table_data = NULL;
+	static char *function               = "libvmdk_extent_file_compare_grain_tables";
+	ssize_t read_count                  = 0;
+	int result                          = 0;
+
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_file->grain_table_size == 0 )
+	 || ( extent_file->grain_table_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent file - grain table size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	primary_grain_table_data = (uint8_t *) memory_allocate(
+	                                        sizeof( uint8_t ) * extent_file->grain_table_size );
+
+	if( primary_grain_table_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create primary grain table data.",
+		 function );
+
+		goto on_error;
+	}
+	secondary_grain_table_data = (uint8_t *) memory_allocate(
+	                                          sizeof( uint8_t ) * extent_file->grain_table_size );
+
+	if( secondary_grain_table_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create secondary grain table data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_pool_read_buffer_at_offset(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              primary_grain_table_data,
+	              extent_file->grain_table_size,
+	              primary_grain_table_offset,
+	              error );
+
+	if( read_count != (ssize_t) extent_file->grain_table_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read primary grain table data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 primary_grain_table_offset,
+		 primary_grain_table_offset );
+
+		goto on_error;
+	}
+	read_count = libbfio_pool_read_buffer_at_offset(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              secondary_grain_table_data,
+	              extent_file->grain_table_size,
+	              secondary_grain_table_offset,
+	              error );
+
+	if( read_count != (ssize_t) extent_file->grain_table_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read secondary grain table data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 secondary_grain_table_offset,
+		 secondary_grain_table_offset );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     primary_grain_table_data,
+	     secondary_grain_table_data,
+	     extent_file->grain_table_size ) == 0 )
+	{
+		result = 1;
+	}
+	memory_free(
+	 secondary_grain_table_data );
+
+	memory_free(
+	 primary_grain_table_data );
+
+	return( result );
+
+on_error:
+	if( secondary_grain_table_data != NULL )
+	{
+		memory_free(
+		 secondary_grain_table_data );
+	}
+	if( primary_grain_table_data != NULL )
+	{
+		memory_free(
+		 primary_grain_table_data );
+	}
+	return( -1 );
+}
+
 /* Reads the backup grain directory
+ * If the backup grain directory mode of the IO handle is verify, the grain directory
+ * entries and the grain tables they refer to are compared with the grain groups list
  * Returns 1 if successful or -1 on error
  */
 int libvmdk_extent_file_read_backup_grain_directory(
@@ -1846,23 +2060,21 @@ int libvmdk_extent_file_read_backup_grain_directory(
      libcerror_error_t **error )
 {
 	uint8_t *grain_directory_data        = NULL;
+	uint8_t *grain_directory_entry       = NULL;
 	static char *function                = "libvmdk_extent_file_read_backup_grain_directory";
 	off64_t grain_group_offset           = 0;
+	off64_t grain_table_offset           = 0;
 	size64_t grain_data_size             = 0;
 	size64_t grain_group_size            = 0;
 	size64_t total_grain_data_size       = 0;
 	ssize_t read_count                   = 0;
 	uint32_t grain_directory_entry_index = 0;
 	uint32_t grain_group_range_flags     = 0;
+	uint32_t range_flags                 = 0;
+	uint8_t is_mismatch                  = 0;
 	int grain_group_file_io_pool_entry   = 0;
 	int number_of_grain_table_entries    = 0;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	uint8_t *grain_directory_entry       = NULL;
-	off64_t grain_table_offset           = 0;
-	uint32_t range_flags                 = 0;
 	int result                           = 0;
-#endif
 
 	if( extent_file == NULL )
 	{
@@ -1875,6 +2087,17 @@ int libvmdk_extent_file_read_backup_grain_directory(
 
 		return( -1 );
 	}
+	if( extent_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extent file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( ( extent_file->grain_directory_size == 0 )
 	 || ( extent_file->grain_directory_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
 	{
@@ -1957,17 +2180,18 @@ int libvmdk_extent_file_read_backup_grain_directory(
 		 extent_file->grain_directory_size,
 		 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
 	}
-	grain_directory_entry = grain_directory_data;
 #endif
+	grain_directory_entry = grain_directory_data;
+
 	for( grain_directory_entry_index = 0;
 	     grain_directory_entry_index < extent_file->number_of_grain_directory_entries;
 	     grain_directory_entry_index++ )
 	{
-#if defined( HAVE_DEBUG_OUTPUT )
 		byte_stream_copy_to_uint32_little_endian(
 		 grain_directory_entry,
 		 grain_table_offset );
 
+#if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
 			libcnotify_printf(
@@ -1976,6 +2200,7 @@ int libvmdk_extent_file_read_backup_grain_directory(
 			 grain_directory_entry_index,
 			 grain_table_offset );
 		}
+#endif
 		if( grain_table_offset != 0 )
 		{
 			range_flags         = 0;
@@ -1985,7 +2210,6 @@ int libvmdk_extent_file_read_backup_grain_directory(
 		{
 			range_flags = LIBVMDK_RANGE_FLAG_IS_SPARSE;
 		}
-#endif
 		number_of_grain_table_entries = (int) extent_file->number_of_grain_table_entries;
 		grain_data_size               = number_of_grain_table_entries * extent_file->grain_size;
 
@@ -2009,8 +2233,8 @@ int libvmdk_extent_file_read_backup_grain_directory(
 			 "%s: grain directory entry: %05" PRIu32 " offset\t\t\t: %" PRIi64 " (0x%08" PRIx64 ")\n",
 			 function,
 			 grain_directory_entry_index,
-			 grain_table_offset * 512,
-			 grain_table_offset * 512 );
+			 grain_table_offset,
+			 grain_table_offset );
 
 			libcnotify_printf(
 			 "%s: grain directory entry: %05" PRIu32 " size\t\t\t: %" PRIu64 " (%d)\n",
@@ -2060,12 +2284,61 @@ int libvmdk_extent_file_read_backup_grain_directory(
 
 			goto on_error;
 		}
-/* TODO compare grain directory entry with back up ? */
+		if( extent_file->io_handle->backup_grain_directory_mode == LIBVMDK_BACKUP_GRAIN_DIRECTORY_MODE_VERIFY )
+		{
+			is_mismatch = 0;
 
-		total_grain_data_size += grain_data_size;
+			if( ( grain_group_range_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != ( range_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) )
+			{
+				is_mismatch = 1;
+			}
+			else if( ( range_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) == 0 )
+			{
+				result = libvmdk_extent_file_compare_grain_tables(
+				          extent_file,
+				          file_io_pool,
+				          file_io_pool_entry,
+				          grain_group_offset,
+				          grain_table_offset,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to compare grain tables of grain directory entry: %" PRIu32 ".",
+					 function,
+					 grain_directory_entry_index );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+					is_mismatch = 1;
+				}
+			}
+			if( is_mismatch != 0 )
+			{
 #if defined( HAVE_DEBUG_OUTPUT )
-		grain_directory_entry += sizeof( uint32_t );
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: mismatch in grain directory entry: %" PRIu32 " primary offset: %" PRIi64 " (0x%08" PRIx64 "), secondary offset: %" PRIi64 " (0x%08" PRIx64 ").\n",
+					 function,
+					 grain_directory_entry_index,
+					 grain_group_offset,
+					 grain_group_offset,
+					 grain_table_offset,
+					 grain_table_offset );
+				}
 #endif
+				extent_file->number_of_grain_directory_mismatches += 1;
+			}
+		}
+		total_grain_data_size += grain_data_size;
+		grain_directory_entry += sizeof( uint32_t );
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -2114,26 +2387,816 @@ on_error:
 	return( -1 );
 }
 
-/* Reads the extent file
- * Callback function for the extent files list
+/* Retrieves the grain directory offsets
+ * The grain directory is the one used to read the grain tables, the backup grain directory
+ * is the other one or 0 if not available
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_extent_file_read_element_data(
-     libvmdk_io_handle_t *io_handle,
-     libbfio_pool_t *file_io_pool,
-     libfdata_list_element_t *element,
-     libfdata_cache_t *cache,
-     int file_io_pool_entry,
-     off64_t element_offset LIBVMDK_ATTRIBUTE_UNUSED,
-     size64_t extent_file_size,
-     uint32_t element_flags LIBVMDK_ATTRIBUTE_UNUSED,
-     uint8_t read_flags LIBVMDK_ATTRIBUTE_UNUSED,
+int libvmdk_extent_file_get_grain_directory_offsets(
+     libvmdk_extent_file_t *extent_file,
+     off64_t *grain_directory_offset,
+     off64_t *backup_grain_directory_offset,
      libcerror_error_t **error )
 {
-	libvmdk_extent_file_t *extent_file = NULL;
-	static char *function              = "libvmdk_extent_file_read_element_data";
+	static char *function = "libvmdk_extent_file_get_grain_directory_offsets";
 
-	LIBVMDK_UNREFERENCED_PARAMETER( element_offset )
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_directory_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain directory offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( backup_grain_directory_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid backup grain directory offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_file->file_type == LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
+	 && ( ( extent_file->flags & LIBVMDK_FLAG_USE_SECONDARY_GRAIN_DIRECTORY ) != 0 ) )
+	{
+		*grain_directory_offset        = extent_file->secondary_grain_directory_offset;
+		*backup_grain_directory_offset = extent_file->primary_grain_directory_offset;
+	}
+	else
+	{
+		*grain_directory_offset        = extent_file->primary_grain_directory_offset;
+		*backup_grain_directory_offset = extent_file->secondary_grain_directory_offset;
+	}
+	if( *backup_grain_directory_offset < 0 )
+	{
+		*backup_grain_directory_offset = 0;
+	}
+	return( 1 );
+}
+
+/* Checks the data of a single grain
+ * The grain data must be stored inside the extent data file. A compressed grain is decompressed,
+ * which also verifies its Adler-32 checksum, and its grain marker must refer to the sector number
+ * of the grain
+ * Read and decompression failures are not considered errors but are set in the corruption flags
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_file_check_grain_data(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t extent_file_size,
+     off64_t grain_data_offset,
+     uint64_t sector_number,
+     uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     uint32_t *corruption_flags,
+     libcerror_error_t **error )
+{
+	uint8_t compressed_data_header[ 12 ];
+
+	static char *function          = "libvmdk_extent_file_check_grain_data";
+	ssize_t read_count             = 0;
+	uint64_t grain_sector_number   = 0;
+	uint32_t grain_compressed_size = 0;
+
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_data_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid grain data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( corruption_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid corruption flags.",
+		 function );
+
+		return( -1 );
+	}
+	*corruption_flags = 0;
+
+	if( ( extent_file->flags & LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION ) == 0 )
+	{
+		if( ( (size64_t) grain_data_offset > extent_file_size )
+		 || ( extent_file->grain_size > ( extent_file_size - (size64_t) grain_data_offset ) ) )
+		{
+			*corruption_flags = LIBVMDK_CORRUPTION_FLAG_OUT_OF_BOUNDS;
+		}
+		return( 1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( (size64_t) grain_data_offset > extent_file_size )
+	 || ( ( extent_file_size - (size64_t) grain_data_offset ) < 12 ) )
+	{
+		*corruption_flags = LIBVMDK_CORRUPTION_FLAG_OUT_OF_BOUNDS;
+
+		return( 1 );
+	}
+	read_count = libbfio_pool_read_buffer_at_offset(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              compressed_data_header,
+	              12,
+	              grain_data_offset,
+	              error );
+
+	if( read_count != (ssize_t) 12 )
+	{
+		libcerror_error_free(
+		 error );
+
+		*corruption_flags = LIBVMDK_CORRUPTION_FLAG_READ_FAILED;
+
+		return( 1 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 compressed_data_header,
+	 grain_sector_number );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( compressed_data_header[ 8 ] ),
+	 grain_compressed_size );
+
+	if( grain_sector_number != sector_number )
+	{
+		*corruption_flags |= LIBVMDK_CORRUPTION_FLAG_GRAIN_HEADER_MISMATCH;
+	}
+	if( ( grain_compressed_size == 0 )
+	 || ( (size_t) grain_compressed_size > compressed_data_size ) )
+	{
+		*corruption_flags |= LIBVMDK_CORRUPTION_FLAG_GRAIN_HEADER_MISMATCH;
+
+		return( 1 );
+	}
+	if( (size64_t) grain_compressed_size > ( extent_file_size - (size64_t) grain_data_offset - 12 ) )
+	{
+		*corruption_flags |= LIBVMDK_CORRUPTION_FLAG_OUT_OF_BOUNDS;
+
+		return( 1 );
+	}
+	read_count = libbfio_pool_read_buffer_at_offset(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              compressed_data,
+	              (size_t) grain_compressed_size,
+	              grain_data_offset + 12,
+	              error );
+
+	if( read_count != (ssize_t) grain_compressed_size )
+	{
+		libcerror_error_free(
+		 error );
+
+		*corruption_flags |= LIBVMDK_CORRUPTION_FLAG_READ_FAILED;
+
+		return( 1 );
+	}
+	if( libvmdk_decompress_data(
+	     compressed_data,
+	     (size_t) grain_compressed_size,
+	     LIBVMDK_COMPRESSION_METHOD_DEFLATE,
+	     uncompressed_data,
+	     &uncompressed_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_free(
+		 error );
+
+		*corruption_flags |= LIBVMDK_CORRUPTION_FLAG_DECOMPRESSION_FAILED;
+	}
+	return( 1 );
+}
+
+/* Checks the integrity of a range of grain groups
+ * The grain directory data and backup grain directory data contain the raw grain directories,
+ * the backup grain directory data is optional. The grain tables are compared with their backup,
+ * if available, and the data of every grain in the grain tables is checked
+ * Corrupted ranges are appended to the corrupted ranges array, their (media) offsets include the extent offset
+ * This function only reads the extent file values and is therefore safe to call concurrently
+ * with a separate file IO pool per caller
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_file_check_grain_groups(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t extent_file_size,
+     off64_t extent_offset,
+     const uint8_t *grain_directory_data,
+     const uint8_t *backup_grain_directory_data,
+     uint32_t grain_directory_entry_index,
+     uint32_t number_of_grain_directory_entries,
+     libcdata_array_t *corrupted_ranges_array,
+     libcerror_error_t **error )
+{
+	uint8_t *backup_grain_table_data       = NULL;
+	uint8_t *compressed_data               = NULL;
+	uint8_t *grain_table_data              = NULL;
+	uint8_t *uncompressed_data             = NULL;
+	static char *function                  = "libvmdk_extent_file_check_grain_groups";
+	off64_t backup_grain_table_offset      = 0;
+	off64_t grain_data_offset              = 0;
+	off64_t grain_group_offset             = 0;
+	off64_t grain_offset                   = 0;
+	off64_t grain_table_offset             = 0;
+	size64_t grain_data_size               = 0;
+	size64_t grain_group_data_size         = 0;
+	size64_t grain_group_size              = 0;
+	size64_t grain_size                    = 0;
+	size_t compressed_data_size            = 0;
+	ssize_t read_count                     = 0;
+	uint32_t corruption_flags              = 0;
+	uint32_t grain_corruption_flags        = 0;
+	uint32_t grain_table_entry_index       = 0;
+	uint32_t last_grain_directory_entry    = 0;
+	uint32_t number_of_grain_table_entries = 0;
+
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extent file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_file->grain_size == 0 )
+	 || ( extent_file->grain_size > (size64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / 2 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent file - grain size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_file->grain_table_size == 0 )
+	 || ( extent_file->grain_table_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	 || ( extent_file->grain_table_size < ( (size_t) extent_file->number_of_grain_table_entries * 4 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent file - grain table size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_directory_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain directory data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( grain_directory_entry_index > extent_file->number_of_grain_directory_entries )
+	 || ( number_of_grain_directory_entries > ( extent_file->number_of_grain_directory_entries - grain_directory_entry_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of grain directory entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	grain_size            = extent_file->grain_size;
+	grain_group_data_size = (size64_t) extent_file->number_of_grain_table_entries * grain_size;
+
+	grain_table_data = (uint8_t *) memory_allocate(
+	                                sizeof( uint8_t ) * extent_file->grain_table_size );
+
+	if( grain_table_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain table data.",
+		 function );
+
+		goto on_error;
+	}
+	if( backup_grain_directory_data != NULL )
+	{
+		backup_grain_table_data = (uint8_t *) memory_allocate(
+		                                       sizeof( uint8_t ) * extent_file->grain_table_size );
+
+		if( backup_grain_table_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create backup grain table data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( extent_file->flags & LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION ) != 0 )
+	{
+		/* Compressed data of incompressible grain data can be slightly larger than the grain
+		 */
+		compressed_data_size = (size_t) ( grain_size * 2 );
+
+		compressed_data = (uint8_t *) memory_allocate(
+		                               sizeof( uint8_t ) * compressed_data_size );
+
+		if( compressed_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create compressed data.",
+			 function );
+
+			goto on_error;
+		}
+		uncompressed_data = (uint8_t *) memory_allocate(
+		                                 sizeof( uint8_t ) * (size_t) grain_size );
+
+		if( uncompressed_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create uncompressed data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	last_grain_directory_entry = grain_directory_entry_index + number_of_grain_directory_entries;
+
+	for( ;
+	     grain_directory_entry_index < last_grain_directory_entry;
+	     grain_directory_entry_index++ )
+	{
+		if( extent_file->io_handle->abort != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+			 "%s: abort requested.",
+			 function );
+
+			goto on_error;
+		}
+		grain_group_offset = (off64_t) ( grain_directory_entry_index * grain_group_data_size );
+
+		if( (size64_t) grain_group_offset >= extent_file->maximum_data_size )
+		{
+			break;
+		}
+		grain_group_size = extent_file->maximum_data_size - (size64_t) grain_group_offset;
+
+		if( grain_group_size > grain_group_data_size )
+		{
+			grain_group_size = grain_group_data_size;
+		}
+		corruption_flags = 0;
+
+		byte_stream_copy_to_uint32_little_endian(
+		 &( grain_directory_data[ grain_directory_entry_index * 4 ] ),
+		 grain_table_offset );
+
+		if( backup_grain_directory_data != NULL )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 &( backup_grain_directory_data[ grain_directory_entry_index * 4 ] ),
+			 backup_grain_table_offset );
+
+			if( ( grain_table_offset == 0 ) != ( backup_grain_table_offset == 0 ) )
+			{
+				corruption_flags = LIBVMDK_CORRUPTION_FLAG_GRAIN_DIRECTORY_MISMATCH;
+			}
+		}
+		if( grain_table_offset != 0 )
+		{
+			grain_table_offset *= 512;
+
+			if( ( (size64_t) grain_table_offset > extent_file_size )
+			 || ( (size64_t) extent_file->grain_table_size > ( extent_file_size - (size64_t) grain_table_offset ) ) )
+			{
+				corruption_flags |= LIBVMDK_CORRUPTION_FLAG_OUT_OF_BOUNDS;
+			}
+			else
+			{
+				read_count = libbfio_pool_read_buffer_at_offset(
+				              file_io_pool,
+				              file_io_pool_entry,
+				              grain_table_data,
+				              extent_file->grain_table_size,
+				              grain_table_offset,
+				              error );
+
+				if( read_count != (ssize_t) extent_file->grain_table_size )
+				{
+					libcerror_error_free(
+					 error );
+
+					corruption_flags |= LIBVMDK_CORRUPTION_FLAG_READ_FAILED;
+				}
+			}
+		}
+		if( ( grain_table_offset != 0 )
+		 && ( backup_grain_table_offset != 0 )
+		 && ( backup_grain_table_data != NULL )
+		 && ( corruption_flags == 0 ) )
+		{
+			backup_grain_table_offset *= 512;
+
+			if( ( (size64_t) backup_grain_table_offset > extent_file_size )
+			 || ( (size64_t) extent_file->grain_table_size > ( extent_file_size - (size64_t) backup_grain_table_offset ) ) )
+			{
+				corruption_flags = LIBVMDK_CORRUPTION_FLAG_GRAIN_TABLE_MISMATCH;
+			}
+			else
+			{
+				read_count = libbfio_pool_read_buffer_at_offset(
+				              file_io_pool,
+				              file_io_pool_entry,
+				              backup_grain_table_data,
+				              extent_file->grain_table_size,
+				              backup_grain_table_offset,
+				              error );
+
+				if( read_count != (ssize_t) extent_file->grain_table_size )
+				{
+					libcerror_error_free(
+					 error );
+
+					corruption_flags = LIBVMDK_CORRUPTION_FLAG_GRAIN_TABLE_MISMATCH;
+				}
+				else if( memory_compare(
+				          grain_table_data,
+				          backup_grain_table_data,
+				          extent_file->grain_table_size ) != 0 )
+				{
+					corruption_flags = LIBVMDK_CORRUPTION_FLAG_GRAIN_TABLE_MISMATCH;
+				}
+			}
+		}
+		if( corruption_flags != 0 )
+		{
+			if( libvmdk_corrupted_range_append_to_array(
+			     corrupted_ranges_array,
+			     extent_offset + grain_group_offset,
+			     grain_group_size,
+			     file_io_pool_entry,
+			     corruption_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append corrupted range of grain group: %" PRIu32 ".",
+				 function,
+				 grain_directory_entry_index );
+
+				goto on_error;
+			}
+		}
+		/* The grains cannot be checked if the grain table is sparse or could not be read
+		 */
+		if( ( grain_table_offset == 0 )
+		 || ( ( corruption_flags & ( LIBVMDK_CORRUPTION_FLAG_OUT_OF_BOUNDS | LIBVMDK_CORRUPTION_FLAG_READ_FAILED ) ) != 0 ) )
+		{
+			continue;
+		}
+		number_of_grain_table_entries = (uint32_t) ( grain_group_size / grain_size );
+
+		if( ( grain_group_size % grain_size ) != 0 )
+		{
+			number_of_grain_table_entries += 1;
+		}
+		for( grain_table_entry_index = 0;
+		     grain_table_entry_index < number_of_grain_table_entries;
+		     grain_table_entry_index++ )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 &( grain_table_data[ grain_table_entry_index * 4 ] ),
+			 grain_data_offset );
+
+			if( grain_data_offset == 0 )
+			{
+				continue;
+			}
+			grain_data_offset *= 512;
+			grain_offset       = grain_group_offset + (off64_t) ( grain_table_entry_index * grain_size );
+			grain_data_size    = extent_file->maximum_data_size - (size64_t) grain_offset;
+
+			if( grain_data_size > grain_size )
+			{
+				grain_data_size = grain_size;
+			}
+
+			if( libvmdk_extent_file_check_grain_data(
+			     extent_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     extent_file_size,
+			     grain_data_offset,
+			     (uint64_t) ( extent_offset + grain_offset ) / 512,
+			     compressed_data,
+			     compressed_data_size,
+			     uncompressed_data,
+			     (size_t) grain_size,
+			     &grain_corruption_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to check grain: %" PRIu32 " of grain group: %" PRIu32 ".",
+				 function,
+				 grain_table_entry_index,
+				 grain_directory_entry_index );
+
+				goto on_error;
+			}
+			if( grain_corruption_flags != 0 )
+			{
+				if( libvmdk_corrupted_range_append_to_array(
+				     corrupted_ranges_array,
+				     extent_offset + grain_offset,
+				     grain_data_size,
+				     file_io_pool_entry,
+				     grain_corruption_flags,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append corrupted range of grain: %" PRIu32 " of grain group: %" PRIu32 ".",
+					 function,
+					 grain_table_entry_index,
+					 grain_directory_entry_index );
+
+					goto on_error;
+				}
+			}
+		}
+	}
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	if( backup_grain_table_data != NULL )
+	{
+		memory_free(
+		 backup_grain_table_data );
+	}
+	memory_free(
+	 grain_table_data );
+
+	return( 1 );
+
+on_error:
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	if( backup_grain_table_data != NULL )
+	{
+		memory_free(
+		 backup_grain_table_data );
+	}
+	if( grain_table_data != NULL )
+	{
+		memory_free(
+		 grain_table_data );
+	}
+	return( -1 );
+}
+
+/* Validates the extent file against the IO handle and updates the IO handle with its values
+ * The first extent file determines the grain size of the IO handle
+ * The mapped size contains the size of the extent in the descriptor file or 0 if the extent
+ * is mapped using the storage media size of the extent file. The storage media size is allowed
+ * to exceed the mapped size by less than a grain
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_file_validate(
+     libvmdk_extent_file_t *extent_file,
+     libvmdk_io_handle_t *io_handle,
+     int extent_index,
+     size64_t mapped_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_extent_file_validate";
+
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_file->file_type != LIBVMDK_FILE_TYPE_COWD_SPARSE_DATA )
+	 && ( extent_file->file_type != LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: extent file type not supported for extent type.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_handle->disk_type != LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
+	 && ( extent_file->file_type == LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
+	 && ( ( extent_file->flags & LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION ) != LIBVMDK_COMPRESSION_METHOD_NONE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: grain compression not supported for disk type.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index == 0 )
+	{
+		io_handle->grain_size = extent_file->grain_size;
+	}
+	else if( extent_file->grain_size != io_handle->grain_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: extent file: %d grain size mismatch.",
+		 function,
+		 extent_index );
+
+		return( -1 );
+	}
+	if( mapped_size != 0 )
+	{
+		if( ( extent_file->storage_media_size < mapped_size )
+		 || ( ( extent_file->storage_media_size - mapped_size ) >= extent_file->grain_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: extent file: %d storage media size mismatch.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+	}
+	if( extent_file->is_dirty != 0 )
+	{
+		io_handle->is_dirty = 1;
+	}
+	io_handle->number_of_grain_directory_mismatches += extent_file->number_of_grain_directory_mismatches;
+
+	return( 1 );
+}
+
+/* Reads the extent file
+ * Callback function for the extent files list
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_file_read_element_data(
+     libvmdk_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfdata_cache_t *cache,
+     int file_io_pool_entry,
+     off64_t element_offset LIBVMDK_ATTRIBUTE_UNUSED,
+     size64_t extent_file_size,
+     uint32_t element_flags LIBVMDK_ATTRIBUTE_UNUSED,
+     uint8_t read_flags LIBVMDK_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	libvmdk_extent_file_t *extent_file = NULL;
+	static char *function              = "libvmdk_extent_file_read_element_data";
+	size64_t mapped_size               = 0;
+	int element_index                  = 0;
+	int result                         = 0;
+
+	LIBVMDK_UNREFERENCED_PARAMETER( element_offset )
 	LIBVMDK_UNREFERENCED_PARAMETER( element_flags )
 	LIBVMDK_UNREFERENCED_PARAMETER( read_flags )
 
@@ -2162,58 +3225,70 @@ int libvmdk_extent_file_read_element_data(
 
 		goto on_error;
 	}
-	if( libvmdk_extent_file_read_file_header(
+	if( libvmdk_extent_file_read_file_io_pool(
 	     extent_file,
 	     file_io_pool,
 	     file_io_pool_entry,
-	     0,
+	     extent_file_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read extent file header from file IO pool entry: %d.",
+		 "%s: unable to read extent file from file IO pool entry: %d.",
 		 function,
 		 file_io_pool_entry );
 
 		goto on_error;
 	}
-	if( ( extent_file->file_type == LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
-	 && ( extent_file->primary_grain_directory_offset == (off64_t) -1 )
-	 && ( extent_file->compression_method == LIBVMDK_COMPRESSION_METHOD_DEFLATE ) )
+	if( libfdata_list_element_get_element_index(
+	     element,
+	     &element_index,
+	     error ) != 1 )
 	{
-		if( libvmdk_extent_file_read_file_header(
-		     extent_file,
-		     file_io_pool,
-		     file_io_pool_entry,
-		     extent_file_size - 1024,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read secondary extent file header from file IO pool entry: %d.",
-			 function,
-			 file_io_pool_entry );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element index.",
+		 function );
 
-			goto on_error;
-		}
+		goto on_error;
+	}
+	/* The extent is mapped using the extent size of the descriptor file
+	 */
+	result = libfdata_list_element_get_mapped_size(
+	          element,
+	          &mapped_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element: %d mapped size.",
+		 function,
+		 element_index );
+
+		goto on_error;
 	}
-	if( libvmdk_extent_file_read_grain_directory(
+	if( libvmdk_extent_file_validate(
 	     extent_file,
-	     file_io_pool,
-	     file_io_pool_entry,
-	     extent_file->primary_grain_directory_offset,
+	     io_handle,
+	     element_index,
+	     mapped_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read primary grain directory.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported extent file: %d.",
+		 function,
+		 element_index );
 
 		goto on_error;
 	}
@@ -2549,6 +3624,7 @@ int libvmdk_extent_file_grain_group_is_sparse_at_offset(
 int libvmdk_extent_file_get_grain_group_at_offset(
      libvmdk_extent_file_t *extent_file,
      libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *grain_groups_cache,
      off64_t offset,
      int *grain_group_index,
      off64_t *grain_group_data_offset,
@@ -2572,7 +3648,7 @@ int libvmdk_extent_file_get_grain_group_at_offset(
 	result = libfdata_list_get_element_value_at_offset(
 		  extent_file->grain_groups_list,
 		  (intptr_t *) file_io_pool,
-		  (libfdata_cache_t *) extent_file->grain_groups_cache,
+		  (libfdata_cache_t *) grain_groups_cache,
 		  offset,
 		  grain_group_index,
 		  grain_group_data_offset,
@@ -2595,6 +3671,103 @@ int libvmdk_extent_file_get_grain_group_at_offset(
 	return( result );
 }
 
+/* Retrieves the range of the grain group at a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_file_get_grain_group_range_at_offset(
+     libvmdk_extent_file_t *extent_file,
+     off64_t offset,
+     int *grain_group_index,
+     off64_t *grain_group_data_offset,
+     size64_t *grain_group_size,
+     uint32_t *grain_group_flags,
+     libcerror_error_t **error )
+{
+	static char *function      = "libvmdk_extent_file_get_grain_group_range_at_offset";
+	off64_t grain_group_offset = 0;
+	int grain_group_file_index = 0;
+
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_element_at_offset(
+	     extent_file->grain_groups_list,
+	     offset,
+	     grain_group_index,
+	     grain_group_data_offset,
+	     &grain_group_file_index,
+	     &grain_group_offset,
+	     grain_group_size,
+	     grain_group_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grains group element at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific grain group
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_file_get_grain_group_by_index(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *grain_groups_cache,
+     int grain_group_index,
+     libfdata_list_t **grains_list,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_extent_file_get_grain_group_by_index";
+
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_element_value_by_index(
+	     extent_file->grain_groups_list,
+	     (intptr_t *) file_io_pool,
+	     (libfdata_cache_t *) grain_groups_cache,
+	     grain_group_index,
+	     (intptr_t **) grains_list,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grains list: %d.",
+		 function,
+		 grain_group_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Reads segment data into a buffer
  * Callback function for the segments stream
  * Returns the number of bytes read or -1 on error
@@ -27,6 +27,7 @@
 
 #include "libvmdk_io_handle.h"
 #include "libvmdk_libbfio.h"
+#include "libvmdk_libcdata.h"
 #include "libvmdk_libcerror.h"
 #include "libvmdk_libfcache.h"
 #include "libvmdk_libfdata.h"
@@ -106,13 +107,14 @@ struct libvmdk_extent_file
 	 */
 	uint8_t is_dirty;
 
-	/* The grain groups list
+	/* The number of grain directory entries that differ between
+	 * the primary and secondary (backup) grain directory
 	 */
-	libfdata_list_t *grain_groups_list;
+	uint32_t number_of_grain_directory_mismatches;
 
-	/* The grain groups cache
+	/* The grain groups list
 	 */
-	libfcache_cache_t *grain_groups_cache;
+	libfdata_list_t *grain_groups_list;
 
 	/* The (current) grain groups index
 	 */
@@ -163,6 +165,13 @@ int libvmdk_extent_file_read_descriptor_data_file_io_handle(
      size_t descriptor_data_size,
      libcerror_error_t **error );
 
+int libvmdk_extent_file_read_file_io_pool(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t extent_file_size,
+     libcerror_error_t **error );
+
 int libvmdk_extent_file_read_grain_directories(
      libvmdk_extent_file_t *extent_file,
      libbfio_pool_t *file_io_pool,
@@ -176,6 +185,14 @@ int libvmdk_extent_file_read_grain_directory(
      off64_t file_offset,
      libcerror_error_t **error );
 
+int libvmdk_extent_file_compare_grain_tables(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t primary_grain_table_offset,
+     off64_t secondary_grain_table_offset,
+     libcerror_error_t **error );
+
 int libvmdk_extent_file_read_backup_grain_directory(
      libvmdk_extent_file_t *extent_file,
      libbfio_pool_t *file_io_pool,
@@ -183,12 +200,52 @@ int libvmdk_extent_file_read_backup_grain_directory(
      off64_t file_offset,
      libcerror_error_t **error );
 
+int libvmdk_extent_file_get_grain_directory_offsets(
+     libvmdk_extent_file_t *extent_file,
+     off64_t *grain_directory_offset,
+     off64_t *backup_grain_directory_offset,
+     libcerror_error_t **error );
+
+int libvmdk_extent_file_check_grain_data(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t extent_file_size,
+     off64_t grain_data_offset,
+     uint64_t sector_number,
+     uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     uint32_t *corruption_flags,
+     libcerror_error_t **error );
+
+int libvmdk_extent_file_check_grain_groups(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t extent_file_size,
+     off64_t extent_offset,
+     const uint8_t *grain_directory_data,
+     const uint8_t *backup_grain_directory_data,
+     uint32_t grain_directory_entry_index,
+     uint32_t number_of_grain_directory_entries,
+     libcdata_array_t *corrupted_ranges_array,
+     libcerror_error_t **error );
+
 int libvmdk_extent_file_read_grains_scan(
      libvmdk_extent_file_t *extent_file,
      libbfio_pool_t *file_io_pool,
      int file_io_pool_entry,
      libcerror_error_t **error );
 
+int libvmdk_extent_file_validate(
+     libvmdk_extent_file_t *extent_file,
+     libvmdk_io_handle_t *io_handle,
+     int extent_index,
+     size64_t mapped_size,
+     libcerror_error_t **error );
+
 int libvmdk_extent_file_read_element_data(
      libvmdk_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
@@ -223,12 +280,30 @@ int libvmdk_extent_file_grain_group_is_sparse_at_offset(
 int libvmdk_extent_file_get_grain_group_at_offset(
      libvmdk_extent_file_t *extent_file,
      libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *grain_groups_cache,
      off64_t offset,
      int *grain_group_index,
      off64_t *grain_group_data_offset,
      libfdata_list_t **grains_list,
      libcerror_error_t **error );
 
+int libvmdk_extent_file_get_grain_group_range_at_offset(
+     libvmdk_extent_file_t *extent_file,
+     off64_t offset,
+     int *grain_group_index,
+     off64_t *grain_group_data_offset,
+     size64_t *grain_group_size,
+     uint32_t *grain_group_flags,
+     libcerror_error_t **error );
+
+int libvmdk_extent_file_get_grain_group_by_index(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *grain_groups_cache,
+     int grain_group_index,
+     libfdata_list_t **grains_list,
+     libcerror_error_t **error );
+
 ssize_t libvmdk_extent_file_read_segment_data(
          intptr_t *data_handle,
          libbfio_pool_t *file_io_pool,
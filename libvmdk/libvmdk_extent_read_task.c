@@ -0,0 +1,387 @@
+/*
+ * Extent read task functions
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_extent_file.h"
+#include "libvmdk_extent_read_task.h"
+#include "libvmdk_io_handle.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_unused.h"
+
+/* Creates an extent read task
+ * Make sure the value extent_read_task is referencing, is set to NULL
+ *
+ * The task reads the extent data file using a clone of its file IO handle
+ * so that multiple extent data files can be read concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_read_task_initialize(
+     libvmdk_extent_read_task_t **extent_read_task,
+     libvmdk_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     int extent_index,
+     size64_t extent_file_size,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle        = NULL;
+	libbfio_handle_t *source_file_io_handle = NULL;
+	static char *function                   = "libvmdk_extent_read_task_initialize";
+
+	if( extent_read_task == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent read task.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extent_read_task != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid extent read task value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_get_handle(
+	     file_io_pool,
+	     extent_index,
+	     &source_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d from pool.",
+		 function,
+		 extent_index );
+
+		return( -1 );
+	}
+	*extent_read_task = memory_allocate_structure(
+	                     libvmdk_extent_read_task_t );
+
+	if( *extent_read_task == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create extent read task.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *extent_read_task,
+	     0,
+	     sizeof( libvmdk_extent_read_task_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear extent read task.",
+		 function );
+
+		memory_free(
+		 *extent_read_task );
+
+		*extent_read_task = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_handle_clone(
+	     &file_io_handle,
+	     source_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to clone file IO handle: %d.",
+		 function,
+		 extent_index );
+
+		goto on_error;
+	}
+	/* The extent index is used as the file IO pool entry since it is stored
+	 * in the grain groups list of the extent file
+	 */
+	if( libbfio_pool_initialize(
+	     &( ( *extent_read_task )->file_io_pool ),
+	     extent_index + 1,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_set_handle(
+	     ( *extent_read_task )->file_io_pool,
+	     extent_index,
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file IO handle: %d in pool.",
+		 function,
+		 extent_index );
+
+		goto on_error;
+	}
+	file_io_handle = NULL;
+
+	( *extent_read_task )->io_handle        = io_handle;
+	( *extent_read_task )->extent_index     = extent_index;
+	( *extent_read_task )->extent_file_size = extent_file_size;
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( *extent_read_task != NULL )
+	{
+		if( ( *extent_read_task )->file_io_pool != NULL )
+		{
+			libbfio_pool_free(
+			 &( ( *extent_read_task )->file_io_pool ),
+			 NULL );
+		}
+		memory_free(
+		 *extent_read_task );
+
+		*extent_read_task = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an extent read task
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_read_task_free(
+     libvmdk_extent_read_task_t **extent_read_task,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_extent_read_task_free";
+	int result            = 1;
+
+	if( extent_read_task == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent read task.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extent_read_task != NULL )
+	{
+		if( ( *extent_read_task )->file_io_pool != NULL )
+		{
+			if( libbfio_pool_close_all(
+			     ( *extent_read_task )->file_io_pool,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close all file IO handles in pool.",
+				 function );
+
+				result = -1;
+			}
+			if( libbfio_pool_free(
+			     &( ( *extent_read_task )->file_io_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *extent_read_task )->extent_file != NULL )
+		{
+			if( libvmdk_extent_file_free(
+			     &( ( *extent_read_task )->extent_file ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free extent file.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *extent_read_task )->error != NULL )
+		{
+			libcerror_error_free(
+			 &( ( *extent_read_task )->error ) );
+		}
+		memory_free(
+		 *extent_read_task );
+
+		*extent_read_task = NULL;
+	}
+	return( result );
+}
+
+/* Reads the extent file header and grain directories
+ * Callback function for the thread pool, the outcome is stored in the task
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_read_task_run(
+     libvmdk_extent_read_task_t *extent_read_task,
+     void *arguments LIBVMDK_ATTRIBUTE_UNUSED )
+{
+	static char *function = "libvmdk_extent_read_task_run";
+
+	LIBVMDK_UNREFERENCED_PARAMETER( arguments )
+
+	if( extent_read_task == NULL )
+	{
+		return( -1 );
+	}
+	extent_read_task->result = -1;
+
+	if( extent_read_task->io_handle->abort != 0 )
+	{
+		libcerror_error_set(
+		 &( extent_read_task->error ),
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+		 "%s: abort requested.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_extent_file_initialize(
+	     &( extent_read_task->extent_file ),
+	     extent_read_task->io_handle,
+	     &( extent_read_task->error ) ) != 1 )
+	{
+		libcerror_error_set(
+		 &( extent_read_task->error ),
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create extent file: %d.",
+		 function,
+		 extent_read_task->extent_index );
+
+		return( -1 );
+	}
+	if( libvmdk_extent_file_read_file_io_pool(
+	     extent_read_task->extent_file,
+	     extent_read_task->file_io_pool,
+	     extent_read_task->extent_index,
+	     extent_read_task->extent_file_size,
+	     &( extent_read_task->error ) ) != 1 )
+	{
+		libcerror_error_set(
+		 &( extent_read_task->error ),
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read extent file: %d.",
+		 function,
+		 extent_read_task->extent_index );
+
+		return( -1 );
+	}
+	/* The file IO handle is no longer needed once the metadata has been read
+	 */
+	if( libbfio_pool_close_all(
+	     extent_read_task->file_io_pool,
+	     &( extent_read_task->error ) ) != 0 )
+	{
+		libcerror_error_set(
+		 &( extent_read_task->error ),
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	extent_read_task->result = 1;
+
+	return( 1 );
+}
+
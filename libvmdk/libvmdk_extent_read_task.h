@@ -0,0 +1,91 @@
+/*
+ * Extent read task functions
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_EXTENT_READ_TASK_H )
+#define _LIBVMDK_EXTENT_READ_TASK_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_extent_file.h"
+#include "libvmdk_io_handle.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_extent_read_task libvmdk_extent_read_task_t;
+
+struct libvmdk_extent_read_task
+{
+	/* The IO handle
+	 */
+	libvmdk_io_handle_t *io_handle;
+
+	/* The file IO pool that only contains the extent data file
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The extent index
+	 */
+	int extent_index;
+
+	/* The extent file size
+	 */
+	size64_t extent_file_size;
+
+	/* The extent file
+	 */
+	libvmdk_extent_file_t *extent_file;
+
+	/* The result of the task
+	 */
+	int result;
+
+	/* The error of the task
+	 */
+	libcerror_error_t *error;
+};
+
+int libvmdk_extent_read_task_initialize(
+     libvmdk_extent_read_task_t **extent_read_task,
+     libvmdk_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     int extent_index,
+     size64_t extent_file_size,
+     libcerror_error_t **error );
+
+int libvmdk_extent_read_task_free(
+     libvmdk_extent_read_task_t **extent_read_task,
+     libcerror_error_t **error );
+
+int libvmdk_extent_read_task_run(
+     libvmdk_extent_read_task_t *extent_read_task,
+     void *arguments );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_EXTENT_READ_TASK_H ) */
+
@@ -178,8 +178,9 @@ int libvmdk_extent_table_clear(
      libvmdk_extent_table_t *extent_table,
      libcerror_error_t **error )
 {
-	static char *function = "libvmdk_extent_table_clear";
-	int result            = 1;
+	libvmdk_io_handle_t *io_handle = NULL;
+	static char *function          = "libvmdk_extent_table_clear";
+	int result                     = 1;
 
 	if( extent_table == NULL )
 	{
@@ -232,6 +233,22 @@ int libvmdk_extent_table_clear(
 			result = -1;
 		}
 	}
+	if( extent_table->grain_groups_cache != NULL )
+	{
+		if( libfcache_cache_free(
+		     &( extent_table->grain_groups_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free grain groups cache.",
+			 function );
+
+			result = -1;
+		}
+	}
 	if( extent_table->extent_files_stream != NULL )
 	{
 		if( libfdata_stream_free(
@@ -248,6 +265,21 @@ int libvmdk_extent_table_clear(
 			result = -1;
 		}
 	}
+	if( extent_table->extent_sizes != NULL )
+	{
+		memory_free(
+		 extent_table->extent_sizes );
+	}
+	if( extent_table->extent_offsets != NULL )
+	{
+		memory_free(
+		 extent_table->extent_offsets );
+	}
+	/* The IO handle is retained since it is used by the extent files list
+	 * when the extent table is reused after the handle was closed
+	 */
+	io_handle = extent_table->io_handle;
+
 	if( memory_set(
 	     extent_table,
 	     0,
@@ -262,6 +294,8 @@ int libvmdk_extent_table_clear(
 
 		result = -1;
 	}
+	extent_table->io_handle = io_handle;
+
 	return( result );
 }
 
@@ -1719,8 +1753,9 @@ int libvmdk_extent_table_initialize_extents(
      int disk_type,
      libcerror_error_t **error )
 {
-	static char *function = "libvmdk_extent_table_initialize_extents";
-	int result            = 0;
+	static char *function              = "libvmdk_extent_table_initialize_extents";
+	int maximum_number_of_extent_files = 0;
+	int result                         = 0;
 
 	if( extent_table == NULL )
 	{
@@ -1733,6 +1768,40 @@ int libvmdk_extent_table_initialize_extents(
 
 		return( -1 );
 	}
+	if( extent_table->extent_sizes != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid extent table - extent sizes value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->extent_offsets != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid extent table - extent offsets value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_extents < 0 )
+	 || ( (size_t) number_of_extents >= ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( off64_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of extents value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 	if( ( disk_type != LIBVMDK_DISK_TYPE_FLAT_2GB_EXTENT )
 	 && ( disk_type != LIBVMDK_DISK_TYPE_MONOLITHIC_FLAT )
 	 && ( disk_type != LIBVMDK_DISK_TYPE_SPARSE_2GB_EXTENT )
@@ -1838,9 +1907,20 @@ int libvmdk_extent_table_initialize_extents(
 
 			goto on_error;
 		}
+		/* The extent files only contain the extent file header values and
+		 * grain directory, hence they are kept for every extent so that they
+		 * do not need to be read again. The grain groups they refer to are
+		 * cached in the shared grain groups cache.
+		 */
+		maximum_number_of_extent_files = number_of_extents;
+
+		if( maximum_number_of_extent_files < LIBVMDK_MAXIMUM_CACHE_ENTRIES_EXTENT_FILES )
+		{
+			maximum_number_of_extent_files = LIBVMDK_MAXIMUM_CACHE_ENTRIES_EXTENT_FILES;
+		}
 		result = libfcache_cache_initialize(
 			  &( extent_table->extent_files_cache ),
-			  LIBVMDK_MAXIMUM_CACHE_ENTRIES_EXTENT_FILES,
+			  maximum_number_of_extent_files,
 			  error );
 
 		if( result != 1 )
@@ -1854,13 +1934,118 @@ int libvmdk_extent_table_initialize_extents(
 
 			goto on_error;
 		}
+		result = libfcache_cache_initialize(
+			  &( extent_table->grain_groups_cache ),
+			  LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAIN_GROUPS,
+			  error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create grain groups cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( number_of_extents > 0 )
+	{
+		extent_table->extent_sizes = (size64_t *) memory_allocate(
+		                                           sizeof( size64_t ) * number_of_extents );
+
+		if( extent_table->extent_sizes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create extent sizes.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     extent_table->extent_sizes,
+		     0,
+		     sizeof( size64_t ) * number_of_extents ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear extent sizes.",
+			 function );
+
+			goto on_error;
+		}
+		/* The extent offsets contain an additional entry for the end of the last extent
+		 */
+		extent_table->extent_offsets = (off64_t *) memory_allocate(
+		                                            sizeof( off64_t ) * ( number_of_extents + 1 ) );
+
+		if( extent_table->extent_offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create extent offsets.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     extent_table->extent_offsets,
+		     0,
+		     sizeof( off64_t ) * ( number_of_extents + 1 ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear extent offsets.",
+			 function );
+
+			goto on_error;
+		}
 	}
-	extent_table->number_of_extents = number_of_extents;
-	extent_table->disk_type         = disk_type;
+	extent_table->number_of_extents        = number_of_extents;
+	extent_table->disk_type                = disk_type;
+	extent_table->uniform_extent_size      = 0;
+	extent_table->extent_offsets_are_dirty = 1;
 
 	return( 1 );
 
 on_error:
+	if( extent_table->extent_offsets != NULL )
+	{
+		memory_free(
+		 extent_table->extent_offsets );
+
+		extent_table->extent_offsets = NULL;
+	}
+	if( extent_table->extent_sizes != NULL )
+	{
+		memory_free(
+		 extent_table->extent_sizes );
+
+		extent_table->extent_sizes = NULL;
+	}
+	if( extent_table->grain_groups_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &( extent_table->grain_groups_cache ),
+		 NULL );
+	}
+	if( extent_table->extent_files_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &( extent_table->extent_files_cache ),
+		 NULL );
+	}
 	if( extent_table->extent_files_list != NULL )
 	{
 		libfdata_list_free(
@@ -1898,6 +2083,40 @@ int libvmdk_extent_table_set_extent_storage_media_size_by_index(
 
 		return( -1 );
 	}
+	if( extent_table->extent_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extent table - missing extent sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_index < 0 )
+	 || ( extent_index >= extent_table->number_of_extents ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid storage media size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfdata_list_set_mapped_size_by_index(
 	     extent_table->extent_files_list,
 	     extent_index,
@@ -1914,22 +2133,26 @@ int libvmdk_extent_table_set_extent_storage_media_size_by_index(
 
 		return( -1 );
 	}
+	extent_table->extent_sizes[ extent_index ] = storage_media_size;
+	extent_table->extent_offsets_are_dirty     = 1;
+
 	return( 1 );
 }
 
-/* Retrieves an extent file at a specific offset from the extent table
+/* Calculates the extent offsets from the extent sizes
+ * If all extents, except for the last, are of equal size the extent index
+ * of an offset is calculated directly, otherwise the extent offsets are searched
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_extent_table_get_extent_file_at_offset(
+int libvmdk_extent_table_calculate_extent_offsets(
      libvmdk_extent_table_t *extent_table,
-     off64_t offset,
-     libbfio_pool_t *file_io_pool,
-     int *extent_index,
-     off64_t *extent_file_data_offset,
-     libvmdk_extent_file_t **extent_file,
      libcerror_error_t **error )
 {
-	static char *function = "libvmdk_extent_table_get_extent_file_at_offset";
+	static char *function        = "libvmdk_extent_table_calculate_extent_offsets";
+	size64_t extent_size         = 0;
+	size64_t uniform_extent_size = 0;
+	off64_t extent_offset        = 0;
+	int extent_index             = 0;
 
 	if( extent_table == NULL )
 	{
@@ -1942,45 +2165,94 @@ int libvmdk_extent_table_get_extent_file_at_offset(
 
 		return( -1 );
 	}
-	if( libfdata_list_get_element_value_at_offset(
-	     extent_table->extent_files_list,
-	     (intptr_t *) file_io_pool,
-	     (libfdata_cache_t *) extent_table->extent_files_cache,
-	     offset,
-	     extent_index,
-	     extent_file_data_offset,
-	     (intptr_t **) extent_file,
-	     0,
-	     error ) != 1 )
+	if( extent_table->number_of_extents == 0 )
+	{
+		extent_table->uniform_extent_size      = 0;
+		extent_table->extent_offsets_are_dirty = 0;
+
+		return( 1 );
+	}
+	if( extent_table->extent_sizes == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element at offset: %" PRIi64 " (0x%08" PRIx64 ") from extent files list.",
-		 function,
-		 offset,
-		 offset );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extent table - missing extent sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->extent_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extent table - missing extent offsets.",
+		 function );
 
 		return( -1 );
 	}
+	uniform_extent_size = extent_table->extent_sizes[ 0 ];
+
+	for( extent_index = 0;
+	     extent_index < extent_table->number_of_extents;
+	     extent_index++ )
+	{
+		extent_size = extent_table->extent_sizes[ extent_index ];
+
+		if( extent_size > (size64_t) ( INT64_MAX - extent_offset ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extent: %d size value out of bounds.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		/* The last extent is allowed to be smaller than the other extents
+		 */
+		if( extent_index < ( extent_table->number_of_extents - 1 ) )
+		{
+			if( extent_size != uniform_extent_size )
+			{
+				uniform_extent_size = 0;
+			}
+		}
+		else if( extent_size > uniform_extent_size )
+		{
+			uniform_extent_size = 0;
+		}
+		extent_table->extent_offsets[ extent_index ] = extent_offset;
+
+		extent_offset += (off64_t) extent_size;
+	}
+	extent_table->extent_offsets[ extent_index ] = extent_offset;
+
+	extent_table->uniform_extent_size      = uniform_extent_size;
+	extent_table->extent_offsets_are_dirty = 0;
+
 	return( 1 );
 }
 
-/* Sets an extent in the extent table based on the extent values
- * Returns 1 if successful or -1 on error
+/* Retrieves the index of the extent that contains a specific offset
+ * Returns 1 if successful, 0 if no such extent or -1 on error
  */
-int libvmdk_extent_table_set_extent_by_extent_values(
+int libvmdk_extent_table_get_extent_index_at_offset(
      libvmdk_extent_table_t *extent_table,
-     libvmdk_extent_values_t *extent_values,
-     int extent_index,
-     int file_io_pool_entry,
-     size64_t extent_file_size,
-     off64_t extent_offset,
-     size64_t extent_size,
+     off64_t offset,
+     int *extent_index,
+     off64_t *extent_data_offset,
      libcerror_error_t **error )
 {
-	static char *function = "libvmdk_extent_table_set_extent_by_extent_values";
+	static char *function = "libvmdk_extent_table_get_extent_index_at_offset";
+	int lower_index       = 0;
+	int middle_index      = 0;
+	int upper_index       = 0;
 
 	if( extent_table == NULL )
 	{
@@ -1993,48 +2265,398 @@ int libvmdk_extent_table_set_extent_by_extent_values(
 
 		return( -1 );
 	}
-	if( extent_values == NULL )
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid extent values.",
+		 "%s: invalid extent index.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( extent_index < 0 )
-	 || ( extent_index > extent_table->number_of_extents ) )
+	if( extent_data_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid extent index value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent data offset.",
 		 function );
 
 		return( -1 );
 	}
-	if( extent_index == 0 )
+	if( extent_table->extent_offsets_are_dirty != 0 )
 	{
-		if( extent_values->type == LIBVMDK_EXTENT_TYPE_FLAT )
+		if( libvmdk_extent_table_calculate_extent_offsets(
+		     extent_table,
+		     error ) != 1 )
 		{
-			if( ( extent_table->disk_type != LIBVMDK_DISK_TYPE_FLAT_2GB_EXTENT )
-			 && ( extent_table->disk_type != LIBVMDK_DISK_TYPE_MONOLITHIC_FLAT ) )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-				 "%s: extent type not supported for disk type.",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate extent offsets.",
+			 function );
 
-				return( -1 );
-			}
+			return( -1 );
 		}
-		else if( extent_values->type == LIBVMDK_EXTENT_TYPE_SPARSE )
-		{
+	}
+	if( extent_table->number_of_extents == 0 )
+	{
+		return( 0 );
+	}
+	if( offset >= extent_table->extent_offsets[ extent_table->number_of_extents ] )
+	{
+		return( 0 );
+	}
+	if( extent_table->uniform_extent_size != 0 )
+	{
+		lower_index = (int) ( (size64_t) offset / extent_table->uniform_extent_size );
+	}
+	else
+	{
+		/* Find the last extent that starts at or before the offset,
+		 * which skips over empty extents
+		 */
+		upper_index = extent_table->number_of_extents;
+
+		while( ( upper_index - lower_index ) > 1 )
+		{
+			middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+			if( extent_table->extent_offsets[ middle_index ] <= offset )
+			{
+				lower_index = middle_index;
+			}
+			else
+			{
+				upper_index = middle_index;
+			}
+		}
+	}
+	*extent_index       = lower_index;
+	*extent_data_offset = offset - extent_table->extent_offsets[ lower_index ];
+
+	return( 1 );
+}
+
+/* Retrieves an extent file at a specific offset from the extent table
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_table_get_extent_file_at_offset(
+     libvmdk_extent_table_t *extent_table,
+     off64_t offset,
+     libbfio_pool_t *file_io_pool,
+     int *extent_index,
+     off64_t *extent_file_data_offset,
+     libvmdk_extent_file_t **extent_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_extent_table_get_extent_file_at_offset";
+	int result            = 0;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent index.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          offset,
+	          extent_index,
+	          extent_file_data_offset,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent index at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_element_value_by_index(
+	     extent_table->extent_files_list,
+	     (intptr_t *) file_io_pool,
+	     (libfdata_cache_t *) extent_table->extent_files_cache,
+	     *extent_index,
+	     (intptr_t **) extent_file,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element: %d from extent files list.",
+		 function,
+		 *extent_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific extent file from the extent table
+ * The extent offset is the (media) offset of the start of the extent
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_table_get_extent_file_by_index(
+     libvmdk_extent_table_t *extent_table,
+     int extent_index,
+     libbfio_pool_t *file_io_pool,
+     off64_t *extent_offset,
+     libvmdk_extent_file_t **extent_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_extent_table_get_extent_file_by_index";
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->extent_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extent table - missing extent offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_index < 0 )
+	 || ( extent_index >= extent_table->number_of_extents ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->extent_offsets_are_dirty != 0 )
+	{
+		if( libvmdk_extent_table_calculate_extent_offsets(
+		     extent_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate extent offsets.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libfdata_list_get_element_value_by_index(
+	     extent_table->extent_files_list,
+	     (intptr_t *) file_io_pool,
+	     (libfdata_cache_t *) extent_table->extent_files_cache,
+	     extent_index,
+	     (intptr_t **) extent_file,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve element: %d from extent files list.",
+		 function,
+		 extent_index );
+
+		return( -1 );
+	}
+	*extent_offset = extent_table->extent_offsets[ extent_index ];
+
+	return( 1 );
+}
+
+/* Sets the extent file of a specific extent in the extent table
+ * The extent table takes over management of the extent file
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_table_set_extent_file_by_index(
+     libvmdk_extent_table_t *extent_table,
+     libbfio_pool_t *file_io_pool,
+     int extent_index,
+     libvmdk_extent_file_t *extent_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_extent_table_set_extent_file_by_index";
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_set_element_value_by_index(
+	     extent_table->extent_files_list,
+	     (intptr_t *) file_io_pool,
+	     (libfdata_cache_t *) extent_table->extent_files_cache,
+	     extent_index,
+	     (intptr_t *) extent_file,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_extent_file_free,
+	     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set extent file: %d in extent files list.",
+		 function,
+		 extent_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets an extent in the extent table based on the extent values
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_table_set_extent_by_extent_values(
+     libvmdk_extent_table_t *extent_table,
+     libvmdk_extent_values_t *extent_values,
+     int extent_index,
+     int file_io_pool_entry,
+     size64_t extent_file_size,
+     off64_t extent_offset,
+     size64_t extent_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_extent_table_set_extent_by_extent_values";
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_index < 0 )
+	 || ( extent_index >= extent_table->number_of_extents ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index == 0 )
+	{
+		if( extent_values->type == LIBVMDK_EXTENT_TYPE_FLAT )
+		{
+			if( ( extent_table->disk_type != LIBVMDK_DISK_TYPE_FLAT_2GB_EXTENT )
+			 && ( extent_table->disk_type != LIBVMDK_DISK_TYPE_MONOLITHIC_FLAT ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: extent type not supported for disk type.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( extent_values->type == LIBVMDK_EXTENT_TYPE_SPARSE )
+		{
 			if( ( extent_table->disk_type != LIBVMDK_DISK_TYPE_SPARSE_2GB_EXTENT )
 			 && ( extent_table->disk_type != LIBVMDK_DISK_TYPE_MONOLITHIC_SPARSE )
 			 && ( extent_table->disk_type != LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED ) )
@@ -2185,6 +2807,234 @@ int libvmdk_extent_table_set_extent_by_extent_values(
 			return( -1 );
 		}
 	}
+	if( extent_table->extent_sizes != NULL )
+	{
+		extent_table->extent_sizes[ extent_index ] = extent_size;
+		extent_table->extent_offsets_are_dirty     = 1;
+	}
 	return( 1 );
 }
 
+/* Retrieves the memory used by the extent files and the grain groups cache
+ * The memory used by list elements is estimated
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_table_get_memory_usage(
+     libvmdk_extent_table_t *extent_table,
+     size64_t *extent_files_memory_usage,
+     size64_t *grain_groups_memory_usage,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value = NULL;
+	libfdata_list_t *grains_list         = NULL;
+	libvmdk_extent_file_t *extent_file   = NULL;
+	static char *function                = "libvmdk_extent_table_get_memory_usage";
+	size64_t memory_usage                = 0;
+	int cache_entry_index                = 0;
+	int number_of_cache_entries          = 0;
+	int number_of_grains                 = 0;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_files_memory_usage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent files memory usage.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_groups_memory_usage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain groups memory usage.",
+		 function );
+
+		return( -1 );
+	}
+	memory_usage = sizeof( libvmdk_extent_table_t )
+	             + ( sizeof( system_character_t ) * extent_table->data_files_path_size );
+
+	if( extent_table->extent_sizes != NULL )
+	{
+		memory_usage += sizeof( size64_t ) * extent_table->number_of_extents;
+	}
+	if( extent_table->extent_offsets != NULL )
+	{
+		memory_usage += sizeof( off64_t ) * extent_table->number_of_extents;
+	}
+	if( extent_table->extent_files_list != NULL )
+	{
+		memory_usage += LIBVMDK_MEMORY_USAGE_LIST_ELEMENT_SIZE * extent_table->number_of_extents;
+	}
+	if( extent_table->extent_files_cache != NULL )
+	{
+		if( libfcache_cache_get_number_of_entries(
+		     extent_table->extent_files_cache,
+		     &number_of_cache_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of extent files cache entries.",
+			 function );
+
+			return( -1 );
+		}
+		for( cache_entry_index = 0;
+		     cache_entry_index < number_of_cache_entries;
+		     cache_entry_index++ )
+		{
+			if( libfcache_cache_get_value_by_index(
+			     extent_table->extent_files_cache,
+			     cache_entry_index,
+			     &cache_value,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve extent files cache entry: %d value.",
+				 function,
+				 cache_entry_index );
+
+				return( -1 );
+			}
+			if( cache_value == NULL )
+			{
+				continue;
+			}
+			extent_file = NULL;
+
+			if( libfcache_cache_value_get_value(
+			     cache_value,
+			     (intptr_t **) &extent_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve extent file from cache entry: %d value.",
+				 function,
+				 cache_entry_index );
+
+				return( -1 );
+			}
+			if( extent_file == NULL )
+			{
+				continue;
+			}
+			memory_usage += sizeof( libvmdk_extent_file_t );
+
+			if( extent_file->grain_groups_list != NULL )
+			{
+				memory_usage += (size64_t) LIBVMDK_MEMORY_USAGE_LIST_ELEMENT_SIZE * extent_file->number_of_grain_directory_entries;
+			}
+		}
+	}
+	*extent_files_memory_usage = memory_usage;
+
+	memory_usage = 0;
+
+	if( extent_table->grain_groups_cache != NULL )
+	{
+		if( libfcache_cache_get_number_of_entries(
+		     extent_table->grain_groups_cache,
+		     &number_of_cache_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of grain groups cache entries.",
+			 function );
+
+			return( -1 );
+		}
+		for( cache_entry_index = 0;
+		     cache_entry_index < number_of_cache_entries;
+		     cache_entry_index++ )
+		{
+			if( libfcache_cache_get_value_by_index(
+			     extent_table->grain_groups_cache,
+			     cache_entry_index,
+			     &cache_value,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve grain groups cache entry: %d value.",
+				 function,
+				 cache_entry_index );
+
+				return( -1 );
+			}
+			if( cache_value == NULL )
+			{
+				continue;
+			}
+			grains_list = NULL;
+
+			if( libfcache_cache_value_get_value(
+			     cache_value,
+			     (intptr_t **) &grains_list,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve grains list from cache entry: %d value.",
+				 function,
+				 cache_entry_index );
+
+				return( -1 );
+			}
+			if( grains_list == NULL )
+			{
+				continue;
+			}
+			if( libfdata_list_get_number_of_elements(
+			     grains_list,
+			     &number_of_grains,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of grains from cache entry: %d value.",
+				 function,
+				 cache_entry_index );
+
+				return( -1 );
+			}
+			memory_usage += (size64_t) LIBVMDK_MEMORY_USAGE_LIST_ELEMENT_SIZE * number_of_grains;
+		}
+	}
+	*grain_groups_memory_usage = memory_usage;
+
+	return( 1 );
+}
@@ -73,9 +73,29 @@ struct libvmdk_extent_table
 	 */
 	libfcache_cache_t *extent_files_cache;
 
+	/* The grain groups cache shared by the sparse extent files
+	 */
+	libfcache_cache_t *grain_groups_cache;
+
 	/* The extent files stream used for flat (non-sparse) extent files
 	 */
 	libfdata_stream_t *extent_files_stream;
+
+	/* The extent sizes
+	 */
+	size64_t *extent_sizes;
+
+	/* The extent offsets, used to look up the extent that contains an offset
+	 */
+	off64_t *extent_offsets;
+
+	/* The extent size if all extents, except for the last, are of equal size or 0 otherwise
+	 */
+	size64_t uniform_extent_size;
+
+	/* Value to indicate the extent offsets need to be (re)calculated
+	 */
+	uint8_t extent_offsets_are_dirty;
 };
 
 int libvmdk_extent_table_initialize(
@@ -175,6 +195,17 @@ int libvmdk_extent_table_set_extent_storage_media_size_by_index(
      size64_t storage_media_size,
      libcerror_error_t **error );
 
+int libvmdk_extent_table_calculate_extent_offsets(
+     libvmdk_extent_table_t *extent_table,
+     libcerror_error_t **error );
+
+int libvmdk_extent_table_get_extent_index_at_offset(
+     libvmdk_extent_table_t *extent_table,
+     off64_t offset,
+     int *extent_index,
+     off64_t *extent_data_offset,
+     libcerror_error_t **error );
+
 int libvmdk_extent_table_get_extent_file_at_offset(
      libvmdk_extent_table_t *extent_table,
      off64_t offset,
@@ -184,6 +215,21 @@ int libvmdk_extent_table_get_extent_file_at_offset(
      libvmdk_extent_file_t **extent_file,
      libcerror_error_t **error );
 
+int libvmdk_extent_table_get_extent_file_by_index(
+     libvmdk_extent_table_t *extent_table,
+     int extent_index,
+     libbfio_pool_t *file_io_pool,
+     off64_t *extent_offset,
+     libvmdk_extent_file_t **extent_file,
+     libcerror_error_t **error );
+
+int libvmdk_extent_table_set_extent_file_by_index(
+     libvmdk_extent_table_t *extent_table,
+     libbfio_pool_t *file_io_pool,
+     int extent_index,
+     libvmdk_extent_file_t *extent_file,
+     libcerror_error_t **error );
+
 int libvmdk_extent_table_set_extent_by_extent_values(
      libvmdk_extent_table_t *extent_table,
      libvmdk_extent_values_t *extent_values,
@@ -194,6 +240,12 @@ int libvmdk_extent_table_set_extent_by_extent_values(
      size64_t extent_size,
      libcerror_error_t **error );
 
+int libvmdk_extent_table_get_memory_usage(
+     libvmdk_extent_table_t *extent_table,
+     size64_t *extent_files_memory_usage,
+     size64_t *grain_groups_memory_usage,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
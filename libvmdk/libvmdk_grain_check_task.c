@@ -0,0 +1,414 @@
+/*
+ * Grain check task functions
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_corrupted_range.h"
+#include "libvmdk_extent_file.h"
+#include "libvmdk_grain_check_task.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcdata.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_unused.h"
+
+/* Creates a grain check task
+ * Make sure the value grain_check_task is referencing, is set to NULL
+ *
+ * The task checks a range of grain groups of the extent data file using a clone
+ * of its file IO handle so that multiple ranges can be checked concurrently
+ * The grain directory data and extent file are referenced and must remain available
+ * until the task has been run
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_check_task_initialize(
+     libvmdk_grain_check_task_t **grain_check_task,
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int extent_index,
+     size64_t extent_file_size,
+     off64_t extent_offset,
+     const uint8_t *grain_directory_data,
+     const uint8_t *backup_grain_directory_data,
+     uint32_t grain_directory_entry_index,
+     uint32_t number_of_grain_directory_entries,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle        = NULL;
+	libbfio_handle_t *source_file_io_handle = NULL;
+	static char *function                   = "libvmdk_grain_check_task_initialize";
+
+	if( grain_check_task == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain check task.",
+		 function );
+
+		return( -1 );
+	}
+	if( *grain_check_task != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid grain check task value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_directory_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain directory data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_get_handle(
+	     file_io_pool,
+	     extent_index,
+	     &source_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d from pool.",
+		 function,
+		 extent_index );
+
+		return( -1 );
+	}
+	*grain_check_task = memory_allocate_structure(
+	                     libvmdk_grain_check_task_t );
+
+	if( *grain_check_task == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain check task.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *grain_check_task,
+	     0,
+	     sizeof( libvmdk_grain_check_task_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear grain check task.",
+		 function );
+
+		memory_free(
+		 *grain_check_task );
+
+		*grain_check_task = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *grain_check_task )->corrupted_ranges_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create corrupted ranges array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_clone(
+	     &file_io_handle,
+	     source_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to clone file IO handle: %d.",
+		 function,
+		 extent_index );
+
+		goto on_error;
+	}
+	/* The extent index is used as the file IO pool entry since it is stored
+	 * as the extent index of the corrupted ranges
+	 */
+	if( libbfio_pool_initialize(
+	     &( ( *grain_check_task )->file_io_pool ),
+	     extent_index + 1,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_set_handle(
+	     ( *grain_check_task )->file_io_pool,
+	     extent_index,
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file IO handle: %d in pool.",
+		 function,
+		 extent_index );
+
+		goto on_error;
+	}
+	file_io_handle = NULL;
+
+	( *grain_check_task )->extent_file                       = extent_file;
+	( *grain_check_task )->extent_index                      = extent_index;
+	( *grain_check_task )->extent_file_size                  = extent_file_size;
+	( *grain_check_task )->extent_offset                     = extent_offset;
+	( *grain_check_task )->grain_directory_data              = grain_directory_data;
+	( *grain_check_task )->backup_grain_directory_data       = backup_grain_directory_data;
+	( *grain_check_task )->grain_directory_entry_index       = grain_directory_entry_index;
+	( *grain_check_task )->number_of_grain_directory_entries = number_of_grain_directory_entries;
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( *grain_check_task != NULL )
+	{
+		if( ( *grain_check_task )->file_io_pool != NULL )
+		{
+			libbfio_pool_free(
+			 &( ( *grain_check_task )->file_io_pool ),
+			 NULL );
+		}
+		if( ( *grain_check_task )->corrupted_ranges_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *grain_check_task )->corrupted_ranges_array ),
+			 NULL,
+			 NULL );
+		}
+		memory_free(
+		 *grain_check_task );
+
+		*grain_check_task = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a grain check task
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_check_task_free(
+     libvmdk_grain_check_task_t **grain_check_task,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_grain_check_task_free";
+	int result            = 1;
+
+	if( grain_check_task == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain check task.",
+		 function );
+
+		return( -1 );
+	}
+	if( *grain_check_task != NULL )
+	{
+		/* The extent file and grain directory data are referenced and freed elsewhere
+		 */
+		if( ( *grain_check_task )->file_io_pool != NULL )
+		{
+			if( libbfio_pool_close_all(
+			     ( *grain_check_task )->file_io_pool,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close all file IO handles in pool.",
+				 function );
+
+				result = -1;
+			}
+			if( libbfio_pool_free(
+			     &( ( *grain_check_task )->file_io_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcdata_array_free(
+		     &( ( *grain_check_task )->corrupted_ranges_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_corrupted_range_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free corrupted ranges array.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *grain_check_task )->error != NULL )
+		{
+			libcerror_error_free(
+			 &( ( *grain_check_task )->error ) );
+		}
+		memory_free(
+		 *grain_check_task );
+
+		*grain_check_task = NULL;
+	}
+	return( result );
+}
+
+/* Checks the range of grain groups
+ * Callback function for the thread pool, the outcome is stored in the task
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_check_task_run(
+     libvmdk_grain_check_task_t *grain_check_task,
+     void *arguments LIBVMDK_ATTRIBUTE_UNUSED )
+{
+	static char *function = "libvmdk_grain_check_task_run";
+
+	LIBVMDK_UNREFERENCED_PARAMETER( arguments )
+
+	if( grain_check_task == NULL )
+	{
+		return( -1 );
+	}
+	grain_check_task->result = -1;
+
+	if( libvmdk_extent_file_check_grain_groups(
+	     grain_check_task->extent_file,
+	     grain_check_task->file_io_pool,
+	     grain_check_task->extent_index,
+	     grain_check_task->extent_file_size,
+	     grain_check_task->extent_offset,
+	     grain_check_task->grain_directory_data,
+	     grain_check_task->backup_grain_directory_data,
+	     grain_check_task->grain_directory_entry_index,
+	     grain_check_task->number_of_grain_directory_entries,
+	     grain_check_task->corrupted_ranges_array,
+	     &( grain_check_task->error ) ) != 1 )
+	{
+		libcerror_error_set(
+		 &( grain_check_task->error ),
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to check grain groups: %" PRIu32 " - %" PRIu32 " of extent file: %d.",
+		 function,
+		 grain_check_task->grain_directory_entry_index,
+		 grain_check_task->grain_directory_entry_index + grain_check_task->number_of_grain_directory_entries,
+		 grain_check_task->extent_index );
+
+		return( -1 );
+	}
+	/* The file IO handle is no longer needed once the grain groups have been checked
+	 */
+	if( libbfio_pool_close_all(
+	     grain_check_task->file_io_pool,
+	     &( grain_check_task->error ) ) != 0 )
+	{
+		libcerror_error_set(
+		 &( grain_check_task->error ),
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	grain_check_task->result = 1;
+
+	return( 1 );
+}
+
@@ -0,0 +1,116 @@
+/*
+ * Grain check task functions
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_GRAIN_CHECK_TASK_H )
+#define _LIBVMDK_GRAIN_CHECK_TASK_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_extent_file.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcdata.h"
+#include "libvmdk_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_grain_check_task libvmdk_grain_check_task_t;
+
+struct libvmdk_grain_check_task
+{
+	/* The extent file
+	 */
+	libvmdk_extent_file_t *extent_file;
+
+	/* The file IO pool that only contains the extent data file
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The extent index
+	 */
+	int extent_index;
+
+	/* The extent file size
+	 */
+	size64_t extent_file_size;
+
+	/* The extent (media) offset
+	 */
+	off64_t extent_offset;
+
+	/* The grain directory data
+	 */
+	const uint8_t *grain_directory_data;
+
+	/* The backup grain directory data
+	 */
+	const uint8_t *backup_grain_directory_data;
+
+	/* The index of the first grain directory entry to check
+	 */
+	uint32_t grain_directory_entry_index;
+
+	/* The number of grain directory entries to check
+	 */
+	uint32_t number_of_grain_directory_entries;
+
+	/* The corrupted ranges array
+	 */
+	libcdata_array_t *corrupted_ranges_array;
+
+	/* The result of the task
+	 */
+	int result;
+
+	/* The error of the task
+	 */
+	libcerror_error_t *error;
+};
+
+int libvmdk_grain_check_task_initialize(
+     libvmdk_grain_check_task_t **grain_check_task,
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int extent_index,
+     size64_t extent_file_size,
+     off64_t extent_offset,
+     const uint8_t *grain_directory_data,
+     const uint8_t *backup_grain_directory_data,
+     uint32_t grain_directory_entry_index,
+     uint32_t number_of_grain_directory_entries,
+     libcerror_error_t **error );
+
+int libvmdk_grain_check_task_free(
+     libvmdk_grain_check_task_t **grain_check_task,
+     libcerror_error_t **error );
+
+int libvmdk_grain_check_task_run(
+     libvmdk_grain_check_task_t *grain_check_task,
+     void *arguments );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_GRAIN_CHECK_TASK_H ) */
+
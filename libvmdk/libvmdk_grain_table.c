@@ -34,6 +34,7 @@
 #include "libvmdk_libcnotify.h"
 #include "libvmdk_libfcache.h"
 #include "libvmdk_libfdata.h"
+#include "libvmdk_shared_cache.h"
 #include "libvmdk_unused.h"
 
 /* Creates a grain table
@@ -131,6 +132,7 @@ int libvmdk_grain_table_free(
      libcerror_error_t **error )
 {
 	static char *function = "libvmdk_grain_table_free";
+	int result            = 1;
 
 	if( grain_table == NULL )
 	{
@@ -145,41 +147,87 @@ int libvmdk_grain_table_free(
 	}
 	if( *grain_table != NULL )
 	{
-		/* The IO handle reference is freed elsewhere
+		/* The IO handle and shared cache references are freed elsewhere
 		 */
+		if( ( *grain_table )->shared_grain_data != NULL )
+		{
+			if( libvmdk_grain_data_free(
+			     &( ( *grain_table )->shared_grain_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free shared grain data.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *grain_table );
 
 		*grain_table = NULL;
 	}
+	return( result );
+}
+
+/* Sets the shared cache
+ * The shared cache is not managed by the grain table
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_table_set_shared_cache(
+     libvmdk_grain_table_t *grain_table,
+     libvmdk_shared_cache_t *shared_cache,
+     uint64_t shared_cache_identifier,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_grain_table_set_shared_cache";
+
+	if( grain_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain table.",
+		 function );
+
+		return( -1 );
+	}
+	grain_table->shared_cache            = shared_cache;
+	grain_table->shared_cache_identifier = shared_cache_identifier;
+
 	return( 1 );
 }
 
-/* Determines if the grain at a specific offset is sparse
- * Returns 1 if the grain is sparse, 0 if not or -1 on error
+/* Resolves the grain at a specific offset
+ * The most recently resolved grain group range is remembered so that consecutive
+ * grains in the same grain group do not require the extent and grain group to be looked up.
+ * The grains list itself is owned by the grain groups cache, which can evict it at any time,
+ * hence it is always retrieved from the cache
+ * Returns 1 if successful or -1 on error
  */
-int libvmdk_grain_table_grain_is_sparse_at_offset(
+int libvmdk_grain_table_get_grain_at_offset(
      libvmdk_grain_table_t *grain_table,
      uint64_t grain_index,
      libbfio_pool_t *file_io_pool,
      libvmdk_extent_table_t *extent_table,
      off64_t offset,
+     libvmdk_grain_descriptor_t *grain_descriptor,
      libcerror_error_t **error )
 {
 	libvmdk_extent_file_t *extent_file = NULL;
 	libfdata_list_t *grains_list       = NULL;
-	static char *function              = "libvmdk_grain_table_grain_is_sparse_at_offset";
+	static char *function              = "libvmdk_grain_table_get_grain_at_offset";
+	size64_t grain_group_size          = 0;
 	off64_t extent_file_data_offset    = 0;
-	off64_t grain_data_offset          = 0;
+	off64_t extent_offset              = 0;
 	off64_t grain_group_data_offset    = 0;
-	off64_t grain_offset               = 0;
-	size64_t grain_size                = 0;
-	uint32_t grain_flags               = 0;
+	uint32_t grain_group_flags         = 0;
 	int extent_number                  = 0;
-	int grain_file_index               = 0;
 	int grain_groups_list_index        = 0;
-	int grains_list_index              = 0;
-	int result                         = 0;
 
 	if( grain_table == NULL )
 	{
@@ -192,31 +240,378 @@ int libvmdk_grain_table_grain_is_sparse_at_offset(
 
 		return( -1 );
 	}
-	if( libvmdk_extent_table_get_extent_file_at_offset(
+	if( grain_table->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid grain table - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_table->io_handle->grain_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid grain table - invalid IO handle - grain size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( grain_table->last_grain_group_is_set != 0 )
+	 && ( offset >= grain_table->last_grain_group_offset )
+	 && ( (size64_t) ( offset - grain_table->last_grain_group_offset ) < grain_table->last_grain_group_size ) )
+	{
+		extent_number           = grain_table->last_extent_number;
+		grain_groups_list_index = grain_table->last_grain_groups_list_index;
+		grain_group_data_offset = offset - grain_table->last_grain_group_offset;
+		grain_group_flags       = grain_table->last_grain_group_flags;
+
+		if( ( grain_group_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) == 0 )
+		{
+			if( libvmdk_extent_table_get_extent_file_by_index(
+			     extent_table,
+			     extent_number,
+			     file_io_pool,
+			     &extent_offset,
+			     &extent_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve extent file: %d from extent table.",
+				 function,
+				 extent_number );
+
+				return( -1 );
+			}
+		}
+	}
+	else
+	{
+		grain_table->last_grain_group_is_set = 0;
+
+		if( libvmdk_extent_table_get_extent_file_at_offset(
+		     extent_table,
+		     offset,
+		     file_io_pool,
+		     &extent_number,
+		     &extent_file_data_offset,
+		     &extent_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent file at offset: %" PRIi64 " (0x%08" PRIx64 ") from extent table.",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		if( libvmdk_extent_file_get_grain_group_range_at_offset(
+		     extent_file,
+		     extent_file_data_offset,
+		     &grain_groups_list_index,
+		     &grain_group_data_offset,
+		     &grain_group_size,
+		     &grain_group_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain group from extent file: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 extent_number,
+			 extent_file_data_offset,
+			 extent_file_data_offset );
+
+			return( -1 );
+		}
+		grain_table->last_extent_number           = extent_number;
+		grain_table->last_grain_groups_list_index = grain_groups_list_index;
+		grain_table->last_grain_group_offset      = offset - grain_group_data_offset;
+		grain_table->last_grain_group_size        = grain_group_size;
+		grain_table->last_grain_group_flags       = grain_group_flags;
+		grain_table->last_grain_group_is_set      = 1;
+	}
+	if( ( grain_group_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) == 0 )
+	{
+		if( libvmdk_extent_file_get_grain_group_by_index(
+		     extent_file,
+		     file_io_pool,
+		     extent_table->grain_groups_cache,
+		     grain_groups_list_index,
+		     &grains_list,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain group: %d from extent file: %d.",
+			 function,
+			 grain_groups_list_index,
+			 extent_number );
+
+			grain_table->last_grain_group_is_set = 0;
+
+			return( -1 );
+		}
+	}
+	grain_descriptor->extent_number      = extent_number;
+	grain_descriptor->grains_list        = grains_list;
+	grain_descriptor->grain_group_offset = grain_table->last_grain_group_offset;
+	grain_descriptor->grain_group_size   = grain_table->last_grain_group_size;
+
+	if( ( grain_group_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+	{
+		grain_descriptor->grains_list_index = -1;
+		grain_descriptor->data_offset       = grain_group_data_offset % grain_table->io_handle->grain_size;
+		grain_descriptor->file_index        = -1;
+		grain_descriptor->offset            = 0;
+		grain_descriptor->size              = grain_table->io_handle->grain_size;
+		grain_descriptor->flags             = LIBVMDK_RANGE_FLAG_IS_SPARSE;
+
+		return( 1 );
+	}
+	if( libfdata_list_get_element_at_offset(
+	     grains_list,
+	     grain_group_data_offset,
+	     &( grain_descriptor->grains_list_index ),
+	     &( grain_descriptor->data_offset ),
+	     &( grain_descriptor->file_index ),
+	     &( grain_descriptor->offset ),
+	     &( grain_descriptor->size ),
+	     &( grain_descriptor->flags ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain: %" PRIu64 " from grain group in extent file: %d.",
+		 function,
+		 grain_index,
+		 extent_number );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Resets the most recently resolved grain group
+ * This must be called when an extent file in the extent table is replaced
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_table_reset_last_grain_group(
+     libvmdk_grain_table_t *grain_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_grain_table_reset_last_grain_group";
+
+	if( grain_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain table.",
+		 function );
+
+		return( -1 );
+	}
+	grain_table->last_grain_group_is_set      = 0;
+	grain_table->last_grain_groups_list_index = -1;
+
+	return( 1 );
+}
+
+/* Determines if the grain at a specific offset is sparse
+ * Returns 1 if the grain is sparse, 0 if not or -1 on error
+ */
+int libvmdk_grain_table_grain_is_sparse_at_offset(
+     libvmdk_grain_table_t *grain_table,
+     uint64_t grain_index,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_extent_table_t *extent_table,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_descriptor_t grain_descriptor;
+
+	static char *function = "libvmdk_grain_table_grain_is_sparse_at_offset";
+
+	if( libvmdk_grain_table_get_grain_at_offset(
+	     grain_table,
+	     grain_index,
+	     file_io_pool,
 	     extent_table,
 	     offset,
-	     file_io_pool,
-	     &extent_number,
-	     &extent_file_data_offset,
-	     &extent_file,
+	     &grain_descriptor,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve extent file at offset: %" PRIi64 " (0x%08" PRIx64 ") from extent table.",
+		 "%s: unable to retrieve grain: %" PRIu64 " at offset: %" PRIi64 " (0x%08" PRIx64 ").",
 		 function,
+		 grain_index,
 		 offset,
 		 offset );
 
 		return( -1 );
 	}
-	result = libvmdk_extent_file_grain_group_is_sparse_at_offset(
-	          extent_file,
-	          extent_file_data_offset,
-	          &grain_groups_list_index,
-	          &grain_group_data_offset,
+	if( ( grain_descriptor.flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the grain data of a grain in a grain group using the shared cache
+ * The grain data is copied from the shared cache into the grain data of the grain table
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_table_get_shared_grain_data(
+     libvmdk_grain_table_t *grain_table,
+     uint64_t grain_index,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *grains_cache,
+     libvmdk_grain_descriptor_t *grain_descriptor,
+     libvmdk_grain_data_t **grain_data,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_data_t *cached_grain_data = NULL;
+	static char *function                   = "libvmdk_grain_table_get_shared_grain_data";
+	size_t cached_data_size                 = 0;
+	int result                              = 0;
+
+	if( grain_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain table.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_table->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid grain table - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain data.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_table->shared_grain_data == NULL )
+	{
+		if( ( grain_table->io_handle->grain_size == 0 )
+		 || ( grain_table->io_handle->grain_size > (size64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid IO handle - grain size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( libvmdk_grain_data_initialize(
+		     &( grain_table->shared_grain_data ),
+		     (size_t) grain_table->io_handle->grain_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shared grain data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	result = libvmdk_shared_cache_get_data(
+	          grain_table->shared_cache,
+	          grain_table->shared_cache_identifier,
+	          grain_descriptor->extent_number,
+	          grain_descriptor->offset,
+	          grain_table->shared_grain_data->data,
+	          (size_t) grain_table->io_handle->grain_size,
+	          &cached_data_size,
 	          error );
 
 	if( result == -1 )
@@ -225,93 +620,89 @@ int libvmdk_grain_table_grain_is_sparse_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve grain group from extent file: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 "%s: unable to retrieve grain: %" PRIu64 " data from shared cache.",
 		 function,
-		 extent_number,
-		 extent_file_data_offset,
-		 extent_file_data_offset );
+		 grain_index );
 
 		return( -1 );
 	}
 	else if( result != 0 )
 	{
+		grain_table->shared_grain_data->data_size = cached_data_size;
+
+		*grain_data = grain_table->shared_grain_data;
+
 		return( 1 );
 	}
-	if( libvmdk_extent_file_get_grain_group_at_offset(
-	     extent_file,
-	     file_io_pool,
-	     extent_file_data_offset,
-	     &grain_groups_list_index,
-	     &grain_group_data_offset,
-	     &grains_list,
+	if( libfdata_list_get_element_value_by_index(
+	     grain_descriptor->grains_list,
+	     (intptr_t *) file_io_pool,
+	     (libfdata_cache_t *) grains_cache,
+	     grain_descriptor->grains_list_index,
+	     (intptr_t **) &cached_grain_data,
+	     0,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve grain group from extent file: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 "%s: unable to retrieve grain: %" PRIu64 " data from grain group in extent file: %d.",
 		 function,
-		 extent_number,
-		 extent_file_data_offset,
-		 extent_file_data_offset );
+		 grain_index,
+		 grain_descriptor->extent_number );
 
 		return( -1 );
 	}
-	if( libfdata_list_get_element_at_offset(
-	     grains_list,
-	     grain_group_data_offset,
-	     &grains_list_index,
-	     &grain_data_offset,
-	     &grain_file_index,
-	     &grain_offset,
-	     &grain_size,
-	     &grain_flags,
-	     error ) != 1 )
+	if( cached_grain_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve grain: %" PRIu64 " from grain group: %d in extent file: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing grain: %" PRIu64 " data.",
 		 function,
-		 grain_index,
-		 grain_groups_list_index,
-		 extent_number,
-		 extent_file_data_offset,
-		 extent_file_data_offset );
+		 grain_index );
 
 		return( -1 );
 	}
-	if( ( grain_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+	if( libvmdk_shared_cache_set_data(
+	     grain_table->shared_cache,
+	     grain_table->shared_cache_identifier,
+	     grain_descriptor->extent_number,
+	     grain_descriptor->offset,
+	     cached_grain_data->data,
+	     cached_grain_data->data_size,
+	     error ) != 1 )
 	{
-		return( 1 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set grain: %" PRIu64 " data in shared cache.",
+		 function,
+		 grain_index );
+
+		return( -1 );
 	}
-	return( 0 );
+	*grain_data = cached_grain_data;
+
+	return( 1 );
 }
 
-/* Retrieves the grain data of a grain at a specific offset
+/* Retrieves the grain data of a resolved grain
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_grain_table_get_grain_data_at_offset(
+int libvmdk_grain_table_get_grain_data(
      libvmdk_grain_table_t *grain_table,
      uint64_t grain_index,
      libbfio_pool_t *file_io_pool,
-     libvmdk_extent_table_t *extent_table,
      libfcache_cache_t *grains_cache,
-     off64_t offset,
+     libvmdk_grain_descriptor_t *grain_descriptor,
      libvmdk_grain_data_t **grain_data,
-     off64_t *grain_data_offset,
      libcerror_error_t **error )
 {
-	libvmdk_extent_file_t *extent_file = NULL;
-	libfdata_list_t *grains_list       = NULL;
-	static char *function              = "libvmdk_grain_table_get_grain_data_at_offset";
-	off64_t grain_group_data_offset    = 0;
-	off64_t extent_file_data_offset    = 0;
-	int extent_number                  = 0;
-	int grain_groups_list_index        = 0;
-	int grains_list_index              = 0;
+	static char *function = "libvmdk_grain_table_get_grain_data";
 
 	if( grain_table == NULL )
 	{
@@ -324,72 +715,134 @@ int libvmdk_grain_table_get_grain_data_at_offset(
 
 		return( -1 );
 	}
-	if( libvmdk_extent_table_get_extent_file_at_offset(
-	     extent_table,
-	     offset,
-	     file_io_pool,
-	     &extent_number,
-	     &extent_file_data_offset,
-	     &extent_file,
+	if( grain_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( grain_descriptor->grains_list == NULL )
+	 || ( ( grain_descriptor->flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported grain: %" PRIu64 " - grain is sparse.",
+		 function,
+		 grain_index );
+
+		return( -1 );
+	}
+	if( grain_table->shared_cache != NULL )
+	{
+		return( libvmdk_grain_table_get_shared_grain_data(
+		         grain_table,
+		         grain_index,
+		         file_io_pool,
+		         grains_cache,
+		         grain_descriptor,
+		         grain_data,
+		         error ) );
+	}
+	if( libfdata_list_get_element_value_by_index(
+	     grain_descriptor->grains_list,
+	     (intptr_t *) file_io_pool,
+	     (libfdata_cache_t *) grains_cache,
+	     grain_descriptor->grains_list_index,
+	     (intptr_t **) grain_data,
+	     0,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve extent file at offset: %" PRIi64 " (0x%08" PRIx64 ") from extent table.",
+		 "%s: unable to retrieve grain: %" PRIu64 " data from grain group in extent file: %d.",
 		 function,
-		 offset,
-		 offset );
+		 grain_index,
+		 grain_descriptor->extent_number );
 
 		return( -1 );
 	}
-	if( libvmdk_extent_file_get_grain_group_at_offset(
-	     extent_file,
+	return( 1 );
+}
+
+/* Retrieves the grain data of a grain at a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_table_get_grain_data_at_offset(
+     libvmdk_grain_table_t *grain_table,
+     uint64_t grain_index,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_extent_table_t *extent_table,
+     libfcache_cache_t *grains_cache,
+     off64_t offset,
+     libvmdk_grain_data_t **grain_data,
+     off64_t *grain_data_offset,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_descriptor_t grain_descriptor;
+
+	static char *function = "libvmdk_grain_table_get_grain_data_at_offset";
+
+	if( grain_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_grain_table_get_grain_at_offset(
+	     grain_table,
+	     grain_index,
 	     file_io_pool,
-	     extent_file_data_offset,
-	     &grain_groups_list_index,
-	     &grain_group_data_offset,
-	     &grains_list,
+	     extent_table,
+	     offset,
+	     &grain_descriptor,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve grain group from extent file: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 "%s: unable to retrieve grain: %" PRIu64 " at offset: %" PRIi64 " (0x%08" PRIx64 ").",
 		 function,
-		 extent_number,
-		 extent_file_data_offset,
-		 extent_file_data_offset );
+		 grain_index,
+		 offset,
+		 offset );
 
 		return( -1 );
 	}
-	if( libfdata_list_get_element_value_at_offset(
-	     grains_list,
-	     (intptr_t *) file_io_pool,
-	     (libfdata_cache_t *) grains_cache,
-	     grain_group_data_offset,
-	     &grains_list_index,
-	     grain_data_offset,
-	     (intptr_t **) grain_data,
-	     0,
+	if( libvmdk_grain_table_get_grain_data(
+	     grain_table,
+	     grain_index,
+	     file_io_pool,
+	     grains_cache,
+	     &grain_descriptor,
+	     grain_data,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve grain: %" PRIu64 " data from grain group: %d in extent file: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 "%s: unable to retrieve grain: %" PRIu64 " data.",
 		 function,
-		 grain_index,
-		 grain_groups_list_index,
-		 extent_number,
-		 extent_file_data_offset,
-		 extent_file_data_offset );
+		 grain_index );
 
 		return( -1 );
 	}
+	*grain_data_offset = grain_descriptor.data_offset;
+
 	return( 1 );
 }
-
@@ -32,11 +32,57 @@
 #include "libvmdk_libcerror.h"
 #include "libvmdk_libfcache.h"
 #include "libvmdk_libfdata.h"
+#include "libvmdk_types.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+typedef struct libvmdk_grain_descriptor libvmdk_grain_descriptor_t;
+
+struct libvmdk_grain_descriptor
+{
+	/* The extent number
+	 */
+	int extent_number;
+
+	/* The grains list (grain group) or NULL if the grain group is sparse
+	 */
+	libfdata_list_t *grains_list;
+
+	/* The index of the grain in the grains list
+	 */
+	int grains_list_index;
+
+	/* The offset relative to the start of the grain
+	 */
+	off64_t data_offset;
+
+	/* The file IO pool entry
+	 */
+	int file_index;
+
+	/* The (physical) offset of the grain in the extent file
+	 */
+	off64_t offset;
+
+	/* The (stored) size of the grain
+	 */
+	size64_t size;
+
+	/* The range flags
+	 */
+	uint32_t flags;
+
+	/* The (media) offset of the grain group
+	 */
+	off64_t grain_group_offset;
+
+	/* The (media) size of the grain group
+	 */
+	size64_t grain_group_size;
+};
+
 typedef struct libvmdk_grain_table libvmdk_grain_table_t;
 
 struct libvmdk_grain_table
@@ -56,6 +102,42 @@ struct libvmdk_grain_table
 	/* The last grain offset that was compared
 	 */
 	int last_grain_offset_compared;
+
+	/* The shared cache
+	 */
+	libvmdk_shared_cache_t *shared_cache;
+
+	/* The shared cache (disk) identifier
+	 */
+	uint64_t shared_cache_identifier;
+
+	/* The grain data used to retrieve data from the shared cache
+	 */
+	libvmdk_grain_data_t *shared_grain_data;
+
+	/* Value to indicate the most recently resolved grain group is set
+	 */
+	uint8_t last_grain_group_is_set;
+
+	/* The extent number of the most recently resolved grain group
+	 */
+	int last_extent_number;
+
+	/* The (media) offset of the most recently resolved grain group
+	 */
+	off64_t last_grain_group_offset;
+
+	/* The size of the most recently resolved grain group
+	 */
+	size64_t last_grain_group_size;
+
+	/* The range flags of the most recently resolved grain group
+	 */
+	uint32_t last_grain_group_flags;
+
+	/* The grain groups list index of the most recently resolved grain group
+	 */
+	int last_grain_groups_list_index;
 };
 
 int libvmdk_grain_table_initialize(
@@ -67,6 +149,25 @@ int libvmdk_grain_table_free(
      libvmdk_grain_table_t **grain_table,
      libcerror_error_t **error );
 
+int libvmdk_grain_table_set_shared_cache(
+     libvmdk_grain_table_t *grain_table,
+     libvmdk_shared_cache_t *shared_cache,
+     uint64_t shared_cache_identifier,
+     libcerror_error_t **error );
+
+int libvmdk_grain_table_get_grain_at_offset(
+     libvmdk_grain_table_t *grain_table,
+     uint64_t grain_index,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_extent_table_t *extent_table,
+     off64_t offset,
+     libvmdk_grain_descriptor_t *grain_descriptor,
+     libcerror_error_t **error );
+
+int libvmdk_grain_table_reset_last_grain_group(
+     libvmdk_grain_table_t *grain_table,
+     libcerror_error_t **error );
+
 int libvmdk_grain_table_grain_is_sparse_at_offset(
      libvmdk_grain_table_t *grain_table,
      uint64_t grain_index,
@@ -75,6 +176,24 @@ int libvmdk_grain_table_grain_is_sparse_at_offset(
      off64_t offset,
      libcerror_error_t **error );
 
+int libvmdk_grain_table_get_shared_grain_data(
+     libvmdk_grain_table_t *grain_table,
+     uint64_t grain_index,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *grains_cache,
+     libvmdk_grain_descriptor_t *grain_descriptor,
+     libvmdk_grain_data_t **grain_data,
+     libcerror_error_t **error );
+
+int libvmdk_grain_table_get_grain_data(
+     libvmdk_grain_table_t *grain_table,
+     uint64_t grain_index,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *grains_cache,
+     libvmdk_grain_descriptor_t *grain_descriptor,
+     libvmdk_grain_data_t **grain_data,
+     libcerror_error_t **error );
+
 int libvmdk_grain_table_get_grain_data_at_offset(
      libvmdk_grain_table_t *grain_table,
      uint64_t grain_index,
@@ -20,20 +20,47 @@
  */
 
 #include <common.h>
+
+/* copy_file_range is declared as a GNU extension
+ */
+#if defined( HAVE_COPY_FILE_RANGE ) && !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
 #include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
 #include <wide_string.h>
 
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libvmdk_change_tracking_file.h"
+#include "libvmdk_corrupted_range.h"
 #include "libvmdk_debug.h"
 #include "libvmdk_definitions.h"
 #include "libvmdk_descriptor_file.h"
 #include "libvmdk_extent_descriptor.h"
 #include "libvmdk_extent_file.h"
+#include "libvmdk_extent_read_task.h"
 #include "libvmdk_extent_table.h"
 #include "libvmdk_extent_values.h"
 #include "libvmdk_handle.h"
+#include "libvmdk_grain_check_task.h"
 #include "libvmdk_grain_data.h"
 #include "libvmdk_grain_table.h"
 #include "libvmdk_io_handle.h"
@@ -46,6 +73,8 @@
 #include "libvmdk_libcthreads.h"
 #include "libvmdk_libfcache.h"
 #include "libvmdk_libfdata.h"
+#include "libvmdk_read_request.h"
+#include "libvmdk_shared_cache.h"
 
 /* Creates a handle
  * Make sure the value handle is referencing, is set to NULL
@@ -138,6 +167,20 @@ int libvmdk_handle_initialize(
 
 		goto on_error;
 	}
+	if( libcdata_array_initialize(
+	     &( internal_handle->corrupted_ranges_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create corrupted ranges array.",
+		 function );
+
+		goto on_error;
+	}
 	if( libvmdk_extent_table_initialize(
 	     &( internal_handle->extent_table ),
 	     internal_handle->io_handle,
@@ -182,6 +225,13 @@ on_error:
 			 &( internal_handle->extent_table ),
 			 NULL );
 		}
+		if( internal_handle->corrupted_ranges_array != NULL )
+		{
+			libcdata_array_free(
+			 &( internal_handle->corrupted_ranges_array ),
+			 NULL,
+			 NULL );
+		}
 		if( internal_handle->extent_values_array != NULL )
 		{
 			libcdata_array_free(
@@ -288,6 +338,20 @@ int libvmdk_handle_free(
 
 			result = -1;
 		}
+		if( libcdata_array_free(
+		     &( internal_handle->corrupted_ranges_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_corrupted_range_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free corrupted ranges array.",
+			 function );
+
+			result = -1;
+		}
 		if( libvmdk_io_handle_free(
 		     &( internal_handle->io_handle ),
 		     error ) != 1 )
@@ -343,6 +407,11 @@ int libvmdk_handle_signal_abort(
 	}
 	internal_handle->io_handle->abort = 1;
 
+	/* Cancel the read requests that are pending
+	 */
+	libvmdk_handle_abort_generation_increment(
+	 &( internal_handle->abort_generation ) );
+
 	return( 1 );
 }
 
@@ -1013,6 +1082,32 @@ int libvmdk_handle_open_file_io_handle(
 
 		return( -1 );
 	}
+	if( ( ( access_flags & LIBVMDK_ACCESS_FLAG_TRUST_PRIMARY_GRAIN_DIRECTORY ) != 0 )
+	 && ( ( access_flags & LIBVMDK_ACCESS_FLAG_VERIFY_GRAIN_DIRECTORIES ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags - cannot both trust and verify the primary grain directory.",
+		 function );
+
+		return( -1 );
+	}
+	/* All the grain directories need to be read to verify them
+	 */
+	if( ( ( access_flags & LIBVMDK_ACCESS_FLAG_VERIFY_GRAIN_DIRECTORIES ) != 0 )
+	 && ( ( access_flags & LIBVMDK_ACCESS_FLAG_READ_EXTENTS_ON_DEMAND ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags - cannot verify grain directories when reading extents on demand.",
+		 function );
+
+		return( -1 );
+	}
 	if( ( access_flags & LIBVMDK_ACCESS_FLAG_READ ) != 0 )
 	{
 		bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
@@ -1836,16 +1931,20 @@ on_error:
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
-/* Closes the VMDK file(s)
- * Returns 0 if successful or -1 on error
+/* Opens the change tracking file
+ * The filename of the change tracking file can be retrieved from the descriptor file
+ * This function is experimental
+ * Returns 1 if successful or -1 on error
  */
-int libvmdk_handle_close(
+int libvmdk_handle_open_change_tracking_file(
      libvmdk_handle_t *handle,
+     const char *filename,
      libcerror_error_t **error )
 {
+	libbfio_handle_t *file_io_handle           = NULL;
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_close";
-	int result                                 = 0;
+	static char *function                      = "libvmdk_handle_open_change_tracking_file";
+	size_t filename_length                     = 0;
 
 	if( handle == NULL )
 	{
@@ -1860,172 +1959,96 @@ int libvmdk_handle_close(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( internal_handle->descriptor_file == NULL )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing descriptor file.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		return( -1 );
-	}
-#endif
-	if( internal_handle->extent_data_file_io_pool_created_in_library != 0 )
-	{
-		if( libbfio_pool_close_all(
-		     internal_handle->extent_data_file_io_pool,
-		     error ) != 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close all files in extent data file IO pool.",
-			 function );
-
-			result = -1;
-		}
-		if( libbfio_pool_free(
-		     &( internal_handle->extent_data_file_io_pool ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free extent data file IO pool.",
-			 function );
-
-			result = -1;
-		}
-		internal_handle->extent_data_file_io_pool_created_in_library = 0;
+		goto on_error;
 	}
-	internal_handle->extent_data_file_io_pool = NULL;
-	internal_handle->current_offset           = 0;
-
-	if( libvmdk_io_handle_clear(
-	     internal_handle->io_handle,
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
 		 function );
 
-		result = -1;
-	}
-	if( internal_handle->descriptor_file != NULL )
-	{
-		if( libvmdk_descriptor_file_free(
-		     &( internal_handle->descriptor_file ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free descriptor file.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->grain_table != NULL )
-	{
-		if( libvmdk_grain_table_free(
-		     &( internal_handle->grain_table ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free grain table.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->grains_cache != NULL )
-	{
-		if( libfcache_cache_free(
-		     &( internal_handle->grains_cache ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free grains cache.",
-			 function );
-
-			result = -1;
-		}
+		goto on_error;
 	}
-	if( libvmdk_extent_table_clear(
-	     internal_handle->extent_table,
+	if( libvmdk_handle_open_change_tracking_file_io_handle(
+	     handle,
+	     file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear extent table.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open change tracking file.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
+	/* The file IO handle is now owned by the handle
+	 */
+	internal_handle->change_tracking_file_io_handle_created_in_library = 1;
 
-		return( -1 );
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
 	}
-#endif
-	return( result );
+	return( -1 );
 }
 
-/* Opens a handle for reading
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Opens the change tracking file
+ * The filename of the change tracking file can be retrieved from the descriptor file
+ * This function is experimental
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_internal_handle_open_read(
-     libvmdk_internal_handle_t *internal_handle,
-     libbfio_handle_t *file_io_handle,
+int libvmdk_handle_open_change_tracking_file_wide(
+     libvmdk_handle_t *handle,
+     const wchar_t *filename,
      libcerror_error_t **error )
 {
-	libvmdk_extent_file_t *extent_file = NULL;
-	uint8_t *descriptor_data           = NULL;
-	static char *function              = "libvmdk_internal_handle_open_read";
-	uint8_t file_type                  = 0;
-	int result                         = 0;
+	libbfio_handle_t *file_io_handle           = NULL;
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_open_change_tracking_file_wide";
+	size_t filename_length                     = 0;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2036,283 +2059,99 @@ int libvmdk_internal_handle_open_read(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->descriptor_file != NULL )
+	filename_length = wide_string_length(
+	                   filename );
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - descriptor file already set.",
-		 function );
-
-		return( -1 );
-	}
-	result = libvmdk_internal_handle_open_read_signature(
-		  file_io_handle,
-		  &file_type,
-		  error );
-
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read signature.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	else if( result == 0 )
-	{
-		file_type = LIBVMDK_FILE_TYPE_RAW_DATA;
-	}
-	switch( file_type )
-	{
-		case LIBVMDK_FILE_TYPE_DESCRIPTOR_FILE:
-			if( libvmdk_descriptor_file_initialize(
-			     &( internal_handle->descriptor_file ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create descriptor file.",
-				 function );
-
-				goto on_error;
-			}
-			if( libvmdk_descriptor_file_read_file_io_handle(
-			     internal_handle->descriptor_file,
-			     file_io_handle,
-			     internal_handle->extent_values_array,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read descriptor file.",
-				 function );
-
-				goto on_error;
-			}
-			break;
-
-		case LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA:
-			if( libvmdk_extent_file_initialize(
-			     &extent_file,
-			     internal_handle->io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create extent file.",
-				 function );
-
-				goto on_error;
-			}
-			if( libvmdk_extent_file_read_file_header_file_io_handle(
-			     extent_file,
-			     file_io_handle,
-			     0,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read extent file header.",
-				 function );
-
-				goto on_error;
-			}
-			if( extent_file->descriptor_size > 0 )
-			{
-				if( libvmdk_descriptor_file_initialize(
-				     &( internal_handle->descriptor_file ),
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to create descriptor file.",
-					 function );
-
-					goto on_error;
-				}
-				if( extent_file->descriptor_size > (size64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-					 "%s: invalid extent file - descriptor size value exceeds maximum allocation size.",
-					 function );
-
-					goto on_error;
-				}
-				descriptor_data = (uint8_t *) memory_allocate(
-							       sizeof( uint8_t ) * (size_t) extent_file->descriptor_size );
-
-				if( descriptor_data == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-					 "%s: unable to create descriptor data.",
-					 function );
-
-					goto on_error;
-				}
-				if( libvmdk_extent_file_read_descriptor_data_file_io_handle(
-				     extent_file,
-				     file_io_handle,
-				     descriptor_data,
-				     (size_t) extent_file->descriptor_size,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read descriptor data.",
-					 function );
-
-					goto on_error;
-				}
-				if( libvmdk_descriptor_file_read_string(
-				     internal_handle->descriptor_file,
-				     (char *) descriptor_data,
-				     (size_t) extent_file->descriptor_size,
-				     internal_handle->extent_values_array,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read descriptor from string.",
-					 function );
-
-					goto on_error;
-				}
-				memory_free(
-				 descriptor_data );
-
-				descriptor_data = NULL;
-			}
-			if( libvmdk_extent_file_free(
-			     &extent_file,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free extent file.",
-				 function );
-
-				goto on_error;
-			}
-			break;
-
-		case LIBVMDK_FILE_TYPE_RAW_DATA:
-		case LIBVMDK_FILE_TYPE_COWD_SPARSE_DATA:
-		default:
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported file type.",
-			 function );
-
-			goto on_error;
-	}
-	if( libvmdk_descriptor_file_get_disk_type(
-	     internal_handle->descriptor_file,
-	     &( internal_handle->disk_type ),
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve disk type.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	if( libvmdk_descriptor_file_get_media_size(
-	     internal_handle->descriptor_file,
-	     &( internal_handle->io_handle->media_size ),
+	if( libvmdk_handle_open_change_tracking_file_io_handle(
+	     handle,
+	     file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve media size.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open change tracking file.",
 		 function );
 
 		goto on_error;
 	}
+	/* The file IO handle is now owned by the handle
+	 */
+	internal_handle->change_tracking_file_io_handle_created_in_library = 1;
+
 	return( 1 );
 
 on_error:
-	if( descriptor_data != NULL )
-	{
-		memory_free(
-		 descriptor_data );
-	}
-	if( extent_file != NULL )
-	{
-		libvmdk_extent_file_free(
-		 &extent_file,
-		 NULL );
-	}
-	if( internal_handle->descriptor_file != NULL )
+	if( file_io_handle != NULL )
 	{
-		libvmdk_descriptor_file_free(
-		 &( internal_handle->descriptor_file ),
+		libbfio_handle_free(
+		 &file_io_handle,
 		 NULL );
 	}
 	return( -1 );
 }
 
-/* Reads the extent data files
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Opens the change tracking file using a Basic File IO (bfio) handle
+ * This function is experimental
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_internal_handle_open_read_extent_data_files(
-     libvmdk_internal_handle_t *internal_handle,
-     libbfio_pool_t *file_io_pool,
+int libvmdk_handle_open_change_tracking_file_io_handle(
+     libvmdk_handle_t *handle,
+     libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
-	libvmdk_extent_file_t *extent_file     = NULL;
-	libvmdk_extent_values_t *extent_values = NULL;
-	static char *function                  = "libvmdk_internal_handle_open_read_extent_data_files";
-	size64_t extent_file_size              = 0;
-	int extent_index                       = 0;
-	int number_of_extents                  = 0;
-	int number_of_file_io_handles          = 0;
+	libvmdk_change_tracking_file_t *change_tracking_file = NULL;
+	libvmdk_internal_handle_t *internal_handle           = NULL;
+	static char *function                                = "libvmdk_handle_open_change_tracking_file_io_handle";
+	uint8_t file_io_handle_opened_in_library             = 0;
+	int file_io_handle_is_open                           = 0;
+	int result                                           = 1;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2323,618 +2162,5145 @@ int libvmdk_internal_handle_open_read_extent_data_files(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->descriptor_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing descriptor file.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->descriptor_file == NULL )
+	if( internal_handle->change_tracking_file != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing descriptor file.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - change tracking file already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->grain_table != NULL )
+	if( file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - grain table already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->grains_cache != NULL )
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - grains cache already set.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( libcdata_array_get_number_of_entries(
-	     internal_handle->extent_values_array,
-	     &number_of_extents,
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_ACCESS_FLAG_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		file_io_handle_opened_in_library = 1;
+	}
+	if( libvmdk_change_tracking_file_initialize(
+	     &change_tracking_file,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of extents.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create change tracking file.",
 		 function );
 
 		goto on_error;
 	}
-	if( number_of_extents == 0 )
+	if( libvmdk_change_tracking_file_read_file_header(
+	     change_tracking_file,
+	     file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing extents.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read change tracking file header.",
 		 function );
 
 		goto on_error;
 	}
-	if( libbfio_pool_get_number_of_handles(
-	     file_io_pool,
-	     &number_of_file_io_handles,
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve the number of file IO handles.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( number_of_extents != number_of_file_io_handles )
+#endif
+	/* The change tracking file must describe the same (storage) media
+	 */
+	if( change_tracking_file->media_size != internal_handle->descriptor_file->media_size )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: mismatch between number of file IO handles in pool and number of extents in metadata.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: mismatch between change tracking file and descriptor file media size.",
 		 function );
 
-		goto on_error;
+		result = -1;
 	}
-	if( libvmdk_extent_table_initialize_extents(
-	     internal_handle->extent_table,
-	     number_of_extents,
-	     internal_handle->disk_type,
+	else
+	{
+		internal_handle->change_tracking_file                              = change_tracking_file;
+		internal_handle->change_tracking_file_io_handle                    = file_io_handle;
+		internal_handle->change_tracking_file_io_handle_created_in_library = 0;
+		internal_handle->change_tracking_file_io_handle_opened_in_library  = file_io_handle_opened_in_library;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize extent table extents.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
+		return( -1 );
+	}
+#endif
+	if( result != 1 )
+	{
 		goto on_error;
 	}
-	if( libvmdk_grain_table_initialize(
-	     &( internal_handle->grain_table ),
-	     internal_handle->io_handle,
+	return( 1 );
+
+on_error:
+	if( change_tracking_file != NULL )
+	{
+		libvmdk_change_tracking_file_free(
+		 &change_tracking_file,
+		 NULL );
+	}
+	if( file_io_handle_opened_in_library != 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes the VMDK file(s)
+ * Returns 0 if successful or -1 on error
+ */
+int libvmdk_handle_close(
+     libvmdk_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_close";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	/* The read requests thread pool is joined before the read/write lock is grabbed
+	 * since processing the pending read requests requires the lock
+	 */
+	if( libvmdk_internal_handle_join_read_requests_thread_pool(
+	     internal_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create grain table.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join read requests thread pool.",
 		 function );
 
-		goto on_error;
+		result = -1;
 	}
-	if( libfcache_cache_initialize(
-	     &( internal_handle->grains_cache ),
-	     LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAINS,
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create grains cache.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	for( extent_index = 0;
-	     extent_index < number_of_extents;
-	     extent_index++ )
+#endif
+	if( internal_handle->extent_data_file_io_pool_created_in_library != 0 )
 	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_handle->extent_values_array,
-		     extent_index,
-		     (intptr_t **) &extent_values,
-		     error ) != 1 )
+		if( libbfio_pool_close_all(
+		     internal_handle->extent_data_file_io_pool,
+		     error ) != 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve extent values: %d from array.",
-			 function,
-			 extent_index );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close all files in extent data file IO pool.",
+			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libbfio_pool_get_size(
-		     file_io_pool,
-		     extent_index,
-		     &extent_file_size,
+		if( libbfio_pool_free(
+		     &( internal_handle->extent_data_file_io_pool ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve size of file IO pool entry: %d.",
-			 function,
-			 extent_index );
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free extent data file IO pool.",
+			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libvmdk_extent_table_set_extent_by_extent_values(
-		     internal_handle->extent_table,
-		     extent_values,
-		     extent_index,
-		     extent_index,
-		     extent_file_size,
-		     extent_values->offset,
-		     extent_values->size,
+		internal_handle->extent_data_file_io_pool_created_in_library = 0;
+	}
+	internal_handle->extent_data_file_io_pool = NULL;
+	internal_handle->current_offset           = 0;
+
+	if( internal_handle->change_tracking_file != NULL )
+	{
+		if( libvmdk_change_tracking_file_free(
+		     &( internal_handle->change_tracking_file ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set extent: %d in table.",
-			 function,
-			 extent_index );
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free change tracking file.",
+			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		if( ( extent_values->type == LIBVMDK_EXTENT_TYPE_SPARSE )
-		 || ( extent_values->type == LIBVMDK_EXTENT_TYPE_VMFS_SPARSE ) )
+	}
+	if( internal_handle->change_tracking_file_io_handle_opened_in_library != 0 )
+	{
+		if( libbfio_handle_close(
+		     internal_handle->change_tracking_file_io_handle,
+		     error ) != 0 )
 		{
-			if( libvmdk_extent_file_initialize(
-			     &extent_file,
-			     internal_handle->io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create extent file: %d.",
-				 function,
-				 extent_index );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close change tracking file IO handle.",
+			 function );
 
-				goto on_error;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "Reading extent file: %d file header:\n",
-				 extent_index );
-			}
-#endif
-			if( libvmdk_extent_file_read_file_header(
-			     extent_file,
-			     file_io_pool,
-			     extent_index,
-			     0,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read extent file: %d header.",
-				 function,
-				 extent_index );
-
-				goto on_error;
-			}
-			if( ( extent_file->file_type != LIBVMDK_FILE_TYPE_COWD_SPARSE_DATA )
-			 && ( extent_file->file_type != LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA ) )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-				 "%s: extent file type not supported for extent type.",
-				 function );
-
-				goto on_error;
-			}
-			if( ( internal_handle->disk_type != LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
-			 && ( extent_file->file_type == LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
-			 && ( ( extent_file->flags & LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION ) != LIBVMDK_COMPRESSION_METHOD_NONE ) )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-				 "%s: grain compression not supported for disk type.",
-				 function );
-
-				goto on_error;
-			}
-			if( ( extent_file->file_type == LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
-			 && ( extent_file->primary_grain_directory_offset == (off64_t) -1 )
-			 && ( extent_file->compression_method == LIBVMDK_COMPRESSION_METHOD_DEFLATE ) )
-			{
-				if( libvmdk_extent_file_read_file_header(
-				     extent_file,
-				     file_io_pool,
-				     extent_index,
-				     extent_file_size - 1024,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read secondary extent file: %d header.",
-					 function,
-					 extent_index );
-
-					goto on_error;
-				}
-			}
-			if( extent_index == 0 )
-			{
-				internal_handle->io_handle->grain_size = extent_file->grain_size;
-			}
-			else if( extent_file->grain_size != internal_handle->io_handle->grain_size )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_INPUT,
-				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-				 "%s: extent file: %d grain size mismatch.",
-				 function,
-				 extent_index );
+			result = -1;
+		}
+		internal_handle->change_tracking_file_io_handle_opened_in_library = 0;
+	}
+	if( internal_handle->change_tracking_file_io_handle_created_in_library != 0 )
+	{
+		if( libbfio_handle_free(
+		     &( internal_handle->change_tracking_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free change tracking file IO handle.",
+			 function );
 
-				goto on_error;
-			}
-			if( extent_file->is_dirty != 0 )
-			{
-				internal_handle->io_handle->is_dirty = 1;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "Reading extent file: %d grain directories:\n",
-				 extent_index );
-			}
-#endif
-			if( libvmdk_extent_file_read_grain_directories(
-			     extent_file,
-			     file_io_pool,
-			     extent_index,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read extent file: %d grain directories.",
-				 function,
-				 extent_index );
+			result = -1;
+		}
+		internal_handle->change_tracking_file_io_handle_created_in_library = 0;
+	}
+	internal_handle->change_tracking_file_io_handle = NULL;
 
-				goto on_error;
-			}
-			if( libvmdk_extent_table_set_extent_storage_media_size_by_index(
-			     internal_handle->extent_table,
-			     extent_index,
-			     extent_file->storage_media_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to set mapped range of element: %d in extent table.",
-				 function,
-				 extent_index );
+	if( libvmdk_io_handle_clear(
+	     internal_handle->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
 
-				goto on_error;
-			}
-			if( libvmdk_extent_file_free(
-			     &extent_file,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free extent file.",
-				 function );
+		result = -1;
+	}
+	if( internal_handle->descriptor_file != NULL )
+	{
+		if( libvmdk_descriptor_file_free(
+		     &( internal_handle->descriptor_file ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free descriptor file.",
+			 function );
 
-				goto on_error;
-			}
+			result = -1;
 		}
-		else if( ( extent_values->type != LIBVMDK_EXTENT_TYPE_FLAT )
-		      && ( extent_values->type != LIBVMDK_EXTENT_TYPE_VMFS_FLAT ) )
+	}
+	if( internal_handle->grain_table != NULL )
+	{
+		if( libvmdk_grain_table_free(
+		     &( internal_handle->grain_table ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported extent type.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free grain table.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		if( internal_handle->io_handle->abort == 1 )
+	}
+	if( internal_handle->grains_cache != NULL )
+	{
+		if( libfcache_cache_free(
+		     &( internal_handle->grains_cache ),
+		     error ) != 1 )
 		{
-			goto on_error;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free grains cache.",
+			 function );
+
+			result = -1;
 		}
 	}
-	return( 1 );
-
-on_error:
-	if( extent_file != NULL )
+	if( libvmdk_extent_table_clear(
+	     internal_handle->extent_table,
+	     error ) != 1 )
 	{
-		libvmdk_extent_file_free(
-		 &extent_file,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear extent table.",
+		 function );
+
+		result = -1;
 	}
-	if( internal_handle->grains_cache != NULL )
+	if( libcdata_array_empty(
+	     internal_handle->corrupted_ranges_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_corrupted_range_free,
+	     error ) != 1 )
 	{
-		libfcache_cache_free(
-		 &( internal_handle->grains_cache ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty corrupted ranges array.",
+		 function );
+
+		result = -1;
 	}
-	if( internal_handle->grain_table != NULL )
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		libvmdk_grain_table_free(
-		 &( internal_handle->grain_table ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
 	}
-	return( -1 );
+#endif
+	return( result );
 }
 
-/* Reads the file signature and tries to determine the file type
- * Returns 1 if successful, 0 if no file type could be determined or -1 on error
+/* Opens a handle for reading
+ * Returns 1 if successful or -1 on error
  */
-int libvmdk_internal_handle_open_read_signature(
+int libvmdk_internal_handle_open_read(
+     libvmdk_internal_handle_t *internal_handle,
      libbfio_handle_t *file_io_handle,
-     uint8_t *file_type,
      libcerror_error_t **error )
 {
-	libcsplit_narrow_split_string_t *lines = NULL;
-	uint8_t *signature                     = NULL;
-	static char *function                  = "libvmdk_internal_handle_open_read_signature";
-	ssize_t read_count                     = 0;
-	int line_index                         = 0;
-	int number_of_lines                    = 0;
-	int result                             = 0;
+	libvmdk_extent_file_t *extent_file = NULL;
+	uint8_t *descriptor_data           = NULL;
+	static char *function              = "libvmdk_internal_handle_open_read";
+	uint8_t file_type                  = 0;
+	int result                         = 0;
 
-	if( file_type == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file type.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	signature = (uint8_t *) memory_allocate(
-	                         sizeof( uint8_t ) * 2048 );
-
-	if( signature == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create signature.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( memory_set(
-	     signature,
-	     0,
-	     sizeof( uint8_t ) * 2048 ) == NULL )
+	if( internal_handle->descriptor_file != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear signature.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - descriptor file already set.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	read_count = libbfio_handle_read_buffer_at_offset(
-	              file_io_handle,
-	              signature,
-	              32,
-	              0,
-	              error );
+	result = libvmdk_internal_handle_open_read_signature(
+		  file_io_handle,
+		  &file_type,
+		  error );
 
-	if( read_count != (ssize_t) 32 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read signature at offset: 0 (0x00000000).",
+		 "%s: unable to read signature.",
 		 function );
 
 		goto on_error;
 	}
-	if( memory_compare(
-	     signature,
-	     cowd_sparse_file_signature,
-	     4 ) == 0 )
+	else if( result == 0 )
 	{
-		*file_type = LIBVMDK_FILE_TYPE_COWD_SPARSE_DATA;
-		result     = 1;
+		file_type = LIBVMDK_FILE_TYPE_RAW_DATA;
+	}
+	switch( file_type )
+	{
+		case LIBVMDK_FILE_TYPE_DESCRIPTOR_FILE:
+			if( libvmdk_descriptor_file_initialize(
+			     &( internal_handle->descriptor_file ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create descriptor file.",
+				 function );
+
+				goto on_error;
+			}
+			if( libvmdk_descriptor_file_read_file_io_handle(
+			     internal_handle->descriptor_file,
+			     file_io_handle,
+			     internal_handle->extent_values_array,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read descriptor file.",
+				 function );
+
+				goto on_error;
+			}
+			break;
+
+		case LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA:
+			if( libvmdk_extent_file_initialize(
+			     &extent_file,
+			     internal_handle->io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create extent file.",
+				 function );
+
+				goto on_error;
+			}
+			if( libvmdk_extent_file_read_file_header_file_io_handle(
+			     extent_file,
+			     file_io_handle,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read extent file header.",
+				 function );
+
+				goto on_error;
+			}
+			if( extent_file->descriptor_size > 0 )
+			{
+				if( libvmdk_descriptor_file_initialize(
+				     &( internal_handle->descriptor_file ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create descriptor file.",
+					 function );
+
+					goto on_error;
+				}
+				if( extent_file->descriptor_size > (size64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+					 "%s: invalid extent file - descriptor size value exceeds maximum allocation size.",
+					 function );
+
+					goto on_error;
+				}
+				descriptor_data = (uint8_t *) memory_allocate(
+							       sizeof( uint8_t ) * (size_t) extent_file->descriptor_size );
+
+				if( descriptor_data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create descriptor data.",
+					 function );
+
+					goto on_error;
+				}
+				if( libvmdk_extent_file_read_descriptor_data_file_io_handle(
+				     extent_file,
+				     file_io_handle,
+				     descriptor_data,
+				     (size_t) extent_file->descriptor_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read descriptor data.",
+					 function );
+
+					goto on_error;
+				}
+				if( libvmdk_descriptor_file_read_string(
+				     internal_handle->descriptor_file,
+				     (char *) descriptor_data,
+				     (size_t) extent_file->descriptor_size,
+				     internal_handle->extent_values_array,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read descriptor from string.",
+					 function );
+
+					goto on_error;
+				}
+				memory_free(
+				 descriptor_data );
+
+				descriptor_data = NULL;
+			}
+			if( libvmdk_extent_file_free(
+			     &extent_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free extent file.",
+				 function );
+
+				goto on_error;
+			}
+			break;
+
+		case LIBVMDK_FILE_TYPE_RAW_DATA:
+		case LIBVMDK_FILE_TYPE_COWD_SPARSE_DATA:
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported file type.",
+			 function );
+
+			goto on_error;
+	}
+	if( libvmdk_descriptor_file_get_disk_type(
+	     internal_handle->descriptor_file,
+	     &( internal_handle->disk_type ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve disk type.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle->io_handle->disk_type = internal_handle->disk_type;
+
+	if( libvmdk_descriptor_file_get_media_size(
+	     internal_handle->descriptor_file,
+	     &( internal_handle->io_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( descriptor_data != NULL )
+	{
+		memory_free(
+		 descriptor_data );
+	}
+	if( extent_file != NULL )
+	{
+		libvmdk_extent_file_free(
+		 &extent_file,
+		 NULL );
+	}
+	if( internal_handle->descriptor_file != NULL )
+	{
+		libvmdk_descriptor_file_free(
+		 &( internal_handle->descriptor_file ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the extent data files
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_open_read_extent_data_files(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	libvmdk_extent_values_t *extent_values         = NULL;
+	static char *function                          = "libvmdk_internal_handle_open_read_extent_data_files";
+	size64_t extent_file_size                      = 0;
+	int extent_index                               = 0;
+	int maximum_number_of_cache_entries            = 0;
+	int number_of_extents                          = 0;
+	int number_of_file_io_handles                  = 0;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *read_thread_pool    = NULL;
+	libvmdk_extent_read_task_t **extent_read_tasks = NULL;
+	libvmdk_extent_read_task_t *extent_read_task   = NULL;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->grain_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - grain table already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->grains_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - grains cache already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_handle->extent_values_array,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_extents == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_get_number_of_handles(
+	     file_io_pool,
+	     &number_of_file_io_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of file IO handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extents != number_of_file_io_handles )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: mismatch between number of file IO handles in pool and number of extents in metadata.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_TRUST_PRIMARY_GRAIN_DIRECTORY ) != 0 )
+	{
+		internal_handle->io_handle->backup_grain_directory_mode = LIBVMDK_BACKUP_GRAIN_DIRECTORY_MODE_SKIP;
+	}
+	else if( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_VERIFY_GRAIN_DIRECTORIES ) != 0 )
+	{
+		internal_handle->io_handle->backup_grain_directory_mode = LIBVMDK_BACKUP_GRAIN_DIRECTORY_MODE_VERIFY;
+	}
+	else
+	{
+		internal_handle->io_handle->backup_grain_directory_mode = LIBVMDK_BACKUP_GRAIN_DIRECTORY_MODE_READ;
+	}
+	internal_handle->io_handle->number_of_grain_directory_mismatches = 0;
+
+	if( libvmdk_extent_table_initialize_extents(
+	     internal_handle->extent_table,
+	     number_of_extents,
+	     internal_handle->disk_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize extent table extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_grain_table_initialize(
+	     &( internal_handle->grain_table ),
+	     internal_handle->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create grain table.",
+		 function );
+
+		goto on_error;
+	}
+	/* The shared cache holds the grain data, hence the grains cache
+	 * only needs to hold the most recently read grain
+	 */
+	if( internal_handle->shared_cache != NULL )
+	{
+		maximum_number_of_cache_entries = LIBVMDK_MAXIMUM_CACHE_ENTRIES_SHARED_CACHE_GRAINS;
+	}
+	else
+	{
+		maximum_number_of_cache_entries = LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAINS;
+	}
+	if( libfcache_cache_initialize(
+	     &( internal_handle->grains_cache ),
+	     maximum_number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create grains cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_handle->shared_cache != NULL )
+	{
+		if( libvmdk_grain_table_set_shared_cache(
+		     internal_handle->grain_table,
+		     internal_handle->shared_cache,
+		     internal_handle->shared_cache_identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set shared cache in grain table.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( ( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_READ_EXTENTS_IN_PARALLEL ) != 0 )
+	 && ( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_READ_EXTENTS_ON_DEMAND ) == 0 )
+	 && ( number_of_extents > 1 ) )
+	{
+		extent_read_tasks = (libvmdk_extent_read_task_t **) memory_allocate(
+		                                                     sizeof( libvmdk_extent_read_task_t * ) * number_of_extents );
+
+		if( extent_read_tasks == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create extent read tasks.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     extent_read_tasks,
+		     0,
+		     sizeof( libvmdk_extent_read_task_t * ) * number_of_extents ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear extent read tasks.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_thread_pool_create(
+		     &read_thread_pool,
+		     NULL,
+		     LIBVMDK_NUMBER_OF_EXTENT_READ_THREADS,
+		     LIBVMDK_NUMBER_OF_EXTENT_READ_THREADS * 2,
+		     (int (*)(intptr_t *, void *)) &libvmdk_extent_read_task_run,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_handle->extent_values_array,
+		     extent_index,
+		     (intptr_t **) &extent_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent values: %d from array.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libbfio_pool_get_size(
+		     file_io_pool,
+		     extent_index,
+		     &extent_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size of file IO pool entry: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libvmdk_extent_table_set_extent_by_extent_values(
+		     internal_handle->extent_table,
+		     extent_values,
+		     extent_index,
+		     extent_index,
+		     extent_file_size,
+		     extent_values->offset,
+		     extent_values->size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set extent: %d in table.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( ( extent_values->type == LIBVMDK_EXTENT_TYPE_SPARSE )
+		 || ( extent_values->type == LIBVMDK_EXTENT_TYPE_VMFS_SPARSE ) )
+		{
+			/* When reading extents on demand only the first extent data file is read
+			 * to determine the grain size, the other extent data files are read
+			 * by the extent files list on first access
+			 */
+			if( ( extent_index > 0 )
+			 && ( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_READ_EXTENTS_ON_DEMAND ) != 0 ) )
+			{
+				continue;
+			}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+			if( read_thread_pool != NULL )
+			{
+				if( libvmdk_extent_read_task_initialize(
+				     &( extent_read_tasks[ extent_index ] ),
+				     internal_handle->io_handle,
+				     file_io_pool,
+				     extent_index,
+				     extent_file_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create extent read task: %d.",
+					 function,
+					 extent_index );
+
+					goto on_error;
+				}
+				if( libcthreads_thread_pool_push(
+				     read_thread_pool,
+				     (intptr_t *) extent_read_tasks[ extent_index ],
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to push extent read task: %d onto read thread pool.",
+					 function,
+					 extent_index );
+
+					goto on_error;
+				}
+			}
+			else
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+			if( libvmdk_internal_handle_open_read_extent_file(
+			     internal_handle,
+			     file_io_pool,
+			     extent_index,
+			     extent_file_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read extent file: %d.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+		}
+		else if( ( extent_values->type != LIBVMDK_EXTENT_TYPE_FLAT )
+		      && ( extent_values->type != LIBVMDK_EXTENT_TYPE_VMFS_FLAT ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported extent type.",
+			 function );
+
+			goto on_error;
+		}
+		if( internal_handle->io_handle->abort == 1 )
+		{
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( read_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &read_thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join read thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		/* The extent files are validated in order since the first extent
+		 * determines the grain size
+		 */
+		for( extent_index = 0;
+		     extent_index < number_of_extents;
+		     extent_index++ )
+		{
+			extent_read_task = extent_read_tasks[ extent_index ];
+
+			if( extent_read_task == NULL )
+			{
+				continue;
+			}
+			if( extent_read_task->result != 1 )
+			{
+				if( ( error != NULL )
+				 && ( *error == NULL ) )
+				{
+					*error = extent_read_task->error;
+
+					extent_read_task->error = NULL;
+				}
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read extent file: %d.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+			if( libvmdk_internal_handle_set_extent_file(
+			     internal_handle,
+			     file_io_pool,
+			     extent_index,
+			     extent_read_task->extent_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set extent file: %d.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+			extent_read_task->extent_file = NULL;
+
+			if( libvmdk_extent_read_task_free(
+			     &( extent_read_tasks[ extent_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free extent read task: %d.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+		}
+		memory_free(
+		 extent_read_tasks );
+
+		extent_read_tasks = NULL;
+	}
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
+	if( libvmdk_extent_table_calculate_extent_offsets(
+	     internal_handle->extent_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate extent offsets in extent table.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( read_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &read_thread_pool,
+		 NULL );
+	}
+	if( extent_read_tasks != NULL )
+	{
+		for( extent_index = 0;
+		     extent_index < number_of_extents;
+		     extent_index++ )
+		{
+			if( extent_read_tasks[ extent_index ] != NULL )
+			{
+				libvmdk_extent_read_task_free(
+				 &( extent_read_tasks[ extent_index ] ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 extent_read_tasks );
+	}
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+	if( internal_handle->grains_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &( internal_handle->grains_cache ),
+		 NULL );
+	}
+	if( internal_handle->grain_table != NULL )
+	{
+		libvmdk_grain_table_free(
+		 &( internal_handle->grain_table ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads an extent data file and sets the corresponding extent file in the extent table
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_open_read_extent_file(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int extent_index,
+     size64_t extent_file_size,
+     libcerror_error_t **error )
+{
+	libvmdk_extent_file_t *extent_file = NULL;
+	static char *function              = "libvmdk_internal_handle_open_read_extent_file";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_extent_file_initialize(
+	     &extent_file,
+	     internal_handle->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create extent file: %d.",
+		 function,
+		 extent_index );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Reading extent file: %d file header and grain directories:\n",
+		 extent_index );
+	}
+#endif
+	if( libvmdk_extent_file_read_file_io_pool(
+	     extent_file,
+	     file_io_pool,
+	     extent_index,
+	     extent_file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read extent file: %d.",
+		 function,
+		 extent_index );
+
+		goto on_error;
+	}
+	if( libvmdk_internal_handle_set_extent_file(
+	     internal_handle,
+	     file_io_pool,
+	     extent_index,
+	     extent_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set extent file: %d.",
+		 function,
+		 extent_index );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( extent_file != NULL )
+	{
+		libvmdk_extent_file_free(
+		 &extent_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Validates an extent file and sets it in the extent table
+ * The extent table takes over management of the extent file if successful
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_set_extent_file(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int extent_index,
+     libvmdk_extent_file_t *extent_file,
+     libcerror_error_t **error )
+{
+	libvmdk_extent_values_t *extent_values = NULL;
+	static char *function                  = "libvmdk_internal_handle_set_extent_file";
+	size64_t mapped_size                   = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	/* When reading extents on demand the extent sizes of the descriptor file
+	 * are used so that all extents are mapped consistently, hence the storage
+	 * media size of the extent file must correspond to the extent size
+	 */
+	if( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_READ_EXTENTS_ON_DEMAND ) != 0 )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_handle->extent_values_array,
+		     extent_index,
+		     (intptr_t **) &extent_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d values from array.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		if( extent_values == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing extent: %d values.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		mapped_size = extent_values->size;
+	}
+	if( libvmdk_extent_file_validate(
+	     extent_file,
+	     internal_handle->io_handle,
+	     extent_index,
+	     mapped_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported extent file: %d.",
+		 function,
+		 extent_index );
+
+		return( -1 );
+	}
+	if( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_READ_EXTENTS_ON_DEMAND ) == 0 )
+	{
+		if( libvmdk_extent_table_set_extent_storage_media_size_by_index(
+		     internal_handle->extent_table,
+		     extent_index,
+		     extent_file->storage_media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to set mapped range of element: %d in extent table.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+	}
+	/* Retain the extent file, which contains the file header values
+	 * and the grain directory, so they do not need to be read again
+	 */
+	if( libvmdk_extent_table_set_extent_file_by_index(
+	     internal_handle->extent_table,
+	     file_io_pool,
+	     extent_index,
+	     extent_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set extent file: %d in extent table.",
+		 function,
+		 extent_index );
+
+		return( -1 );
+	}
+	/* The grain groups of a replaced extent file can no longer be used
+	 */
+	if( internal_handle->grain_table != NULL )
+	{
+		if( libvmdk_grain_table_reset_last_grain_group(
+		     internal_handle->grain_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to reset last grain group in grain table.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads the file signature and tries to determine the file type
+ * Returns 1 if successful, 0 if no file type could be determined or -1 on error
+ */
+int libvmdk_internal_handle_open_read_signature(
+     libbfio_handle_t *file_io_handle,
+     uint8_t *file_type,
+     libcerror_error_t **error )
+{
+	libcsplit_narrow_split_string_t *lines = NULL;
+	uint8_t *signature                     = NULL;
+	static char *function                  = "libvmdk_internal_handle_open_read_signature";
+	ssize_t read_count                     = 0;
+	int line_index                         = 0;
+	int number_of_lines                    = 0;
+	int result                             = 0;
+
+	if( file_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file type.",
+		 function );
+
+		return( -1 );
+	}
+	signature = (uint8_t *) memory_allocate(
+	                         sizeof( uint8_t ) * 2048 );
+
+	if( signature == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create signature.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     signature,
+	     0,
+	     sizeof( uint8_t ) * 2048 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear signature.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              signature,
+	              32,
+	              0,
+	              error );
+
+	if( read_count != (ssize_t) 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read signature at offset: 0 (0x00000000).",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     signature,
+	     cowd_sparse_file_signature,
+	     4 ) == 0 )
+	{
+		*file_type = LIBVMDK_FILE_TYPE_COWD_SPARSE_DATA;
+		result     = 1;
+	}
+	else if( memory_compare(
+	          signature,
+	          vmdk_sparse_file_signature,
+	          4 ) == 0 )
+	{
+		*file_type = LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA;
+		result     = 1;
+	}
+	else if( signature[ 0 ] == '#' )
+	{
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              &( signature[ 32 ] ),
+		              2048 - 32,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read signature.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcsplit_narrow_string_split(
+		     (char *) signature,
+		     32 + read_count,
+		     '\n',
+		     &lines,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to split file data into lines.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcsplit_narrow_split_string_get_number_of_segments(
+		     lines,
+		     &number_of_lines,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to retrieve number of lines.",
+			 function );
+
+			goto on_error;
+		}
+		result = libvmdk_descriptor_file_read_signature(
+			  lines,
+			  number_of_lines,
+			  &line_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read descriptor file.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			*file_type = LIBVMDK_FILE_TYPE_DESCRIPTOR_FILE;
+		}
+		if( libcsplit_narrow_split_string_free(
+		     &lines,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free lines.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 signature );
+
+	return( result );
+
+on_error:
+	if( lines != NULL )
+	{
+		libcsplit_narrow_split_string_free(
+		 &lines,
+		 NULL );
+	}
+	if( signature != NULL )
+	{
+		memory_free(
+		 signature );
+	}
+	return( -1 );
+}
+
+/* Determines the size of the run of grains that are stored contiguously in the same extent data file
+ * The run starts with the grain of the grain descriptor and only contains uncompressed grains
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_get_contiguous_grains_size(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t grain_index,
+     libvmdk_grain_descriptor_t *grain_descriptor,
+     size_t maximum_size,
+     size_t *contiguous_size,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_descriptor_t next_grain_descriptor;
+
+	static char *function = "libvmdk_internal_handle_get_contiguous_grains_size";
+	size64_t grain_size   = 0;
+	size_t size           = 0;
+	off64_t grain_offset  = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( contiguous_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid contiguous size.",
+		 function );
+
+		return( -1 );
+	}
+	grain_size = internal_handle->io_handle->grain_size;
+
+	if( ( grain_descriptor->flags != 0 )
+	 || ( grain_descriptor->data_offset != 0 )
+	 || ( grain_descriptor->size != grain_size )
+	 || ( (size64_t) maximum_size < grain_size ) )
+	{
+		*contiguous_size = 0;
+
+		return( 1 );
+	}
+	size         = (size_t) grain_size;
+	grain_offset = grain_descriptor->offset + (off64_t) grain_size;
+
+	while( (size64_t) ( maximum_size - size ) >= grain_size )
+	{
+		grain_index += 1;
+
+		if( libvmdk_grain_table_get_grain_at_offset(
+		     internal_handle->grain_table,
+		     grain_index,
+		     file_io_pool,
+		     internal_handle->extent_table,
+		     (off64_t) ( grain_index * grain_size ),
+		     &next_grain_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain: %" PRIu64 ".",
+			 function,
+			 grain_index );
+
+			return( -1 );
+		}
+		if( ( next_grain_descriptor.flags != 0 )
+		 || ( next_grain_descriptor.file_index != grain_descriptor->file_index )
+		 || ( next_grain_descriptor.offset != grain_offset )
+		 || ( next_grain_descriptor.size != grain_size ) )
+		{
+			break;
+		}
+		size         += (size_t) grain_size;
+		grain_offset += (off64_t) grain_size;
+	}
+	*contiguous_size = size;
+
+	return( 1 );
+}
+
+/* Reads (media) data at the current offset into a buffer using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvmdk_internal_handle_read_buffer_from_file_io_pool(
+         libvmdk_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libvmdk_grain_descriptor_t grain_descriptor;
+
+	libvmdk_grain_data_t *grain_data = NULL;
+	static char *function            = "libvmdk_internal_handle_read_buffer_from_file_io_pool";
+	size_t buffer_offset             = 0;
+	size_t contiguous_size           = 0;
+	size_t maximum_contiguous_size   = 0;
+	size_t read_size                 = 0;
+	ssize_t read_count               = 0;
+	off64_t grain_data_offset        = 0;
+	uint64_t grain_index             = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->descriptor_file->parent_content_identifier_set != 0 )
+	 && ( internal_handle->descriptor_file->parent_content_identifier != 0xffffffffUL ) )
+	{
+		if( internal_handle->parent_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing parent handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid element data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->io_handle->abort = 0;
+
+	if( buffer_size == 0 )
+	{
+		return( 0 );
+	}
+	if( (size64_t) internal_handle->current_offset >= internal_handle->io_handle->media_size )
+	{
+		return( 0 );
+	}
+	if( internal_handle->extent_table->extent_files_stream != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: requested offset\t\t\t\t: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 internal_handle->current_offset,
+			 internal_handle->current_offset );
+		}
+#endif
+		read_size = buffer_size;
+
+		if( ( (size64_t) read_size > internal_handle->io_handle->media_size )
+		 || ( (size64_t) internal_handle->current_offset > ( internal_handle->io_handle->media_size - read_size ) ) )
+		{
+			read_size = (size_t) ( internal_handle->io_handle->media_size - internal_handle->current_offset );
+		}
+		read_count = libfdata_stream_read_buffer_at_offset(
+		              internal_handle->extent_table->extent_files_stream,
+			      (intptr_t *) file_io_pool,
+			      (uint8_t *) buffer,
+			      read_size,
+			      internal_handle->current_offset,
+			      0,
+			      error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from extent files stream at offset: %" PRIi64 " (0x%" PRIx64 ").",
+			 function,
+			 internal_handle->current_offset,
+			 internal_handle->current_offset );
+
+			return( -1 );
+		}
+		internal_handle->current_offset += (off64_t) read_size;
+
+		buffer_offset = read_size;
+	}
+	else
+	{
+		grain_index       = internal_handle->current_offset / internal_handle->io_handle->grain_size;
+		grain_data_offset = (off64_t) ( internal_handle->current_offset % internal_handle->io_handle->grain_size );
+
+		while( buffer_offset < buffer_size )
+		{
+			if( libvmdk_grain_table_get_grain_at_offset(
+			     internal_handle->grain_table,
+			     grain_index,
+			     file_io_pool,
+			     internal_handle->extent_table,
+			     internal_handle->current_offset,
+			     &grain_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve grain: %" PRIu64 ".",
+				 function,
+				 grain_index );
+
+				return( -1 );
+			}
+			read_size = (size_t) ( internal_handle->io_handle->grain_size - grain_data_offset );
+
+			if( read_size > ( buffer_size - buffer_offset ) )
+			{
+				read_size = buffer_size - buffer_offset;
+			}
+			if( ( (size64_t) read_size > internal_handle->io_handle->media_size )
+			 || ( (size64_t) internal_handle->current_offset > ( internal_handle->io_handle->media_size - read_size ) ) )
+			{
+				read_size = (size_t) ( internal_handle->io_handle->media_size - internal_handle->current_offset );
+			}
+			contiguous_size = 0;
+
+			/* Uncompressed grains that are stored contiguously are read directly into the buffer
+			 * with a single read instead of a read per grain
+			 */
+			if( ( grain_descriptor.flags == 0 )
+			 && ( grain_data_offset == 0 )
+			 && ( (size64_t) read_size == internal_handle->io_handle->grain_size )
+			 && ( ( buffer_size - buffer_offset ) > read_size ) )
+			{
+				maximum_contiguous_size = buffer_size - buffer_offset;
+
+				if( (size64_t) maximum_contiguous_size > ( internal_handle->io_handle->media_size - internal_handle->current_offset ) )
+				{
+					maximum_contiguous_size = (size_t) ( internal_handle->io_handle->media_size - internal_handle->current_offset );
+				}
+				if( maximum_contiguous_size > LIBVMDK_MAXIMUM_CONTIGUOUS_GRAINS_READ_SIZE )
+				{
+					maximum_contiguous_size = LIBVMDK_MAXIMUM_CONTIGUOUS_GRAINS_READ_SIZE;
+				}
+				if( libvmdk_internal_handle_get_contiguous_grains_size(
+				     internal_handle,
+				     file_io_pool,
+				     grain_index,
+				     &grain_descriptor,
+				     maximum_contiguous_size,
+				     &contiguous_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to determine contiguous grains size.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			if( contiguous_size > read_size )
+			{
+				read_size = contiguous_size;
+
+				read_count = libbfio_pool_read_buffer_at_offset(
+					      file_io_pool,
+					      grain_descriptor.file_index,
+					      &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+					      read_size,
+					      grain_descriptor.offset,
+					      error );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read contiguous grains data at offset: %" PRIi64 " (0x%08" PRIx64 ") in file IO pool entry: %d.",
+					 function,
+					 grain_descriptor.offset,
+					 grain_descriptor.offset,
+					 grain_descriptor.file_index );
+
+					return( -1 );
+				}
+			}
+			else if( ( grain_descriptor.flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+			{
+				if( internal_handle->parent_handle == NULL )
+				{
+					if( memory_set(
+					     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+					     0,
+					     read_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+						 "%s: unable to fill buffer with sparse grain.",
+						 function );
+
+						return( -1 );
+					}
+				}
+				else
+				{
+					/* The parent handle can be shared by multiple handles, hence the seek
+					 * and read are done as one operation under the lock of the parent handle
+					 */
+					read_count = libvmdk_handle_read_buffer_at_offset(
+						      internal_handle->parent_handle,
+						      &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+						      read_size,
+						      internal_handle->current_offset,
+						      error );
+
+					if( read_count != (ssize_t) read_size )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read grain data at offset: %" PRIi64 " (0x%08" PRIx64 ") from parent.",
+						 function,
+						 internal_handle->current_offset,
+						 internal_handle->current_offset );
+
+						return( -1 );
+					}
+				}
+			}
+			else
+			{
+				if( libvmdk_grain_table_get_grain_data(
+				     internal_handle->grain_table,
+				     grain_index,
+				     file_io_pool,
+				     internal_handle->grains_cache,
+				     &grain_descriptor,
+				     &grain_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve grain: %d data.",
+					 function,
+					 grain_index );
+
+					return( -1 );
+				}
+				if( grain_data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing grain: %d data.",
+					 function,
+					 grain_index );
+
+					return( -1 );
+				}
+				if( (size64_t) grain_data_offset > grain_data->data_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: grain data offset value out of bounds.",
+					 function );
+
+					return( -1 );
+				}
+				if( read_size > (size_t) ( grain_data->data_size - grain_data_offset ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: read size value out of bounds.",
+					 function );
+
+					return( -1 );
+				}
+				if( memory_copy(
+				     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				     &( ( grain_data->data )[ grain_data_offset ] ),
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy grain data to buffer.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			buffer_offset    += read_size;
+			grain_data_offset = 0;
+
+			if( contiguous_size > 0 )
+			{
+				grain_index += contiguous_size / internal_handle->io_handle->grain_size;
+			}
+			else
+			{
+				grain_index += 1;
+			}
+
+			internal_handle->current_offset += (off64_t) read_size;
+
+			if( (size64_t) internal_handle->current_offset >= internal_handle->io_handle->media_size )
+			{
+				break;
+			}
+			if( internal_handle->io_handle->abort != 0 )
+			{
+				break;
+			}
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Reads (media) data at the current offset into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvmdk_handle_read_buffer(
+         libvmdk_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_read_buffer";
+	ssize_t read_count                         = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
+		      internal_handle,
+		      internal_handle->extent_data_file_io_pool,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (media) data at a specific offset
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvmdk_handle_read_buffer_at_offset(
+         libvmdk_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_read_buffer_at_offset";
+	ssize_t read_count                         = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvmdk_internal_handle_seek_offset(
+	     internal_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
+		      internal_handle,
+		      internal_handle->extent_data_file_io_pool,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Compares two read ranges by their offset
+ * Returns -1 if the first range has the lower offset, 1 if the first range has the higher offset
+ * or 0 if both ranges have the same offset
+ */
+int libvmdk_read_range_compare(
+     const libvmdk_read_range_t *first_read_range,
+     const libvmdk_read_range_t *second_read_range )
+{
+	if( first_read_range->offset < second_read_range->offset )
+	{
+		return( -1 );
+	}
+	else if( first_read_range->offset > second_read_range->offset )
+	{
+		return( 1 );
+	}
+	/* Keep the order of ranges with the same offset stable
+	 */
+	if( first_read_range->range_index < second_read_range->range_index )
+	{
+		return( -1 );
+	}
+	else if( first_read_range->range_index > second_read_range->range_index )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Reads (media) data of multiple ranges
+ * The ranges are read in order of their offset under a single lock so that data of
+ * ranges that share a grain is retrieved once from the grains cache
+ * The reads do not change the current offset of the handle
+ * If read_counts is not NULL it is set to the number of bytes read per range
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_read_ranges(
+     libvmdk_handle_t *handle,
+     int number_of_ranges,
+     void **buffers,
+     size_t *buffer_sizes,
+     off64_t *offsets,
+     ssize_t *read_counts,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	libvmdk_read_range_t *read_ranges          = NULL;
+	static char *function                      = "libvmdk_handle_read_ranges";
+	ssize_t read_count                         = 0;
+	off64_t current_offset                     = 0;
+	int range_index                            = 0;
+	int sorted_range_index                     = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_ranges < 0 )
+	 || ( (size_t) number_of_ranges > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libvmdk_read_range_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of ranges value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges == 0 )
+	{
+		return( 1 );
+	}
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets.",
+		 function );
+
+		return( -1 );
+	}
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		if( buffers[ range_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid buffer: %d.",
+			 function,
+			 range_index );
+
+			return( -1 );
+		}
+		if( buffer_sizes[ range_index ] > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid buffer: %d size value exceeds maximum.",
+			 function,
+			 range_index );
+
+			return( -1 );
+		}
+		if( offsets[ range_index ] < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid offset: %d value out of bounds.",
+			 function,
+			 range_index );
+
+			return( -1 );
+		}
+	}
+	read_ranges = (libvmdk_read_range_t *) memory_allocate(
+	                                        sizeof( libvmdk_read_range_t ) * number_of_ranges );
+
+	if( read_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read ranges.",
+		 function );
+
+		return( -1 );
+	}
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		read_ranges[ range_index ].offset      = offsets[ range_index ];
+		read_ranges[ range_index ].range_index = range_index;
+	}
+	qsort(
+	 read_ranges,
+	 (size_t) number_of_ranges,
+	 sizeof( libvmdk_read_range_t ),
+	 (int (*)(const void *, const void *)) &libvmdk_read_range_compare );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		memory_free(
+		 read_ranges );
+
+		return( -1 );
+	}
+#endif
+	current_offset = internal_handle->current_offset;
+
+	for( sorted_range_index = 0;
+	     sorted_range_index < number_of_ranges;
+	     sorted_range_index++ )
+	{
+		range_index = read_ranges[ sorted_range_index ].range_index;
+
+		if( libvmdk_internal_handle_seek_offset(
+		     internal_handle,
+		     offsets[ range_index ],
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek range: %d offset.",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+		read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
+			      internal_handle,
+			      internal_handle->extent_data_file_io_pool,
+			      buffers[ range_index ],
+			      buffer_sizes[ range_index ],
+			      error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read range: %d.",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+		if( read_counts != NULL )
+		{
+			read_counts[ range_index ] = read_count;
+		}
+	}
+	internal_handle->current_offset = current_offset;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		memory_free(
+		 read_ranges );
+
+		return( -1 );
+	}
+#endif
+	memory_free(
+	 read_ranges );
+
+	return( 1 );
+
+on_error:
+	internal_handle->current_offset = current_offset;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	memory_free(
+	 read_ranges );
+
+	return( -1 );
+}
+
+/* Processes a read request
+ * Callback function for the read requests thread pool, the read is done at the offset
+ * of the request and does not change the current offset of the handle
+ * The read/write lock is held for writing during the entire read, which serializes the read
+ * requests, since the grain table and grain groups and grains caches are updated by the read
+ * The read request is freed after the callback function of the request was called
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_process_read_request(
+     libvmdk_read_request_t *read_request,
+     libvmdk_internal_handle_t *internal_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libvmdk_internal_handle_process_read_request";
+	ssize_t read_count       = -1;
+	off64_t current_offset   = 0;
+	int result               = 1;
+
+	if( read_request == NULL )
+	{
+		return( -1 );
+	}
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	else if( libcthreads_read_write_lock_grab_for_write(
+	          internal_handle->read_write_lock,
+	          &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	else
+	{
+		if( read_request->abort_generation != libvmdk_handle_abort_generation_get( &( internal_handle->abort_generation ) ) )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+			 "%s: abort requested.",
+			 function );
+
+			result = -1;
+		}
+		else if( internal_handle->extent_data_file_io_pool == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing extent data file IO pool.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			current_offset = internal_handle->current_offset;
+
+			if( libvmdk_internal_handle_seek_offset(
+			     internal_handle,
+			     read_request->offset,
+			     SEEK_SET,
+			     &error ) == -1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek offset.",
+				 function );
+
+				result = -1;
+			}
+			else
+			{
+				read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
+					      internal_handle,
+					      internal_handle->extent_data_file_io_pool,
+					      read_request->buffer,
+					      read_request->buffer_size,
+					      &error );
+
+				if( read_count == -1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read buffer.",
+					 function );
+
+					result = -1;
+				}
+			}
+			internal_handle->current_offset = current_offset;
+		}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_handle->read_write_lock,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			read_count = -1;
+			result     = -1;
+		}
+#endif
+	}
+	/* The callback function is called without holding the read/write lock
+	 * so that it can submit new read requests
+	 */
+	read_request->callback_function(
+	 (libvmdk_handle_t *) internal_handle,
+	 read_request->buffer,
+	 read_count,
+	 error,
+	 read_request->callback_data );
+
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	libvmdk_read_request_free(
+	 &read_request,
+	 NULL );
+
+	return( result );
+}
+
+/* Submits a read of (media) data at a specific offset
+ * The read is processed asynchronously and does not change the current offset of the handle,
+ * on completion the callback function is called with the number of bytes read or -1 and
+ * the error on error. The error is freed after the callback function returns
+ * The reads are processed by worker threads but not concurrently with each other or with
+ * other reads of the handle, since reading updates the caches of the handle. Submitting
+ * reads allows the caller to continue while data is read, it does not read in parallel
+ * Pending read requests are cancelled by libvmdk_handle_signal_abort and completed before
+ * libvmdk_handle_close returns. Without multi-thread support the read is processed
+ * before this function returns
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_submit_read(
+     libvmdk_handle_t *handle,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+            libvmdk_handle_t *handle,
+            void *buffer,
+            ssize_t read_count,
+            libcerror_error_t *error,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *read_requests_thread_pool = NULL;
+#endif
+	libvmdk_internal_handle_t *internal_handle           = NULL;
+	libvmdk_read_request_t *read_request                 = NULL;
+	static char *function                                = "libvmdk_handle_submit_read";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_read_request_initialize(
+	     &read_request,
+	     buffer,
+	     buffer_size,
+	     offset,
+	     callback_function,
+	     callback_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read request.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+	read_request->abort_generation = libvmdk_handle_abort_generation_get(
+	                                  &( internal_handle->abort_generation ) );
+
+	if( internal_handle->read_requests_thread_pool == NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( internal_handle->read_requests_thread_pool ),
+		     NULL,
+		     LIBVMDK_NUMBER_OF_READ_REQUEST_THREADS,
+		     LIBVMDK_MAXIMUM_NUMBER_OF_QUEUED_READ_REQUESTS,
+		     (int (*)(intptr_t *, void *)) &libvmdk_internal_handle_process_read_request,
+		     (void *) internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read requests thread pool.",
+			 function );
+
+			libcthreads_read_write_lock_release_for_write(
+			 internal_handle->read_write_lock,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	read_requests_thread_pool = internal_handle->read_requests_thread_pool;
+
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+	/* The read request is pushed without holding the read/write lock since the push
+	 * blocks when the queue is full until a worker thread, that needs the lock, takes
+	 * a read request from the queue
+	 */
+	if( libcthreads_thread_pool_push(
+	     read_requests_thread_pool,
+	     (intptr_t *) read_request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push read request onto thread pool queue.",
+		 function );
+
+		goto on_error;
+	}
+#else
+	read_request->abort_generation = libvmdk_handle_abort_generation_get(
+	                                  &( internal_handle->abort_generation ) );
+
+	/* The read request is freed by libvmdk_internal_handle_process_read_request
+	 */
+	libvmdk_internal_handle_process_read_request(
+	 read_request,
+	 internal_handle );
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
+	return( 1 );
+
+on_error:
+	if( read_request != NULL )
+	{
+		libvmdk_read_request_free(
+		 &read_request,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Waits for the submitted reads to complete
+ * This function should not be called concurrently with libvmdk_handle_submit_read
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_wait_for_reads(
+     libvmdk_handle_t *handle,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libvmdk_internal_handle_t *internal_handle = NULL;
+#endif
+	static char *function                      = "libvmdk_handle_wait_for_reads";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	/* Joining the thread pool processes the pending read requests, a new thread pool
+	 * is created by the next call to libvmdk_handle_submit_read
+	 */
+	if( libvmdk_internal_handle_join_read_requests_thread_pool(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join read requests thread pool.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+/* Joins the read requests thread pool
+ * The thread pool is detached from the handle while holding the read/write lock and joined
+ * without holding the lock, since processing the pending read requests requires the lock
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_join_read_requests_thread_pool(
+     libvmdk_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	libcthreads_thread_pool_t *read_requests_thread_pool = NULL;
+	static char *function                                = "libvmdk_internal_handle_join_read_requests_thread_pool";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	read_requests_thread_pool                  = internal_handle->read_requests_thread_pool;
+	internal_handle->read_requests_thread_pool = NULL;
+
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		internal_handle->read_requests_thread_pool = read_requests_thread_pool;
+
+		return( -1 );
+	}
+	if( read_requests_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &read_requests_thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join read requests thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
+/* Seeks a certain offset of the (media) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libvmdk_internal_handle_seek_offset(
+         libvmdk_internal_handle_t *internal_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libvmdk_internal_handle_seek_offset";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += internal_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) internal_handle->io_handle->media_size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the (media) data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libvmdk_handle_seek_offset(
+         libvmdk_handle_t *handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_seek_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libvmdk_internal_handle_seek_offset(
+	          internal_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		offset = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (media) data
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_offset(
+     libvmdk_handle_t *handle,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_handle->current_offset;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum number of (concurrent) open file handles
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_maximum_number_of_open_handles(
+     libvmdk_handle_t *handle,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_maximum_number_of_open_handles";
+	int result                                 = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->extent_data_file_io_pool != NULL )
+	{
+		if( libbfio_pool_set_maximum_number_of_open_handles(
+		     internal_handle->extent_data_file_io_pool,
+		     maximum_number_of_open_handles,
+		     error ) != -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in extent data file IO pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the parent handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_parent_handle(
+     libvmdk_handle_t *handle,
+     libvmdk_handle_t *parent_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_parent_handle";
+	uint32_t content_identifier                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvmdk_handle_get_content_identifier(
+	     parent_handle,
+	     &content_identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve content identifier from parent handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( content_identifier != internal_handle->descriptor_file->parent_content_identifier )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: mismatch in content identifier.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle->parent_handle = parent_handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Sets the shared cache
+ * The shared cache is not managed by the handle and must remain available until the handle is closed
+ * The image identifier must uniquely identify the image data, for example the full path
+ * of the descriptor file, handles with the same image identifier share cached grain data
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_shared_cache(
+     libvmdk_handle_t *handle,
+     libvmdk_shared_cache_t *shared_cache,
+     const uint8_t *image_identifier,
+     size_t image_identifier_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_shared_cache";
+	uint64_t shared_cache_identifier           = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( shared_cache != NULL )
+	{
+		if( libvmdk_shared_cache_get_identifier(
+		     shared_cache,
+		     image_identifier,
+		     image_identifier_size,
+		     &shared_cache_identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve shared cache identifier.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->grain_table != NULL )
+	{
+		if( libvmdk_grain_table_set_shared_cache(
+		     internal_handle->grain_table,
+		     shared_cache,
+		     shared_cache_identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set shared cache in grain table.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	internal_handle->shared_cache            = shared_cache;
+	internal_handle->shared_cache_identifier = shared_cache_identifier;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Sets the path to the extent data files
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_extent_data_files_path(
+     libvmdk_handle_t *handle,
+     const char *path,
+     size_t path_length,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_extent_data_files_path";
+	int result                                 = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_length > (size_t) ( SSIZE_MAX - 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid path length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvmdk_extent_table_set_data_files_path(
+	     internal_handle->extent_table,
+	     path,
+	     path_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set data files path in extent table.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the path to the extent data files
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_extent_data_files_path_wide(
+     libvmdk_handle_t *handle,
+     const wchar_t *path,
+     size_t path_length,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_extent_data_files_path_wide";
+	int result                                 = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_length > (size_t) ( SSIZE_MAX - 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid path length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvmdk_extent_table_set_data_files_path_wide(
+	     internal_handle->extent_table,
+	     path,
+	     path_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set data files path in extent table.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Retrieves the disk type
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_disk_type(
+     libvmdk_handle_t *handle,
+     int *disk_type,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_disk_type";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+	if( disk_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk type.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*disk_type = internal_handle->disk_type;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the media size
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_media_size(
+     libvmdk_handle_t *handle,
+     size64_t *media_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_media_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*media_size = internal_handle->descriptor_file->media_size;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the content identifier
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_content_identifier(
+     libvmdk_handle_t *handle,
+     uint32_t *content_identifier,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_content_identifier";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+	if( content_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid content identifier.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*content_identifier = internal_handle->descriptor_file->content_identifier;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the parent content identifier
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_handle_get_parent_content_identifier(
+     libvmdk_handle_t *handle,
+     uint32_t *parent_content_identifier,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_parent_content_identifier";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvmdk_descriptor_file_get_parent_content_identifier(
+	          internal_handle->descriptor_file,
+	          parent_content_identifier,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent content identifier.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the size of the UTF-8 encoded parent filename
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_handle_get_utf8_parent_filename_size(
+     libvmdk_handle_t *handle,
+     size_t *utf8_string_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_utf8_parent_filename_size";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvmdk_descriptor_file_get_utf8_parent_filename_size(
+	          internal_handle->descriptor_file,
+	          utf8_string_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 parent filename size.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the UTF-8 encoded parent filename
+ * The size should include the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_handle_get_utf8_parent_filename(
+     libvmdk_handle_t *handle,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_utf8_parent_filename";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvmdk_descriptor_file_get_utf8_parent_filename(
+	          internal_handle->descriptor_file,
+	          utf8_string,
+	          utf8_string_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 parent filename.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the size of the UTF-16 encoded parent filename
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_handle_get_utf16_parent_filename_size(
+     libvmdk_handle_t *handle,
+     size_t *utf16_string_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_utf16_parent_filename_size";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvmdk_descriptor_file_get_utf16_parent_filename_size(
+	          internal_handle->descriptor_file,
+	          utf16_string_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 parent filename size.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the UTF-16 encoded parent filename
+ * The size should include the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_handle_get_utf16_parent_filename(
+     libvmdk_handle_t *handle,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_utf16_parent_filename";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvmdk_descriptor_file_get_utf16_parent_filename(
+	          internal_handle->descriptor_file,
+	          utf16_string,
+	          utf16_string_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 parent filename.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the size of the UTF-8 encoded change tracking filename
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_handle_get_utf8_change_tracking_filename_size(
+     libvmdk_handle_t *handle,
+     size_t *utf8_string_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_utf8_change_tracking_filename_size";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvmdk_descriptor_file_get_utf8_change_tracking_filename_size(
+	          internal_handle->descriptor_file,
+	          utf8_string_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 change tracking filename size.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the UTF-8 encoded change tracking filename
+ * The size should include the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_handle_get_utf8_change_tracking_filename(
+     libvmdk_handle_t *handle,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_utf8_change_tracking_filename";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvmdk_descriptor_file_get_utf8_change_tracking_filename(
+	          internal_handle->descriptor_file,
+	          utf8_string,
+	          utf8_string_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 change tracking filename.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the size of the UTF-16 encoded change tracking filename
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_handle_get_utf16_change_tracking_filename_size(
+     libvmdk_handle_t *handle,
+     size_t *utf16_string_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_utf16_change_tracking_filename_size";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvmdk_descriptor_file_get_utf16_change_tracking_filename_size(
+	          internal_handle->descriptor_file,
+	          utf16_string_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 change tracking filename size.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the UTF-16 encoded change tracking filename
+ * The size should include the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_handle_get_utf16_change_tracking_filename(
+     libvmdk_handle_t *handle,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_utf16_change_tracking_filename";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvmdk_descriptor_file_get_utf16_change_tracking_filename(
+	          internal_handle->descriptor_file,
+	          utf16_string,
+	          utf16_string_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 change tracking filename.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the change sequence number of the change tracking file
+ * This function is experimental
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_handle_get_change_sequence_number(
+     libvmdk_handle_t *handle,
+     uint32_t *change_sequence_number,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_change_sequence_number";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( change_sequence_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change sequence number.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->change_tracking_file != NULL )
+	{
+		*change_sequence_number = internal_handle->change_tracking_file->change_sequence_number;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the change tracking identifier of the change tracking file
+ * The identifier is a little-endian GUID and is 16 bytes of size
+ * This function is experimental
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_handle_get_change_tracking_identifier(
+     libvmdk_handle_t *handle,
+     uint8_t *guid_data,
+     size_t guid_data_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_change_tracking_identifier";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( guid_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid GUID data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( guid_data_size < 16 )
+	 || ( guid_data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid GUID data size value out of bounds.",
+		 function );
+
+		return( -1 );
 	}
-	else if( memory_compare(
-	          signature,
-	          vmdk_sparse_file_signature,
-	          4 ) == 0 )
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		*file_type = LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA;
-		result     = 1;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
 	}
-	else if( signature[ 0 ] == '#' )
+#endif
+	if( internal_handle->change_tracking_file != NULL )
 	{
-		read_count = libbfio_handle_read_buffer(
-		              file_io_handle,
-		              &( signature[ 32 ] ),
-		              2048 - 32,
-		              error );
-
-		if( read_count == -1 )
+		if( memory_copy(
+		     guid_data,
+		     internal_handle->change_tracking_file->change_tracking_identifier,
+		     16 ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read signature.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy change tracking identifier.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libcsplit_narrow_string_split(
-		     (char *) signature,
-		     32 + read_count,
-		     '\n',
-		     &lines,
-		     error ) != 1 )
+		else
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to split file data into lines.",
-			 function );
-
-			goto on_error;
+			result = 1;
 		}
-		if( libcsplit_narrow_split_string_get_number_of_segments(
-		     lines,
-		     &number_of_lines,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to retrieve number of lines.",
-			 function );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-			goto on_error;
-		}
-		result = libvmdk_descriptor_file_read_signature(
-			  lines,
-			  number_of_lines,
-			  &line_index,
-		          error );
+		return( -1 );
+	}
+#endif
+	return( result );
+}
 
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read descriptor file.",
-			 function );
+/* Retrieves the first changed range at or after a specific offset
+ * A range is changed if it was written to after the change sequence number was the current one
+ * The granularity of the ranges is determined by the change tracking file
+ * To retrieve all changed ranges start at offset 0 and continue at range offset + range size
+ * This function is experimental
+ * Returns 1 if successful, 0 if no such range or -1 on error
+ */
+int libvmdk_handle_get_changed_range(
+     libvmdk_handle_t *handle,
+     uint32_t change_sequence_number,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_changed_range";
+	int result                                 = 0;
 
-			goto on_error;
-		}
-		else if( result != 0 )
-		{
-			*file_type = LIBVMDK_FILE_TYPE_DESCRIPTOR_FILE;
-		}
-		if( libcsplit_narrow_split_string_free(
-		     &lines,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free lines.",
-			 function );
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-			goto on_error;
-		}
+		return( -1 );
 	}
-	memory_free(
-	 signature );
+	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	return( result );
+	if( internal_handle->change_tracking_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing change tracking file.",
+		 function );
 
-on_error:
-	if( lines != NULL )
+		return( -1 );
+	}
+	/* The change tracking file IO handle is shared hence a write lock is required
+	 */
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		libcsplit_narrow_split_string_free(
-		 &lines,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
 	}
-	if( signature != NULL )
+#endif
+	result = libvmdk_change_tracking_file_get_changed_range(
+	          internal_handle->change_tracking_file,
+	          internal_handle->change_tracking_file_io_handle,
+	          change_sequence_number,
+	          offset,
+	          range_offset,
+	          range_size,
+	          error );
+
+	if( result == -1 )
 	{
-		memory_free(
-		 signature );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve changed range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
 	}
-	return( -1 );
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
 }
 
-/* Reads (media) data at the current offset into a buffer using a Basic File IO (bfio) pool
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read or -1 on error
+/* Retrieves the number of grain directory mismatches
+ * The mismatches are only determined when the handle was opened with LIBVMDK_ACCESS_FLAG_VERIFY_GRAIN_DIRECTORIES
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libvmdk_internal_handle_read_buffer_from_file_io_pool(
-         libvmdk_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libvmdk_handle_get_number_of_grain_directory_mismatches(
+     libvmdk_handle_t *handle,
+     uint32_t *number_of_mismatches,
+     libcerror_error_t **error )
 {
-	libvmdk_grain_data_t *grain_data = NULL;
-	static char *function            = "libvmdk_internal_handle_read_buffer_from_file_io_pool";
-	size_t buffer_offset             = 0;
-	size_t read_size                 = 0;
-	ssize_t read_count               = 0;
-	off64_t grain_data_offset        = 0;
-	uint64_t grain_index             = 0;
-	int grain_is_sparse              = 0;
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_number_of_grain_directory_mismatches";
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2945,6 +7311,8 @@ ssize_t libvmdk_internal_handle_read_buffer_from_file_io_pool(
 
 		return( -1 );
 	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
 	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -2956,319 +7324,453 @@ ssize_t libvmdk_internal_handle_read_buffer_from_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( number_of_mismatches == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of mismatches.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->descriptor_file == NULL )
+#endif
+	*number_of_mismatches = internal_handle->io_handle->number_of_grain_directory_mismatches;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the memory used by the handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_get_memory_usage(
+     libvmdk_internal_handle_t *internal_handle,
+     int memory_usage_type,
+     size64_t *memory_usage,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value   = NULL;
+	libvmdk_extent_values_t *extent_values = NULL;
+	libvmdk_grain_data_t *grain_data       = NULL;
+	static char *function                  = "libvmdk_internal_handle_get_memory_usage";
+	size64_t descriptor_memory_usage       = 0;
+	size64_t extent_files_memory_usage     = 0;
+	size64_t grain_groups_memory_usage     = 0;
+	size64_t grains_memory_usage           = 0;
+	int cache_entry_index                  = 0;
+	int extent_index                       = 0;
+	int number_of_cache_entries            = 0;
+	int number_of_extents                  = 0;
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing descriptor file.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->descriptor_file->parent_content_identifier_set != 0 )
-	 && ( internal_handle->descriptor_file->parent_content_identifier != 0xffffffffUL ) )
-	{
-		if( internal_handle->parent_handle == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid handle - missing parent handle.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( buffer == NULL )
+	if( ( memory_usage_type != LIBVMDK_MEMORY_USAGE_TYPE_TOTAL )
+	 && ( memory_usage_type != LIBVMDK_MEMORY_USAGE_TYPE_DESCRIPTOR )
+	 && ( memory_usage_type != LIBVMDK_MEMORY_USAGE_TYPE_EXTENT_FILES )
+	 && ( memory_usage_type != LIBVMDK_MEMORY_USAGE_TYPE_GRAIN_GROUPS_CACHE )
+	 && ( memory_usage_type != LIBVMDK_MEMORY_USAGE_TYPE_GRAINS_CACHE ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported memory usage type.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( memory_usage == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid element data size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory usage.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->io_handle->abort = 0;
-
-	if( buffer_size == 0 )
-	{
-		return( 0 );
-	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->io_handle->media_size )
+	if( internal_handle->descriptor_file != NULL )
 	{
-		return( 0 );
+		descriptor_memory_usage = sizeof( libvmdk_descriptor_file_t )
+		                        + internal_handle->descriptor_file->parent_filename_size;
 	}
-	if( internal_handle->extent_table->extent_files_stream != NULL )
+	if( internal_handle->extent_values_array != NULL )
 	{
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		if( libcdata_array_get_number_of_entries(
+		     internal_handle->extent_values_array,
+		     &number_of_extents,
+		     error ) != 1 )
 		{
-			libcnotify_printf(
-			 "%s: requested offset\t\t\t\t: %" PRIi64 " (0x%08" PRIx64 ")\n",
-			 function,
-			 internal_handle->current_offset,
-			 internal_handle->current_offset );
-		}
-#endif
-		read_size = buffer_size;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of extents.",
+			 function );
 
-		if( ( (size64_t) read_size > internal_handle->io_handle->media_size )
-		 || ( (size64_t) internal_handle->current_offset > ( internal_handle->io_handle->media_size - read_size ) ) )
-		{
-			read_size = (size_t) ( internal_handle->io_handle->media_size - internal_handle->current_offset );
+			return( -1 );
 		}
-		read_count = libfdata_stream_read_buffer_at_offset(
-		              internal_handle->extent_table->extent_files_stream,
-			      (intptr_t *) file_io_pool,
-			      (uint8_t *) buffer,
-			      read_size,
-			      internal_handle->current_offset,
-			      0,
-			      error );
+		for( extent_index = 0;
+		     extent_index < number_of_extents;
+		     extent_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_handle->extent_values_array,
+			     extent_index,
+			     (intptr_t **) &extent_values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve extent: %d values from array.",
+				 function,
+				 extent_index );
 
-		if( read_count != (ssize_t) read_size )
+				return( -1 );
+			}
+			if( extent_values != NULL )
+			{
+				descriptor_memory_usage += sizeof( libvmdk_extent_values_t )
+				                         + extent_values->filename_size
+				                         + ( sizeof( system_character_t ) * extent_values->alternate_filename_size );
+			}
+		}
+	}
+	if( internal_handle->extent_table != NULL )
+	{
+		if( libvmdk_extent_table_get_memory_usage(
+		     internal_handle->extent_table,
+		     &extent_files_memory_usage,
+		     &grain_groups_memory_usage,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer from extent files stream at offset: %" PRIi64 " (0x%" PRIx64 ").",
-			 function,
-			 internal_handle->current_offset,
-			 internal_handle->current_offset );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve memory usage of extent table.",
+			 function );
 
 			return( -1 );
 		}
-		internal_handle->current_offset += (off64_t) read_size;
-
-		buffer_offset = read_size;
 	}
-	else
+	if( internal_handle->grains_cache != NULL )
 	{
-		grain_index       = internal_handle->current_offset / internal_handle->io_handle->grain_size;
-		grain_data_offset = (off64_t) ( internal_handle->current_offset % internal_handle->io_handle->grain_size );
+		if( libfcache_cache_get_number_of_entries(
+		     internal_handle->grains_cache,
+		     &number_of_cache_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of grains cache entries.",
+			 function );
 
-		while( buffer_offset < buffer_size )
+			return( -1 );
+		}
+		for( cache_entry_index = 0;
+		     cache_entry_index < number_of_cache_entries;
+		     cache_entry_index++ )
 		{
-			grain_is_sparse = libvmdk_grain_table_grain_is_sparse_at_offset(
-					   internal_handle->grain_table,
-					   grain_index,
-					   file_io_pool,
-					   internal_handle->extent_table,
-					   internal_handle->current_offset,
-					   error );
-
-			if( grain_is_sparse == -1 )
+			if( libfcache_cache_get_value_by_index(
+			     internal_handle->grains_cache,
+			     cache_entry_index,
+			     &cache_value,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if the grain: %" PRIu64 " is sparse.",
+				 "%s: unable to retrieve grains cache entry: %d value.",
 				 function,
-				 grain_index );
+				 cache_entry_index );
 
 				return( -1 );
 			}
-			read_size = (size_t) ( internal_handle->io_handle->grain_size - grain_data_offset );
-
-			if( read_size > ( buffer_size - buffer_offset ) )
+			if( cache_value == NULL )
 			{
-				read_size = buffer_size - buffer_offset;
+				continue;
 			}
-			if( ( (size64_t) read_size > internal_handle->io_handle->media_size )
-			 || ( (size64_t) internal_handle->current_offset > ( internal_handle->io_handle->media_size - read_size ) ) )
+			grain_data = NULL;
+
+			if( libfcache_cache_value_get_value(
+			     cache_value,
+			     (intptr_t **) &grain_data,
+			     error ) != 1 )
 			{
-				read_size = (size_t) ( internal_handle->io_handle->media_size - internal_handle->current_offset );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve grain data from cache entry: %d value.",
+				 function,
+				 cache_entry_index );
+
+				return( -1 );
 			}
-			if( grain_is_sparse != 0 )
+			if( grain_data != NULL )
 			{
-				if( internal_handle->parent_handle == NULL )
-				{
-					if( memory_set(
-					     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-					     0,
-					     read_size ) == NULL )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_MEMORY,
-						 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-						 "%s: unable to fill buffer with sparse grain.",
-						 function );
+				grains_memory_usage += sizeof( libvmdk_grain_data_t ) + grain_data->data_size;
+			}
+		}
+	}
+	if( ( internal_handle->grain_table != NULL )
+	 && ( internal_handle->grain_table->shared_grain_data != NULL )
+	 && ( internal_handle->io_handle != NULL ) )
+	{
+		grains_memory_usage += sizeof( libvmdk_grain_data_t ) + internal_handle->io_handle->grain_size;
+	}
+	switch( memory_usage_type )
+	{
+		case LIBVMDK_MEMORY_USAGE_TYPE_DESCRIPTOR:
+			*memory_usage = descriptor_memory_usage;
+			break;
 
-						return( -1 );
-					}
-				}
-				else
-				{
-/* TODO do we need grain offset or current offset ? */
-					if( libvmdk_handle_seek_offset(
-					     internal_handle->parent_handle,
-					     internal_handle->current_offset,
-					     SEEK_SET,
-					     error ) == -1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_SEEK_FAILED,
-						 "%s: unable to seek grain offset: %" PRIi64 " (0x%08" PRIx64 ") in parent.",
-						 function,
-						 internal_handle->current_offset,
-						 internal_handle->current_offset );
+		case LIBVMDK_MEMORY_USAGE_TYPE_EXTENT_FILES:
+			*memory_usage = extent_files_memory_usage;
+			break;
 
-						return( -1 );
-					}
-					read_count = libvmdk_handle_read_buffer(
-						      internal_handle->parent_handle,
-						      &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-						      read_size,
-						      error );
+		case LIBVMDK_MEMORY_USAGE_TYPE_GRAIN_GROUPS_CACHE:
+			*memory_usage = grain_groups_memory_usage;
+			break;
 
-					if( read_count != (ssize_t) read_size )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: unable to read grain data from parent.",
-						 function );
+		case LIBVMDK_MEMORY_USAGE_TYPE_GRAINS_CACHE:
+			*memory_usage = grains_memory_usage;
+			break;
+
+		default:
+			*memory_usage = sizeof( libvmdk_internal_handle_t )
+			              + descriptor_memory_usage
+			              + extent_files_memory_usage
+			              + grain_groups_memory_usage
+			              + grains_memory_usage;
+			break;
+	}
+	return( 1 );
+}
+
+/* Retrieves the memory used by the handle
+ * The memory usage type selects the subsystem, LIBVMDK_MEMORY_USAGE_TYPE_TOTAL retrieves the sum of all subsystems
+ * The memory used by a shared cache is not included, use libvmdk_shared_cache_get_size instead
+ * The grain data is counted exactly, the extent files and grain groups are estimated per element
+ * The extent data file IO pool, the change tracking file and the buffers that are only allocated
+ * during a read or write are not included
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_memory_usage(
+     libvmdk_handle_t *handle,
+     int memory_usage_type,
+     size64_t *memory_usage,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_memory_usage";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvmdk_internal_handle_get_memory_usage(
+	          internal_handle,
+	          memory_usage_type,
+	          memory_usage,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve memory usage.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
 
-						return( -1 );
-					}
-				}
-			}
-			else
-			{
-				if( libvmdk_grain_table_get_grain_data_at_offset(
-				     internal_handle->grain_table,
-				     grain_index,
-				     file_io_pool,
-				     internal_handle->extent_table,
-				     internal_handle->grains_cache,
-				     internal_handle->current_offset,
-				     &grain_data,
-				     &grain_data_offset,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve grain: %d data.",
-					 function,
-					 grain_index );
+/* Retrieves the number of extents
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_number_of_extents(
+     libvmdk_handle_t *handle,
+     int *number_of_extents,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_number_of_extents";
+	int result                                 = 1;
 
-					return( -1 );
-				}
-				if( grain_data == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing grain: %d data.",
-					 function,
-					 grain_index );
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-					return( -1 );
-				}
-				if( (size64_t) grain_data_offset > grain_data->data_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-					 "%s: grain data offset value out of bounds.",
-					 function );
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-					return( -1 );
-				}
-				if( read_size > (size_t) ( grain_data->data_size - grain_data_offset ) )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-					 "%s: read size value out of bounds.",
-					 function );
+	if( internal_handle->descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing descriptor file.",
+		 function );
 
-					return( -1 );
-				}
-				if( memory_copy(
-				     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-				     &( ( grain_data->data )[ grain_data_offset ] ),
-				     read_size ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-					 "%s: unable to copy grain data to buffer.",
-					 function );
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
-					return( -1 );
-				}
-			}
-			buffer_offset    += read_size;
-			grain_index      += 1;
-			grain_data_offset = 0;
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     internal_handle->extent_values_array,
+	     number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
 
-			internal_handle->current_offset += (off64_t) read_size;
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-			if( (size64_t) internal_handle->current_offset >= internal_handle->io_handle->media_size )
-			{
-				break;
-			}
-			if( internal_handle->io_handle->abort != 0 )
-			{
-				break;
-			}
-		}
+		return( -1 );
 	}
-	return( (ssize_t) buffer_offset );
+#endif
+	return( result );
 }
 
-/* Reads (media) data at the current offset into a buffer
- * Returns the number of bytes read or -1 on error
+/* Retrieves a specific extent descriptor
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libvmdk_handle_read_buffer(
-         libvmdk_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libvmdk_handle_get_extent_descriptor(
+     libvmdk_handle_t *handle,
+     int extent_index,
+     libvmdk_extent_descriptor_t **extent_descriptor,
+     libcerror_error_t **error )
 {
+	libvmdk_extent_values_t *extent_values     = NULL;
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_read_buffer";
-	ssize_t read_count                         = 0;
+	static char *function                      = "libvmdk_handle_get_extent_descriptor";
+	int result                                 = 1;
 
 	if( handle == NULL )
 	{
@@ -3283,19 +7785,41 @@ ssize_t libvmdk_handle_read_buffer(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( internal_handle->extent_data_file_io_pool == NULL )
+	if( internal_handle->descriptor_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing extent data file IO pool.",
+		 "%s: invalid handle - missing descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extent_descriptor != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid extent descriptor value already set.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3303,32 +7827,44 @@ ssize_t libvmdk_handle_read_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
-		      internal_handle,
-		      internal_handle->extent_data_file_io_pool,
-		      buffer,
-		      buffer_size,
-		      error );
+	if( libcdata_array_get_entry_by_index(
+	     internal_handle->extent_values_array,
+	     extent_index,
+	     (intptr_t **) &extent_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent: %d from array.",
+		 function,
+		 extent_index );
 
-	if( read_count < 0 )
+		result = -1;
+	}
+	else if( libvmdk_extent_descriptor_initialize(
+	          extent_descriptor,
+	          extent_values,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create extent descriptor.",
 		 function );
 
-		read_count = -1;
+		result = -1;
 	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3336,30 +7872,48 @@ ssize_t libvmdk_handle_read_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( result );
 }
 
-/* Reads (media) data at a specific offset
- * Returns the number of bytes read or -1 on error
- */
-ssize_t libvmdk_handle_read_buffer_at_offset(
-         libvmdk_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+/* Retrieves the extent map run at a specific offset
+ * A run is a range of (media) data, that starts at the offset, which is stored in the same way in a single extent
+ * The physical offset is relative to the start of the extent data file and is only meaningful for runs that are not sparse
+ * The run is determined from the grain tables and extent table without reading grain data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the offset is beyond the media size or -1 on error
+ */
+int libvmdk_internal_handle_get_extent_map_run_at_offset(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     size64_t *run_size,
+     int *extent_index,
+     off64_t *physical_offset,
+     uint32_t *run_flags,
+     libcerror_error_t **error )
 {
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_read_buffer_at_offset";
-	ssize_t read_count                         = 0;
+	libvmdk_grain_descriptor_t grain_descriptor;
+	libvmdk_grain_descriptor_t next_grain_descriptor;
+
+	static char *function       = "libvmdk_internal_handle_get_extent_map_run_at_offset";
+	size64_t grain_size         = 0;
+	off64_t next_grain_offset   = 0;
+	off64_t run_end_offset      = 0;
+	off64_t segment_data_offset = 0;
+	off64_t segment_offset      = 0;
+	size64_t segment_size       = 0;
+	uint64_t grain_index        = 0;
+	uint32_t segment_flags      = 0;
+	int segment_file_index      = 0;
+	int segment_index           = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -3370,175 +7924,304 @@ ssize_t libvmdk_handle_read_buffer_at_offset(
 
 		return( -1 );
 	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
-
-	if( internal_handle->extent_data_file_io_pool == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing extent data file IO pool.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->extent_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent table.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libvmdk_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
-		      internal_handle,
-		      internal_handle->extent_data_file_io_pool,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
+	if( run_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( extent_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent index.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( read_count );
-
-on_error:
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
-
-/* Seeks a certain offset of the (media) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
- */
-off64_t libvmdk_internal_handle_seek_offset(
-         libvmdk_internal_handle_t *internal_handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
-{
-	static char *function = "libvmdk_internal_handle_seek_offset";
-
-	if( internal_handle == NULL )
+	if( physical_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid physical offset.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( run_flags == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run flags.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+	if( (size64_t) offset >= internal_handle->io_handle->media_size )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
-		 function );
+		return( 0 );
+	}
+	if( internal_handle->extent_table->extent_files_stream != NULL )
+	{
+		if( libfdata_stream_get_segment_index_at_offset(
+		     internal_handle->extent_table->extent_files_stream,
+		     offset,
+		     &segment_index,
+		     &segment_data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment index at offset: %" PRIi64 " (0x%08" PRIx64 ") from extent files stream.",
+			 function,
+			 offset,
+			 offset );
 
-		return( -1 );
+			return( -1 );
+		}
+		if( libfdata_stream_get_segment_by_index(
+		     internal_handle->extent_table->extent_files_stream,
+		     segment_index,
+		     &segment_file_index,
+		     &segment_offset,
+		     &segment_size,
+		     &segment_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %d from extent files stream.",
+			 function,
+			 segment_index );
+
+			return( -1 );
+		}
+		if( ( segment_data_offset < 0 )
+		 || ( (size64_t) segment_data_offset >= segment_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment data offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		*extent_index    = segment_index;
+		*physical_offset = segment_offset + segment_data_offset;
+		*run_flags       = 0;
+		run_end_offset   = offset + (off64_t) ( segment_size - segment_data_offset );
 	}
-	if( whence == SEEK_CUR )
+	else
 	{
-		offset += internal_handle->current_offset;
+		grain_size  = internal_handle->io_handle->grain_size;
+		grain_index = (uint64_t) offset / grain_size;
+
+		if( libvmdk_grain_table_get_grain_at_offset(
+		     internal_handle->grain_table,
+		     grain_index,
+		     file_io_pool,
+		     internal_handle->extent_table,
+		     offset,
+		     &grain_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain: %" PRIu64 ".",
+			 function,
+			 grain_index );
+
+			return( -1 );
+		}
+		*extent_index = grain_descriptor.extent_number;
+
+		if( ( grain_descriptor.flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			*physical_offset = 0;
+			*run_flags       = LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_SPARSE;
+
+			if( internal_handle->parent_handle == NULL )
+			{
+				*run_flags |= LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_ZERO;
+			}
+			else
+			{
+				*run_flags |= LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_IN_PARENT;
+			}
+			/* Only a sparse grain group spans the entire grain group, a sparse grain
+			 * in an allocated grain group spans a single grain
+			 */
+			if( grain_descriptor.grains_list == NULL )
+			{
+				run_end_offset = grain_descriptor.grain_group_offset + (off64_t) grain_descriptor.grain_group_size;
+			}
+			else
+			{
+				run_end_offset = (off64_t) ( ( grain_index + 1 ) * grain_size );
+			}
+		}
+		else if( ( grain_descriptor.flags & LIBVMDK_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+		{
+			/* A compressed grain is always a run by itself and the physical offset
+			 * refers to the start of its compressed data
+			 */
+			*physical_offset = grain_descriptor.offset;
+			*run_flags       = LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_COMPRESSED;
+			run_end_offset   = (off64_t) ( ( grain_index + 1 ) * grain_size );
+		}
+		else
+		{
+			*physical_offset  = grain_descriptor.offset + grain_descriptor.data_offset;
+			*run_flags        = 0;
+			run_end_offset    = (off64_t) ( ( grain_index + 1 ) * grain_size );
+			next_grain_offset = grain_descriptor.offset + (off64_t) grain_size;
+		}
+		while( ( *run_flags & LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_COMPRESSED ) == 0 )
+		{
+			if( (size64_t) run_end_offset >= internal_handle->io_handle->media_size )
+			{
+				break;
+			}
+			grain_index = (uint64_t) run_end_offset / grain_size;
+
+			if( libvmdk_grain_table_get_grain_at_offset(
+			     internal_handle->grain_table,
+			     grain_index,
+			     file_io_pool,
+			     internal_handle->extent_table,
+			     run_end_offset,
+			     &next_grain_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve grain: %" PRIu64 ".",
+				 function,
+				 grain_index );
+
+				return( -1 );
+			}
+			if( ( next_grain_descriptor.extent_number != grain_descriptor.extent_number )
+			 || ( next_grain_descriptor.flags != grain_descriptor.flags ) )
+			{
+				break;
+			}
+			if( ( grain_descriptor.flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+			{
+				if( next_grain_descriptor.grains_list == NULL )
+				{
+					run_end_offset = next_grain_descriptor.grain_group_offset + (off64_t) next_grain_descriptor.grain_group_size;
+				}
+				else
+				{
+					run_end_offset += (off64_t) grain_size;
+				}
+			}
+			else
+			{
+				if( ( next_grain_descriptor.file_index != grain_descriptor.file_index )
+				 || ( next_grain_descriptor.offset != next_grain_offset ) )
+				{
+					break;
+				}
+				run_end_offset    += (off64_t) grain_size;
+				next_grain_offset += (off64_t) grain_size;
+			}
+		}
 	}
-	else if( whence == SEEK_END )
+	if( (size64_t) run_end_offset > internal_handle->io_handle->media_size )
 	{
-		offset += (off64_t) internal_handle->io_handle->media_size;
+		run_end_offset = (off64_t) internal_handle->io_handle->media_size;
 	}
-	if( offset < 0 )
+	if( run_end_offset <= offset )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid run end offset value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->current_offset = offset;
+	*run_size = (size64_t) ( run_end_offset - offset );
 
-	return( offset );
+	return( 1 );
 }
 
-/* Seeks a certain offset of the (media) data
- * Returns the offset if seek is successful or -1 on error
+/* Retrieves the extent map run at a specific offset
+ * A run is a range of (media) data, that starts at the offset, which is stored in the same way in a single extent
+ * The physical offset is relative to the start of the extent data file and is only meaningful for runs that are not sparse
+ * The run flags contain LIBVMDK_EXTENT_MAP_RUN_FLAGS
+ * To retrieve the entire extent map start at offset 0 and continue at offset + run size
+ * Returns 1 if successful, 0 if the offset is beyond the media size or -1 on error
  */
-off64_t libvmdk_handle_seek_offset(
-         libvmdk_handle_t *handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libvmdk_handle_get_extent_map_run_at_offset(
+     libvmdk_handle_t *handle,
+     off64_t offset,
+     size64_t *run_size,
+     int *extent_index,
+     off64_t *physical_offset,
+     uint32_t *run_flags,
+     libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_seek_offset";
+	static char *function                      = "libvmdk_handle_get_extent_map_run_at_offset";
+	int result                                 = 0;
 
 	if( handle == NULL )
 	{
@@ -3579,22 +8262,26 @@ off64_t libvmdk_handle_seek_offset(
 		return( -1 );
 	}
 #endif
-	offset = libvmdk_internal_handle_seek_offset(
+	result = libvmdk_internal_handle_get_extent_map_run_at_offset(
 	          internal_handle,
+	          internal_handle->extent_data_file_io_pool,
 	          offset,
-	          whence,
+	          run_size,
+	          extent_index,
+	          physical_offset,
+	          run_flags,
 	          error );
 
-	if( offset == -1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
-
-		offset = -1;
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent map run at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
 	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -3611,21 +8298,27 @@ off64_t libvmdk_handle_seek_offset(
 		return( -1 );
 	}
 #endif
-	return( offset );
+	return( result );
 }
 
-/* Retrieves the current offset of the (media) data
- * Returns 1 if successful or -1 on error
+#if defined( LIBVMDK_HAVE_COPY_FILE_RANGE )
+
+/* Opens the extent data file of a specific extent as a file descriptor
+ * This is only possible if the extent data files were opened by the library
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libvmdk_handle_get_offset(
-     libvmdk_handle_t *handle,
-     off64_t *offset,
+int libvmdk_internal_handle_open_extent_data_file_descriptor(
+     libvmdk_internal_handle_t *internal_handle,
+     int extent_index,
+     int *file_descriptor,
      libcerror_error_t **error )
 {
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_offset";
+	libbfio_handle_t *file_io_handle = NULL;
+	char *filename                   = NULL;
+	static char *function            = "libvmdk_internal_handle_open_extent_data_file_descriptor";
+	size_t filename_size             = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -3636,168 +8329,386 @@ int libvmdk_handle_get_offset(
 
 		return( -1 );
 	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
-
-	if( internal_handle->io_handle == NULL )
+	if( file_descriptor == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->extent_data_file_io_pool == NULL )
+	/* The file IO handles in a pool provided by the caller are not necessarily files
+	 */
+	if( internal_handle->extent_data_file_io_pool_created_in_library == 0 )
+	{
+		return( 0 );
+	}
+	if( libbfio_pool_get_handle(
+	     internal_handle->extent_data_file_io_pool,
+	     extent_index,
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing extent data file IO pool.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d from pool.",
+		 function,
+		 extent_index );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( offset == NULL )
+	if( libbfio_file_get_name_size(
+	     file_io_handle,
+	     &filename_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent data file: %d name size.",
+		 function,
+		 extent_index );
 
-		return( -1 );
+		goto on_error;
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( ( filename_size <= 1 )
+	 || ( filename_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent data file: %d name size value out of bounds.",
+		 function,
+		 extent_index );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	*offset = internal_handle->current_offset;
+	filename = narrow_string_allocate(
+	            filename_size );
 
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_get_name(
+	     file_io_handle,
+	     filename,
+	     filename_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent data file: %d name.",
+		 function,
+		 extent_index );
 
-		return( -1 );
+		goto on_error;
+	}
+	/* If the extent data file cannot be opened its data is copied via the file IO pool
+	 */
+	*file_descriptor = open(
+	                    filename,
+	                    O_RDONLY );
+
+	memory_free(
+	 filename );
+
+	if( *file_descriptor == -1 )
+	{
+		return( 0 );
 	}
-#endif
 	return( 1 );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	return( -1 );
 }
 
-/* Sets the maximum number of (concurrent) open file handles
- * Returns 1 if successful or -1 on error
+/* Copies data between file descriptors with copy_file_range
+ * Returns 1 if successful, 0 if copy_file_range is not supported for the file descriptors or -1 on error
  */
-int libvmdk_handle_set_maximum_number_of_open_handles(
-     libvmdk_handle_t *handle,
-     int maximum_number_of_open_handles,
+int libvmdk_internal_handle_copy_file_range(
+     int source_file_descriptor,
+     off64_t source_offset,
+     int destination_file_descriptor,
+     off64_t destination_offset,
+     size64_t size,
      libcerror_error_t **error )
 {
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_set_maximum_number_of_open_handles";
-	int result                                 = 1;
+	static char *function          = "libvmdk_internal_handle_copy_file_range";
+	loff_t copy_destination_offset = 0;
+	loff_t copy_source_offset      = 0;
+	size_t copy_size               = 0;
+	ssize_t copy_count             = 0;
 
-	if( handle == NULL )
+	if( source_file_descriptor == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid source file descriptor.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
-
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( destination_file_descriptor == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination file descriptor.",
 		 function );
 
 		return( -1 );
 	}
+	copy_source_offset      = (loff_t) source_offset;
+	copy_destination_offset = (loff_t) destination_offset;
+
+	while( size > 0 )
+	{
+		copy_size = (size_t) LIBVMDK_COPY_BUFFER_SIZE;
+
+		if( (size64_t) copy_size > size )
+		{
+			copy_size = (size_t) size;
+		}
+		copy_count = copy_file_range(
+		              source_file_descriptor,
+		              &copy_source_offset,
+		              destination_file_descriptor,
+		              &copy_destination_offset,
+		              copy_size,
+		              0 );
+
+		if( copy_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			/* Fall back to a buffered copy if the kernel or file systems do not support
+			 * copy_file_range and nothing has been copied yet
+			 */
+			if( ( copy_source_offset == (loff_t) source_offset )
+			 && ( ( errno == ENOSYS )
+			  || ( errno == EXDEV )
+			  || ( errno == EINVAL )
+			  || ( errno == EOPNOTSUPP ) ) )
+			{
+				return( 0 );
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to copy data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 (int64_t) copy_source_offset,
+			 (int64_t) copy_source_offset );
+
+			return( -1 );
+		}
+		if( copy_count == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unexpected end of extent data file at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 (int64_t) copy_source_offset,
+			 (int64_t) copy_source_offset );
+
+			return( -1 );
+		}
+		size -= (size64_t) copy_count;
+	}
+	return( 1 );
+}
+
+#endif /* defined( LIBVMDK_HAVE_COPY_FILE_RANGE ) */
+
+/* Writes a buffer to the destination of a copy, which is either a file IO handle or a file descriptor
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libvmdk_internal_handle_write_buffer_to_destination(
+         libbfio_handle_t *file_io_handle,
+         int file_descriptor,
+         const uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libvmdk_internal_handle_write_buffer_to_destination";
+	ssize_t write_count   = 0;
+
+#if defined( LIBVMDK_HAVE_COPY_TO_FILE_DESCRIPTOR )
+	size_t buffer_offset  = 0;
 #endif
-	if( internal_handle->extent_data_file_io_pool != NULL )
+
+	if( file_io_handle != NULL )
 	{
-		if( libbfio_pool_set_maximum_number_of_open_handles(
-		     internal_handle->extent_data_file_io_pool,
-		     maximum_number_of_open_handles,
-		     error ) != -1 )
+		write_count = libbfio_handle_write_buffer_at_offset(
+		               file_io_handle,
+		               buffer,
+		               size,
+		               offset,
+		               error );
+
+		if( write_count == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set maximum number of open handles in extent data file IO pool.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") to file IO handle.",
+			 function,
+			 offset,
+			 offset );
 
-			result = -1;
+			return( -1 );
 		}
+		return( write_count );
 	}
-	if( result == 1 )
+#if defined( LIBVMDK_HAVE_COPY_TO_FILE_DESCRIPTOR )
+	if( buffer == NULL )
 	{
-		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
+	while( buffer_offset < size )
+	{
+		write_count = pwrite(
+		               file_descriptor,
+		               &( buffer[ buffer_offset ] ),
+		               size - buffer_offset,
+		               (off_t) ( offset + (off64_t) buffer_offset ) );
+
+		if( write_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to write buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") to file descriptor.",
+			 function,
+			 offset + (off64_t) buffer_offset,
+			 offset + (off64_t) buffer_offset );
+
+			return( -1 );
+		}
+		if( write_count == 0 )
+		{
+			break;
+		}
+		buffer_offset += (size_t) write_count;
+	}
+	return( (ssize_t) buffer_offset );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: writing to a file descriptor is not supported.",
+	 function );
+
+	return( -1 );
 #endif
-	return( result );
 }
 
-/* Sets the parent handle
+/* Copies (media) data to a destination, which is either a file IO handle or a file descriptor
+ * The data is read in large buffers, contiguously stored uncompressed grains are read with a single read
+ * If the destination is a file descriptor uncompressed runs are copied with copy_file_range if available
+ * If LIBVMDK_COPY_FLAG_SPARSE is set, ranges that consist of zeros according to the grain tables are not written
+ * but skipped, leaving a hole in the destination, the destination must therefore read as zeros in the destination range
+ * Ranges stored in the parent are copied from the parent in the same way
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_handle_set_parent_handle(
-     libvmdk_handle_t *handle,
-     libvmdk_handle_t *parent_handle,
+int libvmdk_internal_handle_copy_to_destination(
+     libvmdk_internal_handle_t *internal_handle,
+     off64_t offset,
+     size64_t size,
+     libbfio_handle_t *file_io_handle,
+     int file_descriptor,
+     off64_t destination_offset,
+     uint8_t copy_flags,
      libcerror_error_t **error )
 {
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_set_parent_handle";
-	uint32_t content_identifier                = 0;
+#if defined( LIBVMDK_HAVE_COPY_TO_FILE_DESCRIPTOR )
+	struct stat file_statistics;
+#endif
 
-	if( handle == NULL )
+	uint8_t *buffer             = NULL;
+	static char *function       = "libvmdk_internal_handle_copy_to_destination";
+	size_t buffer_size          = 0;
+	size_t read_size            = 0;
+	size64_t destination_size   = 0;
+	size64_t remaining_size     = 0;
+	size64_t run_data_offset    = 0;
+	size64_t run_size           = 0;
+	ssize_t read_count          = 0;
+	ssize_t write_count         = 0;
+	off64_t copy_offset         = 0;
+	off64_t current_offset      = 0;
+	off64_t physical_offset     = 0;
+	off64_t write_offset        = 0;
+	uint32_t run_flags          = 0;
+	uint8_t last_run_is_hole    = 0;
+	int extent_index            = 0;
+	int result                  = 0;
+
+#if defined( LIBVMDK_HAVE_COPY_FILE_RANGE )
+	int source_extent_index     = -1;
+	int source_file_descriptor  = -1;
+	uint8_t use_copy_file_range = 0;
+#endif
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -3808,167 +8719,119 @@ int libvmdk_handle_set_parent_handle(
 
 		return( -1 );
 	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
-
-	if( internal_handle->descriptor_file == NULL )
+	if( internal_handle->extent_data_file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing descriptor file.",
-		 function );
-
-		return( -1 );
-	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: invalid handle - missing extent data file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libvmdk_handle_get_content_identifier(
-	     parent_handle,
-	     &content_identifier,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve content identifier from parent handle.",
-		 function );
-
-		goto on_error;
-	}
-	if( content_identifier != internal_handle->descriptor_file->parent_content_identifier )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: mismatch in content identifier.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	internal_handle->parent_handle = parent_handle;
-
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( ( offset < 0 )
+	 || ( (size64_t) offset > internal_handle->io_handle->media_size ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( 1 );
-
-on_error:
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
-
-/* Sets the path to the extent data files
- * Returns 1 if successful or -1 on error
- */
-int libvmdk_handle_set_extent_data_files_path(
-     libvmdk_handle_t *handle,
-     const char *path,
-     size_t path_length,
-     libcerror_error_t **error )
-{
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_set_extent_data_files_path";
-	int result                                 = 1;
-
-	if( handle == NULL )
+	if( size > ( internal_handle->io_handle->media_size - (size64_t) offset ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
-
-	if( path == NULL )
+	if( ( file_io_handle == NULL )
+	 && ( file_descriptor == -1 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid path.",
+		 "%s: invalid destination.",
 		 function );
 
 		return( -1 );
 	}
-	if( path_length > (size_t) ( SSIZE_MAX - 1 ) )
+	if( ( destination_offset < 0 )
+	 || ( size > (size64_t) ( INT64_MAX - destination_offset ) ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid path length value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid destination offset value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( ( copy_flags & ~( LIBVMDK_COPY_FLAG_SPARSE ) ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported copy flags: 0x%02" PRIx8 ".",
+		 function,
+		 copy_flags );
 
 		return( -1 );
 	}
-#endif
-	if( libvmdk_extent_table_set_data_files_path(
-	     internal_handle->extent_table,
-	     path,
-	     path_length,
-	     error ) != 1 )
+	if( size == 0 )
+	{
+		return( 1 );
+	}
+	buffer_size = LIBVMDK_COPY_BUFFER_SIZE;
+
+	if( size < (size64_t) buffer_size )
+	{
+		buffer_size = (size_t) size;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * buffer_size );
+
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set data files path in extent table.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
 		 function );
 
-		result = -1;
+		return( -1 );
+	}
+#if defined( LIBVMDK_HAVE_COPY_FILE_RANGE )
+	if( file_io_handle == NULL )
+	{
+		use_copy_file_range = 1;
 	}
+#endif
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3976,67 +8839,301 @@ int libvmdk_handle_set_extent_data_files_path(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
+		memory_free(
+		 buffer );
+
 		return( -1 );
 	}
 #endif
-	return( result );
-}
+	current_offset = internal_handle->current_offset;
+	copy_offset    = offset;
+	remaining_size = size;
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
+	while( remaining_size > 0 )
+	{
+		if( libvmdk_internal_handle_get_extent_map_run_at_offset(
+		     internal_handle,
+		     internal_handle->extent_data_file_io_pool,
+		     copy_offset,
+		     &run_size,
+		     &extent_index,
+		     &physical_offset,
+		     &run_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent map run at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 copy_offset,
+			 copy_offset );
 
-/* Sets the path to the extent data files
- * Returns 1 if successful or -1 on error
- */
-int libvmdk_handle_set_extent_data_files_path_wide(
-     libvmdk_handle_t *handle,
-     const wchar_t *path,
-     size_t path_length,
-     libcerror_error_t **error )
-{
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_set_extent_data_files_path_wide";
-	int result                                 = 1;
+			goto on_error;
+		}
+		if( run_size > remaining_size )
+		{
+			run_size = remaining_size;
+		}
+		last_run_is_hole = 0;
+		result           = 0;
 
-	if( handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
+		if( ( ( copy_flags & LIBVMDK_COPY_FLAG_SPARSE ) != 0 )
+		 && ( ( run_flags & LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_ZERO ) != 0 ) )
+		{
+			last_run_is_hole = 1;
+		}
+		else if( ( ( copy_flags & LIBVMDK_COPY_FLAG_SPARSE ) != 0 )
+		      && ( ( run_flags & LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_IN_PARENT ) != 0 ) )
+		{
+			/* Let the parent determine its own holes
+			 */
+			if( file_io_handle != NULL )
+			{
+				result = libvmdk_handle_copy_to_file_io_handle(
+				          internal_handle->parent_handle,
+				          copy_offset,
+				          run_size,
+				          file_io_handle,
+				          destination_offset + ( copy_offset - offset ),
+				          copy_flags,
+				          error );
+			}
+			else
+			{
+				result = libvmdk_handle_copy_to_file_descriptor(
+				          internal_handle->parent_handle,
+				          copy_offset,
+				          run_size,
+				          file_descriptor,
+				          destination_offset + ( copy_offset - offset ),
+				          copy_flags,
+				          error );
+			}
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to copy data at offset: %" PRIi64 " (0x%08" PRIx64 ") from parent.",
+				 function,
+				 copy_offset,
+				 copy_offset );
 
-		return( -1 );
-	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
+				goto on_error;
+			}
+		}
+		else
+		{
+#if defined( LIBVMDK_HAVE_COPY_FILE_RANGE )
+			/* Uncompressed runs are copied from the extent data file by the kernel
+			 */
+			if( ( use_copy_file_range != 0 )
+			 && ( run_flags == 0 ) )
+			{
+				if( extent_index != source_extent_index )
+				{
+					if( source_file_descriptor != -1 )
+					{
+						close(
+						 source_file_descriptor );
 
-	if( path == NULL )
+						source_file_descriptor = -1;
+					}
+					source_extent_index = extent_index;
+
+					if( libvmdk_internal_handle_open_extent_data_file_descriptor(
+					     internal_handle,
+					     extent_index,
+					     &source_file_descriptor,
+					     error ) == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_OPEN_FAILED,
+						 "%s: unable to open extent data file: %d.",
+						 function,
+						 extent_index );
+
+						goto on_error;
+					}
+				}
+				if( source_file_descriptor != -1 )
+				{
+					result = libvmdk_internal_handle_copy_file_range(
+					          source_file_descriptor,
+					          physical_offset,
+					          file_descriptor,
+					          destination_offset + ( copy_offset - offset ),
+					          run_size,
+					          error );
+
+					if( result == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_WRITE_FAILED,
+						 "%s: unable to copy data at offset: %" PRIi64 " (0x%08" PRIx64 ") from extent data file: %d.",
+						 function,
+						 copy_offset,
+						 copy_offset,
+						 extent_index );
+
+						goto on_error;
+					}
+					else if( result == 0 )
+					{
+						use_copy_file_range = 0;
+					}
+				}
+			}
+#endif /* defined( LIBVMDK_HAVE_COPY_FILE_RANGE ) */
+
+			if( result == 0 )
+			{
+				internal_handle->current_offset = copy_offset;
+
+				for( run_data_offset = 0;
+				     run_data_offset < run_size;
+				     run_data_offset += (size64_t) read_size )
+				{
+					read_size = buffer_size;
+
+					if( (size64_t) read_size > ( run_size - run_data_offset ) )
+					{
+						read_size = (size_t) ( run_size - run_data_offset );
+					}
+					read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
+						      internal_handle,
+						      internal_handle->extent_data_file_io_pool,
+						      buffer,
+						      read_size,
+						      error );
+
+					if( read_count != (ssize_t) read_size )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+						 function,
+						 copy_offset + (off64_t) run_data_offset,
+						 copy_offset + (off64_t) run_data_offset );
+
+						goto on_error;
+					}
+					write_offset = destination_offset + ( copy_offset - offset ) + (off64_t) run_data_offset;
+
+					write_count = libvmdk_internal_handle_write_buffer_to_destination(
+						       file_io_handle,
+						       file_descriptor,
+						       buffer,
+						       read_size,
+						       write_offset,
+						       error );
+
+					if( write_count != (ssize_t) read_size )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_WRITE_FAILED,
+						 "%s: unable to write buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+						 function,
+						 write_offset,
+						 write_offset );
+
+						goto on_error;
+					}
+				}
+			}
+		}
+		copy_offset    += (off64_t) run_size;
+		remaining_size -= run_size;
+	}
+	/* Write the last byte when the copy ends in a hole and the destination does not yet
+	 * have the full size
+	 */
+	if( last_run_is_hole != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid path.",
-		 function );
+		if( file_io_handle != NULL )
+		{
+			if( libbfio_handle_get_size(
+			     file_io_handle,
+			     &destination_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve size of file IO handle.",
+				 function );
 
-		return( -1 );
+				goto on_error;
+			}
+		}
+#if defined( LIBVMDK_HAVE_COPY_TO_FILE_DESCRIPTOR )
+		else
+		{
+			if( fstat(
+			     file_descriptor,
+			     &file_statistics ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 errno,
+				 "%s: unable to retrieve size of file descriptor.",
+				 function );
+
+				goto on_error;
+			}
+			destination_size = (size64_t) file_statistics.st_size;
+		}
+#endif
+		if( destination_size >= (size64_t) ( destination_offset + (off64_t) size ) )
+		{
+			last_run_is_hole = 0;
+		}
 	}
-	if( path_length > (size_t) ( SSIZE_MAX - 1 ) )
+	if( last_run_is_hole != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid path length value exceeds maximum.",
-		 function );
+		buffer[ 0 ] = 0;
+
+		write_count = libvmdk_internal_handle_write_buffer_to_destination(
+			       file_io_handle,
+			       file_descriptor,
+			       buffer,
+			       1,
+			       destination_offset + (off64_t) size - 1,
+			       error );
+
+		if( write_count != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write last byte.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
 	}
+	internal_handle->current_offset = current_offset;
+
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4044,57 +9141,70 @@ int libvmdk_handle_set_extent_data_files_path_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
+#if defined( LIBVMDK_HAVE_COPY_FILE_RANGE )
+		if( source_file_descriptor != -1 )
+		{
+			close(
+			 source_file_descriptor );
+		}
+#endif
+		memory_free(
+		 buffer );
+
 		return( -1 );
 	}
 #endif
-	if( libvmdk_extent_table_set_data_files_path_wide(
-	     internal_handle->extent_table,
-	     path,
-	     path_length,
-	     error ) != 1 )
+#if defined( LIBVMDK_HAVE_COPY_FILE_RANGE )
+	if( source_file_descriptor != -1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set data files path in extent table.",
-		 function );
-
-		result = -1;
+		close(
+		 source_file_descriptor );
 	}
+#endif
+	memory_free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	internal_handle->current_offset = current_offset;
+
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+#if defined( LIBVMDK_HAVE_COPY_FILE_RANGE )
+	if( source_file_descriptor != -1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
-
-		return( -1 );
+		close(
+		 source_file_descriptor );
 	}
 #endif
-	return( result );
-}
+	memory_free(
+	 buffer );
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+	return( -1 );
+}
 
-/* Retrieves the disk type
+/* Copies (media) data to a Basic File IO (bfio) handle
+ * If LIBVMDK_COPY_FLAG_SPARSE is set, ranges that consist of zeros according to the grain tables are not written
+ * but skipped, leaving a hole in the destination, the destination must therefore read as zeros in the destination range
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_handle_get_disk_type(
+int libvmdk_handle_copy_to_file_io_handle(
      libvmdk_handle_t *handle,
-     int *disk_type,
+     off64_t offset,
+     size64_t size,
+     libbfio_handle_t *file_io_handle,
+     off64_t destination_offset,
+     uint8_t copy_flags,
      libcerror_error_t **error )
 {
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_disk_type";
+	static char *function = "libvmdk_handle_copy_to_file_io_handle";
 
 	if( handle == NULL )
 	{
@@ -4107,75 +9217,55 @@ int libvmdk_handle_get_disk_type(
 
 		return( -1 );
 	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
-
-	if( internal_handle->descriptor_file == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing descriptor file.",
-		 function );
-
-		return( -1 );
-	}
-	if( disk_type == NULL )
+	if( file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid disk type.",
-		 function );
-
-		return( -1 );
-	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: invalid file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	*disk_type = internal_handle->disk_type;
-
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
+	if( libvmdk_internal_handle_copy_to_destination(
+	     (libvmdk_internal_handle_t *) handle,
+	     offset,
+	     size,
+	     file_io_handle,
+	     -1,
+	     destination_offset,
+	     copy_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to copy data to file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
 	return( 1 );
 }
 
-/* Retrieves the media size
+/* Copies (media) data to a file descriptor
+ * If LIBVMDK_COPY_FLAG_SPARSE is set, ranges that consist of zeros according to the grain tables are not written
+ * but skipped, leaving a hole in the destination, the destination must therefore read as zeros in the destination range
+ * Uncompressed ranges are copied with copy_file_range if available and the extent data files were opened by the library
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_handle_get_media_size(
+int libvmdk_handle_copy_to_file_descriptor(
      libvmdk_handle_t *handle,
-     size64_t *media_size,
+     off64_t offset,
+     size64_t size,
+     int file_descriptor,
+     off64_t destination_offset,
+     uint8_t copy_flags,
      libcerror_error_t **error )
 {
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_media_size";
+	static char *function = "libvmdk_handle_copy_to_file_descriptor";
 
 	if( handle == NULL )
 	{
@@ -4188,77 +9278,85 @@ int libvmdk_handle_get_media_size(
 
 		return( -1 );
 	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
-
-	if( internal_handle->descriptor_file == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing descriptor file.",
-		 function );
-
-		return( -1 );
-	}
-	if( media_size == NULL )
+	if( file_descriptor < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid media size.",
+		 "%s: invalid file descriptor.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
+#if defined( LIBVMDK_HAVE_COPY_TO_FILE_DESCRIPTOR )
+	if( libvmdk_internal_handle_copy_to_destination(
+	     (libvmdk_internal_handle_t *) handle,
+	     offset,
+	     size,
+	     NULL,
+	     file_descriptor,
+	     destination_offset,
+	     copy_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to copy data to file descriptor.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	*media_size = internal_handle->descriptor_file->media_size;
-
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
-		 function );
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: copying to a file descriptor is not supported.",
+	 function );
 
-		return( -1 );
-	}
+	return( -1 );
 #endif
-	return( 1 );
 }
 
-/* Retrieves the content identifier
- * Returns 1 if successful or -1 on error
+/* Checks the integrity of an extent data file
+ * The corrupted ranges that were detected are appended to the corrupted ranges array
+ * Returns 1 if no corruption was detected, 0 if corruption was detected or -1 on error
  */
-int libvmdk_handle_get_content_identifier(
-     libvmdk_handle_t *handle,
-     uint32_t *content_identifier,
+int libvmdk_internal_handle_check_extent_file(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int extent_index,
      libcerror_error_t **error )
 {
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_content_identifier";
+	libvmdk_extent_file_t *extent_file             = NULL;
+	libvmdk_extent_values_t *extent_values         = NULL;
+	uint8_t *backup_grain_directory_data           = NULL;
+	uint8_t *grain_directory_data                  = NULL;
+	static char *function                          = "libvmdk_internal_handle_check_extent_file";
+	size64_t extent_file_size                      = 0;
+	ssize_t read_count                             = 0;
+	off64_t backup_grain_directory_offset          = 0;
+	off64_t extent_offset                          = 0;
+	off64_t grain_directory_offset                 = 0;
+	int number_of_corrupted_ranges                 = 0;
+	int previous_number_of_corrupted_ranges        = 0;
 
-	if( handle == NULL )
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *check_thread_pool   = NULL;
+	libvmdk_corrupted_range_t *corrupted_range     = NULL;
+	libvmdk_grain_check_task_t **grain_check_tasks = NULL;
+	uint32_t grain_directory_entry_index           = 0;
+	uint32_t number_of_grain_directory_entries     = 0;
+	int number_of_tasks                            = 0;
+	int range_index                                = 0;
+	int task_index                                 = 0;
+#endif
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -4269,378 +9367,574 @@ int libvmdk_handle_get_content_identifier(
 
 		return( -1 );
 	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
-
-	if( internal_handle->descriptor_file == NULL )
+	if( libcdata_array_get_entry_by_index(
+	     internal_handle->extent_values_array,
+	     extent_index,
+	     (intptr_t **) &extent_values,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing descriptor file.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent values: %d from array.",
+		 function,
+		 extent_index );
 
 		return( -1 );
 	}
-	if( content_identifier == NULL )
+	if( extent_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid content identifier.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing extent values: %d.",
+		 function,
+		 extent_index );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
+	/* The bounds of flat extents are checked when the extent data files are opened
+	 */
+	if( ( extent_values->type != LIBVMDK_EXTENT_TYPE_SPARSE )
+	 && ( extent_values->type != LIBVMDK_EXTENT_TYPE_VMFS_SPARSE ) )
+	{
+		return( 1 );
+	}
+	if( libvmdk_extent_table_get_extent_file_by_index(
+	     internal_handle->extent_table,
+	     extent_index,
+	     file_io_pool,
+	     &extent_offset,
+	     &extent_file,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent file: %d from extent table.",
+		 function,
+		 extent_index );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	*content_identifier = internal_handle->descriptor_file->content_identifier;
-
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( extent_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing extent file: %d.",
+		 function,
+		 extent_index );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( 1 );
-}
-
-/* Retrieves the parent content identifier
- * Returns 1 if successful, 0 if not available or -1 on error
- */
-int libvmdk_handle_get_parent_content_identifier(
-     libvmdk_handle_t *handle,
-     uint32_t *parent_content_identifier,
-     libcerror_error_t **error )
-{
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_parent_content_identifier";
-	int result                                 = 0;
-
-	if( handle == NULL )
+	if( ( extent_file->grain_directory_size == 0 )
+	 || ( extent_file->grain_directory_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent file: %d - grain directory size value out of bounds.",
+		 function,
+		 extent_index );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
-
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
+	if( libbfio_pool_get_size(
+	     file_io_pool,
+	     extent_index,
+	     &extent_file_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size of file IO pool entry: %d.",
+		 function,
+		 extent_index );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	result = libvmdk_descriptor_file_get_parent_content_identifier(
-	          internal_handle->descriptor_file,
-	          parent_content_identifier,
-	          error );
-
-	if( result == -1 )
+	if( libvmdk_extent_file_get_grain_directory_offsets(
+	     extent_file,
+	     &grain_directory_offset,
+	     &backup_grain_directory_offset,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve parent content identifier.",
-		 function );
+		 "%s: unable to retrieve grain directory offsets of extent file: %d.",
+		 function,
+		 extent_index );
 
-		result = -1;
+		goto on_error;
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
+	if( libcdata_array_get_number_of_entries(
+	     internal_handle->corrupted_ranges_array,
+	     &previous_number_of_corrupted_ranges,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of corrupted ranges.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( result );
-}
-
-/* Retrieves the size of the UTF-8 encoded parent filename
- * The returned size includes the end of string character
- * Returns 1 if successful, 0 if not available or -1 on error
- */
-int libvmdk_handle_get_utf8_parent_filename_size(
-     libvmdk_handle_t *handle,
-     size_t *utf8_string_size,
-     libcerror_error_t **error )
-{
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_utf8_parent_filename_size";
-	int result                                 = 0;
+	grain_directory_data = (uint8_t *) memory_allocate(
+	                                    sizeof( uint8_t ) * extent_file->grain_directory_size );
 
-	if( handle == NULL )
+	if( grain_directory_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain directory data.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
+	/* The grain directory was already read when the extent data file was opened
+	 * hence a failure to read it is not considered corruption
+	 */
+	read_count = libbfio_pool_read_buffer_at_offset(
+	              file_io_pool,
+	              extent_index,
+	              grain_directory_data,
+	              extent_file->grain_directory_size,
+	              grain_directory_offset,
+	              error );
 
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( read_count != (ssize_t) extent_file->grain_directory_size )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read grain directory data of extent file: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 extent_index,
+		 grain_directory_offset,
+		 grain_directory_offset );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	result = libvmdk_descriptor_file_get_utf8_parent_filename_size(
-	          internal_handle->descriptor_file,
-	          utf8_string_size,
-	          error );
-
-	if( result == -1 )
+	if( backup_grain_directory_offset > 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-8 parent filename size.",
-		 function );
+		if( ( (size64_t) backup_grain_directory_offset >= extent_file_size )
+		 || ( extent_file->grain_directory_size > ( extent_file_size - (size64_t) backup_grain_directory_offset ) ) )
+		{
+			read_count = -1;
+		}
+		else
+		{
+			backup_grain_directory_data = (uint8_t *) memory_allocate(
+			                                           sizeof( uint8_t ) * extent_file->grain_directory_size );
 
-		result = -1;
+			if( backup_grain_directory_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create backup grain directory data.",
+				 function );
+
+				goto on_error;
+			}
+			read_count = libbfio_pool_read_buffer_at_offset(
+			              file_io_pool,
+			              extent_index,
+			              backup_grain_directory_data,
+			              extent_file->grain_directory_size,
+			              backup_grain_directory_offset,
+			              NULL );
+		}
+		/* When the backup grain directory cannot be read the whole extent
+		 * is marked as a grain directory mismatch and the grain tables are
+		 * checked without their backup
+		 */
+		if( read_count != (ssize_t) extent_file->grain_directory_size )
+		{
+			if( backup_grain_directory_data != NULL )
+			{
+				memory_free(
+				 backup_grain_directory_data );
+
+				backup_grain_directory_data = NULL;
+			}
+			if( libvmdk_corrupted_range_append_to_array(
+			     internal_handle->corrupted_ranges_array,
+			     extent_offset,
+			     extent_values->size,
+			     extent_index,
+			     LIBVMDK_CORRUPTION_FLAG_GRAIN_DIRECTORY_MISMATCH,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append corrupted range.",
+				 function );
+
+				goto on_error;
+			}
+		}
 	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
-		 function );
+	number_of_tasks = LIBVMDK_NUMBER_OF_GRAIN_CHECK_THREADS;
 
-		return( -1 );
+	if( extent_file->number_of_grain_directory_entries < (uint32_t) number_of_tasks )
+	{
+		number_of_tasks = (int) extent_file->number_of_grain_directory_entries;
 	}
-#endif
-	return( result );
-}
+	if( number_of_tasks > 1 )
+	{
+		grain_check_tasks = (libvmdk_grain_check_task_t **) memory_allocate(
+		                                                     sizeof( libvmdk_grain_check_task_t * ) * number_of_tasks );
 
-/* Retrieves the UTF-8 encoded parent filename
- * The size should include the end of string character
- * Returns 1 if successful, 0 if not available or -1 on error
- */
-int libvmdk_handle_get_utf8_parent_filename(
-     libvmdk_handle_t *handle,
-     uint8_t *utf8_string,
-     size_t utf8_string_size,
-     libcerror_error_t **error )
-{
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_utf8_parent_filename";
-	int result                                 = 0;
+		if( grain_check_tasks == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create grain check tasks.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     grain_check_tasks,
+		     0,
+		     sizeof( libvmdk_grain_check_task_t * ) * number_of_tasks ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear grain check tasks.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_thread_pool_create(
+		     &check_thread_pool,
+		     NULL,
+		     number_of_tasks,
+		     number_of_tasks,
+		     (int (*)(intptr_t *, void *)) &libvmdk_grain_check_task_run,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create check thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		/* Every task checks a contiguous slice of the grain directory
+		 */
+		for( task_index = 0;
+		     task_index < number_of_tasks;
+		     task_index++ )
+		{
+			number_of_grain_directory_entries = extent_file->number_of_grain_directory_entries / (uint32_t) number_of_tasks;
+
+			if( task_index == ( number_of_tasks - 1 ) )
+			{
+				number_of_grain_directory_entries = extent_file->number_of_grain_directory_entries - grain_directory_entry_index;
+			}
+			if( libvmdk_grain_check_task_initialize(
+			     &( grain_check_tasks[ task_index ] ),
+			     extent_file,
+			     file_io_pool,
+			     extent_index,
+			     extent_file_size,
+			     extent_offset,
+			     grain_directory_data,
+			     backup_grain_directory_data,
+			     grain_directory_entry_index,
+			     number_of_grain_directory_entries,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create grain check task: %d.",
+				 function,
+				 task_index );
+
+				goto on_error;
+			}
+			if( libcthreads_thread_pool_push(
+			     check_thread_pool,
+			     (intptr_t *) grain_check_tasks[ task_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push grain check task: %d onto check thread pool.",
+				 function,
+				 task_index );
+
+				goto on_error;
+			}
+			grain_directory_entry_index += number_of_grain_directory_entries;
+		}
+		if( libcthreads_thread_pool_join(
+		     &check_thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join check thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		/* The corrupted ranges of the tasks are merged in order so that
+		 * the corrupted ranges array remains sorted by offset
+		 */
+		for( task_index = 0;
+		     task_index < number_of_tasks;
+		     task_index++ )
+		{
+			if( grain_check_tasks[ task_index ]->result != 1 )
+			{
+				if( ( error != NULL )
+				 && ( *error == NULL ) )
+				{
+					*error = grain_check_tasks[ task_index ]->error;
+
+					grain_check_tasks[ task_index ]->error = NULL;
+				}
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to check grain groups of extent file: %d.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+			if( libcdata_array_get_number_of_entries(
+			     grain_check_tasks[ task_index ]->corrupted_ranges_array,
+			     &number_of_corrupted_ranges,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of corrupted ranges of grain check task: %d.",
+				 function,
+				 task_index );
+
+				goto on_error;
+			}
+			for( range_index = 0;
+			     range_index < number_of_corrupted_ranges;
+			     range_index++ )
+			{
+				if( libcdata_array_get_entry_by_index(
+				     grain_check_tasks[ task_index ]->corrupted_ranges_array,
+				     range_index,
+				     (intptr_t **) &corrupted_range,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve corrupted range: %d of grain check task: %d.",
+					 function,
+					 range_index,
+					 task_index );
+
+					goto on_error;
+				}
+				if( corrupted_range == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing corrupted range: %d of grain check task: %d.",
+					 function,
+					 range_index,
+					 task_index );
+
+					goto on_error;
+				}
+				if( libvmdk_corrupted_range_append_to_array(
+				     internal_handle->corrupted_ranges_array,
+				     corrupted_range->offset,
+				     corrupted_range->size,
+				     corrupted_range->extent_index,
+				     corrupted_range->corruption_flags,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append corrupted range.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( libvmdk_grain_check_task_free(
+			     &( grain_check_tasks[ task_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free grain check task: %d.",
+				 function,
+				 task_index );
 
-	if( handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
+				goto on_error;
+			}
+		}
+		memory_free(
+		 grain_check_tasks );
 
-		return( -1 );
+		grain_check_tasks = NULL;
 	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
-
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
+	else
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+	if( libvmdk_extent_file_check_grain_groups(
+	     extent_file,
+	     file_io_pool,
+	     extent_index,
+	     extent_file_size,
+	     extent_offset,
+	     grain_directory_data,
+	     backup_grain_directory_data,
+	     0,
+	     extent_file->number_of_grain_directory_entries,
+	     internal_handle->corrupted_ranges_array,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to check grain groups of extent file: %d.",
+		 function,
+		 extent_index );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	result = libvmdk_descriptor_file_get_utf8_parent_filename(
-	          internal_handle->descriptor_file,
-	          utf8_string,
-	          utf8_string_size,
-	          error );
-
-	if( result == -1 )
+	if( backup_grain_directory_data != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-8 parent filename.",
-		 function );
+		memory_free(
+		 backup_grain_directory_data );
 
-		result = -1;
+		backup_grain_directory_data = NULL;
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
+	memory_free(
+	 grain_directory_data );
+
+	grain_directory_data = NULL;
+
+	if( libcdata_array_get_number_of_entries(
+	     internal_handle->corrupted_ranges_array,
+	     &number_of_corrupted_ranges,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of corrupted ranges.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( result );
-}
-
-/* Retrieves the size of the UTF-16 encoded parent filename
- * The returned size includes the end of string character
- * Returns 1 if successful, 0 if not available or -1 on error
- */
-int libvmdk_handle_get_utf16_parent_filename_size(
-     libvmdk_handle_t *handle,
-     size_t *utf16_string_size,
-     libcerror_error_t **error )
-{
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_utf16_parent_filename_size";
-	int result                                 = 0;
-
-	if( handle == NULL )
+	if( number_of_corrupted_ranges != previous_number_of_corrupted_ranges )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		return( -1 );
+		return( 0 );
 	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
+	return( 1 );
 
+on_error:
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( check_thread_pool != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
-		 function );
-
-		return( -1 );
+		libcthreads_thread_pool_join(
+		 &check_thread_pool,
+		 NULL );
 	}
-#endif
-	result = libvmdk_descriptor_file_get_utf16_parent_filename_size(
-	          internal_handle->descriptor_file,
-	          utf16_string_size,
-	          error );
-
-	if( result == -1 )
+	if( grain_check_tasks != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-16 parent filename size.",
-		 function );
-
-		result = -1;
+		for( task_index = 0;
+		     task_index < number_of_tasks;
+		     task_index++ )
+		{
+			if( grain_check_tasks[ task_index ] != NULL )
+			{
+				libvmdk_grain_check_task_free(
+				 &( grain_check_tasks[ task_index ] ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 grain_check_tasks );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+	if( backup_grain_directory_data != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
-		 function );
-
-		return( -1 );
+		memory_free(
+		 backup_grain_directory_data );
 	}
-#endif
-	return( result );
+	if( grain_directory_data != NULL )
+	{
+		memory_free(
+		 grain_directory_data );
+	}
+	return( -1 );
 }
 
-/* Retrieves the UTF-16 encoded parent filename
- * The size should include the end of string character
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Checks the integrity of a specific extent
+ * For sparse extents the grain directory and grain tables are compared with their backup,
+ * the grain offsets are checked to be within the bounds of the extent data file and
+ * compressed grains are decompressed to validate their checksum
+ * The corrupted ranges that were detected can be retrieved with libvmdk_handle_get_corrupted_range
+ * Returns 1 if no corruption was detected, 0 if corruption was detected or -1 on error
  */
-int libvmdk_handle_get_utf16_parent_filename(
+int libvmdk_handle_check_extent(
      libvmdk_handle_t *handle,
-     uint16_t *utf16_string,
-     size_t utf16_string_size,
+     int extent_index,
      libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_utf16_parent_filename";
+	static char *function                      = "libvmdk_handle_check_extent";
 	int result                                 = 0;
 
 	if( handle == NULL )
@@ -4656,8 +9950,19 @@ int libvmdk_handle_get_utf16_parent_filename(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4665,16 +9970,16 @@ int libvmdk_handle_get_utf16_parent_filename(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	result = libvmdk_descriptor_file_get_utf16_parent_filename(
-	          internal_handle->descriptor_file,
-	          utf16_string,
-	          utf16_string_size,
+	result = libvmdk_internal_handle_check_extent_file(
+	          internal_handle,
+	          internal_handle->extent_data_file_io_pool,
+	          extent_index,
 	          error );
 
 	if( result == -1 )
@@ -4683,13 +9988,12 @@ int libvmdk_handle_get_utf16_parent_filename(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-16 parent filename.",
-		 function );
-
-		result = -1;
+		 "%s: unable to check extent: %d.",
+		 function,
+		 extent_index );
 	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4697,7 +10001,7 @@ int libvmdk_handle_get_utf16_parent_filename(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -4706,16 +10010,16 @@ int libvmdk_handle_get_utf16_parent_filename(
 	return( result );
 }
 
-/* Retrieves the number of extents
+/* Retrieves the number of corrupted ranges
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_handle_get_number_of_extents(
+int libvmdk_handle_get_number_of_corrupted_ranges(
      libvmdk_handle_t *handle,
-     int *number_of_extents,
+     int *number_of_corrupted_ranges,
      libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_number_of_extents";
+	static char *function                      = "libvmdk_handle_get_number_of_corrupted_ranges";
 	int result                                 = 1;
 
 	if( handle == NULL )
@@ -4731,17 +10035,6 @@ int libvmdk_handle_get_number_of_extents(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( internal_handle->descriptor_file == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing descriptor file.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
@@ -4758,15 +10051,15 @@ int libvmdk_handle_get_number_of_extents(
 	}
 #endif
 	if( libcdata_array_get_number_of_entries(
-	     internal_handle->extent_values_array,
-	     number_of_extents,
+	     internal_handle->corrupted_ranges_array,
+	     number_of_corrupted_ranges,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of extents.",
+		 "%s: unable to retrieve number of corrupted ranges.",
 		 function );
 
 		result = -1;
@@ -4789,18 +10082,21 @@ int libvmdk_handle_get_number_of_extents(
 	return( result );
 }
 
-/* Retrieves a specific extent descriptor
+/* Retrieves a specific corrupted range
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_handle_get_extent_descriptor(
+int libvmdk_handle_get_corrupted_range(
      libvmdk_handle_t *handle,
-     int extent_index,
-     libvmdk_extent_descriptor_t **extent_descriptor,
+     int range_index,
+     off64_t *offset,
+     size64_t *size,
+     int *extent_index,
+     uint32_t *corruption_flags,
      libcerror_error_t **error )
 {
-	libvmdk_extent_values_t *extent_values     = NULL;
+	libvmdk_corrupted_range_t *corrupted_range = NULL;
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_extent_descriptor";
+	static char *function                      = "libvmdk_handle_get_corrupted_range";
 	int result                                 = 1;
 
 	if( handle == NULL )
@@ -4816,35 +10112,46 @@ int libvmdk_handle_get_extent_descriptor(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( internal_handle->descriptor_file == NULL )
+	if( offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing descriptor file.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
 		 function );
 
 		return( -1 );
 	}
-	if( extent_descriptor == NULL )
+	if( size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid extent descriptor.",
+		 "%s: invalid size.",
 		 function );
 
 		return( -1 );
 	}
-	if( *extent_descriptor != NULL )
+	if( extent_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid extent descriptor value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( corruption_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid corruption flags.",
 		 function );
 
 		return( -1 );
@@ -4865,35 +10172,40 @@ int libvmdk_handle_get_extent_descriptor(
 	}
 #endif
 	if( libcdata_array_get_entry_by_index(
-	     internal_handle->extent_values_array,
-	     extent_index,
-	     (intptr_t **) &extent_values,
+	     internal_handle->corrupted_ranges_array,
+	     range_index,
+	     (intptr_t **) &corrupted_range,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve extent: %d from array.",
+		 "%s: unable to retrieve corrupted range: %d.",
 		 function,
-		 extent_index );
+		 range_index );
 
 		result = -1;
 	}
-	else if( libvmdk_extent_descriptor_initialize(
-	          extent_descriptor,
-	          extent_values,
-	          error ) != 1 )
+	else if( corrupted_range == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create extent descriptor.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing corrupted range: %d.",
+		 function,
+		 range_index );
 
 		result = -1;
 	}
+	else
+	{
+		*offset           = corrupted_range->offset;
+		*size             = corrupted_range->size;
+		*extent_index     = corrupted_range->extent_index;
+		*corruption_flags = corrupted_range->corruption_flags;
+	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -25,21 +25,77 @@
 #include <common.h>
 #include <types.h>
 
+#include "libvmdk_change_tracking_file.h"
 #include "libvmdk_descriptor_file.h"
 #include "libvmdk_extent_table.h"
 #include "libvmdk_extern.h"
 #include "libvmdk_grain_table.h"
 #include "libvmdk_io_handle.h"
 #include "libvmdk_libbfio.h"
+#include "libvmdk_libcdata.h"
 #include "libvmdk_libcerror.h"
 #include "libvmdk_libcthreads.h"
 #include "libvmdk_libfcache.h"
 #include "libvmdk_libfdata.h"
+#include "libvmdk_read_request.h"
+#include "libvmdk_types.h"
+
+/* Data can be copied to a file descriptor on platforms that provide pwrite
+ */
+#if defined( HAVE_UNISTD_H ) && defined( HAVE_FSTAT ) && defined( HAVE_PWRITE ) && !defined( WINAPI )
+#define LIBVMDK_HAVE_COPY_TO_FILE_DESCRIPTOR
+#endif
+
+/* Uncompressed runs can be copied by the kernel with copy_file_range, the extent data file
+ * is then opened by its narrow name
+ */
+#if defined( LIBVMDK_HAVE_COPY_TO_FILE_DESCRIPTOR ) && defined( HAVE_COPY_FILE_RANGE ) && defined( HAVE_FCNTL_H ) && defined( HAVE_OPEN ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define LIBVMDK_HAVE_COPY_FILE_RANGE
+#endif
+
+/* The abort generation is changed by libvmdk_handle_signal_abort without holding the read/write lock,
+ * since it can be called from a signal handler while the thread that was interrupted holds the lock
+ */
+#if defined( _MSC_VER )
+#define libvmdk_handle_abort_generation_increment( abort_generation ) \
+	InterlockedIncrement( (LONG volatile *) abort_generation )
+
+#define libvmdk_handle_abort_generation_get( abort_generation ) \
+	(uint32_t) InterlockedCompareExchange( (LONG volatile *) abort_generation, 0, 0 )
+
+#elif defined( __GNUC__ ) || defined( __clang__ )
+#define libvmdk_handle_abort_generation_increment( abort_generation ) \
+	__atomic_add_fetch( abort_generation, 1, __ATOMIC_SEQ_CST )
+
+#define libvmdk_handle_abort_generation_get( abort_generation ) \
+	__atomic_load_n( abort_generation, __ATOMIC_SEQ_CST )
+
+#else
+#define libvmdk_handle_abort_generation_increment( abort_generation ) \
+	*( abort_generation ) += 1
+
+#define libvmdk_handle_abort_generation_get( abort_generation ) \
+	*( abort_generation )
+
+#endif
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+typedef struct libvmdk_read_range libvmdk_read_range_t;
+
+struct libvmdk_read_range
+{
+	/* The (media) offset
+	 */
+	off64_t offset;
+
+	/* The index of the range
+	 */
+	int range_index;
+};
+
 typedef struct libvmdk_internal_handle libvmdk_internal_handle_t;
 
 struct libvmdk_internal_handle
@@ -64,6 +120,10 @@ struct libvmdk_internal_handle
 	 */
 	libcdata_array_t *extent_values_array;
 
+	/* The corrupted ranges array
+	 */
+	libcdata_array_t *corrupted_ranges_array;
+
 	/* The extent (file) table
 	 */
 	libvmdk_extent_table_t *extent_table;
@@ -84,6 +144,22 @@ struct libvmdk_internal_handle
 	 */
 	uint8_t extent_data_file_io_pool_created_in_library;
 
+	/* The change tracking file
+	 */
+	libvmdk_change_tracking_file_t *change_tracking_file;
+
+	/* The change tracking file IO handle
+	 */
+	libbfio_handle_t *change_tracking_file_io_handle;
+
+	/* Value to indicate if the change tracking file IO handle was created inside the library
+	 */
+	uint8_t change_tracking_file_io_handle_created_in_library;
+
+	/* Value to indicate if the change tracking file IO handle was opened inside the library
+	 */
+	uint8_t change_tracking_file_io_handle_opened_in_library;
+
 	/* The access flags
 	 */
 	int access_flags;
@@ -96,7 +172,24 @@ struct libvmdk_internal_handle
 	 */
 	libvmdk_handle_t *parent_handle;
 
+	/* The shared cache
+	 */
+	libvmdk_shared_cache_t *shared_cache;
+
+	/* The (disk) identifier in the shared cache
+	 */
+	uint64_t shared_cache_identifier;
+
+	/* The abort generation, used to cancel pending read requests
+	 * Use libvmdk_handle_abort_generation_get and libvmdk_handle_abort_generation_increment to access it
+	 */
+	uint32_t abort_generation;
+
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	/* The read requests thread pool
+	 */
+	libcthreads_thread_pool_t *read_requests_thread_pool;
+
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
@@ -172,6 +265,28 @@ int libvmdk_handle_open_extent_data_file_wide(
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
+LIBVMDK_EXTERN \
+int libvmdk_handle_open_change_tracking_file(
+     libvmdk_handle_t *handle,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_open_change_tracking_file_wide(
+     libvmdk_handle_t *handle,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_open_change_tracking_file_io_handle(
+     libvmdk_handle_t *handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
 LIBVMDK_EXTERN \
 int libvmdk_handle_close(
      libvmdk_handle_t *handle,
@@ -187,11 +302,35 @@ int libvmdk_internal_handle_open_read_extent_data_files(
      libbfio_pool_t *file_io_pool,
      libcerror_error_t **error );
 
+int libvmdk_internal_handle_open_read_extent_file(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int extent_index,
+     size64_t extent_file_size,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_set_extent_file(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int extent_index,
+     libvmdk_extent_file_t *extent_file,
+     libcerror_error_t **error );
+
+
 int libvmdk_internal_handle_open_read_signature(
      libbfio_handle_t *file_io_handle,
      uint8_t *file_type,
      libcerror_error_t **error );
 
+int libvmdk_internal_handle_get_contiguous_grains_size(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t grain_index,
+     libvmdk_grain_descriptor_t *grain_descriptor,
+     size_t maximum_size,
+     size_t *contiguous_size,
+     libcerror_error_t **error );
+
 ssize_t libvmdk_internal_handle_read_buffer_from_file_io_pool(
          libvmdk_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -214,6 +353,52 @@ ssize_t libvmdk_handle_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+int libvmdk_read_range_compare(
+     const libvmdk_read_range_t *first_read_range,
+     const libvmdk_read_range_t *second_read_range );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_read_ranges(
+     libvmdk_handle_t *handle,
+     int number_of_ranges,
+     void **buffers,
+     size_t *buffer_sizes,
+     off64_t *offsets,
+     ssize_t *read_counts,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_process_read_request(
+     libvmdk_read_request_t *read_request,
+     libvmdk_internal_handle_t *internal_handle );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_submit_read(
+     libvmdk_handle_t *handle,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+            libvmdk_handle_t *handle,
+            void *buffer,
+            ssize_t read_count,
+            libcerror_error_t *error,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_wait_for_reads(
+     libvmdk_handle_t *handle,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+int libvmdk_internal_handle_join_read_requests_thread_pool(
+     libvmdk_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
 off64_t libvmdk_internal_handle_seek_offset(
          libvmdk_internal_handle_t *internal_handle,
          off64_t offset,
@@ -245,6 +430,14 @@ int libvmdk_handle_set_parent_handle(
      libvmdk_handle_t *parent_handle,
      libcerror_error_t **error );
 
+LIBVMDK_EXTERN \
+int libvmdk_handle_set_shared_cache(
+     libvmdk_handle_t *handle,
+     libvmdk_shared_cache_t *shared_cache,
+     const uint8_t *image_identifier,
+     size_t image_identifier_size,
+     libcerror_error_t **error );
+
 LIBVMDK_EXTERN \
 int libvmdk_handle_set_extent_data_files_path(
      libvmdk_handle_t *handle,
@@ -313,6 +506,73 @@ int libvmdk_handle_get_utf16_parent_filename(
      size_t utf16_string_size,
      libcerror_error_t **error );
 
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_utf8_change_tracking_filename_size(
+     libvmdk_handle_t *handle,
+     size_t *utf8_string_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_utf8_change_tracking_filename(
+     libvmdk_handle_t *handle,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_utf16_change_tracking_filename_size(
+     libvmdk_handle_t *handle,
+     size_t *utf16_string_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_utf16_change_tracking_filename(
+     libvmdk_handle_t *handle,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_change_sequence_number(
+     libvmdk_handle_t *handle,
+     uint32_t *change_sequence_number,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_change_tracking_identifier(
+     libvmdk_handle_t *handle,
+     uint8_t *guid_data,
+     size_t guid_data_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_changed_range(
+     libvmdk_handle_t *handle,
+     uint32_t change_sequence_number,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_number_of_grain_directory_mismatches(
+     libvmdk_handle_t *handle,
+     uint32_t *number_of_mismatches,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_get_memory_usage(
+     libvmdk_internal_handle_t *internal_handle,
+     int memory_usage_type,
+     size64_t *memory_usage,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_memory_usage(
+     libvmdk_handle_t *handle,
+     int memory_usage_type,
+     size64_t *memory_usage,
+     libcerror_error_t **error );
+
 LIBVMDK_EXTERN \
 int libvmdk_handle_get_number_of_extents(
      libvmdk_handle_t *handle,
@@ -326,6 +586,110 @@ int libvmdk_handle_get_extent_descriptor(
      libvmdk_extent_descriptor_t **extent_descriptor,
      libcerror_error_t **error );
 
+int libvmdk_internal_handle_get_extent_map_run_at_offset(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     size64_t *run_size,
+     int *extent_index,
+     off64_t *physical_offset,
+     uint32_t *run_flags,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_extent_map_run_at_offset(
+     libvmdk_handle_t *handle,
+     off64_t offset,
+     size64_t *run_size,
+     int *extent_index,
+     off64_t *physical_offset,
+     uint32_t *run_flags,
+     libcerror_error_t **error );
+
+#if defined( LIBVMDK_HAVE_COPY_FILE_RANGE )
+
+int libvmdk_internal_handle_open_extent_data_file_descriptor(
+     libvmdk_internal_handle_t *internal_handle,
+     int extent_index,
+     int *file_descriptor,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_copy_file_range(
+     int source_file_descriptor,
+     off64_t source_offset,
+     int destination_file_descriptor,
+     off64_t destination_offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+#endif /* defined( LIBVMDK_HAVE_COPY_FILE_RANGE ) */
+
+ssize_t libvmdk_internal_handle_write_buffer_to_destination(
+         libbfio_handle_t *file_io_handle,
+         int file_descriptor,
+         const uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int libvmdk_internal_handle_copy_to_destination(
+     libvmdk_internal_handle_t *internal_handle,
+     off64_t offset,
+     size64_t size,
+     libbfio_handle_t *file_io_handle,
+     int file_descriptor,
+     off64_t destination_offset,
+     uint8_t copy_flags,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_copy_to_file_io_handle(
+     libvmdk_handle_t *handle,
+     off64_t offset,
+     size64_t size,
+     libbfio_handle_t *file_io_handle,
+     off64_t destination_offset,
+     uint8_t copy_flags,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_copy_to_file_descriptor(
+     libvmdk_handle_t *handle,
+     off64_t offset,
+     size64_t size,
+     int file_descriptor,
+     off64_t destination_offset,
+     uint8_t copy_flags,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_check_extent_file(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int extent_index,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_check_extent(
+     libvmdk_handle_t *handle,
+     int extent_index,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_number_of_corrupted_ranges(
+     libvmdk_handle_t *handle,
+     int *number_of_corrupted_ranges,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_corrupted_range(
+     libvmdk_handle_t *handle,
+     int range_index,
+     off64_t *offset,
+     size64_t *size,
+     int *extent_index,
+     uint32_t *corruption_flags,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -44,6 +44,10 @@ struct libvmdk_io_handle
 	 */
 	uint8_t file_type;
 
+	/* The disk type
+	 */
+	int disk_type;
+
 	/* The maximum data size
 	 */
 	size64_t maximum_data_size;
@@ -60,6 +64,15 @@ struct libvmdk_io_handle
 	 */
 	uint16_t compression_method;
 
+	/* The backup grain directory mode
+	 */
+	uint8_t backup_grain_directory_mode;
+
+	/* The number of grain directory entries that differ between
+	 * the primary and secondary (backup) grain directories
+	 */
+	uint32_t number_of_grain_directory_mismatches;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -0,0 +1,194 @@
+/*
+ * Read request functions
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_libcerror.h"
+#include "libvmdk_read_request.h"
+#include "libvmdk_types.h"
+
+/* Creates a read request
+ * Make sure the value read_request is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_read_request_initialize(
+     libvmdk_read_request_t **read_request,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+            libvmdk_handle_t *handle,
+            void *buffer,
+            ssize_t read_count,
+            libcerror_error_t *error,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_read_request_initialize";
+
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_request != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read request value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	*read_request = memory_allocate_structure(
+	                 libvmdk_read_request_t );
+
+	if( *read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read request.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_request,
+	     0,
+	     sizeof( libvmdk_read_request_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read request.",
+		 function );
+
+		goto on_error;
+	}
+	( *read_request )->buffer            = buffer;
+	( *read_request )->buffer_size       = buffer_size;
+	( *read_request )->offset            = offset;
+	( *read_request )->callback_function = callback_function;
+	( *read_request )->callback_data     = callback_data;
+
+	return( 1 );
+
+on_error:
+	if( *read_request != NULL )
+	{
+		memory_free(
+		 *read_request );
+
+		*read_request = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read request
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_read_request_free(
+     libvmdk_read_request_t **read_request,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_read_request_free";
+
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_request != NULL )
+	{
+		/* The buffer and callback data are referenced and not managed by the read request
+		 */
+		memory_free(
+		 *read_request );
+
+		*read_request = NULL;
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,92 @@
+/*
+ * Read request functions
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_READ_REQUEST_H )
+#define _LIBVMDK_READ_REQUEST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_libcerror.h"
+#include "libvmdk_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_read_request libvmdk_read_request_t;
+
+struct libvmdk_read_request
+{
+	/* The buffer
+	 */
+	void *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The (media) offset
+	 */
+	off64_t offset;
+
+	/* The abort generation at the time the request was submitted
+	 */
+	uint32_t abort_generation;
+
+	/* The callback function
+	 */
+	void (*callback_function)(
+	       libvmdk_handle_t *handle,
+	       void *buffer,
+	       ssize_t read_count,
+	       libcerror_error_t *error,
+	       void *callback_data );
+
+	/* The callback data
+	 */
+	void *callback_data;
+};
+
+int libvmdk_read_request_initialize(
+     libvmdk_read_request_t **read_request,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+            libvmdk_handle_t *handle,
+            void *buffer,
+            ssize_t read_count,
+            libcerror_error_t *error,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+int libvmdk_read_request_free(
+     libvmdk_read_request_t **read_request,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_READ_REQUEST_H ) */
+
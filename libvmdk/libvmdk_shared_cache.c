@@ -0,0 +1,1183 @@
+/*
+ * Shared (grain) cache functions
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcthreads.h"
+#include "libvmdk_shared_cache.h"
+#include "libvmdk_types.h"
+
+/* Determines the hash bucket of a shared cache entry
+ */
+#define libvmdk_shared_cache_get_bucket_index( identifier, file_index, offset, number_of_buckets ) \
+	( ( ( ( (uint32_t) ( identifier ) ^ (uint32_t) ( ( identifier ) >> 32 ) ) * 31 \
+	      + (uint32_t) ( file_index ) ) * 2654435761UL \
+	    + (uint32_t) ( ( offset ) >> 9 ) + (uint32_t) ( ( offset ) >> 41 ) ) % ( number_of_buckets ) )
+
+/* Creates a shared cache
+ * Make sure the value shared_cache is referencing, is set to NULL
+ *
+ * The shared cache contains (decompressed) grain data that can be shared
+ * between handles. The maximum size is the number of bytes of grain data
+ * the cache is allowed to retain. Only grain data is limited, the grain groups,
+ * extent tables and buffers of a handle are not part of the shared cache
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_shared_cache_initialize(
+     libvmdk_shared_cache_t **shared_cache,
+     size64_t maximum_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_shared_cache_t *internal_shared_cache = NULL;
+	static char *function                                  = "libvmdk_shared_cache_initialize";
+	size64_t number_of_buckets                             = 0;
+
+	if( shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *shared_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid shared cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_buckets = maximum_size / LIBVMDK_SHARED_CACHE_BYTES_PER_BUCKET;
+
+	if( number_of_buckets < LIBVMDK_SHARED_CACHE_MINIMUM_NUMBER_OF_BUCKETS )
+	{
+		number_of_buckets = LIBVMDK_SHARED_CACHE_MINIMUM_NUMBER_OF_BUCKETS;
+	}
+	else if( number_of_buckets > LIBVMDK_SHARED_CACHE_MAXIMUM_NUMBER_OF_BUCKETS )
+	{
+		number_of_buckets = LIBVMDK_SHARED_CACHE_MAXIMUM_NUMBER_OF_BUCKETS;
+	}
+	internal_shared_cache = memory_allocate_structure(
+	                         libvmdk_internal_shared_cache_t );
+
+	if( internal_shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shared cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_shared_cache,
+	     0,
+	     sizeof( libvmdk_internal_shared_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shared cache.",
+		 function );
+
+		memory_free(
+		 internal_shared_cache );
+
+		return( -1 );
+	}
+	internal_shared_cache->buckets = (libvmdk_shared_cache_entry_t **) memory_allocate(
+	                                                                    sizeof( libvmdk_shared_cache_entry_t * ) * (size_t) number_of_buckets );
+
+	if( internal_shared_cache->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_shared_cache->buckets,
+	     0,
+	     sizeof( libvmdk_shared_cache_entry_t * ) * (size_t) number_of_buckets ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_shared_cache->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	internal_shared_cache->maximum_size      = maximum_size;
+	internal_shared_cache->number_of_buckets = (uint32_t) number_of_buckets;
+
+	*shared_cache = (libvmdk_shared_cache_t *) internal_shared_cache;
+
+	return( 1 );
+
+on_error:
+	if( internal_shared_cache != NULL )
+	{
+		if( internal_shared_cache->buckets != NULL )
+		{
+			memory_free(
+			 internal_shared_cache->buckets );
+		}
+		memory_free(
+		 internal_shared_cache );
+	}
+	return( -1 );
+}
+
+/* Frees a shared cache
+ * The shared cache should not be freed while it is used by a handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_shared_cache_free(
+     libvmdk_shared_cache_t **shared_cache,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_shared_cache_t *internal_shared_cache = NULL;
+	libvmdk_shared_cache_entry_t *entry                    = NULL;
+	libvmdk_shared_cache_entry_t *next_entry               = NULL;
+	libvmdk_shared_cache_image_t *image                    = NULL;
+	libvmdk_shared_cache_image_t *next_image               = NULL;
+	static char *function                                  = "libvmdk_shared_cache_free";
+	int result                                             = 1;
+
+	if( shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *shared_cache != NULL )
+	{
+		internal_shared_cache = (libvmdk_internal_shared_cache_t *) *shared_cache;
+		*shared_cache         = NULL;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( internal_shared_cache->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		entry = internal_shared_cache->first_entry;
+
+		while( entry != NULL )
+		{
+			next_entry = entry->next_entry;
+
+			if( entry->data != NULL )
+			{
+				memory_free(
+				 entry->data );
+			}
+			memory_free(
+			 entry );
+
+			entry = next_entry;
+		}
+		image = internal_shared_cache->first_image;
+
+		while( image != NULL )
+		{
+			next_image = image->next_image;
+
+			memory_free(
+			 image->image_identifier );
+
+			memory_free(
+			 image );
+
+			image = next_image;
+		}
+		memory_free(
+		 internal_shared_cache->buckets );
+
+		memory_free(
+		 internal_shared_cache );
+	}
+	return( result );
+}
+
+/* Retrieves the size of the cached data
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_shared_cache_get_size(
+     libvmdk_shared_cache_t *shared_cache,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_shared_cache_t *internal_shared_cache = NULL;
+	static char *function                                  = "libvmdk_shared_cache_get_size";
+
+	if( shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared cache.",
+		 function );
+
+		return( -1 );
+	}
+	internal_shared_cache = (libvmdk_internal_shared_cache_t *) shared_cache;
+
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_shared_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*size = internal_shared_cache->size;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_shared_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the cache statistics
+ * If image_identifier is NULL the statistics of all images are retrieved
+ * otherwise only those of the image with the corresponding image identifier
+ * Returns 1 if successful, 0 if the image is not registered or -1 on error
+ */
+int libvmdk_shared_cache_get_statistics(
+     libvmdk_shared_cache_t *shared_cache,
+     const uint8_t *image_identifier,
+     size_t image_identifier_size,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_shared_cache_t *internal_shared_cache = NULL;
+	libvmdk_shared_cache_image_t *image                    = NULL;
+	static char *function                                  = "libvmdk_shared_cache_get_statistics";
+	int result                                             = 1;
+
+	if( shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared cache.",
+		 function );
+
+		return( -1 );
+	}
+	internal_shared_cache = (libvmdk_internal_shared_cache_t *) shared_cache;
+
+	if( ( image_identifier != NULL )
+	 && ( ( image_identifier_size == 0 )
+	  ||  ( image_identifier_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid image identifier size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_shared_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( image_identifier == NULL )
+	{
+		*number_of_hits   = internal_shared_cache->number_of_hits;
+		*number_of_misses = internal_shared_cache->number_of_misses;
+	}
+	else
+	{
+		image = internal_shared_cache->first_image;
+
+		while( image != NULL )
+		{
+			if( ( image->image_identifier_size == image_identifier_size )
+			 && ( memory_compare(
+			       image->image_identifier,
+			       image_identifier,
+			       image_identifier_size ) == 0 ) )
+			{
+				break;
+			}
+			image = image->next_image;
+		}
+		if( image != NULL )
+		{
+			*number_of_hits   = image->number_of_hits;
+			*number_of_misses = image->number_of_misses;
+		}
+		else
+		{
+			result = 0;
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_shared_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the (disk) identifier of an image in the shared cache
+ * The image identifier is supplied by the caller and must uniquely identify
+ * the image data, for example the full path of the descriptor file.
+ * Distinct image identifiers are mapped onto distinct (disk) identifiers,
+ * hence the cached grain data of different images never collides
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_shared_cache_get_identifier(
+     libvmdk_shared_cache_t *shared_cache,
+     const uint8_t *image_identifier,
+     size_t image_identifier_size,
+     uint64_t *identifier,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_shared_cache_t *internal_shared_cache = NULL;
+	libvmdk_shared_cache_image_t *image                    = NULL;
+	static char *function                                  = "libvmdk_shared_cache_get_identifier";
+
+	if( shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared cache.",
+		 function );
+
+		return( -1 );
+	}
+	internal_shared_cache = (libvmdk_internal_shared_cache_t *) shared_cache;
+
+	if( image_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid image identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( image_identifier_size == 0 )
+	 || ( image_identifier_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid image identifier size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid identifier.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_shared_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	image = internal_shared_cache->first_image;
+
+	while( image != NULL )
+	{
+		if( ( image->image_identifier_size == image_identifier_size )
+		 && ( memory_compare(
+		       image->image_identifier,
+		       image_identifier,
+		       image_identifier_size ) == 0 ) )
+		{
+			break;
+		}
+		image = image->next_image;
+	}
+	if( image == NULL )
+	{
+		image = memory_allocate_structure(
+		         libvmdk_shared_cache_image_t );
+
+		if( image == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create image.",
+			 function );
+
+			goto on_error;
+		}
+		image->image_identifier = (uint8_t *) memory_allocate(
+		                                       sizeof( uint8_t ) * image_identifier_size );
+
+		if( image->image_identifier == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create image identifier.",
+			 function );
+
+			memory_free(
+			 image );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     image->image_identifier,
+		     image_identifier,
+		     image_identifier_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy image identifier.",
+			 function );
+
+			memory_free(
+			 image->image_identifier );
+			memory_free(
+			 image );
+
+			goto on_error;
+		}
+		internal_shared_cache->number_of_images += 1;
+
+		image->image_identifier_size = image_identifier_size;
+		image->identifier            = internal_shared_cache->number_of_images;
+		image->number_of_hits        = 0;
+		image->number_of_misses      = 0;
+		image->next_image            = internal_shared_cache->first_image;
+
+		internal_shared_cache->first_image = image;
+	}
+	*identifier = image->identifier;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_shared_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_shared_cache->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Removes and frees an entry
+ * This function needs to be called with the read/write lock grabbed for writing
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_shared_cache_remove_entry(
+     libvmdk_internal_shared_cache_t *internal_shared_cache,
+     libvmdk_shared_cache_entry_t *entry,
+     libcerror_error_t **error )
+{
+	libvmdk_shared_cache_entry_t *bucket_entry = NULL;
+	static char *function                      = "libvmdk_internal_shared_cache_remove_entry";
+	uint32_t bucket_index                      = 0;
+
+	if( internal_shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	bucket_index = (uint32_t) libvmdk_shared_cache_get_bucket_index(
+	                           entry->identifier,
+	                           entry->file_index,
+	                           entry->offset,
+	                           internal_shared_cache->number_of_buckets );
+
+	bucket_entry = internal_shared_cache->buckets[ bucket_index ];
+
+	if( bucket_entry == entry )
+	{
+		internal_shared_cache->buckets[ bucket_index ] = entry->next_in_bucket;
+	}
+	else
+	{
+		while( bucket_entry != NULL )
+		{
+			if( bucket_entry->next_in_bucket == entry )
+			{
+				bucket_entry->next_in_bucket = entry->next_in_bucket;
+
+				break;
+			}
+			bucket_entry = bucket_entry->next_in_bucket;
+		}
+	}
+	if( entry->previous_entry != NULL )
+	{
+		entry->previous_entry->next_entry = entry->next_entry;
+	}
+	else
+	{
+		internal_shared_cache->first_entry = entry->next_entry;
+	}
+	if( entry->next_entry != NULL )
+	{
+		entry->next_entry->previous_entry = entry->previous_entry;
+	}
+	else
+	{
+		internal_shared_cache->last_entry = entry->previous_entry;
+	}
+	internal_shared_cache->size -= entry->data_size;
+
+	if( entry->data != NULL )
+	{
+		memory_free(
+		 entry->data );
+	}
+	memory_free(
+	 entry );
+
+	return( 1 );
+}
+
+/* Retrieves cached data
+ * The data is copied so that the entry can be evicted by another handle afterwards
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvmdk_shared_cache_get_data(
+     libvmdk_shared_cache_t *shared_cache,
+     uint64_t identifier,
+     int file_index,
+     off64_t offset,
+     uint8_t *data,
+     size_t data_size,
+     size_t *cached_data_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_shared_cache_t *internal_shared_cache = NULL;
+	libvmdk_shared_cache_entry_t *entry                    = NULL;
+	libvmdk_shared_cache_image_t *image                    = NULL;
+	static char *function                                  = "libvmdk_shared_cache_get_data";
+	uint32_t bucket_index                                  = 0;
+	int result                                             = 0;
+
+	if( shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared cache.",
+		 function );
+
+		return( -1 );
+	}
+	internal_shared_cache = (libvmdk_internal_shared_cache_t *) shared_cache;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( cached_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cached data size.",
+		 function );
+
+		return( -1 );
+	}
+	bucket_index = (uint32_t) libvmdk_shared_cache_get_bucket_index(
+	                           identifier,
+	                           file_index,
+	                           offset,
+	                           internal_shared_cache->number_of_buckets );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	/* The write lock is needed since a cache hit changes the most recently used entry
+	 */
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_shared_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	entry = internal_shared_cache->buckets[ bucket_index ];
+
+	while( entry != NULL )
+	{
+		if( ( entry->identifier == identifier )
+		 && ( entry->file_index == file_index )
+		 && ( entry->offset == offset ) )
+		{
+			break;
+		}
+		entry = entry->next_in_bucket;
+	}
+	if( ( entry != NULL )
+	 && ( entry->data_size <= data_size ) )
+	{
+		if( memory_copy(
+		     data,
+		     entry->data,
+		     entry->data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			*cached_data_size = entry->data_size;
+
+			/* Move the entry to the front of the most recently used list
+			 */
+			if( entry->previous_entry != NULL )
+			{
+				entry->previous_entry->next_entry = entry->next_entry;
+
+				if( entry->next_entry != NULL )
+				{
+					entry->next_entry->previous_entry = entry->previous_entry;
+				}
+				else
+				{
+					internal_shared_cache->last_entry = entry->previous_entry;
+				}
+				entry->previous_entry = NULL;
+				entry->next_entry     = internal_shared_cache->first_entry;
+
+				internal_shared_cache->first_entry->previous_entry = entry;
+				internal_shared_cache->first_entry                 = entry;
+			}
+			result = 1;
+		}
+	}
+	if( result != -1 )
+	{
+		image = internal_shared_cache->first_image;
+
+		while( image != NULL )
+		{
+			if( image->identifier == identifier )
+			{
+				break;
+			}
+			image = image->next_image;
+		}
+		if( result == 1 )
+		{
+			internal_shared_cache->number_of_hits += 1;
+
+			if( image != NULL )
+			{
+				image->number_of_hits += 1;
+			}
+		}
+		else
+		{
+			internal_shared_cache->number_of_misses += 1;
+
+			if( image != NULL )
+			{
+				image->number_of_misses += 1;
+			}
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_shared_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets cached data
+ * The data is copied and the least recently used entries are evicted
+ * until the size of the cached data is within the maximum size
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_shared_cache_set_data(
+     libvmdk_shared_cache_t *shared_cache,
+     uint64_t identifier,
+     int file_index,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_shared_cache_t *internal_shared_cache = NULL;
+	libvmdk_shared_cache_entry_t *entry                    = NULL;
+	static char *function                                  = "libvmdk_shared_cache_set_data";
+	uint32_t bucket_index                                  = 0;
+	int result                                             = 1;
+
+	if( shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared cache.",
+		 function );
+
+		return( -1 );
+	}
+	internal_shared_cache = (libvmdk_internal_shared_cache_t *) shared_cache;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Data that does not fit in the cache is not cached
+	 */
+	if( (size64_t) data_size > internal_shared_cache->maximum_size )
+	{
+		return( 1 );
+	}
+	bucket_index = (uint32_t) libvmdk_shared_cache_get_bucket_index(
+	                           identifier,
+	                           file_index,
+	                           offset,
+	                           internal_shared_cache->number_of_buckets );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_shared_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	entry = internal_shared_cache->buckets[ bucket_index ];
+
+	while( entry != NULL )
+	{
+		if( ( entry->identifier == identifier )
+		 && ( entry->file_index == file_index )
+		 && ( entry->offset == offset ) )
+		{
+			break;
+		}
+		entry = entry->next_in_bucket;
+	}
+	/* Another handle could have cached the same data in the meantime
+	 */
+	if( entry != NULL )
+	{
+		if( libvmdk_internal_shared_cache_remove_entry(
+		     internal_shared_cache,
+		     entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove entry.",
+			 function );
+
+			result = -1;
+		}
+		entry = NULL;
+	}
+	while( ( result == 1 )
+	    && ( internal_shared_cache->last_entry != NULL )
+	    && ( ( internal_shared_cache->size + data_size ) > internal_shared_cache->maximum_size ) )
+	{
+		if( libvmdk_internal_shared_cache_remove_entry(
+		     internal_shared_cache,
+		     internal_shared_cache->last_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove least recently used entry.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		entry = memory_allocate_structure(
+		         libvmdk_shared_cache_entry_t );
+
+		if( entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entry.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		entry->data = (uint8_t *) memory_allocate(
+		                           sizeof( uint8_t ) * data_size );
+
+		if( entry->data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entry data.",
+			 function );
+
+			memory_free(
+			 entry );
+
+			entry  = NULL;
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( memory_copy(
+		     entry->data,
+		     data,
+		     data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data.",
+			 function );
+
+			memory_free(
+			 entry->data );
+			memory_free(
+			 entry );
+
+			entry  = NULL;
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		entry->identifier     = identifier;
+		entry->file_index     = file_index;
+		entry->offset         = offset;
+		entry->data_size      = data_size;
+		entry->next_in_bucket = internal_shared_cache->buckets[ bucket_index ];
+		entry->previous_entry = NULL;
+		entry->next_entry     = internal_shared_cache->first_entry;
+
+		if( internal_shared_cache->first_entry != NULL )
+		{
+			internal_shared_cache->first_entry->previous_entry = entry;
+		}
+		else
+		{
+			internal_shared_cache->last_entry = entry;
+		}
+		internal_shared_cache->first_entry             = entry;
+		internal_shared_cache->buckets[ bucket_index ] = entry;
+		internal_shared_cache->size                   += data_size;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_shared_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
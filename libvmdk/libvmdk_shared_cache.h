@@ -0,0 +1,216 @@
+/*
+ * Shared (grain) cache functions
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_SHARED_CACHE_H )
+#define _LIBVMDK_SHARED_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_extern.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcthreads.h"
+#include "libvmdk_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_shared_cache_entry libvmdk_shared_cache_entry_t;
+
+struct libvmdk_shared_cache_entry
+{
+	/* The (disk) identifier
+	 */
+	uint64_t identifier;
+
+	/* The file index
+	 */
+	int file_index;
+
+	/* The (physical) offset
+	 */
+	off64_t offset;
+
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The next entry in the same hash bucket
+	 */
+	libvmdk_shared_cache_entry_t *next_in_bucket;
+
+	/* The previous (more recently used) entry
+	 */
+	libvmdk_shared_cache_entry_t *previous_entry;
+
+	/* The next (less recently used) entry
+	 */
+	libvmdk_shared_cache_entry_t *next_entry;
+};
+
+typedef struct libvmdk_shared_cache_image libvmdk_shared_cache_image_t;
+
+struct libvmdk_shared_cache_image
+{
+	/* The image identifier
+	 */
+	uint8_t *image_identifier;
+
+	/* The image identifier size
+	 */
+	size_t image_identifier_size;
+
+	/* The (disk) identifier
+	 */
+	uint64_t identifier;
+
+	/* The number of cache hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of cache misses
+	 */
+	uint64_t number_of_misses;
+
+	/* The next image
+	 */
+	libvmdk_shared_cache_image_t *next_image;
+};
+
+typedef struct libvmdk_internal_shared_cache libvmdk_internal_shared_cache_t;
+
+struct libvmdk_internal_shared_cache
+{
+	/* The maximum size
+	 */
+	size64_t maximum_size;
+
+	/* The size of the cached data
+	 */
+	size64_t size;
+
+	/* The hash buckets
+	 */
+	libvmdk_shared_cache_entry_t **buckets;
+
+	/* The number of hash buckets
+	 */
+	uint32_t number_of_buckets;
+
+	/* The most recently used entry
+	 */
+	libvmdk_shared_cache_entry_t *first_entry;
+
+	/* The least recently used entry
+	 */
+	libvmdk_shared_cache_entry_t *last_entry;
+
+	/* The first registered image
+	 */
+	libvmdk_shared_cache_image_t *first_image;
+
+	/* The number of registered images
+	 */
+	uint64_t number_of_images;
+
+	/* The number of cache hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of cache misses
+	 */
+	uint64_t number_of_misses;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+LIBVMDK_EXTERN \
+int libvmdk_shared_cache_initialize(
+     libvmdk_shared_cache_t **shared_cache,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_shared_cache_free(
+     libvmdk_shared_cache_t **shared_cache,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_shared_cache_get_size(
+     libvmdk_shared_cache_t *shared_cache,
+     size64_t *size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_shared_cache_get_statistics(
+     libvmdk_shared_cache_t *shared_cache,
+     const uint8_t *image_identifier,
+     size_t image_identifier_size,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+int libvmdk_shared_cache_get_identifier(
+     libvmdk_shared_cache_t *shared_cache,
+     const uint8_t *image_identifier,
+     size_t image_identifier_size,
+     uint64_t *identifier,
+     libcerror_error_t **error );
+
+int libvmdk_internal_shared_cache_remove_entry(
+     libvmdk_internal_shared_cache_t *internal_shared_cache,
+     libvmdk_shared_cache_entry_t *entry,
+     libcerror_error_t **error );
+
+int libvmdk_shared_cache_get_data(
+     libvmdk_shared_cache_t *shared_cache,
+     uint64_t identifier,
+     int file_index,
+     off64_t offset,
+     uint8_t *data,
+     size_t data_size,
+     size_t *cached_data_size,
+     libcerror_error_t **error );
+
+int libvmdk_shared_cache_set_data(
+     libvmdk_shared_cache_t *shared_cache,
+     uint64_t identifier,
+     int file_index,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_SHARED_CACHE_H ) */
+
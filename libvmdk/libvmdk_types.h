@@ -36,10 +36,12 @@
 #if defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI )
 typedef struct libvmdk_extent_descriptor {}	libvmdk_extent_descriptor_t;
 typedef struct libvmdk_handle {}		libvmdk_handle_t;
+typedef struct libvmdk_shared_cache {}		libvmdk_shared_cache_t;
 
 #else
 typedef intptr_t libvmdk_extent_descriptor_t;
 typedef intptr_t libvmdk_handle_t;
+typedef intptr_t libvmdk_shared_cache_t;
 
 #endif /* defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI ) */
 
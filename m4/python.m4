@@ -104,6 +104,12 @@ AC_DEFUN([AX_PYTHON_CHECK],
       [ac_cv_header_python_h=no])
 
     CPPFLAGS="${BACKUP_CPPFLAGS}"
+
+    dnl Headers included in pyvmdk/pyvmdk_file_descriptor_io_handle.c
+    AC_CHECK_HEADERS([errno.h sys/stat.h unistd.h])
+
+    dnl File input/output functions used in pyvmdk/pyvmdk_file_descriptor_io_handle.c
+    AC_CHECK_FUNCS([dup pread])
   ])
 
   AS_IF(
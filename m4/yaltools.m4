@@ -93,6 +93,9 @@ AC_DEFUN([AX_VMDKTOOLS_CHECK_LOCAL],
     [AC_CHECK_FUNCS([clock_gettime getegid geteuid time])
   ])
 
+  dnl Headers included in vmdktools/serve_handle.c and vmdktools/nbd_connection.c
+  AC_CHECK_HEADERS([netinet/in.h sys/socket.h sys/un.h])
+
   AX_TOOLS_CHECK_ENABLE_MINGW_BINMODE
 ])
 
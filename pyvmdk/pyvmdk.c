@@ -32,6 +32,7 @@
 #include "pyvmdk_error.h"
 #include "pyvmdk_extent_descriptor.h"
 #include "pyvmdk_extent_descriptors.h"
+#include "pyvmdk_extent_map_run_flags.h"
 #include "pyvmdk_extent_types.h"
 #include "pyvmdk_file_object_io_handle.h"
 #include "pyvmdk_handle.h"
@@ -663,6 +664,28 @@ PyMODINIT_FUNC initpyvmdk(
 	 "extent_descriptors",
 	 (PyObject *) &pyvmdk_extent_descriptors_type_object );
 
+	/* Setup the extent_map_run_flags type object
+	 */
+	pyvmdk_extent_map_run_flags_type_object.tp_new = PyType_GenericNew;
+
+	if( pyvmdk_extent_map_run_flags_init_type(
+	     &pyvmdk_extent_map_run_flags_type_object ) != 1 )
+	{
+		goto on_error;
+	}
+	if( PyType_Ready(
+	     &pyvmdk_extent_map_run_flags_type_object ) < 0 )
+	{
+		goto on_error;
+	}
+	Py_IncRef(
+	 (PyObject *) &pyvmdk_extent_map_run_flags_type_object );
+
+	PyModule_AddObject(
+	 module,
+	 "extent_map_run_flags",
+	 (PyObject *) &pyvmdk_extent_map_run_flags_type_object );
+
 	/* Setup the extent_types type object
 	 */
 	pyvmdk_extent_types_type_object.tp_new = PyType_GenericNew;
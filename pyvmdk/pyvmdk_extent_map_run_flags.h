@@ -0,0 +1,63 @@
+/*
+ * Python object definition of the libvmdk extent map run flags
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _PYVMDK_EXTENT_MAP_RUN_FLAGS_H )
+#define _PYVMDK_EXTENT_MAP_RUN_FLAGS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "pyvmdk_libvmdk.h"
+#include "pyvmdk_python.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct pyvmdk_extent_map_run_flags pyvmdk_extent_map_run_flags_t;
+
+struct pyvmdk_extent_map_run_flags
+{
+	/* Python object initialization
+	 */
+	PyObject_HEAD
+};
+
+extern PyTypeObject pyvmdk_extent_map_run_flags_type_object;
+
+int pyvmdk_extent_map_run_flags_init_type(
+     PyTypeObject *type_object );
+
+PyObject *pyvmdk_extent_map_run_flags_new(
+           void );
+
+int pyvmdk_extent_map_run_flags_init(
+     pyvmdk_extent_map_run_flags_t *definitions_object );
+
+void pyvmdk_extent_map_run_flags_free(
+      pyvmdk_extent_map_run_flags_t *definitions_object );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _PYVMDK_EXTENT_MAP_RUN_FLAGS_H ) */
+
@@ -0,0 +1,1070 @@
+/*
+ * Python file descriptor IO handle functions
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "pyvmdk_error.h"
+#include "pyvmdk_file_descriptor_io_handle.h"
+#include "pyvmdk_integer.h"
+#include "pyvmdk_libbfio.h"
+#include "pyvmdk_libcerror.h"
+#include "pyvmdk_python.h"
+#include "pyvmdk_unused.h"
+
+#if defined( PYVMDK_HAVE_FILE_DESCRIPTOR_IO_HANDLE )
+
+/* Determines if a file object is an io.FileIO object or an io.BufferedReader or io.BufferedRandom object
+ * of an io.FileIO object. Other file objects that have a fileno method, such as compressed file objects,
+ * can return different data than the file descriptor contains
+ * Make sure to hold the GIL state before calling this function
+ * Returns 1 if the file object is a file IO object, 0 if not or -1 on error
+ */
+int pyvmdk_file_descriptor_is_file_io_object(
+     PyObject *file_object,
+     libcerror_error_t **error )
+{
+	PyObject *buffered_random_type = NULL;
+	PyObject *buffered_reader_type = NULL;
+	PyObject *file_io_type         = NULL;
+	PyObject *io_module            = NULL;
+	PyObject *method_result        = NULL;
+	PyObject *raw_object           = NULL;
+	static char *function          = "pyvmdk_file_descriptor_is_file_io_object";
+	int result                     = 0;
+
+	if( file_object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file object.",
+		 function );
+
+		return( -1 );
+	}
+#if PY_MAJOR_VERSION < 3
+	if( Py_TYPE( file_object ) == &PyFile_Type )
+	{
+		return( 1 );
+	}
+#endif
+	io_module = PyImport_ImportModule(
+	             "io" );
+
+	if( io_module == NULL )
+	{
+		pyvmdk_error_fetch(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to import io module.",
+		 function );
+
+		goto on_error;
+	}
+	file_io_type = PyObject_GetAttrString(
+	                io_module,
+	                "FileIO" );
+
+	buffered_reader_type = PyObject_GetAttrString(
+	                        io_module,
+	                        "BufferedReader" );
+
+	buffered_random_type = PyObject_GetAttrString(
+	                        io_module,
+	                        "BufferedRandom" );
+
+	if( ( file_io_type == NULL )
+	 || ( buffered_reader_type == NULL )
+	 || ( buffered_random_type == NULL ) )
+	{
+		pyvmdk_error_fetch(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO types from io module.",
+		 function );
+
+		goto on_error;
+	}
+	/* Subclasses are not supported since they can override how data is read
+	 */
+	if( (PyObject *) Py_TYPE( file_object ) == file_io_type )
+	{
+		result = 1;
+	}
+	else if( ( (PyObject *) Py_TYPE( file_object ) == buffered_reader_type )
+	      || ( (PyObject *) Py_TYPE( file_object ) == buffered_random_type ) )
+	{
+		raw_object = PyObject_GetAttrString(
+		              file_object,
+		              "raw" );
+
+		if( raw_object == NULL )
+		{
+			PyErr_Clear();
+		}
+		else if( (PyObject *) Py_TYPE( raw_object ) == file_io_type )
+		{
+			result = 1;
+		}
+		/* Data written to a buffered random object is only visible
+		 * through the file descriptor after the buffer is flushed
+		 */
+		if( ( result != 0 )
+		 && ( (PyObject *) Py_TYPE( file_object ) == buffered_random_type ) )
+		{
+			method_result = PyObject_CallMethod(
+			                 file_object,
+			                 "flush",
+			                 NULL );
+
+			if( method_result == NULL )
+			{
+				PyErr_Clear();
+
+				result = 0;
+			}
+		}
+	}
+	if( method_result != NULL )
+	{
+		Py_DecRef(
+		 method_result );
+	}
+	if( raw_object != NULL )
+	{
+		Py_DecRef(
+		 raw_object );
+	}
+	Py_DecRef(
+	 buffered_random_type );
+	Py_DecRef(
+	 buffered_reader_type );
+	Py_DecRef(
+	 file_io_type );
+	Py_DecRef(
+	 io_module );
+
+	return( result );
+
+on_error:
+	if( buffered_random_type != NULL )
+	{
+		Py_DecRef(
+		 buffered_random_type );
+	}
+	if( buffered_reader_type != NULL )
+	{
+		Py_DecRef(
+		 buffered_reader_type );
+	}
+	if( file_io_type != NULL )
+	{
+		Py_DecRef(
+		 file_io_type );
+	}
+	if( io_module != NULL )
+	{
+		Py_DecRef(
+		 io_module );
+	}
+	return( -1 );
+}
+
+#endif /* defined( PYVMDK_HAVE_FILE_DESCRIPTOR_IO_HANDLE ) */
+
+/* Retrieves the file descriptor of a file object
+ * Only file descriptors of io.FileIO based file objects of regular files are retrieved,
+ * since these support positional reads and contain the same data as the file object
+ * Make sure to hold the GIL state before calling this function
+ * Returns 1 if successful, 0 if the file object is not backed by a regular file or -1 on error
+ */
+int pyvmdk_file_descriptor_get_from_file_object(
+     PyObject *file_object,
+     int *file_descriptor,
+     libcerror_error_t **error )
+{
+#if defined( PYVMDK_HAVE_FILE_DESCRIPTOR_IO_HANDLE )
+	struct stat file_statistics;
+
+	PyObject *method_name        = NULL;
+	PyObject *method_result      = NULL;
+	int64_t safe_file_descriptor = 0;
+#endif
+	static char *function        = "pyvmdk_file_descriptor_get_from_file_object";
+	int result                   = 0;
+
+	if( file_object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file object.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( PYVMDK_HAVE_FILE_DESCRIPTOR_IO_HANDLE )
+	result = pyvmdk_file_descriptor_is_file_io_object(
+	          file_object,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if file object is a file IO object.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+#if PY_MAJOR_VERSION >= 3
+	method_name = PyUnicode_FromString(
+	               "fileno" );
+#else
+	method_name = PyString_FromString(
+	               "fileno" );
+#endif
+	PyErr_Clear();
+
+	/* Determine if the file object has the fileno method
+	 */
+	result = PyObject_HasAttr(
+	          file_object,
+	          method_name );
+
+	if( result != 0 )
+	{
+		method_result = PyObject_CallMethodObjArgs(
+		                 file_object,
+		                 method_name,
+		                 NULL );
+
+		/* File objects that are not backed by a file descriptor, such as io.BytesIO,
+		 * raise io.UnsupportedOperation
+		 */
+		if( PyErr_Occurred() )
+		{
+			PyErr_Clear();
+
+			result = 0;
+		}
+		else if( method_result == NULL )
+		{
+			result = 0;
+		}
+		else if( pyvmdk_integer_signed_copy_to_64bit(
+		          method_result,
+		          &safe_file_descriptor,
+		          NULL ) != 1 )
+		{
+			PyErr_Clear();
+
+			result = 0;
+		}
+		else if( ( safe_file_descriptor < 0 )
+		      || ( safe_file_descriptor > (int64_t) INT_MAX ) )
+		{
+			result = 0;
+		}
+	}
+	if( result != 0 )
+	{
+		if( fstat(
+		     (int) safe_file_descriptor,
+		     &file_statistics ) != 0 )
+		{
+			result = 0;
+		}
+		else if( S_ISREG( file_statistics.st_mode ) == 0 )
+		{
+			result = 0;
+		}
+	}
+	if( result != 0 )
+	{
+		*file_descriptor = (int) safe_file_descriptor;
+	}
+	if( method_result != NULL )
+	{
+		Py_DecRef(
+		 method_result );
+	}
+	Py_DecRef(
+	 method_name );
+
+#endif /* defined( PYVMDK_HAVE_FILE_DESCRIPTOR_IO_HANDLE ) */
+
+	return( result );
+}
+
+/* Initializes a file descriptor based handle of a file object
+ * Make sure to hold the GIL state before calling this function
+ * Returns 1 if successful, 0 if the file object is not backed by a regular file or -1 on error
+ */
+int pyvmdk_file_descriptor_initialize_from_file_object(
+     libbfio_handle_t **handle,
+     PyObject *file_object,
+     libcerror_error_t **error )
+{
+	static char *function = "pyvmdk_file_descriptor_initialize_from_file_object";
+	int file_descriptor   = -1;
+	int result            = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = pyvmdk_file_descriptor_get_from_file_object(
+	          file_object,
+	          &file_descriptor,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file descriptor from file object.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( PYVMDK_HAVE_FILE_DESCRIPTOR_IO_HANDLE )
+	else if( result != 0 )
+	{
+		if( pyvmdk_file_descriptor_initialize(
+		     handle,
+		     file_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file descriptor handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( result );
+}
+
+#if defined( PYVMDK_HAVE_FILE_DESCRIPTOR_IO_HANDLE )
+
+/* Creates a file descriptor IO handle
+ * The file descriptor is duplicated so that the IO handle does not depend on the lifetime of the file object
+ * The IO handle is not allocated with PyMem_Malloc, since it can be cloned and freed without the GIL state being held
+ * Make sure the value file_descriptor_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int pyvmdk_file_descriptor_io_handle_initialize(
+     pyvmdk_file_descriptor_io_handle_t **file_descriptor_io_handle,
+     int file_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "pyvmdk_file_descriptor_io_handle_initialize";
+
+	if( file_descriptor_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_descriptor_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file descriptor IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file descriptor value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	*file_descriptor_io_handle = memory_allocate_structure(
+	                              pyvmdk_file_descriptor_io_handle_t );
+
+	if( *file_descriptor_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file descriptor IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_descriptor_io_handle,
+	     0,
+	     sizeof( pyvmdk_file_descriptor_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file descriptor IO handle.",
+		 function );
+
+		memory_free(
+		 *file_descriptor_io_handle );
+
+		*file_descriptor_io_handle = NULL;
+
+		return( -1 );
+	}
+	( *file_descriptor_io_handle )->file_descriptor = dup(
+	                                                   file_descriptor );
+
+	if( ( *file_descriptor_io_handle )->file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to duplicate file descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *file_descriptor_io_handle != NULL )
+	{
+		memory_free(
+		 *file_descriptor_io_handle );
+
+		*file_descriptor_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Initializes the file descriptor IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int pyvmdk_file_descriptor_initialize(
+     libbfio_handle_t **handle,
+     int file_descriptor,
+     libcerror_error_t **error )
+{
+	pyvmdk_file_descriptor_io_handle_t *file_descriptor_io_handle = NULL;
+	static char *function                                         = "pyvmdk_file_descriptor_initialize";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( pyvmdk_file_descriptor_io_handle_initialize(
+	     &file_descriptor_io_handle,
+	     file_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file descriptor IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     handle,
+	     (intptr_t *) file_descriptor_io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) pyvmdk_file_descriptor_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) pyvmdk_file_descriptor_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) pyvmdk_file_descriptor_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) pyvmdk_file_descriptor_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) pyvmdk_file_descriptor_io_handle_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) pyvmdk_file_descriptor_io_handle_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) pyvmdk_file_descriptor_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) pyvmdk_file_descriptor_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) pyvmdk_file_descriptor_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) pyvmdk_file_descriptor_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_descriptor_io_handle != NULL )
+	{
+		pyvmdk_file_descriptor_io_handle_free(
+		 &file_descriptor_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a file descriptor IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int pyvmdk_file_descriptor_io_handle_free(
+     pyvmdk_file_descriptor_io_handle_t **file_descriptor_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "pyvmdk_file_descriptor_io_handle_free";
+	int result            = 1;
+
+	if( file_descriptor_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_descriptor_io_handle != NULL )
+	{
+		if( ( *file_descriptor_io_handle )->file_descriptor != -1 )
+		{
+			if( close(
+			     ( *file_descriptor_io_handle )->file_descriptor ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 errno,
+				 "%s: unable to close file descriptor.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *file_descriptor_io_handle );
+
+		*file_descriptor_io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the file descriptor IO handle and its attributes
+ * Returns 1 if successful or -1 on error
+ */
+int pyvmdk_file_descriptor_io_handle_clone(
+     pyvmdk_file_descriptor_io_handle_t **destination_file_descriptor_io_handle,
+     pyvmdk_file_descriptor_io_handle_t *source_file_descriptor_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "pyvmdk_file_descriptor_io_handle_clone";
+
+	if( destination_file_descriptor_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination file descriptor IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_file_descriptor_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination file descriptor IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_file_descriptor_io_handle == NULL )
+	{
+		*destination_file_descriptor_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( pyvmdk_file_descriptor_io_handle_initialize(
+	     destination_file_descriptor_io_handle,
+	     source_file_descriptor_io_handle->file_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file descriptor IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens the file descriptor IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int pyvmdk_file_descriptor_io_handle_open(
+     pyvmdk_file_descriptor_io_handle_t *file_descriptor_io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "pyvmdk_file_descriptor_io_handle_open";
+
+	if( file_descriptor_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported.",
+		 function );
+
+		return( -1 );
+	}
+	/* No need to do anything here, because the file descriptor is already open
+	 */
+	file_descriptor_io_handle->access_flags   = access_flags;
+	file_descriptor_io_handle->current_offset = 0;
+
+	return( 1 );
+}
+
+/* Closes the file descriptor IO handle
+ * Returns 0 if successful or -1 on error
+ */
+int pyvmdk_file_descriptor_io_handle_close(
+     pyvmdk_file_descriptor_io_handle_t *file_descriptor_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "pyvmdk_file_descriptor_io_handle_close";
+
+	if( file_descriptor_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The duplicated file descriptor is closed when the IO handle is freed
+	 */
+	file_descriptor_io_handle->access_flags = 0;
+
+	return( 0 );
+}
+
+/* Reads a buffer from the file descriptor IO handle
+ * This function does not require the GIL state to be held
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t pyvmdk_file_descriptor_io_handle_read(
+         pyvmdk_file_descriptor_io_handle_t *file_descriptor_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "pyvmdk_file_descriptor_io_handle_read";
+	ssize_t read_count    = 0;
+
+	if( file_descriptor_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* A positional read is used so that the file position of the file object is not changed
+	 */
+	do
+	{
+		read_count = pread(
+		              file_descriptor_io_handle->file_descriptor,
+		              (void *) buffer,
+		              size,
+		              (off_t) file_descriptor_io_handle->current_offset );
+	}
+	while( ( read_count == -1 )
+	    && ( errno == EINTR ) );
+
+	if( read_count < 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 errno,
+		 "%s: unable to read from file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	file_descriptor_io_handle->current_offset += (off64_t) read_count;
+
+	return( read_count );
+}
+
+/* Writes a buffer to the file descriptor IO handle
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t pyvmdk_file_descriptor_io_handle_write(
+         pyvmdk_file_descriptor_io_handle_t *file_descriptor_io_handle,
+         const uint8_t *buffer PYVMDK_ATTRIBUTE_UNUSED,
+         size_t size PYVMDK_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error )
+{
+	static char *function = "pyvmdk_file_descriptor_io_handle_write";
+
+	PYVMDK_UNREFERENCED_PARAMETER( buffer )
+	PYVMDK_UNREFERENCED_PARAMETER( size )
+
+	if( file_descriptor_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: write access currently not supported.",
+	 function );
+
+	return( -1 );
+}
+
+/* Seeks a certain offset within the file descriptor IO handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t pyvmdk_file_descriptor_io_handle_seek_offset(
+         pyvmdk_file_descriptor_io_handle_t *file_descriptor_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "pyvmdk_file_descriptor_io_handle_seek_offset";
+	size64_t size         = 0;
+
+	if( file_descriptor_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += file_descriptor_io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		if( pyvmdk_file_descriptor_io_handle_get_size(
+		     file_descriptor_io_handle,
+		     &size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size.",
+			 function );
+
+			return( -1 );
+		}
+		offset += (off64_t) size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	file_descriptor_io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if a file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int pyvmdk_file_descriptor_io_handle_exists(
+     pyvmdk_file_descriptor_io_handle_t *file_descriptor_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "pyvmdk_file_descriptor_io_handle_exists";
+
+	if( file_descriptor_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor_io_handle->file_descriptor == -1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Check if the file is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int pyvmdk_file_descriptor_io_handle_is_open(
+     pyvmdk_file_descriptor_io_handle_t *file_descriptor_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "pyvmdk_file_descriptor_io_handle_is_open";
+
+	if( file_descriptor_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor_io_handle->file_descriptor == -1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the file size
+ * Returns 1 if successful or -1 on error
+ */
+int pyvmdk_file_descriptor_io_handle_get_size(
+     pyvmdk_file_descriptor_io_handle_t *file_descriptor_io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "pyvmdk_file_descriptor_io_handle_get_size";
+
+	if( file_descriptor_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( fstat(
+	     file_descriptor_io_handle->file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		return( -1 );
+	}
+	*size = (size64_t) file_statistics.st_size;
+
+	return( 1 );
+}
+
+#endif /* defined( PYVMDK_HAVE_FILE_DESCRIPTOR_IO_HANDLE ) */
+
@@ -22,6 +22,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "pyvmdk_file_descriptor_io_handle.h"
 #include "pyvmdk_file_object_io_handle.h"
 #include "pyvmdk_file_objects_io_pool.h"
 #include "pyvmdk_integer.h"
@@ -153,10 +154,19 @@ int pyvmdk_file_objects_pool_initialize(
 
 			goto on_error;
 		}
-		if( pyvmdk_file_object_initialize(
-		     &file_io_handle,
-		     file_object,
-		     error ) != 1 )
+		result = pyvmdk_file_descriptor_initialize_from_file_object(
+		          &file_io_handle,
+		          file_object,
+		          error );
+
+		if( result == 0 )
+		{
+			result = pyvmdk_file_object_initialize(
+			          &file_io_handle,
+			          file_object,
+			          error );
+		}
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
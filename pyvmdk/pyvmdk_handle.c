@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( HAVE_WINAPI )
@@ -29,6 +30,7 @@
 #include "pyvmdk_error.h"
 #include "pyvmdk_extent_descriptor.h"
 #include "pyvmdk_extent_descriptors.h"
+#include "pyvmdk_file_descriptor_io_handle.h"
 #include "pyvmdk_file_object_io_handle.h"
 #include "pyvmdk_file_objects_io_pool.h"
 #include "pyvmdk_handle.h"
@@ -123,10 +125,31 @@ PyMethodDef pyvmdk_handle_object_methods[] = {
 	  "\n"
 	  "Reads a buffer of data at a specific offset." },
 
+	{ "read_buffer_into",
+	  (PyCFunction) pyvmdk_handle_read_buffer_into,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "read_buffer_into(buffer) -> Integer\n"
+	  "\n"
+	  "Reads data into a writable buffer object and returns the number of bytes read." },
+
+	{ "read_buffer_at_offset_into",
+	  (PyCFunction) pyvmdk_handle_read_buffer_at_offset_into,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "read_buffer_at_offset_into(buffer, offset) -> Integer\n"
+	  "\n"
+	  "Reads data at a specific offset into a writable buffer object and returns the number of bytes read." },
+
+	{ "read_ranges",
+	  (PyCFunction) pyvmdk_handle_read_ranges,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "read_ranges(ranges) -> List of strings\n"
+	  "\n"
+	  "Reads multiple ranges of data, where ranges is a sequence of (offset, size) tuples." },
+
 	{ "seek_offset",
 	  (PyCFunction) pyvmdk_handle_seek_offset,
 	  METH_VARARGS | METH_KEYWORDS,
-	  "seek_offset(offset, whence) -> None\n"
+	  "seek_offset(offset, whence) -> Integer\n"
 	  "\n"
 	  "Seeks an offset within the data." },
 
@@ -146,10 +169,31 @@ PyMethodDef pyvmdk_handle_object_methods[] = {
 	  "\n"
 	  "Reads a buffer of data." },
 
+	{ "readinto",
+	  (PyCFunction) pyvmdk_handle_read_buffer_into,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "readinto(buffer) -> Integer\n"
+	  "\n"
+	  "Reads data into a writable buffer object and returns the number of bytes read." },
+
+	{ "readable",
+	  (PyCFunction) pyvmdk_handle_readable,
+	  METH_NOARGS,
+	  "readable() -> Boolean\n"
+	  "\n"
+	  "Determines if the data can be read." },
+
+	{ "seekable",
+	  (PyCFunction) pyvmdk_handle_seekable,
+	  METH_NOARGS,
+	  "seekable() -> Boolean\n"
+	  "\n"
+	  "Determines if the data supports random access." },
+
 	{ "seek",
 	  (PyCFunction) pyvmdk_handle_seek_offset,
 	  METH_VARARGS | METH_KEYWORDS,
-	  "seek(offset, whence) -> None\n"
+	  "seek(offset, whence) -> Integer\n"
 	  "\n"
 	  "Seeks an offset within the data." },
 
@@ -213,12 +257,41 @@ PyMethodDef pyvmdk_handle_object_methods[] = {
 	  "\n"
 	  "Retrieves a specific extent descriptor" },
 
+	/* Functions to access the extent map */
+
+	{ "get_extent_map",
+	  (PyCFunction) pyvmdk_handle_get_extent_map,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "get_extent_map(offset, size) -> Tuple of arrays\n"
+	  "\n"
+	  "Retrieves the extent map, without reading the media data, as a tuple of\n"
+	  "(offsets, sizes, layers, extent indexes, physical offsets, flags) arrays\n"
+	  "of 64-bit signed integers, with a value per run in each array.\n"
+	  "The layer is 0 for the image itself and 1 or more for its parents.\n"
+	  "The flags contain the extent map run flags. By default the map of all media data is retrieved." },
+
+	{ "get_allocated_ranges",
+	  (PyCFunction) pyvmdk_handle_get_allocated_ranges,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "get_allocated_ranges(offset, size) -> Tuple of arrays\n"
+	  "\n"
+	  "Retrieves the ranges of media data that are stored in the image or its parents,\n"
+	  "without reading the media data, as a tuple of (offsets, sizes) arrays of 64-bit\n"
+	  "signed integers, with a value per range in each array.\n"
+	  "By default the ranges of all media data are retrieved." },
+
 	/* Sentinel */
 	{ NULL, NULL, 0, NULL }
 };
 
 PyGetSetDef pyvmdk_handle_object_get_set_definitions[] = {
 
+	{ "closed",
+	  (getter) pyvmdk_handle_get_closed,
+	  (setter) 0,
+	  "Value to indicate the handle is closed.",
+	  NULL },
+
 	{ "disk_type",
 	  (getter) pyvmdk_handle_get_disk_type,
 	  (setter) 0,
@@ -381,6 +454,7 @@ int pyvmdk_handle_init(
 	pyvmdk_handle->handle         = NULL;
 	pyvmdk_handle->file_io_handle = NULL;
 	pyvmdk_handle->file_io_pool   = NULL;
+	pyvmdk_handle->is_open        = 0;
 
 	if( libvmdk_handle_initialize(
 	     &( pyvmdk_handle->handle ),
@@ -684,6 +758,8 @@ PyObject *pyvmdk_handle_open(
 
 			return( NULL );
 		}
+		pyvmdk_handle->is_open = 1;
+
 		Py_IncRef(
 		 Py_None );
 
@@ -841,10 +917,22 @@ PyObject *pyvmdk_handle_open_file_object(
 
 		goto on_error;
 	}
-	if( pyvmdk_file_object_initialize(
-	     &( pyvmdk_handle->file_io_handle ),
-	     file_object,
-	     &error ) != 1 )
+	/* File objects backed by a regular file are read using the file descriptor
+	 * so that reads do not require the GIL
+	 */
+	result = pyvmdk_file_descriptor_initialize_from_file_object(
+	          &( pyvmdk_handle->file_io_handle ),
+	          file_object,
+	          &error );
+
+	if( result == 0 )
+	{
+		result = pyvmdk_file_object_initialize(
+		          &( pyvmdk_handle->file_io_handle ),
+		          file_object,
+		          &error );
+	}
+	if( result != 1 )
 	{
 		pyvmdk_error_raise(
 		 error,
@@ -880,6 +968,8 @@ PyObject *pyvmdk_handle_open_file_object(
 
 		goto on_error;
 	}
+	pyvmdk_handle->is_open = 1;
+
 	Py_IncRef(
 	 Py_None );
 
@@ -1137,6 +1227,8 @@ PyObject *pyvmdk_handle_close(
 
 		return( NULL );
 	}
+	pyvmdk_handle->is_open = 0;
+
 	if( pyvmdk_handle->file_io_handle != NULL )
 	{
 		Py_BEGIN_ALLOW_THREADS
@@ -1435,19 +1527,20 @@ PyObject *pyvmdk_handle_read_buffer_at_offset(
 	return( string_object );
 }
 
-/* Seeks a certain offset in the data
+/* Reads data at the current offset into a writable buffer object
  * Returns a Python object if successful or NULL on error
  */
-PyObject *pyvmdk_handle_seek_offset(
+PyObject *pyvmdk_handle_read_buffer_into(
            pyvmdk_handle_t *pyvmdk_handle,
            PyObject *arguments,
            PyObject *keywords )
 {
+	Py_buffer buffer_view;
+
 	libcerror_error_t *error    = NULL;
-	static char *function       = "pyvmdk_handle_seek_offset";
-	static char *keyword_list[] = { "offset", "whence", NULL };
-	off64_t offset              = 0;
-	int whence                  = 0;
+	static char *function       = "pyvmdk_handle_read_buffer_into";
+	static char *keyword_list[] = { "buffer", NULL };
+	ssize_t read_count          = 0;
 
 	if( pyvmdk_handle == NULL )
 	{
@@ -1458,32 +1551,36 @@ PyObject *pyvmdk_handle_seek_offset(
 
 		return( NULL );
 	}
+	/* The data is read directly into the memory of the buffer object
+	 */
 	if( PyArg_ParseTupleAndKeywords(
 	     arguments,
 	     keywords,
-	     "L|i",
+	     "w*",
 	     keyword_list,
-	     &offset,
-	     &whence ) == 0 )
+	     &buffer_view ) == 0 )
 	{
 		return( NULL );
 	}
 	Py_BEGIN_ALLOW_THREADS
 
-	offset = libvmdk_handle_seek_offset(
-	          pyvmdk_handle->handle,
-	          offset,
-	          whence,
-	          &error );
+	read_count = libvmdk_handle_read_buffer(
+	              pyvmdk_handle->handle,
+	              (uint8_t *) buffer_view.buf,
+	              (size_t) buffer_view.len,
+	              &error );
 
 	Py_END_ALLOW_THREADS
 
- 	if( offset == -1 )
+	PyBuffer_Release(
+	 &buffer_view );
+
+	if( read_count <= -1 )
 	{
 		pyvmdk_error_raise(
 		 error,
 		 PyExc_IOError,
-		 "%s: unable to seek offset.",
+		 "%s: unable to read data.",
 		 function );
 
 		libcerror_error_free(
@@ -1491,26 +1588,25 @@ PyObject *pyvmdk_handle_seek_offset(
 
 		return( NULL );
 	}
-	Py_IncRef(
-	 Py_None );
-
-	return( Py_None );
+	return( pyvmdk_integer_signed_new_from_64bit(
+	         (int64_t) read_count ) );
 }
 
-/* Retrieves the current offset in the data
+/* Reads data at a specific offset into a writable buffer object
  * Returns a Python object if successful or NULL on error
  */
-PyObject *pyvmdk_handle_get_offset(
+PyObject *pyvmdk_handle_read_buffer_at_offset_into(
            pyvmdk_handle_t *pyvmdk_handle,
-           PyObject *arguments PYVMDK_ATTRIBUTE_UNUSED )
+           PyObject *arguments,
+           PyObject *keywords )
 {
-	libcerror_error_t *error = NULL;
-	PyObject *integer_object = NULL;
-	static char *function    = "pyvmdk_handle_get_offset";
-	off64_t current_offset   = 0;
-	int result               = 0;
+	Py_buffer buffer_view;
 
-	PYVMDK_UNREFERENCED_PARAMETER( arguments )
+	libcerror_error_t *error    = NULL;
+	static char *function       = "pyvmdk_handle_read_buffer_at_offset_into";
+	static char *keyword_list[] = { "buffer", "offset", NULL };
+	off64_t read_offset         = 0;
+	ssize_t read_count          = 0;
 
 	if( pyvmdk_handle == NULL )
 	{
@@ -1521,21 +1617,48 @@ PyObject *pyvmdk_handle_get_offset(
 
 		return( NULL );
 	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "w*L",
+	     keyword_list,
+	     &buffer_view,
+	     &read_offset ) == 0 )
+	{
+		return( NULL );
+	}
+	if( read_offset < 0 )
+	{
+		PyBuffer_Release(
+		 &buffer_view );
+
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument read offset value less than zero.",
+		 function );
+
+		return( NULL );
+	}
 	Py_BEGIN_ALLOW_THREADS
 
-	result = libvmdk_handle_get_offset(
-	          pyvmdk_handle->handle,
-	          &current_offset,
-	          &error );
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              pyvmdk_handle->handle,
+	              (uint8_t *) buffer_view.buf,
+	              (size_t) buffer_view.len,
+	              (off64_t) read_offset,
+	              &error );
 
 	Py_END_ALLOW_THREADS
 
-	if( result != 1 )
+	PyBuffer_Release(
+	 &buffer_view );
+
+	if( read_count <= -1 )
 	{
 		pyvmdk_error_raise(
 		 error,
 		 PyExc_IOError,
-		 "%s: unable to retrieve offset.",
+		 "%s: unable to read data.",
 		 function );
 
 		libcerror_error_free(
@@ -1543,26 +1666,35 @@ PyObject *pyvmdk_handle_get_offset(
 
 		return( NULL );
 	}
-	integer_object = pyvmdk_integer_signed_new_from_64bit(
-	                  (int64_t) current_offset );
-
-	return( integer_object );
+	return( pyvmdk_integer_signed_new_from_64bit(
+	         (int64_t) read_count ) );
 }
 
-/* Retrieves the disk type
+/* Reads multiple ranges of data
  * Returns a Python object if successful or NULL on error
  */
-PyObject *pyvmdk_handle_get_disk_type(
+PyObject *pyvmdk_handle_read_ranges(
            pyvmdk_handle_t *pyvmdk_handle,
-           PyObject *arguments PYVMDK_ATTRIBUTE_UNUSED )
+           PyObject *arguments,
+           PyObject *keywords )
 {
-	libcerror_error_t *error = NULL;
-	PyObject *integer_object = NULL;
-	static char *function    = "pyvmdk_handle_get_disk_type";
-	int result               = 0;
-	int disk_type            = 0;
-
-	PYVMDK_UNREFERENCED_PARAMETER( arguments )
+	PyObject **string_objects   = NULL;
+	PyObject *list_object       = NULL;
+	PyObject *range_object      = NULL;
+	PyObject *sequence_object   = NULL;
+	libcerror_error_t *error    = NULL;
+	static char *function       = "pyvmdk_handle_read_ranges";
+	static char *keyword_list[] = { "ranges", NULL };
+	void **buffers              = NULL;
+	size_t *buffer_sizes        = NULL;
+	off64_t *offsets            = NULL;
+	ssize_t *read_counts        = NULL;
+	Py_ssize_t sequence_size    = 0;
+	off64_t read_offset         = 0;
+	int number_of_ranges        = 0;
+	int range_index             = 0;
+	int read_size               = 0;
+	int result                  = 0;
 
 	if( pyvmdk_handle == NULL )
 	{
@@ -1573,67 +1705,178 @@ PyObject *pyvmdk_handle_get_disk_type(
 
 		return( NULL );
 	}
-	Py_BEGIN_ALLOW_THREADS
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "O",
+	     keyword_list,
+	     &sequence_object ) == 0 )
+	{
+		return( NULL );
+	}
+	if( PySequence_Check(
+	     sequence_object ) == 0 )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: unsupported ranges - expected a sequence of (offset, size) tuples.",
+		 function );
 
-	result = libvmdk_handle_get_disk_type(
-	          pyvmdk_handle->handle,
-	          &disk_type,
-	          &error );
+		return( NULL );
+	}
+	sequence_size = PySequence_Size(
+	                 sequence_object );
 
-	Py_END_ALLOW_THREADS
+	if( ( sequence_size < 0 )
+	 || ( sequence_size > (Py_ssize_t) INT_MAX ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid number of ranges value out of bounds.",
+		 function );
 
-	if( result != 1 )
+		return( NULL );
+	}
+	number_of_ranges = (int) sequence_size;
+
+	list_object = PyList_New(
+	               (Py_ssize_t) number_of_ranges );
+
+	if( list_object == NULL )
 	{
-		pyvmdk_error_raise(
-		 error,
-		 PyExc_IOError,
-		 "%s: unable to retrieve disk type.",
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create list object.",
 		 function );
 
-		libcerror_error_free(
-		 &error );
+		goto on_error;
+	}
+	if( number_of_ranges == 0 )
+	{
+		return( list_object );
+	}
+	string_objects = (PyObject **) PyMem_Malloc(
+	                                sizeof( PyObject * ) * number_of_ranges );
 
-		return( NULL );
+	if( string_objects != NULL )
+	{
+		for( range_index = 0;
+		     range_index < number_of_ranges;
+		     range_index++ )
+		{
+			string_objects[ range_index ] = NULL;
+		}
 	}
-#if PY_MAJOR_VERSION >= 3
-	integer_object = PyLong_FromLong(
-	                  (long) disk_type );
-#else
-	integer_object = PyInt_FromLong(
-	                  (long) disk_type );
-#endif
-	return( integer_object );
-}
+	buffers = (void **) PyMem_Malloc(
+	                     sizeof( void * ) * number_of_ranges );
 
-/* Retrieves the media size
- * Returns a Python object if successful or NULL on error
- */
-PyObject *pyvmdk_handle_get_media_size(
-           pyvmdk_handle_t *pyvmdk_handle,
-           PyObject *arguments PYVMDK_ATTRIBUTE_UNUSED )
-{
-	libcerror_error_t *error = NULL;
-	PyObject *integer_object = NULL;
-	static char *function    = "pyvmdk_handle_get_media_size";
-	size64_t media_size      = 0;
-	int result               = 0;
+	buffer_sizes = (size_t *) PyMem_Malloc(
+	                           sizeof( size_t ) * number_of_ranges );
 
-	PYVMDK_UNREFERENCED_PARAMETER( arguments )
+	offsets = (off64_t *) PyMem_Malloc(
+	                       sizeof( off64_t ) * number_of_ranges );
 
-	if( pyvmdk_handle == NULL )
+	read_counts = (ssize_t *) PyMem_Malloc(
+	                           sizeof( ssize_t ) * number_of_ranges );
+
+	if( ( string_objects == NULL )
+	 || ( buffers == NULL )
+	 || ( buffer_sizes == NULL )
+	 || ( offsets == NULL )
+	 || ( read_counts == NULL ) )
 	{
 		PyErr_Format(
-		 PyExc_TypeError,
-		 "%s: invalid handle.",
+		 PyExc_MemoryError,
+		 "%s: unable to create ranges.",
 		 function );
 
-		return( NULL );
+		goto on_error;
+	}
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		range_object = PySequence_GetItem(
+		                sequence_object,
+		                (Py_ssize_t) range_index );
+
+		if( range_object == NULL )
+		{
+			PyErr_Format(
+			 PyExc_ValueError,
+			 "%s: missing range: %d.",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+		result = PyArg_ParseTuple(
+		          range_object,
+		          "Li",
+		          &read_offset,
+		          &read_size );
+
+		/* Remove the reference created by PySequence_GetItem
+		 */
+		Py_DecRef(
+		 range_object );
+
+		if( result == 0 )
+		{
+			goto on_error;
+		}
+		if( read_offset < 0 )
+		{
+			PyErr_Format(
+			 PyExc_ValueError,
+			 "%s: invalid range: %d offset value less than zero.",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+		if( read_size < 0 )
+		{
+			PyErr_Format(
+			 PyExc_ValueError,
+			 "%s: invalid range: %d size value less than zero.",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+#if PY_MAJOR_VERSION >= 3
+		string_objects[ range_index ] = PyBytes_FromStringAndSize(
+		                                 NULL,
+		                                 read_size );
+#else
+		string_objects[ range_index ] = PyString_FromStringAndSize(
+		                                 NULL,
+		                                 read_size );
+#endif
+		if( string_objects[ range_index ] == NULL )
+		{
+			goto on_error;
+		}
+#if PY_MAJOR_VERSION >= 3
+		buffers[ range_index ] = PyBytes_AsString(
+		                          string_objects[ range_index ] );
+#else
+		buffers[ range_index ] = PyString_AsString(
+		                          string_objects[ range_index ] );
+#endif
+		buffer_sizes[ range_index ] = (size_t) read_size;
+		offsets[ range_index ]      = read_offset;
 	}
 	Py_BEGIN_ALLOW_THREADS
 
-	result = libvmdk_handle_get_media_size(
+	result = libvmdk_handle_read_ranges(
 	          pyvmdk_handle->handle,
-	          &media_size,
+	          number_of_ranges,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
 	          &error );
 
 	Py_END_ALLOW_THREADS
@@ -1643,34 +1886,112 @@ PyObject *pyvmdk_handle_get_media_size(
 		pyvmdk_error_raise(
 		 error,
 		 PyExc_IOError,
-		 "%s: failed to retrieve media size.",
+		 "%s: unable to read ranges.",
 		 function );
 
 		libcerror_error_free(
 		 &error );
 
-		return( NULL );
+		goto on_error;
 	}
-	integer_object = pyvmdk_integer_unsigned_new_from_64bit(
-	                  (uint64_t) media_size );
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		/* Need to resize the string here in case the range was not fully read.
+		 */
+#if PY_MAJOR_VERSION >= 3
+		result = _PyBytes_Resize(
+		          &( string_objects[ range_index ] ),
+		          (Py_ssize_t) read_counts[ range_index ] );
+#else
+		result = _PyString_Resize(
+		          &( string_objects[ range_index ] ),
+		          (Py_ssize_t) read_counts[ range_index ] );
+#endif
+		if( result != 0 )
+		{
+			goto on_error;
+		}
+		/* The list takes over the reference of the string object
+		 */
+		PyList_SET_ITEM(
+		 list_object,
+		 (Py_ssize_t) range_index,
+		 string_objects[ range_index ] );
 
-	return( integer_object );
-}
+		string_objects[ range_index ] = NULL;
+	}
+	PyMem_Free(
+	 read_counts );
+	PyMem_Free(
+	 offsets );
+	PyMem_Free(
+	 buffer_sizes );
+	PyMem_Free(
+	 buffers );
+	PyMem_Free(
+	 string_objects );
 
-/* Retrieves the content identifier
- * Returns a Python object if successful or NULL on error
- */
-PyObject *pyvmdk_handle_get_content_identifier(
+	return( list_object );
+
+on_error:
+	if( string_objects != NULL )
+	{
+		for( range_index = 0;
+		     range_index < number_of_ranges;
+		     range_index++ )
+		{
+			if( string_objects[ range_index ] != NULL )
+			{
+				Py_DecRef(
+				 string_objects[ range_index ] );
+			}
+		}
+		PyMem_Free(
+		 string_objects );
+	}
+	if( read_counts != NULL )
+	{
+		PyMem_Free(
+		 read_counts );
+	}
+	if( offsets != NULL )
+	{
+		PyMem_Free(
+		 offsets );
+	}
+	if( buffer_sizes != NULL )
+	{
+		PyMem_Free(
+		 buffer_sizes );
+	}
+	if( buffers != NULL )
+	{
+		PyMem_Free(
+		 buffers );
+	}
+	if( list_object != NULL )
+	{
+		Py_DecRef(
+		 list_object );
+	}
+	return( NULL );
+}
+
+/* Seeks a certain offset in the data
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvmdk_handle_seek_offset(
            pyvmdk_handle_t *pyvmdk_handle,
-           PyObject *arguments PYVMDK_ATTRIBUTE_UNUSED )
+           PyObject *arguments,
+           PyObject *keywords )
 {
 	libcerror_error_t *error    = NULL;
-	PyObject *integer_object    = NULL;
-	static char *function       = "pyvmdk_handle_get_content_identifier";
-	uint32_t content_identifier = 0;
-	int result                  = 0;
-
-	PYVMDK_UNREFERENCED_PARAMETER( arguments )
+	static char *function       = "pyvmdk_handle_seek_offset";
+	static char *keyword_list[] = { "offset", "whence", NULL };
+	off64_t offset              = 0;
+	int whence                  = 0;
 
 	if( pyvmdk_handle == NULL )
 	{
@@ -1681,21 +2002,32 @@ PyObject *pyvmdk_handle_get_content_identifier(
 
 		return( NULL );
 	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "L|i",
+	     keyword_list,
+	     &offset,
+	     &whence ) == 0 )
+	{
+		return( NULL );
+	}
 	Py_BEGIN_ALLOW_THREADS
 
-	result = libvmdk_handle_get_content_identifier(
+	offset = libvmdk_handle_seek_offset(
 	          pyvmdk_handle->handle,
-	          &content_identifier,
+	          offset,
+	          whence,
 	          &error );
 
 	Py_END_ALLOW_THREADS
 
-	if( result != 1 )
+ 	if( offset == -1 )
 	{
 		pyvmdk_error_raise(
 		 error,
 		 PyExc_IOError,
-		 "%s: unable to retrieve content identifier.",
+		 "%s: unable to seek offset.",
 		 function );
 
 		libcerror_error_free(
@@ -1703,24 +2035,24 @@ PyObject *pyvmdk_handle_get_content_identifier(
 
 		return( NULL );
 	}
-	integer_object = pyvmdk_integer_unsigned_new_from_64bit(
-	                  content_identifier );
-
-	return( integer_object );
+	/* The resulting offset is returned for compatibility with io.RawIOBase
+	 */
+	return( pyvmdk_integer_signed_new_from_64bit(
+	         (int64_t) offset ) );
 }
 
-/* Retrieves the parent content identifier
+/* Retrieves the current offset in the data
  * Returns a Python object if successful or NULL on error
  */
-PyObject *pyvmdk_handle_get_parent_content_identifier(
+PyObject *pyvmdk_handle_get_offset(
            pyvmdk_handle_t *pyvmdk_handle,
            PyObject *arguments PYVMDK_ATTRIBUTE_UNUSED )
 {
-	libcerror_error_t *error           = NULL;
-	PyObject *integer_object           = NULL;
-	static char *function              = "pyvmdk_handle_get_parent_content_identifier";
-	uint32_t parent_content_identifier = 0;
-	int result                         = 0;
+	libcerror_error_t *error = NULL;
+	PyObject *integer_object = NULL;
+	static char *function    = "pyvmdk_handle_get_offset";
+	off64_t current_offset   = 0;
+	int result               = 0;
 
 	PYVMDK_UNREFERENCED_PARAMETER( arguments )
 
@@ -1735,9 +2067,9 @@ PyObject *pyvmdk_handle_get_parent_content_identifier(
 	}
 	Py_BEGIN_ALLOW_THREADS
 
-	result = libvmdk_handle_get_parent_content_identifier(
+	result = libvmdk_handle_get_offset(
 	          pyvmdk_handle->handle,
-	          &parent_content_identifier,
+	          &current_offset,
 	          &error );
 
 	Py_END_ALLOW_THREADS
@@ -1747,7 +2079,7 @@ PyObject *pyvmdk_handle_get_parent_content_identifier(
 		pyvmdk_error_raise(
 		 error,
 		 PyExc_IOError,
-		 "%s: unable to retrieve parent content identifier.",
+		 "%s: unable to retrieve offset.",
 		 function );
 
 		libcerror_error_free(
@@ -1755,25 +2087,20 @@ PyObject *pyvmdk_handle_get_parent_content_identifier(
 
 		return( NULL );
 	}
-	integer_object = pyvmdk_integer_unsigned_new_from_64bit(
-	                  parent_content_identifier );
+	integer_object = pyvmdk_integer_signed_new_from_64bit(
+	                  (int64_t) current_offset );
 
 	return( integer_object );
 }
 
-/* Retrieves the parent filename
+/* Determines if the data can be read
  * Returns a Python object if successful or NULL on error
  */
-PyObject *pyvmdk_handle_get_parent_filename(
+PyObject *pyvmdk_handle_readable(
            pyvmdk_handle_t *pyvmdk_handle,
            PyObject *arguments PYVMDK_ATTRIBUTE_UNUSED )
 {
-	libcerror_error_t *error    = NULL;
-	PyObject *string_object     = NULL;
-	uint8_t *parent_filename    = NULL;
-	static char *function       = "pyvmdk_handle_get_parent_filename";
-	size_t parent_filename_size = 0;
-	int result                  = 0;
+	static char *function = "pyvmdk_handle_readable";
 
 	PYVMDK_UNREFERENCED_PARAMETER( arguments )
 
@@ -1786,106 +2113,83 @@ PyObject *pyvmdk_handle_get_parent_filename(
 
 		return( NULL );
 	}
-	Py_BEGIN_ALLOW_THREADS
-
-	result = libvmdk_handle_get_utf8_parent_filename_size(
-	          pyvmdk_handle->handle,
-	          &parent_filename_size,
-	          &error );
-
-	Py_END_ALLOW_THREADS
-
-	if( result == -1 )
-	{
-		pyvmdk_error_raise(
-		 error,
-		 PyExc_IOError,
-		 "%s: unable to retrieve parent filename size.",
-		 function );
+	Py_IncRef(
+	 (PyObject *) Py_True );
 
-		libcerror_error_free(
-		 &error );
+	return( Py_True );
+}
 
-		goto on_error;
-	}
-	else if( ( result == 0 )
-	      || ( parent_filename_size == 0 ) )
-	{
-		Py_IncRef(
-		 Py_None );
+/* Determines if the data supports random access
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvmdk_handle_seekable(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments PYVMDK_ATTRIBUTE_UNUSED )
+{
+	static char *function = "pyvmdk_handle_seekable";
 
-		return( Py_None );
-	}
-	parent_filename = (uint8_t *) PyMem_Malloc(
-	                               sizeof( uint8_t ) * parent_filename_size );
+	PYVMDK_UNREFERENCED_PARAMETER( arguments )
 
-	if( parent_filename == NULL )
+	if( pyvmdk_handle == NULL )
 	{
 		PyErr_Format(
-		 PyExc_MemoryError,
-		 "%s: unable to create parent filename.",
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
 		 function );
 
-		goto on_error;
+		return( NULL );
 	}
-	Py_BEGIN_ALLOW_THREADS
+	Py_IncRef(
+	 (PyObject *) Py_True );
 
-	result = libvmdk_handle_get_utf8_parent_filename(
-		  pyvmdk_handle->handle,
-		  parent_filename,
-		  parent_filename_size,
-		  &error );
+	return( Py_True );
+}
 
-	Py_END_ALLOW_THREADS
+/* Determines if the handle is closed
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvmdk_handle_get_closed(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments PYVMDK_ATTRIBUTE_UNUSED )
+{
+	static char *function = "pyvmdk_handle_get_closed";
 
-	if( result != 1 )
+	PYVMDK_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyvmdk_handle == NULL )
 	{
-		pyvmdk_error_raise(
-		 error,
-		 PyExc_IOError,
-		 "%s: unable to retrieve parent filename.",
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
 		 function );
 
-		libcerror_error_free(
-		 &error );
-
-		goto on_error;
+		return( NULL );
 	}
-	/* Pass the string length to PyUnicode_DecodeUTF8
-	 * otherwise it makes the end of string character is part
-	 * of the string
-	 */
-	string_object = PyUnicode_DecodeUTF8(
-			 (char *) parent_filename,
-			 (Py_ssize_t) parent_filename_size - 1,
-			 NULL );
-
-	PyMem_Free(
-	 parent_filename );
-
-	return( string_object );
-
-on_error:
-	if( parent_filename != NULL )
+	if( pyvmdk_handle->is_open != 0 )
 	{
-		PyMem_Free(
-		 parent_filename );
+		Py_IncRef(
+		 (PyObject *) Py_False );
+
+		return( Py_False );
 	}
-	return( NULL );
+	Py_IncRef(
+	 (PyObject *) Py_True );
+
+	return( Py_True );
 }
 
-/* Retrieves the number of extents
+/* Retrieves the disk type
  * Returns a Python object if successful or NULL on error
  */
-PyObject *pyvmdk_handle_get_number_of_extents(
+PyObject *pyvmdk_handle_get_disk_type(
            pyvmdk_handle_t *pyvmdk_handle,
            PyObject *arguments PYVMDK_ATTRIBUTE_UNUSED )
 {
 	libcerror_error_t *error = NULL;
 	PyObject *integer_object = NULL;
-	static char *function    = "pyvmdk_handle_get_number_of_extents";
-	int number_of_extents    = 0;
+	static char *function    = "pyvmdk_handle_get_disk_type";
 	int result               = 0;
+	int disk_type            = 0;
 
 	PYVMDK_UNREFERENCED_PARAMETER( arguments )
 
@@ -1900,9 +2204,9 @@ PyObject *pyvmdk_handle_get_number_of_extents(
 	}
 	Py_BEGIN_ALLOW_THREADS
 
-	result = libvmdk_handle_get_number_of_extents(
+	result = libvmdk_handle_get_disk_type(
 	          pyvmdk_handle->handle,
-	          &number_of_extents,
+	          &disk_type,
 	          &error );
 
 	Py_END_ALLOW_THREADS
@@ -1912,7 +2216,7 @@ PyObject *pyvmdk_handle_get_number_of_extents(
 		pyvmdk_error_raise(
 		 error,
 		 PyExc_IOError,
-		 "%s: unable to retrieve number of extents.",
+		 "%s: unable to retrieve disk type.",
 		 function );
 
 		libcerror_error_free(
@@ -1922,26 +2226,28 @@ PyObject *pyvmdk_handle_get_number_of_extents(
 	}
 #if PY_MAJOR_VERSION >= 3
 	integer_object = PyLong_FromLong(
-	                  (long) number_of_extents );
+	                  (long) disk_type );
 #else
 	integer_object = PyInt_FromLong(
-	                  (long) number_of_extents );
+	                  (long) disk_type );
 #endif
 	return( integer_object );
 }
 
-/* Retrieves a specific extent descriptor by index
+/* Retrieves the media size
  * Returns a Python object if successful or NULL on error
  */
-PyObject *pyvmdk_handle_get_extent_descriptor_by_index(
-           PyObject *pyvmdk_handle,
-           int extent_index )
+PyObject *pyvmdk_handle_get_media_size(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments PYVMDK_ATTRIBUTE_UNUSED )
 {
-	libcerror_error_t *error                       = NULL;
-	libvmdk_extent_descriptor_t *extent_descriptor = NULL;
-	PyObject *extent_descriptor_object             = NULL;
-	static char *function                          = "pyvmdk_handle_get_extent_descriptor_by_index";
-	int result                                     = 0;
+	libcerror_error_t *error = NULL;
+	PyObject *integer_object = NULL;
+	static char *function    = "pyvmdk_handle_get_media_size";
+	size64_t media_size      = 0;
+	int result               = 0;
+
+	PYVMDK_UNREFERENCED_PARAMETER( arguments )
 
 	if( pyvmdk_handle == NULL )
 	{
@@ -1954,10 +2260,9 @@ PyObject *pyvmdk_handle_get_extent_descriptor_by_index(
 	}
 	Py_BEGIN_ALLOW_THREADS
 
-	result = libvmdk_handle_get_extent_descriptor(
-	          ( ( pyvmdk_handle_t *) pyvmdk_handle )->handle,
-	          extent_index,
-	          &extent_descriptor,
+	result = libvmdk_handle_get_media_size(
+	          pyvmdk_handle->handle,
+	          &media_size,
 	          &error );
 
 	Py_END_ALLOW_THREADS
@@ -1967,80 +2272,137 @@ PyObject *pyvmdk_handle_get_extent_descriptor_by_index(
 		pyvmdk_error_raise(
 		 error,
 		 PyExc_IOError,
-		 "%s: unable to retrieve extent: %d descriptor.",
-		 function,
-		 extent_index );
+		 "%s: failed to retrieve media size.",
+		 function );
 
 		libcerror_error_free(
 		 &error );
 
-		goto on_error;
+		return( NULL );
 	}
-	extent_descriptor_object = pyvmdk_extent_descriptor_new(
-	                            extent_descriptor,
-	                            pyvmdk_handle );
+	integer_object = pyvmdk_integer_unsigned_new_from_64bit(
+	                  (uint64_t) media_size );
 
-	if( extent_descriptor_object == NULL )
-	{
+	return( integer_object );
+}
+
+/* Retrieves the content identifier
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvmdk_handle_get_content_identifier(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments PYVMDK_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error    = NULL;
+	PyObject *integer_object    = NULL;
+	static char *function       = "pyvmdk_handle_get_content_identifier";
+	uint32_t content_identifier = 0;
+	int result                  = 0;
+
+	PYVMDK_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyvmdk_handle == NULL )
+	{
 		PyErr_Format(
-		 PyExc_MemoryError,
-		 "%s: unable to create extent descriptor object.",
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
 		 function );
 
-		goto on_error;
+		return( NULL );
 	}
-	return( extent_descriptor_object );
+	Py_BEGIN_ALLOW_THREADS
 
-on_error:
-	if( extent_descriptor != NULL )
+	result = libvmdk_handle_get_content_identifier(
+	          pyvmdk_handle->handle,
+	          &content_identifier,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
 	{
-		libvmdk_extent_descriptor_free(
-		 &extent_descriptor,
-		 NULL );
+		pyvmdk_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve content identifier.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
 	}
-	return( NULL );
+	integer_object = pyvmdk_integer_unsigned_new_from_64bit(
+	                  content_identifier );
+
+	return( integer_object );
 }
 
-/* Retrieves a specific extent descriptor
+/* Retrieves the parent content identifier
  * Returns a Python object if successful or NULL on error
  */
-PyObject *pyvmdk_handle_get_extent_descriptor(
+PyObject *pyvmdk_handle_get_parent_content_identifier(
            pyvmdk_handle_t *pyvmdk_handle,
-           PyObject *arguments,
-           PyObject *keywords )
+           PyObject *arguments PYVMDK_ATTRIBUTE_UNUSED )
 {
-	PyObject *extent_descriptor_object = NULL;
-	static char *keyword_list[]        = { "extent_index", NULL };
-	int extent_index                   = 0;
+	libcerror_error_t *error           = NULL;
+	PyObject *integer_object           = NULL;
+	static char *function              = "pyvmdk_handle_get_parent_content_identifier";
+	uint32_t parent_content_identifier = 0;
+	int result                         = 0;
 
-	if( PyArg_ParseTupleAndKeywords(
-	     arguments,
-	     keywords,
-	     "i",
-	     keyword_list,
-	     &extent_index ) == 0 )
+	PYVMDK_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyvmdk_handle == NULL )
 	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
 		return( NULL );
 	}
-	extent_descriptor_object = pyvmdk_handle_get_extent_descriptor_by_index(
-	                            (PyObject *) pyvmdk_handle,
-	                            extent_index );
+	Py_BEGIN_ALLOW_THREADS
 
-	return( extent_descriptor_object );
+	result = libvmdk_handle_get_parent_content_identifier(
+	          pyvmdk_handle->handle,
+	          &parent_content_identifier,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyvmdk_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve parent content identifier.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	integer_object = pyvmdk_integer_unsigned_new_from_64bit(
+	                  parent_content_identifier );
+
+	return( integer_object );
 }
 
-/* Retrieves an extent descriptors sequence and iterator object for the extent descriptors
+/* Retrieves the parent filename
  * Returns a Python object if successful or NULL on error
  */
-PyObject *pyvmdk_handle_get_extent_descriptors(
+PyObject *pyvmdk_handle_get_parent_filename(
            pyvmdk_handle_t *pyvmdk_handle,
            PyObject *arguments PYVMDK_ATTRIBUTE_UNUSED )
 {
-	libcerror_error_t *error            = NULL;
-	PyObject *extent_descriptors_object = NULL;
-	static char *function               = "pyvmdk_handle_get_extent_descriptors";
-	int number_of_extent_descriptors    = 0;
-	int result                          = 0;
+	libcerror_error_t *error    = NULL;
+	PyObject *string_object     = NULL;
+	uint8_t *parent_filename    = NULL;
+	static char *function       = "pyvmdk_handle_get_parent_filename";
+	size_t parent_filename_size = 0;
+	int result                  = 0;
 
 	PYVMDK_UNREFERENCED_PARAMETER( arguments )
 
@@ -2055,40 +2417,962 @@ PyObject *pyvmdk_handle_get_extent_descriptors(
 	}
 	Py_BEGIN_ALLOW_THREADS
 
-	result = libvmdk_handle_get_number_of_extents(
+	result = libvmdk_handle_get_utf8_parent_filename_size(
 	          pyvmdk_handle->handle,
-	          &number_of_extent_descriptors,
+	          &parent_filename_size,
 	          &error );
 
 	Py_END_ALLOW_THREADS
 
-	if( result != 1 )
+	if( result == -1 )
 	{
 		pyvmdk_error_raise(
 		 error,
 		 PyExc_IOError,
-		 "%s: unable to retrieve number of extents.",
+		 "%s: unable to retrieve parent filename size.",
 		 function );
 
 		libcerror_error_free(
 		 &error );
 
-		return( NULL );
+		goto on_error;
 	}
-	extent_descriptors_object = pyvmdk_extent_descriptors_new(
-	                             (PyObject *) pyvmdk_handle,
-	                             &pyvmdk_handle_get_extent_descriptor_by_index,
-	                             number_of_extent_descriptors );
+	else if( ( result == 0 )
+	      || ( parent_filename_size == 0 ) )
+	{
+		Py_IncRef(
+		 Py_None );
 
-	if( extent_descriptors_object == NULL )
+		return( Py_None );
+	}
+	parent_filename = (uint8_t *) PyMem_Malloc(
+	                               sizeof( uint8_t ) * parent_filename_size );
+
+	if( parent_filename == NULL )
 	{
 		PyErr_Format(
 		 PyExc_MemoryError,
-		 "%s: unable to create extent descriptors object.",
+		 "%s: unable to create parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libvmdk_handle_get_utf8_parent_filename(
+		  pyvmdk_handle->handle,
+		  parent_filename,
+		  parent_filename_size,
+		  &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyvmdk_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve parent filename.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	/* Pass the string length to PyUnicode_DecodeUTF8
+	 * otherwise it makes the end of string character is part
+	 * of the string
+	 */
+	string_object = PyUnicode_DecodeUTF8(
+			 (char *) parent_filename,
+			 (Py_ssize_t) parent_filename_size - 1,
+			 NULL );
+
+	PyMem_Free(
+	 parent_filename );
+
+	return( string_object );
+
+on_error:
+	if( parent_filename != NULL )
+	{
+		PyMem_Free(
+		 parent_filename );
+	}
+	return( NULL );
+}
+
+/* Retrieves the number of extents
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvmdk_handle_get_number_of_extents(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments PYVMDK_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	PyObject *integer_object = NULL;
+	static char *function    = "pyvmdk_handle_get_number_of_extents";
+	int number_of_extents    = 0;
+	int result               = 0;
+
+	PYVMDK_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyvmdk_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
 		 function );
 
 		return( NULL );
 	}
-	return( extent_descriptors_object );
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libvmdk_handle_get_number_of_extents(
+	          pyvmdk_handle->handle,
+	          &number_of_extents,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyvmdk_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+#if PY_MAJOR_VERSION >= 3
+	integer_object = PyLong_FromLong(
+	                  (long) number_of_extents );
+#else
+	integer_object = PyInt_FromLong(
+	                  (long) number_of_extents );
+#endif
+	return( integer_object );
+}
+
+/* Retrieves a specific extent descriptor by index
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvmdk_handle_get_extent_descriptor_by_index(
+           PyObject *pyvmdk_handle,
+           int extent_index )
+{
+	libcerror_error_t *error                       = NULL;
+	libvmdk_extent_descriptor_t *extent_descriptor = NULL;
+	PyObject *extent_descriptor_object             = NULL;
+	static char *function                          = "pyvmdk_handle_get_extent_descriptor_by_index";
+	int result                                     = 0;
+
+	if( pyvmdk_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libvmdk_handle_get_extent_descriptor(
+	          ( ( pyvmdk_handle_t *) pyvmdk_handle )->handle,
+	          extent_index,
+	          &extent_descriptor,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyvmdk_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve extent: %d descriptor.",
+		 function,
+		 extent_index );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	extent_descriptor_object = pyvmdk_extent_descriptor_new(
+	                            extent_descriptor,
+	                            pyvmdk_handle );
+
+	if( extent_descriptor_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create extent descriptor object.",
+		 function );
+
+		goto on_error;
+	}
+	return( extent_descriptor_object );
+
+on_error:
+	if( extent_descriptor != NULL )
+	{
+		libvmdk_extent_descriptor_free(
+		 &extent_descriptor,
+		 NULL );
+	}
+	return( NULL );
+}
+
+/* Retrieves a specific extent descriptor
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvmdk_handle_get_extent_descriptor(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	PyObject *extent_descriptor_object = NULL;
+	static char *keyword_list[]        = { "extent_index", NULL };
+	int extent_index                   = 0;
+
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "i",
+	     keyword_list,
+	     &extent_index ) == 0 )
+	{
+		return( NULL );
+	}
+	extent_descriptor_object = pyvmdk_handle_get_extent_descriptor_by_index(
+	                            (PyObject *) pyvmdk_handle,
+	                            extent_index );
+
+	return( extent_descriptor_object );
+}
+
+/* Retrieves an extent descriptors sequence and iterator object for the extent descriptors
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvmdk_handle_get_extent_descriptors(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments PYVMDK_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error            = NULL;
+	PyObject *extent_descriptors_object = NULL;
+	static char *function               = "pyvmdk_handle_get_extent_descriptors";
+	int number_of_extent_descriptors    = 0;
+	int result                          = 0;
+
+	PYVMDK_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyvmdk_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libvmdk_handle_get_number_of_extents(
+	          pyvmdk_handle->handle,
+	          &number_of_extent_descriptors,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyvmdk_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	extent_descriptors_object = pyvmdk_extent_descriptors_new(
+	                             (PyObject *) pyvmdk_handle,
+	                             &pyvmdk_handle_get_extent_descriptor_by_index,
+	                             number_of_extent_descriptors );
+
+	if( extent_descriptors_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create extent descriptors object.",
+		 function );
+
+		return( NULL );
+	}
+	return( extent_descriptors_object );
+}
+
+
+/* Appends the values of a run to the runs
+ * The runs are stored in a buffer of 64-bit signed integers per value, so that
+ * every array object can be created at once
+ * Returns 1 if successful or -1 on error
+ */
+int pyvmdk_handle_runs_append(
+     pyvmdk_handle_runs_t *runs,
+     const int64_t *values,
+     int number_of_values )
+{
+	int64_t *run_values           = NULL;
+	static char *function         = "pyvmdk_handle_runs_append";
+	size_t maximum_number_of_runs = 0;
+	int value_index               = 0;
+
+	if( runs == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid runs.",
+		 function );
+
+		return( -1 );
+	}
+	if( values == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_values <= 0 )
+	 || ( number_of_values > PYVMDK_HANDLE_MAXIMUM_NUMBER_OF_RUN_VALUES )
+	 || ( number_of_values != runs->number_of_values ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid number of values value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( runs->number_of_runs >= runs->maximum_number_of_runs )
+	{
+		if( runs->maximum_number_of_runs == 0 )
+		{
+			maximum_number_of_runs = 256;
+		}
+		else
+		{
+			maximum_number_of_runs = runs->maximum_number_of_runs * 2;
+		}
+		if( maximum_number_of_runs > (size_t) ( PY_SSIZE_T_MAX / sizeof( int64_t ) ) )
+		{
+			PyErr_Format(
+			 PyExc_MemoryError,
+			 "%s: invalid maximum number of runs value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		for( value_index = 0;
+		     value_index < number_of_values;
+		     value_index++ )
+		{
+			run_values = (int64_t *) PyMem_Realloc(
+			                          runs->values[ value_index ],
+			                          sizeof( int64_t ) * maximum_number_of_runs );
+
+			if( run_values == NULL )
+			{
+				PyErr_Format(
+				 PyExc_MemoryError,
+				 "%s: unable to resize run values: %d.",
+				 function,
+				 value_index );
+
+				return( -1 );
+			}
+			runs->values[ value_index ] = run_values;
+		}
+		runs->maximum_number_of_runs = maximum_number_of_runs;
+	}
+	for( value_index = 0;
+	     value_index < number_of_values;
+	     value_index++ )
+	{
+		runs->values[ value_index ][ runs->number_of_runs ] = values[ value_index ];
+	}
+	runs->number_of_runs += 1;
+
+	return( 1 );
+}
+
+/* Frees the buffers of the runs
+ */
+void pyvmdk_handle_runs_free(
+      pyvmdk_handle_runs_t *runs )
+{
+	int value_index = 0;
+
+	if( runs == NULL )
+	{
+		return;
+	}
+	for( value_index = 0;
+	     value_index < PYVMDK_HANDLE_MAXIMUM_NUMBER_OF_RUN_VALUES;
+	     value_index++ )
+	{
+		if( runs->values[ value_index ] != NULL )
+		{
+			PyMem_Free(
+			 runs->values[ value_index ] );
+
+			runs->values[ value_index ] = NULL;
+		}
+	}
+	runs->number_of_runs         = 0;
+	runs->maximum_number_of_runs = 0;
+}
+
+/* Creates a tuple of arrays of 64-bit signed integers from the runs, with an array per value
+ * Every array is created from the buffer of its values at once
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvmdk_handle_runs_get_arrays(
+           pyvmdk_handle_runs_t *runs )
+{
+	PyObject *array_module   = NULL;
+	PyObject *array_object   = NULL;
+	PyObject *array_type     = NULL;
+	PyObject *bytes_object   = NULL;
+	PyObject *tuple_object   = NULL;
+	static char *function    = "pyvmdk_handle_runs_get_arrays";
+	int value_index          = 0;
+
+#if PY_MAJOR_VERSION < 3
+	long *long_values        = NULL;
+	size_t run_index         = 0;
+#endif
+
+	if( runs == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid runs.",
+		 function );
+
+		return( NULL );
+	}
+	if( ( runs->number_of_values <= 0 )
+	 || ( runs->number_of_values > PYVMDK_HANDLE_MAXIMUM_NUMBER_OF_RUN_VALUES ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid runs - number of values value out of bounds.",
+		 function );
+
+		return( NULL );
+	}
+	array_module = PyImport_ImportModule(
+	                "array" );
+
+	if( array_module == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ImportError,
+		 "%s: unable to import array module.",
+		 function );
+
+		goto on_error;
+	}
+	array_type = PyObject_GetAttrString(
+	              array_module,
+	              "array" );
+
+	if( array_type == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ImportError,
+		 "%s: unable to retrieve array type.",
+		 function );
+
+		goto on_error;
+	}
+	tuple_object = PyTuple_New(
+	                (Py_ssize_t) runs->number_of_values );
+
+	if( tuple_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create tuple object.",
+		 function );
+
+		goto on_error;
+	}
+	for( value_index = 0;
+	     value_index < runs->number_of_values;
+	     value_index++ )
+	{
+		/* The array is initialized with the bytes of the values in native byte order,
+		 * which is the same as passing them to its frombytes method
+		 */
+#if PY_MAJOR_VERSION >= 3
+		bytes_object = PyBytes_FromStringAndSize(
+		                (char *) runs->values[ value_index ],
+		                (Py_ssize_t) ( sizeof( int64_t ) * runs->number_of_runs ) );
+#else
+		/* Python 2 has no array type of 64-bit signed integers, hence the values are stored as long
+		 */
+		bytes_object = PyString_FromStringAndSize(
+		                NULL,
+		                (Py_ssize_t) ( sizeof( long ) * runs->number_of_runs ) );
+
+		if( bytes_object != NULL )
+		{
+			long_values = (long *) PyString_AsString(
+			                        bytes_object );
+
+			for( run_index = 0;
+			     run_index < runs->number_of_runs;
+			     run_index++ )
+			{
+				long_values[ run_index ] = (long) runs->values[ value_index ][ run_index ];
+			}
+		}
+#endif
+		if( bytes_object == NULL )
+		{
+			PyErr_Format(
+			 PyExc_MemoryError,
+			 "%s: unable to create bytes object: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+#if PY_MAJOR_VERSION >= 3
+		array_object = PyObject_CallFunction(
+		                array_type,
+		                "sO",
+		                "q",
+		                bytes_object );
+#else
+		array_object = PyObject_CallFunction(
+		                array_type,
+		                "sO",
+		                "l",
+		                bytes_object );
+#endif
+		Py_DecRef(
+		 bytes_object );
+
+		if( array_object == NULL )
+		{
+			PyErr_Format(
+			 PyExc_MemoryError,
+			 "%s: unable to create array object: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		/* The tuple takes over the reference of the array object
+		 */
+		PyTuple_SET_ITEM(
+		 tuple_object,
+		 (Py_ssize_t) value_index,
+		 array_object );
+	}
+	Py_DecRef(
+	 array_type );
+	Py_DecRef(
+	 array_module );
+
+	return( tuple_object );
+
+on_error:
+	if( tuple_object != NULL )
+	{
+		Py_DecRef(
+		 tuple_object );
+	}
+	if( array_type != NULL )
+	{
+		Py_DecRef(
+		 array_type );
+	}
+	if( array_module != NULL )
+	{
+		Py_DecRef(
+		 array_module );
+	}
+	return( NULL );
+}
+
+/* Appends the extent map runs of a range of the media data
+ * Runs that are stored in the parent are resolved using the parent handle, where the layer
+ * is 0 for the handle itself, 1 for its parent, etc.
+ * If range offset and range size are provided only the allocated ranges are appended to the runs
+ * as (offset, size) values, otherwise the runs are appended as (offset, size, layer, extent index,
+ * physical offset, flags) values. The range offset and range size contain the allocated range
+ * that has not been appended yet, since it can continue in the next run.
+ * Returns 1 if successful or -1 on error
+ */
+int pyvmdk_handle_append_extent_map_runs(
+     pyvmdk_handle_t *pyvmdk_handle,
+     int layer,
+     off64_t offset,
+     size64_t size,
+     pyvmdk_handle_runs_t *runs,
+     off64_t *range_offset,
+     size64_t *range_size )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "pyvmdk_handle_append_extent_map_runs";
+	int64_t values[ 6 ];
+	size64_t run_size        = 0;
+	off64_t end_offset       = 0;
+	off64_t physical_offset  = 0;
+	uint32_t run_flags       = 0;
+	int extent_index         = 0;
+	int result               = 0;
+
+	if( pyvmdk_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_offset == NULL )
+	 != ( range_size == NULL ) )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid range offset and size.",
+		 function );
+
+		return( -1 );
+	}
+	end_offset = offset + (off64_t) size;
+
+	while( offset < end_offset )
+	{
+		Py_BEGIN_ALLOW_THREADS
+
+		result = libvmdk_handle_get_extent_map_run_at_offset(
+		          pyvmdk_handle->handle,
+		          offset,
+		          &run_size,
+		          &extent_index,
+		          &physical_offset,
+		          &run_flags,
+		          &error );
+
+		Py_END_ALLOW_THREADS
+
+		if( result == -1 )
+		{
+			pyvmdk_error_raise(
+			 error,
+			 PyExc_IOError,
+			 "%s: unable to retrieve extent map run.",
+			 function );
+
+			libcerror_error_free(
+			 &error );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( run_size == 0 )
+		{
+			PyErr_Format(
+			 PyExc_IOError,
+			 "%s: invalid extent map run - missing size.",
+			 function );
+
+			return( -1 );
+		}
+		if( run_size > (size64_t) ( end_offset - offset ) )
+		{
+			run_size = (size64_t) ( end_offset - offset );
+		}
+		if( ( ( run_flags & LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_IN_PARENT ) != 0 )
+		 && ( pyvmdk_handle->parent_handle_object != NULL ) )
+		{
+			if( pyvmdk_handle_append_extent_map_runs(
+			     (pyvmdk_handle_t *) pyvmdk_handle->parent_handle_object,
+			     layer + 1,
+			     offset,
+			     run_size,
+			     runs,
+			     range_offset,
+			     range_size ) != 1 )
+			{
+				return( -1 );
+			}
+		}
+		else if( range_offset != NULL )
+		{
+			if( ( run_flags & ( LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_ZERO | LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_IN_PARENT ) ) == 0 )
+			{
+				if( ( *range_size != 0 )
+				 && ( ( *range_offset + (off64_t) *range_size ) == offset ) )
+				{
+					*range_size += run_size;
+				}
+				else
+				{
+					if( *range_size != 0 )
+					{
+						values[ 0 ] = (int64_t) *range_offset;
+						values[ 1 ] = (int64_t) *range_size;
+
+						if( pyvmdk_handle_runs_append(
+						     runs,
+						     values,
+						     2 ) != 1 )
+						{
+							return( -1 );
+						}
+					}
+					*range_offset = offset;
+					*range_size   = run_size;
+				}
+			}
+		}
+		else
+		{
+			values[ 0 ] = (int64_t) offset;
+			values[ 1 ] = (int64_t) run_size;
+			values[ 2 ] = (int64_t) layer;
+			values[ 3 ] = (int64_t) extent_index;
+			values[ 4 ] = (int64_t) physical_offset;
+			values[ 5 ] = (int64_t) run_flags;
+
+			if( pyvmdk_handle_runs_append(
+			     runs,
+			     values,
+			     6 ) != 1 )
+			{
+				return( -1 );
+			}
+		}
+		offset += (off64_t) run_size;
+	}
+	return( 1 );
+}
+
+/* Retrieves the extent map
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvmdk_handle_get_extent_map(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	pyvmdk_handle_runs_t runs;
+
+	PyObject *tuple_object      = NULL;
+	static char *function       = "pyvmdk_handle_get_extent_map";
+	static char *keyword_list[] = { "offset", "size", NULL };
+	off64_t offset              = 0;
+	int64_t size                = -1;
+
+	if( pyvmdk_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "|LL",
+	     keyword_list,
+	     &offset,
+	     &size ) == 0 )
+	{
+		return( NULL );
+	}
+	if( offset < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( NULL );
+	}
+	if( size < -1 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid size value less than zero.",
+		 function );
+
+		return( NULL );
+	}
+	if( size == -1 )
+	{
+		size = (int64_t) INT64_MAX - offset;
+	}
+	if( memory_set(
+	     &runs,
+	     0,
+	     sizeof( pyvmdk_handle_runs_t ) ) == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to clear runs.",
+		 function );
+
+		return( NULL );
+	}
+	runs.number_of_values = 6;
+
+	if( pyvmdk_handle_append_extent_map_runs(
+	     pyvmdk_handle,
+	     0,
+	     offset,
+	     (size64_t) size,
+	     &runs,
+	     NULL,
+	     NULL ) == 1 )
+	{
+		tuple_object = pyvmdk_handle_runs_get_arrays(
+		                &runs );
+	}
+	pyvmdk_handle_runs_free(
+	 &runs );
+
+	return( tuple_object );
+}
+
+/* Retrieves the allocated ranges
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvmdk_handle_get_allocated_ranges(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	pyvmdk_handle_runs_t runs;
+
+	PyObject *tuple_object      = NULL;
+	static char *function       = "pyvmdk_handle_get_allocated_ranges";
+	static char *keyword_list[] = { "offset", "size", NULL };
+	int64_t values[ 2 ];
+	size64_t range_size         = 0;
+	off64_t offset              = 0;
+	off64_t range_offset        = 0;
+	int64_t size                = -1;
+	int result                  = 0;
+
+	if( pyvmdk_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "|LL",
+	     keyword_list,
+	     &offset,
+	     &size ) == 0 )
+	{
+		return( NULL );
+	}
+	if( offset < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( NULL );
+	}
+	if( size < -1 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid size value less than zero.",
+		 function );
+
+		return( NULL );
+	}
+	if( size == -1 )
+	{
+		size = (int64_t) INT64_MAX - offset;
+	}
+	if( memory_set(
+	     &runs,
+	     0,
+	     sizeof( pyvmdk_handle_runs_t ) ) == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to clear runs.",
+		 function );
+
+		return( NULL );
+	}
+	runs.number_of_values = 2;
+
+	result = pyvmdk_handle_append_extent_map_runs(
+	          pyvmdk_handle,
+	          0,
+	          offset,
+	          (size64_t) size,
+	          &runs,
+	          &range_offset,
+	          &range_size );
+
+	if( ( result == 1 )
+	 && ( range_size != 0 ) )
+	{
+		values[ 0 ] = (int64_t) range_offset;
+		values[ 1 ] = (int64_t) range_size;
+
+		result = pyvmdk_handle_runs_append(
+		          &runs,
+		          values,
+		          2 );
+	}
+	if( result == 1 )
+	{
+		tuple_object = pyvmdk_handle_runs_get_arrays(
+		                &runs );
+	}
+	pyvmdk_handle_runs_free(
+	 &runs );
+
+	return( tuple_object );
 }
 
@@ -33,6 +33,10 @@
 extern "C" {
 #endif
 
+/* The maximum number of values of a run of the extent map
+ */
+#define PYVMDK_HANDLE_MAXIMUM_NUMBER_OF_RUN_VALUES	6
+
 typedef struct pyvmdk_handle pyvmdk_handle_t;
 
 struct pyvmdk_handle
@@ -56,6 +60,31 @@ struct pyvmdk_handle
 	/* The parent handle object
 	 */
 	PyObject *parent_handle_object;
+
+	/* Value to indicate the handle is open
+	 */
+	uint8_t is_open;
+};
+
+typedef struct pyvmdk_handle_runs pyvmdk_handle_runs_t;
+
+struct pyvmdk_handle_runs
+{
+	/* The values of the runs, with a buffer per value
+	 */
+	int64_t *values[ PYVMDK_HANDLE_MAXIMUM_NUMBER_OF_RUN_VALUES ];
+
+	/* The number of values per run
+	 */
+	int number_of_values;
+
+	/* The number of runs
+	 */
+	size_t number_of_runs;
+
+	/* The maximum number of runs the buffers can contain
+	 */
+	size_t maximum_number_of_runs;
 };
 
 extern PyMethodDef pyvmdk_handle_object_methods[];
@@ -109,6 +138,21 @@ PyObject *pyvmdk_handle_read_buffer_at_offset(
            PyObject *arguments,
            PyObject *keywords );
 
+PyObject *pyvmdk_handle_read_buffer_into(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pyvmdk_handle_read_buffer_at_offset_into(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pyvmdk_handle_read_ranges(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
 PyObject *pyvmdk_handle_seek_offset(
            pyvmdk_handle_t *pyvmdk_handle,
            PyObject *arguments,
@@ -118,6 +162,18 @@ PyObject *pyvmdk_handle_get_offset(
            pyvmdk_handle_t *pyvmdk_handle,
            PyObject *arguments );
 
+PyObject *pyvmdk_handle_readable(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments );
+
+PyObject *pyvmdk_handle_seekable(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments );
+
+PyObject *pyvmdk_handle_get_closed(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments );
+
 PyObject *pyvmdk_handle_get_disk_type(
            pyvmdk_handle_t *pyvmdk_handle,
            PyObject *arguments );
@@ -155,6 +211,36 @@ PyObject *pyvmdk_handle_get_extent_descriptors(
            pyvmdk_handle_t *pyvmdk_handle,
            PyObject *arguments );
 
+int pyvmdk_handle_runs_append(
+     pyvmdk_handle_runs_t *runs,
+     const int64_t *values,
+     int number_of_values );
+
+void pyvmdk_handle_runs_free(
+      pyvmdk_handle_runs_t *runs );
+
+PyObject *pyvmdk_handle_runs_get_arrays(
+           pyvmdk_handle_runs_t *runs );
+
+int pyvmdk_handle_append_extent_map_runs(
+     pyvmdk_handle_t *pyvmdk_handle,
+     int layer,
+     off64_t offset,
+     size64_t size,
+     pyvmdk_handle_runs_t *runs,
+     off64_t *range_offset,
+     size64_t *range_size );
+
+PyObject *pyvmdk_handle_get_extent_map(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pyvmdk_handle_get_allocated_ranges(
+           pyvmdk_handle_t *pyvmdk_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 
 GIT_URL_PREFIX="https://github.com/libyal";
-LOCAL_LIBS="libbfio libcdata libcerror libcfile libclocale libcnotify libcpath libcsplit libcthreads libfcache libfdata libfvalue libuna";
+LOCAL_LIBS="libbfio libcdata libcerror libcfile libclocale libcnotify libcpath libcsplit libcthreads libfcache libfdata libfvalue libhmac libuna";
 
 OLDIFS=$IFS;
 IFS=" ";
@@ -175,6 +175,15 @@ SED_SCRIPT="/^$/ {
 		fi
 	fi
 
+	# Make the necessary changes to libhmac/Makefile.am
+	if test ${LOCAL_LIB} = "libhmac";
+	then
+		if ! test -f "m4/libcrypto.m4";
+		then
+			sed -i'~' '/@LIBCRYPTO_CPPFLAGS@/d' ${LOCAL_LIB_MAKEFILE_AM};
+		fi
+	fi
+
 	# Make the necessary changes to libsmraw/Makefile.am
 	if test ${LOCAL_LIB} = "libsmraw";
 	then
@@ -20,6 +20,7 @@
 # along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 import argparse
+import io
 import os
 import random
 import sys
@@ -244,6 +245,50 @@ class HandleTypeTests(unittest.TestCase):
       for extend_data_file_object in extent_data_file_objects:
         extend_data_file_object.close()
 
+  def test_read_buffer_file_object_without_file_descriptor(self):
+    """Tests the read_buffer function on a file-like object without fileno."""
+    test_source = getattr(unittest, "source", None)
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    if not os.path.isfile(test_source):
+      raise unittest.SkipTest("source not a regular file")
+
+    vmdk_handle = pyvmdk.handle()
+
+    vmdk_handle.open(test_source)
+    vmdk_handle.open_extent_data_files()
+
+    media_size = vmdk_handle.get_media_size()
+    expected_data = vmdk_handle.read_buffer(size=4096)
+
+    vmdk_handle.close()
+
+    with open(test_source, "rb") as file_object:
+      bytes_io_object = io.BytesIO(file_object.read())
+
+    vmdk_handle.open_file_object(bytes_io_object)
+
+    extent_data_file_objects = []
+    for extent_descriptor in vmdk_handle.extent_descriptors:
+      extend_data_file_path = os.path.join(
+        os.path.dirname(test_source), extent_descriptor.filename)
+      with open(extend_data_file_path, "rb") as extend_data_file_object:
+        extent_data_file_objects.append(
+            io.BytesIO(extend_data_file_object.read()))
+
+    vmdk_handle.open_extent_data_files_as_file_objects(
+        extent_data_file_objects)
+
+    # Test normal read.
+    data = vmdk_handle.read_buffer(size=4096)
+
+    self.assertIsNotNone(data)
+    self.assertEqual(len(data), min(media_size, 4096))
+    self.assertEqual(data, expected_data)
+
+    vmdk_handle.close()
+
   def test_read_buffer_at_offset(self):
     """Tests the read_buffer_at_offset function."""
     test_source = getattr(unittest, "source", None)
@@ -313,6 +358,192 @@ class HandleTypeTests(unittest.TestCase):
     with self.assertRaises(IOError):
       vmdk_handle.read_buffer_at_offset(4096, 0)
 
+  def test_read_buffer_into(self):
+    """Tests the read_buffer_into function."""
+    test_source = getattr(unittest, "source", None)
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    vmdk_handle = pyvmdk.handle()
+
+    vmdk_handle.open(test_source)
+    vmdk_handle.open_extent_data_files()
+
+    media_size = vmdk_handle.get_media_size()
+
+    # Test normal read.
+    data = vmdk_handle.read_buffer_at_offset(4096, 0)
+
+    vmdk_handle.seek_offset(0, os.SEEK_SET)
+
+    buffer = bytearray(4096)
+    read_count = vmdk_handle.read_buffer_into(buffer)
+
+    self.assertEqual(read_count, min(media_size, 4096))
+    self.assertEqual(buffer[:read_count], data)
+
+    # Test read into a memoryview.
+    vmdk_handle.seek_offset(0, os.SEEK_SET)
+
+    buffer = bytearray(8192)
+    read_count = vmdk_handle.readinto(memoryview(buffer)[4096:])
+
+    self.assertEqual(read_count, min(media_size, 4096))
+    self.assertEqual(buffer[4096:4096 + read_count], data)
+
+    if media_size > 8:
+      vmdk_handle.seek_offset(-8, os.SEEK_END)
+
+      # Read buffer on media_size boundary.
+      read_count = vmdk_handle.read_buffer_into(buffer)
+
+      self.assertEqual(read_count, 8)
+
+      # Read buffer beyond media_size boundary.
+      read_count = vmdk_handle.read_buffer_into(buffer)
+
+      self.assertEqual(read_count, 0)
+
+    with self.assertRaises(TypeError):
+      vmdk_handle.read_buffer_into(b"immutable")
+
+    vmdk_handle.close()
+
+    # Test the read without open.
+    with self.assertRaises(IOError):
+      vmdk_handle.read_buffer_into(buffer)
+
+  def test_read_buffer_at_offset_into(self):
+    """Tests the read_buffer_at_offset_into function."""
+    test_source = getattr(unittest, "source", None)
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    vmdk_handle = pyvmdk.handle()
+
+    vmdk_handle.open(test_source)
+    vmdk_handle.open_extent_data_files()
+
+    media_size = vmdk_handle.get_media_size()
+
+    # Test normal read.
+    data = vmdk_handle.read_buffer_at_offset(4096, 0)
+
+    buffer = bytearray(4096)
+    read_count = vmdk_handle.read_buffer_at_offset_into(buffer, 0)
+
+    self.assertEqual(read_count, min(media_size, 4096))
+    self.assertEqual(buffer[:read_count], data)
+
+    if media_size > 8:
+      # Read buffer on media_size boundary.
+      read_count = vmdk_handle.read_buffer_at_offset_into(buffer, media_size - 8)
+
+      self.assertEqual(read_count, 8)
+
+      # Read buffer beyond media_size boundary.
+      read_count = vmdk_handle.read_buffer_at_offset_into(buffer, media_size + 8)
+
+      self.assertEqual(read_count, 0)
+
+    with self.assertRaises(ValueError):
+      vmdk_handle.read_buffer_at_offset_into(buffer, -1)
+
+    with self.assertRaises(TypeError):
+      vmdk_handle.read_buffer_at_offset_into(b"immutable", 0)
+
+    vmdk_handle.close()
+
+    # Test the read without open.
+    with self.assertRaises(IOError):
+      vmdk_handle.read_buffer_at_offset_into(buffer, 0)
+
+  def test_buffered_reader(self):
+    """Tests wrapping the handle in a buffered reader."""
+    test_source = getattr(unittest, "source", None)
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    vmdk_handle = pyvmdk.handle()
+
+    self.assertTrue(vmdk_handle.closed)
+
+    vmdk_handle.open(test_source)
+    vmdk_handle.open_extent_data_files()
+
+    self.assertFalse(vmdk_handle.closed)
+    self.assertTrue(vmdk_handle.readable())
+    self.assertTrue(vmdk_handle.seekable())
+
+    media_size = vmdk_handle.get_media_size()
+
+    data = vmdk_handle.read_buffer_at_offset(4096, 0)
+
+    buffered_reader = io.BufferedReader(vmdk_handle)
+
+    self.assertEqual(buffered_reader.read(4096), data)
+
+    buffered_reader.seek(0, os.SEEK_SET)
+
+    self.assertEqual(buffered_reader.read(min(media_size, 16)), data[:16])
+
+    if media_size > 8:
+      offset = buffered_reader.seek(-8, os.SEEK_END)
+
+      self.assertEqual(offset, media_size - 8)
+      self.assertEqual(len(buffered_reader.read(4096)), 8)
+
+    buffered_reader.close()
+
+    self.assertTrue(vmdk_handle.closed)
+
+  def test_read_ranges(self):
+    """Tests the read_ranges function."""
+    test_source = getattr(unittest, "source", None)
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    vmdk_handle = pyvmdk.handle()
+
+    vmdk_handle.open(test_source)
+    vmdk_handle.open_extent_data_files()
+
+    media_size = vmdk_handle.get_media_size()
+
+    if media_size > 8:
+      ranges = [(media_size - 8, 4096), (0, 4096)]
+
+      data_list = vmdk_handle.read_ranges(ranges)
+
+      self.assertIsNotNone(data_list)
+      self.assertEqual(len(data_list), 2)
+      self.assertEqual(len(data_list[0]), 8)
+      self.assertEqual(len(data_list[1]), min(media_size, 4096))
+
+      data = vmdk_handle.read_buffer_at_offset(4096, 0)
+      self.assertEqual(data_list[1], data)
+
+      data = vmdk_handle.read_buffer_at_offset(8, media_size - 8)
+      self.assertEqual(data_list[0], data)
+
+    data_list = vmdk_handle.read_ranges([])
+    self.assertEqual(data_list, [])
+
+    with self.assertRaises(ValueError):
+      vmdk_handle.read_ranges([(-1, 4096)])
+
+    with self.assertRaises(ValueError):
+      vmdk_handle.read_ranges([(0, -1)])
+
+    with self.assertRaises(TypeError):
+      vmdk_handle.read_ranges(None)
+
+    vmdk_handle.close()
+
+    # Test the read without open.
+    with self.assertRaises(IOError):
+      vmdk_handle.read_ranges([(0, 4096)])
+
   def test_seek_offset(self):
     """Tests the seek_offset function."""
     test_source = getattr(unittest, "source", None)
@@ -491,6 +722,101 @@ class HandleTypeTests(unittest.TestCase):
 
     vmdk_handle.close()
 
+  def test_get_extent_map(self):
+    """Tests the get_extent_map function."""
+    test_source = getattr(unittest, "source", None)
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    vmdk_handle = pyvmdk.handle()
+
+    vmdk_handle.open(test_source)
+    vmdk_handle.open_extent_data_files()
+
+    media_size = vmdk_handle.get_media_size()
+
+    extent_map = vmdk_handle.get_extent_map()
+    self.assertIsNotNone(extent_map)
+    self.assertEqual(len(extent_map), 6)
+
+    number_of_runs = len(extent_map[0])
+    for values in extent_map:
+      self.assertEqual(len(values), number_of_runs)
+
+    expected_offset = 0
+    for offset, size, layer, _, _, flags in zip(*extent_map):
+      self.assertEqual(offset, expected_offset)
+      self.assertGreater(size, 0)
+      self.assertEqual(layer, 0)
+
+      if flags & pyvmdk.extent_map_run_flags.IS_ZERO:
+        self.assertTrue(flags & pyvmdk.extent_map_run_flags.IS_SPARSE)
+
+      expected_offset += size
+
+    self.assertEqual(expected_offset, media_size)
+
+    if media_size > 8:
+      offsets, sizes, _, _, _, _ = vmdk_handle.get_extent_map(
+          offset=media_size - 8, size=4096)
+      self.assertEqual(len(offsets), 1)
+      self.assertEqual(offsets[0], media_size - 8)
+      self.assertEqual(sizes[0], 8)
+
+    with self.assertRaises(ValueError):
+      vmdk_handle.get_extent_map(offset=-1)
+
+    vmdk_handle.close()
+
+    # Test get_extent_map without open.
+    with self.assertRaises(IOError):
+      vmdk_handle.get_extent_map()
+
+  def test_get_allocated_ranges(self):
+    """Tests the get_allocated_ranges function."""
+    test_source = getattr(unittest, "source", None)
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    vmdk_handle = pyvmdk.handle()
+
+    vmdk_handle.open(test_source)
+    vmdk_handle.open_extent_data_files()
+
+    media_size = vmdk_handle.get_media_size()
+
+    allocated_ranges = vmdk_handle.get_allocated_ranges()
+    self.assertIsNotNone(allocated_ranges)
+    self.assertEqual(len(allocated_ranges), 2)
+
+    offsets, sizes = allocated_ranges
+    self.assertEqual(len(offsets), len(sizes))
+
+    last_end_offset = -1
+    for offset, size in zip(offsets, sizes):
+      # Adjacent allocated ranges are merged.
+      self.assertGreater(offset, last_end_offset)
+      self.assertGreater(size, 0)
+
+      last_end_offset = offset + size
+      self.assertLessEqual(last_end_offset, media_size)
+
+    # Data outside the allocated ranges reads as zeros.
+    hole_offset = 0
+    for offset, size in zip(offsets, sizes):
+      if offset > hole_offset:
+        break
+      hole_offset = offset + size
+
+    if hole_offset < media_size:
+      data = vmdk_handle.read_buffer_at_offset(1, hole_offset)
+      self.assertEqual(data, b"\x00")
+
+    with self.assertRaises(ValueError):
+      vmdk_handle.get_allocated_ranges(offset=-1)
+
+    vmdk_handle.close()
+
 
 if __name__ == "__main__":
   argument_parser = argparse.ArgumentParser()
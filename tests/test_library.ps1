@@ -1,6 +1,6 @@
 # Tests library functions and types.
 
-$LibraryTests = "bit_stream compression deflate descriptor_file error extent_descriptor extent_file extent_table extent_values grain_data grain_group grain_table huffman_tree io_handle notify system_string"
+$LibraryTests = "bit_stream change_tracking_file compression corrupted_range deflate descriptor_file error extent_descriptor extent_file extent_read_task extent_table extent_values grain_data grain_group grain_table huffman_tree io_handle notify read_request shared_cache system_string"
 $LibraryTestsWithInput = "handle support"
 $OptionSets = "" -split " "
 
@@ -1,6 +1,6 @@
 # Tests tools functions and types.
 
-$ToolsTests = "info_handle output signal"
+$ToolsTests = "check_handle export_handle hash_handle info_handle md5 output sha1 sha256 signal"
 $OptionSets = "" -split " "
 
 . .\test_functions.ps1
@@ -0,0 +1,1224 @@
+/*
+ * Library change_tracking_file type test program
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_functions.h"
+#include "vmdk_test_libbfio.h"
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_change_tracking_file.h"
+
+uint8_t vmdk_test_change_tracking_file_data1[ 544 ] = {
+	0xa2, 0x72, 0x19, 0xf6, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+	0xe8, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x80, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0x1c, 0x6e, 0x3a,
+	0x90, 0x4d, 0x2b, 0x7f, 0xa1, 0x38, 0x0c, 0x55, 0xe7, 0x91, 0x6d, 0x24, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x05, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00 };
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Tests the libvmdk_change_tracking_file_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_change_tracking_file_initialize(
+     void )
+{
+	libcerror_error_t *error                             = NULL;
+	libvmdk_change_tracking_file_t *change_tracking_file = NULL;
+	int result                                           = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests                      = 1;
+	int number_of_memset_fail_tests                      = 1;
+	int test_number                                      = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_change_tracking_file_initialize(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_free(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_change_tracking_file_initialize(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	change_tracking_file = (libvmdk_change_tracking_file_t *) 0x12345678UL;
+
+	result = libvmdk_change_tracking_file_initialize(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	change_tracking_file = NULL;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_change_tracking_file_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_change_tracking_file_initialize(
+		          &change_tracking_file,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( change_tracking_file != NULL )
+			{
+				libvmdk_change_tracking_file_free(
+				 &change_tracking_file,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "change_tracking_file",
+			 change_tracking_file );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_change_tracking_file_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_change_tracking_file_initialize(
+		          &change_tracking_file,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( change_tracking_file != NULL )
+			{
+				libvmdk_change_tracking_file_free(
+				 &change_tracking_file,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "change_tracking_file",
+			 change_tracking_file );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( change_tracking_file != NULL )
+	{
+		libvmdk_change_tracking_file_free(
+		 &change_tracking_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_change_tracking_file_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_change_tracking_file_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_change_tracking_file_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_change_tracking_file_read_file_header_data function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_change_tracking_file_read_file_header_data(
+     void )
+{
+	uint8_t data[ 512 ];
+
+	libcerror_error_t *error                             = NULL;
+	libvmdk_change_tracking_file_t *change_tracking_file = NULL;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_change_tracking_file_initialize(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_change_tracking_file_read_file_header_data(
+	          change_tracking_file,
+	          vmdk_test_change_tracking_file_data1,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "change_tracking_file->format_version",
+	 change_tracking_file->format_version,
+	 (uint32_t) 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "change_tracking_file->entries_offset",
+	 (int64_t) change_tracking_file->entries_offset,
+	 (int64_t) 512 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "change_tracking_file->media_size",
+	 (uint64_t) change_tracking_file->media_size,
+	 (uint64_t) 512000 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "change_tracking_file->number_of_entries",
+	 change_tracking_file->number_of_entries,
+	 (uint64_t) 8 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "change_tracking_file->entry_size",
+	 (uint64_t) change_tracking_file->entry_size,
+	 (uint64_t) 65536 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "change_tracking_file->change_sequence_number",
+	 change_tracking_file->change_sequence_number,
+	 (uint32_t) 5 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_change_tracking_file_read_file_header_data(
+	          NULL,
+	          vmdk_test_change_tracking_file_data1,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_read_file_header_data(
+	          change_tracking_file,
+	          NULL,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_read_file_header_data(
+	          change_tracking_file,
+	          vmdk_test_change_tracking_file_data1,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_read_file_header_data(
+	          change_tracking_file,
+	          vmdk_test_change_tracking_file_data1,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the signature is invalid
+	 */
+	if( memory_copy(
+	     data,
+	     vmdk_test_change_tracking_file_data1,
+	     512 ) == NULL )
+	{
+		goto on_error;
+	}
+	data[ 0 ] = 0xff;
+
+	result = libvmdk_change_tracking_file_read_file_header_data(
+	          change_tracking_file,
+	          data,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the entries do not cover the media
+	 */
+	data[ 0 ]  = 0xa2;
+	data[ 24 ] = 0x07;
+
+	result = libvmdk_change_tracking_file_read_file_header_data(
+	          change_tracking_file,
+	          data,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_change_tracking_file_free(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( change_tracking_file != NULL )
+	{
+		libvmdk_change_tracking_file_free(
+		 &change_tracking_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_change_tracking_file_read_file_header function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_change_tracking_file_read_file_header(
+     void )
+{
+	libbfio_handle_t *file_io_handle                     = NULL;
+	libcerror_error_t *error                             = NULL;
+	libvmdk_change_tracking_file_t *change_tracking_file = NULL;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_change_tracking_file_initialize(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_open_file_io_handle(
+	          &file_io_handle,
+	          vmdk_test_change_tracking_file_data1,
+	          544,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_change_tracking_file_read_file_header(
+	          change_tracking_file,
+	          file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "change_tracking_file->format_version",
+	 change_tracking_file->format_version,
+	 (uint32_t) 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "change_tracking_file->entries_offset",
+	 (int64_t) change_tracking_file->entries_offset,
+	 (int64_t) 512 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "change_tracking_file->media_size",
+	 (uint64_t) change_tracking_file->media_size,
+	 (uint64_t) 512000 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "change_tracking_file->number_of_entries",
+	 change_tracking_file->number_of_entries,
+	 (uint64_t) 8 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "change_tracking_file->entry_size",
+	 (uint64_t) change_tracking_file->entry_size,
+	 (uint64_t) 65536 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "change_tracking_file->change_sequence_number",
+	 change_tracking_file->change_sequence_number,
+	 (uint32_t) 5 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_change_tracking_file_read_file_header(
+	          NULL,
+	          file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_read_file_header(
+	          change_tracking_file,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up file IO handle
+	 */
+	result = vmdk_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test read_file_header with data too small to contain the file header
+	 */
+	result = vmdk_test_open_file_io_handle(
+	          &file_io_handle,
+	          vmdk_test_change_tracking_file_data1,
+	          256,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_read_file_header(
+	          change_tracking_file,
+	          file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = vmdk_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test read_file_header with data too small to contain the change sequence number entries
+	 */
+	result = vmdk_test_open_file_io_handle(
+	          &file_io_handle,
+	          vmdk_test_change_tracking_file_data1,
+	          540,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_read_file_header(
+	          change_tracking_file,
+	          file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = vmdk_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libvmdk_change_tracking_file_free(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( change_tracking_file != NULL )
+	{
+		libvmdk_change_tracking_file_free(
+		 &change_tracking_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_change_tracking_file_get_changed_range function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_change_tracking_file_get_changed_range(
+     void )
+{
+	libbfio_handle_t *file_io_handle                     = NULL;
+	libcerror_error_t *error                             = NULL;
+	libvmdk_change_tracking_file_t *change_tracking_file = NULL;
+	size64_t range_size                                  = 0;
+	off64_t range_offset                                 = 0;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	result = vmdk_test_open_file_io_handle(
+	          &file_io_handle,
+	          vmdk_test_change_tracking_file_data1,
+	          544,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_initialize(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_read_file_header(
+	          change_tracking_file,
+	          file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_change_tracking_file_get_changed_range(
+	          change_tracking_file,
+	          file_io_handle,
+	          2,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 65536 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 131072 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_get_changed_range(
+	          change_tracking_file,
+	          file_io_handle,
+	          2,
+	          196608,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 262144 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 65536 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The last range is limited to the media size
+	 */
+	result = libvmdk_change_tracking_file_get_changed_range(
+	          change_tracking_file,
+	          file_io_handle,
+	          2,
+	          327680,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 458752 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 53248 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_get_changed_range(
+	          change_tracking_file,
+	          file_io_handle,
+	          2,
+	          512000,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that nothing has changed since the current change sequence number
+	 */
+	result = libvmdk_change_tracking_file_get_changed_range(
+	          change_tracking_file,
+	          file_io_handle,
+	          5,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_change_tracking_file_get_changed_range(
+	          NULL,
+	          file_io_handle,
+	          2,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_get_changed_range(
+	          change_tracking_file,
+	          file_io_handle,
+	          2,
+	          -1,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_get_changed_range(
+	          change_tracking_file,
+	          file_io_handle,
+	          2,
+	          0,
+	          NULL,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_get_changed_range(
+	          change_tracking_file,
+	          file_io_handle,
+	          2,
+	          0,
+	          &range_offset,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_change_tracking_file_free(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( change_tracking_file != NULL )
+	{
+		libvmdk_change_tracking_file_free(
+		 &change_tracking_file,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_change_tracking_file_initialize",
+	 vmdk_test_change_tracking_file_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_change_tracking_file_free",
+	 vmdk_test_change_tracking_file_free );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_change_tracking_file_read_file_header_data",
+	 vmdk_test_change_tracking_file_read_file_header_data );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_change_tracking_file_read_file_header",
+	 vmdk_test_change_tracking_file_read_file_header );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_change_tracking_file_get_changed_range",
+	 vmdk_test_change_tracking_file_get_changed_range );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,533 @@
+/*
+ * Library corrupted_range type test program
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_corrupted_range.h"
+#include "../libvmdk/libvmdk_libcdata.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Tests the libvmdk_corrupted_range_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_corrupted_range_initialize(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libvmdk_corrupted_range_t *corrupted_range = NULL;
+	int result                                 = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests            = 1;
+	int number_of_memset_fail_tests            = 1;
+	int test_number                            = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_corrupted_range_initialize(
+	          &corrupted_range,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "corrupted_range",
+	 corrupted_range );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_corrupted_range_free(
+	          &corrupted_range,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "corrupted_range",
+	 corrupted_range );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_corrupted_range_initialize(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	corrupted_range = (libvmdk_corrupted_range_t *) 0x12345678UL;
+
+	result = libvmdk_corrupted_range_initialize(
+	          &corrupted_range,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	corrupted_range = NULL;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_corrupted_range_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_corrupted_range_initialize(
+		          &corrupted_range,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( corrupted_range != NULL )
+			{
+				libvmdk_corrupted_range_free(
+				 &corrupted_range,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "corrupted_range",
+			 corrupted_range );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_corrupted_range_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_corrupted_range_initialize(
+		          &corrupted_range,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( corrupted_range != NULL )
+			{
+				libvmdk_corrupted_range_free(
+				 &corrupted_range,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "corrupted_range",
+			 corrupted_range );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( corrupted_range != NULL )
+	{
+		libvmdk_corrupted_range_free(
+		 &corrupted_range,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_corrupted_range_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_corrupted_range_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_corrupted_range_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_corrupted_range_append_to_array function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_corrupted_range_append_to_array(
+     void )
+{
+	libcdata_array_t *corrupted_ranges_array   = NULL;
+	libcerror_error_t *error                   = NULL;
+	libvmdk_corrupted_range_t *corrupted_range = NULL;
+	int number_of_entries                      = 0;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libcdata_array_initialize(
+	          &corrupted_ranges_array,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "corrupted_ranges_array",
+	 corrupted_ranges_array );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_corrupted_range_append_to_array(
+	          corrupted_ranges_array,
+	          65536,
+	          65536,
+	          0,
+	          LIBVMDK_CORRUPTION_FLAG_DECOMPRESSION_FAILED,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a contiguous range with the same flags is merged
+	 */
+	result = libvmdk_corrupted_range_append_to_array(
+	          corrupted_ranges_array,
+	          131072,
+	          65536,
+	          0,
+	          LIBVMDK_CORRUPTION_FLAG_DECOMPRESSION_FAILED,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a contiguous range with different flags is not merged
+	 */
+	result = libvmdk_corrupted_range_append_to_array(
+	          corrupted_ranges_array,
+	          196608,
+	          65536,
+	          0,
+	          LIBVMDK_CORRUPTION_FLAG_OUT_OF_BOUNDS,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_get_number_of_entries(
+	          corrupted_ranges_array,
+	          &number_of_entries,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 2 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_get_entry_by_index(
+	          corrupted_ranges_array,
+	          0,
+	          (intptr_t **) &corrupted_range,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "corrupted_range",
+	 corrupted_range );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "corrupted_range->offset",
+	 (int64_t) corrupted_range->offset,
+	 (int64_t) 65536 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "corrupted_range->size",
+	 (uint64_t) corrupted_range->size,
+	 (uint64_t) 131072 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_corrupted_range_append_to_array(
+	          NULL,
+	          65536,
+	          65536,
+	          0,
+	          LIBVMDK_CORRUPTION_FLAG_DECOMPRESSION_FAILED,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_corrupted_range_append_to_array(
+	          corrupted_ranges_array,
+	          -1,
+	          65536,
+	          0,
+	          LIBVMDK_CORRUPTION_FLAG_DECOMPRESSION_FAILED,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcdata_array_free(
+	          &corrupted_ranges_array,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_corrupted_range_free,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "corrupted_ranges_array",
+	 corrupted_ranges_array );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( corrupted_ranges_array != NULL )
+	{
+		libcdata_array_free(
+		 &corrupted_ranges_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_corrupted_range_free,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_corrupted_range_initialize",
+	 vmdk_test_corrupted_range_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_corrupted_range_free",
+	 vmdk_test_corrupted_range_free );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_corrupted_range_append_to_array",
+	 vmdk_test_corrupted_range_append_to_array );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+}
+
@@ -965,6 +965,578 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvmdk_descriptor_file_get_utf8_change_tracking_filename_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_descriptor_file_get_utf8_change_tracking_filename_size(
+     void )
+{
+	libcerror_error_t *error                      = NULL;
+	libvmdk_descriptor_file_t *descriptor_file    = NULL;
+	size_t utf8_change_tracking_filename_size     = 0;
+	int result                                    = 0;
+	int utf8_change_tracking_filename_size_is_set = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_descriptor_file_initialize(
+	          &descriptor_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "descriptor_file",
+	 descriptor_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_descriptor_file_get_utf8_change_tracking_filename_size(
+	          descriptor_file,
+	          &utf8_change_tracking_filename_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	utf8_change_tracking_filename_size_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libvmdk_descriptor_file_get_utf8_change_tracking_filename_size(
+	          NULL,
+	          &utf8_change_tracking_filename_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( utf8_change_tracking_filename_size_is_set != 0 )
+	{
+		result = libvmdk_descriptor_file_get_utf8_change_tracking_filename_size(
+		          descriptor_file,
+		          NULL,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Clean up
+	 */
+	result = libvmdk_descriptor_file_free(
+	          &descriptor_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "descriptor_file",
+	 descriptor_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( descriptor_file != NULL )
+	{
+		libvmdk_descriptor_file_free(
+		 &descriptor_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_descriptor_file_get_utf8_change_tracking_filename function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_descriptor_file_get_utf8_change_tracking_filename(
+     void )
+{
+	uint8_t utf8_change_tracking_filename[ 512 ];
+
+	libcerror_error_t *error                   = NULL;
+	libvmdk_descriptor_file_t *descriptor_file = NULL;
+	int result                                 = 0;
+	int utf8_change_tracking_filename_is_set   = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_descriptor_file_initialize(
+	          &descriptor_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "descriptor_file",
+	 descriptor_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_descriptor_file_get_utf8_change_tracking_filename(
+	          descriptor_file,
+	          utf8_change_tracking_filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	utf8_change_tracking_filename_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libvmdk_descriptor_file_get_utf8_change_tracking_filename(
+	          NULL,
+	          utf8_change_tracking_filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( utf8_change_tracking_filename_is_set != 0 )
+	{
+		result = libvmdk_descriptor_file_get_utf8_change_tracking_filename(
+		          descriptor_file,
+		          NULL,
+		          512,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvmdk_descriptor_file_get_utf8_change_tracking_filename(
+		          descriptor_file,
+		          utf8_change_tracking_filename,
+		          0,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvmdk_descriptor_file_get_utf8_change_tracking_filename(
+		          descriptor_file,
+		          utf8_change_tracking_filename,
+		          (size_t) SSIZE_MAX + 1,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Clean up
+	 */
+	result = libvmdk_descriptor_file_free(
+	          &descriptor_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "descriptor_file",
+	 descriptor_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( descriptor_file != NULL )
+	{
+		libvmdk_descriptor_file_free(
+		 &descriptor_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_descriptor_file_get_utf16_change_tracking_filename_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_descriptor_file_get_utf16_change_tracking_filename_size(
+     void )
+{
+	libcerror_error_t *error                       = NULL;
+	libvmdk_descriptor_file_t *descriptor_file     = NULL;
+	size_t utf16_change_tracking_filename_size     = 0;
+	int result                                     = 0;
+	int utf16_change_tracking_filename_size_is_set = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_descriptor_file_initialize(
+	          &descriptor_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "descriptor_file",
+	 descriptor_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_descriptor_file_get_utf16_change_tracking_filename_size(
+	          descriptor_file,
+	          &utf16_change_tracking_filename_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	utf16_change_tracking_filename_size_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libvmdk_descriptor_file_get_utf16_change_tracking_filename_size(
+	          NULL,
+	          &utf16_change_tracking_filename_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( utf16_change_tracking_filename_size_is_set != 0 )
+	{
+		result = libvmdk_descriptor_file_get_utf16_change_tracking_filename_size(
+		          descriptor_file,
+		          NULL,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Clean up
+	 */
+	result = libvmdk_descriptor_file_free(
+	          &descriptor_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "descriptor_file",
+	 descriptor_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( descriptor_file != NULL )
+	{
+		libvmdk_descriptor_file_free(
+		 &descriptor_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_descriptor_file_get_utf16_change_tracking_filename function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_descriptor_file_get_utf16_change_tracking_filename(
+     void )
+{
+	uint16_t utf16_change_tracking_filename[ 512 ];
+
+	libcerror_error_t *error                   = NULL;
+	libvmdk_descriptor_file_t *descriptor_file = NULL;
+	int result                                 = 0;
+	int utf16_change_tracking_filename_is_set  = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_descriptor_file_initialize(
+	          &descriptor_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "descriptor_file",
+	 descriptor_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_descriptor_file_get_utf16_change_tracking_filename(
+	          descriptor_file,
+	          utf16_change_tracking_filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	utf16_change_tracking_filename_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libvmdk_descriptor_file_get_utf16_change_tracking_filename(
+	          NULL,
+	          utf16_change_tracking_filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( utf16_change_tracking_filename_is_set != 0 )
+	{
+		result = libvmdk_descriptor_file_get_utf16_change_tracking_filename(
+		          descriptor_file,
+		          NULL,
+		          512,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvmdk_descriptor_file_get_utf16_change_tracking_filename(
+		          descriptor_file,
+		          utf16_change_tracking_filename,
+		          0,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvmdk_descriptor_file_get_utf16_change_tracking_filename(
+		          descriptor_file,
+		          utf16_change_tracking_filename,
+		          (size_t) SSIZE_MAX + 1,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Clean up
+	 */
+	result = libvmdk_descriptor_file_free(
+	          &descriptor_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "descriptor_file",
+	 descriptor_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( descriptor_file != NULL )
+	{
+		libvmdk_descriptor_file_free(
+		 &descriptor_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
 
 /* The main program
@@ -1026,6 +1598,22 @@ int main(
 	 "libvmdk_descriptor_file_get_utf16_parent_filename",
 	 vmdk_test_descriptor_file_get_utf16_parent_filename );
 
+	VMDK_TEST_RUN(
+	 "libvmdk_descriptor_file_get_utf8_change_tracking_filename_size",
+	 vmdk_test_descriptor_file_get_utf8_change_tracking_filename_size );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_descriptor_file_get_utf8_change_tracking_filename",
+	 vmdk_test_descriptor_file_get_utf8_change_tracking_filename );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_descriptor_file_get_utf16_change_tracking_filename_size",
+	 vmdk_test_descriptor_file_get_utf16_change_tracking_filename_size );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_descriptor_file_get_utf16_change_tracking_filename",
+	 vmdk_test_descriptor_file_get_utf16_change_tracking_filename );
+
 	/* TODO: add tests for libvmdk_descriptor_file_get_disk_type */
 
 	/* TODO: add tests for libvmdk_descriptor_file_get_media_size */
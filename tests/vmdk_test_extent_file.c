@@ -33,6 +33,7 @@
 #include "vmdk_test_memory.h"
 #include "vmdk_test_unused.h"
 
+#include "../libvmdk/libvmdk_definitions.h"
 #include "../libvmdk/libvmdk_extent_file.h"
 #include "../libvmdk/libvmdk_io_handle.h"
 
@@ -338,6 +339,359 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvmdk_extent_file_validate function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_extent_file_validate(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libvmdk_extent_file_t *extent_file = NULL;
+	libvmdk_io_handle_t *io_handle     = NULL;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->disk_type = LIBVMDK_DISK_TYPE_SPARSE_2GB_EXTENT;
+
+	result = libvmdk_extent_file_initialize(
+	          &extent_file,
+	          io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_file",
+	 extent_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	extent_file->file_type          = LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA;
+	extent_file->grain_size         = 65536;
+	extent_file->storage_media_size = 1048576;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_extent_file_validate(
+	          extent_file,
+	          io_handle,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "io_handle->grain_size",
+	 (uint64_t) io_handle->grain_size,
+	 (uint64_t) 65536 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "io_handle->is_dirty",
+	 io_handle->is_dirty,
+	 0 );
+
+	extent_file->is_dirty = 1;
+
+	result = libvmdk_extent_file_validate(
+	          extent_file,
+	          io_handle,
+	          1,
+	          1048576,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "io_handle->is_dirty",
+	 io_handle->is_dirty,
+	 1 );
+
+	/* The storage media size is rounded up to the grain size
+	 */
+	result = libvmdk_extent_file_validate(
+	          extent_file,
+	          io_handle,
+	          1,
+	          1048576 - 512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_extent_file_validate(
+	          NULL,
+	          io_handle,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_extent_file_validate(
+	          extent_file,
+	          NULL,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the storage media size is smaller than the mapped size
+	 */
+	result = libvmdk_extent_file_validate(
+	          extent_file,
+	          io_handle,
+	          1,
+	          2097152,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the storage media size exceeds the mapped size by a grain or more
+	 */
+	result = libvmdk_extent_file_validate(
+	          extent_file,
+	          io_handle,
+	          1,
+	          1048576 - 65536,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the grain size differs from the first extent file
+	 */
+	extent_file->grain_size = 4096;
+
+	result = libvmdk_extent_file_validate(
+	          extent_file,
+	          io_handle,
+	          1,
+	          0,
+	          &error );
+
+	extent_file->grain_size = 65536;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where grain compression is used by a disk type that is not stream optimized
+	 */
+	extent_file->flags = LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION;
+
+	result = libvmdk_extent_file_validate(
+	          extent_file,
+	          io_handle,
+	          1,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	io_handle->disk_type = LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED;
+
+	result = libvmdk_extent_file_validate(
+	          extent_file,
+	          io_handle,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error case where the extent file type is not supported
+	 */
+	extent_file->file_type = LIBVMDK_FILE_TYPE_DESCRIPTOR_FILE;
+
+	result = libvmdk_extent_file_validate(
+	          extent_file,
+	          io_handle,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_extent_file_free(
+	          &extent_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "extent_file",
+	 extent_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extent_file != NULL )
+	{
+		libvmdk_extent_file_free(
+		 &extent_file,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libvmdk_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
 
 /* The main program
@@ -383,6 +737,10 @@ int main(
 
 	/* TODO: add tests for libvmdk_extent_file_read_grains_scan */
 
+	VMDK_TEST_RUN(
+	 "libvmdk_extent_file_validate",
+	 vmdk_test_extent_file_validate );
+
 	/* TODO: add tests for libvmdk_extent_file_read_element_data */
 
 	/* TODO: add tests for libvmdk_extent_file_read_grain_group_element_data */
@@ -391,6 +749,10 @@ int main(
 
 	/* TODO: add tests for libvmdk_extent_file_get_grain_group_at_offset */
 
+	/* TODO: add tests for libvmdk_extent_file_get_grain_group_range_at_offset */
+
+	/* TODO: add tests for libvmdk_extent_file_get_grain_group_by_index */
+
 	/* TODO: add tests for libvmdk_extent_file_read_segment_data */
 
 	/* TODO: add tests for libvmdk_extent_file_seek_segment_offset */
@@ -0,0 +1,702 @@
+/*
+ * Library extent_read_task type test program
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_functions.h"
+#include "vmdk_test_libbfio.h"
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_extent_read_task.h"
+#include "../libvmdk/libvmdk_io_handle.h"
+
+uint8_t vmdk_test_extent_read_task_data1[ 64 ] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Tests the libvmdk_extent_read_task_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_extent_read_task_initialize(
+     void )
+{
+	libbfio_handle_t *file_io_handle             = NULL;
+	libbfio_pool_t *file_io_pool                 = NULL;
+	libcerror_error_t *error                     = NULL;
+	libvmdk_extent_read_task_t *extent_read_task = NULL;
+	libvmdk_io_handle_t *io_handle               = NULL;
+	int file_io_pool_entry                       = 0;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_open_file_io_handle(
+	          &file_io_handle,
+	          vmdk_test_extent_read_task_data1,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_initialize(
+	          &file_io_pool,
+	          0,
+	          LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_pool",
+	 file_io_pool );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_append_handle(
+	          file_io_pool,
+	          &file_io_pool_entry,
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	file_io_handle = NULL;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_extent_read_task_initialize(
+	          &extent_read_task,
+	          io_handle,
+	          file_io_pool,
+	          0,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_read_task",
+	 extent_read_task );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_read_task_free(
+	          &extent_read_task,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "extent_read_task",
+	 extent_read_task );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_extent_read_task_initialize(
+	          NULL,
+	          io_handle,
+	          file_io_pool,
+	          0,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	extent_read_task = (libvmdk_extent_read_task_t *) 0x12345678UL;
+
+	result = libvmdk_extent_read_task_initialize(
+	          &extent_read_task,
+	          io_handle,
+	          file_io_pool,
+	          0,
+	          64,
+	          &error );
+
+	extent_read_task = NULL;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_extent_read_task_initialize(
+	          &extent_read_task,
+	          NULL,
+	          file_io_pool,
+	          0,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "extent_read_task",
+	 extent_read_task );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_extent_read_task_initialize(
+	          &extent_read_task,
+	          io_handle,
+	          NULL,
+	          0,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "extent_read_task",
+	 extent_read_task );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_extent_read_task_initialize(
+	          &extent_read_task,
+	          io_handle,
+	          file_io_pool,
+	          -1,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "extent_read_task",
+	 extent_read_task );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfio_pool_close_all(
+	          file_io_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_free(
+	          &file_io_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "file_io_pool",
+	 file_io_pool );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extent_read_task != NULL )
+	{
+		libvmdk_extent_read_task_free(
+		 &extent_read_task,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libvmdk_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_extent_read_task_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_extent_read_task_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result                                   = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_extent_read_task_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_extent_read_task_run function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_extent_read_task_run(
+     void )
+{
+	libbfio_handle_t *file_io_handle             = NULL;
+	libbfio_pool_t *file_io_pool                 = NULL;
+	libcerror_error_t *error                     = NULL;
+	libvmdk_extent_read_task_t *extent_read_task = NULL;
+	libvmdk_io_handle_t *io_handle               = NULL;
+	int file_io_pool_entry                       = 0;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_open_file_io_handle(
+	          &file_io_handle,
+	          vmdk_test_extent_read_task_data1,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_initialize(
+	          &file_io_pool,
+	          0,
+	          LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_pool",
+	 file_io_pool );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_append_handle(
+	          file_io_pool,
+	          &file_io_pool_entry,
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	file_io_handle = NULL;
+
+	result = libvmdk_extent_read_task_initialize(
+	          &extent_read_task,
+	          io_handle,
+	          file_io_pool,
+	          0,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_read_task",
+	 extent_read_task );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_extent_read_task_run(
+	          NULL,
+	          NULL );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Test run with data that does not contain an extent file header
+	 */
+	result = libvmdk_extent_read_task_run(
+	          extent_read_task,
+	          NULL );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "extent_read_task->result",
+	 extent_read_task->result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_read_task->error",
+	 extent_read_task->error );
+
+	/* Clean up
+	 */
+	result = libvmdk_extent_read_task_free(
+	          &extent_read_task,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "extent_read_task",
+	 extent_read_task );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_close_all(
+	          file_io_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_free(
+	          &file_io_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "file_io_pool",
+	 file_io_pool );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extent_read_task != NULL )
+	{
+		libvmdk_extent_read_task_free(
+		 &extent_read_task,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libvmdk_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_extent_read_task_initialize",
+	 vmdk_test_extent_read_task_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_extent_read_task_free",
+	 vmdk_test_extent_read_task_free );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_extent_read_task_run",
+	 vmdk_test_extent_read_task_run );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+}
+
@@ -37,6 +37,7 @@
 #include "vmdk_test_memory.h"
 #include "vmdk_test_unused.h"
 
+#include "../libvmdk/libvmdk_extent_file.h"
 #include "../libvmdk/libvmdk_extent_table.h"
 #include "../libvmdk/libvmdk_extent_values.h"
 #include "../libvmdk/libvmdk_io_handle.h"
@@ -2084,6 +2085,1344 @@ on_error:
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
+/* Tests the libvmdk_extent_table_calculate_extent_offsets function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_extent_table_calculate_extent_offsets(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libvmdk_extent_table_t *extent_table   = NULL;
+	libvmdk_extent_values_t *extent_values = NULL;
+	libvmdk_io_handle_t *io_handle         = NULL;
+	size64_t *extent_sizes                 = NULL;
+	off64_t extent_data_offset             = 0;
+	int extent_index                       = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_initialize(
+	          &extent_table,
+	          io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_table",
+	 extent_table );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases without extents
+	 */
+	result = libvmdk_extent_table_calculate_extent_offsets(
+	          extent_table,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_table->uniform_extent_size",
+	 (uint64_t) extent_table->uniform_extent_size,
+	 (uint64_t) 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "extent_table->extent_offsets_are_dirty",
+	 extent_table->extent_offsets_are_dirty,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_initialize_extents(
+	          extent_table,
+	          4,
+	          LIBVMDK_DISK_TYPE_SPARSE_2GB_EXTENT,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_values_initialize(
+	          &extent_values,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_values",
+	 extent_values );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	extent_values->type = LIBVMDK_EXTENT_TYPE_SPARSE;
+
+	for( extent_index = 0;
+	     extent_index < 4;
+	     extent_index++ )
+	{
+		result = libvmdk_extent_table_set_extent_by_extent_values(
+		          extent_table,
+		          extent_values,
+		          extent_index,
+		          extent_index,
+		          4096,
+		          0,
+		          ( extent_index < 3 ) ? 1024 : 512,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "extent_table->extent_offsets_are_dirty",
+	 extent_table->extent_offsets_are_dirty,
+	 1 );
+
+	/* Test regular cases with extents of equal size and a smaller last extent
+	 */
+	result = libvmdk_extent_table_calculate_extent_offsets(
+	          extent_table,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_table->uniform_extent_size",
+	 (uint64_t) extent_table->uniform_extent_size,
+	 (uint64_t) 1024 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "extent_table->extent_offsets_are_dirty",
+	 extent_table->extent_offsets_are_dirty,
+	 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_table->extent_offsets[ 3 ]",
+	 (int64_t) extent_table->extent_offsets[ 3 ],
+	 (int64_t) 3072 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_table->extent_offsets[ 4 ]",
+	 (int64_t) extent_table->extent_offsets[ 4 ],
+	 (int64_t) 3584 );
+
+	/* The extent index of an offset in the last extent is calculated by division
+	 */
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          3583,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "extent_index",
+	 extent_index,
+	 3 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_data_offset",
+	 (int64_t) extent_data_offset,
+	 (int64_t) 511 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases with a last extent that is larger than the other extents
+	 */
+	result = libvmdk_extent_table_set_extent_storage_media_size_by_index(
+	          extent_table,
+	          3,
+	          2048,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_calculate_extent_offsets(
+	          extent_table,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_table->uniform_extent_size",
+	 (uint64_t) extent_table->uniform_extent_size,
+	 (uint64_t) 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_table->extent_offsets[ 4 ]",
+	 (int64_t) extent_table->extent_offsets[ 4 ],
+	 (int64_t) 5120 );
+
+	/* The extent index of an offset in the last extent is searched
+	 */
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          5119,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "extent_index",
+	 extent_index,
+	 3 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_data_offset",
+	 (int64_t) extent_data_offset,
+	 (int64_t) 2047 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          5120,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases with extents of different size and an empty extent
+	 */
+	result = libvmdk_extent_table_set_extent_storage_media_size_by_index(
+	          extent_table,
+	          1,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_calculate_extent_offsets(
+	          extent_table,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_table->uniform_extent_size",
+	 (uint64_t) extent_table->uniform_extent_size,
+	 (uint64_t) 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_table->extent_offsets[ 1 ]",
+	 (int64_t) extent_table->extent_offsets[ 1 ],
+	 (int64_t) 1024 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_table->extent_offsets[ 2 ]",
+	 (int64_t) extent_table->extent_offsets[ 2 ],
+	 (int64_t) 1024 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_table->extent_offsets[ 4 ]",
+	 (int64_t) extent_table->extent_offsets[ 4 ],
+	 (int64_t) 4096 );
+
+	/* The search skips over the empty extent
+	 */
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          1024,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "extent_index",
+	 extent_index,
+	 2 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_data_offset",
+	 (int64_t) extent_data_offset,
+	 (int64_t) 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          2048,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "extent_index",
+	 extent_index,
+	 3 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_data_offset",
+	 (int64_t) extent_data_offset,
+	 (int64_t) 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          4095,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "extent_index",
+	 extent_index,
+	 3 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_data_offset",
+	 (int64_t) extent_data_offset,
+	 (int64_t) 2047 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_extent_table_calculate_extent_offsets(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	extent_sizes = extent_table->extent_sizes;
+
+	extent_table->extent_sizes = NULL;
+
+	result = libvmdk_extent_table_calculate_extent_offsets(
+	          extent_table,
+	          &error );
+
+	extent_table->extent_sizes = extent_sizes;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the extent sizes exceed the maximum offset
+	 */
+	extent_table->extent_sizes[ 2 ] = (size64_t) INT64_MAX;
+
+	result = libvmdk_extent_table_calculate_extent_offsets(
+	          extent_table,
+	          &error );
+
+	extent_table->extent_sizes[ 2 ] = 1024;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_extent_values_free(
+	          &extent_values,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "extent_values",
+	 extent_values );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_free(
+	          &extent_table,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "extent_table",
+	 extent_table );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extent_values != NULL )
+	{
+		libvmdk_extent_values_free(
+		 &extent_values,
+		 NULL );
+	}
+	if( extent_table != NULL )
+	{
+		libvmdk_extent_table_free(
+		 &extent_table,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libvmdk_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_extent_table_get_extent_index_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_extent_table_get_extent_index_at_offset(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libvmdk_extent_table_t *extent_table   = NULL;
+	libvmdk_extent_values_t *extent_values = NULL;
+	libvmdk_io_handle_t *io_handle         = NULL;
+	off64_t extent_data_offset             = 0;
+	int extent_index                       = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_initialize(
+	          &extent_table,
+	          io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_table",
+	 extent_table );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_initialize_extents(
+	          extent_table,
+	          3,
+	          LIBVMDK_DISK_TYPE_SPARSE_2GB_EXTENT,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_values_initialize(
+	          &extent_values,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_values",
+	 extent_values );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	extent_values->type = LIBVMDK_EXTENT_TYPE_SPARSE;
+
+	for( extent_index = 0;
+	     extent_index < 3;
+	     extent_index++ )
+	{
+		result = libvmdk_extent_table_set_extent_by_extent_values(
+		          extent_table,
+		          extent_values,
+		          extent_index,
+		          extent_index,
+		          4096,
+		          0,
+		          ( extent_index < 2 ) ? 1024 : 512,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases with extents of equal size
+	 */
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          1536,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "extent_index",
+	 extent_index,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_data_offset",
+	 (int64_t) extent_data_offset,
+	 (int64_t) 512 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          2559,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "extent_index",
+	 extent_index,
+	 2 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_data_offset",
+	 (int64_t) extent_data_offset,
+	 (int64_t) 511 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          2560,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases with extents of different size
+	 */
+	result = libvmdk_extent_table_set_extent_storage_media_size_by_index(
+	          extent_table,
+	          1,
+	          2048,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          3071,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "extent_index",
+	 extent_index,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_data_offset",
+	 (int64_t) extent_data_offset,
+	 (int64_t) 2047 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          3072,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "extent_index",
+	 extent_index,
+	 2 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "extent_data_offset",
+	 (int64_t) extent_data_offset,
+	 (int64_t) 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          NULL,
+	          0,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          -1,
+	          &extent_index,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          0,
+	          NULL,
+	          &extent_data_offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          0,
+	          &extent_index,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_extent_values_free(
+	          &extent_values,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "extent_values",
+	 extent_values );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_free(
+	          &extent_table,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "extent_table",
+	 extent_table );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extent_values != NULL )
+	{
+		libvmdk_extent_values_free(
+		 &extent_values,
+		 NULL );
+	}
+	if( extent_table != NULL )
+	{
+		libvmdk_extent_table_free(
+		 &extent_table,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libvmdk_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_extent_table_set_extent_file_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_extent_table_set_extent_file_by_index(
+     void )
+{
+	libvmdk_extent_file_t *extent_files[ 6 ];
+
+	libcerror_error_t *error               = NULL;
+	libvmdk_extent_file_t *extent_file     = NULL;
+	libvmdk_extent_table_t *extent_table   = NULL;
+	libvmdk_extent_values_t *extent_values = NULL;
+	libvmdk_io_handle_t *io_handle         = NULL;
+	off64_t extent_offset                  = 0;
+	int extent_index                       = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_initialize(
+	          &extent_table,
+	          io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_table",
+	 extent_table );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Use more extents than LIBVMDK_MAXIMUM_CACHE_ENTRIES_EXTENT_FILES
+	 */
+	result = libvmdk_extent_table_initialize_extents(
+	          extent_table,
+	          6,
+	          LIBVMDK_DISK_TYPE_SPARSE_2GB_EXTENT,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_values_initialize(
+	          &extent_values,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_values",
+	 extent_values );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	extent_values->type = LIBVMDK_EXTENT_TYPE_SPARSE;
+
+	for( extent_index = 0;
+	     extent_index < 6;
+	     extent_index++ )
+	{
+		result = libvmdk_extent_table_set_extent_by_extent_values(
+		          extent_table,
+		          extent_values,
+		          extent_index,
+		          extent_index,
+		          4096,
+		          0,
+		          1024,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	for( extent_index = 0;
+	     extent_index < 6;
+	     extent_index++ )
+	{
+		result = libvmdk_extent_file_initialize(
+		          &extent_file,
+		          io_handle,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "extent_file",
+		 extent_file );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvmdk_extent_table_set_extent_file_by_index(
+		          extent_table,
+		          NULL,
+		          extent_index,
+		          extent_file,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The extent table takes over management of the extent file
+		 */
+		extent_files[ extent_index ] = extent_file;
+
+		extent_file = NULL;
+	}
+	/* Retrieve the extent files without a file IO pool, which only succeeds
+	 * if they are still cached and do not need to be read again
+	 */
+	for( extent_index = 0;
+	     extent_index < 6;
+	     extent_index++ )
+	{
+		result = libvmdk_extent_table_get_extent_file_by_index(
+		          extent_table,
+		          extent_index,
+		          NULL,
+		          &extent_offset,
+		          &extent_file,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT64(
+		 "extent_offset",
+		 (int64_t) extent_offset,
+		 (int64_t) extent_index * 1024 );
+
+		VMDK_TEST_ASSERT_EQUAL_INTPTR(
+		 "extent_file",
+		 (intptr_t) extent_file,
+		 (intptr_t) extent_files[ extent_index ] );
+
+		extent_file = NULL;
+	}
+	/* Test error cases
+	 */
+	result = libvmdk_extent_file_initialize(
+	          &extent_file,
+	          io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_file",
+	 extent_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_set_extent_file_by_index(
+	          NULL,
+	          NULL,
+	          0,
+	          extent_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_extent_table_set_extent_file_by_index(
+	          extent_table,
+	          NULL,
+	          -1,
+	          extent_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_extent_table_set_extent_file_by_index(
+	          extent_table,
+	          NULL,
+	          0,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_extent_file_free(
+	          &extent_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "extent_file",
+	 extent_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_values_free(
+	          &extent_values,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "extent_values",
+	 extent_values );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_table_free(
+	          &extent_table,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "extent_table",
+	 extent_table );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extent_values != NULL )
+	{
+		libvmdk_extent_values_free(
+		 &extent_values,
+		 NULL );
+	}
+	if( extent_table != NULL )
+	{
+		libvmdk_extent_table_free(
+		 &extent_table,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libvmdk_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
 
 /* The main program
@@ -2155,8 +3494,20 @@ int main(
 
 	/* TODO: add tests for libvmdk_extent_table_set_extent_storage_media_size_by_index */
 
+	VMDK_TEST_RUN(
+	 "libvmdk_extent_table_calculate_extent_offsets",
+	 vmdk_test_extent_table_calculate_extent_offsets );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_extent_table_get_extent_index_at_offset",
+	 vmdk_test_extent_table_get_extent_index_at_offset );
+
 	/* TODO: add tests for libvmdk_extent_table_get_extent_file_at_offset */
 
+	VMDK_TEST_RUN(
+	 "libvmdk_extent_table_set_extent_file_by_index",
+	 vmdk_test_extent_table_set_extent_file_by_index );
+
 	/* TODO: add tests for libvmdk_extent_table_set_extent_by_extent_values */
 
 #endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
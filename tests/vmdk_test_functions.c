@@ -20,7 +20,9 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -30,10 +32,46 @@
 #include <stdlib.h>
 #endif
 
+#include "vmdk_test_functions.h"
 #include "vmdk_test_libbfio.h"
 #include "vmdk_test_libcerror.h"
 #include "vmdk_test_libclocale.h"
 #include "vmdk_test_libuna.h"
+#include "vmdk_test_libvmdk.h"
+
+#if !defined( LIBVMDK_HAVE_BFIO )
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_open_file_io_handle(
+     libvmdk_handle_t *handle,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
+     libvmdk_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_open_extent_data_files_file_io_pool(
+     libvmdk_handle_t *handle,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_error_t **error );
+
+#endif /* !defined( LIBVMDK_HAVE_BFIO ) */
+
+/* The descriptor of a sparse test image, which contains the number of sectors of the extent
+ */
+static const char *vmdk_test_sparse_image_descriptor = \
+	"# Disk DescriptorFile\n"
+	"version=1\n"
+	"CID=a1b2c3d4\n"
+	"parentCID=ffffffff\n"
+	"createType=\"monolithicSparse\"\n"
+	"\n"
+	"# Extent description\n"
+	"RW %" PRIu64 " SPARSE \"test.vmdk\"\n"
+	"\n"
+	"# The Disk Data Base\n"
+	"#DDB\n"
+	"\n"
+	"ddb.virtualHWVersion = \"4\"\n";
 
 /* Retrieves source as a narrow string
  * Returns 1 if successful or -1 on error
@@ -560,3 +598,706 @@ int vmdk_test_close_file_io_handle(
 	return( result );
 }
 
+/* Determines the value of the bytes of a grain in a sparse test image
+ * Returns the byte value
+ */
+uint8_t vmdk_test_get_sparse_image_grain_value(
+         const char *grain_layout,
+         size_t grain_index )
+{
+	if( ( grain_layout[ grain_index ] == 'A' )
+	 || ( grain_layout[ grain_index ] == 'G' ) )
+	{
+		return( (uint8_t) ( ( grain_index % 255 ) + 1 ) );
+	}
+	return( 0 );
+}
+
+/* Creates the data of a monolithic sparse test image
+ * The grain layout contains a character per grain of VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE bytes:
+ * 'A' for a grain stored directly after the previously stored grain,
+ * 'G' for a grain stored after a gap, '.' for a sparse grain in a grain table
+ * and '-' for a grain in a sparse grain table, all grains of a grain table must be '-'
+ * The bytes of a stored grain contain vmdk_test_get_sparse_image_grain_value
+ * If compress grains is set the grains are stored as (stored) deflate compressed data
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_create_sparse_image_data(
+     const char *grain_layout,
+     uint32_t number_of_grain_table_entries,
+     uint8_t compress_grains,
+     uint8_t **image_data,
+     size_t *image_data_size,
+     libcerror_error_t **error )
+{
+	uint8_t *grain_data                        = NULL;
+	uint8_t *safe_image_data                   = NULL;
+	static char *function                      = "vmdk_test_create_sparse_image_data";
+	size_t grain_data_index                    = 0;
+	size_t grain_index                         = 0;
+	size_t number_of_grains                    = 0;
+	size_t safe_image_data_size                = 0;
+	uint64_t grain_directory_sector            = 3;
+	uint64_t grain_sector                      = 0;
+	uint64_t grain_table_sector                = 0;
+	uint64_t number_of_grain_directory_sectors = 0;
+	uint64_t number_of_grain_table_sectors     = 0;
+	uint64_t number_of_sectors                 = 0;
+	uint32_t adler32_lower_word                = 1;
+	uint32_t adler32_upper_word                = 0;
+	uint32_t grain_table_index                 = 0;
+	uint32_t number_of_grain_tables            = 0;
+	uint8_t grain_value                        = 0;
+	int print_count                            = 0;
+
+	if( grain_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_grain_table_entries == 0 )
+	 || ( number_of_grain_table_entries > 512 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of grain table entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( image_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid image data.",
+		 function );
+
+		return( -1 );
+	}
+	if( image_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid image data size.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_grains = narrow_string_length(
+	                    grain_layout );
+
+	if( ( number_of_grains == 0 )
+	 || ( number_of_grains > 65536 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid grain layout value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_grain_tables = (uint32_t) ( ( number_of_grains + number_of_grain_table_entries - 1 ) / number_of_grain_table_entries );
+
+	number_of_grain_directory_sectors = ( ( (uint64_t) number_of_grain_tables * 4 ) + 511 ) / 512;
+	number_of_grain_table_sectors     = ( ( (uint64_t) number_of_grain_table_entries * 4 ) + 511 ) / 512;
+
+	/* Every grain table and every grain is given its own sectors, a grain stored after a gap
+	 * and compressed take up less than 3 grains
+	 */
+	safe_image_data_size = (size_t) ( ( grain_directory_sector + number_of_grain_directory_sectors
+	                                  + ( number_of_grain_tables * number_of_grain_table_sectors ) ) * 512 )
+	                     + ( number_of_grains * 3 * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE );
+
+	safe_image_data = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * safe_image_data_size );
+
+	if( safe_image_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create image data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     safe_image_data,
+	     0,
+	     safe_image_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear image data.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_sectors = (uint64_t) number_of_grains * ( VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE / 512 );
+
+	/* The descriptor is stored in sectors 1 and 2
+	 */
+	print_count = narrow_string_snprintf(
+	               (char *) &( safe_image_data[ 512 ] ),
+	               1024,
+	               vmdk_test_sparse_image_descriptor,
+	               number_of_sectors );
+
+	if( ( print_count < 0 )
+	 || ( print_count >= 1024 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	grain_table_sector = grain_directory_sector + number_of_grain_directory_sectors;
+
+	for( grain_table_index = 0;
+	     grain_table_index < number_of_grain_tables;
+	     grain_table_index++ )
+	{
+		if( grain_layout[ grain_table_index * number_of_grain_table_entries ] == '-' )
+		{
+			continue;
+		}
+		byte_stream_copy_from_uint32_little_endian(
+		 &( safe_image_data[ ( grain_directory_sector * 512 ) + ( grain_table_index * 4 ) ] ),
+		 (uint32_t) grain_table_sector );
+
+		grain_table_sector += number_of_grain_table_sectors;
+	}
+	grain_sector = grain_table_sector;
+
+	/* The file header
+	 */
+	safe_image_data[ 0 ] = 'K';
+	safe_image_data[ 1 ] = 'D';
+	safe_image_data[ 2 ] = 'M';
+	safe_image_data[ 3 ] = 'V';
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( safe_image_data[ 4 ] ),
+	 1 );
+
+	if( compress_grains != 0 )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( safe_image_data[ 8 ] ),
+		 0x00010001UL );
+	}
+	else
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( safe_image_data[ 8 ] ),
+		 0x00000001UL );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 &( safe_image_data[ 12 ] ),
+	 number_of_sectors );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( safe_image_data[ 20 ] ),
+	 (uint64_t) ( VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE / 512 ) );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( safe_image_data[ 28 ] ),
+	 (uint64_t) 1 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( safe_image_data[ 36 ] ),
+	 (uint64_t) 2 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( safe_image_data[ 44 ] ),
+	 number_of_grain_table_entries );
+
+	/* The secondary grain directory refers to the same grain tables
+	 */
+	byte_stream_copy_from_uint64_little_endian(
+	 &( safe_image_data[ 48 ] ),
+	 grain_directory_sector );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( safe_image_data[ 56 ] ),
+	 grain_directory_sector );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( safe_image_data[ 64 ] ),
+	 grain_sector );
+
+	safe_image_data[ 73 ] = (uint8_t) '\n';
+	safe_image_data[ 74 ] = (uint8_t) ' ';
+	safe_image_data[ 75 ] = (uint8_t) '\r';
+	safe_image_data[ 76 ] = (uint8_t) '\n';
+
+	if( compress_grains != 0 )
+	{
+		byte_stream_copy_from_uint16_little_endian(
+		 &( safe_image_data[ 77 ] ),
+		 1 );
+	}
+	/* The grain tables and grains
+	 */
+	grain_table_sector = grain_directory_sector + number_of_grain_directory_sectors;
+
+	for( grain_index = 0;
+	     grain_index < number_of_grains;
+	     grain_index++ )
+	{
+		grain_table_index = (uint32_t) ( grain_index / number_of_grain_table_entries );
+
+		if( ( grain_index > 0 )
+		 && ( ( grain_index % number_of_grain_table_entries ) == 0 )
+		 && ( grain_layout[ grain_index - number_of_grain_table_entries ] != '-' ) )
+		{
+			grain_table_sector += number_of_grain_table_sectors;
+		}
+		if( ( grain_layout[ grain_index ] == '-' )
+		 || ( grain_layout[ grain_index ] == '.' ) )
+		{
+			if( ( grain_layout[ grain_index ] == '-' )
+			 != ( grain_layout[ grain_table_index * number_of_grain_table_entries ] == '-' ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported grain layout - mixed sparse grain table.",
+				 function );
+
+				goto on_error;
+			}
+			continue;
+		}
+		if( ( grain_layout[ grain_index ] != 'A' )
+		 && ( grain_layout[ grain_index ] != 'G' ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported grain layout - invalid character.",
+			 function );
+
+			goto on_error;
+		}
+		if( grain_layout[ grain_table_index * number_of_grain_table_entries ] == '-' )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported grain layout - mixed sparse grain table.",
+			 function );
+
+			goto on_error;
+		}
+		if( grain_layout[ grain_index ] == 'G' )
+		{
+			grain_sector += VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE / 512;
+		}
+		byte_stream_copy_from_uint32_little_endian(
+		 &( safe_image_data[ ( grain_table_sector * 512 ) + ( ( grain_index % number_of_grain_table_entries ) * 4 ) ] ),
+		 (uint32_t) grain_sector );
+
+		grain_value = vmdk_test_get_sparse_image_grain_value(
+		               grain_layout,
+		               grain_index );
+
+		grain_data = &( safe_image_data[ grain_sector * 512 ] );
+
+		if( compress_grains == 0 )
+		{
+			if( memory_set(
+			     grain_data,
+			     grain_value,
+			     VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to set grain data.",
+				 function );
+
+				goto on_error;
+			}
+			grain_sector += VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE / 512;
+
+			continue;
+		}
+		/* The compressed grain header contains the sector number and the compressed data size,
+		 * the compressed data is a zlib stream with a single stored block
+		 */
+		byte_stream_copy_from_uint64_little_endian(
+		 grain_data,
+		 (uint64_t) grain_index * ( VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE / 512 ) );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( grain_data[ 8 ] ),
+		 2 + 5 + VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE + 4 );
+
+		grain_data[ 12 ] = 0x78;
+		grain_data[ 13 ] = 0x01;
+		grain_data[ 14 ] = 0x01;
+
+		byte_stream_copy_from_uint16_little_endian(
+		 &( grain_data[ 15 ] ),
+		 VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE );
+
+		byte_stream_copy_from_uint16_little_endian(
+		 &( grain_data[ 17 ] ),
+		 ~( VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE ) & 0xffff );
+
+		adler32_lower_word = 1;
+		adler32_upper_word = 0;
+
+		for( grain_data_index = 0;
+		     grain_data_index < VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE;
+		     grain_data_index++ )
+		{
+			grain_data[ 19 + grain_data_index ] = grain_value;
+
+			adler32_lower_word = ( adler32_lower_word + grain_value ) % 65521;
+			adler32_upper_word = ( adler32_upper_word + adler32_lower_word ) % 65521;
+		}
+		byte_stream_copy_from_uint32_big_endian(
+		 &( grain_data[ 19 + VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE ] ),
+		 ( adler32_upper_word << 16 ) | adler32_lower_word );
+
+		grain_sector += ( 12 + 2 + 5 + VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE + 4 + 511 ) / 512;
+	}
+	*image_data      = safe_image_data;
+	*image_data_size = (size_t) ( grain_sector * 512 );
+
+	return( 1 );
+
+on_error:
+	if( safe_image_data != NULL )
+	{
+		memory_free(
+		 safe_image_data );
+	}
+	return( -1 );
+}
+
+/* Opens a handle for the data of a sparse test image
+ * The image data must remain available until the handle is closed
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_open_sparse_image(
+     libvmdk_handle_t **handle,
+     libbfio_handle_t **file_io_handle,
+     libbfio_pool_t **file_io_pool,
+     uint8_t *image_data,
+     size_t image_data_size,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *extent_data_file_io_handle = NULL;
+	static char *function                        = "vmdk_test_open_sparse_image";
+	int file_io_pool_entry                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_initialize(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( vmdk_test_open_file_io_handle(
+	     file_io_handle,
+	     image_data,
+	     image_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_open_file_io_handle(
+	     *handle,
+	     *file_io_handle,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_initialize(
+	     file_io_pool,
+	     0,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_memory_range_initialize(
+	     &extent_data_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create extent data file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_memory_range_set(
+	     extent_data_file_io_handle,
+	     image_data,
+	     image_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set memory range of extent data file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_append_handle(
+	     *file_io_pool,
+	     &file_io_pool_entry,
+	     extent_data_file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append extent data file IO handle to pool.",
+		 function );
+
+		goto on_error;
+	}
+	/* The file IO pool now manages the extent data file IO handle
+	 */
+	extent_data_file_io_handle = NULL;
+
+	if( libvmdk_handle_open_extent_data_files_file_io_pool(
+	     *handle,
+	     *file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( extent_data_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &extent_data_file_io_handle,
+		 NULL );
+	}
+	if( *file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 file_io_pool,
+		 NULL );
+	}
+	if( *handle != NULL )
+	{
+		libvmdk_handle_free(
+		 handle,
+		 NULL );
+	}
+	if( *file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes a handle for the data of a sparse test image
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_close_sparse_image(
+     libvmdk_handle_t **handle,
+     libbfio_handle_t **file_io_handle,
+     libbfio_pool_t **file_io_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "vmdk_test_close_sparse_image";
+	int result            = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_close(
+	     *handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		result = -1;
+	}
+	if( libvmdk_handle_free(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		result = -1;
+	}
+	if( libbfio_pool_free(
+	     file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO pool.",
+		 function );
+
+		result = -1;
+	}
+	if( vmdk_test_close_file_io_handle(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
@@ -27,11 +27,16 @@
 
 #include "vmdk_test_libbfio.h"
 #include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The grain size of a sparse test image
+ */
+#define VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE	8192
+
 int vmdk_test_get_narrow_source(
      const system_character_t *source,
      char *narrow_string,
@@ -58,6 +63,32 @@ int vmdk_test_close_file_io_handle(
      libbfio_handle_t **file_io_handle,
      libcerror_error_t **error );
 
+uint8_t vmdk_test_get_sparse_image_grain_value(
+         const char *grain_layout,
+         size_t grain_index );
+
+int vmdk_test_create_sparse_image_data(
+     const char *grain_layout,
+     uint32_t number_of_grain_table_entries,
+     uint8_t compress_grains,
+     uint8_t **image_data,
+     size_t *image_data_size,
+     libcerror_error_t **error );
+
+int vmdk_test_open_sparse_image(
+     libvmdk_handle_t **handle,
+     libbfio_handle_t **file_io_handle,
+     libbfio_pool_t **file_io_pool,
+     uint8_t *image_data,
+     size_t image_data_size,
+     libcerror_error_t **error );
+
+int vmdk_test_close_sparse_image(
+     libvmdk_handle_t **handle,
+     libbfio_handle_t **file_io_handle,
+     libbfio_pool_t **file_io_pool,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
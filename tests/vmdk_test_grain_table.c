@@ -21,21 +21,33 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
 #endif
 
+#include "vmdk_test_functions.h"
+#include "vmdk_test_libbfio.h"
 #include "vmdk_test_libcerror.h"
 #include "vmdk_test_libvmdk.h"
 #include "vmdk_test_macros.h"
 #include "vmdk_test_memory.h"
 #include "vmdk_test_unused.h"
 
+#include "../libvmdk/libvmdk_definitions.h"
+#include "../libvmdk/libvmdk_extent_file.h"
+#include "../libvmdk/libvmdk_extent_table.h"
 #include "../libvmdk/libvmdk_grain_table.h"
+#include "../libvmdk/libvmdk_handle.h"
 #include "../libvmdk/libvmdk_io_handle.h"
 
+/* The number of grain groups of the test image, which exceeds
+ * the maximum number of cache entries of the grain groups cache
+ */
+#define VMDK_TEST_GRAIN_TABLE_NUMBER_OF_GRAIN_GROUPS	130
+
 #if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
 
 /* Tests the libvmdk_grain_table_initialize function
@@ -338,6 +350,624 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvmdk_grain_table_get_grain_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_grain_table_get_grain_at_offset(
+     void )
+{
+	char grain_layout[ ( VMDK_TEST_GRAIN_TABLE_NUMBER_OF_GRAIN_GROUPS * 4 ) + 1 ];
+
+	libvmdk_grain_descriptor_t grain_descriptor;
+
+	libbfio_handle_t *file_io_handle            = NULL;
+	libbfio_pool_t *file_io_pool                = NULL;
+	libcerror_error_t *error                    = NULL;
+	libfdata_list_t *grains_list                = NULL;
+	libvmdk_extent_file_t *extent_file          = NULL;
+	libvmdk_handle_t *handle                    = NULL;
+	libvmdk_internal_handle_t *internal_handle  = NULL;
+	uint8_t *image_data                         = NULL;
+	size_t grain_index                          = 0;
+	size_t image_data_size                      = 0;
+	off64_t extent_offset                       = 0;
+	off64_t offset                              = 0;
+	int grain_group_index                       = 0;
+	int iteration                               = 0;
+	int result                                  = 0;
+
+	/* Initialize test
+	 * Every grain group contains a stored grain followed by sparse grains,
+	 * except for grain group 1 which is sparse
+	 */
+	for( grain_group_index = 0;
+	     grain_group_index < VMDK_TEST_GRAIN_TABLE_NUMBER_OF_GRAIN_GROUPS;
+	     grain_group_index++ )
+	{
+		if( grain_group_index == 1 )
+		{
+			result = memory_copy(
+			          &( grain_layout[ grain_group_index * 4 ] ),
+			          "----",
+			          4 ) != NULL;
+		}
+		else
+		{
+			result = memory_copy(
+			          &( grain_layout[ grain_group_index * 4 ] ),
+			          "A..A",
+			          4 ) != NULL;
+		}
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	grain_layout[ VMDK_TEST_GRAIN_TABLE_NUMBER_OF_GRAIN_GROUPS * 4 ] = 0;
+
+	result = vmdk_test_create_sparse_image_data(
+	          grain_layout,
+	          4,
+	          0,
+	          &image_data,
+	          &image_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_open_sparse_image(
+	          &handle,
+	          &file_io_handle,
+	          &file_io_pool,
+	          image_data,
+	          image_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	result = libvmdk_extent_table_get_extent_file_by_index(
+	          internal_handle->extent_table,
+	          0,
+	          file_io_pool,
+	          &extent_offset,
+	          &extent_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_file",
+	 extent_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * Alternate between grain groups that are more than the maximum number of
+	 * cache entries apart, so that the grain groups evict each other from the cache
+	 */
+	for( iteration = 0;
+	     iteration < ( 2 * VMDK_TEST_GRAIN_TABLE_NUMBER_OF_GRAIN_GROUPS );
+	     iteration++ )
+	{
+		if( ( iteration % 2 ) == 0 )
+		{
+			grain_group_index = iteration / 2;
+		}
+		else
+		{
+			grain_group_index = ( ( iteration / 2 ) + LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAIN_GROUPS ) % VMDK_TEST_GRAIN_TABLE_NUMBER_OF_GRAIN_GROUPS;
+		}
+		grain_index = ( (size_t) grain_group_index * 4 ) + ( iteration % 4 );
+		offset      = (off64_t) ( grain_index * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE ) + 512;
+
+		result = libvmdk_grain_table_get_grain_at_offset(
+		          internal_handle->grain_table,
+		          (uint64_t) grain_index,
+		          file_io_pool,
+		          internal_handle->extent_table,
+		          offset,
+		          &grain_descriptor,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "grain_descriptor.extent_number",
+		 grain_descriptor.extent_number,
+		 0 );
+
+		VMDK_TEST_ASSERT_EQUAL_INT64(
+		 "grain_descriptor.grain_group_offset",
+		 (int64_t) grain_descriptor.grain_group_offset,
+		 (int64_t) grain_group_index * 4 * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE );
+
+		VMDK_TEST_ASSERT_EQUAL_INT64(
+		 "grain_descriptor.data_offset",
+		 (int64_t) grain_descriptor.data_offset,
+		 (int64_t) 512 );
+
+		if( grain_layout[ grain_index ] == '-' )
+		{
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "grain_descriptor.grains_list",
+			 grain_descriptor.grains_list );
+
+			VMDK_TEST_ASSERT_EQUAL_UINT32(
+			 "grain_descriptor.flags",
+			 grain_descriptor.flags,
+			 LIBVMDK_RANGE_FLAG_IS_SPARSE );
+
+			continue;
+		}
+		/* The grains list must be the one that is currently in the grain groups cache
+		 */
+		result = libvmdk_extent_file_get_grain_group_by_index(
+		          extent_file,
+		          file_io_pool,
+		          internal_handle->extent_table->grain_groups_cache,
+		          grain_group_index,
+		          &grains_list,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VMDK_TEST_ASSERT_EQUAL_INTPTR(
+		 "grain_descriptor.grains_list",
+		 (intptr_t) grain_descriptor.grains_list,
+		 (intptr_t) grains_list );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "grain_descriptor.grains_list_index",
+		 grain_descriptor.grains_list_index,
+		 iteration % 4 );
+
+		if( grain_layout[ grain_index ] == '.' )
+		{
+			VMDK_TEST_ASSERT_EQUAL_UINT32(
+			 "grain_descriptor.flags",
+			 grain_descriptor.flags,
+			 LIBVMDK_RANGE_FLAG_IS_SPARSE );
+
+			continue;
+		}
+		VMDK_TEST_ASSERT_EQUAL_UINT32(
+		 "grain_descriptor.flags",
+		 grain_descriptor.flags,
+		 0 );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "grain_descriptor.file_index",
+		 grain_descriptor.file_index,
+		 0 );
+
+		VMDK_TEST_ASSERT_EQUAL_UINT64(
+		 "grain_descriptor.size",
+		 (uint64_t) grain_descriptor.size,
+		 (uint64_t) VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE );
+
+		result = ( grain_descriptor.offset > 0 )
+		      && ( (size_t) ( grain_descriptor.offset + VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE ) <= image_data_size );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_EQUAL_UINT8(
+		 "image_data[ grain_descriptor.offset ]",
+		 image_data[ grain_descriptor.offset ],
+		 vmdk_test_get_sparse_image_grain_value(
+		  grain_layout,
+		  grain_index ) );
+	}
+	/* Evict the most recently resolved grain group from the cache
+	 * before resolving another grain in the same grain group
+	 */
+	result = libvmdk_grain_table_get_grain_at_offset(
+	          internal_handle->grain_table,
+	          0,
+	          file_io_pool,
+	          internal_handle->extent_table,
+	          0,
+	          &grain_descriptor,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_file_get_grain_group_by_index(
+	          extent_file,
+	          file_io_pool,
+	          internal_handle->extent_table->grain_groups_cache,
+	          LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAIN_GROUPS,
+	          &grains_list,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_grain_table_get_grain_at_offset(
+	          internal_handle->grain_table,
+	          3,
+	          file_io_pool,
+	          internal_handle->extent_table,
+	          3 * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE,
+	          &grain_descriptor,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "grain_descriptor.flags",
+	 grain_descriptor.flags,
+	 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "image_data[ grain_descriptor.offset ]",
+	 image_data[ grain_descriptor.offset ],
+	 vmdk_test_get_sparse_image_grain_value(
+	  grain_layout,
+	  3 ) );
+
+	result = libvmdk_extent_file_get_grain_group_by_index(
+	          extent_file,
+	          file_io_pool,
+	          internal_handle->extent_table->grain_groups_cache,
+	          0,
+	          &grains_list,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INTPTR(
+	 "grain_descriptor.grains_list",
+	 (intptr_t) grain_descriptor.grains_list,
+	 (intptr_t) grains_list );
+
+	/* Test error cases
+	 */
+	result = libvmdk_grain_table_get_grain_at_offset(
+	          NULL,
+	          0,
+	          file_io_pool,
+	          internal_handle->extent_table,
+	          0,
+	          &grain_descriptor,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_table_get_grain_at_offset(
+	          internal_handle->grain_table,
+	          0,
+	          file_io_pool,
+	          NULL,
+	          0,
+	          &grain_descriptor,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_table_get_grain_at_offset(
+	          internal_handle->grain_table,
+	          0,
+	          file_io_pool,
+	          internal_handle->extent_table,
+	          -1,
+	          &grain_descriptor,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_table_get_grain_at_offset(
+	          internal_handle->grain_table,
+	          0,
+	          file_io_pool,
+	          internal_handle->extent_table,
+	          0,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = vmdk_test_close_sparse_image(
+	          &handle,
+	          &file_io_handle,
+	          &file_io_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 image_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		vmdk_test_close_sparse_image(
+		 &handle,
+		 &file_io_handle,
+		 &file_io_pool,
+		 NULL );
+	}
+	if( image_data != NULL )
+	{
+		memory_free(
+		 image_data );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_grain_table_reset_last_grain_group function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_grain_table_reset_last_grain_group(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libvmdk_grain_table_t *grain_table = NULL;
+	libvmdk_io_handle_t *io_handle     = NULL;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_grain_table_initialize(
+	          &grain_table,
+	          io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "grain_table",
+	 grain_table );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	grain_table->last_grain_group_is_set = 1;
+	grain_table->last_grain_group_size   = 65536;
+
+	result = libvmdk_grain_table_reset_last_grain_group(
+	          grain_table,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "grain_table->last_grain_group_is_set",
+	 grain_table->last_grain_group_is_set,
+	 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "grain_table->last_grain_groups_list_index",
+	 grain_table->last_grain_groups_list_index,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_grain_table_reset_last_grain_group(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_grain_table_free(
+	          &grain_table,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "grain_table",
+	 grain_table );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( grain_table != NULL )
+	{
+		libvmdk_grain_table_free(
+		 &grain_table,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libvmdk_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
 
 /* The main program
@@ -365,6 +995,14 @@ int main(
 	 "libvmdk_grain_table_free",
 	 vmdk_test_grain_table_free );
 
+	VMDK_TEST_RUN(
+	 "libvmdk_grain_table_get_grain_at_offset",
+	 vmdk_test_grain_table_get_grain_at_offset );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_grain_table_reset_last_grain_group",
+	 vmdk_test_grain_table_reset_last_grain_group );
+
 	/* TODO: add tests for libvmdk_grain_table_grain_is_sparse_at_offset */
 
 	/* TODO: add tests for libvmdk_grain_table_get_grain_data_at_offset */
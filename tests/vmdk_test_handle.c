@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -30,6 +31,10 @@
 #include <stdlib.h>
 #endif
 
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
 #include "vmdk_test_functions.h"
 #include "vmdk_test_getopt.h"
 #include "vmdk_test_libbfio.h"
@@ -40,6 +45,8 @@
 #include "vmdk_test_memory.h"
 #include "vmdk_test_unused.h"
 
+#include "../libvmdk/libvmdk_definitions.h"
+#include "../libvmdk/libvmdk_grain_table.h"
 #include "../libvmdk/libvmdk_handle.h"
 
 #if !defined( LIBVMDK_HAVE_BFIO )
@@ -56,6 +63,16 @@ int libvmdk_handle_open_file_io_handle(
      int access_flags,
      libvmdk_error_t **error );
 
+LIBVMDK_EXTERN \
+int libvmdk_handle_copy_to_file_io_handle(
+     libvmdk_handle_t *handle,
+     off64_t offset,
+     size64_t size,
+     libbfio_handle_t *file_io_handle,
+     off64_t destination_offset,
+     uint8_t copy_flags,
+     libvmdk_error_t **error );
+
 #endif /* !defined( LIBVMDK_HAVE_BFIO ) */
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER ) && SIZEOF_WCHAR_T != 2 && SIZEOF_WCHAR_T != 4
@@ -1660,92 +1677,153 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libvmdk_handle_seek_offset function
+/* Tests the libvmdk_handle_read_ranges function
  * Returns 1 if successful or 0 if not
  */
-int vmdk_test_handle_seek_offset(
+int vmdk_test_handle_read_ranges(
      libvmdk_handle_t *handle )
 {
+	uint8_t buffer1[ 16 ];
+	uint8_t buffer2[ 16 ];
+	uint8_t expected_buffer[ 16 ];
+	void *buffers[ 2 ];
+	size_t buffer_sizes[ 2 ];
+	off64_t offsets[ 2 ];
+	ssize_t read_counts[ 2 ];
+
 	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
-	off64_t offset           = 0;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	int result               = 0;
 
-	/* Test regular cases
+	/* Determine size
 	 */
-	offset = libvmdk_handle_seek_offset(
+	result = libvmdk_handle_get_media_size(
 	          handle,
-	          0,
-	          SEEK_END,
+	          &media_size,
 	          &error );
 
-	VMDK_TEST_ASSERT_NOT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	size = (size64_t) offset;
+	buffers[ 0 ]      = buffer1;
+	buffers[ 1 ]      = buffer2;
+	buffer_sizes[ 0 ] = 16;
+	buffer_sizes[ 1 ] = 16;
+	offsets[ 0 ]      = 0;
+	offsets[ 1 ]      = 0;
 
-	offset = libvmdk_handle_seek_offset(
-	          handle,
-	          1024,
-	          SEEK_SET,
-	          &error );
+	/* Test regular cases
+	 */
+	if( media_size > 16 )
+	{
+		/* Read the ranges in reverse order of their offset
+		 */
+		offsets[ 0 ] = (off64_t) media_size - 8;
+		offsets[ 1 ] = 0;
 
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 1024 );
+		result = libvmdk_handle_read_ranges(
+		          handle,
+		          2,
+		          buffers,
+		          buffer_sizes,
+		          offsets,
+		          read_counts,
+		          &error );
 
-	VMDK_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
 
-	offset = libvmdk_handle_seek_offset(
-	          handle,
-	          -512,
-	          SEEK_CUR,
-	          &error );
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
 
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 512 );
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_counts[ 0 ]",
+		 read_counts[ 0 ],
+		 (ssize_t) 8 );
 
-	VMDK_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_counts[ 1 ]",
+		 read_counts[ 1 ],
+		 (ssize_t) 16 );
 
-	offset = libvmdk_handle_seek_offset(
-	          handle,
-	          (off64_t) ( size + 512 ),
-	          SEEK_SET,
-	          &error );
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              handle,
+		              expected_buffer,
+		              16,
+		              0,
+		              &error );
 
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) ( size + 512 ) );
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
 
-	VMDK_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
 
-	/* Reset offset to 0
-	 */
-	offset = libvmdk_handle_seek_offset(
+		result = memory_compare(
+		          buffer2,
+		          expected_buffer,
+		          16 );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              handle,
+		              expected_buffer,
+		              8,
+		              (off64_t) media_size - 8,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer1,
+		          expected_buffer,
+		          8 );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		offsets[ 0 ] = 0;
+		offsets[ 1 ] = 0;
+	}
+	result = libvmdk_handle_read_ranges(
 	          handle,
 	          0,
-	          SEEK_SET,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
 	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -1753,16 +1831,19 @@ int vmdk_test_handle_seek_offset(
 
 	/* Test error cases
 	 */
-	offset = libvmdk_handle_seek_offset(
+	result = libvmdk_handle_read_ranges(
 	          NULL,
-	          0,
-	          SEEK_SET,
+	          2,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
 	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1771,16 +1852,19 @@ int vmdk_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libvmdk_handle_seek_offset(
+	result = libvmdk_handle_read_ranges(
 	          handle,
 	          -1,
-	          SEEK_SET,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
 	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1789,31 +1873,40 @@ int vmdk_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libvmdk_handle_seek_offset(
+	result = libvmdk_handle_read_ranges(
 	          handle,
-	          -1,
-	          SEEK_CUR,
+	          2,
+	          NULL,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
 	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	offset = libvmdk_handle_seek_offset(
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_read_ranges(
 	          handle,
-	          (off64_t) ( -1 * ( size + 1 ) ),
-	          SEEK_END,
+	          2,
+	          buffers,
+	          NULL,
+	          offsets,
+	          read_counts,
 	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1822,53 +1915,40 @@ int vmdk_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
-
-/* Tests the libvmdk_handle_get_offset function
- * Returns 1 if successful or 0 if not
- */
-int vmdk_test_handle_get_offset(
-     libvmdk_handle_t *handle )
-{
-	libcerror_error_t *error = NULL;
-	off64_t offset           = 0;
-	int offset_is_set        = 0;
-	int result               = 0;
-
-	/* Test regular cases
-	 */
-	result = libvmdk_handle_get_offset(
+	result = libvmdk_handle_read_ranges(
 	          handle,
-	          &offset,
+	          2,
+	          buffers,
+	          buffer_sizes,
+	          NULL,
+	          read_counts,
 	          &error );
 
-	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 -1 );
 
-	VMDK_TEST_ASSERT_IS_NULL(
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	offset_is_set = result;
+	libcerror_error_free(
+	 &error );
 
-	/* Test error cases
-	 */
-	result = libvmdk_handle_get_offset(
-	          NULL,
-	          &offset,
+	offsets[ 1 ] = -1;
+
+	result = libvmdk_handle_read_ranges(
+	          handle,
+	          2,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
 	          &error );
 
+	offsets[ 1 ] = 0;
+
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
@@ -1881,25 +1961,6 @@ int vmdk_test_handle_get_offset(
 	libcerror_error_free(
 	 &error );
 
-	if( offset_is_set != 0 )
-	{
-		result = libvmdk_handle_get_offset(
-		          handle,
-		          NULL,
-		          &error );
-
-		VMDK_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		VMDK_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -1911,40 +1972,2631 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libvmdk_handle_get_disk_type function
- * Returns 1 if successful or 0 if not
+/* The completion state of a submitted read for testing
  */
-int vmdk_test_handle_get_disk_type(
-     libvmdk_handle_t *handle )
+typedef struct vmdk_test_handle_read_completion vmdk_test_handle_read_completion_t;
+
+struct vmdk_test_handle_read_completion
 {
-	libcerror_error_t *error = NULL;
-	int disk_type            = 0;
-	int disk_type_is_set     = 0;
+	/* The number of times the callback function was called
+	 */
+	int number_of_calls;
+
+	/* The read count
+	 */
+	ssize_t read_count;
+
+	/* Value to indicate an error was passed
+	 */
+	int has_error;
+};
+
+/* Submitted read callback function for testing
+ */
+void vmdk_test_handle_submit_read_callback(
+      libvmdk_handle_t *handle VMDK_TEST_ATTRIBUTE_UNUSED,
+      void *buffer VMDK_TEST_ATTRIBUTE_UNUSED,
+      ssize_t read_count,
+      libvmdk_error_t *error,
+      void *callback_data )
+{
+	vmdk_test_handle_read_completion_t *read_completion = NULL;
+
+	VMDK_TEST_UNREFERENCED_PARAMETER( handle )
+	VMDK_TEST_UNREFERENCED_PARAMETER( buffer )
+
+	read_completion = (vmdk_test_handle_read_completion_t *) callback_data;
+
+	read_completion->number_of_calls += 1;
+	read_completion->read_count       = read_count;
+	read_completion->has_error        = (int) ( error != NULL );
+}
+
+/* Tests the libvmdk_handle_submit_read and libvmdk_handle_wait_for_reads functions
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_submit_read(
+     libvmdk_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+	uint8_t expected_buffer[ 16 ];
+
+	vmdk_test_handle_read_completion_t read_completion;
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	off64_t offset           = 0;
+	off64_t saved_offset     = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libvmdk_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 16 )
+	{
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              handle,
+		              expected_buffer,
+		              16,
+		              0,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvmdk_handle_get_offset(
+		          handle,
+		          &saved_offset,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_completion.number_of_calls = 0;
+		read_completion.read_count      = 0;
+		read_completion.has_error       = 0;
+
+		result = libvmdk_handle_submit_read(
+		          handle,
+		          buffer,
+		          16,
+		          0,
+		          &vmdk_test_handle_submit_read_callback,
+		          (void *) &read_completion,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvmdk_handle_wait_for_reads(
+		          handle,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "read_completion.number_of_calls",
+		 read_completion.number_of_calls,
+		 1 );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_completion.read_count",
+		 read_completion.read_count,
+		 (ssize_t) 16 );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "read_completion.has_error",
+		 read_completion.has_error,
+		 0 );
+
+		result = memory_compare(
+		          buffer,
+		          expected_buffer,
+		          16 );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* The submitted read does not change the current offset
+		 */
+		result = libvmdk_handle_get_offset(
+		          handle,
+		          &offset,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) saved_offset );
+	}
+	/* Test error cases
+	 */
+	result = libvmdk_handle_submit_read(
+	          NULL,
+	          buffer,
+	          16,
+	          0,
+	          &vmdk_test_handle_submit_read_callback,
+	          (void *) &read_completion,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_submit_read(
+	          handle,
+	          NULL,
+	          16,
+	          0,
+	          &vmdk_test_handle_submit_read_callback,
+	          (void *) &read_completion,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_submit_read(
+	          handle,
+	          buffer,
+	          16,
+	          -1,
+	          &vmdk_test_handle_submit_read_callback,
+	          (void *) &read_completion,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_submit_read(
+	          handle,
+	          buffer,
+	          16,
+	          0,
+	          NULL,
+	          (void *) &read_completion,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_wait_for_reads(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_seek_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_seek_offset(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	off64_t offset           = 0;
+
+	/* Test regular cases
+	 */
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size = (size64_t) offset;
+
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          1024,
+	          SEEK_SET,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 1024 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          -512,
+	          SEEK_CUR,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 512 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          (off64_t) ( size + 512 ),
+	          SEEK_SET,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) ( size + 512 ) );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset offset to 0
+	 */
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	offset = libvmdk_handle_seek_offset(
+	          NULL,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_CUR,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          (off64_t) ( -1 * ( size + 1 ) ),
+	          SEEK_END,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_offset(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	off64_t offset           = 0;
+	int offset_is_set        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_offset(
+	          handle,
+	          &offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_offset(
+	          NULL,
+	          &offset,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( offset_is_set != 0 )
+	{
+		result = libvmdk_handle_get_offset(
+		          handle,
+		          NULL,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_disk_type function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_disk_type(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int disk_type            = 0;
+	int disk_type_is_set     = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_disk_type(
+	          handle,
+	          &disk_type,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	disk_type_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_disk_type(
+	          NULL,
+	          &disk_type,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( disk_type_is_set != 0 )
+	{
+		result = libvmdk_handle_get_disk_type(
+		          handle,
+		          NULL,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_media_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_media_size(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	int media_size_is_set    = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	media_size_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_media_size(
+	          NULL,
+	          &media_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( media_size_is_set != 0 )
+	{
+		result = libvmdk_handle_get_media_size(
+		          handle,
+		          NULL,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_content_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_content_identifier(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error      = NULL;
+	uint32_t content_identifier   = 0;
+	int content_identifier_is_set = 0;
+	int result                    = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_content_identifier(
+	          handle,
+	          &content_identifier,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	content_identifier_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_content_identifier(
+	          NULL,
+	          &content_identifier,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( content_identifier_is_set != 0 )
+	{
+		result = libvmdk_handle_get_content_identifier(
+		          handle,
+		          NULL,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_parent_content_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_parent_content_identifier(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error             = NULL;
+	uint32_t parent_content_identifier   = 0;
+	int parent_content_identifier_is_set = 0;
+	int result                           = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_parent_content_identifier(
+	          handle,
+	          &parent_content_identifier,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	parent_content_identifier_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_parent_content_identifier(
+	          NULL,
+	          &parent_content_identifier,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( parent_content_identifier_is_set != 0 )
+	{
+		result = libvmdk_handle_get_parent_content_identifier(
+		          handle,
+		          NULL,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_utf8_parent_filename_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_utf8_parent_filename_size(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error             = NULL;
+	size_t utf8_parent_filename_size     = 0;
+	int result                           = 0;
+	int utf8_parent_filename_size_is_set = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_utf8_parent_filename_size(
+	          handle,
+	          &utf8_parent_filename_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	utf8_parent_filename_size_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_utf8_parent_filename_size(
+	          NULL,
+	          &utf8_parent_filename_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( utf8_parent_filename_size_is_set != 0 )
+	{
+		result = libvmdk_handle_get_utf8_parent_filename_size(
+		          handle,
+		          NULL,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_utf8_parent_filename function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_utf8_parent_filename(
+     libvmdk_handle_t *handle )
+{
+	uint8_t utf8_parent_filename[ 512 ];
+
+	libcerror_error_t *error        = NULL;
+	int result                      = 0;
+	int utf8_parent_filename_is_set = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_utf8_parent_filename(
+	          handle,
+	          utf8_parent_filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	utf8_parent_filename_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_utf8_parent_filename(
+	          NULL,
+	          utf8_parent_filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( utf8_parent_filename_is_set != 0 )
+	{
+		result = libvmdk_handle_get_utf8_parent_filename(
+		          handle,
+		          NULL,
+		          512,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvmdk_handle_get_utf8_parent_filename(
+		          handle,
+		          utf8_parent_filename,
+		          0,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvmdk_handle_get_utf8_parent_filename(
+		          handle,
+		          utf8_parent_filename,
+		          (size_t) SSIZE_MAX + 1,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_utf16_parent_filename_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_utf16_parent_filename_size(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error              = NULL;
+	size_t utf16_parent_filename_size     = 0;
+	int result                            = 0;
+	int utf16_parent_filename_size_is_set = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_utf16_parent_filename_size(
+	          handle,
+	          &utf16_parent_filename_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	utf16_parent_filename_size_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_utf16_parent_filename_size(
+	          NULL,
+	          &utf16_parent_filename_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( utf16_parent_filename_size_is_set != 0 )
+	{
+		result = libvmdk_handle_get_utf16_parent_filename_size(
+		          handle,
+		          NULL,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_utf16_parent_filename function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_utf16_parent_filename(
+     libvmdk_handle_t *handle )
+{
+	uint16_t utf16_parent_filename[ 512 ];
+
+	libcerror_error_t *error         = NULL;
+	int result                       = 0;
+	int utf16_parent_filename_is_set = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_utf16_parent_filename(
+	          handle,
+	          utf16_parent_filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	utf16_parent_filename_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_utf16_parent_filename(
+	          NULL,
+	          utf16_parent_filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( utf16_parent_filename_is_set != 0 )
+	{
+		result = libvmdk_handle_get_utf16_parent_filename(
+		          handle,
+		          NULL,
+		          512,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvmdk_handle_get_utf16_parent_filename(
+		          handle,
+		          utf16_parent_filename,
+		          0,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvmdk_handle_get_utf16_parent_filename(
+		          handle,
+		          utf16_parent_filename,
+		          (size_t) SSIZE_MAX + 1,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_number_of_grain_directory_mismatches function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_number_of_grain_directory_mismatches(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error      = NULL;
+	uint32_t number_of_mismatches = 0;
+	int result                    = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_number_of_grain_directory_mismatches(
+	          handle,
+	          &number_of_mismatches,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_number_of_grain_directory_mismatches(
+	          NULL,
+	          &number_of_mismatches,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_number_of_grain_directory_mismatches(
+	          handle,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_memory_usage function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_memory_usage(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error     = NULL;
+	size64_t grains_memory_usage = 0;
+	size64_t total_memory_usage  = 0;
+	int result                   = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_memory_usage(
+	          handle,
+	          LIBVMDK_MEMORY_USAGE_TYPE_TOTAL,
+	          &total_memory_usage,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_get_memory_usage(
+	          handle,
+	          LIBVMDK_MEMORY_USAGE_TYPE_GRAINS_CACHE,
+	          &grains_memory_usage,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_LESS_THAN_UINT64(
+	 "grains_memory_usage",
+	 (uint64_t) grains_memory_usage,
+	 (uint64_t) total_memory_usage );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_memory_usage(
+	          NULL,
+	          LIBVMDK_MEMORY_USAGE_TYPE_TOTAL,
+	          &total_memory_usage,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_memory_usage(
+	          handle,
+	          -1,
+	          &total_memory_usage,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_memory_usage(
+	          handle,
+	          LIBVMDK_MEMORY_USAGE_TYPE_TOTAL,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_number_of_extents function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_number_of_extents(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error     = NULL;
+	int number_of_extents        = 0;
+	int number_of_extents_is_set = 0;
+	int result                   = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_get_number_of_extents(
+	          handle,
+	          &number_of_extents,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	number_of_extents_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_number_of_extents(
+	          NULL,
+	          &number_of_extents,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( number_of_extents_is_set != 0 )
+	{
+		result = libvmdk_handle_get_number_of_extents(
+		          handle,
+		          NULL,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_extent_map_run_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_extent_map_run_at_offset(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	size64_t run_size        = 0;
+	off64_t offset           = 0;
+	off64_t physical_offset  = 0;
+	uint32_t run_flags       = 0;
+	int extent_index         = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libvmdk_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	while( (size64_t) offset < media_size )
+	{
+		result = libvmdk_handle_get_extent_map_run_at_offset(
+		          handle,
+		          offset,
+		          &run_size,
+		          &extent_index,
+		          &physical_offset,
+		          &run_flags,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VMDK_TEST_ASSERT_NOT_EQUAL_INT64(
+		 "run_size",
+		 (int64_t) run_size,
+		 (int64_t) 0 );
+
+		offset += (off64_t) run_size;
+	}
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) media_size );
+
+	result = libvmdk_handle_get_extent_map_run_at_offset(
+	          handle,
+	          (off64_t) media_size,
+	          &run_size,
+	          &extent_index,
+	          &physical_offset,
+	          &run_flags,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_extent_map_run_at_offset(
+	          NULL,
+	          0,
+	          &run_size,
+	          &extent_index,
+	          &physical_offset,
+	          &run_flags,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_extent_map_run_at_offset(
+	          handle,
+	          -1,
+	          &run_size,
+	          &extent_index,
+	          &physical_offset,
+	          &run_flags,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_extent_map_run_at_offset(
+	          handle,
+	          0,
+	          NULL,
+	          &extent_index,
+	          &physical_offset,
+	          &run_flags,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_extent_map_run_at_offset(
+	          handle,
+	          0,
+	          &run_size,
+	          &extent_index,
+	          &physical_offset,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_extent_map_run_at_offset function on a sparse image
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_extent_map_run_at_offset_sparse(
+     void )
+{
+	uint8_t grain_data[ VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE ];
+
+	/* The grain groups contain: stored and sparse grains, sparse grain group,
+	 * sparse and stored grains, sparse grains, contiguous stored grains
+	 */
+	const char *grain_layout              = "A..A----.AG.....AAAA";
+	uint64_t expected_run_grains[ 8 ]     = { 1, 2, 1, 5, 1, 1, 5, 4 };
+	uint32_t expected_run_flags[ 8 ]      = { 0, 1, 0, 1, 0, 0, 1, 0 };
+
+	libbfio_handle_t *file_io_handle      = NULL;
+	libbfio_pool_t *file_io_pool          = NULL;
+	libcerror_error_t *error              = NULL;
+	libvmdk_handle_t *handle              = NULL;
+	uint8_t *image_data                   = NULL;
+	size64_t run_size                     = 0;
+	size_t byte_index                     = 0;
+	size_t grain_index                    = 0;
+	size_t image_data_size                = 0;
+	ssize_t read_count                    = 0;
+	off64_t offset                        = 0;
+	off64_t physical_offset               = 0;
+	uint32_t run_flags                    = 0;
+	uint8_t expected_value                = 0;
+	int extent_index                      = 0;
+	int result                            = 0;
+	int run_index                         = 0;
+
+	/* Initialize test
+	 */
+	result = vmdk_test_create_sparse_image_data(
+	          grain_layout,
+	          4,
+	          0,
+	          &image_data,
+	          &image_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_open_sparse_image(
+	          &handle,
+	          &file_io_handle,
+	          &file_io_pool,
+	          image_data,
+	          image_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a sparse grain in an allocated grain group does not extend
+	 * a run over the stored grains of the grain group and that the data
+	 * of a run marked as zero reads as zero bytes
+	 */
+	for( run_index = 0;
+	     run_index < 8;
+	     run_index++ )
+	{
+		result = libvmdk_handle_get_extent_map_run_at_offset(
+		          handle,
+		          offset,
+		          &run_size,
+		          &extent_index,
+		          &physical_offset,
+		          &run_flags,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VMDK_TEST_ASSERT_EQUAL_UINT64(
+		 "run_size",
+		 (uint64_t) run_size,
+		 (uint64_t) ( expected_run_grains[ run_index ] * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE ) );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "extent_index",
+		 extent_index,
+		 0 );
+
+		if( expected_run_flags[ run_index ] != 0 )
+		{
+			VMDK_TEST_ASSERT_EQUAL_UINT32(
+			 "run_flags",
+			 run_flags,
+			 (uint32_t) ( LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_SPARSE | LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_ZERO ) );
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_UINT32(
+			 "run_flags",
+			 run_flags,
+			 (uint32_t) 0 );
+		}
+		while( run_size > 0 )
+		{
+			grain_index = (size_t) ( offset / VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE );
+
+			read_count = libvmdk_handle_read_buffer_at_offset(
+			              handle,
+			              grain_data,
+			              VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE,
+			              offset,
+			              &error );
+
+			VMDK_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			expected_value = vmdk_test_get_sparse_image_grain_value(
+			                  grain_layout,
+			                  grain_index );
+
+			if( ( run_flags & LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_ZERO ) != 0 )
+			{
+				VMDK_TEST_ASSERT_EQUAL_UINT8(
+				 "expected_value",
+				 expected_value,
+				 (uint8_t) 0 );
+			}
+			else
+			{
+				VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+				 "expected_value",
+				 (int) expected_value,
+				 0 );
+			}
+			for( byte_index = 0;
+			     byte_index < VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE;
+			     byte_index++ )
+			{
+				if( grain_data[ byte_index ] != expected_value )
+				{
+					break;
+				}
+			}
+			VMDK_TEST_ASSERT_EQUAL_SIZE(
+			 "byte_index",
+			 byte_index,
+			 (size_t) VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE );
+
+			offset   += VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE;
+			run_size -= VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE;
+		}
+	}
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) ( 20 * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE ) );
+
+	result = libvmdk_handle_get_extent_map_run_at_offset(
+	          handle,
+	          offset,
+	          &run_size,
+	          &extent_index,
+	          &physical_offset,
+	          &run_flags,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a run that starts at a sparse grain that is not the first grain
+	 * of an allocated grain group
+	 */
+	result = libvmdk_handle_get_extent_map_run_at_offset(
+	          handle,
+	          (off64_t) ( 2 * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE ),
+	          &run_size,
+	          &extent_index,
+	          &physical_offset,
+	          &run_flags,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "run_size",
+	 (uint64_t) run_size,
+	 (uint64_t) VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE );
+
+	/* Clean up
+	 */
+	result = vmdk_test_close_sparse_image(
+	          &handle,
+	          &file_io_handle,
+	          &file_io_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 image_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		vmdk_test_close_sparse_image(
+		 &handle,
+		 &file_io_handle,
+		 &file_io_pool,
+		 NULL );
+	}
+	if( image_data != NULL )
+	{
+		memory_free(
+		 image_data );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_copy_to_file_io_handle function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_copy_to_file_io_handle(
+     libvmdk_handle_t *handle )
+{
+	uint8_t destination_data[ 4096 ];
+	uint8_t expected_data[ 4096 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	size64_t copy_size               = 4096;
+	size64_t media_size              = 0;
+	ssize_t read_count               = 0;
+	int result                       = 0;
+
+	/* Determine size
+	 */
+	result = libvmdk_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( copy_size > media_size )
+	{
+		copy_size = media_size;
+	}
+	/* Initialize test
+	 */
+	result = memory_set(
+	          destination_data,
+	          0,
+	          4096 ) != NULL;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          destination_data,
+	          4096,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ_WRITE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_copy_to_file_io_handle(
+	          handle,
+	          0,
+	          copy_size,
+	          file_io_handle,
+	          0,
+	          LIBVMDK_COPY_FLAG_SPARSE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( copy_size > 0 )
+	{
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              handle,
+		              expected_data,
+		              (size_t) copy_size,
+		              0,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) copy_size );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          destination_data,
+		          expected_data,
+		          (size_t) copy_size );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libvmdk_handle_copy_to_file_io_handle(
+	          NULL,
+	          0,
+	          copy_size,
+	          file_io_handle,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_copy_to_file_io_handle(
+	          handle,
+	          -1,
+	          copy_size,
+	          file_io_handle,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_copy_to_file_io_handle(
+	          handle,
+	          0,
+	          media_size + 1,
+	          file_io_handle,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_copy_to_file_io_handle(
+	          handle,
+	          0,
+	          copy_size,
+	          NULL,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_copy_to_file_io_handle(
+	          handle,
+	          0,
+	          copy_size,
+	          file_io_handle,
+	          -1,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_copy_to_file_io_handle(
+	          handle,
+	          0,
+	          copy_size,
+	          file_io_handle,
+	          0,
+	          0xff,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( LIBVMDK_HAVE_COPY_TO_FILE_DESCRIPTOR ) && defined( HAVE_MKSTEMP ) && defined( HAVE_UNLINK )
+
+/* Tests the libvmdk_handle_copy_to_file_descriptor function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_copy_to_file_descriptor(
+     libvmdk_handle_t *handle )
+{
+	char filename[ 32 ]      = "vmdk_test_handle_XXXXXX";
+	uint8_t destination_data[ 4096 ];
+	uint8_t expected_data[ 4096 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t copy_size       = 4096;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	int file_descriptor      = -1;
 	int result               = 0;
 
-	/* Test regular cases
+	/* Determine size
 	 */
-	result = libvmdk_handle_get_disk_type(
+	result = libvmdk_handle_get_media_size(
 	          handle,
-	          &disk_type,
+	          &media_size,
 	          &error );
 
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( copy_size > media_size )
+	{
+		copy_size = media_size;
+	}
+	/* Initialize test
+	 */
+	file_descriptor = mkstemp(
+	                   filename );
+
 	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "file_descriptor",
+	 file_descriptor,
+	 -1 );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_copy_to_file_descriptor(
+	          handle,
+	          0,
+	          copy_size,
+	          file_descriptor,
+	          0,
+	          LIBVMDK_COPY_FLAG_SPARSE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( copy_size > 0 )
+	{
+		read_count = pread(
+		              file_descriptor,
+		              destination_data,
+		              (size_t) copy_size,
+		              0 );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) copy_size );
+
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              handle,
+		              expected_data,
+		              (size_t) copy_size,
+		              0,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) copy_size );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          destination_data,
+		          expected_data,
+		          (size_t) copy_size );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libvmdk_handle_copy_to_file_descriptor(
+	          NULL,
+	          0,
+	          copy_size,
+	          file_descriptor,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_copy_to_file_descriptor(
+	          handle,
+	          -1,
+	          copy_size,
+	          file_descriptor,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_copy_to_file_descriptor(
+	          handle,
+	          0,
+	          media_size + 1,
+	          file_descriptor,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_copy_to_file_descriptor(
+	          handle,
+	          0,
+	          copy_size,
+	          -1,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_copy_to_file_descriptor(
+	          handle,
+	          0,
+	          copy_size,
+	          file_descriptor,
+	          -1,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_copy_to_file_descriptor(
+	          handle,
+	          0,
+	          copy_size,
+	          file_descriptor,
+	          0,
+	          0xff,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	close(
+	 file_descriptor );
+
+	file_descriptor = -1;
+
+	unlink(
+	 filename );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+		unlink(
+		 filename );
+	}
+	return( 0 );
+}
+
+#endif /* defined( LIBVMDK_HAVE_COPY_TO_FILE_DESCRIPTOR ) && defined( HAVE_MKSTEMP ) && defined( HAVE_UNLINK ) */
+
+/* Tests the libvmdk_handle_check_extent function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_check_extent(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int extent_index         = 0;
+	int number_of_extents    = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_handle_get_number_of_extents(
+	          handle,
+	          &number_of_extents,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		result = libvmdk_handle_check_extent(
+		          handle,
+		          extent_index,
+		          &error );
+
+		VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libvmdk_handle_check_extent(
+	          NULL,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 -1 );
 
-	VMDK_TEST_ASSERT_IS_NULL(
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	disk_type_is_set = result;
+	libcerror_error_free(
+	 &error );
 
-	/* Test error cases
-	 */
-	result = libvmdk_handle_get_disk_type(
-	          NULL,
-	          &disk_type,
+	result = libvmdk_handle_check_extent(
+	          handle,
+	          -1,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -1959,25 +4611,6 @@ int vmdk_test_handle_get_disk_type(
 	libcerror_error_free(
 	 &error );
 
-	if( disk_type_is_set != 0 )
-	{
-		result = libvmdk_handle_get_disk_type(
-		          handle,
-		          NULL,
-		          &error );
-
-		VMDK_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		VMDK_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -1989,40 +4622,37 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libvmdk_handle_get_media_size function
+/* Tests the libvmdk_handle_get_number_of_corrupted_ranges function
  * Returns 1 if successful or 0 if not
  */
-int vmdk_test_handle_get_media_size(
+int vmdk_test_handle_get_number_of_corrupted_ranges(
      libvmdk_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	size64_t media_size      = 0;
-	int media_size_is_set    = 0;
-	int result               = 0;
+	libcerror_error_t *error       = NULL;
+	int number_of_corrupted_ranges = 0;
+	int result                     = 0;
 
 	/* Test regular cases
 	 */
-	result = libvmdk_handle_get_media_size(
+	result = libvmdk_handle_get_number_of_corrupted_ranges(
 	          handle,
-	          &media_size,
+	          &number_of_corrupted_ranges,
 	          &error );
 
-	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	media_size_is_set = result;
-
 	/* Test error cases
 	 */
-	result = libvmdk_handle_get_media_size(
+	result = libvmdk_handle_get_number_of_corrupted_ranges(
 	          NULL,
-	          &media_size,
+	          &number_of_corrupted_ranges,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -2037,25 +4667,23 @@ int vmdk_test_handle_get_media_size(
 	libcerror_error_free(
 	 &error );
 
-	if( media_size_is_set != 0 )
-	{
-		result = libvmdk_handle_get_media_size(
-		          handle,
-		          NULL,
-		          &error );
+	result = libvmdk_handle_get_number_of_corrupted_ranges(
+	          handle,
+	          NULL,
+	          &error );
 
-		VMDK_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		VMDK_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -2067,40 +4695,72 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libvmdk_handle_get_content_identifier function
+/* Tests the libvmdk_handle_get_corrupted_range function
  * Returns 1 if successful or 0 if not
  */
-int vmdk_test_handle_get_content_identifier(
+int vmdk_test_handle_get_corrupted_range(
      libvmdk_handle_t *handle )
 {
-	libcerror_error_t *error      = NULL;
-	uint32_t content_identifier   = 0;
-	int content_identifier_is_set = 0;
-	int result                    = 0;
+	libcerror_error_t *error       = NULL;
+	size64_t size                  = 0;
+	off64_t offset                 = 0;
+	uint32_t corruption_flags      = 0;
+	int extent_index               = 0;
+	int number_of_corrupted_ranges = 0;
+	int result                     = 0;
 
-	/* Test regular cases
+	/* Initialize test
 	 */
-	result = libvmdk_handle_get_content_identifier(
+	result = libvmdk_handle_get_number_of_corrupted_ranges(
 	          handle,
-	          &content_identifier,
+	          &number_of_corrupted_ranges,
 	          &error );
 
-	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	content_identifier_is_set = result;
+	/* Test regular cases
+	 */
+	if( number_of_corrupted_ranges > 0 )
+	{
+		result = libvmdk_handle_get_corrupted_range(
+		          handle,
+		          0,
+		          &offset,
+		          &size,
+		          &extent_index,
+		          &corruption_flags,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
 
+		VMDK_TEST_ASSERT_NOT_EQUAL_INT64(
+		 "size",
+		 (int64_t) size,
+		 (int64_t) 0 );
+	}
 	/* Test error cases
 	 */
-	result = libvmdk_handle_get_content_identifier(
+	result = libvmdk_handle_get_corrupted_range(
 	          NULL,
-	          &content_identifier,
+	          0,
+	          &offset,
+	          &size,
+	          &extent_index,
+	          &corruption_flags,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -2115,70 +4775,76 @@ int vmdk_test_handle_get_content_identifier(
 	libcerror_error_free(
 	 &error );
 
-	if( content_identifier_is_set != 0 )
-	{
-		result = libvmdk_handle_get_content_identifier(
-		          handle,
-		          NULL,
-		          &error );
+	result = libvmdk_handle_get_corrupted_range(
+	          handle,
+	          -1,
+	          &offset,
+	          &size,
+	          &extent_index,
+	          &corruption_flags,
+	          &error );
 
-		VMDK_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		VMDK_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		libcerror_error_free(
-		 &error );
-	}
-	return( 1 );
+	libcerror_error_free(
+	 &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	result = libvmdk_handle_get_corrupted_range(
+	          handle,
+	          0,
+	          NULL,
+	          &size,
+	          &extent_index,
+	          &corruption_flags,
+	          &error );
 
-/* Tests the libvmdk_handle_get_parent_content_identifier function
- * Returns 1 if successful or 0 if not
- */
-int vmdk_test_handle_get_parent_content_identifier(
-     libvmdk_handle_t *handle )
-{
-	libcerror_error_t *error             = NULL;
-	uint32_t parent_content_identifier   = 0;
-	int parent_content_identifier_is_set = 0;
-	int result                           = 0;
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	/* Test regular cases
-	 */
-	result = libvmdk_handle_get_parent_content_identifier(
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_corrupted_range(
 	          handle,
-	          &parent_content_identifier,
+	          0,
+	          &offset,
+	          NULL,
+	          &extent_index,
+	          &corruption_flags,
 	          &error );
 
-	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 -1 );
 
-	VMDK_TEST_ASSERT_IS_NULL(
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	parent_content_identifier_is_set = result;
+	libcerror_error_free(
+	 &error );
 
-	/* Test error cases
-	 */
-	result = libvmdk_handle_get_parent_content_identifier(
+	result = libvmdk_handle_get_corrupted_range(
+	          handle,
+	          0,
+	          &offset,
+	          &size,
 	          NULL,
-	          &parent_content_identifier,
+	          &corruption_flags,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -2193,151 +4859,300 @@ int vmdk_test_handle_get_parent_content_identifier(
 	libcerror_error_free(
 	 &error );
 
-	if( parent_content_identifier_is_set != 0 )
-	{
-		result = libvmdk_handle_get_parent_content_identifier(
-		          handle,
-		          NULL,
-		          &error );
+	result = libvmdk_handle_get_corrupted_range(
+	          handle,
+	          0,
+	          &offset,
+	          &size,
+	          &extent_index,
+	          NULL,
+	          &error );
 
-		VMDK_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		VMDK_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
 
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
 		libcerror_error_free(
 		 &error );
 	}
-	return( 1 );
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Retrieves the grain descriptor of a grain and determines the contiguous grains size
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_internal_handle_get_contiguous_grains_size_of_grain(
+     libvmdk_handle_t *handle,
+     uint64_t grain_index,
+     size_t maximum_size,
+     size_t *contiguous_size,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_descriptor_t grain_descriptor;
+
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "vmdk_test_internal_handle_get_contiguous_grains_size_of_grain";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( libvmdk_grain_table_get_grain_at_offset(
+	     internal_handle->grain_table,
+	     grain_index,
+	     internal_handle->extent_data_file_io_pool,
+	     internal_handle->extent_table,
+	     (off64_t) ( grain_index * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE ),
+	     &grain_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain: %" PRIu64 ".",
+		 function,
+		 grain_index );
 
-on_error:
-	if( error != NULL )
+		return( -1 );
+	}
+	if( libvmdk_internal_handle_get_contiguous_grains_size(
+	     internal_handle,
+	     internal_handle->extent_data_file_io_pool,
+	     grain_index,
+	     &grain_descriptor,
+	     maximum_size,
+	     contiguous_size,
+	     error ) != 1 )
 	{
-		libcerror_error_free(
-		 &error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine contiguous grains size.",
+		 function );
+
+		return( -1 );
 	}
-	return( 0 );
+	return( 1 );
 }
 
-/* Tests the libvmdk_handle_get_utf8_parent_filename_size function
+/* Tests the libvmdk_internal_handle_get_contiguous_grains_size function
  * Returns 1 if successful or 0 if not
  */
-int vmdk_test_handle_get_utf8_parent_filename_size(
-     libvmdk_handle_t *handle )
+int vmdk_test_internal_handle_get_contiguous_grains_size(
+     void )
 {
-	libcerror_error_t *error             = NULL;
-	size_t utf8_parent_filename_size     = 0;
-	int result                           = 0;
-	int utf8_parent_filename_size_is_set = 0;
+	libvmdk_grain_descriptor_t grain_descriptor;
 
-	/* Test regular cases
+	/* The grain groups contain: contiguous stored grains, stored grains that continue
+	 * the previous grain group followed by a grain stored after a gap and a sparse grain,
+	 * contiguous stored grains, a sparse grain group and a stored grain followed by sparse grains
 	 */
-	result = libvmdk_handle_get_utf8_parent_filename_size(
-	          handle,
-	          &utf8_parent_filename_size,
+	const char *grain_layout                   = "AAAAAAG.AAAA----A...";
+	uint64_t test_grain_indexes[ 8 ]           = { 0, 6, 8, 2, 2, 2, 7, 16 };
+	size_t test_maximum_sizes[ 8 ]             = { 64, 64, 64, 3, 3, 0, 64, 64 };
+	size_t expected_contiguous_sizes[ 8 ]      = { 6, 1, 4, 3, 3, 0, 0, 1 };
+
+	libbfio_handle_t *file_io_handle           = NULL;
+	libbfio_pool_t *file_io_pool               = NULL;
+	libcerror_error_t *error                   = NULL;
+	libvmdk_handle_t *handle                   = NULL;
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	uint8_t *image_data                        = NULL;
+	char *large_grain_layout                   = NULL;
+	size_t contiguous_size                     = 0;
+	size_t image_data_size                     = 0;
+	size_t maximum_size                        = 0;
+	int result                                 = 0;
+	int test_index                             = 0;
+
+	/* Initialize test
+	 */
+	result = vmdk_test_create_sparse_image_data(
+	          grain_layout,
+	          4,
+	          0,
+	          &image_data,
+	          &image_data_size,
 	          &error );
 
-	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	utf8_parent_filename_size_is_set = result;
-
-	/* Test error cases
-	 */
-	result = libvmdk_handle_get_utf8_parent_filename_size(
-	          NULL,
-	          &utf8_parent_filename_size,
+	result = vmdk_test_open_sparse_image(
+	          &handle,
+	          &file_io_handle,
+	          &file_io_pool,
+	          image_data,
+	          image_data_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( utf8_parent_filename_size_is_set != 0 )
+	/* Test that the run continues over a grain group boundary while the grains are stored contiguously,
+	 * and stops at a grain stored after a gap, a sparse grain, a sparse grain group and the maximum size
+	 */
+	for( test_index = 0;
+	     test_index < 8;
+	     test_index++ )
 	{
-		result = libvmdk_handle_get_utf8_parent_filename_size(
+		maximum_size = test_maximum_sizes[ test_index ] * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE;
+
+		/* Test a maximum size that is not a multiple of the grain size
+		 */
+		if( test_index == 4 )
+		{
+			maximum_size += VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE / 2;
+		}
+		else if( test_index == 5 )
+		{
+			maximum_size = VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE - 1;
+		}
+		result = vmdk_test_internal_handle_get_contiguous_grains_size_of_grain(
 		          handle,
-		          NULL,
+		          test_grain_indexes[ test_index ],
+		          maximum_size,
+		          &contiguous_size,
 		          &error );
 
 		VMDK_TEST_ASSERT_EQUAL_INT(
 		 "result",
 		 result,
-		 -1 );
+		 1 );
 
-		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		VMDK_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
 
-		libcerror_error_free(
-		 &error );
+		VMDK_TEST_ASSERT_EQUAL_SIZE(
+		 "contiguous_size",
+		 contiguous_size,
+		 (size_t) ( expected_contiguous_sizes[ test_index ] * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE ) );
 	}
-	return( 1 );
+	/* Test that the run stops at a grain stored in another file
+	 */
+	result = libvmdk_grain_table_get_grain_at_offset(
+	          internal_handle->grain_table,
+	          0,
+	          internal_handle->extent_data_file_io_pool,
+	          internal_handle->extent_table,
+	          0,
+	          &grain_descriptor,
+	          &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-/* Tests the libvmdk_handle_get_utf8_parent_filename function
- * Returns 1 if successful or 0 if not
- */
-int vmdk_test_handle_get_utf8_parent_filename(
-     libvmdk_handle_t *handle )
-{
-	uint8_t utf8_parent_filename[ 512 ];
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	libcerror_error_t *error        = NULL;
-	int result                      = 0;
-	int utf8_parent_filename_is_set = 0;
+	grain_descriptor.file_index += 1;
 
-	/* Test regular cases
+	result = libvmdk_internal_handle_get_contiguous_grains_size(
+	          internal_handle,
+	          internal_handle->extent_data_file_io_pool,
+	          0,
+	          &grain_descriptor,
+	          64 * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE,
+	          &contiguous_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "contiguous_size",
+	 contiguous_size,
+	 (size_t) VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE );
+
+	/* Test that a run does not start in the middle of a grain
 	 */
-	result = libvmdk_handle_get_utf8_parent_filename(
-	          handle,
-	          utf8_parent_filename,
-	          512,
+	grain_descriptor.file_index -= 1;
+	grain_descriptor.data_offset = 512;
+
+	result = libvmdk_internal_handle_get_contiguous_grains_size(
+	          internal_handle,
+	          internal_handle->extent_data_file_io_pool,
+	          0,
+	          &grain_descriptor,
+	          64 * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE,
+	          &contiguous_size,
 	          &error );
 
-	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	utf8_parent_filename_is_set = result;
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "contiguous_size",
+	 contiguous_size,
+	 (size_t) 0 );
+
+	grain_descriptor.data_offset = 0;
 
 	/* Test error cases
 	 */
-	result = libvmdk_handle_get_utf8_parent_filename(
+	result = libvmdk_internal_handle_get_contiguous_grains_size(
 	          NULL,
-	          utf8_parent_filename,
-	          512,
+	          internal_handle->extent_data_file_io_pool,
+	          0,
+	          &grain_descriptor,
+	          64 * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE,
+	          &contiguous_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -2352,107 +5167,34 @@ int vmdk_test_handle_get_utf8_parent_filename(
 	libcerror_error_free(
 	 &error );
 
-	if( utf8_parent_filename_is_set != 0 )
-	{
-		result = libvmdk_handle_get_utf8_parent_filename(
-		          handle,
-		          NULL,
-		          512,
-		          &error );
-
-		VMDK_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		VMDK_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-
-		result = libvmdk_handle_get_utf8_parent_filename(
-		          handle,
-		          utf8_parent_filename,
-		          0,
-		          &error );
-
-		VMDK_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		VMDK_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-
-		result = libvmdk_handle_get_utf8_parent_filename(
-		          handle,
-		          utf8_parent_filename,
-		          (size_t) SSIZE_MAX + 1,
-		          &error );
-
-		VMDK_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		VMDK_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
-
-/* Tests the libvmdk_handle_get_utf16_parent_filename_size function
- * Returns 1 if successful or 0 if not
- */
-int vmdk_test_handle_get_utf16_parent_filename_size(
-     libvmdk_handle_t *handle )
-{
-	libcerror_error_t *error              = NULL;
-	size_t utf16_parent_filename_size     = 0;
-	int result                            = 0;
-	int utf16_parent_filename_size_is_set = 0;
-
-	/* Test regular cases
-	 */
-	result = libvmdk_handle_get_utf16_parent_filename_size(
-	          handle,
-	          &utf16_parent_filename_size,
+	result = libvmdk_internal_handle_get_contiguous_grains_size(
+	          internal_handle,
+	          internal_handle->extent_data_file_io_pool,
+	          0,
+	          NULL,
+	          64 * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE,
+	          &contiguous_size,
 	          &error );
 
-	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 -1 );
 
-	VMDK_TEST_ASSERT_IS_NULL(
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	utf16_parent_filename_size_is_set = result;
+	libcerror_error_free(
+	 &error );
 
-	/* Test error cases
-	 */
-	result = libvmdk_handle_get_utf16_parent_filename_size(
+	result = libvmdk_internal_handle_get_contiguous_grains_size(
+	          internal_handle,
+	          internal_handle->extent_data_file_io_pool,
+	          0,
+	          &grain_descriptor,
+	          64 * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE,
 	          NULL,
-	          &utf16_parent_filename_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -2467,221 +5209,230 @@ int vmdk_test_handle_get_utf16_parent_filename_size(
 	libcerror_error_free(
 	 &error );
 
-	if( utf16_parent_filename_size_is_set != 0 )
-	{
-		result = libvmdk_handle_get_utf16_parent_filename_size(
-		          handle,
-		          NULL,
-		          &error );
+	/* Clean up
+	 */
+	result = vmdk_test_close_sparse_image(
+	          &handle,
+	          &file_io_handle,
+	          &file_io_pool,
+	          &error );
 
-		VMDK_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		VMDK_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 image_data );
+
+	image_data = NULL;
+
+	/* Test that a compressed grain does not start a run
+	 */
+	result = vmdk_test_create_sparse_image_data(
+	          "AAAA",
+	          4,
+	          1,
+	          &image_data,
+	          &image_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		libcerror_error_free(
-		 &error );
-	}
-	return( 1 );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	result = vmdk_test_open_sparse_image(
+	          &handle,
+	          &file_io_handle,
+	          &file_io_pool,
+	          image_data,
+	          image_data_size,
+	          &error );
 
-/* Tests the libvmdk_handle_get_utf16_parent_filename function
- * Returns 1 if successful or 0 if not
- */
-int vmdk_test_handle_get_utf16_parent_filename(
-     libvmdk_handle_t *handle )
-{
-	uint16_t utf16_parent_filename[ 512 ];
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	libcerror_error_t *error         = NULL;
-	int result                       = 0;
-	int utf16_parent_filename_is_set = 0;
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* Test regular cases
-	 */
-	result = libvmdk_handle_get_utf16_parent_filename(
+	result = vmdk_test_internal_handle_get_contiguous_grains_size_of_grain(
 	          handle,
-	          utf16_parent_filename,
-	          512,
+	          0,
+	          4 * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE,
+	          &contiguous_size,
 	          &error );
 
-	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	utf16_parent_filename_is_set = result;
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "contiguous_size",
+	 contiguous_size,
+	 (size_t) 0 );
 
-	/* Test error cases
-	 */
-	result = libvmdk_handle_get_utf16_parent_filename(
-	          NULL,
-	          utf16_parent_filename,
-	          512,
+	result = vmdk_test_close_sparse_image(
+	          &handle,
+	          &file_io_handle,
+	          &file_io_pool,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	memory_free(
+	 image_data );
 
-	if( utf16_parent_filename_is_set != 0 )
-	{
-		result = libvmdk_handle_get_utf16_parent_filename(
-		          handle,
-		          NULL,
-		          512,
-		          &error );
+	image_data = NULL;
 
-		VMDK_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	/* Test that the run is limited to the maximum contiguous grains read size
+	 * with more contiguous grains than fit in the maximum contiguous grains read size
+	 */
+	large_grain_layout = (char *) memory_allocate(
+	                               sizeof( char ) * ( ( LIBVMDK_MAXIMUM_CONTIGUOUS_GRAINS_READ_SIZE / VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE ) + 5 ) );
 
-		VMDK_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "large_grain_layout",
+	 large_grain_layout );
 
-		libcerror_error_free(
-		 &error );
+	result = memory_set(
+	          large_grain_layout,
+	          (int) 'A',
+	          ( LIBVMDK_MAXIMUM_CONTIGUOUS_GRAINS_READ_SIZE / VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE ) + 4 ) != NULL;
 
-		result = libvmdk_handle_get_utf16_parent_filename(
-		          handle,
-		          utf16_parent_filename,
-		          0,
-		          &error );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		VMDK_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	large_grain_layout[ ( LIBVMDK_MAXIMUM_CONTIGUOUS_GRAINS_READ_SIZE / VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE ) + 4 ] = 0;
 
-		VMDK_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	result = vmdk_test_create_sparse_image_data(
+	          large_grain_layout,
+	          512,
+	          0,
+	          &image_data,
+	          &image_data_size,
+	          &error );
 
-		libcerror_error_free(
-		 &error );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		result = libvmdk_handle_get_utf16_parent_filename(
-		          handle,
-		          utf16_parent_filename,
-		          (size_t) SSIZE_MAX + 1,
-		          &error );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		VMDK_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	memory_free(
+	 large_grain_layout );
 
-		VMDK_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	large_grain_layout = NULL;
 
-		libcerror_error_free(
-		 &error );
-	}
-	return( 1 );
+	result = vmdk_test_open_sparse_image(
+	          &handle,
+	          &file_io_handle,
+	          &file_io_pool,
+	          image_data,
+	          image_data_size,
+	          &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-/* Tests the libvmdk_handle_get_number_of_extents function
- * Returns 1 if successful or 0 if not
- */
-int vmdk_test_handle_get_number_of_extents(
-     libvmdk_handle_t *handle )
-{
-	libcerror_error_t *error     = NULL;
-	int number_of_extents        = 0;
-	int number_of_extents_is_set = 0;
-	int result                   = 0;
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* Test regular cases
-	 */
-	result = libvmdk_handle_get_number_of_extents(
+	result = vmdk_test_internal_handle_get_contiguous_grains_size_of_grain(
 	          handle,
-	          &number_of_extents,
+	          0,
+	          LIBVMDK_MAXIMUM_CONTIGUOUS_GRAINS_READ_SIZE,
+	          &contiguous_size,
 	          &error );
 
-	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	number_of_extents_is_set = result;
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "contiguous_size",
+	 contiguous_size,
+	 (size_t) LIBVMDK_MAXIMUM_CONTIGUOUS_GRAINS_READ_SIZE );
 
-	/* Test error cases
+	/* Test that the run ends at the last grain when the maximum size is limited to the media size
 	 */
-	result = libvmdk_handle_get_number_of_extents(
-	          NULL,
-	          &number_of_extents,
+	result = vmdk_test_internal_handle_get_contiguous_grains_size_of_grain(
+	          handle,
+	          LIBVMDK_MAXIMUM_CONTIGUOUS_GRAINS_READ_SIZE / VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE,
+	          4 * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE,
+	          &contiguous_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "contiguous_size",
+	 contiguous_size,
+	 (size_t) ( 4 * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE ) );
 
-	if( number_of_extents_is_set != 0 )
-	{
-		result = libvmdk_handle_get_number_of_extents(
-		          handle,
-		          NULL,
-		          &error );
+	/* Clean up
+	 */
+	result = vmdk_test_close_sparse_image(
+	          &handle,
+	          &file_io_handle,
+	          &file_io_pool,
+	          &error );
 
-		VMDK_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		VMDK_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 image_data );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -2690,9 +5441,29 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( handle != NULL )
+	{
+		vmdk_test_close_sparse_image(
+		 &handle,
+		 &file_io_handle,
+		 &file_io_pool,
+		 NULL );
+	}
+	if( large_grain_layout != NULL )
+	{
+		memory_free(
+		 large_grain_layout );
+	}
+	if( image_data != NULL )
+	{
+		memory_free(
+		 image_data );
+	}
 	return( 0 );
 }
 
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -2750,6 +5521,18 @@ int main(
 	 "libvmdk_handle_free",
 	 vmdk_test_handle_free );
 
+	VMDK_TEST_RUN(
+	 "libvmdk_handle_get_extent_map_run_at_offset_sparse",
+	 vmdk_test_handle_get_extent_map_run_at_offset_sparse );
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_internal_handle_get_contiguous_grains_size",
+	 vmdk_test_internal_handle_get_contiguous_grains_size );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
@@ -2894,6 +5677,16 @@ int main(
 		 vmdk_test_handle_read_buffer_at_offset,
 		 handle );
 
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_read_ranges",
+		 vmdk_test_handle_read_ranges,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_submit_read",
+		 vmdk_test_handle_submit_read,
+		 handle );
+
 		/* TODO: add tests for libvmdk_handle_write_buffer */
 
 		/* TODO: add tests for libvmdk_handle_write_buffer_at_offset */
@@ -2952,6 +5745,16 @@ int main(
 		 vmdk_test_handle_get_utf16_parent_filename,
 		 handle );
 
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_get_number_of_grain_directory_mismatches",
+		 vmdk_test_handle_get_number_of_grain_directory_mismatches,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_get_memory_usage",
+		 vmdk_test_handle_get_memory_usage,
+		 handle );
+
 		VMDK_TEST_RUN_WITH_ARGS(
 		 "libvmdk_handle_get_number_of_extents",
 		 vmdk_test_handle_get_number_of_extents,
@@ -2959,6 +5762,40 @@ int main(
 
 		/* TODO: add tests for libvmdk_handle_get_extent_descriptor */
 
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_get_extent_map_run_at_offset",
+		 vmdk_test_handle_get_extent_map_run_at_offset,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_copy_to_file_io_handle",
+		 vmdk_test_handle_copy_to_file_io_handle,
+		 handle );
+
+#if defined( LIBVMDK_HAVE_COPY_TO_FILE_DESCRIPTOR ) && defined( HAVE_MKSTEMP ) && defined( HAVE_UNLINK )
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_copy_to_file_descriptor",
+		 vmdk_test_handle_copy_to_file_descriptor,
+		 handle );
+
+#endif /* defined( LIBVMDK_HAVE_COPY_TO_FILE_DESCRIPTOR ) && defined( HAVE_MKSTEMP ) && defined( HAVE_UNLINK ) */
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_check_extent",
+		 vmdk_test_handle_check_extent,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_get_number_of_corrupted_ranges",
+		 vmdk_test_handle_get_number_of_corrupted_ranges,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_get_corrupted_range",
+		 vmdk_test_handle_get_corrupted_range,
+		 handle );
+
 		/* Clean up
 		 */
 		result = vmdk_test_handle_close_source(
@@ -0,0 +1,454 @@
+/*
+ * Library read_request type test program
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_read_request.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Read request callback function for testing
+ */
+void vmdk_test_read_request_callback(
+      libvmdk_handle_t *handle VMDK_TEST_ATTRIBUTE_UNUSED,
+      void *buffer VMDK_TEST_ATTRIBUTE_UNUSED,
+      ssize_t read_count VMDK_TEST_ATTRIBUTE_UNUSED,
+      libcerror_error_t *error VMDK_TEST_ATTRIBUTE_UNUSED,
+      void *callback_data VMDK_TEST_ATTRIBUTE_UNUSED )
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( handle )
+	VMDK_TEST_UNREFERENCED_PARAMETER( buffer )
+	VMDK_TEST_UNREFERENCED_PARAMETER( read_count )
+	VMDK_TEST_UNREFERENCED_PARAMETER( error )
+	VMDK_TEST_UNREFERENCED_PARAMETER( callback_data )
+}
+
+/* Tests the libvmdk_read_request_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_read_request_initialize(
+     void )
+{
+	uint8_t buffer[ 64 ];
+
+	libcerror_error_t *error             = NULL;
+	libvmdk_read_request_t *read_request = NULL;
+	int result                           = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests      = 1;
+	int number_of_memset_fail_tests      = 1;
+	int test_number                      = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_read_request_initialize(
+	          &read_request,
+	          buffer,
+	          64,
+	          0,
+	          &vmdk_test_read_request_callback,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "read_request",
+	 read_request );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_read_request_free(
+	          &read_request,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "read_request",
+	 read_request );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_read_request_initialize(
+	          NULL,
+	          buffer,
+	          64,
+	          0,
+	          &vmdk_test_read_request_callback,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_request = (libvmdk_read_request_t *) 0x12345678UL;
+
+	result = libvmdk_read_request_initialize(
+	          &read_request,
+	          buffer,
+	          64,
+	          0,
+	          &vmdk_test_read_request_callback,
+	          NULL,
+	          &error );
+
+	read_request = NULL;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_read_request_initialize(
+	          &read_request,
+	          NULL,
+	          64,
+	          0,
+	          &vmdk_test_read_request_callback,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "read_request",
+	 read_request );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_read_request_initialize(
+	          &read_request,
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          0,
+	          &vmdk_test_read_request_callback,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "read_request",
+	 read_request );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_read_request_initialize(
+	          &read_request,
+	          buffer,
+	          64,
+	          -1,
+	          &vmdk_test_read_request_callback,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "read_request",
+	 read_request );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_read_request_initialize(
+	          &read_request,
+	          buffer,
+	          64,
+	          0,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "read_request",
+	 read_request );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_read_request_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_read_request_initialize(
+		          &read_request,
+		          buffer,
+		          64,
+		          0,
+		          &vmdk_test_read_request_callback,
+		          NULL,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( read_request != NULL )
+			{
+				libvmdk_read_request_free(
+				 &read_request,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "read_request",
+			 read_request );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_read_request_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_read_request_initialize(
+		          &read_request,
+		          buffer,
+		          64,
+		          0,
+		          &vmdk_test_read_request_callback,
+		          NULL,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( read_request != NULL )
+			{
+				libvmdk_read_request_free(
+				 &read_request,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "read_request",
+			 read_request );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_request != NULL )
+	{
+		libvmdk_read_request_free(
+		 &read_request,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_read_request_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_read_request_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_read_request_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_read_request_initialize",
+	 vmdk_test_read_request_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_read_request_free",
+	 vmdk_test_read_request_free );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+}
+
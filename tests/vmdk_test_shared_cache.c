@@ -0,0 +1,1406 @@
+/*
+ * Library shared_cache type test program
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_shared_cache.h"
+
+uint8_t vmdk_test_shared_cache_data1[ 64 ] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+	0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+	0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f };
+
+/* Tests the libvmdk_shared_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_shared_cache_initialize(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libvmdk_shared_cache_t *shared_cache = NULL;
+	int result                           = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests      = 2;
+	int number_of_memset_fail_tests      = 2;
+	int test_number                      = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_shared_cache_initialize(
+	          &shared_cache,
+	          1024 * 1024,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "shared_cache",
+	 shared_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_shared_cache_free(
+	          &shared_cache,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "shared_cache",
+	 shared_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_shared_cache_initialize(
+	          NULL,
+	          1024 * 1024,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	shared_cache = (libvmdk_shared_cache_t *) 0x12345678UL;
+
+	result = libvmdk_shared_cache_initialize(
+	          &shared_cache,
+	          1024 * 1024,
+	          &error );
+
+	shared_cache = NULL;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_shared_cache_initialize(
+	          &shared_cache,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "shared_cache",
+	 shared_cache );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_shared_cache_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_shared_cache_initialize(
+		          &shared_cache,
+		          1024 * 1024,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( shared_cache != NULL )
+			{
+				libvmdk_shared_cache_free(
+				 &shared_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "shared_cache",
+			 shared_cache );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_shared_cache_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_shared_cache_initialize(
+		          &shared_cache,
+		          1024 * 1024,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( shared_cache != NULL )
+			{
+				libvmdk_shared_cache_free(
+				 &shared_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "shared_cache",
+			 shared_cache );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( shared_cache != NULL )
+	{
+		libvmdk_shared_cache_free(
+		 &shared_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_shared_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_shared_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_shared_cache_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_shared_cache_get_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_shared_cache_get_size(
+     libvmdk_shared_cache_t *shared_cache )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_shared_cache_get_size(
+	          shared_cache,
+	          &size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_shared_cache_get_size(
+	          NULL,
+	          &size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_shared_cache_get_size(
+	          shared_cache,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Tests the libvmdk_shared_cache_get_data and libvmdk_shared_cache_set_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_shared_cache_get_data(
+     void )
+{
+	uint8_t data[ 64 ];
+
+	libcerror_error_t *error             = NULL;
+	libvmdk_shared_cache_t *shared_cache = NULL;
+	size64_t size                        = 0;
+	size_t cached_data_size              = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_shared_cache_initialize(
+	          &shared_cache,
+	          128,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "shared_cache",
+	 shared_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_shared_cache_get_data(
+	          shared_cache,
+	          1,
+	          0,
+	          0,
+	          data,
+	          64,
+	          &cached_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_shared_cache_set_data(
+	          shared_cache,
+	          1,
+	          0,
+	          0,
+	          vmdk_test_shared_cache_data1,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_shared_cache_get_data(
+	          shared_cache,
+	          1,
+	          0,
+	          0,
+	          data,
+	          64,
+	          &cached_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "cached_data_size",
+	 cached_data_size,
+	 (size_t) 64 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          vmdk_test_shared_cache_data1,
+	          64 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test data of a different disk identifier is not returned
+	 */
+	result = libvmdk_shared_cache_get_data(
+	          shared_cache,
+	          2,
+	          0,
+	          0,
+	          data,
+	          64,
+	          &cached_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the least recently used data is evicted when the cache is full
+	 */
+	result = libvmdk_shared_cache_set_data(
+	          shared_cache,
+	          1,
+	          0,
+	          64,
+	          vmdk_test_shared_cache_data1,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_shared_cache_set_data(
+	          shared_cache,
+	          1,
+	          0,
+	          128,
+	          vmdk_test_shared_cache_data1,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_shared_cache_get_size(
+	          shared_cache,
+	          &size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 (uint64_t) size,
+	 (uint64_t) 128 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_shared_cache_get_data(
+	          shared_cache,
+	          1,
+	          0,
+	          0,
+	          data,
+	          64,
+	          &cached_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_shared_cache_get_data(
+	          shared_cache,
+	          1,
+	          0,
+	          128,
+	          data,
+	          64,
+	          &cached_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_shared_cache_get_data(
+	          NULL,
+	          1,
+	          0,
+	          0,
+	          data,
+	          64,
+	          &cached_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_shared_cache_get_data(
+	          shared_cache,
+	          1,
+	          0,
+	          0,
+	          NULL,
+	          64,
+	          &cached_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_shared_cache_get_data(
+	          shared_cache,
+	          1,
+	          0,
+	          0,
+	          data,
+	          64,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_shared_cache_set_data(
+	          NULL,
+	          1,
+	          0,
+	          0,
+	          vmdk_test_shared_cache_data1,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_shared_cache_set_data(
+	          shared_cache,
+	          1,
+	          0,
+	          0,
+	          NULL,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_shared_cache_free(
+	          &shared_cache,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "shared_cache",
+	 shared_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( shared_cache != NULL )
+	{
+		libvmdk_shared_cache_free(
+		 &shared_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_shared_cache_get_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_shared_cache_get_identifier(
+     void )
+{
+	uint8_t image_identifier1[ 20 ] = {
+		'/', 'v', 'm', '1', '/', 'd', 'i', 's', 'k', '.', 'v', 'm', 'd', 'k', 0, 0, 0, 0, 0, 0 };
+	uint8_t image_identifier2[ 20 ] = {
+		'/', 'v', 'm', '2', '/', 'd', 'i', 's', 'k', '.', 'v', 'm', 'd', 'k', 0, 0, 0, 0, 0, 0 };
+
+	libcerror_error_t *error             = NULL;
+	libvmdk_shared_cache_t *shared_cache = NULL;
+	uint64_t identifier1                 = 0;
+	uint64_t identifier2                 = 0;
+	uint64_t identifier3                 = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_shared_cache_initialize(
+	          &shared_cache,
+	          128,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "shared_cache",
+	 shared_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_shared_cache_get_identifier(
+	          shared_cache,
+	          image_identifier1,
+	          14,
+	          &identifier1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A copy of the same image at a different location must not share cached data
+	 */
+	result = libvmdk_shared_cache_get_identifier(
+	          shared_cache,
+	          image_identifier2,
+	          14,
+	          &identifier2,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "identifier2",
+	 (int64_t) identifier2,
+	 (int64_t) identifier1 );
+
+	/* The same image identifier must map onto the same identifier
+	 */
+	result = libvmdk_shared_cache_get_identifier(
+	          shared_cache,
+	          image_identifier1,
+	          14,
+	          &identifier3,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "identifier3",
+	 identifier3,
+	 identifier1 );
+
+	/* An image identifier that only differs in size must not match
+	 */
+	result = libvmdk_shared_cache_get_identifier(
+	          shared_cache,
+	          image_identifier1,
+	          15,
+	          &identifier3,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "identifier3",
+	 (int64_t) identifier3,
+	 (int64_t) identifier1 );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "identifier3",
+	 (int64_t) identifier3,
+	 (int64_t) identifier2 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_shared_cache_get_identifier(
+	          NULL,
+	          image_identifier1,
+	          14,
+	          &identifier1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_shared_cache_get_identifier(
+	          shared_cache,
+	          NULL,
+	          14,
+	          &identifier1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_shared_cache_get_identifier(
+	          shared_cache,
+	          image_identifier1,
+	          0,
+	          &identifier1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_shared_cache_get_identifier(
+	          shared_cache,
+	          image_identifier1,
+	          14,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_shared_cache_free(
+	          &shared_cache,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "shared_cache",
+	 shared_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( shared_cache != NULL )
+	{
+		libvmdk_shared_cache_free(
+		 &shared_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_shared_cache_get_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_shared_cache_get_statistics(
+     void )
+{
+	uint8_t data[ 16 ];
+	uint8_t image_identifier1[ 14 ] = {
+		'/', 'v', 'm', '1', '/', 'd', 'i', 's', 'k', '.', 'v', 'm', 'd', 'k' };
+	uint8_t image_identifier2[ 14 ] = {
+		'/', 'v', 'm', '2', '/', 'd', 'i', 's', 'k', '.', 'v', 'm', 'd', 'k' };
+
+	libcerror_error_t *error             = NULL;
+	libvmdk_shared_cache_t *shared_cache = NULL;
+	size_t cached_data_size              = 0;
+	uint64_t identifier1                 = 0;
+	uint64_t number_of_hits              = 0;
+	uint64_t number_of_misses            = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_shared_cache_initialize(
+	          &shared_cache,
+	          128,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "shared_cache",
+	 shared_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_shared_cache_get_identifier(
+	          shared_cache,
+	          image_identifier1,
+	          14,
+	          &identifier1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Cause a cache miss followed by a cache hit
+	 */
+	result = libvmdk_shared_cache_get_data(
+	          shared_cache,
+	          identifier1,
+	          0,
+	          0,
+	          data,
+	          16,
+	          &cached_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_shared_cache_set_data(
+	          shared_cache,
+	          identifier1,
+	          0,
+	          0,
+	          data,
+	          16,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_shared_cache_get_data(
+	          shared_cache,
+	          identifier1,
+	          0,
+	          0,
+	          data,
+	          16,
+	          &cached_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_shared_cache_get_statistics(
+	          shared_cache,
+	          NULL,
+	          0,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_hits",
+	 number_of_hits,
+	 (uint64_t) 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_misses",
+	 number_of_misses,
+	 (uint64_t) 1 );
+
+	number_of_hits   = 0;
+	number_of_misses = 0;
+
+	result = libvmdk_shared_cache_get_statistics(
+	          shared_cache,
+	          image_identifier1,
+	          14,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_hits",
+	 number_of_hits,
+	 (uint64_t) 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_misses",
+	 number_of_misses,
+	 (uint64_t) 1 );
+
+	/* An image that is not registered has no statistics
+	 */
+	result = libvmdk_shared_cache_get_statistics(
+	          shared_cache,
+	          image_identifier2,
+	          14,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_shared_cache_get_statistics(
+	          NULL,
+	          image_identifier1,
+	          14,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_shared_cache_get_statistics(
+	          shared_cache,
+	          image_identifier1,
+	          0,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_shared_cache_get_statistics(
+	          shared_cache,
+	          image_identifier1,
+	          14,
+	          NULL,
+	          &number_of_misses,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_shared_cache_get_statistics(
+	          shared_cache,
+	          image_identifier1,
+	          14,
+	          &number_of_hits,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_shared_cache_free(
+	          &shared_cache,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "shared_cache",
+	 shared_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( shared_cache != NULL )
+	{
+		libvmdk_shared_cache_free(
+		 &shared_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	libcerror_error_t *error             = NULL;
+	libvmdk_shared_cache_t *shared_cache = NULL;
+	int result                           = 0;
+
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_shared_cache_initialize",
+	 vmdk_test_shared_cache_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_shared_cache_free",
+	 vmdk_test_shared_cache_free );
+
+	/* Initialize shared cache for tests
+	 */
+	result = libvmdk_shared_cache_initialize(
+	          &shared_cache,
+	          1024 * 1024,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "shared_cache",
+	 shared_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_RUN_WITH_ARGS(
+	 "libvmdk_shared_cache_get_size",
+	 vmdk_test_shared_cache_get_size,
+	 shared_cache );
+
+	/* Clean up
+	 */
+	result = libvmdk_shared_cache_free(
+	          &shared_cache,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "shared_cache",
+	 shared_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_shared_cache_get_data",
+	 vmdk_test_shared_cache_get_data );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_shared_cache_get_identifier",
+	 vmdk_test_shared_cache_get_identifier );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_shared_cache_get_statistics",
+	 vmdk_test_shared_cache_get_statistics );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( shared_cache != NULL )
+	{
+		libvmdk_shared_cache_free(
+		 &shared_cache,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
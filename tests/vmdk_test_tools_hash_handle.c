@@ -0,0 +1,824 @@
+/*
+ * Tools hash_handle type test program
+ *
+ * Copyright (C) 2014-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "vmdk_test_functions.h"
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../vmdktools/hash_handle.h"
+
+#if defined( HAVE_UNLINK )
+
+/* The grain layout of the test image, with allocated grains, sparse grains and a sparse grain table
+ */
+static const char *vmdk_test_tools_hash_handle_grain_layout = "AA.G----A..AAAAA";
+
+#endif /* defined( HAVE_UNLINK ) */
+
+/* Tests the hash_handle_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_tools_hash_handle_initialize(
+     void )
+{
+	hash_handle_t *hash_handle      = NULL;
+	libcerror_error_t *error        = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = hash_handle_initialize(
+	          &hash_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "hash_handle",
+	 hash_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = hash_handle_free(
+	          &hash_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "hash_handle",
+	 hash_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = hash_handle_initialize(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	hash_handle = (hash_handle_t *) 0x12345678UL;
+
+	result = hash_handle_initialize(
+	          &hash_handle,
+	          &error );
+
+	hash_handle = NULL;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test hash_handle_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = hash_handle_initialize(
+		          &hash_handle,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( hash_handle != NULL )
+			{
+				hash_handle_free(
+				 &hash_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "hash_handle",
+			 hash_handle );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test hash_handle_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = hash_handle_initialize(
+		          &hash_handle,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( hash_handle != NULL )
+			{
+				hash_handle_free(
+				 &hash_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "hash_handle",
+			 hash_handle );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( hash_handle != NULL )
+	{
+		hash_handle_free(
+		 &hash_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the hash_handle_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_tools_hash_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = hash_handle_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the hash_handle_set_number_of_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_tools_hash_handle_set_number_of_threads(
+     void )
+{
+	hash_handle_t *hash_handle = NULL;
+	libcerror_error_t *error   = NULL;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = hash_handle_initialize(
+	          &hash_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "hash_handle",
+	 hash_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = hash_handle_set_number_of_threads(
+	          hash_handle,
+	          _SYSTEM_STRING( "0" ),
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "hash_handle->number_of_threads",
+	 hash_handle->number_of_threads,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	result = hash_handle_set_number_of_threads(
+	          hash_handle,
+	          _SYSTEM_STRING( "12" ),
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "hash_handle->number_of_threads",
+	 hash_handle->number_of_threads,
+	 12 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+#endif
+
+	/* Test error cases
+	 */
+	result = hash_handle_set_number_of_threads(
+	          NULL,
+	          _SYSTEM_STRING( "0" ),
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = hash_handle_set_number_of_threads(
+	          hash_handle,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = hash_handle_set_number_of_threads(
+	          hash_handle,
+	          _SYSTEM_STRING( "" ),
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = hash_handle_set_number_of_threads(
+	          hash_handle,
+	          _SYSTEM_STRING( "4x" ),
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = hash_handle_set_number_of_threads(
+	          hash_handle,
+	          _SYSTEM_STRING( "33" ),
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = hash_handle_free(
+	          &hash_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "hash_handle",
+	 hash_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( hash_handle != NULL )
+	{
+		hash_handle_free(
+		 &hash_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_UNLINK )
+
+/* Tests the hash_handle_hash_input function
+ * The digest hashes of a sparse image are compared with known digest hashes of its media data
+ * for uncompressed and compressed grains, single-threaded and multi-threaded
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_tools_hash_handle_hash_input(
+     void )
+{
+	system_character_t *filenames[ 1 ] = {
+		(system_character_t *) _SYSTEM_STRING( "test.vmdk" ) };
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	const system_character_t *number_of_threads_strings[ 3 ] = {
+		_SYSTEM_STRING( "0" ),
+		_SYSTEM_STRING( "1" ),
+		_SYSTEM_STRING( "4" ) };
+#else
+	const system_character_t *number_of_threads_strings[ 1 ] = {
+		_SYSTEM_STRING( "0" ) };
+#endif
+
+	FILE *file_stream          = NULL;
+	hash_handle_t *hash_handle = NULL;
+	libcerror_error_t *error   = NULL;
+	uint8_t *image_data        = NULL;
+	size_t image_data_size     = 0;
+	size_t write_count         = 0;
+	uint8_t compress_grains    = 0;
+	int file_exists            = 0;
+	int number_of_tests        = (int) ( sizeof( number_of_threads_strings ) / sizeof( system_character_t * ) );
+	int result                 = 0;
+	int test_number            = 0;
+
+	for( compress_grains = 0;
+	     compress_grains <= 1;
+	     compress_grains++ )
+	{
+		/* Initialize test
+		 */
+		result = vmdk_test_create_sparse_image_data(
+		          vmdk_test_tools_hash_handle_grain_layout,
+		          4,
+		          compress_grains,
+		          &image_data,
+		          &image_data_size,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "image_data",
+		 image_data );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The descriptor of the test image refers to test.vmdk as its extent data file
+		 */
+		file_stream = file_stream_open(
+		               "test.vmdk",
+		               FILE_STREAM_BINARY_OPEN_WRITE );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "file_stream",
+		 file_stream );
+
+		file_exists = 1;
+
+		write_count = file_stream_write(
+		               file_stream,
+		               image_data,
+		               image_data_size );
+
+		result = file_stream_close(
+		          file_stream );
+
+		file_stream = NULL;
+
+		VMDK_TEST_ASSERT_EQUAL_SIZE(
+		 "write_count",
+		 write_count,
+		 image_data_size );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		memory_free(
+		 image_data );
+
+		image_data = NULL;
+
+		for( test_number = 0;
+		     test_number < number_of_tests;
+		     test_number++ )
+		{
+			result = hash_handle_initialize(
+			          &hash_handle,
+			          &error );
+
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = hash_handle_set_additional_digest_types(
+			          hash_handle,
+			          _SYSTEM_STRING( "sha1,sha256" ),
+			          &error );
+
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = hash_handle_set_number_of_threads(
+			          hash_handle,
+			          number_of_threads_strings[ test_number ],
+			          &error );
+
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			/* Use a process buffer size that is not a multiple of the grain size
+			 * so that ranges start and end within grains
+			 */
+			hash_handle->process_buffer_size = ( 3 * VMDK_TEST_SPARSE_IMAGE_GRAIN_SIZE ) + 512;
+
+			result = hash_handle_open_input(
+			          hash_handle,
+			          filenames,
+			          1,
+			          &error );
+
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			/* Test regular cases
+			 */
+			result = hash_handle_hash_input(
+			          hash_handle,
+			          0,
+			          &error );
+
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = system_string_compare(
+			          hash_handle->calculated_md5_hash_string,
+			          _SYSTEM_STRING( "8b14f27f1292ba205f69e31801af7480" ),
+			          33 );
+
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+
+			result = system_string_compare(
+			          hash_handle->calculated_sha1_hash_string,
+			          _SYSTEM_STRING( "85f445e1406eefcea3621978798c9fd6e74aee97" ),
+			          41 );
+
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+
+			result = system_string_compare(
+			          hash_handle->calculated_sha256_hash_string,
+			          _SYSTEM_STRING( "8c620167d630fb9ad19dd83c7e0f5037828cf5ee2e0d111899fcedffcc3a9afe" ),
+			          65 );
+
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+
+			/* Clean up
+			 */
+			result = hash_handle_close(
+			          hash_handle,
+			          &error );
+
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = hash_handle_free(
+			          &hash_handle,
+			          &error );
+
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "hash_handle",
+			 hash_handle );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		result = unlink(
+		          "test.vmdk" );
+
+		file_exists = 0;
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = hash_handle_hash_input(
+	          NULL,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( hash_handle != NULL )
+	{
+		hash_handle_free(
+		 &hash_handle,
+		 NULL );
+	}
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	if( file_exists != 0 )
+	{
+		unlink(
+		 "test.vmdk" );
+	}
+	if( image_data != NULL )
+	{
+		memory_free(
+		 image_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_UNLINK ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+	VMDK_TEST_RUN(
+	 "hash_handle_initialize",
+	 vmdk_test_tools_hash_handle_initialize );
+
+	VMDK_TEST_RUN(
+	 "hash_handle_free",
+	 vmdk_test_tools_hash_handle_free );
+
+	VMDK_TEST_RUN(
+	 "hash_handle_set_number_of_threads",
+	 vmdk_test_tools_hash_handle_set_number_of_threads );
+
+#if defined( HAVE_UNLINK )
+
+	VMDK_TEST_RUN(
+	 "hash_handle_hash_input",
+	 vmdk_test_tools_hash_handle_hash_input );
+
+#endif /* defined( HAVE_UNLINK ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
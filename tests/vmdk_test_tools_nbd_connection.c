@@ -0,0 +1,659 @@
+/*
+ * Tools nbd_connection type test program
+ *
+ * Copyright (C) 2014-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../vmdktools/nbd_connection.h"
+#include "../vmdktools/serve_handle.h"
+
+#if defined( SERVE_HANDLE_HAVE_SOCKETS )
+#include <sys/socket.h>
+
+/* The client side of a session: the handshake flags, the structured reply and go options,
+ * a read beyond the end of the media and a disconnect
+ */
+uint8_t vmdk_test_tools_nbd_connection_client_data[ 104 ] = {
+	0x00, 0x00, 0x00, 0x03,
+	0x49, 0x48, 0x41, 0x56, 0x45, 0x4f, 0x50, 0x54, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00,
+	0x49, 0x48, 0x41, 0x56, 0x45, 0x4f, 0x50, 0x54, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x06,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x25, 0x60, 0x95, 0x13, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x02, 0x00,
+	0x25, 0x60, 0x95, 0x13, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+/* The server side of the session: the handshake, the option replies, including the export
+ * information of a 4096 bytes read-only media, and the structured error reply to the read
+ */
+uint8_t vmdk_test_tools_nbd_connection_server_data[ 116 ] = {
+	0x4e, 0x42, 0x44, 0x4d, 0x41, 0x47, 0x49, 0x43, 0x49, 0x48, 0x41, 0x56, 0x45, 0x4f, 0x50, 0x54,
+	0x00, 0x03,
+	0x00, 0x03, 0xe8, 0x89, 0x04, 0x55, 0x65, 0xa9, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x01,
+	0x00, 0x00, 0x00, 0x00,
+	0x00, 0x03, 0xe8, 0x89, 0x04, 0x55, 0x65, 0xa9, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x03,
+	0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x01, 0x87,
+	0x00, 0x03, 0xe8, 0x89, 0x04, 0x55, 0x65, 0xa9, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x01,
+	0x00, 0x00, 0x00, 0x00,
+	0x66, 0x8e, 0x33, 0xef, 0x00, 0x01, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+	0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00 };
+
+#endif /* defined( SERVE_HANDLE_HAVE_SOCKETS ) */
+
+/* Tests the nbd_connection_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_tools_nbd_connection_initialize(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	nbd_connection_t *nbd_connection = NULL;
+	serve_handle_t *serve_handle     = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests  = 1;
+	int number_of_memset_fail_tests  = 1;
+	int test_number                  = 0;
+#endif
+
+	/* Initialize test
+	 */
+	result = serve_handle_initialize(
+	          &serve_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "serve_handle",
+	 serve_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = nbd_connection_initialize(
+	          &nbd_connection,
+	          serve_handle,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "nbd_connection",
+	 nbd_connection );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nbd_connection_free(
+	          &nbd_connection,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "nbd_connection",
+	 nbd_connection );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = nbd_connection_initialize(
+	          NULL,
+	          serve_handle,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	nbd_connection = (nbd_connection_t *) 0x12345678UL;
+
+	result = nbd_connection_initialize(
+	          &nbd_connection,
+	          serve_handle,
+	          0,
+	          &error );
+
+	nbd_connection = NULL;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = nbd_connection_initialize(
+	          &nbd_connection,
+	          NULL,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = nbd_connection_initialize(
+	          &nbd_connection,
+	          serve_handle,
+	          -1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test nbd_connection_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = nbd_connection_initialize(
+		          &nbd_connection,
+		          serve_handle,
+		          0,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( nbd_connection != NULL )
+			{
+				nbd_connection_free(
+				 &nbd_connection,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "nbd_connection",
+			 nbd_connection );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test nbd_connection_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = nbd_connection_initialize(
+		          &nbd_connection,
+		          serve_handle,
+		          0,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( nbd_connection != NULL )
+			{
+				nbd_connection_free(
+				 &nbd_connection,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "nbd_connection",
+			 nbd_connection );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
+	result = serve_handle_free(
+	          &serve_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "serve_handle",
+	 serve_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( nbd_connection != NULL )
+	{
+		nbd_connection_free(
+		 &nbd_connection,
+		 NULL );
+	}
+	if( serve_handle != NULL )
+	{
+		serve_handle_free(
+		 &serve_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the nbd_connection_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_tools_nbd_connection_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = nbd_connection_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( SERVE_HANDLE_HAVE_SOCKETS )
+
+/* Tests the nbd_connection_serve function
+ * The client side of the connection is a socket pair that is written before and read after serving
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_tools_nbd_connection_serve(
+     void )
+{
+	uint8_t server_data[ 128 ];
+	int socket_descriptors[ 2 ]      = { -1, -1 };
+
+	libcerror_error_t *error         = NULL;
+	nbd_connection_t *nbd_connection = NULL;
+	serve_handle_t *serve_handle     = NULL;
+	ssize_t read_count               = 0;
+	ssize_t write_count              = 0;
+	size_t server_data_size          = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = socketpair(
+	          AF_UNIX,
+	          SOCK_STREAM,
+	          0,
+	          socket_descriptors );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = serve_handle_initialize(
+	          &serve_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "serve_handle",
+	 serve_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	serve_handle->input_media_size = 4096;
+
+	result = nbd_connection_initialize(
+	          &nbd_connection,
+	          serve_handle,
+	          socket_descriptors[ 1 ],
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "nbd_connection",
+	 nbd_connection );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	write_count = write(
+	               socket_descriptors[ 0 ],
+	               vmdk_test_tools_nbd_connection_client_data,
+	               104 );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 104 );
+
+	/* Test regular cases
+	 */
+	result = nbd_connection_serve(
+	          nbd_connection,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	close(
+	 socket_descriptors[ 1 ] );
+
+	socket_descriptors[ 1 ] = -1;
+
+	do
+	{
+		read_count = read(
+		              socket_descriptors[ 0 ],
+		              &( server_data[ server_data_size ] ),
+		              128 - server_data_size );
+
+		if( read_count > 0 )
+		{
+			server_data_size += (size_t) read_count;
+		}
+	}
+	while( ( read_count > 0 )
+	    && ( server_data_size < 128 ) );
+
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "server_data_size",
+	 server_data_size,
+	 (size_t) 116 );
+
+	result = memory_compare(
+	          server_data,
+	          vmdk_test_tools_nbd_connection_server_data,
+	          116 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = nbd_connection_serve(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = nbd_connection_free(
+	          &nbd_connection,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "nbd_connection",
+	 nbd_connection );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = serve_handle_free(
+	          &serve_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "serve_handle",
+	 serve_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	close(
+	 socket_descriptors[ 0 ] );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( nbd_connection != NULL )
+	{
+		nbd_connection_free(
+		 &nbd_connection,
+		 NULL );
+	}
+	if( serve_handle != NULL )
+	{
+		serve_handle_free(
+		 &serve_handle,
+		 NULL );
+	}
+	if( socket_descriptors[ 1 ] != -1 )
+	{
+		close(
+		 socket_descriptors[ 1 ] );
+	}
+	if( socket_descriptors[ 0 ] != -1 )
+	{
+		close(
+		 socket_descriptors[ 0 ] );
+	}
+	return( 0 );
+}
+
+#endif /* defined( SERVE_HANDLE_HAVE_SOCKETS ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+	VMDK_TEST_RUN(
+	 "nbd_connection_initialize",
+	 vmdk_test_tools_nbd_connection_initialize );
+
+	VMDK_TEST_RUN(
+	 "nbd_connection_free",
+	 vmdk_test_tools_nbd_connection_free );
+
+#if defined( SERVE_HANDLE_HAVE_SOCKETS )
+
+	VMDK_TEST_RUN(
+	 "nbd_connection_serve",
+	 vmdk_test_tools_nbd_connection_serve );
+
+#endif /* defined( SERVE_HANDLE_HAVE_SOCKETS ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,774 @@
+/*
+ * Check handle
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "check_handle.h"
+#include "process_status.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libvmdk.h"
+
+#define CHECK_HANDLE_NOTIFY_STREAM		stdout
+
+/* Creates a check handle
+ * Make sure the value check_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int check_handle_initialize(
+     check_handle_t **check_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "check_handle_initialize";
+
+	if( check_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid check handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *check_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid check handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*check_handle = memory_allocate_structure(
+	                 check_handle_t );
+
+	if( *check_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create check handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *check_handle,
+	     0,
+	     sizeof( check_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear check handle.",
+		 function );
+
+		memory_free(
+		 *check_handle );
+
+		*check_handle = NULL;
+
+		return( -1 );
+	}
+	if( libvmdk_handle_initialize(
+	     &( ( *check_handle )->input_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *check_handle )->notify_stream = CHECK_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *check_handle != NULL )
+	{
+		memory_free(
+		 *check_handle );
+
+		*check_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a check handle
+ * Returns 1 if successful or -1 on error
+ */
+int check_handle_free(
+     check_handle_t **check_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "check_handle_free";
+	int result            = 1;
+
+	if( check_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid check handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *check_handle != NULL )
+	{
+		if( ( *check_handle )->input_handle != NULL )
+		{
+			if( libvmdk_handle_free(
+			     &( ( *check_handle )->input_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *check_handle );
+
+		*check_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the check handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int check_handle_signal_abort(
+     check_handle_t *check_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "check_handle_signal_abort";
+
+	if( check_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid check handle.",
+		 function );
+
+		return( -1 );
+	}
+	check_handle->abort = 1;
+
+	if( check_handle->input_handle != NULL )
+	{
+		if( libvmdk_handle_signal_abort(
+		     check_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Opens the input of the check handle
+ * Only the extent data files of the input are checked, hence parent images are not opened
+ * Returns 1 if successful or -1 on error
+ */
+int check_handle_open_input(
+     check_handle_t *check_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error )
+{
+	static char *function = "check_handle_open_input";
+	int result            = 0;
+
+	if( check_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid check handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_filenames != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of filenames.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_open_wide(
+	          check_handle->input_handle,
+	          filenames[ 0 ],
+	          LIBVMDK_OPEN_READ,
+	          error );
+#else
+	result = libvmdk_handle_open(
+	          check_handle->input_handle,
+	          filenames[ 0 ],
+	          LIBVMDK_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_open_extent_data_files(
+	     check_handle->input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_media_size(
+	     check_handle->input_handle,
+	     &( check_handle->input_media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the check handle
+ * Returns the 0 if successful or -1 on error
+ */
+int check_handle_close(
+     check_handle_t *check_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "check_handle_close";
+
+	if( check_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid check handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_close(
+	     check_handle->input_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Checks the integrity of the input
+ * The extents are checked one at a time, the library distributes the grain groups
+ * of an extent over multiple threads if multi-threading support is available
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int check_handle_check_input(
+     check_handle_t *check_handle,
+     uint8_t print_status_information,
+     libcerror_error_t **error )
+{
+	libvmdk_extent_descriptor_t *extent_descriptor = NULL;
+	process_status_t *process_status               = NULL;
+	static char *function                          = "check_handle_check_input";
+	size64_t extent_size                           = 0;
+	off64_t check_offset                           = 0;
+	off64_t extent_offset                          = 0;
+	int extent_index                               = 0;
+	int number_of_extents                          = 0;
+	int status                                     = PROCESS_STATUS_COMPLETED;
+
+	if( check_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid check handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_number_of_extents(
+	     check_handle->input_handle,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_initialize(
+	     &process_status,
+	     _SYSTEM_STRING( "Check" ),
+	     _SYSTEM_STRING( "checked" ),
+	     _SYSTEM_STRING( "Checked" ),
+	     check_handle->notify_stream,
+	     print_status_information,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_start(
+	     process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start process status.",
+		 function );
+
+		goto on_error;
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( check_handle->abort != 0 )
+		{
+			status = PROCESS_STATUS_ABORTED;
+
+			break;
+		}
+		if( libvmdk_handle_get_extent_descriptor(
+		     check_handle->input_handle,
+		     extent_index,
+		     &extent_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent descriptor: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libvmdk_extent_descriptor_get_range(
+		     extent_descriptor,
+		     &extent_offset,
+		     &extent_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d range.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libvmdk_extent_descriptor_free(
+		     &extent_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free extent descriptor: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libvmdk_handle_check_extent(
+		     check_handle->input_handle,
+		     extent_index,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to check extent: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		check_offset += (off64_t) extent_size;
+
+		if( (size64_t) check_offset > check_handle->input_media_size )
+		{
+			check_offset = (off64_t) check_handle->input_media_size;
+		}
+		if( process_status_update(
+		     process_status,
+		     (size64_t) check_offset,
+		     check_handle->input_media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( process_status_stop(
+	     process_status,
+	     (size64_t) check_offset,
+	     status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to stop process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_free(
+	     &process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_get_number_of_corrupted_ranges(
+	     check_handle->input_handle,
+	     &( check_handle->number_of_corrupted_ranges ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of corrupted ranges.",
+		 function );
+
+		goto on_error;
+	}
+	if( status == PROCESS_STATUS_ABORTED )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	if( process_status != NULL )
+	{
+		process_status_stop(
+		 process_status,
+		 (size64_t) check_offset,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &process_status,
+		 NULL );
+	}
+	if( extent_descriptor != NULL )
+	{
+		libvmdk_extent_descriptor_free(
+		 &extent_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Prints the corruption flags to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int check_handle_corruption_flags_fprint(
+     uint32_t corruption_flags,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function = "check_handle_corruption_flags_fprint";
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( corruption_flags & LIBVMDK_CORRUPTION_FLAG_READ_FAILED ) != 0 )
+	{
+		fprintf(
+		 stream,
+		 "\t\t\t\t\t  (Read failed)\n" );
+	}
+	if( ( corruption_flags & LIBVMDK_CORRUPTION_FLAG_OUT_OF_BOUNDS ) != 0 )
+	{
+		fprintf(
+		 stream,
+		 "\t\t\t\t\t  (Out of bounds)\n" );
+	}
+	if( ( corruption_flags & LIBVMDK_CORRUPTION_FLAG_GRAIN_DIRECTORY_MISMATCH ) != 0 )
+	{
+		fprintf(
+		 stream,
+		 "\t\t\t\t\t  (Grain directory mismatch)\n" );
+	}
+	if( ( corruption_flags & LIBVMDK_CORRUPTION_FLAG_GRAIN_TABLE_MISMATCH ) != 0 )
+	{
+		fprintf(
+		 stream,
+		 "\t\t\t\t\t  (Grain table mismatch)\n" );
+	}
+	if( ( corruption_flags & LIBVMDK_CORRUPTION_FLAG_GRAIN_HEADER_MISMATCH ) != 0 )
+	{
+		fprintf(
+		 stream,
+		 "\t\t\t\t\t  (Grain header mismatch)\n" );
+	}
+	if( ( corruption_flags & LIBVMDK_CORRUPTION_FLAG_DECOMPRESSION_FAILED ) != 0 )
+	{
+		fprintf(
+		 stream,
+		 "\t\t\t\t\t  (Decompression failed)\n" );
+	}
+	return( 1 );
+}
+
+/* Prints the check results to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int check_handle_check_results_fprint(
+     check_handle_t *check_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function     = "check_handle_check_results_fprint";
+	size64_t size             = 0;
+	off64_t offset            = 0;
+	uint32_t corruption_flags = 0;
+	int extent_index          = 0;
+	int range_index           = 0;
+
+	if( check_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid check handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( check_handle->number_of_corrupted_ranges == 0 )
+	{
+		fprintf(
+		 stream,
+		 "No corruption detected.\n" );
+
+		return( 1 );
+	}
+	fprintf(
+	 stream,
+	 "Corrupted ranges:\n" );
+
+	fprintf(
+	 stream,
+	 "\tNumber of ranges\t\t: %d\n",
+	 check_handle->number_of_corrupted_ranges );
+
+	for( range_index = 0;
+	     range_index < check_handle->number_of_corrupted_ranges;
+	     range_index++ )
+	{
+		if( libvmdk_handle_get_corrupted_range(
+		     check_handle->input_handle,
+		     range_index,
+		     &offset,
+		     &size,
+		     &extent_index,
+		     &corruption_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve corrupted range: %d.",
+			 function,
+			 range_index );
+
+			return( -1 );
+		}
+		fprintf(
+		 stream,
+		 "\tRange: %d\n",
+		 range_index + 1 );
+
+		fprintf(
+		 stream,
+		 "\t\tOffset\t\t\t: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 offset,
+		 offset );
+
+		fprintf(
+		 stream,
+		 "\t\tSize\t\t\t: %" PRIu64 "\n",
+		 size );
+
+		fprintf(
+		 stream,
+		 "\t\tExtent\t\t\t: %d\n",
+		 extent_index + 1 );
+
+		fprintf(
+		 stream,
+		 "\t\tCorruption flags\t: 0x%08" PRIx32 "\n",
+		 corruption_flags );
+
+		if( check_handle_corruption_flags_fprint(
+		     corruption_flags,
+		     stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print corruption flags.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	fprintf(
+	 stream,
+	 "\n" );
+
+	return( 1 );
+}
+
@@ -0,0 +1,103 @@
+/*
+ * Check handle
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _CHECK_HANDLE_H )
+#define _CHECK_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libvmdk.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct check_handle check_handle_t;
+
+struct check_handle
+{
+	/* The libvmdk input handle
+	 */
+	libvmdk_handle_t *input_handle;
+
+	/* The input media size
+	 */
+	size64_t input_media_size;
+
+	/* The number of corrupted ranges
+	 */
+	int number_of_corrupted_ranges;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int check_handle_initialize(
+     check_handle_t **check_handle,
+     libcerror_error_t **error );
+
+int check_handle_free(
+     check_handle_t **check_handle,
+     libcerror_error_t **error );
+
+int check_handle_signal_abort(
+     check_handle_t *check_handle,
+     libcerror_error_t **error );
+
+int check_handle_open_input(
+     check_handle_t *check_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error );
+
+int check_handle_close(
+     check_handle_t *check_handle,
+     libcerror_error_t **error );
+
+int check_handle_check_input(
+     check_handle_t *check_handle,
+     uint8_t print_status_information,
+     libcerror_error_t **error );
+
+int check_handle_corruption_flags_fprint(
+     uint32_t corruption_flags,
+     FILE *stream,
+     libcerror_error_t **error );
+
+int check_handle_check_results_fprint(
+     check_handle_t *check_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _CHECK_HANDLE_H ) */
+
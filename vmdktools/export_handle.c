@@ -0,0 +1,2919 @@
+/*
+ * Export handle
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "export_handle.h"
+#include "process_status.h"
+#include "vmdktools_libbfio.h"
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libcpath.h"
+#include "vmdktools_libcthreads.h"
+#include "vmdktools_libvmdk.h"
+
+#define EXPORT_HANDLE_NOTIFY_STREAM		stdout
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Block of zero bytes used to write ranges that are not allocated without reading them
+ */
+static const uint8_t export_handle_zero_block[ EXPORT_HANDLE_ZERO_BLOCK_SIZE ] = { 0 };
+
+#endif
+
+/* Creates an export handle
+ * Make sure the value export_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_initialize(
+     export_handle_t **export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_initialize";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*export_handle = memory_allocate_structure(
+	                  export_handle_t );
+
+	if( *export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create export handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *export_handle,
+	     0,
+	     sizeof( export_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear export handle.",
+		 function );
+
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+
+		return( -1 );
+	}
+	if( libvmdk_handle_initialize(
+	     &( ( *export_handle )->input_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *export_handle )->parent_handles_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize parent handles array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *export_handle )->reader_handles_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize reader handles array.",
+		 function );
+
+		goto on_error;
+	}
+	( *export_handle )->write_sparse        = 1;
+	( *export_handle )->process_buffer_size = EXPORT_HANDLE_PROCESS_BUFFER_SIZE;
+	( *export_handle )->notify_stream       = EXPORT_HANDLE_NOTIFY_STREAM;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	( *export_handle )->number_of_threads = EXPORT_HANDLE_DEFAULT_NUMBER_OF_THREADS;
+#endif
+	return( 1 );
+
+on_error:
+	if( *export_handle != NULL )
+	{
+		if( ( *export_handle )->parent_handles_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *export_handle )->parent_handles_array ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *export_handle )->input_handle != NULL )
+		{
+			libvmdk_handle_free(
+			 &( ( *export_handle )->input_handle ),
+			 NULL );
+		}
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an export handle
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_free(
+     export_handle_t **export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_free";
+	int result            = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_handle != NULL )
+	{
+		if( ( *export_handle )->basename != NULL )
+		{
+			memory_free(
+			 ( *export_handle )->basename );
+		}
+		if( ( *export_handle )->target_file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( ( *export_handle )->target_file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free target file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		/* The input and reader handles reference the parent handles and must be freed first
+		 */
+		if( ( *export_handle )->input_handle != NULL )
+		{
+			if( libvmdk_handle_free(
+			     &( ( *export_handle )->input_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *export_handle )->reader_handles_array != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *export_handle )->reader_handles_array ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free reader handles array.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *export_handle )->parent_handles_array != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *export_handle )->parent_handles_array ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free parent handles array.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the export handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_signal_abort(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *reader_handle = NULL;
+	static char *function           = "export_handle_signal_abort";
+	int number_of_reader_handles    = 0;
+	int reader_index                = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->abort = 1;
+
+	if( export_handle->input_handle != NULL )
+	{
+		if( libvmdk_handle_signal_abort(
+		     export_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( export_handle->reader_handles_array != NULL )
+	{
+		if( libcdata_array_get_number_of_entries(
+		     export_handle->reader_handles_array,
+		     &number_of_reader_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of reader handles.",
+			 function );
+
+			return( -1 );
+		}
+		for( reader_index = 0;
+		     reader_index < number_of_reader_handles;
+		     reader_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     export_handle->reader_handles_array,
+			     reader_index,
+			     (intptr_t **) &reader_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve reader handle: %d.",
+				 function,
+				 reader_index );
+
+				return( -1 );
+			}
+			if( libvmdk_handle_signal_abort(
+			     reader_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal reader handle: %d to abort.",
+				 function,
+				 reader_index );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the basename
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_basename(
+     export_handle_t *export_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_basename";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->basename != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - basename value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( basename_size == 0 )
+	 || ( basename_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid basename size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->basename = system_string_allocate(
+	                           basename_size );
+
+	if( export_handle->basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create basename string.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     export_handle->basename,
+	     basename,
+	     basename_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy basename.",
+		 function );
+
+		goto on_error;
+	}
+	export_handle->basename[ basename_size - 1 ] = 0;
+
+	export_handle->basename_size = basename_size;
+
+	return( 1 );
+
+on_error:
+	if( export_handle->basename != NULL )
+	{
+		memory_free(
+		 export_handle->basename );
+
+		export_handle->basename = NULL;
+	}
+	export_handle->basename_size = 0;
+
+	return( -1 );
+}
+
+/* Sets the number of threads used to read the input
+ * A number of 0 represents single-threaded mode
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_number_of_threads(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_number_of_threads";
+	size_t string_index   = 0;
+	int number_of_threads = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	for( string_index = 0;
+	     string[ string_index ] != 0;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] < (system_character_t) '0' )
+		 || ( string[ string_index ] > (system_character_t) '9' ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character in number of threads string.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_threads *= 10;
+		number_of_threads += (int) ( string[ string_index ] - (system_character_t) '0' );
+
+		if( number_of_threads > EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of threads value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( string_index == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads string value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading is not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	export_handle->number_of_threads = number_of_threads;
+
+	return( 1 );
+}
+
+/* Opens the input of the export handle
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_open_input(
+     export_handle_t *export_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error )
+{
+	system_character_t *basename_end     = NULL;
+	static char *function                = "export_handle_open_input";
+	size_t basename_length               = 0;
+	size_t filename_length               = 0;
+	uint32_t parent_content_identifier   = 0;
+	int result                           = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libvmdk_handle_t *parent_vmdk_handle = NULL;
+	int number_of_parent_handles         = 0;
+#endif
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_filenames != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of filenames.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filenames[ 0 ] );
+
+	basename_end = system_string_search_character_reverse(
+	                filenames[ 0 ],
+	                (system_character_t) LIBCPATH_SEPARATOR,
+	                filename_length + 1 );
+
+	if( basename_end != NULL )
+	{
+		basename_length = (size_t) ( basename_end - filenames[ 0 ] ) + 1;
+	}
+	if( basename_length > 0 )
+	{
+		if( export_handle_set_basename(
+		     export_handle,
+		     filenames[ 0 ],
+		     basename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set basename.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_open_wide(
+	          export_handle->input_handle,
+	          filenames[ 0 ],
+	          LIBVMDK_OPEN_READ,
+	          error );
+#else
+	result = libvmdk_handle_open(
+	          export_handle->input_handle,
+	          filenames[ 0 ],
+	          LIBVMDK_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvmdk_handle_get_parent_content_identifier(
+	          export_handle->input_handle,
+	          &parent_content_identifier,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent content identifier.",
+		 function );
+
+		return( -1 );
+	}
+	else if( ( result != 0 )
+	      && ( parent_content_identifier != 0xffffffffUL ) )
+	{
+		if( export_handle_open_parent(
+		     export_handle,
+		     export_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open parent handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libvmdk_handle_open_extent_data_files(
+	     export_handle->input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_media_size(
+	     export_handle->input_handle,
+	     &( export_handle->input_media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->number_of_threads > 0 )
+	{
+		if( libcdata_array_get_number_of_entries(
+		     export_handle->parent_handles_array,
+		     &number_of_parent_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of parent handles.",
+			 function );
+
+			return( -1 );
+		}
+		/* The parent of the input handle is the last entry appended to the array
+		 */
+		if( number_of_parent_handles > 0 )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     export_handle->parent_handles_array,
+			     number_of_parent_handles - 1,
+			     (intptr_t **) &parent_vmdk_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve parent handle.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( export_handle_open_readers(
+		     export_handle,
+		     filenames[ 0 ],
+		     parent_vmdk_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open reader handles.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( 1 );
+}
+
+/* Opens the parent handle of a specific handle, including its own parents
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_open_parent(
+     export_handle_t *export_handle,
+     libvmdk_handle_t *vmdk_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *parent_vmdk_handle = NULL;
+	system_character_t *parent_filename  = NULL;
+	system_character_t *parent_path      = NULL;
+	static char *function                = "export_handle_open_parent";
+	size_t parent_filename_size          = 0;
+	size_t parent_path_size              = 0;
+	uint32_t parent_content_identifier   = 0;
+	int entry_index                      = 0;
+	int result                           = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename_size(
+	          vmdk_handle,
+	          &parent_filename_size,
+	          error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename_size(
+	          vmdk_handle,
+	          &parent_filename_size,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( parent_filename_size == 0 )
+	 || ( parent_filename_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid parent filename size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	parent_filename = system_string_allocate(
+	                   parent_filename_size );
+
+	if( parent_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parent filename string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename(
+	          vmdk_handle,
+	          (uint16_t *) parent_filename,
+	          parent_filename_size,
+	          error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename(
+	          vmdk_handle,
+	          (uint8_t *) parent_filename,
+	          parent_filename_size,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->basename == NULL )
+	{
+		parent_path      = parent_filename;
+		parent_path_size = parent_filename_size;
+	}
+	else
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libcpath_path_join_wide(
+		          &parent_path,
+		          &parent_path_size,
+		          export_handle->basename,
+		          export_handle->basename_size - 1,
+		          parent_filename,
+		          parent_filename_size - 1,
+		          error );
+#else
+		result = libcpath_path_join(
+		          &parent_path,
+		          &parent_path_size,
+		          export_handle->basename,
+		          export_handle->basename_size - 1,
+		          parent_filename,
+		          parent_filename_size - 1,
+		          error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create parent path.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_handle_initialize(
+	     &parent_vmdk_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize parent handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_open_wide(
+	          parent_vmdk_handle,
+	          parent_path,
+	          LIBVMDK_OPEN_READ,
+	          error );
+#else
+	result = libvmdk_handle_open(
+	          parent_vmdk_handle,
+	          parent_path,
+	          LIBVMDK_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent handle: %" PRIs_SYSTEM ".",
+		 function,
+		 parent_path );
+
+		goto on_error;
+	}
+	if( export_handle->basename != NULL )
+	{
+		memory_free(
+		 parent_path );
+	}
+	parent_path = NULL;
+
+	memory_free(
+	 parent_filename );
+
+	parent_filename = NULL;
+
+	result = libvmdk_handle_get_parent_content_identifier(
+	          parent_vmdk_handle,
+	          &parent_content_identifier,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent content identifier.",
+		 function );
+
+		goto on_error;
+	}
+	else if( ( result != 0 )
+	      && ( parent_content_identifier != 0xffffffffUL ) )
+	{
+		if( export_handle_open_parent(
+		     export_handle,
+		     parent_vmdk_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open parent handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_handle_open_extent_data_files(
+	     parent_vmdk_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent extent data files.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_set_parent_handle(
+	     vmdk_handle,
+	     parent_vmdk_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set parent handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_append_entry(
+	     export_handle->parent_handles_array,
+	     &entry_index,
+	     (intptr_t *) parent_vmdk_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append parent handle to array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( parent_vmdk_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &parent_vmdk_handle,
+		 NULL );
+	}
+	if( ( parent_path != NULL )
+	 && ( export_handle->basename != NULL ) )
+	{
+		memory_free(
+		 parent_path );
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Opens the reader handles, additional handles of the input that share its parent handle
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_open_readers(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libvmdk_handle_t *parent_vmdk_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *reader_handle = NULL;
+	static char *function           = "export_handle_open_readers";
+	int entry_index                 = 0;
+	int reader_index                = 0;
+	int result                      = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	for( reader_index = 0;
+	     reader_index < export_handle->number_of_threads;
+	     reader_index++ )
+	{
+		if( libvmdk_handle_initialize(
+		     &reader_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize reader handle: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libvmdk_handle_open_wide(
+		          reader_handle,
+		          filename,
+		          LIBVMDK_OPEN_READ,
+		          error );
+#else
+		result = libvmdk_handle_open(
+		          reader_handle,
+		          filename,
+		          LIBVMDK_OPEN_READ,
+		          error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open reader handle: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		if( parent_vmdk_handle != NULL )
+		{
+			if( libvmdk_handle_set_parent_handle(
+			     reader_handle,
+			     parent_vmdk_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set parent handle of reader handle: %d.",
+				 function,
+				 reader_index );
+
+				goto on_error;
+			}
+		}
+		if( libvmdk_handle_open_extent_data_files(
+		     reader_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open extent data files of reader handle: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     export_handle->reader_handles_array,
+		     &entry_index,
+		     (intptr_t *) reader_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append reader handle: %d to array.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		reader_handle = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( reader_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &reader_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Opens the output of the export handle
+ * The filename "-" represents stdout
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_open_output(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "export_handle_open_output";
+	size_t filename_length = 0;
+	int result             = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( export_handle->target_file_io_handle != NULL )
+	 || ( export_handle->use_stdout != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - output already opened.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	if( ( filename_length == 1 )
+	 && ( filename[ 0 ] == (system_character_t) '-' ) )
+	{
+		export_handle->use_stdout = 1;
+
+		return( 1 );
+	}
+	if( libbfio_file_initialize(
+	     &( export_handle->target_file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize target file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_set_name_wide(
+	          export_handle->target_file_io_handle,
+	          filename,
+	          filename_length,
+	          error );
+#else
+	result = libbfio_file_set_name(
+	          export_handle->target_file_io_handle,
+	          filename,
+	          filename_length,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set target filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     export_handle->target_file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open target file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( export_handle->target_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &( export_handle->target_file_io_handle ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes the export handle
+ * Returns the 0 if successful or -1 on error
+ */
+int export_handle_close(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *parent_vmdk_handle = NULL;
+	libvmdk_handle_t *reader_handle      = NULL;
+	static char *function                = "export_handle_close";
+	int entry_index                      = 0;
+	int number_of_entries                = 0;
+	int result                           = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->target_file_io_handle != NULL )
+	{
+		if( libbfio_handle_close(
+		     export_handle->target_file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close target file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( export_handle->target_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free target file IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	export_handle->use_stdout = 0;
+
+	if( libvmdk_handle_close(
+	     export_handle->input_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input handle.",
+		 function );
+
+		result = -1;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     export_handle->reader_handles_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of reader handles.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     export_handle->reader_handles_array,
+		     entry_index,
+		     (intptr_t **) &reader_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reader handle: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+
+			continue;
+		}
+		if( libvmdk_handle_close(
+		     reader_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close reader handle: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+		}
+	}
+	if( libcdata_array_get_number_of_entries(
+	     export_handle->parent_handles_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of parent handles.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     export_handle->parent_handles_array,
+		     entry_index,
+		     (intptr_t **) &parent_vmdk_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent handle: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+
+			continue;
+		}
+		if( libvmdk_handle_close(
+		     parent_vmdk_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close parent handle: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Exports the ranges of the input in the current thread
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int export_handle_export_ranges(
+     export_handle_t *export_handle,
+     process_status_t *process_status,
+     uint8_t copy_flags,
+     off64_t *export_offset,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer       = NULL;
+	static char *function = "export_handle_export_ranges";
+	size64_t export_size  = 0;
+	size_t buffer_size    = 0;
+	ssize_t read_count    = 0;
+	int result            = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export offset.",
+		 function );
+
+		return( -1 );
+	}
+	buffer_size = export_handle->process_buffer_size;
+
+	if( export_handle->input_media_size < (size64_t) buffer_size )
+	{
+		buffer_size = (size_t) export_handle->input_media_size;
+	}
+	if( ( export_handle->use_stdout != 0 )
+	 && ( buffer_size > 0 ) )
+	{
+		buffer = (uint8_t *) memory_allocate(
+		                      sizeof( uint8_t ) * buffer_size );
+
+		if( buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( (size64_t) *export_offset < export_handle->input_media_size )
+	{
+		if( export_handle->abort != 0 )
+		{
+			result = 0;
+
+			break;
+		}
+		export_size = export_handle->input_media_size - (size64_t) *export_offset;
+
+		if( export_size > (size64_t) buffer_size )
+		{
+			export_size = (size64_t) buffer_size;
+		}
+		if( export_handle->use_stdout != 0 )
+		{
+			read_count = libvmdk_handle_read_buffer_at_offset(
+			              export_handle->input_handle,
+			              buffer,
+			              (size_t) export_size,
+			              *export_offset,
+			              error );
+
+			if( read_count != (ssize_t) export_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 *export_offset,
+				 *export_offset );
+
+				goto on_error;
+			}
+			if( file_stream_write(
+			     stdout,
+			     buffer,
+			     (size_t) export_size ) != (size_t) export_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write data to stdout.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else if( libvmdk_handle_copy_to_file_io_handle(
+		          export_handle->input_handle,
+		          *export_offset,
+		          export_size,
+		          export_handle->target_file_io_handle,
+		          *export_offset,
+		          copy_flags,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to export data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 *export_offset,
+			 *export_offset );
+
+			goto on_error;
+		}
+		*export_offset += (off64_t) export_size;
+
+		if( process_status_update(
+		     process_status,
+		     (size64_t) *export_offset,
+		     export_handle->input_media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( result );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Determines the next range to export
+ * A range is either not allocated according to the grain tables, in which case it is limited
+ * to the size of the block of zero bytes, or contains data limited to the maximum range size
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_get_next_range(
+     export_handle_t *export_handle,
+     off64_t range_offset,
+     size_t maximum_range_size,
+     size_t *range_size,
+     uint8_t *range_is_zero,
+     libcerror_error_t **error )
+{
+	static char *function   = "export_handle_get_next_range";
+	size64_t run_size       = 0;
+	off64_t physical_offset = 0;
+	uint32_t run_flags      = 0;
+	int extent_index        = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_offset < 0 )
+	 || ( (size64_t) range_offset >= export_handle->input_media_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_range_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum range size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_is_zero == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range is zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_extent_map_run_at_offset(
+	     export_handle->input_handle,
+	     range_offset,
+	     &run_size,
+	     &extent_index,
+	     &physical_offset,
+	     &run_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent map run at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 range_offset,
+		 range_offset );
+
+		return( -1 );
+	}
+	if( ( run_size == 0 )
+	 || ( run_size > ( export_handle->input_media_size - (size64_t) range_offset ) ) )
+	{
+		run_size = export_handle->input_media_size - (size64_t) range_offset;
+	}
+	if( ( run_flags & LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_ZERO ) != 0 )
+	{
+		maximum_range_size = EXPORT_HANDLE_ZERO_BLOCK_SIZE;
+		*range_is_zero     = 1;
+	}
+	else
+	{
+		*range_is_zero = 0;
+	}
+	if( run_size > (size64_t) maximum_range_size )
+	{
+		run_size = (size64_t) maximum_range_size;
+	}
+	*range_size = (size_t) run_size;
+
+	return( 1 );
+}
+
+/* Writes a range to the output
+ * A range that is not allocated is written from the block of zero bytes, unless the target
+ * is written sparse, in which case it is left as a hole of the target extended up front
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_write_range(
+     export_handle_t *export_handle,
+     const uint8_t *buffer,
+     size_t range_size,
+     off64_t range_offset,
+     uint8_t range_is_zero,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_write_range";
+	ssize_t write_count   = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_is_zero != 0 )
+	{
+		if( range_size > (size_t) EXPORT_HANDLE_ZERO_BLOCK_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid range size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( export_handle->write_sparse != 0 )
+		 && ( export_handle->target_file_io_handle != NULL ) )
+		{
+			return( 1 );
+		}
+		buffer = export_handle_zero_block;
+	}
+	else if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->use_stdout != 0 )
+	{
+		if( file_stream_write(
+		     stdout,
+		     buffer,
+		     range_size ) != range_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data to stdout.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		write_count = libbfio_handle_write_buffer_at_offset(
+		               export_handle->target_file_io_handle,
+		               buffer,
+		               range_size,
+		               range_offset,
+		               error );
+
+		if( write_count != (ssize_t) range_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data to target file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Runs a read task in a read thread
+ * The task reads its range using a reader handle that is not in use by another read thread
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_read_task_run(
+     export_handle_read_task_t *read_task,
+     export_handle_t *export_handle )
+{
+	libvmdk_handle_t *reader_handle = NULL;
+	static char *function           = "export_handle_read_task_run";
+	ssize_t read_count              = 0;
+	int result                      = 1;
+
+	if( read_task == NULL )
+	{
+		return( -1 );
+	}
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 &( read_task->error ),
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_queue_pop(
+	     export_handle->reader_handles_queue,
+	     (intptr_t **) &reader_handle,
+	     &( read_task->error ) ) != 1 )
+	{
+		libcerror_error_set(
+		 &( read_task->error ),
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pop reader handle from queue.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              reader_handle,
+		              read_task->buffer,
+		              read_task->range_size,
+		              read_task->range_offset,
+		              &( read_task->error ) );
+
+		if( read_count != (ssize_t) read_task->range_size )
+		{
+			libcerror_error_set(
+			 &( read_task->error ),
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_task->range_offset,
+			 read_task->range_offset );
+
+			result = -1;
+		}
+		if( libcthreads_queue_push(
+		     export_handle->reader_handles_queue,
+		     (intptr_t *) reader_handle,
+		     &( read_task->error ) ) != 1 )
+		{
+			libcerror_error_set(
+			 &( read_task->error ),
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push reader handle onto queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_grab(
+	     export_handle->read_tasks_mutex,
+	     &( read_task->error ) ) != 1 )
+	{
+		libcerror_error_set(
+		 &( read_task->error ),
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read tasks mutex.",
+		 function );
+
+		return( -1 );
+	}
+	read_task->result       = result;
+	read_task->is_completed = 1;
+
+	if( libcthreads_condition_broadcast(
+	     export_handle->read_tasks_condition,
+	     &( read_task->error ) ) != 1 )
+	{
+		libcerror_error_set(
+		 &( read_task->error ),
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast read tasks condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     export_handle->read_tasks_mutex,
+	     &( read_task->error ) ) != 1 )
+	{
+		libcerror_error_set(
+		 &( read_task->error ),
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read tasks mutex.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Frees the read tasks and the values shared with the read threads
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_free_read_tasks(
+     export_handle_t *export_handle,
+     export_handle_read_task_t **read_tasks,
+     int number_of_read_tasks,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_free_read_tasks";
+	int read_task_index   = 0;
+	int result            = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_tasks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read tasks.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_tasks != NULL )
+	{
+		for( read_task_index = 0;
+		     read_task_index < number_of_read_tasks;
+		     read_task_index++ )
+		{
+			if( ( *read_tasks )[ read_task_index ].error != NULL )
+			{
+				libcerror_error_free(
+				 &( ( *read_tasks )[ read_task_index ].error ) );
+			}
+			if( ( *read_tasks )[ read_task_index ].buffer != NULL )
+			{
+				memory_free(
+				 ( *read_tasks )[ read_task_index ].buffer );
+			}
+		}
+		memory_free(
+		 *read_tasks );
+
+		*read_tasks = NULL;
+	}
+	/* The reader handles in the queue are owned by the reader handles array
+	 */
+	if( export_handle->reader_handles_queue != NULL )
+	{
+		if( libcthreads_queue_free(
+		     &( export_handle->reader_handles_queue ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reader handles queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( export_handle->read_tasks_condition != NULL )
+	{
+		if( libcthreads_condition_free(
+		     &( export_handle->read_tasks_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read tasks condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( export_handle->read_tasks_mutex != NULL )
+	{
+		if( libcthreads_mutex_free(
+		     &( export_handle->read_tasks_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read tasks mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Schedules a read task for the next range of the input
+ * Ranges that are not allocated are completed without being pushed onto the read thread pool
+ * Returns 1 if a read task was scheduled, 0 if no data remains or -1 on error
+ */
+int export_handle_schedule_read_task(
+     export_handle_t *export_handle,
+     export_handle_read_task_t *read_task,
+     libcthreads_thread_pool_t *read_thread_pool,
+     off64_t *read_offset,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_schedule_read_task";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_task == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read task.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) *read_offset >= export_handle->input_media_size )
+	{
+		return( 0 );
+	}
+	if( export_handle_get_next_range(
+	     export_handle,
+	     *read_offset,
+	     buffer_size,
+	     &( read_task->range_size ),
+	     &( read_task->range_is_zero ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 *read_offset,
+		 *read_offset );
+
+		return( -1 );
+	}
+	read_task->range_offset = *read_offset;
+	read_task->result       = 1;
+
+	if( read_task->range_is_zero != 0 )
+	{
+		read_task->is_completed = 1;
+	}
+	else
+	{
+		read_task->is_completed = 0;
+
+		if( libcthreads_thread_pool_push(
+		     read_thread_pool,
+		     (intptr_t *) read_task,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push read task onto read thread pool.",
+			 function );
+
+			read_task->range_size = 0;
+
+			return( -1 );
+		}
+	}
+	*read_offset += (off64_t) read_task->range_size;
+
+	return( 1 );
+}
+
+/* Exports the ranges of the input while they are read and decompressed by the read threads
+ * The ranges are written in order, while the read threads read the ranges that follow
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int export_handle_export_ranges_multi_threaded(
+     export_handle_t *export_handle,
+     process_status_t *process_status,
+     off64_t *export_offset,
+     libcerror_error_t **error )
+{
+	libcthreads_thread_pool_t *read_thread_pool = NULL;
+	libvmdk_handle_t *reader_handle             = NULL;
+	export_handle_read_task_t *read_task        = NULL;
+	export_handle_read_task_t *read_tasks       = NULL;
+	static char *function                       = "export_handle_export_ranges_multi_threaded";
+	size_t buffer_size                          = 0;
+	off64_t read_offset                         = 0;
+	int number_of_reader_handles                = 0;
+	int number_of_read_tasks                    = 0;
+	int read_task_index                         = 0;
+	int reader_index                            = 0;
+	int result                                  = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->reader_handles_queue != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - reader handles queue value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     export_handle->reader_handles_array,
+	     &number_of_reader_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of reader handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_reader_handles <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of reader handles value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Use twice as many read tasks as read threads so that every read thread
+	 * has a range to read while the main thread is writing, the process buffer size is
+	 * divided over the read tasks to bound the memory usage
+	 */
+	number_of_read_tasks = number_of_reader_handles * 2;
+
+	buffer_size = export_handle->process_buffer_size / number_of_read_tasks;
+
+	if( buffer_size < 512 )
+	{
+		buffer_size = 512;
+	}
+	if( export_handle->input_media_size < (size64_t) buffer_size )
+	{
+		buffer_size = (size_t) export_handle->input_media_size;
+	}
+	read_tasks = (export_handle_read_task_t *) memory_allocate(
+	                                          sizeof( export_handle_read_task_t ) * number_of_read_tasks );
+
+	if( read_tasks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read tasks.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     read_tasks,
+	     0,
+	     sizeof( export_handle_read_task_t ) * number_of_read_tasks ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read tasks.",
+		 function );
+
+		memory_free(
+		 read_tasks );
+
+		return( -1 );
+	}
+	if( buffer_size > 0 )
+	{
+		for( read_task_index = 0;
+		     read_task_index < number_of_read_tasks;
+		     read_task_index++ )
+		{
+			read_tasks[ read_task_index ].buffer = (uint8_t *) memory_allocate(
+			                                                    sizeof( uint8_t ) * buffer_size );
+
+			if( read_tasks[ read_task_index ].buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create read task: %d buffer.",
+				 function,
+				 read_task_index );
+
+				goto on_error;
+			}
+		}
+	}
+	if( libcthreads_queue_initialize(
+	     &( export_handle->reader_handles_queue ),
+	     number_of_reader_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize reader handles queue.",
+		 function );
+
+		goto on_error;
+	}
+	for( reader_index = 0;
+	     reader_index < number_of_reader_handles;
+	     reader_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     export_handle->reader_handles_array,
+		     reader_index,
+		     (intptr_t **) &reader_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reader handle: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		if( libcthreads_queue_push(
+		     export_handle->reader_handles_queue,
+		     (intptr_t *) reader_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push reader handle: %d onto queue.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_initialize(
+	     &( export_handle->read_tasks_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read tasks mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( export_handle->read_tasks_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read tasks condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &read_thread_pool,
+	     NULL,
+	     number_of_reader_handles,
+	     number_of_read_tasks,
+	     (int (*)(intptr_t *, void *)) &export_handle_read_task_run,
+	     (void *) export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	read_offset = *export_offset;
+
+	for( read_task_index = 0;
+	     read_task_index < number_of_read_tasks;
+	     read_task_index++ )
+	{
+		if( export_handle_schedule_read_task(
+		     export_handle,
+		     &( read_tasks[ read_task_index ] ),
+		     read_thread_pool,
+		     &read_offset,
+		     buffer_size,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to schedule read task: %d.",
+			 function,
+			 read_task_index );
+
+			goto on_error;
+		}
+	}
+	read_task_index = 0;
+
+	while( (size64_t) *export_offset < export_handle->input_media_size )
+	{
+		if( export_handle->abort != 0 )
+		{
+			result = 0;
+
+			break;
+		}
+		read_task = &( read_tasks[ read_task_index ] );
+
+		if( libcthreads_mutex_grab(
+		     export_handle->read_tasks_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read tasks mutex.",
+			 function );
+
+			goto on_error;
+		}
+		while( read_task->is_completed == 0 )
+		{
+			if( libcthreads_condition_wait(
+			     export_handle->read_tasks_condition,
+			     export_handle->read_tasks_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for read tasks condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 export_handle->read_tasks_mutex,
+				 NULL );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_mutex_release(
+		     export_handle->read_tasks_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read tasks mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( read_task->result != 1 )
+		{
+			if( ( error != NULL )
+			 && ( *error == NULL ) )
+			{
+				*error = read_task->error;
+
+				read_task->error = NULL;
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_task->range_offset,
+			 read_task->range_offset );
+
+			goto on_error;
+		}
+		if( export_handle_write_range(
+		     export_handle,
+		     read_task->buffer,
+		     read_task->range_size,
+		     read_task->range_offset,
+		     read_task->range_is_zero,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_task->range_offset,
+			 read_task->range_offset );
+
+			goto on_error;
+		}
+		*export_offset += (off64_t) read_task->range_size;
+
+		if( process_status_update(
+		     process_status,
+		     (size64_t) *export_offset,
+		     export_handle->input_media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
+			 function );
+
+			goto on_error;
+		}
+		if( export_handle_schedule_read_task(
+		     export_handle,
+		     read_task,
+		     read_thread_pool,
+		     &read_offset,
+		     buffer_size,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to schedule read task: %d.",
+			 function,
+			 read_task_index );
+
+			goto on_error;
+		}
+		read_task_index = ( read_task_index + 1 ) % number_of_read_tasks;
+	}
+	/* Joining the read thread pool waits for the read tasks that are still scheduled
+	 */
+	if( libcthreads_thread_pool_join(
+	     &read_thread_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join read thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle_free_read_tasks(
+	     export_handle,
+	     &read_tasks,
+	     number_of_read_tasks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read tasks.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( read_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &read_thread_pool,
+		 NULL );
+	}
+	export_handle_free_read_tasks(
+	 export_handle,
+	 &read_tasks,
+	 number_of_read_tasks,
+	 NULL );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Exports the input
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int export_handle_export_input(
+     export_handle_t *export_handle,
+     uint8_t print_status_information,
+     libcerror_error_t **error )
+{
+	process_status_t *process_status = NULL;
+	static char *function            = "export_handle_export_input";
+	off64_t export_offset            = 0;
+	uint8_t copy_flags               = 0;
+	int result                       = 0;
+	int status                       = PROCESS_STATUS_COMPLETED;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int number_of_reader_handles     = 0;
+#endif
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( export_handle->target_file_io_handle == NULL )
+	 && ( export_handle->use_stdout == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing output.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcdata_array_get_number_of_entries(
+	     export_handle->reader_handles_array,
+	     &number_of_reader_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of reader handles.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( export_handle->write_sparse != 0 )
+	{
+		copy_flags = LIBVMDK_COPY_FLAG_SPARSE;
+
+		/* Extend the target to the media size up front so that ranges ending in a hole
+		 * do not need to be extended individually
+		 */
+		if( ( export_handle->target_file_io_handle != NULL )
+		 && ( export_handle->input_media_size > 0 ) )
+		{
+			if( libbfio_handle_write_buffer_at_offset(
+			     export_handle->target_file_io_handle,
+			     (uint8_t *) "",
+			     1,
+			     (off64_t) export_handle->input_media_size - 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to extend target file.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( process_status_initialize(
+	     &process_status,
+	     _SYSTEM_STRING( "Export" ),
+	     _SYSTEM_STRING( "exported" ),
+	     _SYSTEM_STRING( "Written" ),
+	     ( export_handle->use_stdout != 0 ) ? stderr : export_handle->notify_stream,
+	     print_status_information,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_start(
+	     process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start process status.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( number_of_reader_handles > 0 )
+	{
+		result = export_handle_export_ranges_multi_threaded(
+		          export_handle,
+		          process_status,
+		          &export_offset,
+		          error );
+	}
+	else
+#endif
+	{
+		result = export_handle_export_ranges(
+		          export_handle,
+		          process_status,
+		          copy_flags,
+		          &export_offset,
+		          error );
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to export ranges.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		status = PROCESS_STATUS_ABORTED;
+	}
+	if( process_status_stop(
+	     process_status,
+	     (size64_t) export_offset,
+	     status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to stop process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_free(
+	     &process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( status == PROCESS_STATUS_ABORTED )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	if( process_status != NULL )
+	{
+		process_status_stop(
+		 process_status,
+		 (size64_t) export_offset,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &process_status,
+		 NULL );
+	}
+	return( -1 );
+}
+
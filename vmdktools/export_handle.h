@@ -0,0 +1,278 @@
+/*
+ * Export handle
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EXPORT_HANDLE_H )
+#define _EXPORT_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "process_status.h"
+#include "vmdktools_libbfio.h"
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libcthreads.h"
+#include "vmdktools_libvmdk.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the (media) data exported per iteration
+ */
+#define EXPORT_HANDLE_PROCESS_BUFFER_SIZE	( 64 * 1024 * 1024 )
+
+/* The size of the block of zero bytes used to write ranges that are not allocated
+ */
+#define EXPORT_HANDLE_ZERO_BLOCK_SIZE		( 1024 * 1024 )
+
+/* The default number of threads used to read the input
+ */
+#define EXPORT_HANDLE_DEFAULT_NUMBER_OF_THREADS	4
+
+/* The maximum number of threads used to read the input
+ */
+#define EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS	32
+
+typedef struct export_handle export_handle_t;
+
+struct export_handle
+{
+	/* The basename
+	 */
+	system_character_t *basename;
+
+	/* The basename size
+	 */
+	size_t basename_size;
+
+	/* The libvmdk input handle
+	 */
+	libvmdk_handle_t *input_handle;
+
+	/* The libvmdk parent handles
+	 */
+	libcdata_array_t *parent_handles_array;
+
+	/* The libvmdk reader handles, additional handles of the input used by the read threads
+	 */
+	libcdata_array_t *reader_handles_array;
+
+	/* The input media size
+	 */
+	size64_t input_media_size;
+
+	/* The number of threads used to read the input, where 0 represents single-threaded
+	 */
+	int number_of_threads;
+
+	/* The size of the (media) data exported per iteration
+	 */
+	size_t process_buffer_size;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The queue of reader handles that are not in use by a read thread
+	 */
+	libcthreads_queue_t *reader_handles_queue;
+
+	/* The read tasks mutex
+	 */
+	libcthreads_mutex_t *read_tasks_mutex;
+
+	/* The read tasks condition, signalled when a read task has completed
+	 */
+	libcthreads_condition_t *read_tasks_condition;
+#endif
+
+	/* The target file IO handle
+	 */
+	libbfio_handle_t *target_file_io_handle;
+
+	/* Value to indicate the output should be written to stdout
+	 */
+	uint8_t use_stdout;
+
+	/* Value to indicate the output should be written as a sparse file
+	 */
+	uint8_t write_sparse;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct export_handle_read_task export_handle_read_task_t;
+
+struct export_handle_read_task
+{
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The (media) offset of the range
+	 */
+	off64_t range_offset;
+
+	/* The size of the range
+	 */
+	size_t range_size;
+
+	/* Value to indicate the range is not allocated
+	 */
+	uint8_t range_is_zero;
+
+	/* Value to indicate the task has completed
+	 */
+	uint8_t is_completed;
+
+	/* The result of the task
+	 */
+	int result;
+
+	/* The error of the task
+	 */
+	libcerror_error_t *error;
+};
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int export_handle_initialize(
+     export_handle_t **export_handle,
+     libcerror_error_t **error );
+
+int export_handle_free(
+     export_handle_t **export_handle,
+     libcerror_error_t **error );
+
+int export_handle_signal_abort(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_set_basename(
+     export_handle_t *export_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error );
+
+int export_handle_set_number_of_threads(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_open_input(
+     export_handle_t *export_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error );
+
+int export_handle_open_parent(
+     export_handle_t *export_handle,
+     libvmdk_handle_t *vmdk_handle,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int export_handle_open_readers(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libvmdk_handle_t *parent_vmdk_handle,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int export_handle_open_output(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int export_handle_close(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_export_ranges(
+     export_handle_t *export_handle,
+     process_status_t *process_status,
+     uint8_t copy_flags,
+     off64_t *export_offset,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int export_handle_get_next_range(
+     export_handle_t *export_handle,
+     off64_t range_offset,
+     size_t maximum_range_size,
+     size_t *range_size,
+     uint8_t *range_is_zero,
+     libcerror_error_t **error );
+
+int export_handle_write_range(
+     export_handle_t *export_handle,
+     const uint8_t *buffer,
+     size_t range_size,
+     off64_t range_offset,
+     uint8_t range_is_zero,
+     libcerror_error_t **error );
+
+int export_handle_read_task_run(
+     export_handle_read_task_t *read_task,
+     export_handle_t *export_handle );
+
+int export_handle_free_read_tasks(
+     export_handle_t *export_handle,
+     export_handle_read_task_t **read_tasks,
+     int number_of_read_tasks,
+     libcerror_error_t **error );
+
+int export_handle_schedule_read_task(
+     export_handle_t *export_handle,
+     export_handle_read_task_t *read_task,
+     libcthreads_thread_pool_t *read_thread_pool,
+     off64_t *read_offset,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int export_handle_export_ranges_multi_threaded(
+     export_handle_t *export_handle,
+     process_status_t *process_status,
+     off64_t *export_offset,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int export_handle_export_input(
+     export_handle_t *export_handle,
+     uint8_t print_status_information,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EXPORT_HANDLE_H ) */
+
@@ -0,0 +1,3310 @@
+/*
+ * Hash handle
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "hash_handle.h"
+#include "process_status.h"
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libcpath.h"
+#include "vmdktools_libcthreads.h"
+#include "vmdktools_libhmac.h"
+#include "vmdktools_libvmdk.h"
+
+#define HASH_HANDLE_NOTIFY_STREAM		stdout
+
+/* Block of zero bytes used to hash ranges that are not allocated without reading them
+ */
+static const uint8_t hash_handle_zero_block[ HASH_HANDLE_ZERO_BLOCK_SIZE ] = { 0 };
+
+/* Creates a hash handle
+ * Make sure the value hash_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_initialize(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_initialize";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*hash_handle = memory_allocate_structure(
+	                  hash_handle_t );
+
+	if( *hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *hash_handle,
+	     0,
+	     sizeof( hash_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash handle.",
+		 function );
+
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+
+		return( -1 );
+	}
+	if( libvmdk_handle_initialize(
+	     &( ( *hash_handle )->input_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *hash_handle )->parent_handles_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize parent handles array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *hash_handle )->reader_handles_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize reader handles array.",
+		 function );
+
+		goto on_error;
+	}
+	( *hash_handle )->calculate_md5       = 1;
+	( *hash_handle )->process_buffer_size = HASH_HANDLE_PROCESS_BUFFER_SIZE;
+	( *hash_handle )->notify_stream       = HASH_HANDLE_NOTIFY_STREAM;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	( *hash_handle )->number_of_threads = HASH_HANDLE_DEFAULT_NUMBER_OF_THREADS;
+#endif
+	return( 1 );
+
+on_error:
+	if( *hash_handle != NULL )
+	{
+		if( ( *hash_handle )->parent_handles_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *hash_handle )->parent_handles_array ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *hash_handle )->input_handle != NULL )
+		{
+			libvmdk_handle_free(
+			 &( ( *hash_handle )->input_handle ),
+			 NULL );
+		}
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a hash handle
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_free(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_free";
+	int result            = 1;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_handle != NULL )
+	{
+		if( ( *hash_handle )->basename != NULL )
+		{
+			memory_free(
+			 ( *hash_handle )->basename );
+		}
+		if( ( *hash_handle )->md5_context != NULL )
+		{
+			if( libhmac_md5_free(
+			     &( ( *hash_handle )->md5_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free MD5 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *hash_handle )->sha1_context != NULL )
+		{
+			if( libhmac_sha1_free(
+			     &( ( *hash_handle )->sha1_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA1 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *hash_handle )->sha256_context != NULL )
+		{
+			if( libhmac_sha256_free(
+			     &( ( *hash_handle )->sha256_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA256 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		/* The input and reader handles reference the parent handles and must be freed first
+		 */
+		if( ( *hash_handle )->input_handle != NULL )
+		{
+			if( libvmdk_handle_free(
+			     &( ( *hash_handle )->input_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *hash_handle )->reader_handles_array != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *hash_handle )->reader_handles_array ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free reader handles array.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *hash_handle )->parent_handles_array != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *hash_handle )->parent_handles_array ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free parent handles array.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the hash handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_signal_abort(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *reader_handle = NULL;
+	static char *function           = "hash_handle_signal_abort";
+	int number_of_reader_handles    = 0;
+	int reader_index                = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->abort = 1;
+
+	if( hash_handle->input_handle != NULL )
+	{
+		if( libvmdk_handle_signal_abort(
+		     hash_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( hash_handle->reader_handles_array != NULL )
+	{
+		if( libcdata_array_get_number_of_entries(
+		     hash_handle->reader_handles_array,
+		     &number_of_reader_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of reader handles.",
+			 function );
+
+			return( -1 );
+		}
+		for( reader_index = 0;
+		     reader_index < number_of_reader_handles;
+		     reader_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     hash_handle->reader_handles_array,
+			     reader_index,
+			     (intptr_t **) &reader_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve reader handle: %d.",
+				 function,
+				 reader_index );
+
+				return( -1 );
+			}
+			if( libvmdk_handle_signal_abort(
+			     reader_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal reader handle: %d to abort.",
+				 function,
+				 reader_index );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the basename
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_basename(
+     hash_handle_t *hash_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_basename";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->basename != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle - basename value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( basename_size == 0 )
+	 || ( basename_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid basename size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->basename = system_string_allocate(
+	                           basename_size );
+
+	if( hash_handle->basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create basename string.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     hash_handle->basename,
+	     basename,
+	     basename_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy basename.",
+		 function );
+
+		goto on_error;
+	}
+	hash_handle->basename[ basename_size - 1 ] = 0;
+
+	hash_handle->basename_size = basename_size;
+
+	return( 1 );
+
+on_error:
+	if( hash_handle->basename != NULL )
+	{
+		memory_free(
+		 hash_handle->basename );
+
+		hash_handle->basename = NULL;
+	}
+	hash_handle->basename_size = 0;
+
+	return( -1 );
+}
+
+/* Sets the additional digest types
+ * The string contains a comma separated list of digest types: sha1 and/or sha256
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_additional_digest_types(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_additional_digest_types";
+	size_t segment_length = 0;
+	size_t segment_start  = 0;
+	size_t string_index   = 0;
+	size_t string_length  = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	for( string_index = 0;
+	     string_index <= string_length;
+	     string_index++ )
+	{
+		if( ( string_index < string_length )
+		 && ( string[ string_index ] != (system_character_t) ',' ) )
+		{
+			continue;
+		}
+		segment_length = string_index - segment_start;
+
+		if( segment_length == 3 )
+		{
+			if( system_string_compare(
+			     &( string[ segment_start ] ),
+			     _SYSTEM_STRING( "md5" ),
+			     3 ) == 0 )
+			{
+				hash_handle->calculate_md5 = 1;
+
+				segment_length = 0;
+			}
+		}
+		else if( segment_length == 4 )
+		{
+			if( system_string_compare(
+			     &( string[ segment_start ] ),
+			     _SYSTEM_STRING( "sha1" ),
+			     4 ) == 0 )
+			{
+				hash_handle->calculate_sha1 = 1;
+
+				segment_length = 0;
+			}
+		}
+		else if( segment_length == 5 )
+		{
+			if( system_string_compare(
+			     &( string[ segment_start ] ),
+			     _SYSTEM_STRING( "sha-1" ),
+			     5 ) == 0 )
+			{
+				hash_handle->calculate_sha1 = 1;
+
+				segment_length = 0;
+			}
+		}
+		else if( segment_length == 6 )
+		{
+			if( system_string_compare(
+			     &( string[ segment_start ] ),
+			     _SYSTEM_STRING( "sha256" ),
+			     6 ) == 0 )
+			{
+				hash_handle->calculate_sha256 = 1;
+
+				segment_length = 0;
+			}
+		}
+		else if( segment_length == 7 )
+		{
+			if( system_string_compare(
+			     &( string[ segment_start ] ),
+			     _SYSTEM_STRING( "sha-256" ),
+			     7 ) == 0 )
+			{
+				hash_handle->calculate_sha256 = 1;
+
+				segment_length = 0;
+			}
+		}
+		if( segment_length != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported digest type in string: %" PRIs_SYSTEM ".",
+			 function,
+			 string );
+
+			return( -1 );
+		}
+		segment_start = string_index + 1;
+	}
+	return( 1 );
+}
+
+/* Sets the number of threads used to read the input
+ * A number of 0 represents single-threaded mode
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_number_of_threads(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_number_of_threads";
+	size_t string_index   = 0;
+	int number_of_threads = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	for( string_index = 0;
+	     string[ string_index ] != 0;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] < (system_character_t) '0' )
+		 || ( string[ string_index ] > (system_character_t) '9' ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character in number of threads string.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_threads *= 10;
+		number_of_threads += (int) ( string[ string_index ] - (system_character_t) '0' );
+
+		if( number_of_threads > HASH_HANDLE_MAXIMUM_NUMBER_OF_THREADS )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of threads value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( string_index == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads string value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading is not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	hash_handle->number_of_threads = number_of_threads;
+
+	return( 1 );
+}
+
+/* Opens the input of the hash handle
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_open_input(
+     hash_handle_t *hash_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error )
+{
+	system_character_t *basename_end     = NULL;
+	static char *function                = "hash_handle_open_input";
+	size_t basename_length               = 0;
+	size_t filename_length               = 0;
+	uint32_t parent_content_identifier   = 0;
+	int result                           = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libvmdk_handle_t *parent_vmdk_handle = NULL;
+	int number_of_parent_handles         = 0;
+#endif
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_filenames != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of filenames.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filenames[ 0 ] );
+
+	basename_end = system_string_search_character_reverse(
+	                filenames[ 0 ],
+	                (system_character_t) LIBCPATH_SEPARATOR,
+	                filename_length + 1 );
+
+	if( basename_end != NULL )
+	{
+		basename_length = (size_t) ( basename_end - filenames[ 0 ] ) + 1;
+	}
+	if( basename_length > 0 )
+	{
+		if( hash_handle_set_basename(
+		     hash_handle,
+		     filenames[ 0 ],
+		     basename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set basename.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_open_wide(
+	          hash_handle->input_handle,
+	          filenames[ 0 ],
+	          LIBVMDK_OPEN_READ,
+	          error );
+#else
+	result = libvmdk_handle_open(
+	          hash_handle->input_handle,
+	          filenames[ 0 ],
+	          LIBVMDK_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvmdk_handle_get_parent_content_identifier(
+	          hash_handle->input_handle,
+	          &parent_content_identifier,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent content identifier.",
+		 function );
+
+		return( -1 );
+	}
+	else if( ( result != 0 )
+	      && ( parent_content_identifier != 0xffffffffUL ) )
+	{
+		if( hash_handle_open_parent(
+		     hash_handle,
+		     hash_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open parent handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libvmdk_handle_open_extent_data_files(
+	     hash_handle->input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_media_size(
+	     hash_handle->input_handle,
+	     &( hash_handle->input_media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( hash_handle->number_of_threads > 0 )
+	{
+		if( libcdata_array_get_number_of_entries(
+		     hash_handle->parent_handles_array,
+		     &number_of_parent_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of parent handles.",
+			 function );
+
+			return( -1 );
+		}
+		/* The parent of the input handle is the last entry appended to the array
+		 */
+		if( number_of_parent_handles > 0 )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     hash_handle->parent_handles_array,
+			     number_of_parent_handles - 1,
+			     (intptr_t **) &parent_vmdk_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve parent handle.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( hash_handle_open_readers(
+		     hash_handle,
+		     filenames[ 0 ],
+		     parent_vmdk_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open reader handles.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( 1 );
+}
+
+/* Opens the parent handle of a specific handle, including its own parents
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_open_parent(
+     hash_handle_t *hash_handle,
+     libvmdk_handle_t *vmdk_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *parent_vmdk_handle = NULL;
+	system_character_t *parent_filename  = NULL;
+	system_character_t *parent_path      = NULL;
+	static char *function                = "hash_handle_open_parent";
+	size_t parent_filename_size          = 0;
+	size_t parent_path_size              = 0;
+	uint32_t parent_content_identifier   = 0;
+	int entry_index                      = 0;
+	int result                           = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename_size(
+	          vmdk_handle,
+	          &parent_filename_size,
+	          error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename_size(
+	          vmdk_handle,
+	          &parent_filename_size,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( parent_filename_size == 0 )
+	 || ( parent_filename_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid parent filename size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	parent_filename = system_string_allocate(
+	                   parent_filename_size );
+
+	if( parent_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parent filename string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename(
+	          vmdk_handle,
+	          (uint16_t *) parent_filename,
+	          parent_filename_size,
+	          error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename(
+	          vmdk_handle,
+	          (uint8_t *) parent_filename,
+	          parent_filename_size,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( hash_handle->basename == NULL )
+	{
+		parent_path      = parent_filename;
+		parent_path_size = parent_filename_size;
+	}
+	else
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libcpath_path_join_wide(
+		          &parent_path,
+		          &parent_path_size,
+		          hash_handle->basename,
+		          hash_handle->basename_size - 1,
+		          parent_filename,
+		          parent_filename_size - 1,
+		          error );
+#else
+		result = libcpath_path_join(
+		          &parent_path,
+		          &parent_path_size,
+		          hash_handle->basename,
+		          hash_handle->basename_size - 1,
+		          parent_filename,
+		          parent_filename_size - 1,
+		          error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create parent path.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_handle_initialize(
+	     &parent_vmdk_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize parent handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_open_wide(
+	          parent_vmdk_handle,
+	          parent_path,
+	          LIBVMDK_OPEN_READ,
+	          error );
+#else
+	result = libvmdk_handle_open(
+	          parent_vmdk_handle,
+	          parent_path,
+	          LIBVMDK_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent handle: %" PRIs_SYSTEM ".",
+		 function,
+		 parent_path );
+
+		goto on_error;
+	}
+	if( hash_handle->basename != NULL )
+	{
+		memory_free(
+		 parent_path );
+	}
+	parent_path = NULL;
+
+	memory_free(
+	 parent_filename );
+
+	parent_filename = NULL;
+
+	result = libvmdk_handle_get_parent_content_identifier(
+	          parent_vmdk_handle,
+	          &parent_content_identifier,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent content identifier.",
+		 function );
+
+		goto on_error;
+	}
+	else if( ( result != 0 )
+	      && ( parent_content_identifier != 0xffffffffUL ) )
+	{
+		if( hash_handle_open_parent(
+		     hash_handle,
+		     parent_vmdk_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open parent handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_handle_open_extent_data_files(
+	     parent_vmdk_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent extent data files.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_set_parent_handle(
+	     vmdk_handle,
+	     parent_vmdk_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set parent handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_append_entry(
+	     hash_handle->parent_handles_array,
+	     &entry_index,
+	     (intptr_t *) parent_vmdk_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append parent handle to array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( parent_vmdk_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &parent_vmdk_handle,
+		 NULL );
+	}
+	if( ( parent_path != NULL )
+	 && ( hash_handle->basename != NULL ) )
+	{
+		memory_free(
+		 parent_path );
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Opens the reader handles, additional handles of the input that share its parent handle
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_open_readers(
+     hash_handle_t *hash_handle,
+     const system_character_t *filename,
+     libvmdk_handle_t *parent_vmdk_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *reader_handle = NULL;
+	static char *function           = "hash_handle_open_readers";
+	int entry_index                 = 0;
+	int reader_index                = 0;
+	int result                      = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	for( reader_index = 0;
+	     reader_index < hash_handle->number_of_threads;
+	     reader_index++ )
+	{
+		if( libvmdk_handle_initialize(
+		     &reader_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize reader handle: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libvmdk_handle_open_wide(
+		          reader_handle,
+		          filename,
+		          LIBVMDK_OPEN_READ,
+		          error );
+#else
+		result = libvmdk_handle_open(
+		          reader_handle,
+		          filename,
+		          LIBVMDK_OPEN_READ,
+		          error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open reader handle: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		if( parent_vmdk_handle != NULL )
+		{
+			if( libvmdk_handle_set_parent_handle(
+			     reader_handle,
+			     parent_vmdk_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set parent handle of reader handle: %d.",
+				 function,
+				 reader_index );
+
+				goto on_error;
+			}
+		}
+		if( libvmdk_handle_open_extent_data_files(
+		     reader_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open extent data files of reader handle: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     hash_handle->reader_handles_array,
+		     &entry_index,
+		     (intptr_t *) reader_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append reader handle: %d to array.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		reader_handle = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( reader_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &reader_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Closes the hash handle
+ * Returns the 0 if successful or -1 on error
+ */
+int hash_handle_close(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *parent_vmdk_handle = NULL;
+	libvmdk_handle_t *reader_handle      = NULL;
+	static char *function                = "hash_handle_close";
+	int entry_index                      = 0;
+	int number_of_entries                = 0;
+	int result                           = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_close(
+	     hash_handle->input_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input handle.",
+		 function );
+
+		result = -1;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     hash_handle->reader_handles_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of reader handles.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     hash_handle->reader_handles_array,
+		     entry_index,
+		     (intptr_t **) &reader_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reader handle: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+
+			continue;
+		}
+		if( libvmdk_handle_close(
+		     reader_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close reader handle: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+		}
+	}
+	if( libcdata_array_get_number_of_entries(
+	     hash_handle->parent_handles_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of parent handles.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     hash_handle->parent_handles_array,
+		     entry_index,
+		     (intptr_t **) &parent_vmdk_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent handle: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+
+			continue;
+		}
+		if( libvmdk_handle_close(
+		     parent_vmdk_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close parent handle: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Initializes the integrity hash(es)
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_initialize_integrity_hash(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_initialize_integrity_hash";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->calculate_md5 != 0 )
+	{
+		if( libhmac_md5_initialize(
+		     &( hash_handle->md5_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize MD5 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( hash_handle->calculate_sha1 != 0 )
+	{
+		if( libhmac_sha1_initialize(
+		     &( hash_handle->sha1_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA1 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( hash_handle->calculate_sha256 != 0 )
+	{
+		if( libhmac_sha256_initialize(
+		     &( hash_handle->sha256_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( hash_handle->md5_context != NULL )
+	{
+		libhmac_md5_free(
+		 &( hash_handle->md5_context ),
+		 NULL );
+	}
+	if( hash_handle->sha1_context != NULL )
+	{
+		libhmac_sha1_free(
+		 &( hash_handle->sha1_context ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Updates the integrity hash(es)
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_update_integrity_hash(
+     hash_handle_t *hash_handle,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_update_integrity_hash";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->md5_context != NULL )
+	{
+		if( libhmac_md5_update(
+		     hash_handle->md5_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update MD5 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( hash_handle->sha1_context != NULL )
+	{
+		if( libhmac_sha1_update(
+		     hash_handle->sha1_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA1 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( hash_handle->sha256_context != NULL )
+	{
+		if( libhmac_sha256_update(
+		     hash_handle->sha256_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Converts the digest hash to a printable string
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_copy_digest_hash_to_string(
+     const uint8_t *digest_hash,
+     size_t digest_hash_size,
+     system_character_t *string,
+     size_t string_size,
+     libcerror_error_t **error )
+{
+	static char *function       = "hash_handle_copy_digest_hash_to_string";
+	size_t digest_hash_iterator = 0;
+	size_t string_iterator      = 0;
+	uint8_t digest_digit        = 0;
+
+	if( digest_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_hash_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid digest hash size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* The string requires space for 2 characters per digest hash digit and a end of string
+	 */
+	if( string_size < ( ( 2 * digest_hash_size ) + 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: string too small.",
+		 function );
+
+		return( -1 );
+	}
+	for( digest_hash_iterator = 0;
+	     digest_hash_iterator < digest_hash_size;
+	     digest_hash_iterator++ )
+	{
+		digest_digit = digest_hash[ digest_hash_iterator ] >> 4;
+
+		if( digest_digit <= 9 )
+		{
+			string[ string_iterator++ ] = (system_character_t) ( (uint8_t) '0' + digest_digit );
+		}
+		else
+		{
+			string[ string_iterator++ ] = (system_character_t) ( (uint8_t) 'a' + ( digest_digit - 10 ) );
+		}
+		digest_digit = digest_hash[ digest_hash_iterator ] & 0x0f;
+
+		if( digest_digit <= 9 )
+		{
+			string[ string_iterator++ ] = (system_character_t) ( (uint8_t) '0' + digest_digit );
+		}
+		else
+		{
+			string[ string_iterator++ ] = (system_character_t) ( (uint8_t) 'a' + ( digest_digit - 10 ) );
+		}
+	}
+	string[ string_iterator ] = 0;
+
+	return( 1 );
+}
+
+/* Finalizes the integrity hash(es)
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_finalize_integrity_hash(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	uint8_t calculated_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+
+	static char *function = "hash_handle_finalize_integrity_hash";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->md5_context != NULL )
+	{
+		if( libhmac_md5_finalize(
+		     hash_handle->md5_context,
+		     calculated_hash,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to finalize MD5 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( hash_handle_copy_digest_hash_to_string(
+		     calculated_hash,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     hash_handle->calculated_md5_hash_string,
+		     ( 2 * LIBHMAC_MD5_HASH_SIZE ) + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to create calculated MD5 hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( libhmac_md5_free(
+		     &( hash_handle->md5_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free MD5 context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( hash_handle->sha1_context != NULL )
+	{
+		if( libhmac_sha1_finalize(
+		     hash_handle->sha1_context,
+		     calculated_hash,
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to finalize SHA1 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( hash_handle_copy_digest_hash_to_string(
+		     calculated_hash,
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     hash_handle->calculated_sha1_hash_string,
+		     ( 2 * LIBHMAC_SHA1_HASH_SIZE ) + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to create calculated SHA1 hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( libhmac_sha1_free(
+		     &( hash_handle->sha1_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA1 context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( hash_handle->sha256_context != NULL )
+	{
+		if( libhmac_sha256_finalize(
+		     hash_handle->sha256_context,
+		     calculated_hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to finalize SHA256 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( hash_handle_copy_digest_hash_to_string(
+		     calculated_hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     hash_handle->calculated_sha256_hash_string,
+		     ( 2 * LIBHMAC_SHA256_HASH_SIZE ) + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to create calculated SHA256 hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( libhmac_sha256_free(
+		     &( hash_handle->sha256_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA256 context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Determines the next range to hash
+ * A range is either not allocated according to the grain tables, in which case it is limited
+ * to the size of the block of zero bytes, or contains data limited to the maximum range size
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_get_next_range(
+     hash_handle_t *hash_handle,
+     off64_t range_offset,
+     size_t maximum_range_size,
+     size_t *range_size,
+     uint8_t *range_is_zero,
+     libcerror_error_t **error )
+{
+	static char *function   = "hash_handle_get_next_range";
+	size64_t run_size       = 0;
+	off64_t physical_offset = 0;
+	uint32_t run_flags      = 0;
+	int extent_index        = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_offset < 0 )
+	 || ( (size64_t) range_offset >= hash_handle->input_media_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_range_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum range size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_is_zero == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range is zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_extent_map_run_at_offset(
+	     hash_handle->input_handle,
+	     range_offset,
+	     &run_size,
+	     &extent_index,
+	     &physical_offset,
+	     &run_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent map run at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 range_offset,
+		 range_offset );
+
+		return( -1 );
+	}
+	if( ( run_size == 0 )
+	 || ( run_size > ( hash_handle->input_media_size - (size64_t) range_offset ) ) )
+	{
+		run_size = hash_handle->input_media_size - (size64_t) range_offset;
+	}
+	if( ( run_flags & LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_ZERO ) != 0 )
+	{
+		maximum_range_size = HASH_HANDLE_ZERO_BLOCK_SIZE;
+		*range_is_zero     = 1;
+	}
+	else
+	{
+		*range_is_zero = 0;
+	}
+	if( run_size > (size64_t) maximum_range_size )
+	{
+		run_size = (size64_t) maximum_range_size;
+	}
+	*range_size = (size_t) run_size;
+
+	return( 1 );
+}
+
+/* Hashes the ranges of the input in the current thread
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int hash_handle_hash_ranges(
+     hash_handle_t *hash_handle,
+     process_status_t *process_status,
+     off64_t *hash_offset,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer       = NULL;
+	static char *function = "hash_handle_hash_ranges";
+	size_t buffer_size    = 0;
+	size_t range_size     = 0;
+	ssize_t read_count    = 0;
+	uint8_t range_is_zero = 0;
+	int result            = 1;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash offset.",
+		 function );
+
+		return( -1 );
+	}
+	buffer_size = hash_handle->process_buffer_size;
+
+	if( hash_handle->input_media_size < (size64_t) buffer_size )
+	{
+		buffer_size = (size_t) hash_handle->input_media_size;
+	}
+	if( buffer_size > 0 )
+	{
+		buffer = (uint8_t *) memory_allocate(
+		                      sizeof( uint8_t ) * buffer_size );
+
+		if( buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( (size64_t) *hash_offset < hash_handle->input_media_size )
+	{
+		if( hash_handle->abort != 0 )
+		{
+			result = 0;
+
+			break;
+		}
+		if( hash_handle_get_next_range(
+		     hash_handle,
+		     *hash_offset,
+		     buffer_size,
+		     &range_size,
+		     &range_is_zero,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 *hash_offset,
+			 *hash_offset );
+
+			goto on_error;
+		}
+		if( range_is_zero == 0 )
+		{
+			read_count = libvmdk_handle_read_buffer_at_offset(
+			              hash_handle->input_handle,
+			              buffer,
+			              range_size,
+			              *hash_offset,
+			              error );
+
+			if( read_count != (ssize_t) range_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 *hash_offset,
+				 *hash_offset );
+
+				goto on_error;
+			}
+		}
+		if( hash_handle_update_integrity_hash(
+		     hash_handle,
+		     ( range_is_zero != 0 ) ? hash_handle_zero_block : buffer,
+		     range_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update integrity hash(es).",
+			 function );
+
+			goto on_error;
+		}
+		*hash_offset += (off64_t) range_size;
+
+		if( process_status_update(
+		     process_status,
+		     (size64_t) *hash_offset,
+		     hash_handle->input_media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( result );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Runs a read task in a read thread
+ * The task reads its range using a reader handle that is not in use by another read thread
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_read_task_run(
+     hash_handle_read_task_t *read_task,
+     hash_handle_t *hash_handle )
+{
+	libvmdk_handle_t *reader_handle = NULL;
+	static char *function           = "hash_handle_read_task_run";
+	ssize_t read_count              = 0;
+	int result                      = 1;
+
+	if( read_task == NULL )
+	{
+		return( -1 );
+	}
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 &( read_task->error ),
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_queue_pop(
+	     hash_handle->reader_handles_queue,
+	     (intptr_t **) &reader_handle,
+	     &( read_task->error ) ) != 1 )
+	{
+		libcerror_error_set(
+		 &( read_task->error ),
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pop reader handle from queue.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              reader_handle,
+		              read_task->buffer,
+		              read_task->range_size,
+		              read_task->range_offset,
+		              &( read_task->error ) );
+
+		if( read_count != (ssize_t) read_task->range_size )
+		{
+			libcerror_error_set(
+			 &( read_task->error ),
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_task->range_offset,
+			 read_task->range_offset );
+
+			result = -1;
+		}
+		if( libcthreads_queue_push(
+		     hash_handle->reader_handles_queue,
+		     (intptr_t *) reader_handle,
+		     &( read_task->error ) ) != 1 )
+		{
+			libcerror_error_set(
+			 &( read_task->error ),
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push reader handle onto queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_grab(
+	     hash_handle->read_tasks_mutex,
+	     &( read_task->error ) ) != 1 )
+	{
+		libcerror_error_set(
+		 &( read_task->error ),
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read tasks mutex.",
+		 function );
+
+		return( -1 );
+	}
+	read_task->result       = result;
+	read_task->is_completed = 1;
+
+	if( libcthreads_condition_broadcast(
+	     hash_handle->read_tasks_condition,
+	     &( read_task->error ) ) != 1 )
+	{
+		libcerror_error_set(
+		 &( read_task->error ),
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast read tasks condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     hash_handle->read_tasks_mutex,
+	     &( read_task->error ) ) != 1 )
+	{
+		libcerror_error_set(
+		 &( read_task->error ),
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read tasks mutex.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Frees the read tasks and the values shared with the read threads
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_free_read_tasks(
+     hash_handle_t *hash_handle,
+     hash_handle_read_task_t **read_tasks,
+     int number_of_read_tasks,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_free_read_tasks";
+	int read_task_index   = 0;
+	int result            = 1;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_tasks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read tasks.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_tasks != NULL )
+	{
+		for( read_task_index = 0;
+		     read_task_index < number_of_read_tasks;
+		     read_task_index++ )
+		{
+			if( ( *read_tasks )[ read_task_index ].error != NULL )
+			{
+				libcerror_error_free(
+				 &( ( *read_tasks )[ read_task_index ].error ) );
+			}
+			if( ( *read_tasks )[ read_task_index ].buffer != NULL )
+			{
+				memory_free(
+				 ( *read_tasks )[ read_task_index ].buffer );
+			}
+		}
+		memory_free(
+		 *read_tasks );
+
+		*read_tasks = NULL;
+	}
+	/* The reader handles in the queue are owned by the reader handles array
+	 */
+	if( hash_handle->reader_handles_queue != NULL )
+	{
+		if( libcthreads_queue_free(
+		     &( hash_handle->reader_handles_queue ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reader handles queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( hash_handle->read_tasks_condition != NULL )
+	{
+		if( libcthreads_condition_free(
+		     &( hash_handle->read_tasks_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read tasks condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( hash_handle->read_tasks_mutex != NULL )
+	{
+		if( libcthreads_mutex_free(
+		     &( hash_handle->read_tasks_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read tasks mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Schedules a read task for the next range of the input
+ * Ranges that are not allocated are completed without being pushed onto the read thread pool
+ * Returns 1 if a read task was scheduled, 0 if no data remains or -1 on error
+ */
+int hash_handle_schedule_read_task(
+     hash_handle_t *hash_handle,
+     hash_handle_read_task_t *read_task,
+     libcthreads_thread_pool_t *read_thread_pool,
+     off64_t *read_offset,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_schedule_read_task";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_task == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read task.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) *read_offset >= hash_handle->input_media_size )
+	{
+		return( 0 );
+	}
+	if( hash_handle_get_next_range(
+	     hash_handle,
+	     *read_offset,
+	     buffer_size,
+	     &( read_task->range_size ),
+	     &( read_task->range_is_zero ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 *read_offset,
+		 *read_offset );
+
+		return( -1 );
+	}
+	read_task->range_offset = *read_offset;
+	read_task->result       = 1;
+
+	if( read_task->range_is_zero != 0 )
+	{
+		read_task->is_completed = 1;
+	}
+	else
+	{
+		read_task->is_completed = 0;
+
+		if( libcthreads_thread_pool_push(
+		     read_thread_pool,
+		     (intptr_t *) read_task,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push read task onto read thread pool.",
+			 function );
+
+			read_task->range_size = 0;
+
+			return( -1 );
+		}
+	}
+	*read_offset += (off64_t) read_task->range_size;
+
+	return( 1 );
+}
+
+/* Hashes the ranges of the input while they are read and decompressed by the read threads
+ * The ranges are hashed in order, while the read threads read the ranges that follow
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int hash_handle_hash_ranges_multi_threaded(
+     hash_handle_t *hash_handle,
+     process_status_t *process_status,
+     off64_t *hash_offset,
+     libcerror_error_t **error )
+{
+	libcthreads_thread_pool_t *read_thread_pool = NULL;
+	libvmdk_handle_t *reader_handle             = NULL;
+	hash_handle_read_task_t *read_task          = NULL;
+	hash_handle_read_task_t *read_tasks         = NULL;
+	static char *function                       = "hash_handle_hash_ranges_multi_threaded";
+	size_t buffer_size                          = 0;
+	off64_t read_offset                         = 0;
+	int number_of_reader_handles                = 0;
+	int number_of_read_tasks                    = 0;
+	int read_task_index                         = 0;
+	int reader_index                            = 0;
+	int result                                  = 1;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->reader_handles_queue != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle - reader handles queue value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     hash_handle->reader_handles_array,
+	     &number_of_reader_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of reader handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_reader_handles <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of reader handles value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Use twice as many read tasks as read threads so that every read thread
+	 * has a range to read while the main thread is hashing, the process buffer size is
+	 * divided over the read tasks to bound the memory usage
+	 */
+	number_of_read_tasks = number_of_reader_handles * 2;
+
+	buffer_size = hash_handle->process_buffer_size / number_of_read_tasks;
+
+	if( buffer_size < 512 )
+	{
+		buffer_size = 512;
+	}
+	if( hash_handle->input_media_size < (size64_t) buffer_size )
+	{
+		buffer_size = (size_t) hash_handle->input_media_size;
+	}
+	read_tasks = (hash_handle_read_task_t *) memory_allocate(
+	                                          sizeof( hash_handle_read_task_t ) * number_of_read_tasks );
+
+	if( read_tasks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read tasks.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     read_tasks,
+	     0,
+	     sizeof( hash_handle_read_task_t ) * number_of_read_tasks ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read tasks.",
+		 function );
+
+		memory_free(
+		 read_tasks );
+
+		return( -1 );
+	}
+	if( buffer_size > 0 )
+	{
+		for( read_task_index = 0;
+		     read_task_index < number_of_read_tasks;
+		     read_task_index++ )
+		{
+			read_tasks[ read_task_index ].buffer = (uint8_t *) memory_allocate(
+			                                                    sizeof( uint8_t ) * buffer_size );
+
+			if( read_tasks[ read_task_index ].buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create read task: %d buffer.",
+				 function,
+				 read_task_index );
+
+				goto on_error;
+			}
+		}
+	}
+	if( libcthreads_queue_initialize(
+	     &( hash_handle->reader_handles_queue ),
+	     number_of_reader_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize reader handles queue.",
+		 function );
+
+		goto on_error;
+	}
+	for( reader_index = 0;
+	     reader_index < number_of_reader_handles;
+	     reader_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     hash_handle->reader_handles_array,
+		     reader_index,
+		     (intptr_t **) &reader_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reader handle: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		if( libcthreads_queue_push(
+		     hash_handle->reader_handles_queue,
+		     (intptr_t *) reader_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push reader handle: %d onto queue.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_initialize(
+	     &( hash_handle->read_tasks_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read tasks mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( hash_handle->read_tasks_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read tasks condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &read_thread_pool,
+	     NULL,
+	     number_of_reader_handles,
+	     number_of_read_tasks,
+	     (int (*)(intptr_t *, void *)) &hash_handle_read_task_run,
+	     (void *) hash_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	read_offset = *hash_offset;
+
+	for( read_task_index = 0;
+	     read_task_index < number_of_read_tasks;
+	     read_task_index++ )
+	{
+		if( hash_handle_schedule_read_task(
+		     hash_handle,
+		     &( read_tasks[ read_task_index ] ),
+		     read_thread_pool,
+		     &read_offset,
+		     buffer_size,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to schedule read task: %d.",
+			 function,
+			 read_task_index );
+
+			goto on_error;
+		}
+	}
+	read_task_index = 0;
+
+	while( (size64_t) *hash_offset < hash_handle->input_media_size )
+	{
+		if( hash_handle->abort != 0 )
+		{
+			result = 0;
+
+			break;
+		}
+		read_task = &( read_tasks[ read_task_index ] );
+
+		if( libcthreads_mutex_grab(
+		     hash_handle->read_tasks_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read tasks mutex.",
+			 function );
+
+			goto on_error;
+		}
+		while( read_task->is_completed == 0 )
+		{
+			if( libcthreads_condition_wait(
+			     hash_handle->read_tasks_condition,
+			     hash_handle->read_tasks_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for read tasks condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 hash_handle->read_tasks_mutex,
+				 NULL );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_mutex_release(
+		     hash_handle->read_tasks_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read tasks mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( read_task->result != 1 )
+		{
+			if( ( error != NULL )
+			 && ( *error == NULL ) )
+			{
+				*error = read_task->error;
+
+				read_task->error = NULL;
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_task->range_offset,
+			 read_task->range_offset );
+
+			goto on_error;
+		}
+		if( hash_handle_update_integrity_hash(
+		     hash_handle,
+		     ( read_task->range_is_zero != 0 ) ? hash_handle_zero_block : read_task->buffer,
+		     read_task->range_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update integrity hash(es).",
+			 function );
+
+			goto on_error;
+		}
+		*hash_offset += (off64_t) read_task->range_size;
+
+		if( process_status_update(
+		     process_status,
+		     (size64_t) *hash_offset,
+		     hash_handle->input_media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
+			 function );
+
+			goto on_error;
+		}
+		if( hash_handle_schedule_read_task(
+		     hash_handle,
+		     read_task,
+		     read_thread_pool,
+		     &read_offset,
+		     buffer_size,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to schedule read task: %d.",
+			 function,
+			 read_task_index );
+
+			goto on_error;
+		}
+		read_task_index = ( read_task_index + 1 ) % number_of_read_tasks;
+	}
+	/* Joining the read thread pool waits for the read tasks that are still scheduled
+	 */
+	if( libcthreads_thread_pool_join(
+	     &read_thread_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join read thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( hash_handle_free_read_tasks(
+	     hash_handle,
+	     &read_tasks,
+	     number_of_read_tasks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read tasks.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( read_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &read_thread_pool,
+		 NULL );
+	}
+	hash_handle_free_read_tasks(
+	 hash_handle,
+	 &read_tasks,
+	 number_of_read_tasks,
+	 NULL );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Hashes the input
+ * Ranges that are not allocated according to the grain tables are hashed from a block of
+ * zero bytes instead of being read
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int hash_handle_hash_input(
+     hash_handle_t *hash_handle,
+     uint8_t print_status_information,
+     libcerror_error_t **error )
+{
+	process_status_t *process_status = NULL;
+	static char *function            = "hash_handle_hash_input";
+	off64_t hash_offset              = 0;
+	int result                       = 0;
+	int status                       = PROCESS_STATUS_COMPLETED;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int number_of_reader_handles     = 0;
+#endif
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcdata_array_get_number_of_entries(
+	     hash_handle->reader_handles_array,
+	     &number_of_reader_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of reader handles.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( hash_handle_initialize_integrity_hash(
+	     hash_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize integrity hash(es).",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_initialize(
+	     &process_status,
+	     _SYSTEM_STRING( "Hash" ),
+	     _SYSTEM_STRING( "hashed" ),
+	     _SYSTEM_STRING( "Read" ),
+	     hash_handle->notify_stream,
+	     print_status_information,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_start(
+	     process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start process status.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( number_of_reader_handles > 0 )
+	{
+		result = hash_handle_hash_ranges_multi_threaded(
+		          hash_handle,
+		          process_status,
+		          &hash_offset,
+		          error );
+	}
+	else
+#endif
+	{
+		result = hash_handle_hash_ranges(
+		          hash_handle,
+		          process_status,
+		          &hash_offset,
+		          error );
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to hash ranges.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		status = PROCESS_STATUS_ABORTED;
+	}
+	if( process_status_stop(
+	     process_status,
+	     (size64_t) hash_offset,
+	     status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to stop process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_free(
+	     &process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( hash_handle_finalize_integrity_hash(
+	     hash_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to finalize integrity hash(es).",
+		 function );
+
+		goto on_error;
+	}
+	if( status == PROCESS_STATUS_ABORTED )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	if( process_status != NULL )
+	{
+		process_status_stop(
+		 process_status,
+		 (size64_t) hash_offset,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &process_status,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Prints the hash values to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_hash_values_fprint(
+     hash_handle_t *hash_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_hash_values_fprint";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->calculate_md5 != 0 )
+	{
+		fprintf(
+		 stream,
+		 "MD5 hash calculated over data:\t\t%" PRIs_SYSTEM "\n",
+		 hash_handle->calculated_md5_hash_string );
+	}
+	if( hash_handle->calculate_sha1 != 0 )
+	{
+		fprintf(
+		 stream,
+		 "SHA1 hash calculated over data:\t\t%" PRIs_SYSTEM "\n",
+		 hash_handle->calculated_sha1_hash_string );
+	}
+	if( hash_handle->calculate_sha256 != 0 )
+	{
+		fprintf(
+		 stream,
+		 "SHA256 hash calculated over data:\t%" PRIs_SYSTEM "\n",
+		 hash_handle->calculated_sha256_hash_string );
+	}
+	return( 1 );
+}
+
@@ -26,6 +26,7 @@
 
 #include "mount_dokan.h"
 #include "mount_file_entry.h"
+#include "mount_file_system.h"
 #include "mount_handle.h"
 #include "vmdktools_libcerror.h"
 #include "vmdktools_libcnotify.h"
@@ -808,6 +809,7 @@ NTSTATUS __stdcall mount_dokan_ReadFile(
 	libcerror_error_t *error = NULL;
 	static char *function    = "mount_dokan_ReadFile";
 	ssize_t read_count       = 0;
+	int64_t start_timestamp  = 0;
 	int result               = 0;
 
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -884,6 +886,22 @@ NTSTATUS __stdcall mount_dokan_ReadFile(
 
 		goto on_error;
 	}
+	if( mount_file_system_start_read(
+	     ( (mount_file_entry_t *) file_info->Context )->file_system,
+	     &start_timestamp,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start read in file system.",
+		 function );
+
+		result = MOUNT_DOKAN_ERROR_READ_FAULT;
+
+		goto on_error;
+	}
 	read_count = mount_file_entry_read_buffer_at_offset(
 	              (mount_file_entry_t *) file_info->Context,
 	              buffer,
@@ -901,7 +919,25 @@ NTSTATUS __stdcall mount_dokan_ReadFile(
 		 function );
 
 		result = MOUNT_DOKAN_ERROR_READ_FAULT;
+	}
+	if( mount_file_system_end_read(
+	     ( (mount_file_entry_t *) file_info->Context )->file_system,
+	     start_timestamp,
+	     read_count,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to end read in file system.",
+		 function );
 
+		result = MOUNT_DOKAN_ERROR_READ_FAULT;
+	}
+	if( result != 0 )
+	{
 		goto on_error;
 	}
 	if( read_count > (size_t) INT32_MAX )
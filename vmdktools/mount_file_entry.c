@@ -193,6 +193,62 @@ on_error:
 	return( -1 );
 }
 
+/* Creates a statistics file entry
+ * The statistics are retrieved from the file system when the file entry is created
+ * Make sure the value file_entry is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_entry_initialize_statistics(
+     mount_file_entry_t **file_entry,
+     mount_file_system_t *file_system,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_initialize_statistics";
+
+	if( mount_file_entry_initialize(
+	     file_entry,
+	     file_system,
+	     _SYSTEM_STRING( MOUNT_FILE_SYSTEM_STATISTICS_NAME ),
+	     MOUNT_FILE_SYSTEM_STATISTICS_NAME_LENGTH,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file entry.",
+		 function );
+
+		return( -1 );
+	}
+	( *file_entry )->is_statistics = 1;
+
+	if( mount_file_system_get_statistics(
+	     file_system,
+	     &( ( *file_entry )->statistics ),
+	     &( ( *file_entry )->statistics_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics from file system.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	mount_file_entry_free(
+	 file_entry,
+	 NULL );
+
+	return( -1 );
+}
+
 /* Frees a file entry
  * Returns 1 if successful or -1 on error
  */
@@ -220,6 +276,11 @@ int mount_file_entry_free(
 			memory_free(
 			 ( *file_entry )->name );
 		}
+		if( ( *file_entry )->statistics != NULL )
+		{
+			memory_free(
+			 ( *file_entry )->statistics );
+		}
 		memory_free(
 		 *file_entry );
 
@@ -271,7 +332,8 @@ int mount_file_entry_get_parent_file_entry(
 
 		return( -1 );
 	}
-	if( file_entry->vmdk_handle != NULL )
+	if( ( file_entry->vmdk_handle != NULL )
+	 || ( file_entry->is_statistics != 0 ) )
 	{
 		if( mount_file_entry_initialize(
 		     parent_file_entry,
@@ -487,7 +549,8 @@ int mount_file_entry_get_file_mode(
 
 		return( -1 );
 	}
-	if( file_entry->vmdk_handle == NULL )
+	if( ( file_entry->vmdk_handle == NULL )
+	 && ( file_entry->is_statistics == 0 ) )
 	{
 		*file_mode = S_IFDIR | 0555;
 	}
@@ -655,7 +718,8 @@ int mount_file_entry_get_number_of_sub_file_entries(
 
 		return( -1 );
 	}
-	if( file_entry->vmdk_handle == NULL )
+	if( ( file_entry->vmdk_handle == NULL )
+	 && ( file_entry->is_statistics == 0 ) )
 	{
 		if( mount_file_system_get_number_of_handles(
 		     file_entry->file_system,
@@ -683,8 +747,14 @@ int mount_file_entry_get_number_of_sub_file_entries(
 
 			return( -1 );
 		}
+		/* The statistics file follows the images
+		 */
+		*number_of_sub_file_entries = number_of_handles + 1;
+	}
+	else
+	{
+		*number_of_sub_file_entries = 0;
 	}
-	*number_of_sub_file_entries = number_of_handles;
 
 	return( 1 );
 }
@@ -764,6 +834,24 @@ int mount_file_entry_get_sub_file_entry_by_index(
 
 		return( -1 );
 	}
+	if( sub_file_entry_index == ( number_of_sub_file_entries - 1 ) )
+	{
+		if( mount_file_entry_initialize_statistics(
+		     sub_file_entry,
+		     file_entry->file_system,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize statistics sub file entry.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
 	if( mount_file_system_get_path_from_handle_index(
 	     file_entry->file_system,
 	     sub_file_entry_index,
@@ -843,8 +931,9 @@ ssize_t mount_file_entry_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error )
 {
-	static char *function = "mount_file_entry_read_buffer_at_offset";
-	ssize_t read_count    = 0;
+	libvmdk_handle_t *reader_handle = NULL;
+	static char *function           = "mount_file_entry_read_buffer_at_offset";
+	ssize_t read_count              = 0;
 
 	if( file_entry == NULL )
 	{
@@ -857,8 +946,87 @@ ssize_t mount_file_entry_read_buffer_at_offset(
 
 		return( -1 );
 	}
+	if( file_entry->is_statistics != 0 )
+	{
+		if( buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( buffer_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid buffer size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( (size64_t) offset >= (size64_t) file_entry->statistics_size )
+		{
+			return( 0 );
+		}
+		read_count = (ssize_t) ( file_entry->statistics_size - (size_t) offset );
+
+		if( (size_t) read_count > buffer_size )
+		{
+			read_count = (ssize_t) buffer_size;
+		}
+		if( memory_copy(
+		     buffer,
+		     &( file_entry->statistics[ offset ] ),
+		     (size_t) read_count ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy statistics.",
+			 function );
+
+			return( -1 );
+		}
+		return( read_count );
+	}
+	if( mount_file_system_get_reader_handle_by_offset(
+	     file_entry->file_system,
+	     file_entry->vmdk_handle,
+	     offset,
+	     &reader_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve reader handle for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
 	read_count = libvmdk_handle_read_buffer_at_offset(
-	              file_entry->vmdk_handle,
+	              reader_handle,
 	              buffer,
 	              buffer_size,
 	              offset,
@@ -914,7 +1082,7 @@ int mount_file_entry_get_size(
 
 			return( -1 );
 		}
-		*size = 0;
+		*size = (size64_t) file_entry->statistics_size;
 	}
 	else
 	{
@@ -936,3 +1104,297 @@ int mount_file_entry_get_size(
 	return( 1 );
 }
 
+/* Retrieves the allocated size
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_entry_get_allocated_size(
+     mount_file_entry_t *file_entry,
+     size64_t *allocated_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_get_allocated_size";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry->vmdk_handle == NULL )
+	{
+		if( allocated_size == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid allocated size.",
+			 function );
+
+			return( -1 );
+		}
+		*allocated_size = (size64_t) file_entry->statistics_size;
+	}
+	else
+	{
+		if( mount_file_system_get_allocated_size(
+		     file_entry->file_system,
+		     file_entry->vmdk_handle,
+		     allocated_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve allocated size from file system.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the offset of the next data or hole at or after a specific offset
+ * If find_hole is 0 the offset of the next data is retrieved, otherwise the offset of the next hole.
+ * The end of the data is considered a hole
+ * Returns 1 if successful, 0 if no such offset or -1 on error
+ */
+int mount_file_entry_get_next_data_or_hole_offset(
+     mount_file_entry_t *file_entry,
+     off64_t offset,
+     uint8_t find_hole,
+     off64_t *next_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_get_next_data_or_hole_offset";
+	size64_t run_size     = 0;
+	uint8_t is_hole       = 0;
+	int result            = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( next_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid next offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry->vmdk_handle == NULL )
+	{
+		return( 0 );
+	}
+	find_hole = (uint8_t) ( find_hole != 0 );
+
+	do
+	{
+		result = mount_file_system_get_run_at_offset(
+		          file_entry->file_system,
+		          file_entry->vmdk_handle,
+		          offset,
+		          &run_size,
+		          &is_hole,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve run at offset: %" PRIi64 " (0x%08" PRIx64 ") from file system.",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( is_hole == find_hole )
+		{
+			*next_offset = offset;
+
+			return( 1 );
+		}
+		offset += (off64_t) run_size;
+	}
+	while( run_size > 0 );
+
+	/* There is no hole after the last data, the end of the data is used instead
+	 * unless the offset was already beyond the end of the data
+	 */
+	if( ( find_hole != 0 )
+	 && ( run_size > 0 ) )
+	{
+		*next_offset = offset;
+
+		return( 1 );
+	}
+	return( 0 );
+}
+
+#if defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS )
+
+/* Retrieves the run at a specific offset and, if the data of the run is stored
+ * as-is in an opened extent data file, its file descriptor and file offset
+ * Returns 1 if the data is stored as-is, 0 if not or -1 on error
+ */
+int mount_file_entry_get_stored_run_at_offset(
+     mount_file_entry_t *file_entry,
+     off64_t offset,
+     size64_t *run_size,
+     int *file_descriptor,
+     off64_t *file_offset,
+     libcerror_error_t **error )
+{
+	static char *function   = "mount_file_entry_get_stored_run_at_offset";
+	off64_t physical_offset = 0;
+	uint32_t run_flags      = 0;
+	int extent_index        = 0;
+	int result              = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( run_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run size.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file offset.",
+		 function );
+
+		return( -1 );
+	}
+	*run_size = 0;
+
+	if( file_entry->vmdk_handle == NULL )
+	{
+		return( 0 );
+	}
+	result = libvmdk_handle_get_extent_map_run_at_offset(
+	          file_entry->vmdk_handle,
+	          offset,
+	          run_size,
+	          &extent_index,
+	          &physical_offset,
+	          &run_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent map run at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		*run_size = 0;
+
+		return( 0 );
+	}
+	/* Sparse, compressed and zero runs and runs stored in a parent are read by the library
+	 */
+	if( run_flags != 0 )
+	{
+		return( 0 );
+	}
+	result = mount_file_system_get_extent_file_descriptor(
+	          file_entry->file_system,
+	          file_entry->vmdk_handle,
+	          extent_index,
+	          file_descriptor,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent: %d file descriptor from file system.",
+		 function,
+		 extent_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		*file_offset = physical_offset;
+	}
+	return( result );
+}
+
+#endif /* defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS ) */
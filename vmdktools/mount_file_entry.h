@@ -52,6 +52,18 @@ struct mount_file_entry
 	/* The handle
 	 */
 	libvmdk_handle_t *vmdk_handle;
+
+	/* Value to indicate the file entry is the statistics file
+	 */
+	uint8_t is_statistics;
+
+	/* The statistics
+	 */
+	uint8_t *statistics;
+
+	/* The statistics size
+	 */
+	size_t statistics_size;
 };
 
 int mount_file_entry_initialize(
@@ -62,6 +74,11 @@ int mount_file_entry_initialize(
      libvmdk_handle_t *vmdk_handle,
      libcerror_error_t **error );
 
+int mount_file_entry_initialize_statistics(
+     mount_file_entry_t **file_entry,
+     mount_file_system_t *file_system,
+     libcerror_error_t **error );
+
 int mount_file_entry_free(
      mount_file_entry_t **file_entry,
      libcerror_error_t **error );
@@ -130,6 +147,30 @@ int mount_file_entry_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+int mount_file_entry_get_allocated_size(
+     mount_file_entry_t *file_entry,
+     size64_t *allocated_size,
+     libcerror_error_t **error );
+
+int mount_file_entry_get_next_data_or_hole_offset(
+     mount_file_entry_t *file_entry,
+     off64_t offset,
+     uint8_t find_hole,
+     off64_t *next_offset,
+     libcerror_error_t **error );
+
+#if defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS )
+
+int mount_file_entry_get_stored_run_at_offset(
+     mount_file_entry_t *file_entry,
+     off64_t offset,
+     size64_t *run_size,
+     int *file_descriptor,
+     off64_t *file_offset,
+     libcerror_error_t **error );
+
+#endif /* defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS ) */
+
 #if defined( __cplusplus )
 }
 #endif
@@ -36,9 +36,14 @@
 
 #include <time.h>
 
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
 #include "mount_file_system.h"
 #include "vmdktools_libcdata.h"
 #include "vmdktools_libcerror.h"
+#include "vmdktools_libcthreads.h"
 #include "vmdktools_libvmdk.h"
 
 /* Creates a file system
@@ -134,6 +139,49 @@ int mount_file_system_initialize(
 
 		goto on_error;
 	}
+	if( libcdata_array_initialize(
+	     &( ( *file_system )->reader_handles_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize reader handles array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_shared_cache_initialize(
+	     &( ( *file_system )->shared_cache ),
+	     (size64_t) MOUNT_FILE_SYSTEM_SHARED_CACHE_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize shared cache.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *file_system )->statistics_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize statistics mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 #if defined( WINAPI )
 	if( memory_set(
 	     &systemtime,
@@ -213,6 +261,34 @@ int mount_file_system_initialize(
 on_error:
 	if( *file_system != NULL )
 	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *file_system )->statistics_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *file_system )->statistics_mutex ),
+			 NULL );
+		}
+#endif
+		if( ( *file_system )->shared_cache != NULL )
+		{
+			libvmdk_shared_cache_free(
+			 &( ( *file_system )->shared_cache ),
+			 NULL );
+		}
+		if( ( *file_system )->reader_handles_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *file_system )->reader_handles_array ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *file_system )->handles_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *file_system )->handles_array ),
+			 NULL,
+			 NULL );
+		}
 		memory_free(
 		 *file_system );
 
@@ -231,6 +307,12 @@ int mount_file_system_free(
 	static char *function = "mount_file_system_free";
 	int result            = 1;
 
+#if defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS )
+	int extent_index      = 0;
+	int handle_index      = 0;
+	int number_of_handles = 0;
+#endif
+
 	if( file_system == NULL )
 	{
 		libcerror_error_set(
@@ -249,6 +331,22 @@ int mount_file_system_free(
 			memory_free(
 			 ( *file_system )->path_prefix );
 		}
+#if defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS )
+		if( libcdata_array_get_number_of_entries(
+		     ( *file_system )->handles_array,
+		     &number_of_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of handles.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		if( libcdata_array_free(
 		     &( ( *file_system )->handles_array ),
 		     NULL,
@@ -263,6 +361,86 @@ int mount_file_system_free(
 
 			result = -1;
 		}
+		if( libcdata_array_free(
+		     &( ( *file_system )->reader_handles_array ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reader handles array.",
+			 function );
+
+			result = -1;
+		}
+		if( libvmdk_shared_cache_free(
+		     &( ( *file_system )->shared_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free shared cache.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *file_system )->allocated_sizes != NULL )
+		{
+			memory_free(
+			 ( *file_system )->allocated_sizes );
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *file_system )->statistics_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free statistics mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+#if defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS )
+		if( ( *file_system )->extent_file_descriptors != NULL )
+		{
+			for( handle_index = 0;
+			     handle_index < number_of_handles;
+			     handle_index++ )
+			{
+				if( ( *file_system )->extent_file_descriptors[ handle_index ] == NULL )
+				{
+					continue;
+				}
+				for( extent_index = 0;
+				     extent_index < ( *file_system )->number_of_extent_file_descriptors[ handle_index ];
+				     extent_index++ )
+				{
+					if( ( *file_system )->extent_file_descriptors[ handle_index ][ extent_index ] != -1 )
+					{
+						close(
+						 ( *file_system )->extent_file_descriptors[ handle_index ][ extent_index ] );
+					}
+				}
+				memory_free(
+				 ( *file_system )->extent_file_descriptors[ handle_index ] );
+			}
+			memory_free(
+			 ( *file_system )->extent_file_descriptors );
+		}
+		if( ( *file_system )->number_of_extent_file_descriptors != NULL )
+		{
+			memory_free(
+			 ( *file_system )->number_of_extent_file_descriptors );
+		}
+#endif
 		memory_free(
 		 *file_system );
 
@@ -723,8 +901,15 @@ int mount_file_system_append_handle(
      libvmdk_handle_t *vmdk_handle,
      libcerror_error_t **error )
 {
-	static char *function = "mount_file_system_append_handle";
-	int entry_index       = 0;
+	size64_t *allocated_sizes = NULL;
+	static char *function     = "mount_file_system_append_handle";
+	int entry_index           = 0;
+	int number_of_handles     = 0;
+
+#if defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS )
+	int **extent_file_descriptors          = NULL;
+	int *number_of_extent_file_descriptors = NULL;
+#endif
 
 	if( file_system == NULL )
 	{
@@ -737,6 +922,79 @@ int mount_file_system_append_handle(
 
 		return( -1 );
 	}
+	if( libcdata_array_get_number_of_entries(
+	     file_system->handles_array,
+	     &number_of_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of handles.",
+		 function );
+
+		return( -1 );
+	}
+	allocated_sizes = (size64_t *) memory_reallocate(
+	                               file_system->allocated_sizes,
+	                               sizeof( size64_t ) * ( number_of_handles + 1 ) );
+
+	if( allocated_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize allocated sizes.",
+		 function );
+
+		return( -1 );
+	}
+	file_system->allocated_sizes = allocated_sizes;
+
+	file_system->allocated_sizes[ number_of_handles ] = MOUNT_FILE_SYSTEM_ALLOCATED_SIZE_NOT_SET;
+
+#if defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS )
+	extent_file_descriptors = (int **) memory_reallocate(
+	                                    file_system->extent_file_descriptors,
+	                                    sizeof( int * ) * ( number_of_handles + 1 ) );
+
+	if( extent_file_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize extent file descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	file_system->extent_file_descriptors = extent_file_descriptors;
+
+	file_system->extent_file_descriptors[ number_of_handles ] = NULL;
+
+	number_of_extent_file_descriptors = (int *) memory_reallocate(
+	                                             file_system->number_of_extent_file_descriptors,
+	                                             sizeof( int ) * ( number_of_handles + 1 ) );
+
+	if( number_of_extent_file_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize number of extent file descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	file_system->number_of_extent_file_descriptors = number_of_extent_file_descriptors;
+
+	file_system->number_of_extent_file_descriptors[ number_of_handles ] = 0;
+#endif
+
 	if( libcdata_array_append_entry(
 	     file_system->handles_array,
 	     &entry_index,
@@ -755,6 +1013,1572 @@ int mount_file_system_append_handle(
 	return( 1 );
 }
 
+/* Sets the shared cache of a handle
+ * The layers are identified in the shared cache by their handle, hence
+ * a reader handle shares the cached grain data of its layer handle
+ * This function needs to be called before the handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_set_shared_cache_of_handle(
+     mount_file_system_t *file_system,
+     libvmdk_handle_t *vmdk_handle,
+     libvmdk_handle_t *layer_vmdk_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_set_shared_cache_of_handle";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( layer_vmdk_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layer handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_set_shared_cache(
+	     vmdk_handle,
+	     file_system->shared_cache,
+	     (uint8_t *) &layer_vmdk_handle,
+	     sizeof( libvmdk_handle_t * ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set shared cache of handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the index of a specific handle
+ * Returns 1 if successful, 0 if no such handle or -1 on error
+ */
+int mount_file_system_get_index_of_handle(
+     mount_file_system_t *file_system,
+     libvmdk_handle_t *vmdk_handle,
+     int *handle_index,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *array_vmdk_handle = NULL;
+	static char *function               = "mount_file_system_get_index_of_handle";
+	int number_of_handles               = 0;
+	int safe_handle_index               = 0;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( handle_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     file_system->handles_array,
+	     &number_of_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of handles.",
+		 function );
+
+		return( -1 );
+	}
+	for( safe_handle_index = 0;
+	     safe_handle_index < number_of_handles;
+	     safe_handle_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     file_system->handles_array,
+		     safe_handle_index,
+		     (intptr_t **) &array_vmdk_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve handle: %d.",
+			 function,
+			 safe_handle_index );
+
+			return( -1 );
+		}
+		if( array_vmdk_handle == vmdk_handle )
+		{
+			*handle_index = safe_handle_index;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Retrieves the run at a specific offset of a handle
+ * A run is a range that starts at the offset and consists either entirely of
+ * data or entirely of a hole, where a hole is a range that is not stored in
+ * the image or any of its parents and reads as zero bytes.
+ * The parent handles are appended to the file system before the handle,
+ * hence the parent of the handle at a specific index is the handle at the
+ * preceding index
+ * Returns 1 if successful, 0 if the offset is beyond the media size or -1 on error
+ */
+int mount_file_system_get_run_at_offset(
+     mount_file_system_t *file_system,
+     libvmdk_handle_t *vmdk_handle,
+     off64_t offset,
+     size64_t *run_size,
+     uint8_t *is_hole,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *layer_vmdk_handle = NULL;
+	static char *function               = "mount_file_system_get_run_at_offset";
+	size64_t layer_run_size             = 0;
+	size64_t media_size                 = 0;
+	off64_t physical_offset             = 0;
+	uint32_t run_flags                  = 0;
+	int extent_index                    = 0;
+	int handle_index                    = 0;
+	int result                          = 0;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( run_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run size.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_hole == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid is hole.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_media_size(
+	     vmdk_handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= media_size )
+	{
+		return( 0 );
+	}
+	result = mount_file_system_get_index_of_handle(
+	          file_system,
+	          vmdk_handle,
+	          &handle_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index of handle.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		/* Without a known parent, data stored in the parent is considered data
+		 */
+		handle_index = 0;
+	}
+	layer_vmdk_handle = vmdk_handle;
+
+	*run_size = media_size - (size64_t) offset;
+	*is_hole  = 0;
+
+	do
+	{
+		result = libvmdk_handle_get_extent_map_run_at_offset(
+		          layer_vmdk_handle,
+		          offset,
+		          &layer_run_size,
+		          &extent_index,
+		          &physical_offset,
+		          &run_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent map run at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			/* The parent is smaller than the image, which reads as zero bytes
+			 */
+			*is_hole = 1;
+
+			break;
+		}
+		if( ( layer_run_size != 0 )
+		 && ( layer_run_size < *run_size ) )
+		{
+			*run_size = layer_run_size;
+		}
+		if( ( ( run_flags & LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_IN_PARENT ) == 0 )
+		 || ( handle_index == 0 ) )
+		{
+			if( ( run_flags & LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_ZERO ) != 0 )
+			{
+				*is_hole = 1;
+			}
+			break;
+		}
+		handle_index--;
+
+		if( libcdata_array_get_entry_by_index(
+		     file_system->handles_array,
+		     handle_index,
+		     (intptr_t **) &layer_vmdk_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve handle: %d.",
+			 function,
+			 handle_index );
+
+			return( -1 );
+		}
+	}
+	while( layer_vmdk_handle != NULL );
+
+	return( 1 );
+}
+
+/* Retrieves the allocated size of a handle
+ * The allocated size is the number of bytes of the runs that are not a hole.
+ * The allocated size does not change while the image is mounted and is
+ * only determined the first time it is requested
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_get_allocated_size(
+     mount_file_system_t *file_system,
+     libvmdk_handle_t *vmdk_handle,
+     size64_t *allocated_size,
+     libcerror_error_t **error )
+{
+	static char *function        = "mount_file_system_get_allocated_size";
+	size64_t run_size            = 0;
+	size64_t safe_allocated_size = 0;
+	off64_t offset               = 0;
+	uint8_t is_hole              = 0;
+	int handle_index             = 0;
+	int has_handle_index         = 0;
+	int result                   = 0;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocated_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocated size.",
+		 function );
+
+		return( -1 );
+	}
+	result = mount_file_system_get_index_of_handle(
+	          file_system,
+	          vmdk_handle,
+	          &handle_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index of handle.",
+		 function );
+
+		return( -1 );
+	}
+	has_handle_index = result;
+
+	if( ( has_handle_index != 0 )
+	 && ( file_system->allocated_sizes[ handle_index ] != MOUNT_FILE_SYSTEM_ALLOCATED_SIZE_NOT_SET ) )
+	{
+		*allocated_size = file_system->allocated_sizes[ handle_index ];
+
+		return( 1 );
+	}
+	do
+	{
+		result = mount_file_system_get_run_at_offset(
+		          file_system,
+		          vmdk_handle,
+		          offset,
+		          &run_size,
+		          &is_hole,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve run at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( is_hole == 0 )
+			{
+				safe_allocated_size += run_size;
+			}
+			offset += (off64_t) run_size;
+		}
+	}
+	while( result != 0 );
+
+	/* Concurrent requests determine and store the same value
+	 */
+	if( has_handle_index != 0 )
+	{
+		file_system->allocated_sizes[ handle_index ] = safe_allocated_size;
+	}
+	*allocated_size = safe_allocated_size;
+
+	return( 1 );
+}
+
+#if defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS )
+
+/* Sets the extent file descriptors of a handle
+ * The file system takes over ownership of the extent file descriptors, a file descriptor
+ * of -1 indicates the extent data file is not available
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_set_extent_file_descriptors(
+     mount_file_system_t *file_system,
+     libvmdk_handle_t *vmdk_handle,
+     int *extent_file_descriptors,
+     int number_of_extent_file_descriptors,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_set_extent_file_descriptors";
+	int handle_index      = 0;
+	int result            = 0;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_file_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extent_file_descriptors < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of extent file descriptors value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = mount_file_system_get_index_of_handle(
+	          file_system,
+	          vmdk_handle,
+	          &handle_index,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index of handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->extent_file_descriptors[ handle_index ] != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file system - extent file descriptors of handle: %d value already set.",
+		 function,
+		 handle_index );
+
+		return( -1 );
+	}
+	file_system->extent_file_descriptors[ handle_index ]           = extent_file_descriptors;
+	file_system->number_of_extent_file_descriptors[ handle_index ] = number_of_extent_file_descriptors;
+
+	return( 1 );
+}
+
+/* Retrieves the file descriptor of a specific extent data file of a handle
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int mount_file_system_get_extent_file_descriptor(
+     mount_file_system_t *file_system,
+     libvmdk_handle_t *vmdk_handle,
+     int extent_index,
+     int *file_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_get_extent_file_descriptor";
+	int handle_index      = 0;
+	int result            = 0;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	result = mount_file_system_get_index_of_handle(
+	          file_system,
+	          vmdk_handle,
+	          &handle_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index of handle.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( ( file_system->extent_file_descriptors[ handle_index ] == NULL )
+	 || ( extent_index < 0 )
+	 || ( extent_index >= file_system->number_of_extent_file_descriptors[ handle_index ] ) )
+	{
+		return( 0 );
+	}
+	if( file_system->extent_file_descriptors[ handle_index ][ extent_index ] == -1 )
+	{
+		return( 0 );
+	}
+	*file_descriptor = file_system->extent_file_descriptors[ handle_index ][ extent_index ];
+
+	return( 1 );
+}
+
+#endif /* defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS ) */
+
+/* Retrieves the number of reader handles
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_get_number_of_reader_handles(
+     mount_file_system_t *file_system,
+     int *number_of_reader_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_get_number_of_reader_handles";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     file_system->reader_handles_array,
+	     number_of_reader_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of reader handles.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific reader handle
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_get_reader_handle_by_index(
+     mount_file_system_t *file_system,
+     int reader_handle_index,
+     libvmdk_handle_t **reader_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_get_reader_handle_by_index";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     file_system->reader_handles_array,
+	     reader_handle_index,
+	     (intptr_t **) reader_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve reader handle: %d.",
+		 function,
+		 reader_handle_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the handle to read the data at a specific offset of a handle
+ * Reads of the handle the reader handles were opened for are distributed in stripes
+ * over the reader handles so that concurrent reads of different parts of the image
+ * do not have to wait for each other. Data of a stripe is always read by the same
+ * reader handle, which keeps the caches of the reader handles from overlapping.
+ * For other handles the handle itself is returned
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_get_reader_handle_by_offset(
+     mount_file_system_t *file_system,
+     libvmdk_handle_t *vmdk_handle,
+     off64_t offset,
+     libvmdk_handle_t **reader_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *first_reader_handle = NULL;
+	static char *function                 = "mount_file_system_get_reader_handle_by_offset";
+	int number_of_reader_handles          = 0;
+	int reader_handle_index               = 0;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( reader_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     file_system->reader_handles_array,
+	     &number_of_reader_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of reader handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_reader_handles > 1 )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     file_system->reader_handles_array,
+		     0,
+		     (intptr_t **) &first_reader_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reader handle: 0.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( first_reader_handle == NULL )
+	 || ( first_reader_handle != vmdk_handle ) )
+	{
+		*reader_handle = vmdk_handle;
+
+		return( 1 );
+	}
+	reader_handle_index = (int) ( ( (size64_t) offset / MOUNT_FILE_SYSTEM_READER_STRIPE_SIZE ) % (size64_t) number_of_reader_handles );
+
+	if( libcdata_array_get_entry_by_index(
+	     file_system->reader_handles_array,
+	     reader_handle_index,
+	     (intptr_t **) reader_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve reader handle: %d.",
+		 function,
+		 reader_handle_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends a reader handle to the file system
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_append_reader_handle(
+     mount_file_system_t *file_system,
+     libvmdk_handle_t *reader_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_append_reader_handle";
+	int entry_index       = 0;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_append_entry(
+	     file_system->reader_handles_array,
+	     &entry_index,
+	     (intptr_t *) reader_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append reader handle to array.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Marks the start of a read request
+ * The start timestamp is used to determine the read latency and is 0 if not available
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_start_read(
+     mount_file_system_t *file_system,
+     int64_t *start_timestamp,
+     libcerror_error_t **error )
+{
+#if defined( MOUNT_FILE_SYSTEM_HAVE_READ_LATENCY )
+	struct timespec time_structure;
+#endif
+
+	static char *function = "mount_file_system_start_read";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( start_timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid start timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	*start_timestamp = 0;
+
+#if defined( MOUNT_FILE_SYSTEM_HAVE_READ_LATENCY )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time structure.",
+		 function );
+
+		return( -1 );
+	}
+	*start_timestamp = ( (int64_t) time_structure.tv_sec * 1000000000 ) + time_structure.tv_nsec;
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     file_system->statistics_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab statistics mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	file_system->number_of_outstanding_read_requests += 1;
+
+	if( file_system->number_of_outstanding_read_requests > file_system->maximum_number_of_outstanding_read_requests )
+	{
+		file_system->maximum_number_of_outstanding_read_requests = file_system->number_of_outstanding_read_requests;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     file_system->statistics_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release statistics mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Marks the end of a read request
+ * A read count of -1 indicates the read request failed
+ * The file descriptor read size is the part of the read count that was passed as file descriptor
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_end_read(
+     mount_file_system_t *file_system,
+     int64_t start_timestamp,
+     ssize_t read_count,
+     size_t file_descriptor_read_size,
+     libcerror_error_t **error )
+{
+#if defined( MOUNT_FILE_SYSTEM_HAVE_READ_LATENCY )
+	struct timespec time_structure;
+#endif
+
+	static char *function    = "mount_file_system_end_read";
+
+#if defined( MOUNT_FILE_SYSTEM_HAVE_READ_LATENCY )
+	uint64_t latency         = 0;
+	uint64_t latency_bound   = 10;
+	int latency_bucket_index = 0;
+#endif
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( MOUNT_FILE_SYSTEM_HAVE_READ_LATENCY )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time structure.",
+		 function );
+
+		return( -1 );
+	}
+	latency = (uint64_t) ( ( (int64_t) time_structure.tv_sec * 1000000000 ) + time_structure.tv_nsec );
+
+	if( ( start_timestamp <= 0 )
+	 || ( (uint64_t) start_timestamp > latency ) )
+	{
+		latency = 0;
+	}
+	else
+	{
+		latency -= (uint64_t) start_timestamp;
+	}
+	/* The latency bounds of the buckets are in microseconds
+	 */
+	while( latency_bucket_index < ( MOUNT_FILE_SYSTEM_NUMBER_OF_READ_LATENCY_BUCKETS - 1 ) )
+	{
+		if( ( latency / 1000 ) < latency_bound )
+		{
+			break;
+		}
+		latency_bound *= 10;
+
+		latency_bucket_index++;
+	}
+#endif /* defined( MOUNT_FILE_SYSTEM_HAVE_READ_LATENCY ) */
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     file_system->statistics_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab statistics mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( file_system->number_of_outstanding_read_requests > 0 )
+	{
+		file_system->number_of_outstanding_read_requests -= 1;
+	}
+	file_system->number_of_read_requests += 1;
+
+	if( read_count < 0 )
+	{
+		file_system->number_of_failed_read_requests += 1;
+	}
+	else
+	{
+		file_system->number_of_bytes_read                      += (uint64_t) read_count;
+		file_system->number_of_bytes_passed_as_file_descriptor += (uint64_t) file_descriptor_read_size;
+	}
+#if defined( MOUNT_FILE_SYSTEM_HAVE_READ_LATENCY )
+	file_system->read_latency_histogram[ latency_bucket_index ] += 1;
+	file_system->total_read_latency                             += latency;
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     file_system->statistics_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release statistics mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the statistics
+ * The statistics are a narrow string without end-of-string character
+ * that is freed by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_get_statistics(
+     mount_file_system_t *file_system,
+     uint8_t **statistics,
+     size_t *statistics_size,
+     libcerror_error_t **error )
+{
+	const char *memory_usage_type_names[ 5 ] = {
+		"Total memory usage\t\t\t",
+		"Descriptor memory usage\t\t",
+		"Extent files memory usage\t\t",
+		"Grain groups cache memory usage\t\t",
+		"Grains cache memory usage\t\t" };
+
+#if defined( MOUNT_FILE_SYSTEM_HAVE_READ_LATENCY )
+	uint64_t read_latency_histogram[ MOUNT_FILE_SYSTEM_NUMBER_OF_READ_LATENCY_BUCKETS ];
+
+	const char *read_latency_bucket_names[ MOUNT_FILE_SYSTEM_NUMBER_OF_READ_LATENCY_BUCKETS ] = {
+		"< 10 us\t",
+		"< 100 us",
+		"< 1 ms\t",
+		"< 10 ms\t",
+		"< 100 ms",
+		"< 1 s\t",
+		">= 1 s\t" };
+#endif
+
+	libvmdk_handle_t *vmdk_handle                       = NULL;
+	char *safe_statistics                               = NULL;
+	static char *function                               = "mount_file_system_get_statistics";
+	size64_t memory_usage                               = 0;
+	size64_t shared_cache_size                          = 0;
+	size_t safe_statistics_size                         = 0;
+	size_t statistics_index                             = 0;
+	uint64_t number_of_bytes_passed_as_file_descriptor  = 0;
+	uint64_t number_of_bytes_read                       = 0;
+	uint64_t number_of_cache_hits                       = 0;
+	uint64_t number_of_cache_misses                     = 0;
+	uint64_t number_of_failed_read_requests             = 0;
+	uint64_t number_of_read_requests                    = 0;
+	int handle_index                                    = 0;
+	int maximum_number_of_outstanding_read_requests     = 0;
+	int memory_usage_type                               = 0;
+	int number_of_handles                               = 0;
+	int number_of_outstanding_read_requests             = 0;
+	int number_of_reader_handles                        = 0;
+	int print_count                                     = 0;
+	int result                                          = 0;
+
+#if defined( MOUNT_FILE_SYSTEM_HAVE_READ_LATENCY )
+	uint64_t total_read_latency                         = 0;
+	int latency_bucket_index                            = 0;
+#endif
+
+#if defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS )
+	int extent_index                                    = 0;
+	int number_of_extent_file_descriptors               = 0;
+#endif
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( statistics_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     file_system->handles_array,
+	     &number_of_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     file_system->reader_handles_array,
+	     &number_of_reader_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of reader handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( number_of_handles < 0 )
+	 || ( number_of_handles > 999 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of handles value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     file_system->statistics_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab statistics mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	number_of_read_requests                     = file_system->number_of_read_requests;
+	number_of_failed_read_requests              = file_system->number_of_failed_read_requests;
+	number_of_outstanding_read_requests         = file_system->number_of_outstanding_read_requests;
+	maximum_number_of_outstanding_read_requests = file_system->maximum_number_of_outstanding_read_requests;
+	number_of_bytes_read                        = file_system->number_of_bytes_read;
+	number_of_bytes_passed_as_file_descriptor   = file_system->number_of_bytes_passed_as_file_descriptor;
+
+#if defined( MOUNT_FILE_SYSTEM_HAVE_READ_LATENCY )
+	total_read_latency = file_system->total_read_latency;
+
+	for( latency_bucket_index = 0;
+	     latency_bucket_index < MOUNT_FILE_SYSTEM_NUMBER_OF_READ_LATENCY_BUCKETS;
+	     latency_bucket_index++ )
+	{
+		read_latency_histogram[ latency_bucket_index ] = file_system->read_latency_histogram[ latency_bucket_index ];
+	}
+#endif
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     file_system->statistics_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release statistics mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	/* Every line is less than 128 characters
+	 */
+	safe_statistics_size = 128 * ( 20 + MOUNT_FILE_SYSTEM_NUMBER_OF_READ_LATENCY_BUCKETS + ( number_of_handles * 10 ) );
+
+	safe_statistics = narrow_string_allocate(
+	                   safe_statistics_size );
+
+	if( safe_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create statistics.",
+		 function );
+
+		goto on_error;
+	}
+	print_count = narrow_string_snprintf(
+	               &( safe_statistics[ statistics_index ] ),
+	               safe_statistics_size - statistics_index,
+	               "Read requests:\n"
+	               "\tNumber of requests\t\t\t: %" PRIu64 "\n"
+	               "\tNumber of failed requests\t\t: %" PRIu64 "\n"
+	               "\tNumber of outstanding requests\t\t: %d\n"
+	               "\tMaximum number of outstanding requests\t: %d\n"
+	               "\tNumber of bytes read\t\t\t: %" PRIu64 "\n"
+	               "\tNumber of bytes passed as descriptor\t: %" PRIu64 "\n"
+	               "\tNumber of reader handles\t\t: %d\n",
+	               number_of_read_requests,
+	               number_of_failed_read_requests,
+	               number_of_outstanding_read_requests,
+	               maximum_number_of_outstanding_read_requests,
+	               number_of_bytes_read,
+	               number_of_bytes_passed_as_file_descriptor,
+	               number_of_reader_handles );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= ( safe_statistics_size - statistics_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read requests statistics.",
+		 function );
+
+		goto on_error;
+	}
+	statistics_index += (size_t) print_count;
+
+#if defined( MOUNT_FILE_SYSTEM_HAVE_READ_LATENCY )
+	if( number_of_read_requests > 0 )
+	{
+		total_read_latency /= number_of_read_requests;
+	}
+	print_count = narrow_string_snprintf(
+	               &( safe_statistics[ statistics_index ] ),
+	               safe_statistics_size - statistics_index,
+	               "\tAverage latency\t\t\t\t: %" PRIu64 " us\n"
+	               "\n"
+	               "Read latency histogram:\n",
+	               total_read_latency / 1000 );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= ( safe_statistics_size - statistics_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read latency statistics.",
+		 function );
+
+		goto on_error;
+	}
+	statistics_index += (size_t) print_count;
+
+	for( latency_bucket_index = 0;
+	     latency_bucket_index < MOUNT_FILE_SYSTEM_NUMBER_OF_READ_LATENCY_BUCKETS;
+	     latency_bucket_index++ )
+	{
+		print_count = narrow_string_snprintf(
+		               &( safe_statistics[ statistics_index ] ),
+		               safe_statistics_size - statistics_index,
+		               "\t%s\t\t\t\t: %" PRIu64 "\n",
+		               read_latency_bucket_names[ latency_bucket_index ],
+		               read_latency_histogram[ latency_bucket_index ] );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= ( safe_statistics_size - statistics_index ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set read latency histogram statistics.",
+			 function );
+
+			goto on_error;
+		}
+		statistics_index += (size_t) print_count;
+	}
+#endif /* defined( MOUNT_FILE_SYSTEM_HAVE_READ_LATENCY ) */
+
+	if( libvmdk_shared_cache_get_size(
+	     file_system->shared_cache,
+	     &shared_cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve shared cache size.",
+		 function );
+
+		goto on_error;
+	}
+	print_count = narrow_string_snprintf(
+	               &( safe_statistics[ statistics_index ] ),
+	               safe_statistics_size - statistics_index,
+	               "\n"
+	               "Shared cache:\n"
+	               "\tSize of cached grain data\t\t: %" PRIu64 " bytes\n"
+	               "\tMaximum size of cached grain data\t: %d bytes\n",
+	               shared_cache_size,
+	               MOUNT_FILE_SYSTEM_SHARED_CACHE_SIZE );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= ( safe_statistics_size - statistics_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set shared cache statistics.",
+		 function );
+
+		goto on_error;
+	}
+	statistics_index += (size_t) print_count;
+
+	for( handle_index = 0;
+	     handle_index < number_of_handles;
+	     handle_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     file_system->handles_array,
+		     handle_index,
+		     (intptr_t **) &vmdk_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve handle: %d.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+		/* The layers are numbered like the image files in the file system
+		 */
+		print_count = narrow_string_snprintf(
+		               &( safe_statistics[ statistics_index ] ),
+		               safe_statistics_size - statistics_index,
+		               "\n"
+		               "Layer: %d\n",
+		               handle_index + 1 );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= ( safe_statistics_size - statistics_index ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set layer: %d statistics.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+		statistics_index += (size_t) print_count;
+
+		for( memory_usage_type = LIBVMDK_MEMORY_USAGE_TYPE_TOTAL;
+		     memory_usage_type <= LIBVMDK_MEMORY_USAGE_TYPE_GRAINS_CACHE;
+		     memory_usage_type++ )
+		{
+			if( libvmdk_handle_get_memory_usage(
+			     vmdk_handle,
+			     memory_usage_type,
+			     &memory_usage,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve memory usage: %d of handle: %d.",
+				 function,
+				 memory_usage_type,
+				 handle_index );
+
+				goto on_error;
+			}
+			print_count = narrow_string_snprintf(
+			               &( safe_statistics[ statistics_index ] ),
+			               safe_statistics_size - statistics_index,
+			               "\t%s: %" PRIu64 " bytes\n",
+			               memory_usage_type_names[ memory_usage_type ],
+			               memory_usage );
+
+			if( ( print_count < 0 )
+			 || ( (size_t) print_count >= ( safe_statistics_size - statistics_index ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set layer: %d memory usage statistics.",
+				 function,
+				 handle_index );
+
+				goto on_error;
+			}
+			statistics_index += (size_t) print_count;
+		}
+		/* The layers are identified in the shared cache by their handle
+		 */
+		result = libvmdk_shared_cache_get_statistics(
+		          file_system->shared_cache,
+		          (uint8_t *) &vmdk_handle,
+		          sizeof( libvmdk_handle_t * ),
+		          &number_of_cache_hits,
+		          &number_of_cache_misses,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve shared cache statistics of handle: %d.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			number_of_cache_hits   = 0;
+			number_of_cache_misses = 0;
+		}
+		print_count = narrow_string_snprintf(
+		               &( safe_statistics[ statistics_index ] ),
+		               safe_statistics_size - statistics_index,
+		               "\tNumber of grain cache hits\t\t: %" PRIu64 "\n"
+		               "\tNumber of grain cache misses\t\t: %" PRIu64 "\n",
+		               number_of_cache_hits,
+		               number_of_cache_misses );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= ( safe_statistics_size - statistics_index ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set layer: %d grain cache statistics.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+		statistics_index += (size_t) print_count;
+
+#if defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS )
+		number_of_extent_file_descriptors = 0;
+
+		if( file_system->extent_file_descriptors[ handle_index ] != NULL )
+		{
+			for( extent_index = 0;
+			     extent_index < file_system->number_of_extent_file_descriptors[ handle_index ];
+			     extent_index++ )
+			{
+				if( file_system->extent_file_descriptors[ handle_index ][ extent_index ] != -1 )
+				{
+					number_of_extent_file_descriptors++;
+				}
+			}
+		}
+		print_count = narrow_string_snprintf(
+		               &( safe_statistics[ statistics_index ] ),
+		               safe_statistics_size - statistics_index,
+		               "\tNumber of extent file descriptors\t: %d of %d\n",
+		               number_of_extent_file_descriptors,
+		               file_system->number_of_extent_file_descriptors[ handle_index ] );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= ( safe_statistics_size - statistics_index ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set layer: %d extent file descriptors statistics.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+		statistics_index += (size_t) print_count;
+
+#endif /* defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS ) */
+	}
+	*statistics      = (uint8_t *) safe_statistics;
+	*statistics_size = statistics_index;
+
+	return( 1 );
+
+on_error:
+	if( safe_statistics != NULL )
+	{
+		memory_free(
+		 safe_statistics );
+	}
+	return( -1 );
+}
+
 /* Retrieves the path from a handle index.
  * Returns 1 if successful or -1 on error
  */
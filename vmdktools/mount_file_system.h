@@ -25,13 +25,58 @@
 #include <common.h>
 #include <types.h>
 
+#if defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#endif
+
+#include <time.h>
+
 #include "vmdktools_libcdata.h"
 #include "vmdktools_libcerror.h"
+#include "vmdktools_libcthreads.h"
+#include "vmdktools_libvmdk.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The size of the stripes in which reads are distributed over the reader handles
+ */
+#define MOUNT_FILE_SYSTEM_READER_STRIPE_SIZE	( 1024 * 1024 )
+
+/* The extent data files are opened by the mount file system, so that the data
+ * stored in them can be passed to FUSE as a file descriptor and offset
+ */
+#if ( defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) ) && defined( HAVE_FCNTL_H ) && defined( HAVE_UNISTD_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) && !defined( WINAPI )
+#define MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS
+#endif
+
+/* The name of the statistics file
+ */
+#define MOUNT_FILE_SYSTEM_STATISTICS_NAME		".vmdkmount_stats"
+#define MOUNT_FILE_SYSTEM_STATISTICS_NAME_LENGTH	16
+
+/* The read latencies are only measured if a monotonic clock is available
+ */
+#if defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+#define MOUNT_FILE_SYSTEM_HAVE_READ_LATENCY
+#endif
+
+/* The number of buckets of the read latency histogram, the upper bound of
+ * the first bucket is 10 microseconds, that of every next bucket 10 times
+ * that of the previous and the last bucket has no upper bound
+ */
+#define MOUNT_FILE_SYSTEM_NUMBER_OF_READ_LATENCY_BUCKETS	7
+
+/* The maximum number of bytes of grain data retained by the shared cache
+ * of the layers and reader handles
+ */
+#define MOUNT_FILE_SYSTEM_SHARED_CACHE_SIZE		( 64 * 1024 * 1024 )
+
+/* The value of an allocated size that has not been determined yet
+ */
+#define MOUNT_FILE_SYSTEM_ALLOCATED_SIZE_NOT_SET	( (size64_t) -1 )
+
 typedef struct mount_file_system mount_file_system_t;
 
 struct mount_file_system
@@ -51,6 +96,70 @@ struct mount_file_system
 	/* The handles array
 	 */
 	libcdata_array_t *handles_array;
+
+	/* The allocated sizes of the handles
+	 */
+	size64_t *allocated_sizes;
+
+#if defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS )
+	/* The extent file descriptors of the handles
+	 */
+	int **extent_file_descriptors;
+
+	/* The number of extent file descriptors of the handles
+	 */
+	int *number_of_extent_file_descriptors;
+#endif
+
+	/* The reader handles array
+	 * The first entry is the handle the reader handles were opened for,
+	 * the other entries are additional handles of the same image
+	 */
+	libcdata_array_t *reader_handles_array;
+
+	/* The shared cache
+	 */
+	libvmdk_shared_cache_t *shared_cache;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The statistics mutex
+	 */
+	libcthreads_mutex_t *statistics_mutex;
+#endif
+
+	/* The number of read requests
+	 */
+	uint64_t number_of_read_requests;
+
+	/* The number of failed read requests
+	 */
+	uint64_t number_of_failed_read_requests;
+
+	/* The number of outstanding read requests
+	 */
+	int number_of_outstanding_read_requests;
+
+	/* The maximum number of outstanding read requests
+	 */
+	int maximum_number_of_outstanding_read_requests;
+
+	/* The number of bytes read
+	 */
+	uint64_t number_of_bytes_read;
+
+	/* The number of bytes passed as file descriptor
+	 */
+	uint64_t number_of_bytes_passed_as_file_descriptor;
+
+#if defined( MOUNT_FILE_SYSTEM_HAVE_READ_LATENCY )
+	/* The read latency histogram
+	 */
+	uint64_t read_latency_histogram[ MOUNT_FILE_SYSTEM_NUMBER_OF_READ_LATENCY_BUCKETS ];
+
+	/* The total read latency in nanoseconds
+	 */
+	uint64_t total_read_latency;
+#endif
 };
 
 int mount_file_system_initialize(
@@ -99,6 +208,91 @@ int mount_file_system_append_handle(
      libvmdk_handle_t *vmdk_handle,
      libcerror_error_t **error );
 
+int mount_file_system_set_shared_cache_of_handle(
+     mount_file_system_t *file_system,
+     libvmdk_handle_t *vmdk_handle,
+     libvmdk_handle_t *layer_vmdk_handle,
+     libcerror_error_t **error );
+
+int mount_file_system_get_index_of_handle(
+     mount_file_system_t *file_system,
+     libvmdk_handle_t *vmdk_handle,
+     int *handle_index,
+     libcerror_error_t **error );
+
+int mount_file_system_get_run_at_offset(
+     mount_file_system_t *file_system,
+     libvmdk_handle_t *vmdk_handle,
+     off64_t offset,
+     size64_t *run_size,
+     uint8_t *is_hole,
+     libcerror_error_t **error );
+
+int mount_file_system_get_allocated_size(
+     mount_file_system_t *file_system,
+     libvmdk_handle_t *vmdk_handle,
+     size64_t *allocated_size,
+     libcerror_error_t **error );
+
+#if defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS )
+
+int mount_file_system_set_extent_file_descriptors(
+     mount_file_system_t *file_system,
+     libvmdk_handle_t *vmdk_handle,
+     int *extent_file_descriptors,
+     int number_of_extent_file_descriptors,
+     libcerror_error_t **error );
+
+int mount_file_system_get_extent_file_descriptor(
+     mount_file_system_t *file_system,
+     libvmdk_handle_t *vmdk_handle,
+     int extent_index,
+     int *file_descriptor,
+     libcerror_error_t **error );
+
+#endif /* defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS ) */
+
+int mount_file_system_get_number_of_reader_handles(
+     mount_file_system_t *file_system,
+     int *number_of_reader_handles,
+     libcerror_error_t **error );
+
+int mount_file_system_get_reader_handle_by_index(
+     mount_file_system_t *file_system,
+     int reader_handle_index,
+     libvmdk_handle_t **reader_handle,
+     libcerror_error_t **error );
+
+int mount_file_system_get_reader_handle_by_offset(
+     mount_file_system_t *file_system,
+     libvmdk_handle_t *vmdk_handle,
+     off64_t offset,
+     libvmdk_handle_t **reader_handle,
+     libcerror_error_t **error );
+
+int mount_file_system_append_reader_handle(
+     mount_file_system_t *file_system,
+     libvmdk_handle_t *reader_handle,
+     libcerror_error_t **error );
+
+int mount_file_system_start_read(
+     mount_file_system_t *file_system,
+     int64_t *start_timestamp,
+     libcerror_error_t **error );
+
+int mount_file_system_end_read(
+     mount_file_system_t *file_system,
+     int64_t start_timestamp,
+     ssize_t read_count,
+     size_t file_descriptor_read_size,
+     libcerror_error_t **error );
+
+int mount_file_system_get_statistics(
+     mount_file_system_t *file_system,
+     uint8_t **statistics,
+     size_t *statistics_size,
+     libcerror_error_t **error );
+
 int mount_file_system_get_path_from_handle_index(
      mount_file_system_t *file_system,
      int handle_index,
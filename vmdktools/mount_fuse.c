@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <types.h>
 
@@ -39,6 +40,8 @@
 #include <unistd.h>
 #endif
 
+#include "mount_file_entry.h"
+#include "mount_file_system.h"
 #include "mount_fuse.h"
 #include "mount_handle.h"
 #include "vmdktools_libcerror.h"
@@ -56,11 +59,13 @@ extern mount_handle_t *vmdkmount_mount_handle;
 
 /* Sets the values in a stat info structure
  * The time values are a signed 64-bit POSIX date and time value in number of nanoseconds
+ * The number of blocks is determined from the allocated size in units of 512 bytes
  * Returns 1 if successful or -1 on error
  */
 int mount_fuse_set_stat_info(
      mount_fuse_stat_t *stat_info,
      size64_t size,
+     size64_t allocated_size,
      uint16_t file_mode,
      int64_t access_time,
      int64_t inode_change_time,
@@ -113,11 +118,12 @@ int mount_fuse_set_stat_info(
 	group_identifier = getegid();
 #endif
 #if defined( __APPLE__ )
-	stat_info->size  = (off_t) size;
-	stat_info->mode  = file_mode;
-	stat_info->nlink = number_of_links;
-	stat_info->uid   = owner_identifier;
-	stat_info->gid   = group_identifier;
+	stat_info->size   = (off_t) size;
+	stat_info->blocks = (blkcnt_t) ( ( allocated_size + 511 ) / 512 );
+	stat_info->mode   = file_mode;
+	stat_info->nlink  = number_of_links;
+	stat_info->uid    = owner_identifier;
+	stat_info->gid    = group_identifier;
 
 	stat_info->atimespec.tv_sec  = access_time / 1000000000;
 	stat_info->atimespec.tv_nsec = access_time % 1000000000;
@@ -128,11 +134,12 @@ int mount_fuse_set_stat_info(
 	stat_info->mtimespec.tv_sec  = modification_time / 1000000000;
 	stat_info->mtimespec.tv_nsec = modification_time % 1000000000;
 #else
-	stat_info->st_size  = (off_t) size;
-	stat_info->st_mode  = file_mode;
-	stat_info->st_nlink = number_of_links;
-	stat_info->st_uid   = owner_identifier;
-	stat_info->st_gid   = group_identifier;
+	stat_info->st_size   = (off_t) size;
+	stat_info->st_blocks = (blkcnt_t) ( ( allocated_size + 511 ) / 512 );
+	stat_info->st_mode   = file_mode;
+	stat_info->st_nlink  = number_of_links;
+	stat_info->st_uid    = owner_identifier;
+	stat_info->st_gid    = group_identifier;
 
 	stat_info->st_atime = access_time / 1000000000;
 	stat_info->st_ctime = inode_change_time / 1000000000;
@@ -160,6 +167,7 @@ int mount_fuse_filldir(
      libcerror_error_t **error )
 {
 	static char *function      = "mount_fuse_filldir";
+	size64_t allocated_size    = 0;
 	size64_t file_size         = 0;
 	uint64_t access_time       = 0;
 	uint64_t inode_change_time = 0;
@@ -193,6 +201,20 @@ int mount_fuse_filldir(
 
 			return( -1 );
 		}
+		if( mount_file_entry_get_allocated_size(
+		     file_entry,
+		     &allocated_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file entry allocated size.",
+			 function );
+
+			return( -1 );
+		}
 		if( mount_file_entry_get_file_mode(
 		     file_entry,
 		     &file_mode,
@@ -267,6 +289,7 @@ int mount_fuse_filldir(
 	if( mount_fuse_set_stat_info(
 	     stat_info,
 	     file_size,
+	     allocated_size,
 	     file_mode,
 	     (int64_t) access_time,
 	     (int64_t) inode_change_time,
@@ -399,6 +422,13 @@ int mount_fuse_open(
 
 		goto on_error;
 	}
+	if( ( (mount_file_entry_t *) file_info->fh )->is_statistics != 0 )
+	{
+		/* The statistics change between opens and their size is not known in advance,
+		 * hence they bypass the page cache
+		 */
+		file_info->direct_io = 1;
+	}
 	return( 0 );
 
 on_error:
@@ -425,6 +455,7 @@ int mount_fuse_read(
 	libcerror_error_t *error = NULL;
 	static char *function    = "mount_fuse_read";
 	ssize_t read_count       = 0;
+	int64_t start_timestamp  = 0;
 	int result               = 0;
 
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -488,6 +519,22 @@ int mount_fuse_read(
 
 		goto on_error;
 	}
+	if( mount_file_system_start_read(
+	     ( (mount_file_entry_t *) file_info->fh )->file_system,
+	     &start_timestamp,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start read in file system.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
 	read_count = mount_file_entry_read_buffer_at_offset(
 	              (mount_file_entry_t *) file_info->fh,
 	              (void *) buffer,
@@ -505,7 +552,25 @@ int mount_fuse_read(
 		 function );
 
 		result = -EIO;
+	}
+	if( mount_file_system_end_read(
+	     ( (mount_file_entry_t *) file_info->fh )->file_system,
+	     start_timestamp,
+	     read_count,
+	     0,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to end read in file system.",
+		 function );
 
+		result = -EIO;
+	}
+	if( result != 0 )
+	{
 		goto on_error;
 	}
 	return( (int) read_count );
@@ -521,6 +586,621 @@ on_error:
 	return( result );
 }
 
+#if defined( MOUNT_FUSE_HAVE_READ_BUF )
+
+/* Appends a memory buffer with the data at the specified offset to a buffer vector
+ * Returns 1 if successful or -1 on error
+ */
+int mount_fuse_append_memory_buffer(
+     struct fuse_bufvec *buffer_vector,
+     mount_file_entry_t *file_entry,
+     off64_t offset,
+     size_t size,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer       = NULL;
+	static char *function = "mount_fuse_append_memory_buffer";
+	ssize_t read_count    = 0;
+
+	if( buffer_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_vector->count >= MOUNT_FUSE_MAXIMUM_NUMBER_OF_BUFFERS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer vector - count value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The buffer is freed by FUSE
+	 */
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = mount_file_entry_read_buffer_at_offset(
+	              file_entry,
+	              (void *) buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file entry.",
+		 function );
+
+		goto on_error;
+	}
+	buffer_vector->buf[ buffer_vector->count ].size  = (size_t) read_count;
+	buffer_vector->buf[ buffer_vector->count ].flags = 0;
+	buffer_vector->buf[ buffer_vector->count ].mem   = (void *) buffer;
+	buffer_vector->buf[ buffer_vector->count ].fd    = -1;
+	buffer_vector->buf[ buffer_vector->count ].pos   = 0;
+
+	buffer_vector->count += 1;
+
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Reads the data at the specified offset into a buffer vector
+ * Data that is stored as-is in an extent data file is passed as a file descriptor
+ * and offset, so that FUSE can splice it, other data is read into memory buffers
+ * Returns 0 if successful or a negative errno value otherwise
+ */
+int mount_fuse_read_buf(
+     const char *path,
+     struct fuse_bufvec **buffer_vector,
+     size_t size,
+     off_t offset,
+     struct fuse_file_info *file_info )
+{
+	struct fuse_bufvec *safe_buffer_vector = NULL;
+	libcerror_error_t *error               = NULL;
+	mount_file_entry_t *file_entry         = NULL;
+	static char *function                  = "mount_fuse_read_buf";
+	size64_t file_size                     = 0;
+	size64_t run_size                      = 0;
+	size_t file_descriptor_read_size       = 0;
+	size_t pending_size                    = 0;
+	size_t read_size                       = 0;
+	off64_t file_offset                    = 0;
+	off64_t pending_offset                 = 0;
+	int64_t start_timestamp                = 0;
+	uint32_t buffer_index                  = 0;
+	uint8_t read_started                   = 0;
+	int file_descriptor                    = -1;
+	int result                             = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: %s\n",
+		 function,
+		 path );
+	}
+#endif
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( buffer_vector == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer vector.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( size > (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file information.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info->fh == (uint64_t) NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file information - missing file handle.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	file_entry = (mount_file_entry_t *) file_info->fh;
+
+	if( mount_file_system_start_read(
+	     file_entry->file_system,
+	     &start_timestamp,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start read in file system.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	read_started = 1;
+
+	if( mount_file_entry_get_size(
+	     file_entry,
+	     &file_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry size.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	if( (size64_t) offset >= file_size )
+	{
+		size = 0;
+	}
+	else if( (size64_t) size > ( file_size - (size64_t) offset ) )
+	{
+		size = (size_t) ( file_size - (size64_t) offset );
+	}
+	/* The buffer vector is freed by FUSE
+	 */
+	safe_buffer_vector = (struct fuse_bufvec *) memory_allocate(
+	                                             sizeof( struct fuse_bufvec ) + ( sizeof( struct fuse_buf ) * ( MOUNT_FUSE_MAXIMUM_NUMBER_OF_BUFFERS - 1 ) ) );
+
+	if( safe_buffer_vector == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer vector.",
+		 function );
+
+		result = -ENOMEM;
+
+		goto on_error;
+	}
+	if( memory_set(
+	     safe_buffer_vector,
+	     0,
+	     sizeof( struct fuse_bufvec ) + ( sizeof( struct fuse_buf ) * ( MOUNT_FUSE_MAXIMUM_NUMBER_OF_BUFFERS - 1 ) ) ) == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffer vector.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	while( read_size < size )
+	{
+		/* Make sure a buffer remains available for the data that is read
+		 * into memory once the buffer vector is almost full
+		 */
+		if( ( safe_buffer_vector->count + 2 ) >= MOUNT_FUSE_MAXIMUM_NUMBER_OF_BUFFERS )
+		{
+			if( pending_size == 0 )
+			{
+				pending_offset = (off64_t) offset + (off64_t) read_size;
+			}
+			pending_size += size - read_size;
+
+			break;
+		}
+		result = mount_file_entry_get_stored_run_at_offset(
+		          file_entry,
+		          (off64_t) offset + (off64_t) read_size,
+		          &run_size,
+		          &file_descriptor,
+		          &file_offset,
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stored run at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 (off64_t) offset + (off64_t) read_size,
+			 (off64_t) offset + (off64_t) read_size );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		/* Data without a run, such as the statistics, is read into memory
+		 */
+		if( ( run_size == 0 )
+		 || ( run_size > (size64_t) ( size - read_size ) ) )
+		{
+			run_size = (size64_t) ( size - read_size );
+		}
+		if( result == 0 )
+		{
+			if( pending_size == 0 )
+			{
+				pending_offset = (off64_t) offset + (off64_t) read_size;
+			}
+			pending_size += (size_t) run_size;
+		}
+		else
+		{
+			if( pending_size > 0 )
+			{
+				if( mount_fuse_append_memory_buffer(
+				     safe_buffer_vector,
+				     file_entry,
+				     pending_offset,
+				     pending_size,
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 pending_offset,
+					 pending_offset );
+
+					result = -EIO;
+
+					goto on_error;
+				}
+				pending_size = 0;
+			}
+			buffer_index = (uint32_t) safe_buffer_vector->count;
+
+			safe_buffer_vector->buf[ buffer_index ].size  = (size_t) run_size;
+			safe_buffer_vector->buf[ buffer_index ].flags = FUSE_BUF_IS_FD | FUSE_BUF_FD_SEEK;
+			safe_buffer_vector->buf[ buffer_index ].mem   = NULL;
+			safe_buffer_vector->buf[ buffer_index ].fd    = file_descriptor;
+			safe_buffer_vector->buf[ buffer_index ].pos   = (off_t) file_offset;
+
+			safe_buffer_vector->count += 1;
+
+			file_descriptor_read_size += (size_t) run_size;
+		}
+		read_size += (size_t) run_size;
+	}
+	if( pending_size > 0 )
+	{
+		if( mount_fuse_append_memory_buffer(
+		     safe_buffer_vector,
+		     file_entry,
+		     pending_offset,
+		     pending_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 pending_offset,
+			 pending_offset );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+	}
+	/* Memory buffers can contain less data than requested
+	 */
+	read_size = 0;
+
+	for( buffer_index = 0;
+	     buffer_index < (uint32_t) safe_buffer_vector->count;
+	     buffer_index++ )
+	{
+		read_size += safe_buffer_vector->buf[ buffer_index ].size;
+	}
+	read_started = 0;
+
+	if( mount_file_system_end_read(
+	     file_entry->file_system,
+	     start_timestamp,
+	     (ssize_t) read_size,
+	     file_descriptor_read_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to end read in file system.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	*buffer_vector = safe_buffer_vector;
+
+	return( 0 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_started != 0 )
+	{
+		mount_file_system_end_read(
+		 file_entry->file_system,
+		 start_timestamp,
+		 -1,
+		 0,
+		 NULL );
+	}
+	if( safe_buffer_vector != NULL )
+	{
+		for( buffer_index = 0;
+		     buffer_index < (uint32_t) safe_buffer_vector->count;
+		     buffer_index++ )
+		{
+			if( ( safe_buffer_vector->buf[ buffer_index ].flags & FUSE_BUF_IS_FD ) == 0 )
+			{
+				memory_free(
+				 safe_buffer_vector->buf[ buffer_index ].mem );
+			}
+		}
+		memory_free(
+		 safe_buffer_vector );
+	}
+	return( result );
+}
+
+#endif /* defined( MOUNT_FUSE_HAVE_READ_BUF ) */
+
+#if defined( MOUNT_FUSE_HAVE_LSEEK )
+
+/* Repositions the offset of a file entry to the next data or hole
+ * Only SEEK_DATA and SEEK_HOLE are supported, the kernel handles the other values of whence
+ * Returns the resulting offset if successful or a negative errno value otherwise
+ */
+off_t mount_fuse_lseek(
+       const char *path,
+       off_t offset,
+       int whence,
+       struct fuse_file_info *file_info )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "mount_fuse_lseek";
+	off64_t next_offset      = 0;
+	int result               = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: %s\n",
+		 function,
+		 path );
+	}
+#endif
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( ( whence != SEEK_DATA )
+	 && ( whence != SEEK_HOLE ) )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file information.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info->fh == (uint64_t) NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file information - missing file handle.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	result = mount_file_entry_get_next_data_or_hole_offset(
+	          (mount_file_entry_t *) file_info->fh,
+	          (off64_t) offset,
+	          (uint8_t) ( whence == SEEK_HOLE ),
+	          &next_offset,
+	          &error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve next data or hole offset.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( -ENXIO );
+	}
+	return( (off_t) next_offset );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( (off_t) result );
+}
+
+#endif /* defined( MOUNT_FUSE_HAVE_LSEEK ) */
+
 /* Releases a file entry
  * Returns 0 if successful or a negative errno value otherwise
  */
@@ -1108,6 +1788,7 @@ int mount_fuse_getattr(
 	libcerror_error_t *error       = NULL;
 	mount_file_entry_t *file_entry = NULL;
 	static char *function          = "mount_fuse_getattr";
+	size64_t allocated_size        = 0;
 	size64_t file_size             = 0;
 	uint64_t access_time           = 0;
 	uint64_t inode_change_time     = 0;
@@ -1210,6 +1891,22 @@ int mount_fuse_getattr(
 
 		goto on_error;
 	}
+	if( mount_file_entry_get_allocated_size(
+	     file_entry,
+	     &allocated_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry allocated size.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
 	if( mount_file_entry_get_file_mode(
 	     file_entry,
 	     &file_mode,
@@ -1277,6 +1974,7 @@ int mount_fuse_getattr(
 	if( mount_fuse_set_stat_info(
 	     stat_info,
 	     file_size,
+	     allocated_size,
 	     file_mode,
 	     (int64_t) access_time,
 	     (int64_t) inode_change_time,
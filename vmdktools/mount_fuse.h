@@ -47,6 +47,18 @@
 #include <osxfuse/fuse.h>
 #endif
 
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+/* The lseek operation was added in FUSE 3.8
+ */
+#if defined( HAVE_LIBFUSE3 ) && defined( SEEK_DATA ) && defined( SEEK_HOLE ) && defined( FUSE_MAKE_VERSION )
+#if FUSE_VERSION >= FUSE_MAKE_VERSION( 3, 8 )
+#define MOUNT_FUSE_HAVE_LSEEK
+#endif
+#endif
+
 #endif /* defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE ) */
 
 #include "mount_file_entry.h"
@@ -54,6 +66,14 @@
 #include "vmdktools_libcerror.h"
 #include "vmdktools_libvmdk.h"
 
+/* The read_buf operation was added in FUSE 2.9
+ */
+#if defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS ) && defined( FUSE_MAKE_VERSION )
+#if defined( HAVE_LIBFUSE3 ) || ( defined( HAVE_LIBFUSE ) && ( FUSE_VERSION >= FUSE_MAKE_VERSION( 2, 9 ) ) )
+#define MOUNT_FUSE_HAVE_READ_BUF
+#endif
+#endif
+
 #if defined( __cplusplus )
 extern "C" {
 #endif
@@ -77,6 +97,7 @@ typedef struct stat mount_fuse_stat_t;
 int mount_fuse_set_stat_info(
      mount_fuse_stat_t *stat_info,
      size64_t size,
+     size64_t allocated_size,
      uint16_t file_mode,
      int64_t access_time,
      int64_t inode_change_time,
@@ -102,6 +123,36 @@ int mount_fuse_read(
      off_t offset,
      struct fuse_file_info *file_info );
 
+#if defined( MOUNT_FUSE_HAVE_READ_BUF )
+
+/* The maximum number of buffers in the buffer vector of a read request
+ */
+#define MOUNT_FUSE_MAXIMUM_NUMBER_OF_BUFFERS	16
+
+int mount_fuse_append_memory_buffer(
+     struct fuse_bufvec *buffer_vector,
+     mount_file_entry_t *file_entry,
+     off64_t offset,
+     size_t size,
+     libcerror_error_t **error );
+
+int mount_fuse_read_buf(
+     const char *path,
+     struct fuse_bufvec **buffer_vector,
+     size_t size,
+     off_t offset,
+     struct fuse_file_info *file_info );
+
+#endif /* defined( MOUNT_FUSE_HAVE_READ_BUF ) */
+
+#if defined( MOUNT_FUSE_HAVE_LSEEK )
+off_t mount_fuse_lseek(
+       const char *path,
+       off_t offset,
+       int whence,
+       struct fuse_file_info *file_info );
+#endif
+
 int mount_fuse_release(
      const char *path,
      struct fuse_file_info *file_info );
@@ -26,6 +26,14 @@
 #include <types.h>
 #include <wide_string.h>
 
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
 #include "mount_file_entry.h"
 #include "mount_file_system.h"
 #include "mount_handle.h"
@@ -356,6 +364,46 @@ int mount_handle_set_path_prefix(
 	return( 1 );
 }
 
+/* Sets the number of reader handles
+ * The reader handles are used to serve concurrent reads of the image
+ * The number of reader handles is limited to MOUNT_HANDLE_MAXIMUM_NUMBER_OF_READERS
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_number_of_readers(
+     mount_handle_t *mount_handle,
+     int number_of_readers,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_number_of_readers";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_readers < 0 )
+	 || ( number_of_readers > MOUNT_HANDLE_MAXIMUM_NUMBER_OF_READERS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of readers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	mount_handle->number_of_readers = number_of_readers;
+
+	return( 1 );
+}
+
 /* Opens the mount handle
  * Returns 1 if successful, 0 if not or -1 on error
  */
@@ -365,14 +413,16 @@ int mount_handle_open(
      int number_of_filenames,
      libcerror_error_t **error )
 {
-	libvmdk_handle_t *vmdk_handle      = NULL;
-	system_character_t *basename_end   = NULL;
-	static char *function              = "mount_handle_open";
-	size_t basename_length             = 0;
-	size_t filename_length             = 0;
-	uint32_t parent_content_identifier = 0;
-	int disk_type                      = 0;
-	int result                         = 0;
+	libvmdk_handle_t *parent_vmdk_handle = NULL;
+	libvmdk_handle_t *vmdk_handle        = NULL;
+	system_character_t *basename_end     = NULL;
+	static char *function                = "mount_handle_open";
+	size_t basename_length               = 0;
+	size_t filename_length               = 0;
+	uint32_t parent_content_identifier   = 0;
+	int disk_type                        = 0;
+	int number_of_handles                = 0;
+	int result                           = 0;
 
 	if( mount_handle == NULL )
 	{
@@ -450,6 +500,21 @@ int mount_handle_open(
 
 		goto on_error;
 	}
+	if( mount_file_system_set_shared_cache_of_handle(
+	     mount_handle->file_system,
+	     vmdk_handle,
+	     vmdk_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set shared cache of handle.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	result = libvmdk_handle_open_wide(
 	          vmdk_handle,
@@ -600,6 +665,41 @@ int mount_handle_open(
 
 		goto on_error;
 	}
+	/* The parent handles are appended to the file system before the handle
+	 * hence the last handle is the parent handle if there is one
+	 */
+	if( mount_file_system_get_number_of_handles(
+	     mount_handle->file_system,
+	     &number_of_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_handles > 0 )
+	{
+		if( mount_file_system_get_handle_by_index(
+		     mount_handle->file_system,
+		     number_of_handles - 1,
+		     &parent_vmdk_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( mount_file_system_append_handle(
 	     mount_handle->file_system,
 	     vmdk_handle,
@@ -614,6 +714,51 @@ int mount_handle_open(
 
 		goto on_error;
 	}
+#if defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS )
+	if( mount_handle_open_extent_file_descriptors(
+	     mount_handle,
+	     vmdk_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		/* The handle is owned by the file system
+		 */
+		vmdk_handle = NULL;
+
+		goto on_error;
+	}
+#endif
+	if( mount_handle->number_of_readers > 1 )
+	{
+		/* The handle is owned by the file system from here on
+		 */
+		result = mount_handle_open_readers(
+		          mount_handle,
+		          filenames[ 0 ],
+		          vmdk_handle,
+		          parent_vmdk_handle,
+		          error );
+
+		vmdk_handle = NULL;
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open reader handles.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
@@ -787,6 +932,21 @@ int mount_handle_open_parent(
 
 		goto on_error;
 	}
+	if( mount_file_system_set_shared_cache_of_handle(
+	     mount_handle->file_system,
+	     parent_vmdk_handle,
+	     parent_vmdk_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set shared cache of parent handle.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libvmdk_handle_open_wide(
 	     parent_vmdk_handle,
@@ -969,6 +1129,28 @@ int mount_handle_open_parent(
 
 		goto on_error;
 	}
+#if defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS )
+	/* The parent handle is owned by the file system from here on
+	 */
+	result = mount_handle_open_extent_file_descriptors(
+	          mount_handle,
+	          parent_vmdk_handle,
+	          error );
+
+	parent_vmdk_handle = NULL;
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files of parent handle.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
@@ -992,6 +1174,534 @@ on_error:
 	return( -1 );
 }
 
+#if defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS )
+
+/* Opens the extent data files of a handle for direct access
+ * An extent data file that cannot be opened is skipped, in which case
+ * its data is read by the library instead
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_open_extent_file_descriptors(
+     mount_handle_t *mount_handle,
+     libvmdk_handle_t *vmdk_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_extent_descriptor_t *extent_descriptor = NULL;
+	char *extent_filename                          = NULL;
+	char *extent_path                              = NULL;
+	char *filename                                 = NULL;
+	int *extent_file_descriptors                   = NULL;
+	static char *function                          = "mount_handle_open_extent_file_descriptors";
+	size_t extent_filename_size                    = 0;
+	size_t extent_path_size                        = 0;
+	size_t filename_size                           = 0;
+	int extent_index                               = 0;
+	int extent_type                                = 0;
+	int number_of_extents                          = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_number_of_extents(
+	     vmdk_handle,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_extents <= 0 )
+	{
+		return( 1 );
+	}
+	if( (size_t) number_of_extents > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( int ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of extents value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	extent_file_descriptors = (int *) memory_allocate(
+	                                   sizeof( int ) * number_of_extents );
+
+	if( extent_file_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create extent file descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		extent_file_descriptors[ extent_index ] = -1;
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( libvmdk_handle_get_extent_descriptor(
+		     vmdk_handle,
+		     extent_index,
+		     &extent_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent descriptor: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libvmdk_extent_descriptor_get_type(
+		     extent_descriptor,
+		     &extent_type,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d type.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( ( extent_type == LIBVMDK_EXTENT_TYPE_FLAT )
+		 || ( extent_type == LIBVMDK_EXTENT_TYPE_SPARSE )
+		 || ( extent_type == LIBVMDK_EXTENT_TYPE_VMFS_FLAT )
+		 || ( extent_type == LIBVMDK_EXTENT_TYPE_VMFS_SPARSE ) )
+		{
+			if( libvmdk_extent_descriptor_get_utf8_filename_size(
+			     extent_descriptor,
+			     &extent_filename_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve extent: %d filename size.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+			if( ( extent_filename_size <= 1 )
+			 || ( extent_filename_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid extent: %d filename size value out of bounds.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+			extent_filename = narrow_string_allocate(
+			                   extent_filename_size );
+
+			if( extent_filename == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create extent filename.",
+				 function );
+
+				goto on_error;
+			}
+			if( libvmdk_extent_descriptor_get_utf8_filename(
+			     extent_descriptor,
+			     (uint8_t *) extent_filename,
+			     extent_filename_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve extent: %d filename.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+			/* Ignore the directory of the extent filename, like the library does
+			 */
+			filename = narrow_string_search_character_reverse(
+			            extent_filename,
+			            (int) LIBCPATH_SEPARATOR,
+			            extent_filename_size );
+
+			if( filename != NULL )
+			{
+				filename += 1;
+			}
+			else
+			{
+				filename = extent_filename;
+			}
+			filename_size = extent_filename_size - (size_t) ( filename - extent_filename );
+
+			if( mount_handle->basename == NULL )
+			{
+				extent_path      = filename;
+				extent_path_size = filename_size;
+			}
+			else if( libcpath_path_join(
+			          &extent_path,
+			          &extent_path_size,
+			          mount_handle->basename,
+			          mount_handle->basename_size - 1,
+			          filename,
+			          filename_size - 1,
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create extent: %d path.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+			/* If the extent data file cannot be opened its data is read by the library
+			 */
+			extent_file_descriptors[ extent_index ] = open(
+			                                           extent_path,
+			                                           O_RDONLY );
+
+			if( mount_handle->basename != NULL )
+			{
+				memory_free(
+				 extent_path );
+			}
+			extent_path = NULL;
+
+			memory_free(
+			 extent_filename );
+
+			extent_filename = NULL;
+		}
+		if( libvmdk_extent_descriptor_free(
+		     &extent_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free extent descriptor: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+	}
+	if( mount_file_system_set_extent_file_descriptors(
+	     mount_handle->file_system,
+	     vmdk_handle,
+	     extent_file_descriptors,
+	     number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set extent file descriptors in file system.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( ( extent_path != NULL )
+	 && ( mount_handle->basename != NULL ) )
+	{
+		memory_free(
+		 extent_path );
+	}
+	if( extent_filename != NULL )
+	{
+		memory_free(
+		 extent_filename );
+	}
+	if( extent_descriptor != NULL )
+	{
+		libvmdk_extent_descriptor_free(
+		 &extent_descriptor,
+		 NULL );
+	}
+	if( extent_file_descriptors != NULL )
+	{
+		for( extent_index = 0;
+		     extent_index < number_of_extents;
+		     extent_index++ )
+		{
+			if( extent_file_descriptors[ extent_index ] != -1 )
+			{
+				close(
+				 extent_file_descriptors[ extent_index ] );
+			}
+		}
+		memory_free(
+		 extent_file_descriptors );
+	}
+	return( -1 );
+}
+
+#endif /* defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS ) */
+
+/* Opens the reader handles
+ * The reader handles are additional handles of the same image that share
+ * the parent handle, so that reads of different parts of the image can be
+ * served concurrently. Reads of the shared parent handle are serialized by
+ * the lock of the parent handle
+ *
+ * Every additional reader handle parses the descriptor and grain directories
+ * and opens the extent data files of the image again, only the grain data is
+ * shared through the shared cache. Hence the number of additional reader handles
+ * is limited so that they open at most MOUNT_HANDLE_MAXIMUM_NUMBER_OF_READER_EXTENT_FILES
+ * extent data files together
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_open_readers(
+     mount_handle_t *mount_handle,
+     const system_character_t *filename,
+     libvmdk_handle_t *vmdk_handle,
+     libvmdk_handle_t *parent_vmdk_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *reader_handle = NULL;
+	static char *function           = "mount_handle_open_readers";
+	int number_of_extents           = 0;
+	int number_of_readers           = 0;
+	int reader_index                = 0;
+	int result                      = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( vmdk_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_number_of_extents(
+	     vmdk_handle,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_readers = mount_handle->number_of_readers;
+
+	if( ( number_of_extents > 0 )
+	 && ( ( number_of_readers - 1 ) > ( MOUNT_HANDLE_MAXIMUM_NUMBER_OF_READER_EXTENT_FILES / number_of_extents ) ) )
+	{
+		number_of_readers = 1 + ( MOUNT_HANDLE_MAXIMUM_NUMBER_OF_READER_EXTENT_FILES / number_of_extents );
+	}
+	if( mount_file_system_append_reader_handle(
+	     mount_handle->file_system,
+	     vmdk_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append handle to reader handles.",
+		 function );
+
+		goto on_error;
+	}
+	for( reader_index = 1;
+	     reader_index < number_of_readers;
+	     reader_index++ )
+	{
+		if( libvmdk_handle_initialize(
+		     &reader_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize reader handle: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		if( mount_file_system_set_shared_cache_of_handle(
+		     mount_handle->file_system,
+		     reader_handle,
+		     vmdk_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set shared cache of reader handle: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libvmdk_handle_open_wide(
+		          reader_handle,
+		          filename,
+		          LIBVMDK_OPEN_READ,
+		          error );
+#else
+		result = libvmdk_handle_open(
+		          reader_handle,
+		          filename,
+		          LIBVMDK_OPEN_READ,
+		          error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open reader handle: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		if( parent_vmdk_handle != NULL )
+		{
+			if( libvmdk_handle_set_parent_handle(
+			     reader_handle,
+			     parent_vmdk_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set parent handle of reader handle: %d.",
+				 function,
+				 reader_index );
+
+				goto on_error;
+			}
+		}
+		if( libvmdk_handle_open_extent_data_files(
+		     reader_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open extent data files of reader handle: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		if( mount_file_system_append_reader_handle(
+		     mount_handle->file_system,
+		     reader_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append reader handle: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		reader_handle = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( reader_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &reader_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Closes the mount handle
  * Returns the 0 if successful or -1 on error
  */
@@ -1003,6 +1713,7 @@ int mount_handle_close(
 	static char *function         = "mount_handle_close";
 	int handle_index              = 0;
 	int number_of_handles         = 0;
+	int number_of_reader_handles  = 0;
 	int result                    = 0;
 
 	if( mount_handle == NULL )
@@ -1016,6 +1727,71 @@ int mount_handle_close(
 
 		return( -1 );
 	}
+	if( mount_file_system_get_number_of_reader_handles(
+	     mount_handle->file_system,
+	     &number_of_reader_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of reader handles.",
+		 function );
+
+		return( -1 );
+	}
+	/* The first reader handle is one of the handles of the file system
+	 */
+	for( handle_index = number_of_reader_handles - 1;
+	     handle_index > 0;
+	     handle_index-- )
+	{
+		if( mount_file_system_get_reader_handle_by_index(
+		     mount_handle->file_system,
+		     handle_index,
+		     &vmdk_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reader handle: %d.",
+			 function,
+			 handle_index );
+
+			result = -1;
+		}
+		if( libvmdk_handle_close(
+		     vmdk_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close reader handle: %d.",
+			 function,
+			 handle_index );
+
+			result = -1;
+		}
+		if( libvmdk_handle_free(
+		     &vmdk_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reader handle: %d.",
+			 function,
+			 handle_index );
+
+			result = -1;
+		}
+	}
 	if( mount_file_system_get_number_of_handles(
 	     mount_handle->file_system,
 	     &number_of_handles,
@@ -1162,6 +1938,39 @@ int mount_handle_get_file_entry_by_path(
 		filename        = &( path[ path_index + 1 ] );
 		filename_length = path_length - ( path_index + 1 );
 	}
+	if( ( path_index == 0 )
+	 && ( filename_length == MOUNT_FILE_SYSTEM_STATISTICS_NAME_LENGTH ) )
+	{
+#if defined( WINAPI )
+		result = system_string_compare_no_case(
+		          filename,
+		          _SYSTEM_STRING( MOUNT_FILE_SYSTEM_STATISTICS_NAME ),
+		          MOUNT_FILE_SYSTEM_STATISTICS_NAME_LENGTH );
+#else
+		result = system_string_compare(
+		          filename,
+		          _SYSTEM_STRING( MOUNT_FILE_SYSTEM_STATISTICS_NAME ),
+		          MOUNT_FILE_SYSTEM_STATISTICS_NAME_LENGTH );
+#endif
+		if( result == 0 )
+		{
+			if( mount_file_entry_initialize_statistics(
+			     file_entry,
+			     mount_handle->file_system,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize statistics file entry.",
+				 function );
+
+				goto on_error;
+			}
+			return( 1 );
+		}
+	}
 	result = mount_file_system_get_handle_by_path(
 	          mount_handle->file_system,
 	          path,
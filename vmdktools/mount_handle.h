@@ -35,6 +35,21 @@
 extern "C" {
 #endif
 
+/* The default number of reader handles used to serve concurrent reads
+ */
+#define MOUNT_HANDLE_DEFAULT_NUMBER_OF_READERS	8
+
+/* The maximum number of reader handles
+ * Every reader handle parses the descriptor and grain directories and opens
+ * the extent data files of the image again
+ */
+#define MOUNT_HANDLE_MAXIMUM_NUMBER_OF_READERS	16
+
+/* The maximum number of extent data files the additional reader handles
+ * open together, fewer reader handles are opened for images with many extents
+ */
+#define MOUNT_HANDLE_MAXIMUM_NUMBER_OF_READER_EXTENT_FILES	256
+
 typedef struct mount_handle mount_handle_t;
 
 struct mount_handle
@@ -51,6 +66,10 @@ struct mount_handle
 	 */
 	mount_file_system_t *file_system;
 
+	/* The number of reader handles
+	 */
+	int number_of_readers;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -80,6 +99,11 @@ int mount_handle_set_path_prefix(
      size_t path_prefix_size,
      libcerror_error_t **error );
 
+int mount_handle_set_number_of_readers(
+     mount_handle_t *mount_handle,
+     int number_of_readers,
+     libcerror_error_t **error );
+
 int mount_handle_open(
      mount_handle_t *mount_handle,
      system_character_t * const * filenames,
@@ -91,6 +115,22 @@ int mount_handle_open_parent(
      libvmdk_handle_t *vmdk_handle,
      libcerror_error_t **error );
 
+#if defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS )
+
+int mount_handle_open_extent_file_descriptors(
+     mount_handle_t *mount_handle,
+     libvmdk_handle_t *vmdk_handle,
+     libcerror_error_t **error );
+
+#endif /* defined( MOUNT_FILE_SYSTEM_HAVE_EXTENT_FILE_DESCRIPTORS ) */
+
+int mount_handle_open_readers(
+     mount_handle_t *mount_handle,
+     const system_character_t *filename,
+     libvmdk_handle_t *vmdk_handle,
+     libvmdk_handle_t *parent_vmdk_handle,
+     libcerror_error_t **error );
+
 int mount_handle_close(
      mount_handle_t *mount_handle,
      libcerror_error_t **error );
@@ -0,0 +1,2397 @@
+/*
+ * Network Block Device (NBD) connection
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "nbd_connection.h"
+#include "serve_handle.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libcnotify.h"
+
+#if defined( SERVE_HANDLE_HAVE_SOCKETS )
+#include <sys/socket.h>
+#endif
+
+/* Do not raise SIGPIPE when the client has closed the connection
+ */
+#if defined( SERVE_HANDLE_HAVE_SOCKETS ) && defined( MSG_NOSIGNAL )
+#define NBD_CONNECTION_SEND_FLAGS	MSG_NOSIGNAL
+#else
+#define NBD_CONNECTION_SEND_FLAGS	0
+#endif
+
+/* Creates a connection
+ * Make sure the value nbd_connection is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_initialize(
+     nbd_connection_t **nbd_connection,
+     serve_handle_t *serve_handle,
+     int socket_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_initialize";
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_connection != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid connection value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( socket_descriptor < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid socket descriptor value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	*nbd_connection = memory_allocate_structure(
+	                   nbd_connection_t );
+
+	if( *nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create connection.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *nbd_connection,
+	     0,
+	     sizeof( nbd_connection_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear connection.",
+		 function );
+
+		goto on_error;
+	}
+	( *nbd_connection )->serve_handle      = serve_handle;
+	( *nbd_connection )->socket_descriptor = socket_descriptor;
+
+	return( 1 );
+
+on_error:
+	if( *nbd_connection != NULL )
+	{
+		memory_free(
+		 *nbd_connection );
+
+		*nbd_connection = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a connection
+ * The socket descriptor is not closed
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_free(
+     nbd_connection_t **nbd_connection,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_free";
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_connection != NULL )
+	{
+		if( ( *nbd_connection )->buffer != NULL )
+		{
+			memory_free(
+			 ( *nbd_connection )->buffer );
+		}
+		memory_free(
+		 *nbd_connection );
+
+		*nbd_connection = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads data from the connection
+ * Returns 1 if successful, 0 if the connection was closed before any data was read or -1 on error
+ */
+int nbd_connection_read_data(
+     nbd_connection_t *nbd_connection,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_read_data";
+	size_t data_offset    = 0;
+	ssize_t read_count    = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+#if defined( SERVE_HANDLE_HAVE_SOCKETS )
+		read_count = recv(
+		              nbd_connection->socket_descriptor,
+		              &( data[ data_offset ] ),
+		              data_size - data_offset,
+		              0 );
+#else
+		read_count = read(
+		              nbd_connection->socket_descriptor,
+		              &( data[ data_offset ] ),
+		              data_size - data_offset );
+#endif
+		if( read_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read data.",
+			 function );
+
+			return( -1 );
+		}
+		else if( read_count == 0 )
+		{
+			if( data_offset == 0 )
+			{
+				return( 0 );
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: connection closed while reading data.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += (size_t) read_count;
+	}
+	return( 1 );
+}
+
+/* Writes data to the connection
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_data(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_write_data";
+	size_t data_offset    = 0;
+	ssize_t write_count   = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data == NULL )
+	 && ( data_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+#if defined( SERVE_HANDLE_HAVE_SOCKETS )
+		write_count = send(
+		               nbd_connection->socket_descriptor,
+		               &( data[ data_offset ] ),
+		               data_size - data_offset,
+		               NBD_CONNECTION_SEND_FLAGS );
+#else
+		write_count = write(
+		               nbd_connection->socket_descriptor,
+		               &( data[ data_offset ] ),
+		               data_size - data_offset );
+#endif
+		if( write_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to write data.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += (size_t) write_count;
+	}
+	return( 1 );
+}
+
+/* Reads and discards data from the connection
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_skip_data(
+     nbd_connection_t *nbd_connection,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t skip_buffer[ 4096 ];
+
+	static char *function = "nbd_connection_skip_data";
+	size_t read_size      = 0;
+
+	while( data_size > 0 )
+	{
+		read_size = sizeof( skip_buffer );
+
+		if( read_size > data_size )
+		{
+			read_size = data_size;
+		}
+		if( nbd_connection_read_data(
+		     nbd_connection,
+		     skip_buffer,
+		     read_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data.",
+			 function );
+
+			return( -1 );
+		}
+		data_size -= read_size;
+	}
+	return( 1 );
+}
+
+/* Resizes the data buffer if it is smaller than the buffer size
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_resize_buffer(
+     nbd_connection_t *nbd_connection,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	uint8_t *reallocation = NULL;
+	static char *function = "nbd_connection_resize_buffer";
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size <= nbd_connection->buffer_size )
+	{
+		return( 1 );
+	}
+	reallocation = (uint8_t *) memory_reallocate(
+	                            nbd_connection->buffer,
+	                            sizeof( uint8_t ) * buffer_size );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize buffer.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_connection->buffer      = reallocation;
+	nbd_connection->buffer_size = buffer_size;
+
+	return( 1 );
+}
+
+/* Writes an option reply
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_option_reply(
+     nbd_connection_t *nbd_connection,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 20 ];
+
+	static char *function = "nbd_connection_write_option_reply";
+
+	if( data_size > (size_t) NBD_CONNECTION_MAXIMUM_OPTION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_header[ 0 ] ),
+	 NBD_CONNECTION_OPTION_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 8 ] ),
+	 option );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 12 ] ),
+	 reply_type );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 16 ] ),
+	 (uint32_t) data_size );
+
+	if( nbd_connection_write_data(
+	     nbd_connection,
+	     reply_header,
+	     20,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write option reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_connection_write_data(
+		     nbd_connection,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write option reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes the export information in reply to the info and go options
+ * Returns 1 if successful, 0 if the option data is invalid or -1 on error
+ */
+int nbd_connection_write_export_information(
+     nbd_connection_t *nbd_connection,
+     uint32_t option,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t information_data[ 14 ];
+
+	static char *function                = "nbd_connection_write_export_information";
+	size64_t media_size                  = 0;
+	size_t data_offset                   = 0;
+	uint32_t name_length                 = 0;
+	uint16_t information_type            = 0;
+	uint16_t number_of_information_types = 0;
+	uint16_t transmission_flags          = 0;
+	uint8_t send_block_size              = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data == NULL )
+	 && ( data_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	/* The option data consists of the export name followed by the requested information types
+	 */
+	if( data_size >= 6 )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 data,
+		 name_length );
+
+		if( (size_t) name_length <= ( data_size - 6 ) )
+		{
+			data_offset = 4 + (size_t) name_length;
+
+			byte_stream_copy_to_uint16_big_endian(
+			 &( data[ data_offset ] ),
+			 number_of_information_types );
+
+			data_offset += 2;
+		}
+	}
+	if( ( data_offset == 0 )
+	 || ( ( data_size - data_offset ) != ( 2 * (size_t) number_of_information_types ) ) )
+	{
+		if( nbd_connection_write_option_reply(
+		     nbd_connection,
+		     option,
+		     NBD_CONNECTION_REPLY_ERROR_INVALID,
+		     NULL,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write option reply.",
+			 function );
+
+			return( -1 );
+		}
+		return( 0 );
+	}
+	while( data_offset < data_size )
+	{
+		byte_stream_copy_to_uint16_big_endian(
+		 &( data[ data_offset ] ),
+		 information_type );
+
+		if( information_type == NBD_CONNECTION_INFO_BLOCK_SIZE )
+		{
+			send_block_size = 1;
+		}
+		data_offset += 2;
+	}
+	if( serve_handle_get_media_size(
+	     nbd_connection->serve_handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	transmission_flags = NBD_CONNECTION_FLAG_HAS_FLAGS
+	                   | NBD_CONNECTION_FLAG_READ_ONLY
+	                   | NBD_CONNECTION_FLAG_SEND_FLUSH
+	                   | NBD_CONNECTION_FLAG_CAN_MULTI_CONN;
+
+	if( nbd_connection->use_structured_replies != 0 )
+	{
+		transmission_flags |= NBD_CONNECTION_FLAG_SEND_DF;
+	}
+	byte_stream_copy_from_uint16_big_endian(
+	 &( information_data[ 0 ] ),
+	 NBD_CONNECTION_INFO_EXPORT );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( information_data[ 2 ] ),
+	 media_size );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( information_data[ 10 ] ),
+	 transmission_flags );
+
+	if( nbd_connection_write_option_reply(
+	     nbd_connection,
+	     option,
+	     NBD_CONNECTION_REPLY_INFO,
+	     information_data,
+	     12,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write export information.",
+		 function );
+
+		return( -1 );
+	}
+	if( send_block_size != 0 )
+	{
+		byte_stream_copy_from_uint16_big_endian(
+		 &( information_data[ 0 ] ),
+		 NBD_CONNECTION_INFO_BLOCK_SIZE );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( information_data[ 2 ] ),
+		 1 );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( information_data[ 6 ] ),
+		 NBD_CONNECTION_PREFERRED_REQUEST_SIZE );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( information_data[ 10 ] ),
+		 NBD_CONNECTION_MAXIMUM_REQUEST_SIZE );
+
+		if( nbd_connection_write_option_reply(
+		     nbd_connection,
+		     option,
+		     NBD_CONNECTION_REPLY_INFO,
+		     information_data,
+		     14,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write block size information.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( nbd_connection_write_option_reply(
+	     nbd_connection,
+	     option,
+	     NBD_CONNECTION_REPLY_ACK,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write option reply.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes the meta contexts in reply to the list and set meta context options
+ * The only meta context supported is base:allocation
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_meta_contexts(
+     nbd_connection_t *nbd_connection,
+     uint32_t option,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t meta_context_data[ 4 + NBD_CONNECTION_BASE_ALLOCATION_LENGTH ];
+
+	static char *function      = "nbd_connection_write_meta_contexts";
+	size_t data_offset         = 0;
+	uint32_t name_length       = 0;
+	uint32_t number_of_queries = 0;
+	uint32_t query_index       = 0;
+	uint32_t query_length      = 0;
+	uint8_t is_valid           = 0;
+	uint8_t has_match          = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data == NULL )
+	 && ( data_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	/* The option data consists of the export name followed by the queries
+	 */
+	if( data_size >= 8 )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 data,
+		 name_length );
+
+		if( (size_t) name_length <= ( data_size - 8 ) )
+		{
+			data_offset = 4 + (size_t) name_length;
+
+			byte_stream_copy_to_uint32_big_endian(
+			 &( data[ data_offset ] ),
+			 number_of_queries );
+
+			data_offset += 4;
+			is_valid     = 1;
+		}
+	}
+	for( query_index = 0;
+	     ( is_valid != 0 ) && ( query_index < number_of_queries );
+	     query_index++ )
+	{
+		if( ( data_size - data_offset ) < 4 )
+		{
+			is_valid = 0;
+
+			break;
+		}
+		byte_stream_copy_to_uint32_big_endian(
+		 &( data[ data_offset ] ),
+		 query_length );
+
+		data_offset += 4;
+
+		if( (size_t) query_length > ( data_size - data_offset ) )
+		{
+			is_valid = 0;
+
+			break;
+		}
+		data_offset += (size_t) query_length;
+	}
+	if( data_offset != data_size )
+	{
+		is_valid = 0;
+	}
+	/* Selecting a meta context requires structured replies
+	 */
+	if( ( option == NBD_CONNECTION_OPTION_SET_META_CONTEXT )
+	 && ( nbd_connection->use_structured_replies == 0 ) )
+	{
+		is_valid = 0;
+	}
+	if( is_valid == 0 )
+	{
+		if( nbd_connection_write_option_reply(
+		     nbd_connection,
+		     option,
+		     NBD_CONNECTION_REPLY_ERROR_INVALID,
+		     NULL,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write option reply.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( option == NBD_CONNECTION_OPTION_SET_META_CONTEXT )
+	{
+		nbd_connection->use_base_allocation = 0;
+	}
+	/* Listing without queries returns all meta contexts
+	 */
+	if( ( option == NBD_CONNECTION_OPTION_LIST_META_CONTEXT )
+	 && ( number_of_queries == 0 ) )
+	{
+		has_match = 1;
+	}
+	data_offset = 8 + (size_t) name_length;
+
+	for( query_index = 0;
+	     query_index < number_of_queries;
+	     query_index++ )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 &( data[ data_offset ] ),
+		 query_length );
+
+		data_offset += 4;
+
+		if( ( query_length == NBD_CONNECTION_BASE_ALLOCATION_LENGTH )
+		 && ( narrow_string_compare(
+		       (char *) &( data[ data_offset ] ),
+		       NBD_CONNECTION_BASE_ALLOCATION,
+		       NBD_CONNECTION_BASE_ALLOCATION_LENGTH ) == 0 ) )
+		{
+			has_match = 1;
+		}
+		/* Listing the "base:" namespace returns all its meta contexts
+		 */
+		else if( ( option == NBD_CONNECTION_OPTION_LIST_META_CONTEXT )
+		      && ( query_length == 5 )
+		      && ( narrow_string_compare(
+		            (char *) &( data[ data_offset ] ),
+		            "base:",
+		            5 ) == 0 ) )
+		{
+			has_match = 1;
+		}
+		data_offset += (size_t) query_length;
+	}
+	if( has_match != 0 )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( meta_context_data[ 0 ] ),
+		 NBD_CONNECTION_BASE_ALLOCATION_IDENTIFIER );
+
+		if( memory_copy(
+		     &( meta_context_data[ 4 ] ),
+		     NBD_CONNECTION_BASE_ALLOCATION,
+		     NBD_CONNECTION_BASE_ALLOCATION_LENGTH ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy meta context name.",
+			 function );
+
+			return( -1 );
+		}
+		if( nbd_connection_write_option_reply(
+		     nbd_connection,
+		     option,
+		     NBD_CONNECTION_REPLY_META_CONTEXT,
+		     meta_context_data,
+		     4 + NBD_CONNECTION_BASE_ALLOCATION_LENGTH,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write meta context.",
+			 function );
+
+			return( -1 );
+		}
+		if( option == NBD_CONNECTION_OPTION_SET_META_CONTEXT )
+		{
+			nbd_connection->use_base_allocation = 1;
+		}
+	}
+	if( nbd_connection_write_option_reply(
+	     nbd_connection,
+	     option,
+	     NBD_CONNECTION_REPLY_ACK,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write option reply.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Negotiates the options of the connection using the fixed newstyle handshake
+ * Returns 1 if the transmission phase was entered, 0 if the client ended the negotiation or -1 on error
+ */
+int nbd_connection_negotiate(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error )
+{
+	uint8_t export_information[ 134 ];
+	uint8_t handshake_data[ 18 ];
+	uint8_t option_header[ 16 ];
+
+	static char *function          = "nbd_connection_negotiate";
+	size64_t media_size            = 0;
+	size_t export_information_size = 0;
+	uint64_t option_magic          = 0;
+	uint32_t client_flags          = 0;
+	uint32_t option                = 0;
+	uint32_t option_data_size      = 0;
+	uint16_t transmission_flags    = 0;
+	int result                     = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( handshake_data[ 0 ] ),
+	 NBD_CONNECTION_SERVER_MAGIC );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( handshake_data[ 8 ] ),
+	 NBD_CONNECTION_OPTION_MAGIC );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( handshake_data[ 16 ] ),
+	 NBD_CONNECTION_FLAG_FIXED_NEWSTYLE | NBD_CONNECTION_FLAG_NO_ZEROES );
+
+	if( nbd_connection_write_data(
+	     nbd_connection,
+	     handshake_data,
+	     18,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write handshake.",
+		 function );
+
+		return( -1 );
+	}
+	result = nbd_connection_read_data(
+	          nbd_connection,
+	          handshake_data,
+	          4,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read client flags.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 handshake_data,
+	 client_flags );
+
+	/* Clients that do not support the fixed newstyle handshake are not supported
+	 */
+	if( ( ( client_flags & NBD_CONNECTION_FLAG_FIXED_NEWSTYLE ) == 0 )
+	 || ( ( client_flags & ~( NBD_CONNECTION_FLAG_FIXED_NEWSTYLE | NBD_CONNECTION_FLAG_NO_ZEROES ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported client flags: 0x%08" PRIx32 ".",
+		 function,
+		 client_flags );
+
+		return( -1 );
+	}
+	if( ( client_flags & NBD_CONNECTION_FLAG_NO_ZEROES ) != 0 )
+	{
+		nbd_connection->no_zeroes = 1;
+	}
+	while( nbd_connection->serve_handle->abort == 0 )
+	{
+		result = nbd_connection_read_data(
+		          nbd_connection,
+		          option_header,
+		          16,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read option header.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		byte_stream_copy_to_uint64_big_endian(
+		 &( option_header[ 0 ] ),
+		 option_magic );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( option_header[ 8 ] ),
+		 option );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( option_header[ 12 ] ),
+		 option_data_size );
+
+		if( option_magic != NBD_CONNECTION_OPTION_MAGIC )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: unsupported option magic.",
+			 function );
+
+			return( -1 );
+		}
+		if( option_data_size > NBD_CONNECTION_MAXIMUM_OPTION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid option data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( option_data_size > 0 )
+		{
+			if( nbd_connection_resize_buffer(
+			     nbd_connection,
+			     (size_t) option_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize buffer.",
+				 function );
+
+				return( -1 );
+			}
+			if( nbd_connection_read_data(
+			     nbd_connection,
+			     nbd_connection->buffer,
+			     (size_t) option_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read option data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		result = 1;
+
+		switch( option )
+		{
+			case NBD_CONNECTION_OPTION_EXPORT_NAME:
+				/* Any export name refers to the image
+				 */
+				if( serve_handle_get_media_size(
+				     nbd_connection->serve_handle,
+				     &media_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve media size.",
+					 function );
+
+					return( -1 );
+				}
+				transmission_flags = NBD_CONNECTION_FLAG_HAS_FLAGS
+				                   | NBD_CONNECTION_FLAG_READ_ONLY
+				                   | NBD_CONNECTION_FLAG_SEND_FLUSH
+				                   | NBD_CONNECTION_FLAG_CAN_MULTI_CONN;
+
+				if( nbd_connection->use_structured_replies != 0 )
+				{
+					transmission_flags |= NBD_CONNECTION_FLAG_SEND_DF;
+				}
+				if( memory_set(
+				     export_information,
+				     0,
+				     134 ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear export information.",
+					 function );
+
+					return( -1 );
+				}
+				byte_stream_copy_from_uint64_big_endian(
+				 &( export_information[ 0 ] ),
+				 media_size );
+
+				byte_stream_copy_from_uint16_big_endian(
+				 &( export_information[ 8 ] ),
+				 transmission_flags );
+
+				export_information_size = 134;
+
+				if( nbd_connection->no_zeroes != 0 )
+				{
+					export_information_size = 10;
+				}
+				if( nbd_connection_write_data(
+				     nbd_connection,
+				     export_information,
+				     export_information_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write export information.",
+					 function );
+
+					return( -1 );
+				}
+				return( 1 );
+
+			case NBD_CONNECTION_OPTION_ABORT:
+				if( nbd_connection_write_option_reply(
+				     nbd_connection,
+				     option,
+				     NBD_CONNECTION_REPLY_ACK,
+				     NULL,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write option reply.",
+					 function );
+
+					return( -1 );
+				}
+				return( 0 );
+
+			case NBD_CONNECTION_OPTION_LIST:
+				if( option_data_size != 0 )
+				{
+					result = nbd_connection_write_option_reply(
+					          nbd_connection,
+					          option,
+					          NBD_CONNECTION_REPLY_ERROR_INVALID,
+					          NULL,
+					          0,
+					          error );
+					break;
+				}
+				/* The image is served as the default export, which has an empty name
+				 */
+				byte_stream_copy_from_uint32_big_endian(
+				 export_information,
+				 0 );
+
+				result = nbd_connection_write_option_reply(
+				          nbd_connection,
+				          option,
+				          NBD_CONNECTION_REPLY_SERVER,
+				          export_information,
+				          4,
+				          error );
+
+				if( result == 1 )
+				{
+					result = nbd_connection_write_option_reply(
+					          nbd_connection,
+					          option,
+					          NBD_CONNECTION_REPLY_ACK,
+					          NULL,
+					          0,
+					          error );
+				}
+				break;
+
+			case NBD_CONNECTION_OPTION_INFO:
+			case NBD_CONNECTION_OPTION_GO:
+				result = nbd_connection_write_export_information(
+				          nbd_connection,
+				          option,
+				          nbd_connection->buffer,
+				          (size_t) option_data_size,
+				          error );
+
+				if( ( result == 1 )
+				 && ( option == NBD_CONNECTION_OPTION_GO ) )
+				{
+					return( 1 );
+				}
+				else if( result == 0 )
+				{
+					result = 1;
+				}
+				break;
+
+			case NBD_CONNECTION_OPTION_STRUCTURED_REPLY:
+				if( option_data_size != 0 )
+				{
+					result = nbd_connection_write_option_reply(
+					          nbd_connection,
+					          option,
+					          NBD_CONNECTION_REPLY_ERROR_INVALID,
+					          NULL,
+					          0,
+					          error );
+					break;
+				}
+				nbd_connection->use_structured_replies = 1;
+
+				result = nbd_connection_write_option_reply(
+				          nbd_connection,
+				          option,
+				          NBD_CONNECTION_REPLY_ACK,
+				          NULL,
+				          0,
+				          error );
+				break;
+
+			case NBD_CONNECTION_OPTION_LIST_META_CONTEXT:
+			case NBD_CONNECTION_OPTION_SET_META_CONTEXT:
+				result = nbd_connection_write_meta_contexts(
+				          nbd_connection,
+				          option,
+				          nbd_connection->buffer,
+				          (size_t) option_data_size,
+				          error );
+				break;
+
+			default:
+				result = nbd_connection_write_option_reply(
+				          nbd_connection,
+				          option,
+				          NBD_CONNECTION_REPLY_ERROR_UNSUPPORTED,
+				          NULL,
+				          0,
+				          error );
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to reply to option: %" PRIu32 ".",
+			 function,
+			 option );
+
+			return( -1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Writes a simple reply
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_simple_reply(
+     nbd_connection_t *nbd_connection,
+     uint64_t cookie,
+     uint32_t error_code,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 16 ];
+
+	static char *function = "nbd_connection_write_simple_reply";
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 0 ] ),
+	 NBD_CONNECTION_SIMPLE_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 4 ] ),
+	 error_code );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_header[ 8 ] ),
+	 cookie );
+
+	if( nbd_connection_write_data(
+	     nbd_connection,
+	     reply_header,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_connection_write_data(
+		     nbd_connection,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes a structured reply chunk
+ * The header data is written together with the chunk header and is limited to 44 bytes
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_structured_reply(
+     nbd_connection_t *nbd_connection,
+     uint64_t cookie,
+     uint16_t chunk_flags,
+     uint16_t chunk_type,
+     const uint8_t *header_data,
+     size_t header_data_size,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 64 ];
+
+	static char *function = "nbd_connection_write_structured_reply";
+
+	if( header_data_size > 44 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid header data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) ( UINT32_MAX - header_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 0 ] ),
+	 NBD_CONNECTION_STRUCTURED_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( reply_header[ 4 ] ),
+	 chunk_flags );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( reply_header[ 6 ] ),
+	 chunk_type );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_header[ 8 ] ),
+	 cookie );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 16 ] ),
+	 (uint32_t) ( header_data_size + data_size ) );
+
+	if( header_data_size > 0 )
+	{
+		if( memory_copy(
+		     &( reply_header[ 20 ] ),
+		     header_data,
+		     header_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy header data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( nbd_connection_write_data(
+	     nbd_connection,
+	     reply_header,
+	     20 + header_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_connection_write_data(
+		     nbd_connection,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes the final reply of a request without data
+ * An error code of 0 indicates success
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_error_reply(
+     nbd_connection_t *nbd_connection,
+     uint64_t cookie,
+     uint32_t error_code,
+     libcerror_error_t **error )
+{
+	uint8_t error_data[ 6 ];
+
+	static char *function = "nbd_connection_write_error_reply";
+	int result            = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_connection->use_structured_replies == 0 )
+	{
+		result = nbd_connection_write_simple_reply(
+		          nbd_connection,
+		          cookie,
+		          error_code,
+		          NULL,
+		          0,
+		          error );
+	}
+	else if( error_code == 0 )
+	{
+		result = nbd_connection_write_structured_reply(
+		          nbd_connection,
+		          cookie,
+		          NBD_CONNECTION_CHUNK_FLAG_DONE,
+		          NBD_CONNECTION_CHUNK_TYPE_NONE,
+		          NULL,
+		          0,
+		          NULL,
+		          0,
+		          error );
+	}
+	else
+	{
+		/* The error chunk contains an empty message
+		 */
+		byte_stream_copy_from_uint32_big_endian(
+		 &( error_data[ 0 ] ),
+		 error_code );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( error_data[ 4 ] ),
+		 0 );
+
+		result = nbd_connection_write_structured_reply(
+		          nbd_connection,
+		          cookie,
+		          NBD_CONNECTION_CHUNK_FLAG_DONE,
+		          NBD_CONNECTION_CHUNK_TYPE_ERROR,
+		          error_data,
+		          6,
+		          NULL,
+		          0,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write reply.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Handles a read request
+ * With structured replies the runs that read as zero bytes are sent as holes,
+ * unless the client requested the reply not to be fragmented
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_read(
+     nbd_connection_t *nbd_connection,
+     uint64_t cookie,
+     uint16_t command_flags,
+     off64_t offset,
+     uint32_t length,
+     libcerror_error_t **error )
+{
+	uint8_t chunk_header[ 12 ];
+
+	libcerror_error_t *read_error = NULL;
+	static char *function         = "nbd_connection_read";
+	size64_t media_size           = 0;
+	size64_t run_size             = 0;
+	size_t chunk_size             = 0;
+	ssize_t read_count            = 0;
+	off64_t chunk_offset          = 0;
+	off64_t end_offset            = 0;
+	uint32_t error_code           = 0;
+	uint8_t block_status_flags    = 0;
+	uint8_t chunk_is_zero         = 0;
+	int result                    = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( serve_handle_get_media_size(
+	     nbd_connection->serve_handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( length > NBD_CONNECTION_MAXIMUM_REQUEST_SIZE )
+	{
+		error_code = NBD_CONNECTION_ERROR_OVERFLOW;
+	}
+	else if( ( offset < 0 )
+	      || ( (size64_t) offset > media_size )
+	      || ( (size64_t) length > ( media_size - (size64_t) offset ) ) )
+	{
+		error_code = NBD_CONNECTION_ERROR_INVALID;
+	}
+	if( ( error_code != 0 )
+	 || ( length == 0 ) )
+	{
+		if( nbd_connection_write_error_reply(
+		     nbd_connection,
+		     cookie,
+		     error_code,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( nbd_connection_resize_buffer(
+	     nbd_connection,
+	     (size_t) length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( nbd_connection->use_structured_replies == 0 )
+	 || ( ( command_flags & NBD_CONNECTION_COMMAND_FLAG_DONT_FRAGMENT ) != 0 ) )
+	{
+		read_count = serve_handle_read_buffer_at_offset(
+		              nbd_connection->serve_handle,
+		              nbd_connection->buffer,
+		              (size_t) length,
+		              offset,
+		              &read_error );
+
+		if( read_count != (ssize_t) length )
+		{
+			libcerror_error_free(
+			 &read_error );
+
+			result = nbd_connection_write_error_reply(
+			          nbd_connection,
+			          cookie,
+			          NBD_CONNECTION_ERROR_IO,
+			          error );
+		}
+		else if( nbd_connection->use_structured_replies == 0 )
+		{
+			result = nbd_connection_write_simple_reply(
+			          nbd_connection,
+			          cookie,
+			          0,
+			          nbd_connection->buffer,
+			          (size_t) length,
+			          error );
+		}
+		else
+		{
+			byte_stream_copy_from_uint64_big_endian(
+			 chunk_header,
+			 (uint64_t) offset );
+
+			result = nbd_connection_write_structured_reply(
+			          nbd_connection,
+			          cookie,
+			          NBD_CONNECTION_CHUNK_FLAG_DONE,
+			          NBD_CONNECTION_CHUNK_TYPE_OFFSET_DATA,
+			          chunk_header,
+			          8,
+			          nbd_connection->buffer,
+			          (size_t) length,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	end_offset = offset + (off64_t) length;
+
+	while( offset < end_offset )
+	{
+		/* Determine the chunk of consecutive runs that either read as zero bytes or contain data
+		 */
+		chunk_offset = offset;
+		chunk_size   = 0;
+
+		while( offset < end_offset )
+		{
+			result = serve_handle_get_block_status_at_offset(
+			          nbd_connection->serve_handle,
+			          offset,
+			          &run_size,
+			          &block_status_flags,
+			          &read_error );
+
+			if( result != 1 )
+			{
+				break;
+			}
+			if( ( chunk_size > 0 )
+			 && ( ( ( block_status_flags & SERVE_HANDLE_BLOCK_STATUS_FLAG_IS_ZERO ) != 0 ) != ( chunk_is_zero != 0 ) ) )
+			{
+				break;
+			}
+			chunk_is_zero = (uint8_t) ( ( block_status_flags & SERVE_HANDLE_BLOCK_STATUS_FLAG_IS_ZERO ) != 0 );
+
+			if( ( run_size == 0 )
+			 || ( run_size > (size64_t) ( end_offset - offset ) ) )
+			{
+				run_size = (size64_t) ( end_offset - offset );
+			}
+			chunk_size += (size_t) run_size;
+			offset     += (off64_t) run_size;
+		}
+		if( result != 1 )
+		{
+			break;
+		}
+		if( chunk_is_zero != 0 )
+		{
+			byte_stream_copy_from_uint64_big_endian(
+			 &( chunk_header[ 0 ] ),
+			 (uint64_t) chunk_offset );
+
+			byte_stream_copy_from_uint32_big_endian(
+			 &( chunk_header[ 8 ] ),
+			 (uint32_t) chunk_size );
+
+			result = nbd_connection_write_structured_reply(
+			          nbd_connection,
+			          cookie,
+			          0,
+			          NBD_CONNECTION_CHUNK_TYPE_OFFSET_HOLE,
+			          chunk_header,
+			          12,
+			          NULL,
+			          0,
+			          error );
+		}
+		else
+		{
+			read_count = serve_handle_read_buffer_at_offset(
+			              nbd_connection->serve_handle,
+			              nbd_connection->buffer,
+			              chunk_size,
+			              chunk_offset,
+			              &read_error );
+
+			if( read_count != (ssize_t) chunk_size )
+			{
+				result = 0;
+
+				break;
+			}
+			byte_stream_copy_from_uint64_big_endian(
+			 chunk_header,
+			 (uint64_t) chunk_offset );
+
+			result = nbd_connection_write_structured_reply(
+			          nbd_connection,
+			          cookie,
+			          0,
+			          NBD_CONNECTION_CHUNK_TYPE_OFFSET_DATA,
+			          chunk_header,
+			          8,
+			          nbd_connection->buffer,
+			          chunk_size,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply chunk.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* A failed read is reported to the client, which can continue to use the connection
+	 */
+	if( result != 1 )
+	{
+		libcerror_error_free(
+		 &read_error );
+
+		error_code = NBD_CONNECTION_ERROR_IO;
+	}
+	if( nbd_connection_write_error_reply(
+	     nbd_connection,
+	     cookie,
+	     error_code,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write reply.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Handles a block status request of the base:allocation meta context
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_get_block_status(
+     nbd_connection_t *nbd_connection,
+     uint64_t cookie,
+     uint16_t command_flags,
+     off64_t offset,
+     uint32_t length,
+     libcerror_error_t **error )
+{
+	uint8_t context_data[ 4 ];
+
+	libcerror_error_t *status_error    = NULL;
+	static char *function              = "nbd_connection_get_block_status";
+	size64_t media_size                = 0;
+	size64_t run_size                  = 0;
+	size_t descriptors_data_offset     = 0;
+	off64_t end_offset                 = 0;
+	uint32_t descriptor_length         = 0;
+	uint32_t descriptor_state          = 0;
+	uint32_t error_code                = 0;
+	uint32_t previous_descriptor_state = 0;
+	uint8_t block_status_flags         = 0;
+	int maximum_number_of_descriptors  = NBD_CONNECTION_MAXIMUM_NUMBER_OF_DESCRIPTORS;
+	int number_of_descriptors          = 0;
+	int result                         = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( serve_handle_get_media_size(
+	     nbd_connection->serve_handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( nbd_connection->use_base_allocation == 0 )
+	 || ( length == 0 )
+	 || ( offset < 0 )
+	 || ( (size64_t) offset > media_size )
+	 || ( (size64_t) length > ( media_size - (size64_t) offset ) ) )
+	{
+		error_code = NBD_CONNECTION_ERROR_INVALID;
+	}
+	else if( nbd_connection_resize_buffer(
+	          nbd_connection,
+	          8 * NBD_CONNECTION_MAXIMUM_NUMBER_OF_DESCRIPTORS,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( command_flags & NBD_CONNECTION_COMMAND_FLAG_REQUEST_ONE ) != 0 )
+	{
+		maximum_number_of_descriptors = 1;
+	}
+	end_offset = offset + (off64_t) length;
+
+	while( ( error_code == 0 )
+	    && ( offset < end_offset ) )
+	{
+		result = serve_handle_get_block_status_at_offset(
+		          nbd_connection->serve_handle,
+		          offset,
+		          &run_size,
+		          &block_status_flags,
+		          &status_error );
+
+		if( result != 1 )
+		{
+			libcerror_error_free(
+			 &status_error );
+
+			error_code = NBD_CONNECTION_ERROR_IO;
+
+			break;
+		}
+		if( ( run_size == 0 )
+		 || ( run_size > (size64_t) ( end_offset - offset ) ) )
+		{
+			run_size = (size64_t) ( end_offset - offset );
+		}
+		descriptor_state = 0;
+
+		if( ( block_status_flags & SERVE_HANDLE_BLOCK_STATUS_FLAG_IS_HOLE ) != 0 )
+		{
+			descriptor_state |= NBD_CONNECTION_STATE_HOLE;
+		}
+		if( ( block_status_flags & SERVE_HANDLE_BLOCK_STATUS_FLAG_IS_ZERO ) != 0 )
+		{
+			descriptor_state |= NBD_CONNECTION_STATE_ZERO;
+		}
+		/* Consecutive runs with the same state are merged into a single descriptor
+		 */
+		if( ( number_of_descriptors > 0 )
+		 && ( descriptor_state == previous_descriptor_state ) )
+		{
+			descriptors_data_offset -= 8;
+
+			descriptor_length += (uint32_t) run_size;
+		}
+		else if( number_of_descriptors < maximum_number_of_descriptors )
+		{
+			descriptor_length = (uint32_t) run_size;
+
+			number_of_descriptors++;
+		}
+		else
+		{
+			break;
+		}
+		byte_stream_copy_from_uint32_big_endian(
+		 &( nbd_connection->buffer[ descriptors_data_offset ] ),
+		 descriptor_length );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( nbd_connection->buffer[ descriptors_data_offset + 4 ] ),
+		 descriptor_state );
+
+		descriptors_data_offset  += 8;
+		previous_descriptor_state = descriptor_state;
+
+		offset += (off64_t) run_size;
+	}
+	if( error_code != 0 )
+	{
+		result = nbd_connection_write_error_reply(
+		          nbd_connection,
+		          cookie,
+		          error_code,
+		          error );
+	}
+	else
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 context_data,
+		 NBD_CONNECTION_BASE_ALLOCATION_IDENTIFIER );
+
+		result = nbd_connection_write_structured_reply(
+		          nbd_connection,
+		          cookie,
+		          NBD_CONNECTION_CHUNK_FLAG_DONE,
+		          NBD_CONNECTION_CHUNK_TYPE_BLOCK_STATUS,
+		          context_data,
+		          4,
+		          nbd_connection->buffer,
+		          descriptors_data_offset,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write reply.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Processes the requests of the transmission phase
+ * Returns 1 if the client disconnected or -1 on error
+ */
+int nbd_connection_process_requests(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error )
+{
+	uint8_t request_data[ 28 ];
+
+	static char *function   = "nbd_connection_process_requests";
+	uint64_t cookie         = 0;
+	uint64_t offset         = 0;
+	uint32_t error_code     = 0;
+	uint32_t length         = 0;
+	uint32_t request_magic  = 0;
+	uint16_t command_flags  = 0;
+	uint16_t command_type   = 0;
+	int result              = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	while( nbd_connection->serve_handle->abort == 0 )
+	{
+		result = nbd_connection_read_data(
+		          nbd_connection,
+		          request_data,
+		          28,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read request.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		byte_stream_copy_to_uint32_big_endian(
+		 &( request_data[ 0 ] ),
+		 request_magic );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 &( request_data[ 4 ] ),
+		 command_flags );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 &( request_data[ 6 ] ),
+		 command_type );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( request_data[ 8 ] ),
+		 cookie );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( request_data[ 16 ] ),
+		 offset );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( request_data[ 24 ] ),
+		 length );
+
+		if( request_magic != NBD_CONNECTION_REQUEST_MAGIC )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: unsupported request magic.",
+			 function );
+
+			return( -1 );
+		}
+		if( command_type == NBD_CONNECTION_COMMAND_DISCONNECT )
+		{
+			break;
+		}
+		/* Offsets that do not fit in a signed 64-bit integer are beyond the media size
+		 */
+		if( offset > (uint64_t) INT64_MAX )
+		{
+			offset = (uint64_t) INT64_MAX;
+		}
+		error_code = 0;
+
+		switch( command_type )
+		{
+			case NBD_CONNECTION_COMMAND_READ:
+				result = nbd_connection_read(
+				          nbd_connection,
+				          cookie,
+				          command_flags,
+				          (off64_t) offset,
+				          length,
+				          error );
+				break;
+
+			case NBD_CONNECTION_COMMAND_BLOCK_STATUS:
+				result = nbd_connection_get_block_status(
+				          nbd_connection,
+				          cookie,
+				          command_flags,
+				          (off64_t) offset,
+				          length,
+				          error );
+				break;
+
+			case NBD_CONNECTION_COMMAND_WRITE:
+				/* The data of the write request must be read before the reply is sent
+				 */
+				if( nbd_connection_skip_data(
+				     nbd_connection,
+				     (size_t) length,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read write request data.",
+					 function );
+
+					return( -1 );
+				}
+				error_code = NBD_CONNECTION_ERROR_PERMISSION_DENIED;
+
+				result = nbd_connection_write_error_reply(
+				          nbd_connection,
+				          cookie,
+				          error_code,
+				          error );
+				break;
+
+			case NBD_CONNECTION_COMMAND_TRIM:
+			case NBD_CONNECTION_COMMAND_WRITE_ZEROES:
+				error_code = NBD_CONNECTION_ERROR_PERMISSION_DENIED;
+
+				result = nbd_connection_write_error_reply(
+				          nbd_connection,
+				          cookie,
+				          error_code,
+				          error );
+				break;
+
+			/* The image is read-only hence there is nothing to flush
+			 */
+			case NBD_CONNECTION_COMMAND_FLUSH:
+			case NBD_CONNECTION_COMMAND_CACHE:
+				result = nbd_connection_write_error_reply(
+				          nbd_connection,
+				          cookie,
+				          0,
+				          error );
+				break;
+
+			default:
+				error_code = NBD_CONNECTION_ERROR_INVALID;
+
+				result = nbd_connection_write_error_reply(
+				          nbd_connection,
+				          cookie,
+				          error_code,
+				          error );
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to process request of type: %" PRIu16 ".",
+			 function,
+			 command_type );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Serves the connection
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_serve(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_serve";
+	int result            = 0;
+
+	result = nbd_connection_negotiate(
+	          nbd_connection,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to negotiate options.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( nbd_connection_process_requests(
+		     nbd_connection,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to process requests.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Serves the connection from a thread
+ * Errors are printed since they cannot be returned to the thread that created the connection
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_thread_function(
+     nbd_connection_t *nbd_connection )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "nbd_connection_thread_function";
+	int result               = 0;
+
+	if( nbd_connection == NULL )
+	{
+		return( -1 );
+	}
+	result = nbd_connection_serve(
+	          nbd_connection,
+	          &error );
+
+	if( result != 1 )
+	{
+		libcnotify_printf(
+		 "%s: unable to serve connection.\n",
+		 function );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	nbd_connection->is_finished = 1;
+
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,296 @@
+/*
+ * Network Block Device (NBD) connection
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NBD_CONNECTION_H )
+#define _NBD_CONNECTION_H
+
+#include <common.h>
+#include <types.h>
+
+#include "serve_handle.h"
+#include "vmdktools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define NBD_CONNECTION_SERVER_MAGIC			0x4e42444d41474943ULL
+#define NBD_CONNECTION_OPTION_MAGIC			0x49484156454f5054ULL
+#define NBD_CONNECTION_OPTION_REPLY_MAGIC		0x0003e889045565a9ULL
+#define NBD_CONNECTION_REQUEST_MAGIC			0x25609513UL
+#define NBD_CONNECTION_SIMPLE_REPLY_MAGIC		0x67446698UL
+#define NBD_CONNECTION_STRUCTURED_REPLY_MAGIC		0x668e33efUL
+
+/* The handshake flags
+ */
+#define NBD_CONNECTION_FLAG_FIXED_NEWSTYLE		0x0001
+#define NBD_CONNECTION_FLAG_NO_ZEROES			0x0002
+
+/* The transmission flags
+ */
+#define NBD_CONNECTION_FLAG_HAS_FLAGS			0x0001
+#define NBD_CONNECTION_FLAG_READ_ONLY			0x0002
+#define NBD_CONNECTION_FLAG_SEND_FLUSH			0x0004
+#define NBD_CONNECTION_FLAG_SEND_DF			0x0080
+#define NBD_CONNECTION_FLAG_CAN_MULTI_CONN		0x0100
+
+/* The options
+ */
+#define NBD_CONNECTION_OPTION_EXPORT_NAME		1
+#define NBD_CONNECTION_OPTION_ABORT			2
+#define NBD_CONNECTION_OPTION_LIST			3
+#define NBD_CONNECTION_OPTION_INFO			6
+#define NBD_CONNECTION_OPTION_GO			7
+#define NBD_CONNECTION_OPTION_STRUCTURED_REPLY		8
+#define NBD_CONNECTION_OPTION_LIST_META_CONTEXT		9
+#define NBD_CONNECTION_OPTION_SET_META_CONTEXT		10
+
+/* The option reply types
+ */
+#define NBD_CONNECTION_REPLY_ACK			1
+#define NBD_CONNECTION_REPLY_SERVER			2
+#define NBD_CONNECTION_REPLY_INFO			3
+#define NBD_CONNECTION_REPLY_META_CONTEXT		4
+#define NBD_CONNECTION_REPLY_ERROR_UNSUPPORTED		0x80000001UL
+#define NBD_CONNECTION_REPLY_ERROR_INVALID		0x80000003UL
+
+/* The information types
+ */
+#define NBD_CONNECTION_INFO_EXPORT			0
+#define NBD_CONNECTION_INFO_BLOCK_SIZE			3
+
+/* The commands
+ */
+#define NBD_CONNECTION_COMMAND_READ			0
+#define NBD_CONNECTION_COMMAND_WRITE			1
+#define NBD_CONNECTION_COMMAND_DISCONNECT		2
+#define NBD_CONNECTION_COMMAND_FLUSH			3
+#define NBD_CONNECTION_COMMAND_TRIM			4
+#define NBD_CONNECTION_COMMAND_CACHE			5
+#define NBD_CONNECTION_COMMAND_WRITE_ZEROES		6
+#define NBD_CONNECTION_COMMAND_BLOCK_STATUS		7
+
+/* The command flags
+ */
+#define NBD_CONNECTION_COMMAND_FLAG_DONT_FRAGMENT	0x0004
+#define NBD_CONNECTION_COMMAND_FLAG_REQUEST_ONE		0x0008
+
+/* The structured reply chunk types
+ */
+#define NBD_CONNECTION_CHUNK_FLAG_DONE			0x0001
+
+#define NBD_CONNECTION_CHUNK_TYPE_NONE			0
+#define NBD_CONNECTION_CHUNK_TYPE_OFFSET_DATA		1
+#define NBD_CONNECTION_CHUNK_TYPE_OFFSET_HOLE		2
+#define NBD_CONNECTION_CHUNK_TYPE_BLOCK_STATUS		5
+#define NBD_CONNECTION_CHUNK_TYPE_ERROR			0x8001
+
+/* The base:allocation block status flags
+ */
+#define NBD_CONNECTION_STATE_HOLE			0x00000001UL
+#define NBD_CONNECTION_STATE_ZERO			0x00000002UL
+
+/* The error codes
+ */
+#define NBD_CONNECTION_ERROR_PERMISSION_DENIED		1
+#define NBD_CONNECTION_ERROR_IO				5
+#define NBD_CONNECTION_ERROR_INVALID			22
+#define NBD_CONNECTION_ERROR_OVERFLOW			75
+
+/* The meta context of the allocation state
+ */
+#define NBD_CONNECTION_BASE_ALLOCATION			"base:allocation"
+#define NBD_CONNECTION_BASE_ALLOCATION_LENGTH		15
+#define NBD_CONNECTION_BASE_ALLOCATION_IDENTIFIER	1
+
+/* The maximum size of the data of an option
+ */
+#define NBD_CONNECTION_MAXIMUM_OPTION_SIZE		( 64 * 1024 )
+
+/* The maximum size of the data of a request
+ */
+#define NBD_CONNECTION_MAXIMUM_REQUEST_SIZE		( 32 * 1024 * 1024 )
+
+/* The preferred size of the data of a request
+ */
+#define NBD_CONNECTION_PREFERRED_REQUEST_SIZE		( 64 * 1024 )
+
+/* The maximum number of block status descriptors per reply
+ */
+#define NBD_CONNECTION_MAXIMUM_NUMBER_OF_DESCRIPTORS	256
+
+typedef struct nbd_connection nbd_connection_t;
+
+struct nbd_connection
+{
+	/* The serve handle
+	 */
+	serve_handle_t *serve_handle;
+
+	/* The socket descriptor
+	 */
+	int socket_descriptor;
+
+	/* Value to indicate the client does not want the zero padding of the export information
+	 */
+	uint8_t no_zeroes;
+
+	/* Value to indicate structured replies were negotiated
+	 */
+	uint8_t use_structured_replies;
+
+	/* Value to indicate the base:allocation meta context was negotiated
+	 */
+	uint8_t use_base_allocation;
+
+	/* The data buffer
+	 */
+	uint8_t *buffer;
+
+	/* The data buffer size
+	 */
+	size_t buffer_size;
+
+	/* Value to indicate the connection has finished
+	 */
+	int is_finished;
+};
+
+int nbd_connection_initialize(
+     nbd_connection_t **nbd_connection,
+     serve_handle_t *serve_handle,
+     int socket_descriptor,
+     libcerror_error_t **error );
+
+int nbd_connection_free(
+     nbd_connection_t **nbd_connection,
+     libcerror_error_t **error );
+
+int nbd_connection_read_data(
+     nbd_connection_t *nbd_connection,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_data(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_skip_data(
+     nbd_connection_t *nbd_connection,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_resize_buffer(
+     nbd_connection_t *nbd_connection,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_option_reply(
+     nbd_connection_t *nbd_connection,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_export_information(
+     nbd_connection_t *nbd_connection,
+     uint32_t option,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_meta_contexts(
+     nbd_connection_t *nbd_connection,
+     uint32_t option,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_negotiate(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error );
+
+int nbd_connection_write_simple_reply(
+     nbd_connection_t *nbd_connection,
+     uint64_t cookie,
+     uint32_t error_code,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_structured_reply(
+     nbd_connection_t *nbd_connection,
+     uint64_t cookie,
+     uint16_t chunk_flags,
+     uint16_t chunk_type,
+     const uint8_t *header_data,
+     size_t header_data_size,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_error_reply(
+     nbd_connection_t *nbd_connection,
+     uint64_t cookie,
+     uint32_t error_code,
+     libcerror_error_t **error );
+
+int nbd_connection_read(
+     nbd_connection_t *nbd_connection,
+     uint64_t cookie,
+     uint16_t command_flags,
+     off64_t offset,
+     uint32_t length,
+     libcerror_error_t **error );
+
+int nbd_connection_get_block_status(
+     nbd_connection_t *nbd_connection,
+     uint64_t cookie,
+     uint16_t command_flags,
+     off64_t offset,
+     uint32_t length,
+     libcerror_error_t **error );
+
+int nbd_connection_process_requests(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error );
+
+int nbd_connection_serve(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int nbd_connection_thread_function(
+     nbd_connection_t *nbd_connection );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _NBD_CONNECTION_H ) */
+
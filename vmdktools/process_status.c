@@ -0,0 +1,479 @@
+/*
+ * Process status functions
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <time.h>
+
+#include "byte_size_string.h"
+#include "process_status.h"
+#include "vmdktools_libcerror.h"
+
+/* Creates process status
+ * Make sure the value process_status is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_initialize(
+     process_status_t **process_status,
+     const system_character_t *status_process_string,
+     const system_character_t *status_update_string,
+     const system_character_t *status_summary_string,
+     FILE *output_stream,
+     uint8_t print_status_information,
+     libcerror_error_t **error )
+{
+	static char *function = "process_status_initialize";
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	if( *process_status != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid process status value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*process_status = memory_allocate_structure(
+	                   process_status_t );
+
+	if( *process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *process_status,
+	     0,
+	     sizeof( process_status_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear process status.",
+		 function );
+
+		goto on_error;
+	}
+	( *process_status )->status_process_string    = status_process_string;
+	( *process_status )->status_update_string     = status_update_string;
+	( *process_status )->status_summary_string    = status_summary_string;
+	( *process_status )->output_stream            = output_stream;
+	( *process_status )->print_status_information = print_status_information;
+	( *process_status )->last_percentage          = -1;
+
+	return( 1 );
+
+on_error:
+	if( *process_status != NULL )
+	{
+		memory_free(
+		 *process_status );
+
+		*process_status = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees process status
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_free(
+     process_status_t **process_status,
+     libcerror_error_t **error )
+{
+	static char *function = "process_status_free";
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	if( *process_status != NULL )
+	{
+		memory_free(
+		 *process_status );
+
+		*process_status = NULL;
+	}
+	return( 1 );
+}
+
+/* Starts the process status
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_start(
+     process_status_t *process_status,
+     libcerror_error_t **error )
+{
+	static char *function = "process_status_start";
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	process_status->last_percentage      = -1;
+	process_status->last_bytes_processed = 0;
+	process_status->start_timestamp      = time( NULL );
+	process_status->last_timestamp       = process_status->start_timestamp;
+
+	if( ( process_status->print_status_information != 0 )
+	 && ( process_status->output_stream != NULL )
+	 && ( process_status->status_process_string != NULL ) )
+	{
+		fprintf(
+		 process_status->output_stream,
+		 "%" PRIs_SYSTEM " started at: %s",
+		 process_status->status_process_string,
+		 ctime( &( process_status->start_timestamp ) ) );
+
+		fprintf(
+		 process_status->output_stream,
+		 "This could take a while.\n\n" );
+	}
+	return( 1 );
+}
+
+/* Updates the process status
+ * The status is printed at most once per second or when the percentage changes
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_update(
+     process_status_t *process_status,
+     size64_t bytes_processed,
+     size64_t bytes_total,
+     libcerror_error_t **error )
+{
+	static char *function     = "process_status_update";
+	size64_t remaining_bytes  = 0;
+	time_t current_timestamp  = 0;
+	time_t number_of_seconds  = 0;
+	time_t remaining_seconds  = 0;
+	int8_t new_percentage     = 0;
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( process_status->print_status_information == 0 )
+	 || ( process_status->output_stream == NULL ) )
+	{
+		return( 1 );
+	}
+	if( ( bytes_total > 0 )
+	 && ( bytes_processed <= bytes_total ) )
+	{
+		new_percentage = (int8_t) ( ( bytes_processed * 100 ) / bytes_total );
+	}
+	current_timestamp = time( NULL );
+
+	if( ( new_percentage <= process_status->last_percentage )
+	 && ( current_timestamp == process_status->last_timestamp ) )
+	{
+		return( 1 );
+	}
+	process_status->last_percentage      = new_percentage;
+	process_status->last_timestamp       = current_timestamp;
+	process_status->last_bytes_processed = bytes_processed;
+
+	number_of_seconds = current_timestamp - process_status->start_timestamp;
+
+	fprintf(
+	 process_status->output_stream,
+	 "Status: at %" PRIi8 "%%.\n",
+	 new_percentage );
+
+	fprintf(
+	 process_status->output_stream,
+	 "        %" PRIs_SYSTEM " ",
+	 process_status->status_update_string );
+
+	process_status_bytes_fprint(
+	 process_status->output_stream,
+	 bytes_processed );
+
+	fprintf(
+	 process_status->output_stream,
+	 " of total " );
+
+	process_status_bytes_fprint(
+	 process_status->output_stream,
+	 bytes_total );
+
+	fprintf(
+	 process_status->output_stream,
+	 ".\n" );
+
+	if( ( number_of_seconds > 0 )
+	 && ( bytes_processed > 0 )
+	 && ( bytes_processed <= bytes_total ) )
+	{
+		remaining_bytes   = bytes_total - bytes_processed;
+		remaining_seconds = (time_t) ( ( remaining_bytes * (size64_t) number_of_seconds ) / bytes_processed );
+
+		fprintf(
+		 process_status->output_stream,
+		 "        completion in %" PRIi64 " second(s) with ",
+		 (int64_t) remaining_seconds );
+
+		process_status_bytes_per_second_fprint(
+		 process_status->output_stream,
+		 bytes_processed,
+		 number_of_seconds );
+
+		fprintf(
+		 process_status->output_stream,
+		 ".\n" );
+	}
+	fprintf(
+	 process_status->output_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
+/* Stops the process status
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_stop(
+     process_status_t *process_status,
+     size64_t bytes_processed,
+     int status,
+     libcerror_error_t **error )
+{
+	const char *status_string = NULL;
+	static char *function     = "process_status_stop";
+	time_t number_of_seconds  = 0;
+	time_t stop_timestamp     = 0;
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( status != PROCESS_STATUS_ABORTED )
+	 && ( status != PROCESS_STATUS_COMPLETED )
+	 && ( status != PROCESS_STATUS_FAILED ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported status.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( process_status->print_status_information == 0 )
+	 || ( process_status->output_stream == NULL ) )
+	{
+		return( 1 );
+	}
+	if( status == PROCESS_STATUS_ABORTED )
+	{
+		status_string = "aborted";
+	}
+	else if( status == PROCESS_STATUS_COMPLETED )
+	{
+		status_string = "completed";
+	}
+	else
+	{
+		status_string = "failed";
+	}
+	stop_timestamp    = time( NULL );
+	number_of_seconds = stop_timestamp - process_status->start_timestamp;
+
+	fprintf(
+	 process_status->output_stream,
+	 "%" PRIs_SYSTEM " %s at: %s\n",
+	 process_status->status_process_string,
+	 status_string,
+	 ctime( &stop_timestamp ) );
+
+	if( ( status == PROCESS_STATUS_COMPLETED )
+	 && ( process_status->status_summary_string != NULL ) )
+	{
+		fprintf(
+		 process_status->output_stream,
+		 "%" PRIs_SYSTEM ": ",
+		 process_status->status_summary_string );
+
+		process_status_bytes_fprint(
+		 process_status->output_stream,
+		 bytes_processed );
+
+		fprintf(
+		 process_status->output_stream,
+		 " in %" PRIi64 " second(s) with ",
+		 (int64_t) number_of_seconds );
+
+		process_status_bytes_per_second_fprint(
+		 process_status->output_stream,
+		 bytes_processed,
+		 number_of_seconds );
+
+		fprintf(
+		 process_status->output_stream,
+		 ".\n" );
+	}
+	return( 1 );
+}
+
+/* Prints a human readable number of bytes
+ */
+void process_status_bytes_fprint(
+      FILE *stream,
+      size64_t bytes )
+{
+	system_character_t bytes_string[ 16 ];
+
+	int result = 0;
+
+	if( stream == NULL )
+	{
+		return;
+	}
+	if( bytes >= 1024 )
+	{
+		result = byte_size_string_create(
+		          bytes_string,
+		          16,
+		          bytes,
+		          BYTE_SIZE_STRING_UNIT_MEBIBYTE,
+		          NULL );
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stream,
+		 "%" PRIs_SYSTEM " (%" PRIu64 " bytes)",
+		 bytes_string,
+		 bytes );
+	}
+	else
+	{
+		fprintf(
+		 stream,
+		 "%" PRIu64 " bytes",
+		 bytes );
+	}
+}
+
+/* Prints a human readable throughput
+ */
+void process_status_bytes_per_second_fprint(
+      FILE *stream,
+      size64_t bytes,
+      time_t number_of_seconds )
+{
+	system_character_t bytes_per_second_string[ 16 ];
+
+	size64_t bytes_per_second = 0;
+	int result                = 0;
+
+	if( stream == NULL )
+	{
+		return;
+	}
+	if( number_of_seconds > 0 )
+	{
+		bytes_per_second = bytes / (size64_t) number_of_seconds;
+	}
+	else
+	{
+		bytes_per_second = bytes;
+	}
+	if( bytes_per_second >= 1024 )
+	{
+		result = byte_size_string_create(
+		          bytes_per_second_string,
+		          16,
+		          bytes_per_second,
+		          BYTE_SIZE_STRING_UNIT_MEBIBYTE,
+		          NULL );
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stream,
+		 "%" PRIs_SYSTEM "/s (%" PRIu64 " bytes/second)",
+		 bytes_per_second_string,
+		 bytes_per_second );
+	}
+	else
+	{
+		fprintf(
+		 stream,
+		 "%" PRIu64 " bytes/second",
+		 bytes_per_second );
+	}
+}
+
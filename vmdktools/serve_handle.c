@@ -0,0 +1,2290 @@
+/*
+ * Serve handle
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "nbd_connection.h"
+#include "serve_handle.h"
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libcnotify.h"
+#include "vmdktools_libcpath.h"
+#include "vmdktools_libcthreads.h"
+#include "vmdktools_libvmdk.h"
+
+#if defined( SERVE_HANDLE_HAVE_SOCKETS )
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+#define SERVE_HANDLE_NOTIFY_STREAM		stdout
+
+/* Creates a serve handle
+ * Make sure the value serve_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int serve_handle_initialize(
+     serve_handle_t **serve_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "serve_handle_initialize";
+
+	if( serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *serve_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid serve handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*serve_handle = memory_allocate_structure(
+	                  serve_handle_t );
+
+	if( *serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create serve handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *serve_handle,
+	     0,
+	     sizeof( serve_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear serve handle.",
+		 function );
+
+		memory_free(
+		 *serve_handle );
+
+		*serve_handle = NULL;
+
+		return( -1 );
+	}
+	if( libvmdk_handle_initialize(
+	     &( ( *serve_handle )->input_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *serve_handle )->parent_handles_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize parent handles array.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcdata_array_initialize(
+	     &( ( *serve_handle )->connections_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize connections array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *serve_handle )->threads_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize threads array.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *serve_handle )->socket_descriptor = -1;
+	( *serve_handle )->notify_stream     = SERVE_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *serve_handle != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *serve_handle )->connections_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *serve_handle )->connections_array ),
+			 NULL,
+			 NULL );
+		}
+#endif
+		if( ( *serve_handle )->parent_handles_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *serve_handle )->parent_handles_array ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *serve_handle )->input_handle != NULL )
+		{
+			libvmdk_handle_free(
+			 &( ( *serve_handle )->input_handle ),
+			 NULL );
+		}
+		memory_free(
+		 *serve_handle );
+
+		*serve_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a serve handle
+ * Returns 1 if successful or -1 on error
+ */
+int serve_handle_free(
+     serve_handle_t **serve_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "serve_handle_free";
+	int result            = 1;
+
+	if( serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *serve_handle != NULL )
+	{
+		if( ( *serve_handle )->basename != NULL )
+		{
+			memory_free(
+			 ( *serve_handle )->basename );
+		}
+		if( ( *serve_handle )->socket_descriptor != -1 )
+		{
+			if( serve_handle_close_socket(
+			     *serve_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close socket.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* The connections are finished and their threads joined by serve_handle_serve_connections
+		 */
+		if( ( *serve_handle )->threads_array != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *serve_handle )->threads_array ),
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free threads array.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *serve_handle )->connections_array != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *serve_handle )->connections_array ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &nbd_connection_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free connections array.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		/* The input handle references the parent handles and must be freed first
+		 */
+		if( ( *serve_handle )->input_handle != NULL )
+		{
+			if( libvmdk_handle_free(
+			     &( ( *serve_handle )->input_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *serve_handle )->parent_handles_array != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *serve_handle )->parent_handles_array ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free parent handles array.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *serve_handle );
+
+		*serve_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the serve handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int serve_handle_signal_abort(
+     serve_handle_t *serve_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "serve_handle_signal_abort";
+
+	if( serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serve handle.",
+		 function );
+
+		return( -1 );
+	}
+	serve_handle->abort = 1;
+
+#if defined( SERVE_HANDLE_HAVE_SOCKETS )
+	/* Shutting down the listening socket makes a blocking accept return
+	 */
+	if( serve_handle->socket_descriptor != -1 )
+	{
+		shutdown(
+		 serve_handle->socket_descriptor,
+		 SHUT_RDWR );
+	}
+#endif
+	if( serve_handle->input_handle != NULL )
+	{
+		if( libvmdk_handle_signal_abort(
+		     serve_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the basename
+ * Returns 1 if successful or -1 on error
+ */
+int serve_handle_set_basename(
+     serve_handle_t *serve_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error )
+{
+	static char *function = "serve_handle_set_basename";
+
+	if( serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( serve_handle->basename != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid serve handle - basename value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( basename_size == 0 )
+	 || ( basename_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid basename size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	serve_handle->basename = system_string_allocate(
+	                           basename_size );
+
+	if( serve_handle->basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create basename string.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     serve_handle->basename,
+	     basename,
+	     basename_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy basename.",
+		 function );
+
+		goto on_error;
+	}
+	serve_handle->basename[ basename_size - 1 ] = 0;
+
+	serve_handle->basename_size = basename_size;
+
+	return( 1 );
+
+on_error:
+	if( serve_handle->basename != NULL )
+	{
+		memory_free(
+		 serve_handle->basename );
+
+		serve_handle->basename = NULL;
+	}
+	serve_handle->basename_size = 0;
+
+	return( -1 );
+}
+
+/* Opens the input of the serve handle
+ * Returns 1 if successful or -1 on error
+ */
+int serve_handle_open_input(
+     serve_handle_t *serve_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error )
+{
+	system_character_t *basename_end   = NULL;
+	static char *function              = "serve_handle_open_input";
+	size_t basename_length             = 0;
+	size_t filename_length             = 0;
+	uint32_t parent_content_identifier = 0;
+	int result                         = 0;
+
+	if( serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_filenames != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of filenames.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filenames[ 0 ] );
+
+	basename_end = system_string_search_character_reverse(
+	                filenames[ 0 ],
+	                (system_character_t) LIBCPATH_SEPARATOR,
+	                filename_length + 1 );
+
+	if( basename_end != NULL )
+	{
+		basename_length = (size_t) ( basename_end - filenames[ 0 ] ) + 1;
+	}
+	if( basename_length > 0 )
+	{
+		if( serve_handle_set_basename(
+		     serve_handle,
+		     filenames[ 0 ],
+		     basename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set basename.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_open_wide(
+	          serve_handle->input_handle,
+	          filenames[ 0 ],
+	          LIBVMDK_OPEN_READ,
+	          error );
+#else
+	result = libvmdk_handle_open(
+	          serve_handle->input_handle,
+	          filenames[ 0 ],
+	          LIBVMDK_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvmdk_handle_get_parent_content_identifier(
+	          serve_handle->input_handle,
+	          &parent_content_identifier,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent content identifier.",
+		 function );
+
+		return( -1 );
+	}
+	else if( ( result != 0 )
+	      && ( parent_content_identifier != 0xffffffffUL ) )
+	{
+		if( serve_handle_open_parent(
+		     serve_handle,
+		     serve_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open parent handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libvmdk_handle_open_extent_data_files(
+	     serve_handle->input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_media_size(
+	     serve_handle->input_handle,
+	     &( serve_handle->input_media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens the parent handle of a specific handle, including its own parents
+ * Returns 1 if successful or -1 on error
+ */
+int serve_handle_open_parent(
+     serve_handle_t *serve_handle,
+     libvmdk_handle_t *vmdk_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *parent_vmdk_handle = NULL;
+	system_character_t *parent_filename  = NULL;
+	system_character_t *parent_path      = NULL;
+	static char *function                = "serve_handle_open_parent";
+	size_t parent_filename_size          = 0;
+	size_t parent_path_size              = 0;
+	uint32_t parent_content_identifier   = 0;
+	int entry_index                      = 0;
+	int result                           = 0;
+
+	if( serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serve handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename_size(
+	          vmdk_handle,
+	          &parent_filename_size,
+	          error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename_size(
+	          vmdk_handle,
+	          &parent_filename_size,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( parent_filename_size == 0 )
+	 || ( parent_filename_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid parent filename size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	parent_filename = system_string_allocate(
+	                   parent_filename_size );
+
+	if( parent_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parent filename string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename(
+	          vmdk_handle,
+	          (uint16_t *) parent_filename,
+	          parent_filename_size,
+	          error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename(
+	          vmdk_handle,
+	          (uint8_t *) parent_filename,
+	          parent_filename_size,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( serve_handle->basename == NULL )
+	{
+		parent_path      = parent_filename;
+		parent_path_size = parent_filename_size;
+	}
+	else
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libcpath_path_join_wide(
+		          &parent_path,
+		          &parent_path_size,
+		          serve_handle->basename,
+		          serve_handle->basename_size - 1,
+		          parent_filename,
+		          parent_filename_size - 1,
+		          error );
+#else
+		result = libcpath_path_join(
+		          &parent_path,
+		          &parent_path_size,
+		          serve_handle->basename,
+		          serve_handle->basename_size - 1,
+		          parent_filename,
+		          parent_filename_size - 1,
+		          error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create parent path.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_handle_initialize(
+	     &parent_vmdk_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize parent handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_open_wide(
+	          parent_vmdk_handle,
+	          parent_path,
+	          LIBVMDK_OPEN_READ,
+	          error );
+#else
+	result = libvmdk_handle_open(
+	          parent_vmdk_handle,
+	          parent_path,
+	          LIBVMDK_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent handle: %" PRIs_SYSTEM ".",
+		 function,
+		 parent_path );
+
+		goto on_error;
+	}
+	if( serve_handle->basename != NULL )
+	{
+		memory_free(
+		 parent_path );
+	}
+	parent_path = NULL;
+
+	memory_free(
+	 parent_filename );
+
+	parent_filename = NULL;
+
+	result = libvmdk_handle_get_parent_content_identifier(
+	          parent_vmdk_handle,
+	          &parent_content_identifier,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent content identifier.",
+		 function );
+
+		goto on_error;
+	}
+	else if( ( result != 0 )
+	      && ( parent_content_identifier != 0xffffffffUL ) )
+	{
+		if( serve_handle_open_parent(
+		     serve_handle,
+		     parent_vmdk_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open parent handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_handle_open_extent_data_files(
+	     parent_vmdk_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent extent data files.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_set_parent_handle(
+	     vmdk_handle,
+	     parent_vmdk_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set parent handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_append_entry(
+	     serve_handle->parent_handles_array,
+	     &entry_index,
+	     (intptr_t *) parent_vmdk_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append parent handle to array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( parent_vmdk_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &parent_vmdk_handle,
+		 NULL );
+	}
+	if( ( parent_path != NULL )
+	 && ( serve_handle->basename != NULL ) )
+	{
+		memory_free(
+		 parent_path );
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+	}
+	return( -1 );
+}
+
+/* Closes the serve handle
+ * Returns the 0 if successful or -1 on error
+ */
+int serve_handle_close(
+     serve_handle_t *serve_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *parent_vmdk_handle = NULL;
+	static char *function                = "serve_handle_close";
+	int entry_index                      = 0;
+	int number_of_entries                = 0;
+	int result                           = 0;
+
+	if( serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_close(
+	     serve_handle->input_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input handle.",
+		 function );
+
+		result = -1;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     serve_handle->parent_handles_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of parent handles.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     serve_handle->parent_handles_array,
+		     entry_index,
+		     (intptr_t **) &parent_vmdk_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent handle: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+
+			continue;
+		}
+		if( libvmdk_handle_close(
+		     parent_vmdk_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close parent handle: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the media size
+ * Returns 1 if successful or -1 on error
+ */
+int serve_handle_get_media_size(
+     serve_handle_t *serve_handle,
+     size64_t *media_size,
+     libcerror_error_t **error )
+{
+	static char *function = "serve_handle_get_media_size";
+
+	if( serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media size.",
+		 function );
+
+		return( -1 );
+	}
+	*media_size = serve_handle->input_media_size;
+
+	return( 1 );
+}
+
+/* Reads a buffer of media data at a specific offset
+ * This function is used by multiple connections and does not change the current offset of the input handle
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t serve_handle_read_buffer_at_offset(
+         serve_handle_t *serve_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "serve_handle_read_buffer_at_offset";
+	ssize_t read_count    = 0;
+
+	if( serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serve handle.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              serve_handle->input_handle,
+	              buffer,
+	              buffer_size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer from input handle at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Retrieves the block status of the run of media data at a specific offset
+ * Runs of which the data is stored in a parent are resolved using the parent handles.
+ * A run that is not stored in any of the layers is a hole that reads as zero bytes
+ * Returns 1 if successful, 0 if the offset is beyond the media size or -1 on error
+ */
+int serve_handle_get_block_status_at_offset(
+     serve_handle_t *serve_handle,
+     off64_t offset,
+     size64_t *run_size,
+     uint8_t *block_status_flags,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *layer_vmdk_handle = NULL;
+	static char *function               = "serve_handle_get_block_status_at_offset";
+	size64_t layer_run_size             = 0;
+	off64_t physical_offset             = 0;
+	uint32_t run_flags                  = 0;
+	int extent_index                    = 0;
+	int handle_index                    = 0;
+	int result                          = 0;
+
+	if( serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( run_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run size.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_status_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block status flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= serve_handle->input_media_size )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     serve_handle->parent_handles_array,
+	     &handle_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of parent handles.",
+		 function );
+
+		return( -1 );
+	}
+	layer_vmdk_handle = serve_handle->input_handle;
+
+	*run_size           = serve_handle->input_media_size - (size64_t) offset;
+	*block_status_flags = 0;
+
+	/* The parent handles are stored from the top most parent to the direct parent of the input handle
+	 */
+	do
+	{
+		result = libvmdk_handle_get_extent_map_run_at_offset(
+		          layer_vmdk_handle,
+		          offset,
+		          &layer_run_size,
+		          &extent_index,
+		          &physical_offset,
+		          &run_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent map run at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			/* The parent is smaller than the image, which reads as zero bytes
+			 */
+			*block_status_flags = SERVE_HANDLE_BLOCK_STATUS_FLAG_IS_HOLE | SERVE_HANDLE_BLOCK_STATUS_FLAG_IS_ZERO;
+
+			break;
+		}
+		if( ( layer_run_size != 0 )
+		 && ( layer_run_size < *run_size ) )
+		{
+			*run_size = layer_run_size;
+		}
+		if( ( ( run_flags & LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_IN_PARENT ) == 0 )
+		 || ( handle_index == 0 ) )
+		{
+			if( ( run_flags & LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_SPARSE ) != 0 )
+			{
+				*block_status_flags |= SERVE_HANDLE_BLOCK_STATUS_FLAG_IS_HOLE;
+			}
+			if( ( run_flags & LIBVMDK_EXTENT_MAP_RUN_FLAG_IS_ZERO ) != 0 )
+			{
+				*block_status_flags |= SERVE_HANDLE_BLOCK_STATUS_FLAG_IS_ZERO;
+			}
+			break;
+		}
+		handle_index--;
+
+		if( libcdata_array_get_entry_by_index(
+		     serve_handle->parent_handles_array,
+		     handle_index,
+		     (intptr_t **) &layer_vmdk_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent handle: %d.",
+			 function,
+			 handle_index );
+
+			return( -1 );
+		}
+	}
+	while( layer_vmdk_handle != NULL );
+
+	return( 1 );
+}
+
+/* Opens a Unix domain socket to listen for connections
+ * Returns 1 if successful or -1 on error
+ */
+int serve_handle_open_unix_socket(
+     serve_handle_t *serve_handle,
+     const system_character_t *path,
+     libcerror_error_t **error )
+{
+#if defined( SERVE_HANDLE_HAVE_SOCKETS )
+	struct sockaddr_un socket_address;
+
+	size_t path_length = 0;
+#endif
+
+	static char *function = "serve_handle_open_unix_socket";
+
+	if( serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( serve_handle->socket_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid serve handle - socket already opened.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( SERVE_HANDLE_HAVE_SOCKETS )
+	path_length = system_string_length(
+	               path );
+
+	if( ( path_length == 0 )
+	 || ( path_length >= sizeof( socket_address.sun_path ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &socket_address,
+	     0,
+	     sizeof( struct sockaddr_un ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear socket address.",
+		 function );
+
+		return( -1 );
+	}
+	socket_address.sun_family = AF_UNIX;
+
+	if( system_string_copy(
+	     socket_address.sun_path,
+	     path,
+	     path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy path.",
+		 function );
+
+		return( -1 );
+	}
+	serve_handle->socket_path = system_string_allocate(
+	                             path_length + 1 );
+
+	if( serve_handle->socket_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create socket path.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     serve_handle->socket_path,
+	     path,
+	     path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy socket path.",
+		 function );
+
+		goto on_error;
+	}
+	serve_handle->socket_path[ path_length ] = 0;
+
+	serve_handle->socket_descriptor = socket(
+	                                   AF_UNIX,
+	                                   SOCK_STREAM,
+	                                   0 );
+
+	if( serve_handle->socket_descriptor == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to create socket.",
+		 function );
+
+		goto on_error;
+	}
+	if( bind(
+	     serve_handle->socket_descriptor,
+	     (struct sockaddr *) &socket_address,
+	     sizeof( struct sockaddr_un ) ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to bind socket to: %" PRIs_SYSTEM ".",
+		 function,
+		 path );
+
+		/* Do not remove a file that was not created by the serve handle
+		 */
+		memory_free(
+		 serve_handle->socket_path );
+
+		serve_handle->socket_path = NULL;
+
+		goto on_error;
+	}
+	if( listen(
+	     serve_handle->socket_descriptor,
+	     SERVE_HANDLE_MAXIMUM_NUMBER_OF_PENDING_CONNECTIONS ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to listen on socket.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	serve_handle_close_socket(
+	 serve_handle,
+	 NULL );
+
+	return( -1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: sockets are not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( SERVE_HANDLE_HAVE_SOCKETS ) */
+}
+
+/* Opens a TCP socket on the loopback interface to listen for connections
+ * Returns 1 if successful or -1 on error
+ */
+int serve_handle_open_tcp_socket(
+     serve_handle_t *serve_handle,
+     uint16_t port,
+     libcerror_error_t **error )
+{
+#if defined( SERVE_HANDLE_HAVE_SOCKETS )
+	struct sockaddr_in socket_address;
+
+	int reuse_address = 1;
+#endif
+
+	static char *function = "serve_handle_open_tcp_socket";
+
+	if( serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( serve_handle->socket_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid serve handle - socket already opened.",
+		 function );
+
+		return( -1 );
+	}
+	if( port == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid port value zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( SERVE_HANDLE_HAVE_SOCKETS )
+	if( memory_set(
+	     &socket_address,
+	     0,
+	     sizeof( struct sockaddr_in ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear socket address.",
+		 function );
+
+		return( -1 );
+	}
+	/* Only listen on the loopback interface since the connections are not authenticated
+	 */
+	socket_address.sin_family      = AF_INET;
+	socket_address.sin_port        = htons( port );
+	socket_address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+
+	serve_handle->socket_descriptor = socket(
+	                                   AF_INET,
+	                                   SOCK_STREAM,
+	                                   0 );
+
+	if( serve_handle->socket_descriptor == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to create socket.",
+		 function );
+
+		goto on_error;
+	}
+	if( setsockopt(
+	     serve_handle->socket_descriptor,
+	     SOL_SOCKET,
+	     SO_REUSEADDR,
+	     &reuse_address,
+	     sizeof( int ) ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to set socket to reuse address.",
+		 function );
+
+		goto on_error;
+	}
+	if( bind(
+	     serve_handle->socket_descriptor,
+	     (struct sockaddr *) &socket_address,
+	     sizeof( struct sockaddr_in ) ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to bind socket to port: %" PRIu16 ".",
+		 function,
+		 port );
+
+		goto on_error;
+	}
+	if( listen(
+	     serve_handle->socket_descriptor,
+	     SERVE_HANDLE_MAXIMUM_NUMBER_OF_PENDING_CONNECTIONS ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to listen on socket.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	serve_handle_close_socket(
+	 serve_handle,
+	 NULL );
+
+	return( -1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: sockets are not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( SERVE_HANDLE_HAVE_SOCKETS ) */
+}
+
+/* Closes the listening socket
+ * The Unix domain socket is removed from the file system
+ * Returns 0 if successful or -1 on error
+ */
+int serve_handle_close_socket(
+     serve_handle_t *serve_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "serve_handle_close_socket";
+	int result            = 0;
+
+	if( serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( serve_handle->socket_descriptor != -1 )
+	{
+		if( close(
+		     serve_handle->socket_descriptor ) != 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to close socket.",
+			 function );
+
+			result = -1;
+		}
+		serve_handle->socket_descriptor = -1;
+	}
+	if( serve_handle->socket_path != NULL )
+	{
+		if( unlink(
+		     serve_handle->socket_path ) != 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 errno,
+			 "%s: unable to remove socket: %" PRIs_SYSTEM ".",
+			 function,
+			 serve_handle->socket_path );
+
+			result = -1;
+		}
+		memory_free(
+		 serve_handle->socket_path );
+
+		serve_handle->socket_path = NULL;
+	}
+	return( result );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Joins the threads of the connections and frees the connections
+ * If finished_only is set only the connections that have finished are joined,
+ * otherwise the remaining connections are shut down first
+ * Returns 1 if successful or -1 on error
+ */
+int serve_handle_join_connections(
+     serve_handle_t *serve_handle,
+     uint8_t finished_only,
+     libcerror_error_t **error )
+{
+	libcthreads_thread_t *thread     = NULL;
+	nbd_connection_t *nbd_connection = NULL;
+	static char *function            = "serve_handle_join_connections";
+	int entry_index                  = 0;
+	int number_of_entries            = 0;
+	int result                       = 1;
+
+	if( serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     serve_handle->connections_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of connections.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     serve_handle->connections_array,
+		     entry_index,
+		     (intptr_t **) &nbd_connection,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve connection: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( nbd_connection == NULL )
+		{
+			continue;
+		}
+		if( nbd_connection->is_finished == 0 )
+		{
+			if( finished_only != 0 )
+			{
+				continue;
+			}
+#if defined( SERVE_HANDLE_HAVE_SOCKETS )
+			/* Shutting down the socket makes a blocking read of the connection return
+			 */
+			shutdown(
+			 nbd_connection->socket_descriptor,
+			 SHUT_RDWR );
+#endif
+		}
+		if( libcdata_array_get_entry_by_index(
+		     serve_handle->threads_array,
+		     entry_index,
+		     (intptr_t **) &thread,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve thread: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( thread != NULL )
+		{
+			if( libcthreads_thread_join(
+			     &thread,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread: %d.",
+				 function,
+				 entry_index );
+
+				result = -1;
+			}
+		}
+		if( close(
+		     nbd_connection->socket_descriptor ) != 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to close socket of connection: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+		}
+		if( nbd_connection_free(
+		     &nbd_connection,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free connection: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+		}
+		if( libcdata_array_set_entry_by_index(
+		     serve_handle->threads_array,
+		     entry_index,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set thread: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( libcdata_array_set_entry_by_index(
+		     serve_handle->connections_array,
+		     entry_index,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set connection: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Starts a thread to serve a connection
+ * The slot of a connection that has been joined is reused
+ * Returns 1 if successful or -1 on error
+ */
+int serve_handle_start_connection(
+     serve_handle_t *serve_handle,
+     int socket_descriptor,
+     libcerror_error_t **error )
+{
+	libcthreads_thread_t *thread          = NULL;
+	nbd_connection_t *nbd_connection      = NULL;
+	nbd_connection_t *used_nbd_connection = NULL;
+	static char *function                 = "serve_handle_start_connection";
+	int entry_index                       = 0;
+	int number_of_entries                 = 0;
+
+	if( serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     serve_handle->connections_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of connections.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     serve_handle->connections_array,
+		     entry_index,
+		     (intptr_t **) &used_nbd_connection,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve connection: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( used_nbd_connection == NULL )
+		{
+			break;
+		}
+	}
+	if( entry_index >= number_of_entries )
+	{
+		if( libcdata_array_append_entry(
+		     serve_handle->connections_array,
+		     &entry_index,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append connection to array.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcdata_array_append_entry(
+		     serve_handle->threads_array,
+		     &entry_index,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append thread to array.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( nbd_connection_initialize(
+	     &nbd_connection,
+	     serve_handle,
+	     socket_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize connection.",
+		 function );
+
+		goto on_error;
+	}
+	/* The connection is stored before the thread is created so that it is always joined
+	 */
+	if( libcdata_array_set_entry_by_index(
+	     serve_handle->connections_array,
+	     entry_index,
+	     (intptr_t *) nbd_connection,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set connection: %d.",
+		 function,
+		 entry_index );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_create(
+	     &thread,
+	     NULL,
+	     (int (*)(void *)) &nbd_connection_thread_function,
+	     (void *) nbd_connection,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread.",
+		 function );
+
+		libcdata_array_set_entry_by_index(
+		 serve_handle->connections_array,
+		 entry_index,
+		 NULL,
+		 NULL );
+
+		goto on_error;
+	}
+	if( libcdata_array_set_entry_by_index(
+	     serve_handle->threads_array,
+	     entry_index,
+	     (intptr_t *) thread,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set thread: %d.",
+		 function,
+		 entry_index );
+
+#if defined( SERVE_HANDLE_HAVE_SOCKETS )
+		/* Shutting down the socket makes the thread of the connection stop
+		 */
+		shutdown(
+		 socket_descriptor,
+		 SHUT_RDWR );
+#endif
+		libcthreads_thread_join(
+		 &thread,
+		 NULL );
+
+		libcdata_array_set_entry_by_index(
+		 serve_handle->connections_array,
+		 entry_index,
+		 NULL,
+		 NULL );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( nbd_connection != NULL )
+	{
+		nbd_connection_free(
+		 &nbd_connection,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Accepts and serves connections until abort is signalled
+ * If multi-threading is supported every connection is served by its own thread,
+ * otherwise the connections are served one after the other
+ * Returns 1 if successful or -1 on error
+ */
+int serve_handle_serve_connections(
+     serve_handle_t *serve_handle,
+     libcerror_error_t **error )
+{
+#if defined( SERVE_HANDLE_HAVE_SOCKETS )
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcerror_error_t *connection_error = NULL;
+	nbd_connection_t *nbd_connection    = NULL;
+#endif
+	int socket_descriptor               = -1;
+	int result                          = 1;
+#endif
+
+	static char *function = "serve_handle_serve_connections";
+
+	if( serve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( serve_handle->socket_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid serve handle - missing socket.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( SERVE_HANDLE_HAVE_SOCKETS )
+	while( serve_handle->abort == 0 )
+	{
+		socket_descriptor = accept(
+		                     serve_handle->socket_descriptor,
+		                     NULL,
+		                     NULL );
+
+		if( socket_descriptor == -1 )
+		{
+			if( serve_handle->abort != 0 )
+			{
+				break;
+			}
+			if( ( errno == EINTR )
+			 || ( errno == ECONNABORTED ) )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to accept connection.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( serve_handle_join_connections(
+		     serve_handle,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join finished connections.",
+			 function );
+
+			close(
+			 socket_descriptor );
+
+			result = -1;
+
+			break;
+		}
+		if( serve_handle_start_connection(
+		     serve_handle,
+		     socket_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start connection.",
+			 function );
+
+			close(
+			 socket_descriptor );
+
+			result = -1;
+
+			break;
+		}
+#else
+		if( nbd_connection_initialize(
+		     &nbd_connection,
+		     serve_handle,
+		     socket_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize connection.",
+			 function );
+
+			close(
+			 socket_descriptor );
+
+			result = -1;
+
+			break;
+		}
+		/* A failing connection does not stop the other connections from being served
+		 */
+		if( nbd_connection_serve(
+		     nbd_connection,
+		     &connection_error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to serve connection.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 connection_error );
+			libcerror_error_free(
+			 &connection_error );
+		}
+		close(
+		 socket_descriptor );
+
+		if( nbd_connection_free(
+		     &nbd_connection,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free connection.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( result == 1 )
+	{
+		if( serve_handle_join_connections(
+		     serve_handle,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join connections.",
+			 function );
+
+			result = -1;
+		}
+	}
+	else
+	{
+		serve_handle_join_connections(
+		 serve_handle,
+		 0,
+		 NULL );
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( result );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: sockets are not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( SERVE_HANDLE_HAVE_SOCKETS ) */
+}
+
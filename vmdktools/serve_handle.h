@@ -0,0 +1,193 @@
+/*
+ * Serve handle
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _SERVE_HANDLE_H )
+#define _SERVE_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libcthreads.h"
+#include "vmdktools_libvmdk.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The images are served over sockets, which are only supported on POSIX platforms
+ */
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) && defined( HAVE_NETINET_IN_H ) && !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define SERVE_HANDLE_HAVE_SOCKETS
+#endif
+
+/* The maximum number of pending connections
+ */
+#define SERVE_HANDLE_MAXIMUM_NUMBER_OF_PENDING_CONNECTIONS	16
+
+/* The block status flags
+ */
+#define SERVE_HANDLE_BLOCK_STATUS_FLAG_IS_HOLE			0x01
+#define SERVE_HANDLE_BLOCK_STATUS_FLAG_IS_ZERO			0x02
+
+typedef struct serve_handle serve_handle_t;
+
+struct serve_handle
+{
+	/* The basename
+	 */
+	system_character_t *basename;
+
+	/* The basename size
+	 */
+	size_t basename_size;
+
+	/* The libvmdk input handle
+	 */
+	libvmdk_handle_t *input_handle;
+
+	/* The libvmdk parent handles
+	 */
+	libcdata_array_t *parent_handles_array;
+
+	/* The input media size
+	 */
+	size64_t input_media_size;
+
+	/* The listening socket descriptor
+	 */
+	int socket_descriptor;
+
+	/* The path of the Unix domain socket
+	 */
+	system_character_t *socket_path;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The connections
+	 */
+	libcdata_array_t *connections_array;
+
+	/* The connection threads
+	 */
+	libcdata_array_t *threads_array;
+#endif
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int serve_handle_initialize(
+     serve_handle_t **serve_handle,
+     libcerror_error_t **error );
+
+int serve_handle_free(
+     serve_handle_t **serve_handle,
+     libcerror_error_t **error );
+
+int serve_handle_signal_abort(
+     serve_handle_t *serve_handle,
+     libcerror_error_t **error );
+
+int serve_handle_set_basename(
+     serve_handle_t *serve_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error );
+
+int serve_handle_open_input(
+     serve_handle_t *serve_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error );
+
+int serve_handle_open_parent(
+     serve_handle_t *serve_handle,
+     libvmdk_handle_t *vmdk_handle,
+     libcerror_error_t **error );
+
+int serve_handle_close(
+     serve_handle_t *serve_handle,
+     libcerror_error_t **error );
+
+int serve_handle_get_media_size(
+     serve_handle_t *serve_handle,
+     size64_t *media_size,
+     libcerror_error_t **error );
+
+ssize_t serve_handle_read_buffer_at_offset(
+         serve_handle_t *serve_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int serve_handle_get_block_status_at_offset(
+     serve_handle_t *serve_handle,
+     off64_t offset,
+     size64_t *run_size,
+     uint8_t *block_status_flags,
+     libcerror_error_t **error );
+
+int serve_handle_open_unix_socket(
+     serve_handle_t *serve_handle,
+     const system_character_t *path,
+     libcerror_error_t **error );
+
+int serve_handle_open_tcp_socket(
+     serve_handle_t *serve_handle,
+     uint16_t port,
+     libcerror_error_t **error );
+
+int serve_handle_close_socket(
+     serve_handle_t *serve_handle,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int serve_handle_join_connections(
+     serve_handle_t *serve_handle,
+     uint8_t finished_only,
+     libcerror_error_t **error );
+
+int serve_handle_start_connection(
+     serve_handle_t *serve_handle,
+     int socket_descriptor,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int serve_handle_serve_connections(
+     serve_handle_t *serve_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _SERVE_HANDLE_H ) */
+
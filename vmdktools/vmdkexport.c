@@ -0,0 +1,456 @@
+/*
+ * Exports the media data of a VMware Virtual Disk (VMDK) file.
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_FCNTL_H ) || defined( WINAPI )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "export_handle.h"
+#include "vmdktools_getopt.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libclocale.h"
+#include "vmdktools_libcnotify.h"
+#include "vmdktools_libvmdk.h"
+#include "vmdktools_output.h"
+#include "vmdktools_signal.h"
+#include "vmdktools_unused.h"
+
+export_handle_t *vmdkexport_export_handle = NULL;
+int vmdkexport_abort                      = 0;
+
+/* Signal handler for vmdkexport
+ */
+void vmdkexport_signal_handler(
+      vmdktools_signal_t signal VMDKTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vmdkexport_signal_handler";
+
+	VMDKTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vmdkexport_abort = 1;
+
+	if( vmdkexport_export_handle != NULL )
+	{
+		if( export_handle_signal_abort(
+		     vmdkexport_export_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal export handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	const char *description = \
+		"Use vmdkexport to export the media data of a VMware Virtual Disk (VMDK) file to a raw image.";
+
+	vmdktools_option_t options[ ] = {
+		{ 'h', NULL, "shows this help" },
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		{ 'j', "jobs", "the number of concurrent read jobs (threads), where a number of 0 represents single-threaded mode (default is 4)" },
+#endif
+		{ 'q', NULL, "quiet shows minimal status information" },
+		{ 'S', NULL, "do not write the target as a sparse file" },
+		{ 't', "target", "specify the target file to export to, use - for stdout" },
+		{ 'v', NULL, "verbose output to stderr" },
+		{ 'V', NULL, "print version" },
+		{ 0, "source", "the source descriptor file" },
+	};
+	system_character_t options_string[ 32 ];
+
+	libvmdk_error_t *error                       = NULL;
+	system_character_t * const *source_filenames = NULL;
+	system_character_t *option_jobs              = NULL;
+	system_character_t *option_target_filename   = NULL;
+	FILE *output_stream                          = stdout;
+	char *program                                = "vmdkexport";
+	system_integer_t option                      = 0;
+	size_t string_length                         = 0;
+	uint8_t print_status_information             = 1;
+	uint8_t write_sparse                         = 1;
+	int number_of_options                        = (int) ( sizeof( options ) / sizeof( vmdktools_option_t ) );
+	int number_of_source_filenames               = 0;
+	int result                                   = 0;
+	int verbose                                  = 0;
+
+#if defined( __MINGW32__ ) && defined( HAVE_MINGW_BINMODE )
+	_setmode( _fileno( stdout ), _O_BINARY );
+	_setmode( _fileno( stderr ), _O_BINARY );
+#endif
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "vmdktools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( vmdktools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	if( vmdktools_getopt_get_options_string(
+	     options,
+	     number_of_options,
+	     options_string,
+	     32 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to determine options string.\n" );
+
+		goto on_error;
+	}
+	while( ( option = vmdktools_getopt(
+	                   argc,
+	                   argv,
+	                   options_string ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				vmdktools_output_version_fprint(
+				 stdout,
+				 program );
+
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				vmdktools_getopt_usage_fprint(
+				 stdout,
+				 program,
+				 description,
+				 options,
+				 number_of_options );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				vmdktools_output_version_fprint(
+				 stdout,
+				 program );
+
+				vmdktools_getopt_usage_fprint(
+				 stdout,
+				 program,
+				 description,
+				 options,
+				 number_of_options );
+
+				return( EXIT_SUCCESS );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			case (system_integer_t) 'j':
+				option_jobs = optarg;
+
+				break;
+
+#endif
+			case (system_integer_t) 'q':
+				print_status_information = 0;
+
+				break;
+
+			case (system_integer_t) 'S':
+				write_sparse = 0;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_target_filename = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vmdktools_output_version_fprint(
+				 stdout,
+				 program );
+
+				vmdktools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( option_target_filename != NULL )
+	{
+		string_length = system_string_length(
+		                 option_target_filename );
+
+		/* When exporting to stdout the status information is printed to stderr
+		 */
+		if( ( string_length == 1 )
+		 && ( option_target_filename[ 0 ] == (system_character_t) '-' ) )
+		{
+			output_stream = stderr;
+		}
+	}
+	vmdktools_output_version_fprint(
+	 output_stream,
+	 program );
+
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source image.\n" );
+
+		vmdktools_getopt_usage_fprint(
+		 output_stream,
+		 program,
+		 description,
+		 options,
+		 number_of_options );
+
+		return( EXIT_FAILURE );
+	}
+	if( option_target_filename == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Missing target file.\n" );
+
+		vmdktools_getopt_usage_fprint(
+		 output_stream,
+		 program,
+		 description,
+		 options,
+		 number_of_options );
+
+		return( EXIT_FAILURE );
+	}
+	source_filenames           = &( argv[ optind ] );
+	number_of_source_filenames = argc - optind;
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvmdk_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvmdk_notify_set_verbose(
+	 verbose );
+
+	if( export_handle_initialize(
+	     &vmdkexport_export_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize export handle.\n" );
+
+		goto on_error;
+	}
+	vmdkexport_export_handle->notify_stream = output_stream;
+	vmdkexport_export_handle->write_sparse  = write_sparse;
+
+	if( option_jobs != NULL )
+	{
+		if( export_handle_set_number_of_threads(
+		     vmdkexport_export_handle,
+		     option_jobs,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of jobs: %" PRIs_SYSTEM ".\n",
+			 option_jobs );
+
+			goto on_error;
+		}
+	}
+	if( export_handle_open_input(
+	     vmdkexport_export_handle,
+	     source_filenames,
+	     number_of_source_filenames,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open source file(s).\n" );
+
+		goto on_error;
+	}
+	if( export_handle_open_output(
+	     vmdkexport_export_handle,
+	     option_target_filename,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open target file: %" PRIs_SYSTEM ".\n",
+		 option_target_filename );
+
+		goto on_error;
+	}
+	if( vmdktools_signal_attach(
+	     vmdkexport_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = export_handle_export_input(
+	          vmdkexport_export_handle,
+	          print_status_information,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to export input.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vmdktools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( export_handle_close(
+	     vmdkexport_export_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close export handle.\n" );
+
+		goto on_error;
+	}
+	if( export_handle_free(
+	     &vmdkexport_export_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free export handle.\n" );
+
+		goto on_error;
+	}
+	if( ( result != 1 )
+	 || ( vmdkexport_abort != 0 ) )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vmdkexport_export_handle != NULL )
+	{
+		export_handle_free(
+		 &vmdkexport_export_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
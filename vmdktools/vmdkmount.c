@@ -116,6 +116,9 @@ int main( int argc, char * const argv[] )
 
 	vmdktools_option_t options[ ] = {
 		{ 'h', NULL, "shows this help" },
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
+		{ 'm', NULL, "use multiple threads to serve concurrent reads" },
+#endif
 		{ 'v', NULL, "verbose output to stderr, while vmdkmount will remain running in the foreground" },
 		{ 'V', NULL, "print version" },
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
@@ -145,6 +148,7 @@ int main( int argc, char * const argv[] )
 	struct fuse_operations vmdkmount_fuse_operations;
 
 	system_character_t *option_extended_options = NULL;
+	int use_multi_threading                     = 0;
 
 #if defined( HAVE_LIBFUSE3 )
 	/* Need to set this to 1 even if there no arguments, otherwise this causes
@@ -255,6 +259,11 @@ int main( int argc, char * const argv[] )
 				return( EXIT_SUCCESS );
 
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
+			case (system_integer_t) 'm':
+				use_multi_threading = 1;
+
+				break;
+
 			case (system_integer_t) 'X':
 				option_extended_options = optarg;
 
@@ -336,6 +345,22 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
+	if( use_multi_threading != 0 )
+	{
+		if( mount_handle_set_number_of_readers(
+		     vmdkmount_mount_handle,
+		     MOUNT_HANDLE_DEFAULT_NUMBER_OF_READERS,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of readers.\n" );
+
+			goto on_error;
+		}
+	}
+#endif
 	result = mount_handle_open(
 	          vmdkmount_mount_handle,
 	          sources,
@@ -419,6 +444,13 @@ int main( int argc, char * const argv[] )
 	vmdkmount_fuse_operations.getattr    = &mount_fuse_getattr;
 	vmdkmount_fuse_operations.destroy    = &mount_fuse_destroy;
 
+#if defined( MOUNT_FUSE_HAVE_READ_BUF )
+	vmdkmount_fuse_operations.read_buf   = &mount_fuse_read_buf;
+#endif
+#if defined( MOUNT_FUSE_HAVE_LSEEK )
+	vmdkmount_fuse_operations.lseek      = &mount_fuse_lseek;
+#endif
+
 #if defined( HAVE_LIBFUSE3 )
 	vmdkmount_fuse_handle = fuse_new(
 	                         &vmdkmount_fuse_arguments,
@@ -488,8 +520,22 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
-	result = fuse_loop(
-	          vmdkmount_fuse_handle );
+	if( use_multi_threading != 0 )
+	{
+#if defined( HAVE_LIBFUSE3 )
+		result = fuse_loop_mt(
+		          vmdkmount_fuse_handle,
+		          0 );
+#else
+		result = fuse_loop_mt(
+		          vmdkmount_fuse_handle );
+#endif
+	}
+	else
+	{
+		result = fuse_loop(
+		          vmdkmount_fuse_handle );
+	}
 
 	if( result != 0 )
 	{
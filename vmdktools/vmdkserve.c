@@ -0,0 +1,517 @@
+/*
+ * Serves the media data of a VMware Virtual Disk (VMDK) file as a Network Block Device (NBD).
+ *
+ * Copyright (C) 2009-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "serve_handle.h"
+#include "vmdktools_getopt.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libclocale.h"
+#include "vmdktools_libcnotify.h"
+#include "vmdktools_libvmdk.h"
+#include "vmdktools_output.h"
+#include "vmdktools_signal.h"
+#include "vmdktools_unused.h"
+
+serve_handle_t *vmdkserve_serve_handle = NULL;
+int vmdkserve_abort                    = 0;
+
+/* Signal handler for vmdkserve
+ */
+void vmdkserve_signal_handler(
+      vmdktools_signal_t signal VMDKTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vmdkserve_signal_handler";
+
+	VMDKTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vmdkserve_abort = 1;
+
+	if( vmdkserve_serve_handle != NULL )
+	{
+		if( serve_handle_signal_abort(
+		     vmdkserve_serve_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal serve handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+}
+
+/* Determines the port from a string
+ * Returns 1 if successful or -1 on error
+ */
+int vmdkserve_get_port(
+     const system_character_t *string,
+     uint16_t *port,
+     libcerror_error_t **error )
+{
+	static char *function = "vmdkserve_get_port";
+	size_t string_index   = 0;
+	uint32_t value_32bit  = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( port == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid port.",
+		 function );
+
+		return( -1 );
+	}
+	for( string_index = 0;
+	     string[ string_index ] != 0;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] < (system_character_t) '0' )
+		 || ( string[ string_index ] > (system_character_t) '9' ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character in port string.",
+			 function );
+
+			return( -1 );
+		}
+		value_32bit *= 10;
+		value_32bit += (uint32_t) ( string[ string_index ] - (system_character_t) '0' );
+
+		if( value_32bit > (uint32_t) UINT16_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid port value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( string_index == 0 )
+	 || ( value_32bit == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid port value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*port = (uint16_t) value_32bit;
+
+	return( 1 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	const char *description = \
+		"Use vmdkserve to serve the media data of a VMware Virtual Disk (VMDK) file as a read-only Network Block Device (NBD).";
+
+	vmdktools_option_t options[ ] = {
+		{ 'h', NULL, "shows this help" },
+		{ 'p', "port", "specify the TCP port to listen on, the port is bound to the loopback address" },
+		{ 'u', "socket", "specify the path of the Unix domain socket to listen on" },
+		{ 'v', NULL, "verbose output to stderr" },
+		{ 'V', NULL, "print version" },
+		{ 0, "source", "the source descriptor file" },
+	};
+	system_character_t options_string[ 32 ];
+
+	libvmdk_error_t *error                       = NULL;
+	system_character_t * const *source_filenames = NULL;
+	system_character_t *option_port              = NULL;
+	system_character_t *option_socket_path       = NULL;
+	char *program                                = "vmdkserve";
+	system_integer_t option                      = 0;
+	uint16_t port                                = 0;
+	int number_of_options                        = (int) ( sizeof( options ) / sizeof( vmdktools_option_t ) );
+	int number_of_source_filenames               = 0;
+	int result                                   = 0;
+	int verbose                                  = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "vmdktools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( vmdktools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	if( vmdktools_getopt_get_options_string(
+	     options,
+	     number_of_options,
+	     options_string,
+	     32 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to determine options string.\n" );
+
+		goto on_error;
+	}
+	while( ( option = vmdktools_getopt(
+	                   argc,
+	                   argv,
+	                   options_string ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				vmdktools_output_version_fprint(
+				 stdout,
+				 program );
+
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				vmdktools_getopt_usage_fprint(
+				 stdout,
+				 program,
+				 description,
+				 options,
+				 number_of_options );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				vmdktools_output_version_fprint(
+				 stdout,
+				 program );
+
+				vmdktools_getopt_usage_fprint(
+				 stdout,
+				 program,
+				 description,
+				 options,
+				 number_of_options );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'p':
+				option_port = optarg;
+
+				break;
+
+			case (system_integer_t) 'u':
+				option_socket_path = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vmdktools_output_version_fprint(
+				 stdout,
+				 program );
+
+				vmdktools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	vmdktools_output_version_fprint(
+	 stdout,
+	 program );
+
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source image.\n" );
+
+		vmdktools_getopt_usage_fprint(
+		 stdout,
+		 program,
+		 description,
+		 options,
+		 number_of_options );
+
+		return( EXIT_FAILURE );
+	}
+	if( ( ( option_port == NULL )
+	  &&  ( option_socket_path == NULL ) )
+	 || ( ( option_port != NULL )
+	  &&  ( option_socket_path != NULL ) ) )
+	{
+		fprintf(
+		 stderr,
+		 "Specify either a port or a socket to listen on.\n" );
+
+		vmdktools_getopt_usage_fprint(
+		 stdout,
+		 program,
+		 description,
+		 options,
+		 number_of_options );
+
+		return( EXIT_FAILURE );
+	}
+	if( option_port != NULL )
+	{
+		if( vmdkserve_get_port(
+		     option_port,
+		     &port,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported port: %" PRIs_SYSTEM ".\n",
+			 option_port );
+
+			goto on_error;
+		}
+	}
+	source_filenames           = &( argv[ optind ] );
+	number_of_source_filenames = argc - optind;
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvmdk_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvmdk_notify_set_verbose(
+	 verbose );
+
+	if( serve_handle_initialize(
+	     &vmdkserve_serve_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize serve handle.\n" );
+
+		goto on_error;
+	}
+	if( serve_handle_open_input(
+	     vmdkserve_serve_handle,
+	     source_filenames,
+	     number_of_source_filenames,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open source file(s).\n" );
+
+		goto on_error;
+	}
+	if( option_socket_path != NULL )
+	{
+		result = serve_handle_open_unix_socket(
+		          vmdkserve_serve_handle,
+		          option_socket_path,
+		          &error );
+
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to listen on socket: %" PRIs_SYSTEM ".\n",
+			 option_socket_path );
+
+			goto on_error;
+		}
+		fprintf(
+		 stdout,
+		 "Serving on socket: %" PRIs_SYSTEM "\n",
+		 option_socket_path );
+	}
+	else
+	{
+		result = serve_handle_open_tcp_socket(
+		          vmdkserve_serve_handle,
+		          port,
+		          &error );
+
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to listen on port: %" PRIu16 ".\n",
+			 port );
+
+			goto on_error;
+		}
+		fprintf(
+		 stdout,
+		 "Serving on port: %" PRIu16 "\n",
+		 port );
+	}
+	if( vmdktools_signal_attach(
+	     vmdkserve_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = serve_handle_serve_connections(
+	          vmdkserve_serve_handle,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to serve connections.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vmdktools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( serve_handle_close_socket(
+	     vmdkserve_serve_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close socket.\n" );
+
+		goto on_error;
+	}
+	if( serve_handle_close(
+	     vmdkserve_serve_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close serve handle.\n" );
+
+		goto on_error;
+	}
+	if( serve_handle_free(
+	     &vmdkserve_serve_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free serve handle.\n" );
+
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vmdkserve_serve_handle != NULL )
+	{
+		serve_handle_free(
+		 &vmdkserve_serve_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+